@@ -30,6 +30,7 @@ void DatabaseInterface::cleanAllConfigs(void)
     PDIEEPROM.write(i, 0);
   }
   PDIEEPROM.end();
+  touchStore();
 }
 
 /**
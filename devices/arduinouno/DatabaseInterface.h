@@ -59,6 +59,10 @@ public:
         PDIEEPROM.write(_address + i, *((char *)&(*_object) + i));
       }
     }
+    if (_data_written)
+    {
+      touchStore();
+    }
   }
 
   /**
@@ -18,6 +18,7 @@ created Date    : 1st Jan 2024
 void DatabaseInterface::beginConfigs(uint32_t _size)
 {
   EEPROM.begin(_size);
+  touchStore();
 }
 
 /**
@@ -30,6 +31,28 @@ void DatabaseInterface::cleanAllConfigs(void)
     EEPROM.write(i, 0);
   }
   EEPROM.end();
+  clearDirty();
+  touchStore();
+}
+
+/**
+ * write the ram copy out. the sector is erased and rewritten whole whatever
+ * the dirty range, so the saving here is in how many saves share one write.
+ *
+ * @return bool
+ */
+bool DatabaseInterface::commitConfigs()
+{
+  if (!hasUncommittedConfigs())
+  {
+    return true;
+  }
+  if (!EEPROM.commit())
+  {
+    return false;
+  }
+  clearDirty();
+  return true;
 }
 
 /**
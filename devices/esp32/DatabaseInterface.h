@@ -40,9 +40,11 @@ public:
   void cleanAllConfigs() override;
   bool isValidConfigs() override;
   uint32_t getMaxDBSize() override;
+  bool commitConfigs() override;
 
   /**
-   * template to save table in database by their address from table object
+   * template to save table in database by their address from table object.
+   * only the ram copy changes here, commitConfigs writes the sector.
    *
    * @param   uint16_t  	_address
    * @param   type of database table struct  _object
@@ -50,23 +52,19 @@ public:
   template <typename T>
   void saveConfig(uint16_t _address, T *_object)
   {
-    bool _data_written = false;
     for (size_t i = 0; i < sizeof((*_object)); i++)
     {
       if ((char)EEPROM.read(_address + i) != *((char *)&(*_object) + i))
       {
-        _data_written = true;
         EEPROM.write(_address + i, *((char *)&(*_object) + i));
+        markDirty(_address + i, 1);
       }
     }
-    if (_data_written)
-    {
-      EEPROM.commit();
-    }
   }
 
   /**
-   * template to load table from database by their address in table object
+   * template to load table from database by their address in table object.
+   * the ram copy is read in one go.
    *
    * @param   uint16_t  	_address
    * @param   type of database table struct  _object
@@ -76,10 +74,7 @@ public:
   {
     if (isValidConfigs())
     {
-      for (size_t i = 0; i < sizeof((*_object)); i++)
-      {
-        *((char *)&(*_object) + i) = EEPROM.read(_address + i);
-      }
+      EEPROM.get(_address, *_object);
     }
   }
 
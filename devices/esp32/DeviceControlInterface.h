@@ -92,6 +92,7 @@ public:
   uint32_t get_max_free_block() override;
   void log(logger_type_t log_type, const char *content) override;
   void yield() override;
+  void idle(uint32_t ms) override;
 
   // upgrade api
 #ifdef ENABLE_OTA_SERVICE
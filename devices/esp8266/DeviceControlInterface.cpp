@@ -9,6 +9,7 @@ created Date    : 1st Jan 2024
 ******************************************************************************/
 
 #include "DeviceControlInterface.h"
+#include "DatabaseInterface.h"
 #include "ExceptionsNotifier.h"
 #include "core/Espnow.h"
 #include "PingInterface.h"
@@ -261,6 +262,8 @@ void DeviceControlInterface::resetDevice()
  */
 void DeviceControlInterface::restartDevice()
 {
+    // saves still inside their commit window would be lost with the ram copy
+    __i_db.commitConfigs();
     ESP.restart();
 }
 
@@ -500,6 +503,17 @@ void DeviceControlInterface::yield()
     // #endif
 }
 
+/**
+ * idle the loop until the next task is due. delay hands the cpu to the sdk,
+ * which is where modem sleep and automatic light sleep get their chance.
+ * the serve loop only idles when no contextual task is registered, so
+ * nothing driven from the loop is held up by this
+ */
+void DeviceControlInterface::idle(uint32_t ms)
+{
+    delay(ms);
+}
+
 #ifdef ENABLE_OTA_SERVICE
 /**
  * Upgrade device with provided binary path and new version
@@ -147,15 +147,11 @@ bool EW_EEPROMClass::commit() {
 
   CRITICAL_SECTION_ENTER
 
-  if(spi_flash_erase_sector(m_sector) == SPI_FLASH_RESULT_OK) {
-    if(spi_flash_write(m_sector * SPI_FLASH_SEC_SIZE, reinterpret_cast<uint32_t*>(m_data), m_size) == SPI_FLASH_RESULT_OK) {
-      m_dirty = false;
-      ret = true;
-    }
-  }
-  if(spi_flash_erase_sector(m_copy_sector) == SPI_FLASH_RESULT_OK) {
-    if(spi_flash_write(m_copy_sector * SPI_FLASH_SEC_SIZE, reinterpret_cast<uint32_t*>(m_data), m_size) == SPI_FLASH_RESULT_OK) {
-    }
+  // the copy is brought up to date before the main sector is erased, so a reset
+  // part way through always leaves one whole sector for begin() to recover from
+  if( writeSector(m_copy_sector) && writeSector(m_sector) ) {
+    m_dirty = false;
+    ret = true;
   }
 
   CRITICAL_SECTION_EXIT
@@ -163,6 +159,20 @@ bool EW_EEPROMClass::commit() {
   return ret;
 }
 
+bool EW_EEPROMClass::writeSector(uint32_t sector) {
+  if(spi_flash_erase_sector(sector) != SPI_FLASH_RESULT_OK) {
+    return false;
+  }
+
+  // the validity word goes down last. begin() trusts a sector by that word, so
+  // a sector whose body was cut short is never mistaken for a good one
+  uint32_t address = sector * SPI_FLASH_SEC_SIZE;
+  if( m_size > 4 && spi_flash_write(address + 4, reinterpret_cast<uint32_t*>(m_data + 4), m_size - 4) != SPI_FLASH_RESULT_OK ) {
+    return false;
+  }
+  return spi_flash_write(address, reinterpret_cast<uint32_t*>(m_data), 4) == SPI_FLASH_RESULT_OK;
+}
+
 uint8_t * EW_EEPROMClass::getDataPtr() {
   m_dirty = true;
   return m_data;
@@ -35,10 +35,21 @@ public:
 
   size_t length() { return m_size; }
 
+  template<typename T> T &get(int const address, T &t) {
+    if (address < 0 || nullptr == m_data || address + sizeof(T) > m_size) {
+      return t;
+    }
+
+    memcpy((uint8_t *)&t, m_data + address, sizeof(T));
+    return t;
+  }
+
   uint8_t &operator[](int const address) { return getDataPtr()[address]; }
   uint8_t const &operator[](int const address) const { return getConstDataPtr()[address]; }
 
 private:
+  bool writeSector(uint32_t sector);
+
   uint32_t m_sector;
   uint32_t m_copy_sector;
   uint8_t *m_data;
@@ -48,6 +48,12 @@ created Date    : 1st Jan 2026
  */
 #define MAX_DB_TABLES 15
 
+/**
+ * lwip here has few tcp control blocks to share with ssh and telnet
+ */
+#define HTTP_SERVER_MAX_CLIENTS 2
+#define HTTP_SERVER_REQUEST_BUFFER_SIZE 1536
+
 /**
  * enable/disable storage service
  */
@@ -11,11 +11,45 @@ created Date    : 16th Aug 2026
 #include "DatabaseInterface.h"
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
+
+/**
+ * a journal record is this header followed by the bytes of the range
+ */
+#define DATABASE_JOURNAL_MAGIC 0x4A424450 // "PDBJ"
+
+struct database_journal_header
+{
+  uint32_t magic;
+  uint32_t from;
+  uint32_t length;
+  uint32_t sum;
+};
+
+/**
+ * fnv-1a over the range and where it goes, enough to tell a record that was
+ * written out whole from one a crash cut short
+ */
+static uint32_t journalSum(uint32_t from, const uint8_t *data, uint32_t length)
+{
+  uint32_t hash = 2166136261u;
+  const uint8_t *where = (const uint8_t *)&from;
+  for (uint8_t i = 0; i < sizeof(from); i++)
+  {
+    hash = (hash ^ where[i]) * 16777619u;
+  }
+  for (uint32_t i = 0; i < length; i++)
+  {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
 
 /**
  * DatabaseInterface constructor.
  */
-DatabaseInterface::DatabaseInterface() : m_size(DATABASE_MAX_SIZE)
+DatabaseInterface::DatabaseInterface() : m_size(DATABASE_MAX_SIZE),
+                                         m_commit_count(0)
 {
   memset(m_store, 0, DATABASE_MAX_SIZE);
 }
@@ -41,23 +75,143 @@ void DatabaseInterface::writeByte(uint32_t address, uint8_t value)
 }
 
 /**
- * push the store to its backing file when one is attached
+ * push the dirty range to the backing file when one is attached. the range is
+ * journalled first and only then written over the file, so a crash between the
+ * two is repaired by the next attach.
+ *
+ * @return bool
  */
-void DatabaseInterface::commit()
+bool DatabaseInterface::commitConfigs()
 {
+  if (!hasUncommittedConfigs())
+  {
+    return true;
+  }
+
   if (m_backingfile.size() == 0)
   {
-    return;
+    clearDirty();
+    return true;
+  }
+
+  uint32_t from = m_dirty_from;
+  uint32_t to = m_dirty_to > DATABASE_MAX_SIZE ? DATABASE_MAX_SIZE : m_dirty_to;
+
+  // a range that could not be written stays dirty for the next commit, and a
+  // journal already on disk is replayed if the process never gets that far
+  if (!writeJournal(from, to) || !writeRange(m_backingfile.c_str(), from, to))
+  {
+    return false;
   }
 
+  remove(journalPath().c_str());
+  clearDirty();
+  m_commit_count++;
+  return true;
+}
+
+/**
+ * write the whole store over the backing file, for a file that does not exist
+ * yet
+ */
+bool DatabaseInterface::writeWholeFile()
+{
   FILE *f = fopen(m_backingfile.c_str(), "wb");
   if (nullptr == f)
+  {
+    return false;
+  }
+
+  bool written = fwrite(m_store, 1, DATABASE_MAX_SIZE, f) == DATABASE_MAX_SIZE;
+  written = (0 == fflush(f)) && written;
+  fsync(fileno(f));
+  fclose(f);
+  return written;
+}
+
+/**
+ * patch one range of the file in place from the store
+ */
+bool DatabaseInterface::writeRange(const char *path, uint32_t from, uint32_t to)
+{
+  FILE *f = fopen(path, "r+b");
+  if (nullptr == f)
+  {
+    return writeWholeFile();
+  }
+
+  bool written = (0 == fseek(f, (long)from, SEEK_SET)) &&
+                 fwrite(m_store + from, 1, to - from, f) == (to - from);
+  written = (0 == fflush(f)) && written;
+  fsync(fileno(f));
+  fclose(f);
+  return written;
+}
+
+/**
+ * record the range about to be written, durably, before the file is touched
+ */
+bool DatabaseInterface::writeJournal(uint32_t from, uint32_t to)
+{
+  FILE *f = fopen(journalPath().c_str(), "wb");
+  if (nullptr == f)
+  {
+    return false;
+  }
+
+  database_journal_header header;
+  header.magic = DATABASE_JOURNAL_MAGIC;
+  header.from = from;
+  header.length = to - from;
+  header.sum = journalSum(from, m_store + from, header.length);
+
+  bool written = fwrite(&header, 1, sizeof(header), f) == sizeof(header) &&
+                 fwrite(m_store + from, 1, header.length, f) == header.length;
+  written = (0 == fflush(f)) && written;
+  fsync(fileno(f));
+  fclose(f);
+  return written;
+}
+
+/**
+ * finish a commit a crash interrupted. a whole record is applied to the store
+ * and the file, a torn one means the file was never touched and is dropped.
+ */
+void DatabaseInterface::replayJournal()
+{
+  pdiutil::string path = journalPath();
+  FILE *f = fopen(path.c_str(), "rb");
+  if (nullptr == f)
   {
     return;
   }
 
-  fwrite(m_store, 1, DATABASE_MAX_SIZE, f);
+  uint8_t data[DATABASE_MAX_SIZE];
+  database_journal_header header;
+  bool whole = fread(&header, 1, sizeof(header), f) == sizeof(header) &&
+               header.magic == DATABASE_JOURNAL_MAGIC &&
+               header.from <= DATABASE_MAX_SIZE &&
+               header.length <= DATABASE_MAX_SIZE - header.from &&
+               fread(data, 1, header.length, f) == header.length &&
+               header.sum == journalSum(header.from, data, header.length);
   fclose(f);
+
+  if (whole)
+  {
+    memcpy(m_store + header.from, data, header.length);
+    if (!writeRange(m_backingfile.c_str(), header.from, header.from + header.length))
+    {
+      return;
+    }
+  }
+  remove(path.c_str());
+}
+
+pdiutil::string DatabaseInterface::journalPath() const
+{
+  pdiutil::string path = m_backingfile;
+  path += ".jnl";
+  return path;
 }
 
 /**
@@ -76,7 +230,8 @@ void DatabaseInterface::beginConfigs(uint32_t _size)
 void DatabaseInterface::cleanAllConfigs(void)
 {
   memset(m_store, 0, DATABASE_MAX_SIZE);
-  commit();
+  markDirty(0, DATABASE_MAX_SIZE);
+  commitConfigs();
 }
 
 /**
@@ -109,16 +264,21 @@ bool DatabaseInterface::attachBackingFile(const char *path)
   }
 
   m_backingfile = path;
+  clearDirty();
+  touchStore();
 
   FILE *f = fopen(path, "rb");
   if (nullptr != f)
   {
     fread(m_store, 1, DATABASE_MAX_SIZE, f);
     fclose(f);
+    replayJournal();
     return true;
   }
 
-  commit();
+  // nothing a journal could apply to, so any left beside it is stale
+  remove(journalPath().c_str());
+  writeWholeFile();
   return true;
 }
 
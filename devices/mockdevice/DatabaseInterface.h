@@ -23,7 +23,10 @@ created Date    : 1st Jan 2024
  * DatabaseInterface class
  *
  * Keeps the config store in a plain byte array. A backing file can be attached
- * so a store survives across runs the way real NVM does.
+ * so a store survives across runs the way real NVM does. A commit lands the
+ * dirty range in a journal beside that file before patching it in place, and
+ * attaching replays a journal left whole, so a commit cut short by a crash is
+ * either finished or never happened.
  */
 class DatabaseInterface : public iDatabaseInterface
 {
@@ -43,6 +46,12 @@ public:
   void cleanAllConfigs() override;
   bool isValidConfigs() override;
   uint32_t getMaxDBSize() override;
+  bool commitConfigs() override;
+
+  /**
+   * @brief How many commits have reached the backing file.
+   */
+  uint32_t getCommitCount() const { return m_commit_count; }
 
   /**
    * @brief Back the store with a file, loading it when it already exists.
@@ -56,7 +65,8 @@ public:
   void detachBackingFile();
 
   /**
-   * template to save table in database by their address from table object
+   * template to save table in database by their address from table object.
+   * only the store changes here, commitConfigs persists it.
    *
    * @param   uint16_t  	_address
    * @param   type of database table struct  _object
@@ -64,23 +74,19 @@ public:
   template <typename T>
   void saveConfig(uint16_t _address, T *_object)
   {
-    bool _data_written = false;
     for (size_t i = 0; i < sizeof((*_object)); i++)
     {
       if ((char)readByte(_address + i) != *((char *)&(*_object) + i))
       {
-        _data_written = true;
         writeByte(_address + i, *((char *)&(*_object) + i));
+        markDirty(_address + i, 1);
       }
     }
-    if (_data_written)
-    {
-      commit();
-    }
   }
 
   /**
-   * template to load table from database by their address in table object
+   * template to load table from database by their address in table object.
+   * a table that fits the store is copied in one go.
    *
    * @param   uint16_t  	_address
    * @param   type of database table struct  _object
@@ -88,12 +94,20 @@ public:
   template <typename T>
   void loadConfig(uint16_t _address, T *_object)
   {
-    if (isValidConfigs())
+    if (!isValidConfigs())
     {
-      for (size_t i = 0; i < sizeof((*_object)); i++)
-      {
-        *((char *)&(*_object) + i) = readByte(_address + i);
-      }
+      return;
+    }
+
+    if ((uint32_t)_address + sizeof(T) <= DATABASE_MAX_SIZE)
+    {
+      memcpy((void *)_object, m_store + _address, sizeof(T));
+      return;
+    }
+
+    for (size_t i = 0; i < sizeof((*_object)); i++)
+    {
+      *((char *)&(*_object) + i) = readByte(_address + i);
     }
   }
 
@@ -114,10 +128,15 @@ private:
   uint8_t m_store[DATABASE_MAX_SIZE];
   uint32_t m_size;
   pdiutil::string m_backingfile;
+  uint32_t m_commit_count;
 
   uint8_t readByte(uint32_t address) const;
   void writeByte(uint32_t address, uint8_t value);
-  void commit();
+  bool writeWholeFile();
+  bool writeRange(const char *path, uint32_t from, uint32_t to);
+  bool writeJournal(uint32_t from, uint32_t to);
+  void replayJournal();
+  pdiutil::string journalPath() const;
 };
 
 #endif // _MOCKDEVICE_DATABASE_INTERFACE_H_
@@ -9,6 +9,7 @@ created Date    : 16th Aug 2026
 ******************************************************************************/
 
 #include "DeviceControlInterface.h"
+#include "DatabaseInterface.h"
 #ifdef ENABLE_NETWORK_SERVICE
 #include "PingInterface.h"
 #include "UdpInterface.h"
@@ -18,6 +19,7 @@ created Date    : 16th Aug 2026
 #include <utility/EventUtil.h>
 #endif
 #include <malloc.h>
+#include <poll.h>
 #include <stdio.h>
 #include <time.h>
 
@@ -28,6 +30,9 @@ static const char MOCKDEVICE_MAC[] = "02:00:00:AB:CD:EF";
 static const uint32_t MOCKDEVICE_ID = 0x00C0FFEE;
 static const uint32_t MOCKDEVICE_HEAP_SIZE = 4194304;
 
+int DeviceControlInterface::s_watched[MOCKDEVICE_MAX_WATCHED_DESCRIPTORS];
+uint16_t DeviceControlInterface::s_watched_count = 0;
+
 /**
  * DeviceControlInterface constructor.
  */
@@ -150,6 +155,8 @@ void DeviceControlInterface::resetDevice()
 
 void DeviceControlInterface::restartDevice()
 {
+    // saves still inside their commit window would be lost with the ram copy
+    __i_db.commitConfigs();
     m_restart_count++;
 }
 
@@ -299,6 +306,59 @@ void DeviceControlInterface::yield()
 #endif
 }
 
+/**
+ * block in poll on every descriptor that can bring work, so an idle pdid sits
+ * in the kernel instead of spinning a core, yet a keystroke, a connection or a
+ * datagram is picked up the moment it lands. a virtual clock only moves when
+ * its caller moves it, so there is nothing to wait for.
+ */
+void DeviceControlInterface::idle(uint32_t ms)
+{
+    if (0 == ms || m_virtual_clock)
+    {
+        return;
+    }
+
+    struct pollfd fds[MOCKDEVICE_MAX_WATCHED_DESCRIPTORS];
+    for (uint16_t i = 0; i < s_watched_count; i++)
+    {
+        fds[i].fd = s_watched[i];
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+    }
+
+    poll(fds, s_watched_count, ms > INT32_MAX ? INT32_MAX : (int)ms);
+}
+
+void DeviceControlInterface::watchDescriptor(int fd)
+{
+    if (fd < 0 || s_watched_count >= MOCKDEVICE_MAX_WATCHED_DESCRIPTORS)
+    {
+        return;
+    }
+
+    for (uint16_t i = 0; i < s_watched_count; i++)
+    {
+        if (s_watched[i] == fd)
+        {
+            return;
+        }
+    }
+    s_watched[s_watched_count++] = fd;
+}
+
+void DeviceControlInterface::unwatchDescriptor(int fd)
+{
+    for (uint16_t i = 0; i < s_watched_count; i++)
+    {
+        if (s_watched[i] == fd)
+        {
+            s_watched[i] = s_watched[--s_watched_count];
+            return;
+        }
+    }
+}
+
 #ifdef ENABLE_OTA_SERVICE
 upgrade_status_t DeviceControlInterface::Upgrade(const char *path, const char *version, void *client)
 {
@@ -14,6 +14,10 @@ created Date    : 1st Jan 2024
 #include "mockdevice.h"
 #include <interface/pdi/middlewares/iDeviceControlInterface.h>
 
+#ifndef MOCKDEVICE_MAX_WATCHED_DESCRIPTORS
+#define MOCKDEVICE_MAX_WATCHED_DESCRIPTORS 32
+#endif
+
 /**
  * Gpio's that should not be touched
  */
@@ -72,6 +76,7 @@ public:
   uint32_t get_max_free_block() override;
   void log(logger_type_t log_type, const char *content) override;
   void yield() override;
+  void idle(uint32_t ms) override;
 
   // upgrade api
 #ifdef ENABLE_OTA_SERVICE
@@ -89,6 +94,17 @@ public:
    */
   void advanceVirtualClock(uint64_t microseconds);
 
+  /**
+   * @brief Add a host descriptor whose readiness ends an idle early. Sockets
+   *        and the terminal register themselves as they open.
+   */
+  static void watchDescriptor(int fd);
+
+  /**
+   * @brief Stop waking an idle for a descriptor, before it is closed.
+   */
+  static void unwatchDescriptor(int fd);
+
   /**
    * @brief Seed the pseudo random source so a run reproduces exactly.
    */
@@ -131,6 +147,9 @@ private:
   GPIO_MODE m_pin_mode[MAX_DIGITAL_GPIO_PINS];
 
   uint64_t host_micros() const;
+
+  static int s_watched[MOCKDEVICE_MAX_WATCHED_DESCRIPTORS];
+  static uint16_t s_watched_count;
 };
 
 /**
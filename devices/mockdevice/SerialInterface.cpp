@@ -9,6 +9,7 @@ created Date    : 16th Aug 2026
 ******************************************************************************/
 
 #include "SerialInterface.h"
+#include "DeviceControlInterface.h"
 #include <errno.h>
 #include <poll.h>
 #include <string.h>
@@ -39,6 +40,7 @@ UARTSerial::UARTSerial(int readfd, int writefd) : m_connected(false),
                                                   m_writefd(writefd),
                                                   m_peeked(-1)
 {
+    DeviceControlInterface::watchDescriptor(m_readfd);
 }
 
 /**
@@ -207,6 +209,8 @@ void UARTSerial::flush(int16_t flushtype)
 
 void UARTSerial::setDescriptors(int readfd, int writefd)
 {
+    DeviceControlInterface::unwatchDescriptor(m_readfd);
+    DeviceControlInterface::watchDescriptor(readfd);
     m_readfd = readfd;
     m_writefd = writefd;
     m_peeked = -1;
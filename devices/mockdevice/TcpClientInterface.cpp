@@ -9,6 +9,7 @@ created Date    : 16th Aug 2026
 ******************************************************************************/
 
 #include "TcpClientInterface.h"
+#include "DeviceControlInterface.h"
 #include <arpa/inet.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -48,6 +49,7 @@ TcpClientInterface::TcpClientInterface(int socketfd) : m_socket(socketfd), m_tim
     if (m_socket >= 0)
     {
         setNonBlocking(m_socket);
+        DeviceControlInterface::watchDescriptor(m_socket);
     }
 }
 
@@ -60,6 +62,7 @@ void TcpClientInterface::closeSocket()
 {
     if (m_socket >= 0)
     {
+        DeviceControlInterface::unwatchDescriptor(m_socket);
         ::close(m_socket);
         m_socket = -1;
     }
@@ -139,6 +142,7 @@ int16_t TcpClientInterface::connect(const uint8_t *host, uint16_t port)
         }
     }
 
+    DeviceControlInterface::watchDescriptor(m_socket);
     return 0;
 }
 
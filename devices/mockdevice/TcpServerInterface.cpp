@@ -10,6 +10,7 @@ created Date    : 16th Aug 2026
 
 #include "TcpServerInterface.h"
 #include "TcpClientInterface.h"
+#include "DeviceControlInterface.h"
 #include <arpa/inet.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -111,6 +112,7 @@ int32_t TcpServerInterface::begin(uint16_t port)
         fcntl(m_socket, F_SETFL, flags | O_NONBLOCK);
     }
 
+    DeviceControlInterface::watchDescriptor(m_socket);
     return 0;
 }
 
@@ -171,6 +173,7 @@ void TcpServerInterface::close()
 {
     if (m_socket >= 0)
     {
+        DeviceControlInterface::unwatchDescriptor(m_socket);
         ::close(m_socket);
         m_socket = -1;
     }
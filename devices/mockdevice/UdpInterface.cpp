@@ -9,6 +9,7 @@ created Date    : 16th Aug 2026
 ******************************************************************************/
 
 #include "UdpInterface.h"
+#include "DeviceControlInterface.h"
 #include <arpa/inet.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -96,6 +97,7 @@ bool UdpInterface::begin(uint16_t local_port)
     }
 
     track();
+    DeviceControlInterface::watchDescriptor(m_socket);
     return true;
 }
 
@@ -144,6 +146,7 @@ void UdpInterface::close()
 
     if (m_socket >= 0)
     {
+        DeviceControlInterface::unwatchDescriptor(m_socket);
         ::close(m_socket);
         m_socket = -1;
     }
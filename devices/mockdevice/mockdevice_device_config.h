@@ -54,5 +54,6 @@ created Date    : 16th Aug 2026
 #define ENABLE_NETWORK_SERVICE
 #define ENABLE_AUTH_SERVICE
 #define ENABLE_CMD_SERVICE
+#define ENABLE_SYSLOG_SERVICE
 
 #endif // _MOCKDEVICE_DEVICE_CONFIG_H_
@@ -43,35 +43,35 @@ class TestController : public Controller {
       LogI("Handling Test route\n");
 
       /**
-       * take new dynamic array to build html response page
-       * PAGE_HTML_MAX_SIZE defined in framework as 5000
+       * take a page writer to stream the html response page to the client
+       * it holds one PAGE_WRITER_CHUNK_SIZE chunk and sends it whenever it fills up
        */
-      char* _page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-      if( nullptr == _page ) return;
+      PageWriter _page(this->m_web_resource->m_server);
+      if( !_page.ok() ) return;
+      _page.begin( HTTP_RESP_OK, MIME_TYPE_TEXT_HTML );
 
       /**
        * first append header part of html to reponse
   		 */
-			strcat_ro( _page, WEB_SERVER_HEADER_HTML );
+			_page.append_ro( WEB_SERVER_HEADER_HTML );
 
       /**
        * then append body part of html to response
        * for demo purpose, dashboard card added with the help of html helpers available in framework
   		 */
-			strcat_ro( _page, WEB_SERVER_MENU_CARD_PAGE_WRAP_TOP );
+			_page.append_ro( WEB_SERVER_MENU_CARD_PAGE_WRAP_TOP );
 			concat_svg_menu_card( _page, WEB_SERVER_HOME_MENU_TITLE_DASHBOARD, SVG_ICON48_PATH_DASHBOARD, WEB_SERVER_DASHBOARD_ROUTE );
-			strcat_ro( _page, WEB_SERVER_MENU_CARD_PAGE_WRAP_BOTTOM );
+			_page.append_ro( WEB_SERVER_MENU_CARD_PAGE_WRAP_BOTTOM );
 
       /**
        * lastely append footer part of html to response
   		 */
-			strcat_ro( _page, WEB_SERVER_FOOTER_HTML );
+			_page.append_ro( WEB_SERVER_FOOTER_HTML );
 
       /**
-       * finally send response and deallocate page
+       * finally send what is left and end the response
   		 */
-      this->m_web_resource->m_server->send( HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page );
-      pdiutil::safe_delete_array(_page);
+      _page.end();
     }
 };
 
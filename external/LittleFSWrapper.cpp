@@ -12,6 +12,8 @@ created Date    : 6th Apr 2025
 ******************************************************************************/
 
 #include "LittleFSWrapper.h"
+#include "interface/pdi/modules/storage/FileCopyEngine.h"
+#include "interface/pdi/modules/storage/FileLineIndex.h"
 
 // Map a LittleFS return (LFS_ERR_* negative, or a non-negative count/size) onto
 // the framework error space. Non-negative values (count/size) pass through
@@ -31,9 +33,11 @@ static int lfsToPdiErr(int rc) {
  * system, and formats it if mounting fails.
  */
 LittleFSWrapper::LittleFSWrapper(iStorageInterface& storage, bool defaultConfig)
-    : iFileSystemInterface(storage), m_mounted(false) {
+    : iFileSystemInterface(storage), m_mounted(false),
+      m_usedMap(nullptr), m_usedBlocks(0), m_usageStale(true) {
     memset(&m_lfs, 0, sizeof(m_lfs));
     memset(&m_lfscfg, 0, sizeof(m_lfscfg));
+    memset(m_handles, 0, sizeof(m_handles));
     if (defaultConfig) {
         initLFSConfig();
     }
@@ -43,10 +47,12 @@ LittleFSWrapper::LittleFSWrapper(iStorageInterface& storage, bool defaultConfig)
  * @brief Destructor to unmount the LittleFS file system.
  */
 LittleFSWrapper::~LittleFSWrapper() {
+    closeAllFiles();
     if (m_mounted) {
         lfs_unmount(&m_lfs);
         m_mounted = false;
     }
+    pdiutil::safe_delete_array(m_usedMap);
 }
 
 /**
@@ -56,6 +62,7 @@ LittleFSWrapper::~LittleFSWrapper() {
  */
 int LittleFSWrapper::initLFSConfig(lfs_config *lfscnfg)
 {
+    closeAllFiles();
     if (m_mounted) {
         lfs_unmount(&m_lfs);
         m_mounted = false;
@@ -90,6 +97,12 @@ int LittleFSWrapper::initLFSConfig(lfs_config *lfscnfg)
 
     m_lfscfg.context = this; // Context for lfs storage operations
 
+    // one bit per block, sized afresh since the block count may have changed
+    pdiutil::safe_delete_array(m_usedMap);
+    m_usedMap = pdiutil::safe_new_array<uint8_t>((m_lfscfg.block_count + 7) / 8);
+    m_usedBlocks = 0;
+    m_usageStale = true;
+
     // Mount the file system
     int ret = lfs_mount(&m_lfs, &m_lfscfg);
     if (ret != LFS_ERR_OK) {
@@ -99,6 +112,9 @@ int LittleFSWrapper::initLFSConfig(lfs_config *lfscnfg)
     }
 
     m_mounted = (ret == LFS_ERR_OK);
+    if (m_mounted) {
+        countUsage();
+    }
 
     return lfsToPdiErr(ret); // Success
 }
@@ -180,6 +196,7 @@ int LittleFSWrapper::editFile(const char* path, uint64_t offset, const char* con
 
     if( bytesWrittenOrErr >= 0 ){
         stampModify(path);
+        updateLineIndex(path, offset);
     }
 
     return lfsToPdiErr(bytesWrittenOrErr);
@@ -210,6 +227,7 @@ int LittleFSWrapper::writeFile(const char *path, const char *content, uint32_t s
     if( bytesWrittenOrErr >= 0 ){
         if( preExisted ){
             stampModify(path);
+            updateLineIndex(path, append ? UINT64_MAX : 0);
         } else {
             stampCreate(path, false);
         }
@@ -227,7 +245,7 @@ int LittleFSWrapper::writeFile(const char *path, const char *content, uint32_t s
  * @param didmatchfound Optional pointer to a boolean that will be set to true if the match string was found.
  * @return The number of bytes read, or -1 on failure.
  */
-int LittleFSWrapper::readFile(const char* path, uint64_t size, pdiutil::function<bool(char *, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool *didmatchfound) {
+int LittleFSWrapper::readFile(const char* path, uint64_t size, pdiutil::function_ref<bool(char *, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool *didmatchfound) {
     lfs_file_t file;
     int32_t okOrErr = lfs_file_open(&m_lfs, &file, path, LFS_O_RDONLY);
     if (okOrErr < 0) {
@@ -390,6 +408,163 @@ void LittleFSWrapper::stampModify(const char *path){
     lfs_setattr(&m_lfs, path, FILE_ATTR_MTIME, &now, sizeof(now));
 }
 
+/**
+ * @brief Get the open file behind a handle.
+ * @return The open file, or nullptr when the handle is not open.
+ */
+LittleFSWrapper::lfs_handle_t* LittleFSWrapper::handleOf(int16_t fd) const {
+    if (fd < 0 || fd >= VFS_MAX_OPEN_FILES) {
+        return nullptr;
+    }
+    return m_handles[fd];
+}
+
+/**
+ * @brief Close every open file, before the file system is unmounted. Runs
+ * from the destructor too, so nothing is stamped here.
+ */
+void LittleFSWrapper::closeAllFiles() {
+    for (int16_t fd = 0; fd < VFS_MAX_OPEN_FILES; fd++) {
+        if (nullptr != m_handles[fd]) {
+            if (m_mounted) {
+                lfs_file_close(&m_lfs, &m_handles[fd]->m_file);
+            }
+            pdiutil::safe_delete(m_handles[fd]);
+            m_handles[fd] = nullptr;
+        }
+    }
+}
+
+/**
+ * @brief Opens a file and keeps its LittleFS handle until closeFile.
+ * @param path The path of the file to open.
+ * @param flags file_open_flag_t bits, or'd together.
+ * @return A handle >= 0, or a negative error code on failure.
+ */
+int16_t LittleFSWrapper::openFile(const char *path, uint8_t flags) {
+    if (nullptr == path) {
+        return PDI_ERR_INVALID_ARG;
+    }
+
+    int lfsflags = 0;
+    if (flags & FILE_OPEN_READ) lfsflags |= LFS_O_RDONLY;
+    if (flags & (FILE_OPEN_WRITE | FILE_OPEN_APPEND)) lfsflags |= LFS_O_WRONLY;
+    if (0 == lfsflags) {
+        return PDI_ERR_INVALID_ARG;
+    }
+    if (flags & FILE_OPEN_CREATE) lfsflags |= LFS_O_CREAT;
+    if (flags & FILE_OPEN_EXCL) lfsflags |= LFS_O_EXCL;
+    if (flags & FILE_OPEN_TRUNC) lfsflags |= LFS_O_TRUNC;
+    if (flags & FILE_OPEN_APPEND) lfsflags |= LFS_O_APPEND;
+
+    int16_t fd = 0;
+    while (fd < VFS_MAX_OPEN_FILES && nullptr != m_handles[fd]) {
+        fd++;
+    }
+    if (fd >= VFS_MAX_OPEN_FILES) {
+        return PDI_ERR_FULL;
+    }
+
+    bool preExisted = (flags & FILE_OPEN_CREATE) ? isFileExist(path) : true;
+
+    lfs_handle_t *handle = pdiutil::safe_new<lfs_handle_t>();
+    if (nullptr == handle) {
+        return PDI_ERR_NO_MEM;
+    }
+    int fileOpenOrErr = lfs_file_open(&m_lfs, &handle->m_file, path, lfsflags);
+    if (fileOpenOrErr < 0) {
+        pdiutil::safe_delete(handle);
+        return lfsToPdiErr(fileOpenOrErr);
+    }
+
+    handle->m_path = path;
+    handle->m_created = !preExisted;
+    handle->m_modified = preExisted && (flags & FILE_OPEN_TRUNC);
+    handle->m_dirtyFrom = handle->m_modified ? 0 : UINT64_MAX;
+    m_handles[fd] = handle;
+    return fd;
+}
+
+/**
+ * @brief Reads from the current position of an open file.
+ * @param fd Handle returned by openFile.
+ * @param buffer Buffer to receive the data.
+ * @param size Capacity of the buffer in bytes.
+ * @return The number of bytes read, 0 at end of file, or a negative error code.
+ */
+int32_t LittleFSWrapper::readHandle(int16_t fd, char *buffer, uint32_t size) {
+    lfs_handle_t *handle = handleOf(fd);
+    if (nullptr == handle || nullptr == buffer) {
+        return PDI_ERR_INVALID_ARG;
+    }
+    return lfsToPdiErr(lfs_file_read(&m_lfs, &handle->m_file, buffer, size));
+}
+
+/**
+ * @brief Writes at the current position of an open file.
+ * @param fd Handle returned by openFile.
+ * @param buffer The data to write.
+ * @param size The number of bytes to write.
+ * @return The number of bytes written, or a negative error code on failure.
+ */
+int32_t LittleFSWrapper::writeHandle(int16_t fd, const char *buffer, uint32_t size) {
+    lfs_handle_t *handle = handleOf(fd);
+    if (nullptr == handle || nullptr == buffer) {
+        return PDI_ERR_INVALID_ARG;
+    }
+    int bytesWrittenOrErr = lfs_file_write(&m_lfs, &handle->m_file, buffer, size);
+    if (bytesWrittenOrErr > 0) {
+        handle->m_modified = true;
+        uint64_t at = (uint64_t)lfs_file_tell(&m_lfs, &handle->m_file) - bytesWrittenOrErr;
+        if (at < handle->m_dirtyFrom) {
+            handle->m_dirtyFrom = at;
+        }
+    }
+    return lfsToPdiErr(bytesWrittenOrErr);
+}
+
+/**
+ * @brief Moves the position of an open file.
+ * @param fd Handle returned by openFile.
+ * @param offset Offset from whence.
+ * @param whence Where the offset counts from.
+ * @return The new position, or a negative error code on failure.
+ */
+int64_t LittleFSWrapper::seekHandle(int16_t fd, int64_t offset, file_seek_t whence) {
+    lfs_handle_t *handle = handleOf(fd);
+    if (nullptr == handle) {
+        return PDI_ERR_INVALID_ARG;
+    }
+    int lfswhence = LFS_SEEK_SET;
+    if (FILE_SEEK_CUR == whence) lfswhence = LFS_SEEK_CUR;
+    else if (FILE_SEEK_END == whence) lfswhence = LFS_SEEK_END;
+    return lfsToPdiErr(lfs_file_seek(&m_lfs, &handle->m_file, (lfs_soff_t)offset, lfswhence));
+}
+
+/**
+ * @brief Closes an open file and stamps its times once for the whole session.
+ * @param fd Handle returned by openFile.
+ * @return 0 on success, or a negative error code on failure.
+ */
+pdi_err_t LittleFSWrapper::closeFile(int16_t fd) {
+    lfs_handle_t *handle = handleOf(fd);
+    if (nullptr == handle) {
+        return PDI_ERR_INVALID_ARG;
+    }
+    int okOrErr = lfs_file_close(&m_lfs, &handle->m_file);
+    if (okOrErr >= 0) {
+        if (handle->m_created) {
+            stampCreate(handle->m_path.c_str(), false);
+        } else if (handle->m_modified) {
+            stampModify(handle->m_path.c_str());
+            updateLineIndex(handle->m_path.c_str(), handle->m_dirtyFrom);
+        }
+    }
+    m_handles[fd] = nullptr;
+    pdiutil::safe_delete(handle);
+    return lfsToPdiErr(okOrErr);
+}
+
 /**
  * @brief Find the string in file.
  * @param path The path of the file to find in.
@@ -478,182 +653,263 @@ int LittleFSWrapper::findInFile(const char* path, const char* findStr, pdiutil::
 /**
  * @brief Find the offset in file if line number given.
  * @param path The path of the file to find in.
- * @param linenumber line number to count offset till.
+ * @param linenumber line number to count offset till. A negative one counts
+ *        back from the last line.
  * @param yield Optional callback function to yield control during long operations.
  * @return The offset found, or -1 on failure.
  */
 int64_t LittleFSWrapper::getOffsetFromLineNumber(const char* path, int linenumber, CallBackVoidArgFn yield){
 
+    lfs_lines_t lines;
+    FileLineIndex index;
+    bool indexed = false;
+    int okOrErr = openLines(path, lines, index, indexed);
+    if( okOrErr < 0 ) return okOrErr; // error
+
     int64_t offset = 0;
 
-    if( linenumber < 0 ){
+    if( linenumber < 0 && !indexed ){
 
-        uint32_t totalnumberoflines = 0;
-        int iStatus = readFile(path, 250, [&](char *data, uint32_t size)->bool{
-            for(uint32_t i = 0; i < size; i++){
-                if(data[i] == '\n') totalnumberoflines++;
-            }
-            return true;
-        });
-        if( iStatus < 0 ) return iStatus; // error
+        // only the tail of the file is read, from its end backwards
+        offset = lineStartFromEnd(lines.m_file, (uint32_t)(-(int64_t)linenumber), yield);
 
-        int64_t fs = getFileSize(path);
-        if( fs > 0 ){
-            char lastChar = '\n';
-            readFile(path, 1, [&](char *data, uint32_t size) -> bool {
-                if(size > 0) lastChar = data[0];
-                return true;
-            }, (uint64_t)(fs - 1));
-            if( lastChar != '\n' ){
-                totalnumberoflines++;
-            }
+    }else{
+
+        if( linenumber < 0 ){
+            linenumber = (int)index.lines() + linenumber;
         }
 
-        linenumber = totalnumberoflines + linenumber;
-        if( linenumber < 0 ) return PDI_ERR_RANGE;
+        if( linenumber < 0 ){
+            offset = PDI_ERR_RANGE;
+        }else if( indexed && (uint32_t)linenumber > index.newlines() ){
+            offset = index.size();
+        }else if( linenumber > 0 ){
+            uint32_t from = 0;
+            uint32_t line = indexed ? index.lineBefore((uint32_t)linenumber, from) : 0;
+            offset = skipLines(lines.m_file, from, (uint32_t)linenumber - line, yield);
+        }
     }
 
-    // Find the file content offset from line number offset
-    if( linenumber > 0 ){
+    lfs_file_close(&m_lfs, &lines.m_file);
+    return offset;
+}
 
-        int newlinesFound = 0;
+/**
+ * @brief Find the line in file if offset given.
+ * @param path The path of the file to find in.
+ * @param offset offset to find line number for.
+ * @param yield Optional callback function to yield control during long operations.
+ * @return The line number found, or -1 on failure.
+ */
+int64_t LittleFSWrapper::getLineNumberFromOffset(const char* path, int64_t offset, CallBackVoidArgFn yield){
+    
+    lfs_lines_t lines;
+    FileLineIndex index;
+    bool indexed = false;
+    int okOrErr = openLines(path, lines, index, indexed);
+    if( okOrErr < 0 ) return okOrErr; // error
 
-        int iStatus = readFile(path, 250, [&](char *data, uint32_t size)->bool{
+    int64_t filesize = lfs_file_size(&m_lfs, &lines.m_file);
+    int64_t linenumber = 0;
 
-            for(uint32_t i = 0; i < size; i++){
+    if( offset < 0 ){
+        offset = filesize + offset;
+    }
 
-                if(data[i] == '\n') {
+    if( offset > 0 ){
 
-                    newlinesFound++;
+        if( indexed && offset >= filesize ){
 
-                    if(newlinesFound >= linenumber){
+            linenumber = index.newlines();
 
-                        offset += i + 1;
-                        return false;
-                    }
-                }
+        }else{
+
+            uint32_t from = 0;
+            if( indexed ){
+                linenumber = index.lineAt((uint32_t)offset, from);
             }
 
-            offset += size;
+            int64_t counted = countLines(lines.m_file, from, (uint64_t)offset, yield);
+            linenumber = (counted < 0) ? counted : linenumber + counted;
+        }
+    }
 
-            if(yield){
-                yield();
-            }
+    lfs_file_close(&m_lfs, &lines.m_file);
+    return linenumber;
+}
 
-            return true;
-        });
+/**
+ * @brief Opens a file for a line lookup, reading its line index at the same
+ *        time so the lookup costs one walk to the file.
+ * @param indexed Set when the index is there and still covers the whole file.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int LittleFSWrapper::openLines(const char *path, lfs_lines_t &lines, FileLineIndex &index, bool &indexed){
+
+    memset(&lines.m_cfg, 0, sizeof(lines.m_cfg));
+    lines.m_attr.type = FILE_ATTR_LINES;
+    lines.m_attr.buffer = index.clear();
+    lines.m_attr.size = index.room();
+    lines.m_cfg.attrs = &lines.m_attr;
+    lines.m_cfg.attr_count = 1;
+
+    int okOrErr = lfs_file_opencfg(&m_lfs, &lines.m_file, path, LFS_O_RDONLY, &lines.m_cfg);
+    if( okOrErr < 0 ){
+        return lfsToPdiErr(okOrErr); // Failed to open file
+    }
+
+    indexed = index.loaded() && (lfs_soff_t)index.size() == lfs_file_size(&m_lfs, &lines.m_file);
+    return 0;
+}
+
+/**
+ * @brief Offset just past the given number of newlines, counted from an offset.
+ * @return The offset, the file size when it has fewer, or a negative error code.
+ */
+int64_t LittleFSWrapper::skipLines(lfs_file_t &file, uint64_t from, uint32_t lines, CallBackVoidArgFn yield){
 
-        if( iStatus < 0 ) return iStatus; // error
+    char buffer[VFS_LINE_SCAN_BLOCK];
+    int64_t offset = (int64_t)from;
+    uint32_t newlinesFound = 0;
+    int bytesReadOrErr = 0;
 
-        // int filesize = getFileSize(path);
-        // if(filesize < 0){
-        //     return filesize;
-        // }
+    lfs_file_seek(&m_lfs, &file, (lfs_soff_t)from, LFS_SEEK_SET);
 
-        // int newlinesFound = 0;
-        // bool didmatchfound = false;
+    while( (bytesReadOrErr = lfs_file_read(&m_lfs, &file, buffer, sizeof(buffer))) > 0 ){
 
-        // do
-        // {
-        //     int bytesReadOrErr = readFile(path, 250, [&](char *data, uint32_t size) -> bool {
-        //         return true;
-        //     }, offset, "\n", &didmatchfound);
+        for(int i = 0; i < bytesReadOrErr; i++){
 
-        //     if(bytesReadOrErr < 0){
-        //         return lfsToPdiErr(bytesReadOrErr);
-        //     }
+            if(buffer[i] == '\n' && ++newlinesFound >= lines){
+                return offset + i + 1;
+            }
+        }
 
-        //     offset += bytesReadOrErr + 1;
-        //     if(didmatchfound){
-        //         newlinesFound++;
-        //         didmatchfound = false;
-        //     }
+        offset += bytesReadOrErr;
 
-        //     if(yield){
-        //         yield();
-        //     }
-        // } while (offset < (uint64_t)filesize && newlinesFound < linenumber);
+        if(yield){
+            yield();
+        }
     }
 
-    return offset;
+    return (bytesReadOrErr < 0) ? lfsToPdiErr(bytesReadOrErr) : offset;
 }
 
 /**
- * @brief Find the line in file if offset given.
- * @param path The path of the file to find in.
- * @param offset offset to find line number for.
- * @param yield Optional callback function to yield control during long operations.
- * @return The line number found, or -1 on failure.
+ * @brief Number of newlines between two offsets, the second one excluded.
+ * @return The count, or a negative error code.
  */
-int64_t LittleFSWrapper::getLineNumberFromOffset(const char* path, int64_t offset, CallBackVoidArgFn yield){
-    
-    int64_t linenumber = 0;
-    int64_t filesize = getFileSize(path);
-    if( filesize < 0 ){
-        return filesize; // error
-    }
+int64_t LittleFSWrapper::countLines(lfs_file_t &file, uint64_t from, uint64_t to, CallBackVoidArgFn yield){
 
-    if( offset < 0 ){
-        offset = filesize + offset;
-    }
+    char buffer[VFS_LINE_SCAN_BLOCK];
+    int64_t newlinesFound = 0;
+    int bytesReadOrErr = 0;
 
-    // Find the line number from offset
-    if( offset > 0 ){
+    lfs_file_seek(&m_lfs, &file, (lfs_soff_t)from, LFS_SEEK_SET);
 
-        int64_t offsetcount = 0;
-        int iStatus = readFile(path, 250, [&](char *data, uint32_t size)->bool{
+    while( from < to ){
 
-            for(uint32_t i = 0; i < size; i++){
-                
-                if(offset <= (offsetcount + i)){
-                    return false;
-                }
+        lfs_size_t chunk = (to - from < sizeof(buffer)) ? (lfs_size_t)(to - from) : sizeof(buffer);
+        bytesReadOrErr = lfs_file_read(&m_lfs, &file, buffer, chunk);
+        if( bytesReadOrErr <= 0 ){
+            break;
+        }
 
-                if(data[i] == '\n') {
-                    linenumber++;
-                }
+        for(int i = 0; i < bytesReadOrErr; i++){
+            if(buffer[i] == '\n') {
+                newlinesFound++;
             }
+        }
 
-            offsetcount += size;
-            
-            if(yield){
-                yield();
+        from += bytesReadOrErr;
+
+        if(yield){
+            yield();
+        }
+    }
+
+    return (bytesReadOrErr < 0) ? lfsToPdiErr(bytesReadOrErr) : newlinesFound;
+}
+
+/**
+ * @brief Where the count-th line from the end starts, found by reading the
+ *        file backwards a block at a time so a tail costs what it shows.
+ * @return The offset, PDI_ERR_RANGE when the file has fewer lines, or a
+ *         negative error code.
+ */
+int64_t LittleFSWrapper::lineStartFromEnd(lfs_file_t &file, uint32_t count, CallBackVoidArgFn yield){
+
+    char buffer[VFS_LINE_SCAN_BLOCK];
+    lfs_soff_t filesize = lfs_file_size(&m_lfs, &file);
+    lfs_soff_t end = filesize;
+    uint32_t newlinesFound = 0;
+
+    while( end > 0 ){
+
+        lfs_size_t chunk = lfs_min(sizeof(buffer), (lfs_size_t)end);
+        lfs_soff_t start = end - chunk;
+
+        lfs_file_seek(&m_lfs, &file, start, LFS_SEEK_SET);
+        int bytesReadOrErr = lfs_file_read(&m_lfs, &file, buffer, chunk);
+        if( bytesReadOrErr != (int)chunk ){
+            return (bytesReadOrErr < 0) ? lfsToPdiErr(bytesReadOrErr) : PDI_ERR_IO;
+        }
+
+        for(lfs_size_t i = chunk; i > 0; i--){
+
+            // the newline ending the last line does not start another one
+            if(buffer[i - 1] == '\n' && (start + (lfs_soff_t)i) < filesize && ++newlinesFound == count){
+                return start + i;
             }
+        }
 
-            return true;
-        });
-        if( iStatus < 0 ) return iStatus; // error
+        end = start;
 
-        // int64_t offsetcount = 0;
-        // bool didmatchfound = false;
+        if(yield){
+            yield();
+        }
+    }
 
-        // do
-        // {
-        //     int bytesReadOrErr = readFile(path, 250, [&](char *data, uint32_t size) -> bool {
-        //         return true;
-        //     }, offsetcount, "\n", &didmatchfound);
+    // reached the start, which is where the first line begins
+    return (filesize > 0 && newlinesFound + 1 == count) ? 0 : PDI_ERR_RANGE;
+}
 
-        //     if(bytesReadOrErr < 0){
-        //         return lfsToPdiErr(bytesReadOrErr);
-        //     }
+/**
+ * @brief Bring the line index of a written file up to date, re-counting from
+ *        the first byte that changed. Files without an index are left alone.
+ * @param from The first byte written, or UINT64_MAX for an append.
+ */
+void LittleFSWrapper::updateLineIndex(const char *path, uint64_t from){
 
-        //     offsetcount += bytesReadOrErr + 1;
-        //     if(didmatchfound){
-        //         if((offsetcount - 1) < (uint64_t)offset){
-        //             linenumber++;
-        //         }else{
-        //             break;
-        //         }
-        //         didmatchfound = false;
-        //     }
+    FileLineIndex index;
+    int length = lfs_getattr(&m_lfs, path, FILE_ATTR_LINES, index.clear(), index.room());
+    if( length < 0 ){
+        return; // not indexed
+    }
 
-        //     if(yield){
-        //         yield();
-        //     }
-        // } while (offsetcount < (uint64_t)offset && offsetcount < (uint64_t)filesize);
+    lfs_info info;
+    if( lfs_stat(&m_lfs, path, &info) < 0 ){
+        return;
     }
 
-    return linenumber;
+    if( index.loaded() && (uint32_t)length == index.length() ){
+        index.rewind(from > info.size ? info.size : (uint32_t)from);
+        if( index.size() > info.size ){
+            index.reset();
+        }
+    }else{
+        index.reset();
+    }
+
+    int iStatus = readFile(path, VFS_LINE_SCAN_BLOCK, [&](char *data, uint32_t size)->bool{
+        index.feed(data, size);
+        return true;
+    }, index.size());
+
+    if( iStatus < 0 || index.size() != info.size ||
+        lfs_setattr(&m_lfs, path, FILE_ATTR_LINES, index.data(), index.length()) < 0 ){
+        // a stale index is worse than none
+        lfs_removeattr(&m_lfs, path, FILE_ATTR_LINES);
+    }
 }
 
 /**
@@ -781,6 +1037,27 @@ int LittleFSWrapper::readLineInFile(const char* path, int32_t linenumber, pdiuti
     return lfsToPdiErr(bytesReadedOrError);
 }
 
+/**
+ * @brief Builds the file's line index and keeps it as FILE_ATTR_LINES.
+ * @param path The path of the file to index.
+ * @param yield Optional callback function to yield control during long operations.
+ * @return 0 on success, or a negative error code on failure.
+ */
+pdi_err_t LittleFSWrapper::indexLines(const char* path, CallBackVoidArgFn yield){
+
+    FileLineIndex index;
+    int iStatus = readFile(path, VFS_LINE_SCAN_BLOCK, [&](char *data, uint32_t size)->bool{
+        index.feed(data, size);
+        if(yield){
+            yield();
+        }
+        return true;
+    });
+
+    if( iStatus < 0 ) return iStatus; // error
+
+    return lfsToPdiErr(lfs_setattr(&m_lfs, path, FILE_ATTR_LINES, index.data(), index.length()));
+}
 
 /**
  * @brief Creates a directory.
@@ -874,16 +1151,16 @@ pdi_err_t LittleFSWrapper::rename(const char* oldPath, const char* newPath) {
 }
 
 /**
- * @brief Copies a file to a new path.
+ * @brief Copies a file to a new path, a block at a time. A block is at least
+ *        the cache size, so lfs moves it between the file and the flash
+ *        directly instead of one cache line per call.
  * @param sourcePath The path of the source file.
  * @param destPath The path of the destination file.
- * @return 0 on success, or a negative error code on failure.
+ * @param progress Optional, called after every block; false stops the copy.
+ * @return 0 on success, or a negative error code on failure. A failed or
+ *         stopped copy leaves no destination behind.
  */
-pdi_err_t LittleFSWrapper::copyFile(const char* sourcePath, const char* destPath) {
-    // Buffer to store file content
-    char buffer[m_lfscfg.read_size];
-    memset(buffer, 0, sizeof(buffer));
-
+pdi_err_t LittleFSWrapper::copyFile(const char* sourcePath, const char* destPath, CallBackCopyProgressFn progress) {
     lfs_file_t sourceFile;
     int fileOpenOrErr = lfs_file_open(&m_lfs, &sourceFile, sourcePath, LFS_O_RDONLY);
     if (fileOpenOrErr < 0) {
@@ -893,20 +1170,33 @@ pdi_err_t LittleFSWrapper::copyFile(const char* sourcePath, const char* destPath
     lfs_file_t destFile;
     fileOpenOrErr = lfs_file_open(&m_lfs, &destFile, destPath, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
     if (fileOpenOrErr < 0) {
+        lfs_file_close(&m_lfs, &sourceFile);
         return lfsToPdiErr(fileOpenOrErr); // Failed to open/create file
     }
 
-    // Copy the content from source file to destination file
-    lfs_size_t filesize = lfs_file_size(&m_lfs, &sourceFile); 
-    for (lfs_size_t i = 0; i < filesize; i += m_lfscfg.read_size) {
-        lfs_size_t chunk = lfs_min(m_lfscfg.read_size, filesize - i);
-        lfs_file_read(&m_lfs, &sourceFile, buffer, chunk);
-        lfs_file_write(&m_lfs, &destFile, buffer, chunk);
-    }
+    lfs_soff_t filesize = lfs_file_size(&m_lfs, &sourceFile);
+    FileCopyEngine engine(m_lfscfg.block_size, filesize > 0 ? (uint64_t)filesize : 0);
+    int64_t copied = engine.run(
+        [&](char* buffer, uint32_t size) -> int32_t {
+            lfs_ssize_t n = lfs_file_read(&m_lfs, &sourceFile, buffer, size);
+            return n < 0 ? lfsToPdiErr((int)n) : (int32_t)n;
+        },
+        [&](const char* buffer, uint32_t size) -> int32_t {
+            lfs_ssize_t n = lfs_file_write(&m_lfs, &destFile, buffer, size);
+            return n < 0 ? lfsToPdiErr((int)n) : (int32_t)n;
+        },
+        [&](uint64_t done, uint64_t total) -> bool {
+            copyYield();
+            return !progress || progress(done, total);
+        });
 
     // Close the files
     lfs_file_close(&m_lfs, &sourceFile);
-    lfs_file_close(&m_lfs, &destFile);
+    int closed = lfs_file_close(&m_lfs, &destFile);
+    if (copied < 0 || closed < 0) {
+        lfs_remove(&m_lfs, destPath);
+        return (copied < 0) ? (pdi_err_t)copied : lfsToPdiErr(closed);
+    }
 
     // Fresh entry: stamp ctime/mtime, then carry over source perms if present.
     stampCreate(destPath, false);
@@ -933,7 +1223,7 @@ pdi_err_t LittleFSWrapper::deleteFile(const char *path){
  * @param newPath The new path of the file.
  * @return 0 on success, or a negative error code on failure.
  */
-pdi_err_t LittleFSWrapper::moveFile(const char *oldPath, const char *newPath){
+pdi_err_t LittleFSWrapper::moveFile(const char *oldPath, const char *newPath, CallBackCopyProgressFn){
     return lfsToPdiErr(lfs_rename(&m_lfs, oldPath, newPath));
 }
 
@@ -1080,21 +1370,13 @@ uint64_t LittleFSWrapper::getTotalSize() {
  * @return The used size of the file system in bytes.
  */
 uint64_t LittleFSWrapper::getUsedSize() {
-    lfs_info info;
-    int32_t usedBlocks = lfs_fs_size(&m_lfs);
-
-    // Iterate through all files and directories to calculate used blocks
-    // lfs_dir_t dir;
-    // if (lfs_dir_open(&m_lfs, &dir, "/") == 0) {
-    //     while (lfs_dir_read(&m_lfs, &dir, &info) > 0) {
-    //         if (info.type == LFS_TYPE_REG || info.type == LFS_TYPE_DIR) {
-    //             usedBlocks += (info.size + m_lfscfg.block_size - 1) / m_lfscfg.block_size;
-    //         }
-    //     }
-    //     lfs_dir_close(&m_lfs, &dir);
-    // }
-
-    return usedBlocks * m_lfscfg.block_size;
+    if (!m_mounted) {
+        return 0;
+    }
+    if (nullptr == m_usedMap && m_usageStale) {
+        countUsage();
+    }
+    return (uint64_t)m_usedBlocks * m_lfscfg.block_size;
 }
 
 /**
@@ -1107,6 +1389,70 @@ uint64_t LittleFSWrapper::getFreeSize() {
     return totalSize > usedSize ? totalSize - usedSize : 0;
 }
 
+/**
+ * @brief Recounts the blocks in use when anything was written since the
+ *        last count, giving back the ones freed meanwhile.
+ * @return 0 on success, or a negative error code on failure.
+ */
+pdi_err_t LittleFSWrapper::scrubUsage() {
+    if (!m_mounted) {
+        return STORAGE_ERROR_NOT_MOUNTED;
+    }
+    if (!m_usageStale) {
+        return PDI_OK;
+    }
+    return lfsToPdiErr(countUsage());
+}
+
+/**
+ * @brief Marks a block LittleFS has just taken up.
+ * @param block The block erased or programmed.
+ */
+void LittleFSWrapper::markUsed(lfs_block_t block) {
+    // whatever was rewritten may have left an older copy behind
+    m_usageStale = true;
+    if (nullptr == m_usedMap || block >= m_lfscfg.block_count) {
+        return;
+    }
+    uint8_t bit = (uint8_t)(1 << (block % 8));
+    if (0 == (m_usedMap[block / 8] & bit)) {
+        m_usedMap[block / 8] |= bit;
+        m_usedBlocks++;
+    }
+}
+
+/**
+ * @brief Counts the blocks in use by walking the whole tree.
+ * @return 0 on success, or a negative LittleFS error code.
+ */
+int LittleFSWrapper::countUsage() {
+    int err;
+    if (nullptr != m_usedMap) {
+        memset(m_usedMap, 0, (m_lfscfg.block_count + 7) / 8);
+        m_usedBlocks = 0;
+        err = lfs_fs_traverse(&m_lfs, &LittleFSWrapper::usageCallback, this);
+    } else {
+        lfs_ssize_t blocks = lfs_fs_size(&m_lfs);
+        err = (blocks < 0) ? (int)blocks : LFS_ERR_OK;
+        if (blocks >= 0) {
+            m_usedBlocks = (uint32_t)blocks;
+        }
+    }
+    if (LFS_ERR_OK == err) {
+        m_usageStale = false;
+    }
+    return err;
+}
+
+/**
+ * @brief Called by the traversal for every block in use. A block reached
+ *        twice (shared by copy-on-write) is counted once.
+ */
+int LittleFSWrapper::usageCallback(void* context, lfs_block_t block) {
+    static_cast<LittleFSWrapper*>(context)->markUsed(block);
+    return LFS_ERR_OK;
+}
+
 /**
  * @brief Callback for reading data from storage.
  * @param c The LittleFS configuration.
@@ -1145,6 +1491,7 @@ int LittleFSWrapper::progCallback(const struct lfs_config* c, lfs_block_t block,
     if( byteWritten < 0 ){
         return LFS_ERR_IO;
     }
+    wrapper->markUsed(block);
     return LFS_ERR_OK;
 }
 
@@ -1159,6 +1506,7 @@ int LittleFSWrapper::eraseCallback(const struct lfs_config* c, lfs_block_t block
     bool bytesErased = wrapper->m_istorage.erase(block * c->block_size, c->block_size);
     // LogFmtI("\nlfserase callback: %d, %d", block, c->block_size);
     if( bytesErased ){
+        wrapper->markUsed(block);
         return LFS_ERR_OK;
     }
     return LFS_ERR_IO;
@@ -11,6 +11,7 @@ created Date    : 6th Apr 2025
 #define _EXT_LITTLEFS_WRAPPER_H
 
 #include "interface/pdi/modules/storage/iFileSystemInterface.h"
+#include "config/VfsConfig.h"
 
 // Include the LittleFS library.
 #define LFS_NAME_MAX FILE_NAME_MAX_SIZE
@@ -43,6 +44,8 @@ created Date    : 6th Apr 2025
  *
  * @note The storage backend must implement the iStorageInterface.
  */
+class FileLineIndex;
+
 class LittleFSWrapper : public iFileSystemInterface {
 public:
     /**
@@ -106,7 +109,7 @@ public:
      * @param didmatchfound Optional pointer to a boolean that will be set to true if the match string was found.
      * @return The number of bytes read, or -1 on failure.
      */
-    int readFile(const char* path, uint64_t size, pdiutil::function<bool(char *, uint32_t)> readbackfn, uint64_t offset = 0, const char* readUntilMatchStr=nullptr, bool *didmatchfound=nullptr) override; 
+    int readFile(const char* path, uint64_t size, pdiutil::function_ref<bool(char *, uint32_t)> readbackfn, uint64_t offset = 0, const char* readUntilMatchStr=nullptr, bool *didmatchfound=nullptr) override; 
 
     /**
      * @brief Find the offset in file if line number given.
@@ -161,6 +164,14 @@ public:
      */
     int readLineInFile(const char* path, int32_t linenumber, pdiutil::string &linedata, const char* pattern = nullptr, CallBackVoidArgFn yield = nullptr) override;
 
+    /**
+     * @brief Builds the file's line index and keeps it as FILE_ATTR_LINES.
+     * @param path The path of the file to index.
+     * @param yield Optional callback function to yield control during long operations.
+     * @return 0 on success, or a negative error code on failure.
+     */
+    pdi_err_t indexLines(const char* path, CallBackVoidArgFn yield = nullptr) override;
+
     /**
      * @brief Creates a directory.
      * @param path The path of the directory to create.
@@ -184,12 +195,14 @@ public:
     pdi_err_t rename(const char* oldPath, const char* newPath) override;
 
     /**
-     * @brief Copies a file to a new path.
+     * @brief Copies a file to a new path a block at a time, through a scratch
+     *        buffer sized to the heap (see FileCopyEngine).
      * @param sourcePath The path of the source file.
      * @param destPath The path of the destination file.
+     * @param progress Optional, called after every block; false stops the copy.
      * @return 0 on success, or a negative error code on failure.
      */
-    pdi_err_t copyFile(const char* sourcePath, const char* destPath) override;
+    pdi_err_t copyFile(const char* sourcePath, const char* destPath, CallBackCopyProgressFn progress = nullptr) override;
 
     /**
      * @brief Deletes a file.
@@ -202,9 +215,10 @@ public:
      * @brief Moves a file to a new path.
      * @param oldPath The current path of the file.
      * @param newPath The new path of the file.
-     * @return 0 on success, or a negative error code on failure.
+     * @return 0 on success, or a negative error code on failure. A move is
+     *         an lfs rename, so it never copies and never reports progress.
      */
-    pdi_err_t moveFile(const char* oldPath, const char* newPath) override;
+    pdi_err_t moveFile(const char* oldPath, const char* newPath, CallBackCopyProgressFn progress = nullptr) override;
 
     /**
      * @brief Gets the size of a file.
@@ -261,6 +275,13 @@ public:
      */
     uint64_t getFreeSize() override;
 
+    /**
+     * @brief Recounts the blocks in use when anything was written since the
+     *        last count, giving back the ones freed meanwhile.
+     * @return 0 on success, or a negative error code on failure.
+     */
+    pdi_err_t scrubUsage();
+
     /**
      * @brief Set a custom attribute on a file or directory.
      * @param path The path of the file or directory.
@@ -291,6 +312,49 @@ public:
 
     int setFileOwner(const char *path, uint16_t uid, uint16_t gid) override;
 
+    /**
+     * @brief Opens a file and keeps its LittleFS handle until closeFile, so
+     *        its blocks are looked up once rather than on every transfer.
+     * @param path The path of the file to open.
+     * @param flags file_open_flag_t bits, or'd together.
+     * @return A handle >= 0, or a negative error code on failure.
+     */
+    int16_t openFile(const char *path, uint8_t flags) override;
+
+    /**
+     * @brief Reads from the current position of an open file.
+     * @param fd Handle returned by openFile.
+     * @param buffer Buffer to receive the data.
+     * @param size Capacity of the buffer in bytes.
+     * @return The number of bytes read, 0 at end of file, or a negative error code.
+     */
+    int32_t readHandle(int16_t fd, char *buffer, uint32_t size) override;
+
+    /**
+     * @brief Writes at the current position of an open file.
+     * @param fd Handle returned by openFile.
+     * @param buffer The data to write.
+     * @param size The number of bytes to write.
+     * @return The number of bytes written, or a negative error code on failure.
+     */
+    int32_t writeHandle(int16_t fd, const char *buffer, uint32_t size) override;
+
+    /**
+     * @brief Moves the position of an open file.
+     * @param fd Handle returned by openFile.
+     * @param offset Offset from whence.
+     * @param whence Where the offset counts from.
+     * @return The new position, or a negative error code on failure.
+     */
+    int64_t seekHandle(int16_t fd, int64_t offset, file_seek_t whence = FILE_SEEK_SET) override;
+
+    /**
+     * @brief Closes an open file and stamps its times once for the whole session.
+     * @param fd Handle returned by openFile.
+     * @return 0 on success, or a negative error code on failure.
+     */
+    pdi_err_t closeFile(int16_t fd) override;
+
 protected:
     // Stamp ctime + mtime + perms + uid/gid on a freshly created entry. Uses
     // nowEpoch() + currentOwner() (implemented by the policy layer).
@@ -306,6 +370,49 @@ private:
     // set once a mount succeeds. 
     bool m_mounted;
 
+    /**
+     * an open file. the path is kept to stamp the file once it is closed.
+     */
+    struct lfs_handle_t {
+        lfs_file_t m_file;
+        pdiutil::string m_path;
+        bool m_created;     // the open made the file
+        bool m_modified;    // it was written or truncated
+        uint64_t m_dirtyFrom; // first byte written, for the line index
+    };
+
+    // open files, taken from the heap on open. the handle is the index.
+    lfs_handle_t* m_handles[VFS_MAX_OPEN_FILES];
+
+    lfs_handle_t* handleOf(int16_t fd) const;
+    void closeAllFiles();
+
+    // blocks in use, so getUsedSize need not walk the tree. a block is marked
+    // when it is erased or programmed; LittleFS never says when it lets one
+    // go, so between scrubs the count can only run high. without the map
+    // (no heap for it) a stale count is recounted on the next query instead.
+    uint8_t* m_usedMap;
+    uint32_t m_usedBlocks;
+    bool m_usageStale;
+
+    void markUsed(lfs_block_t block);
+    int countUsage();
+    static int usageCallback(void* context, lfs_block_t block);
+
+    // line lookups. the index is only used while it still describes the whole
+    // file; updateLineIndex re-counts it from the first byte that changed.
+    // a file opened for a line lookup, its index read in by the same open.
+    struct lfs_lines_t {
+        lfs_file_t m_file;
+        lfs_file_config m_cfg;
+        lfs_attr m_attr;
+    };
+    int openLines(const char *path, lfs_lines_t &lines, FileLineIndex &index, bool &indexed);
+    void updateLineIndex(const char *path, uint64_t from);
+    int64_t skipLines(lfs_file_t &file, uint64_t from, uint32_t lines, CallBackVoidArgFn yield);
+    int64_t countLines(lfs_file_t &file, uint64_t from, uint64_t to, CallBackVoidArgFn yield);
+    int64_t lineStartFromEnd(lfs_file_t &file, uint32_t count, CallBackVoidArgFn yield);
+
     /**
      * @brief Callback for reading data from storage.
      * @param c The LittleFS configuration.
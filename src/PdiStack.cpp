@@ -232,6 +232,13 @@ void PDIStack::serve(){
   #ifdef ENABLE_CONTEXTUAL_EXECUTION
   __i_cooperative_scheduler.tick_from_loop();
   #endif
+
+  // Idle until the next task is due. a task handed to a contextual lane is
+  // always due, so this only sleeps when the inline lane is all there is
+  uint32_t _idle_ms = __task_scheduler.nextDeadlineMs();
+  if( _idle_ms > 0 ){
+    __i_dvc_ctrl.idle( _idle_ms < MAX_IDLE_SLEEP_MS ? _idle_ms : MAX_IDLE_SLEEP_MS );
+  }
 }
 
 /**
@@ -42,5 +42,14 @@ created Date    : 1st June 2019
 #endif
 #define MAX_FACTORY_RESET_CALLBACKS	MAX_SCHEDULABLE_TASKS
 
+/**
+ * longest the serve loop idles in one go when no task is due. the web server
+ * is still polled from the loop, so this bounds what an idle adds to a request
+ * on a port whose idle cannot wake on io
+ */
+#ifndef MAX_IDLE_SLEEP_MS
+#define MAX_IDLE_SLEEP_MS	20
+#endif
+
 
 #endif
@@ -22,6 +22,15 @@ created Date    : 1st June 2019
 #define LAUNCH_YEAR       19
 #define LAUNCH_UNIX_TIME  1546300800  // 2019 Unix time stamp
 
+/**
+ * how long a saved table waits in ram for further saves before the store is
+ * committed, so a form or config burst costs one flash write. 0 commits on
+ * every save
+ */
+#ifndef DATABASE_COMMIT_WINDOW_MS
+#define DATABASE_COMMIT_WINDOW_MS 1000
+#endif
+
 struct global_config {
 
   // Default Constructor
@@ -30,6 +30,9 @@ enum http_resp_code : uint16_t {
     HTTP_RESP_NOT_FOUND = 404,
     HTTP_RESP_METHOD_NOT_ALLOWED = 405,
     HTTP_RESP_REQUEST_TIMEOUT = 408,
+    HTTP_RESP_PAYLOAD_TOO_LARGE = 413,
+    HTTP_RESP_URI_TOO_LONG = 414,
+    HTTP_RESP_REQUEST_HEADER_FIELDS_TOO_LARGE = 431,
     HTTP_RESP_INTERNAL_SERVER_ERROR = 500,
     HTTP_RESP_NOT_IMPLEMENTED = 501,
     HTTP_RESP_BAD_GATEWAY = 502,
@@ -90,6 +93,57 @@ typedef enum http_method http_method_t;
 #define HTTP_DEFAULT_KEEP_ALIVE_MS 30000
 #endif
 
+/**
+ * How many clients the server holds connections for at once. Each slot keeps
+ * its own request being read, so a browser holding a keep-alive connection
+ * does not lock out the next one. A connection arriving when every slot is in
+ * use waits in the listener, or takes the place of a slot sitting idle.
+ */
+#ifndef HTTP_SERVER_MAX_CLIENTS
+#define HTTP_SERVER_MAX_CLIENTS 4
+#endif
+
+/**
+ * How long a client may stall part way through sending a request before its
+ * slot is given back. An idle keep-alive connection is held for
+ * HTTP_DEFAULT_KEEP_ALIVE_MS instead.
+ */
+#ifndef HTTP_SERVER_REQUEST_TIMEOUT_MS
+#define HTTP_SERVER_REQUEST_TIMEOUT_MS 5000
+#endif
+
+/**
+ * Bytes each client slot keeps for the request it is reading: the request
+ * line, the headers that are collected and a url encoded form body. A request
+ * that does not fit is refused, headers nobody collects take no room at all.
+ */
+#ifndef HTTP_SERVER_REQUEST_BUFFER_SIZE
+#define HTTP_SERVER_REQUEST_BUFFER_SIZE 2048
+#endif
+
+// Collected headers and query or form arguments kept for one request
+#ifndef HTTP_SERVER_MAX_HEADERS
+#define HTTP_SERVER_MAX_HEADERS 8
+#endif
+
+#ifndef HTTP_SERVER_MAX_ARGS
+#define HTTP_SERVER_MAX_ARGS 48
+#endif
+
+// Path parameters one route may name, e.g. /gpio/:pin
+#ifndef HTTP_SERVER_MAX_ROUTE_PARAMS
+#define HTTP_SERVER_MAX_ROUTE_PARAMS 4
+#endif
+
+/**
+ * How many client slots may be held by server-sent event streams at once. A
+ * stream keeps its slot until the client goes away, so some are always left
+ * for ordinary requests; a stream asked for beyond this is answered 503.
+ */
+#ifndef HTTP_SERVER_MAX_EVENT_STREAMS
+#define HTTP_SERVER_MAX_EVENT_STREAMS (HTTP_SERVER_MAX_CLIENTS / 2)
+#endif
+
 // Client specific defines
 #define HTTP_CLIENT_BUF_SIZE 640
 #define HTTP_CLIENT_READINTERVAL_MS 10
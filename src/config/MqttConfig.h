@@ -28,6 +28,50 @@ created Date    : 1st June 2019
 
 #define MQTT_INITIALIZE_DURATION   MILLISECOND_DURATION_5000
 
+/**
+ * QoS 1/2 publishes kept on the wire at once, each waiting on its own
+ * acknowledgement. Every one holds a heap copy of its packet for the resend.
+ */
+#ifndef MQTT_INFLIGHT_WINDOW
+#define MQTT_INFLIGHT_WINDOW    4
+#endif
+
+/**
+ * seconds an unacknowledged publish or pubrel waits before it is sent again
+ */
+#ifndef MQTT_RETRY_INTERVAL
+#define MQTT_RETRY_INTERVAL     5
+#endif
+
+/**
+ * QoS 1/2 publishes are appended here before they are sent and dropped once the
+ * broker has them, so they outlast a lost link or a reboot. Point it into /tmp
+ * to keep the spool in RAM. Past the max size a publish is refused.
+ */
+#ifndef MQTT_SPOOL_DIR
+#define MQTT_SPOOL_DIR          "/var"
+#endif
+
+#ifndef MQTT_SPOOL_FILE
+#define MQTT_SPOOL_FILE         MQTT_SPOOL_DIR "/mqtt.spool"
+#endif
+
+#ifndef MQTT_SPOOL_MAX_SIZE
+#define MQTT_SPOOL_MAX_SIZE     16384
+#endif
+
+/**
+ * without the storage service the spool is a ring in RAM of this many bytes
+ */
+#ifndef MQTT_SPOOL_RAM_SIZE
+#define MQTT_SPOOL_RAM_SIZE     1536
+#endif
+
+/**
+ * file attribute on the spool holding how far the broker has taken it
+ */
+#define MQTT_SPOOL_ATTR         (FILE_ATTR_USER_BASE + 0)
+
 /**
  * enable/disable mqtt default payload for publish if user not assigned explicitely
  */
@@ -19,6 +19,32 @@ created Date    : 1st June 2025
 #define SSH_MAX_SESSIONS 2
 #endif
 
+/* Channels one connection may hold open at once, e.g. a shell and sftp */
+#ifndef SSH_MAX_CHANNELS
+#define SSH_MAX_CHANNELS 4
+#endif
+
+/* Receive window offered per channel, topped up once half is used */
+#ifndef SSH_CHANNEL_WINDOW
+#define SSH_CHANNEL_WINDOW 131072
+#endif
+
+#ifndef SSH_CHANNEL_MAX_PACKET
+#define SSH_CHANNEL_MAX_PACKET 32768
+#endif
+
+/* Output a channel may have waiting for the client's window before it stops
+   taking new requests and stops topping up the client's window */
+#ifndef SSH_CHANNEL_TX_QUEUE_CAP
+#define SSH_CHANNEL_TX_QUEUE_CAP (4 * SSH_CHANNEL_MAX_PACKET)
+#endif
+
+/* Bytes a control message or keystroke echo is built in before it needs the
+   heap, enough for the whole packet once it is padded and its MAC appended */
+#ifndef SSH_SMALL_PACKET_INLINE
+#define SSH_SMALL_PACKET_INLINE 64
+#endif
+
 #ifndef SSH_HANDSHAKE_IDLE_MS
 #define SSH_HANDSHAKE_IDLE_MS 10000
 #endif
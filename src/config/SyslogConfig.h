@@ -35,11 +35,33 @@ created Date    : 25th July 2026
 #define SYSLOG_FILE_SUCCESS SYSLOG_DIR "/syslog.success"
 #endif
 
-// truncate-and-restart once a file crosses this many bytes
+// rotate a file before it would cross this many bytes
 #ifndef SYSLOG_FILE_MAX_SIZE
 #define SYSLOG_FILE_MAX_SIZE 8192
 #endif
 
+// rotated files kept per type: syslog.info.1 is the newest, syslog.info.N the
+// oldest; 0 keeps none and starts the file over
+#ifndef SYSLOG_ROTATE_COUNT
+#define SYSLOG_ROTATE_COUNT 2
+#endif
+
+// lines wait in a ring of this many bytes (a power of two) until a scheduler
+// task writes them out, SYSLOG_FLUSH_DELAY ms after the first one arrives. a
+// line that does not fit is dropped and counted in /proc/syslog
+#ifndef SYSLOG_RING_SIZE
+#define SYSLOG_RING_SIZE 1024
+#endif
+
+#ifndef SYSLOG_FLUSH_DELAY
+#define SYSLOG_FLUSH_DELAY 100
+#endif
+
+// bytes gathered before each write to a syslog file
+#ifndef SYSLOG_WRITE_BATCH
+#define SYSLOG_WRITE_BATCH 512
+#endif
+
 // max assembled length of a single syslog line (longer lines are truncated)
 #ifndef SYSLOG_LINE_MAX
 #define SYSLOG_LINE_MAX 200
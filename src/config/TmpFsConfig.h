@@ -27,4 +27,23 @@ created Date    : 23rd July 2026
 #define TMPFS_MAX_PATH 63
 #endif
 
+// File content is kept in chunks of this many bytes taken from the heap as a
+// file grows, so an append never moves what is already there. A file holds at
+// most one partly used chunk, which bounds the heap beyond TMPFS_MAX_BYTES to
+// TMPFS_MAX_NODES of them.
+#ifndef TMPFS_CHUNK_SIZE
+#define TMPFS_CHUNK_SIZE 128
+#endif
+
+// Chunks kept back for reuse when a file shrinks or goes; the rest are given
+// back to the heap.
+#ifndef TMPFS_SPARE_CHUNKS
+#define TMPFS_SPARE_CHUNKS 4
+#endif
+
+// Buckets of the table a directory entry is looked up in by parent and name.
+#ifndef TMPFS_HASH_BUCKETS
+#define TMPFS_HASH_BUCKETS 16
+#endif
+
 #endif
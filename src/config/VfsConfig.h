@@ -24,6 +24,58 @@ created Date    : 20th July 2026
 #define VFS_MOUNT_NAME_MAX 11
 #endif
 
+// Files open at once through the dispatcher (openFile). Each backend keeps a
+// handle table of the same size, so every one of them may sit on one mount.
+#ifndef VFS_MAX_OPEN_FILES
+#define VFS_MAX_OPEN_FILES 4
+#endif
+
+// Read-ahead / write-behind buffer the dispatcher keeps per open file. It is
+// taken from the heap on the first read or write and given back at close;
+// transfers at least this large bypass it.
+#ifndef VFS_HANDLE_BUFFER_SIZE
+#define VFS_HANDLE_BUFFER_SIZE 256
+#endif
+
+// Scratch buffer a copy or cross-mount move streams through. Each copy sizes
+// it to the smaller of the file, the backend's block and the max, halving
+// until the heap can spare it; the min is taken from the stack when it cannot.
+#ifndef VFS_COPY_BUFFER_MAX
+#define VFS_COPY_BUFFER_MAX 4096
+#endif
+
+#ifndef VFS_COPY_BUFFER_MIN
+#define VFS_COPY_BUFFER_MIN 64
+#endif
+
+// Block the line lookups (tail, line numbers) read a file in.
+#ifndef VFS_LINE_SCAN_BLOCK
+#define VFS_LINE_SCAN_BLOCK 256
+#endif
+
+// Line index kept as a file attribute by indexLines: the record is capped at
+// this many bytes (LittleFS allows up to 1022) and starts with a checkpoint
+// every VFS_LINE_INDEX_STRIDE lines, doubling the stride whenever it fills.
+#ifndef VFS_LINE_INDEX_BYTES
+#define VFS_LINE_INDEX_BYTES 256
+#endif
+
+#ifndef VFS_LINE_INDEX_STRIDE
+#define VFS_LINE_INDEX_STRIDE 16
+#endif
+
+// How often (ms) the root filesystem recounts its blocks in use. Usage queries
+// read a count kept up to date on every write, but blocks LittleFS lets go of
+// only come off it at the next recount, and only if anything was written.
+#ifndef VFS_USAGE_SCRUB_INTERVAL
+#define VFS_USAGE_SCRUB_INTERVAL 30000
+#endif
+
+// Files open at once on each synthetic backend (procfs, sysfs, devfs).
+#ifndef VFS_SYNTHETIC_MAX_OPEN_FILES
+#define VFS_SYNTHETIC_MAX_OPEN_FILES 2
+#endif
+
 // Per-backend enable flags. Each backend adds a mount slot at boot, so keep
 // VFS_MAX_MOUNTS ≥ 1 + (number of enabled synthetic backends). Override to
 // undef in DeviceConfig.h to opt out on tight-RAM ports.
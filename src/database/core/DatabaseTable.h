@@ -26,7 +26,7 @@ public:
 	/**
 	 * DatabaseTable constructor
 	 */
-	DatabaseTable()
+	DatabaseTable() : m_registered(false)
 	{
 	}
 
@@ -53,6 +53,32 @@ public:
         return this->get_table(addr, _table);
     }
 
+    /**
+     * @purpose read-only view of the table for readers on a hot path. it is
+     * decoded on first use and reused until the store version moves, and its
+     * copy only exists for a table that is ever peeked.
+     *
+     * @return  the table, or nullptr when it never registered
+     */
+    const Table *peek()
+    {
+        static Table _cache;
+        static uint32_t _cache_version = 0;
+
+        if (!this->is_registered())
+        {
+            return nullptr;
+        }
+
+        if (_cache_version != __i_db.getStoreVersion())
+        {
+            _cache = Table();
+            __i_db.loadConfig<Table>(addr, &_cache);
+            _cache_version = __i_db.getStoreVersion();
+        }
+        return &_cache;
+    }
+
     /**
      * @purpose set table in database.
      */
@@ -70,6 +96,34 @@ public:
     }
 
 private:
+	/**
+	 * @var	bool	m_registered
+	 * registration is never withdrawn, so once the registry has this address
+	 * the answer is kept rather than looked up again
+	 */
+	bool m_registered;
+
+	/**
+	 * whether this table's address reached the registry
+	 *
+	 * @return  bool
+	 */
+	bool is_registered()
+	{
+		if (!this->m_registered)
+		{
+			for (uint8_t i = 0; i < __database.m_database_tables.size(); i++)
+			{
+				if (__database.m_database_tables[i].m_table_address == addr)
+				{
+					this->m_registered = true;
+					break;
+				}
+			}
+		}
+		return this->m_registered;
+	}
+
 	/**
 	 * register table with address
 	 *
@@ -93,17 +147,12 @@ private:
 	 */
 	bool get_table(uint16_t _address, Table* _object)
 	{
-		bool bStatus = false;
-		for (uint8_t i = 0; i < __database.m_database_tables.size(); i++)
+		if (!this->is_registered())
 		{
-			if (__database.m_database_tables[i].m_table_address == _address)
-			{
-				__i_db.loadConfig<Table>(_address, _object);
-				bStatus = true;
-				break;
-			}
+			return false;
 		}
-		return bStatus;
+		__i_db.loadConfig<Table>(_address, _object);
+		return true;
 	}
 
 	/**
@@ -114,17 +163,13 @@ private:
 	 */
 	bool clear_table(uint16_t _address)
 	{
-		bool bStatus = false;
-		for (uint8_t i = 0; i < __database.m_database_tables.size(); i++)
+		if (!this->is_registered())
 		{
-			if (__database.m_database_tables[i].m_table_address == _address)
-			{
-				__i_db.clearConfig<Table>(_address);
-				bStatus = true;
-				break;
-			}
+			return false;
 		}
-		return bStatus;
+		__i_db.clearConfig<Table>(_address);
+		__database.schedule_commit();
+		return true;
 	}
 
 	/**
@@ -136,17 +181,13 @@ private:
 	 */
 	bool set_table(uint16_t _address, Table* _object)
 	{
-		bool bStatus = false;
-		for (uint8_t i = 0; i < __database.m_database_tables.size(); i++)
+		if (!this->is_registered())
 		{
-			if (__database.m_database_tables[i].m_table_address == _address)
-			{
-				__i_db.saveConfig<Table>(_address, _object);
-				bStatus = true;
-				break;
-			}
+			return false;
 		}
-		return bStatus;
+		__i_db.saveConfig<Table>(_address, _object);
+		__database.schedule_commit();
+		return true;
 	}
 };
 
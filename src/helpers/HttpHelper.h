@@ -50,6 +50,9 @@ static rofn::ROPTR getHttpStatusString(int code) {
         case HTTP_RESP_NOT_FOUND: return ROPTR_WRAP("Not Found");
         case HTTP_RESP_METHOD_NOT_ALLOWED: return ROPTR_WRAP("Method Not Allowed");
         case HTTP_RESP_REQUEST_TIMEOUT: return ROPTR_WRAP("Request Timeout");
+        case HTTP_RESP_PAYLOAD_TOO_LARGE: return ROPTR_WRAP("Payload Too Large");
+        case HTTP_RESP_URI_TOO_LONG: return ROPTR_WRAP("URI Too Long");
+        case HTTP_RESP_REQUEST_HEADER_FIELDS_TOO_LARGE: return ROPTR_WRAP("Request Header Fields Too Large");
         case HTTP_RESP_INTERNAL_SERVER_ERROR: return ROPTR_WRAP("Internal Server Error");
         case HTTP_RESP_NOT_IMPLEMENTED: return ROPTR_WRAP("Not Implemented");
         case HTTP_RESP_BAD_GATEWAY: return ROPTR_WRAP("Bad Gateway");
@@ -61,6 +64,19 @@ static rofn::ROPTR getHttpStatusString(int code) {
     }
 }
 
+// Get the HTTP method of a request line method name, HTTP_METHOD_MAX if unknown
+inline http_method_t getHttpMethod(const char *method) {
+    if (nullptr == method) return HTTP_METHOD_MAX;
+    if (0 == strcmp(method, "GET")) return HTTP_METHOD_GET;
+    if (0 == strcmp(method, "POST")) return HTTP_METHOD_POST;
+    if (0 == strcmp(method, "HEAD")) return HTTP_METHOD_HEAD;
+    if (0 == strcmp(method, "PUT")) return HTTP_METHOD_PUT;
+    if (0 == strcmp(method, "PATCH")) return HTTP_METHOD_PATCH;
+    if (0 == strcmp(method, "DELETE")) return HTTP_METHOD_DELETE;
+    if (0 == strcmp(method, "OPTIONS")) return HTTP_METHOD_OPTIONS;
+    return HTTP_METHOD_MAX;
+}
+
 /// URL decode a percent-encoded string
 static void urlDecode(pdiutil::string& text){
 
@@ -91,5 +107,35 @@ static void urlDecode(pdiutil::string& text){
     text = decoded;
 }
 
+/// URL decode a NUL terminated percent-encoded string where it lies, the
+/// decoded text is never longer than the encoded one
+inline void urlDecode(char *text){
+
+    if (nullptr == text) {
+        return;
+    }
+
+    char *out = text;
+    while (*text)
+    {
+        if (('%' == *text) && text[1] && text[2])
+        {
+            char hex[3] = { text[1], text[2], '\0' };
+            *out++ = static_cast<char>(strtol(hex, nullptr, 16));
+            text += 3;
+        }
+        else if ('+' == *text)
+        {
+            *out++ = ' ';
+            text++;
+        }
+        else
+        {
+            *out++ = *text++;
+        }
+    }
+    *out = '\0';
+}
+
 
 #endif
@@ -27,7 +27,7 @@ public:
   /**
    * iDatabaseInterface constructor.
    */
-  iDatabaseInterface() {}
+  iDatabaseInterface() : m_dirty_from(0), m_dirty_to(0), m_store_version(1) {}
   /**
    * iDatabaseInterface destructor.
    */
@@ -38,6 +38,37 @@ public:
   virtual bool isValidConfigs() = 0;
   virtual uint32_t getMaxDBSize() = 0;
 
+  /**
+   * push whatever saveConfig left in the working copy out to the medium. saves
+   * only mark their bytes dirty so several of them share one write, and the
+   * database utility decides when that write happens. a port whose medium is
+   * written byte by byte has nothing to push.
+   *
+   * @return bool false when the medium refused the write
+   */
+  virtual bool commitConfigs()
+  {
+    clearDirty();
+    return true;
+  }
+
+  /**
+   * whether saves are waiting on commitConfigs
+   */
+  bool hasUncommittedConfigs() const { return m_dirty_to > m_dirty_from; }
+
+  /**
+   * first dirty address and one past the last, equal when nothing is dirty
+   */
+  uint32_t getDirtyFrom() const { return m_dirty_from; }
+  uint32_t getDirtyTo() const { return m_dirty_to; }
+
+  /**
+   * moves on whenever the contents of the store may have changed, so a decoded
+   * copy of a table taken at one version is known stale at any other
+   */
+  uint32_t getStoreVersion() const { return m_store_version; }
+
   /**
    * Below template methods are must to define by derived
    */
@@ -50,6 +81,49 @@ public:
 
   // template <typename T>
   // void clearConfig(uint16_t _address);
+
+protected:
+  /**
+   * widen the dirty range to cover a write. one range rather than a list, as
+   * tables sit close together and one span costs a single seek and write.
+   */
+  void markDirty(uint32_t _address, uint32_t _length)
+  {
+    if (0 == _length)
+    {
+      return;
+    }
+    touchStore();
+    if (!hasUncommittedConfigs())
+    {
+      m_dirty_from = _address;
+      m_dirty_to = _address + _length;
+      return;
+    }
+    if (_address < m_dirty_from)
+    {
+      m_dirty_from = _address;
+    }
+    if (_address + _length > m_dirty_to)
+    {
+      m_dirty_to = _address + _length;
+    }
+  }
+
+  void clearDirty()
+  {
+    m_dirty_from = 0;
+    m_dirty_to = 0;
+  }
+
+  /**
+   * for changes that bypass saveConfig, such as loading or wiping the store
+   */
+  void touchStore() { m_store_version++; }
+
+  uint32_t m_dirty_from;
+  uint32_t m_dirty_to;
+  uint32_t m_store_version;
 };
 
 // derived class must define this
@@ -0,0 +1,262 @@
+/***************************** HTTP Route Table *******************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+Author          : Suraj I.
+created Date    : 17th Oct 2026
+******************************************************************************/
+
+#include "HttpRouteTable.h"
+
+/**
+ * HttpRouteTable constructor.
+ */
+HttpRouteTable::HttpRouteTable(){
+    clear();
+}
+
+/**
+ * @brief drop all routes, leaving the root node which matches the empty path
+ */
+void HttpRouteTable::clear(){
+    m_nodes.clear();
+    m_labels.clear();
+    m_nodes.push_back({0, 0, false, NO_NODE, NO_NODE, NO_ROUTE, 0});
+}
+
+/**
+ * @brief add a node below parent, ahead of its other children
+ */
+uint16_t HttpRouteTable::addNode(uint16_t parent, uint16_t labelat, uint8_t labellen, bool isparam){
+
+    uint16_t index = m_nodes.size();
+    if (NO_NODE == index) {
+        return NO_NODE;
+    }
+    m_nodes.push_back({labelat, labellen, isparam, NO_NODE, m_nodes[parent].child, NO_ROUTE, 0});
+    if (m_nodes.size() == index) {
+        return NO_NODE; // out of memory
+    }
+    m_nodes[parent].child = index;
+    return index;
+}
+
+/**
+ * @brief the literal child whose label starts with first. labels of literal
+ * siblings never share a first character, so there is at most one.
+ */
+uint16_t HttpRouteTable::findChild(uint16_t parent, char first) const{
+
+    for (uint16_t i = m_nodes[parent].child; NO_NODE != i; i = m_nodes[i].sibling) {
+        if (!m_nodes[i].isparam && m_labels[m_nodes[i].labelat] == first) {
+            return i;
+        }
+    }
+    return NO_NODE;
+}
+
+/**
+ * @brief the parameter child, a node has at most one
+ */
+uint16_t HttpRouteTable::findParamChild(uint16_t parent) const{
+
+    for (uint16_t i = m_nodes[parent].child; NO_NODE != i; i = m_nodes[i].sibling) {
+        if (m_nodes[i].isparam) {
+            return i;
+        }
+    }
+    return NO_NODE;
+}
+
+/**
+ * @brief add a route pattern, splitting any edge it branches off part way
+ */
+int16_t HttpRouteTable::insert(const char *pattern, int16_t route){
+
+    if (nullptr == pattern) {
+        return NO_ROUTE;
+    }
+
+    // labels are kept as runs of the pattern text, so it is stored once
+    uint16_t base = m_labels.size();
+    uint16_t length = strlen(pattern);
+    m_labels.append(pattern, length);
+    if (m_labels.size() != (uint32_t)base + length) {
+        return NO_ROUTE; // out of memory
+    }
+
+    uint16_t node = 0;
+    uint16_t at = 0;
+
+    while (at < length) {
+
+        const char *p = m_labels.c_str() + base + at;
+
+        if (':' == *p) {
+
+            uint16_t namelen = 0;
+            while (at + 1 + namelen < length && '/' != p[1 + namelen]) {
+                namelen++;
+            }
+
+            // one parameter node per position, shared by every route with a
+            // parameter there; the names are each route's own, see nameParams
+            uint16_t param = findParamChild(node);
+            if (NO_NODE == param) {
+                param = addNode(node, base + at + 1, namelen > 0xFF ? 0xFF : namelen, true);
+                if (NO_NODE == param) {
+                    return NO_ROUTE;
+                }
+            }
+            node = param;
+            at += 1 + namelen;
+            continue;
+        }
+
+        // a literal run lasts up to the next parameter
+        uint16_t runlen = 0;
+        while (at + runlen < length && ':' != p[runlen] && runlen < 0xFF) {
+            runlen++;
+        }
+
+        uint16_t child = findChild(node, *p);
+        if (NO_NODE == child) {
+            child = addNode(node, base + at, runlen, false);
+            if (NO_NODE == child) {
+                return NO_ROUTE;
+            }
+            node = child;
+            at += runlen;
+            continue;
+        }
+
+        uint8_t common = 0;
+        const char *label = m_labels.c_str() + m_nodes[child].labelat;
+        while (common < m_nodes[child].labellen && common < runlen && label[common] == p[common]) {
+            common++;
+        }
+
+        if (common < m_nodes[child].labellen) {
+
+            // the pattern leaves this edge part way, so the edge is split and
+            // the part past the branch point moves down with what was below
+            uint16_t tail = m_nodes.size();
+            RouteNode split = {
+                (uint16_t)(m_nodes[child].labelat + common),
+                (uint8_t)(m_nodes[child].labellen - common),
+                false,
+                m_nodes[child].child,
+                NO_NODE,
+                m_nodes[child].route,
+                m_nodes[child].patternat
+            };
+            m_nodes.push_back(split);
+            if (m_nodes.size() == tail) {
+                return NO_ROUTE;
+            }
+            m_nodes[child].labellen = common;
+            m_nodes[child].child = tail;
+            m_nodes[child].route = NO_ROUTE;
+        }
+
+        node = child;
+        at += common;
+    }
+
+    int16_t previous = m_nodes[node].route;
+    m_nodes[node].route = route;
+    m_nodes[node].patternat = base;
+    return previous;
+}
+
+/**
+ * @brief find the route for a path, see matchNode
+ */
+int16_t HttpRouteTable::match(const char *path, HttpRouteParam *params, uint8_t maxparams, uint8_t &paramcount) const{
+
+    paramcount = 0;
+    if (nullptr == path) {
+        return NO_ROUTE;
+    }
+    uint16_t node = matchNode(0, path, params, maxparams, paramcount);
+    if (NO_NODE == node) {
+        return NO_ROUTE;
+    }
+    nameParams(node, params, paramcount);
+    return m_nodes[node].route;
+}
+
+/**
+ * @brief name the parameters found for the route ending at node after its own
+ * pattern, in the order they appear there. two routes may have a parameter at
+ * the same position under different names, /gpio/:pin and /gpio/:id/mode.
+ */
+void HttpRouteTable::nameParams(uint16_t node, HttpRouteParam *params, uint8_t paramcount) const{
+
+    const char *p = m_labels.c_str() + m_nodes[node].patternat;
+    for (uint8_t i = 0; i < paramcount; i++) {
+
+        while (':' != *p) {
+            p++;
+        }
+        p++;
+
+        uint16_t namelen = 0;
+        while ('\0' != p[namelen] && '/' != p[namelen]) {
+            namelen++;
+        }
+        params[i].name = p;
+        params[i].namelen = namelen > 0xFF ? 0xFF : namelen;
+        p += namelen;
+    }
+}
+
+/**
+ * @brief match the rest of the path below node, giving the node its route ends
+ * at. the literal child is tried first and the parameter child only if that
+ * finds nothing, so the cost is a walk along the path unless a parameter and a
+ * literal route overlap.
+ */
+uint16_t HttpRouteTable::matchNode(uint16_t node, const char *path, HttpRouteParam *params, uint8_t maxparams, uint8_t &paramcount) const{
+
+    if ('\0' == *path) {
+        return NO_ROUTE == m_nodes[node].route ? NO_NODE : node;
+    }
+
+    uint16_t child = findChild(node, *path);
+    if (NO_NODE != child) {
+        const RouteNode &edge = m_nodes[child];
+        if (0 == strncmp(path, m_labels.c_str() + edge.labelat, edge.labellen)) {
+            uint16_t found = matchNode(child, path + edge.labellen, params, maxparams, paramcount);
+            if (NO_NODE != found) {
+                return found;
+            }
+        }
+    }
+
+    uint16_t param = findParamChild(node);
+    if (NO_NODE != param && paramcount < maxparams) {
+
+        uint16_t valuelen = 0;
+        while ('\0' != path[valuelen] && '/' != path[valuelen]) {
+            valuelen++;
+        }
+        if (0 == valuelen) {
+            return NO_NODE; // a parameter is never empty
+        }
+
+        uint8_t slot = paramcount++;
+        params[slot].value = path;
+        params[slot].valuelen = valuelen;
+
+        uint16_t found = matchNode(param, path + valuelen, params, maxparams, paramcount);
+        if (NO_NODE != found) {
+            return found;
+        }
+        paramcount = slot;
+    }
+
+    return NO_NODE;
+}
@@ -0,0 +1,105 @@
+/***************************** HTTP Route Table *******************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+The route table maps a request path to the route registered for it. Routes are
+kept in a radix trie built as they are registered, so finding one costs a walk
+along the path rather than a compare against every route. A route may name
+path parameters, e.g. /gpio/:pin, which match one path segment each.
+
+Author          : Suraj I.
+created Date    : 17th Oct 2026
+******************************************************************************/
+
+#ifndef _HTTP_ROUTE_TABLE_H_
+#define _HTTP_ROUTE_TABLE_H_
+
+#include <config/HttpConfig.h>
+
+/**
+ * a path parameter found while matching. name points into the table and value
+ * into the path matched, neither is NUL terminated.
+ */
+struct HttpRouteParam{
+  const char *name;
+  uint8_t namelen;
+  const char *value;
+  uint16_t valuelen;
+};
+
+/**
+ * HttpRouteTable class
+ */
+class HttpRouteTable
+{
+
+public:
+
+  static const int16_t NO_ROUTE = -1;
+
+  /**
+   * HttpRouteTable constructor.
+   */
+  HttpRouteTable();
+
+  /**
+   * @brief add a route pattern. a segment starting with ':' is a parameter.
+   * @param pattern route pattern, e.g. /gpio/:pin
+   * @param route what match() returns for a path matching the pattern
+   * @return the route the pattern had before, NO_ROUTE if it is new or could
+   * not be added for want of memory
+   */
+  int16_t insert(const char *pattern, int16_t route);
+
+  /**
+   * @brief find the route for a path. a literal segment is preferred over a
+   * parameter where both would match.
+   * @param path request path, without its query string
+   * @param params filled with the parameters of the route found
+   * @param maxparams room in params
+   * @param paramcount number of parameters found
+   * @return the route, or NO_ROUTE
+   */
+  int16_t match(const char *path, HttpRouteParam *params, uint8_t maxparams, uint8_t &paramcount) const;
+
+  /**
+   * @brief drop all routes
+   */
+  void clear();
+
+  /**
+   * @brief number of trie nodes, for sizing
+   */
+  uint16_t nodes() const { return m_nodes.size(); }
+
+protected:
+
+  static const uint16_t NO_NODE = 0xFFFF;
+
+  /**
+   * one edge of the trie with the node below it. the label is a run of
+   * m_labels, a parameter node's label is the name it was first added under.
+   */
+  struct RouteNode{
+    uint16_t labelat;
+    uint8_t labellen;
+    bool isparam;
+    uint16_t child;     // first child
+    uint16_t sibling;   // next child of the same parent
+    int16_t route;      // route ending here
+    uint16_t patternat; // where its pattern starts in m_labels, for the names
+  };
+
+  uint16_t addNode(uint16_t parent, uint16_t labelat, uint8_t labellen, bool isparam);
+  uint16_t findChild(uint16_t parent, char first) const;
+  uint16_t findParamChild(uint16_t parent) const;
+  uint16_t matchNode(uint16_t node, const char *path, HttpRouteParam *params, uint8_t maxparams, uint8_t &paramcount) const;
+  void nameParams(uint16_t node, HttpRouteParam *params, uint8_t paramcount) const;
+
+  pdiutil::vector<RouteNode> m_nodes;
+  pdiutil::string m_labels;   // text of every pattern added
+};
+
+#endif
@@ -18,6 +18,10 @@ created Date    : 1st June 2025
 
 CallBackVoidArgFn HttpServerInterfaceImpl::UriToHandlerMap::notFoundHandler = nullptr;
 
+// matched as prefixes of a Content-Type value, which may carry parameters
+static const char HTTP_CONTENT_TYPE_URLENCODED []PROG_RODT_ATTR = "application/x-www-form-urlencoded";
+static const char HTTP_CONTENT_TYPE_MULTIPART  []PROG_RODT_ATTR = "multipart/";
+
 
 /**
  * HttpServerInterfaceImpl constructor.
@@ -25,7 +29,6 @@ CallBackVoidArgFn HttpServerInterfaceImpl::UriToHandlerMap::notFoundHandler = nu
 HttpServerInterfaceImpl::HttpServerInterfaceImpl() :
     m_server(nullptr),
     m_client(nullptr),
-    m_currentclient_lastactivity_timestamp(0),
     m_handlingclientfromcb(false)
 #ifdef ENABLE_TLS_SERVICE
     , m_secure(false)
@@ -33,8 +36,9 @@ HttpServerInterfaceImpl::HttpServerInterfaceImpl() :
 #if defined(ENABLE_HTTPS_SERVER) && defined(ENABLE_TLS_SERVICE)
     , m_insecure_server(nullptr)
 #endif
+    , m_clientSlot(nullptr)
+    , m_clientRequest(nullptr)
 {
-    m_clientRequest.clear();
     m_uriHandlerMap.clear();
     m_responseHeaders.clear();
     m_storagePath = CHARPTR_WRAP_RO(HTTP_SERVER_DEFAULT_STATIC_PATH); // Default storage path for static files
@@ -44,6 +48,7 @@ HttpServerInterfaceImpl::HttpServerInterfaceImpl() :
  * HttpServerInterfaceImpl destructor.
  */
 HttpServerInterfaceImpl::~HttpServerInterfaceImpl(){
+    closeClients();
     if( nullptr != m_server ){
         pdiutil::safe_delete(m_server);
         m_server = nullptr;
@@ -87,14 +92,10 @@ void HttpServerInterfaceImpl::begin(uint16_t port, bool secure){
             m_server->setOnAcceptClientEventCallback([](void* arg){
                 HttpServerInterfaceImpl *ihttpserver = reinterpret_cast<HttpServerInterfaceImpl*>(arg);
 
-                if(ihttpserver && !ihttpserver->m_handlingclientfromcb && !ihttpserver->m_client){
-
-                    ihttpserver->m_handlingclientfromcb = true;
-
-                    ihttpserver->m_client = ihttpserver->m_server->accept();
-                    ihttpserver->m_currentclient_lastactivity_timestamp = __i_instance.getUtilityInstance().millis_now();
-
-                    ihttpserver->m_handlingclientfromcb = false;
+                // taking the connection into a slot straight away keeps it from
+                // being reset by the next one the listener sees
+                if(ihttpserver && !ihttpserver->m_handlingclientfromcb){
+                    ihttpserver->acceptClient(ihttpserver->m_server);
                 }
             }, this);
         }
@@ -137,102 +138,516 @@ void HttpServerInterfaceImpl::handleClient(){
         return; // Server not initialized
     }
 
-    // Skip if the lwIP callback is currently mid-accept; avoids racing on m_client.
+    // Skip if the lwIP callback is currently mid-accept; avoids racing on the slots.
     if (m_handlingclientfromcb) {
         return;
     }
 
-    // A connection that arrived while the previous client was still being served
-    // stays waiting in the server, the accept callback only runs for a new one.
-    // Picking it up here is what keeps it from being reset by the next accept.
-    if (!m_client && m_server->hasClient()) {
-
-        m_handlingclientfromcb = true;
-        m_client = m_server->accept();
-        m_currentclient_lastactivity_timestamp = __i_instance.getUtilityInstance().millis_now();
-        m_handlingclientfromcb = false;
+    // A connection that arrived while every slot was in use stays waiting in
+    // the server, the accept callback only runs for a new one. When it is
+    // still waiting, an idle keep-alive connection gives its slot up to it.
+    if (m_server->hasClient() && !acceptClient(m_server)) {
+        evictIdleClient();
+        acceptClient(m_server);
     }
 
     #if defined(ENABLE_HTTPS_SERVER) && defined(ENABLE_TLS_SERVICE)
-    if (!m_client && nullptr != m_insecure_server && m_insecure_server->hasClient()) {
-
-        m_handlingclientfromcb = true;
-        m_client = m_insecure_server->accept();
-        m_currentclient_lastactivity_timestamp = __i_instance.getUtilityInstance().millis_now();
-        m_handlingclientfromcb = false;
+    if (nullptr != m_insecure_server && m_insecure_server->hasClient()) {
+        acceptClient(m_insecure_server);
     }
     #endif
 
-    if (m_client && m_client->connected()) {
+    // Every slot gets its turn, and at most one request is answered per slot
+    // per pass, so a client pipelining requests cannot starve the others.
+    for (uint8_t i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++) {
+        pollClient(m_slots[i]);
+    }
+}
 
-        if( m_client->available() ){
+/**
+ * take a waiting connection into a free slot
+ */
+bool HttpServerInterfaceImpl::acceptClient(iTcpServerInterface* server){
 
-            // Parse the incoming request
-            parseRequest();
+    for (uint8_t i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++) {
 
-            #if defined(ENABLE_HTTPS_SERVER) && defined(ENABLE_TLS_SERVICE)
-            if( m_client && !m_client->isSecure() ){
-                sendHttpsRedirect();
-                if( !m_clientRequest.isPending ){
-                    m_clientRequest.clear();
-                }
-                m_client->flush(FLUSH_ALL);
-                // closeClient();
-                // m_currentclient_lastactivity_timestamp = 0;
-                return;
+        if (nullptr == m_slots[i].client) {
+
+            m_handlingclientfromcb = true;
+            m_slots[i].client = server->accept();
+            m_handlingclientfromcb = false;
+
+            if (nullptr == m_slots[i].client) {
+                return false;
             }
-            #endif
 
-            // Handle the request based on the URI
-            bool uriFound = false;
-            for (uint16_t i = 0; i < m_uriHandlerMap.size(); i++) {
+            // a response goes out as several writes, headers then body, and
+            // on a kept connection Nagle would hold each back for the ack
+            static_cast<iTcpClientInterface*>(m_slots[i].client)->setNoDelay(true);
+            m_slots[i].reset();
+            m_slots[i].streaming = false;
+            m_slots[i].lastactivity = __i_instance.getUtilityInstance().millis_now();
+            return true;
+        }
+    }
+    return false;
+}
 
-                if (m_clientRequest.uri == m_uriHandlerMap[i].uri) {
-                    // Call the registered handler for the URI
-                    if (m_uriHandlerMap[i].urihandler) {
-                        m_uriHandlerMap[i].urihandler();
-                    }
-                    uriFound = true;
-                    break; // Exit the loop after handling the request
+/**
+ * close the connection that has waited longest for its next request, if any
+ * slot is sitting idle at all. a slot part way through a request is left be.
+ */
+void HttpServerInterfaceImpl::evictIdleClient(){
+
+    HttpClientSlot *oldest = nullptr;
+
+    for (uint8_t i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++) {
+
+        HttpClientSlot &slot = m_slots[i];
+        if (nullptr != slot.client && !slot.streaming && slot.isIdle() && slot.client->available() <= 0) {
+            if (nullptr == oldest || slot.lastactivity < oldest->lastactivity) {
+                oldest = &slot;
+            }
+        }
+    }
+
+    if (nullptr != oldest) {
+        closeClient(*oldest);
+    }
+}
+
+/**
+ * take in whatever a client has sent, and answer its request once whole
+ */
+void HttpServerInterfaceImpl::pollClient(HttpClientSlot& slot){
+
+    if (nullptr == slot.client) {
+        return;
+    }
+
+    uint64_t now = __i_instance.getUtilityInstance().millis_now();
+
+    if (!slot.client->connected() && slot.client->available() <= 0 && 0 == slot.carry) {
+        closeClient(slot);
+        return;
+    }
+
+    if (slot.streaming) {
+        pollStream(slot);
+        return;
+    }
+
+    // Read no further than the end of the current request. The head is read
+    // in blocks, so what a block brings past it is carried in the buffer and
+    // taken ahead of the socket: by the body, a multipart part, or the next
+    // pipelined request.
+    while (HTTP_PARSE_READY != slot.state && (0 != slot.carry || slot.client->available() > 0)) {
+
+        if (HTTP_PARSE_BODY == slot.state) {
+
+            HttpRequestData &request = slot.request;
+            uint8_t scrap[64];
+            uint8_t *into = slot.keepbody ? (uint8_t *)request.buffer + request.used : scrap;
+            uint32_t want = slot.contentLength - slot.bodyread;
+            if (!slot.keepbody && want > sizeof(scrap)) {
+                want = sizeof(scrap);
+            }
+            // admission already bounds a kept body, this keeps the read inside
+            // the buffer whatever the length said
+            if (slot.keepbody && want > (uint32_t)(HTTP_SERVER_REQUEST_BUFFER_SIZE - 1 - request.used)) {
+                want = HTTP_SERVER_REQUEST_BUFFER_SIZE - 1 - request.used;
+            }
+
+            int32_t got = 0;
+            if (0 != slot.carry) {
+                got = want < slot.carry ? want : slot.carry;
+                if (slot.keepbody) {
+                    memmove(into, request.buffer + slot.carryat, got);
                 }
+                slot.carryat += got;
+                slot.carry -= got;
+            } else {
+                got = slot.client->read(into, want);
+            }
+            if (got <= 0) {
+                break;
+            }
+            slot.bodyread += got;
+            if (slot.keepbody) {
+                request.used += got;
             }
 
-            if (!uriFound) {
-                // If no handler was found, call the notFoundHandler
-                if (UriToHandlerMap::notFoundHandler) {
-                    UriToHandlerMap::notFoundHandler();
+            if (slot.bodyread >= slot.contentLength) {
+                if (slot.keepbody) {
+                    request.buffer[request.used] = '\0';
+                    parseArgs(request, request.buffer + request.used - slot.bodyread);
                 }
+                slot.state = HTTP_PARSE_READY;
             }
+        } else if (!readHead(slot)) {
+            break;
+        }
+
+        slot.lastactivity = now;
+    }
+
+    if (HTTP_PARSE_READY == slot.state) {
+        dispatchRequest(slot);
+        return;
+    }
 
-            if(!m_clientRequest.isPending){
-                m_clientRequest.clear();
+    // An idle connection is held for the keep-alive time it was promised, one
+    // that stops part way through a request only briefly.
+    uint32_t timeout = slot.isIdle() ? HTTP_DEFAULT_KEEP_ALIVE_MS : HTTP_SERVER_REQUEST_TIMEOUT_MS;
+    if ((now - slot.lastactivity) > timeout) {
+        closeClient(slot);
+    }
+}
+
+/**
+ * @brief take the request line and headers a block at a time. the block goes
+ * to the free tail of the buffer and is parsed where it lies: a byte is only
+ * ever written back at or before the one being taken, so the lines build up
+ * behind the bytes still to come. what is left once the head ends is carry.
+ * @return false when the socket had nothing after all
+ */
+bool HttpServerInterfaceImpl::readHead(HttpClientSlot& slot){
+
+    HttpRequestData &request = slot.request;
+
+    if (0 == slot.carry) {
+
+        uint16_t room = HTTP_SERVER_REQUEST_BUFFER_SIZE - 1 - request.used;
+        if (0 == room) {
+            // a full line is about to be refused, see takeHeadByte
+            takeHeadByte(slot, (char)slot.client->read());
+            return true;
+        }
+
+        int32_t got = slot.client->read((uint8_t *)request.buffer + request.used, room);
+        if (got <= 0) {
+            return false;
+        }
+        slot.carryat = request.used;
+        slot.carry = got;
+    }
+
+    while (0 != slot.carry && (HTTP_PARSE_REQUEST_LINE == slot.state || HTTP_PARSE_HEADERS == slot.state)) {
+        char c = request.buffer[slot.carryat++];
+        slot.carry--;
+        takeHeadByte(slot, c);
+    }
+    return true;
+}
+
+/**
+ * @brief take one byte of the request line or headers. a line is built up in
+ * the request buffer and parsed where it lies once its newline arrives.
+ */
+void HttpServerInterfaceImpl::takeHeadByte(HttpClientSlot& slot, char c){
+
+    HttpRequestData &request = slot.request;
+
+    if ('\n' == c) {
+
+        if (slot.skipline) {
+            // nothing of the line was kept. an overlong request line is still
+            // followed by headers, which are read past until the blank line
+            slot.skipline = false;
+            if (HTTP_PARSE_REQUEST_LINE == slot.state) {
+                slot.state = HTTP_PARSE_HEADERS;
             }
-            
-            // Flush the client buffer
-            m_client->flush(FLUSH_ALL);
+            return;
+        }
 
-            // Update current client liast activity timestamp
-            m_currentclient_lastactivity_timestamp = __i_instance.getUtilityInstance().millis_now();
+        uint16_t end = request.used;
+        if (end > slot.linestart && '\r' == request.buffer[end - 1]) {
+            end--;
         }
+        request.buffer[end] = '\0';
+        request.used = end + 1;
 
-        // Only one client is served at a time, so an idle keep-alive connection
-        // is given up as soon as another one is waiting. Holding it would leave
-        // the waiting connection to be reset by the accept that follows it.
-        else if( !m_clientRequest.isPending && m_server->hasClient() ){
+        if (HTTP_PARSE_REQUEST_LINE == slot.state) {
+            parseRequestLine(slot);
+        } else {
+            parseHeaderLine(slot);
+        }
+
+        slot.linestart = request.used;
+        slot.valuestart = 0;
+        return;
+    }
 
-            closeClient();
-            m_currentclient_lastactivity_timestamp = 0;
+    if (slot.skipline) {
+        return;
+    }
+
+    // one byte is always left for the NUL that ends the line
+    if (request.used + 1 >= HTTP_SERVER_REQUEST_BUFFER_SIZE) {
+        if (0 == slot.refusal) {
+            slot.refusal = HTTP_PARSE_REQUEST_LINE == slot.state ?
+                HTTP_RESP_URI_TOO_LONG : HTTP_RESP_REQUEST_HEADER_FIELDS_TOO_LARGE;
+        }
+        request.used = slot.linestart;
+        slot.skipline = true;
+        return;
+    }
+
+    // a header nobody collects is dropped as soon as its name is known, so it
+    // takes no room however long its value runs
+    if (HTTP_PARSE_HEADERS == slot.state && ':' == c && 0 == slot.valuestart) {
+
+        request.buffer[request.used] = '\0';
+        const char *key = request.buffer + slot.linestart;
+
+        if (!isCollectedHeader(key) &&
+            0 != strcasecmp(key, HTTP_HEADER_KEY_CONTENT_TYPE) &&
+            0 != strcasecmp(key, HTTP_HEADER_KEY_CONTENT_LENGTH)) {
+            request.used = slot.linestart;
+            slot.skipline = true;
             return;
         }
+        slot.valuestart = ++request.used;
+        return;
+    }
+
+    request.buffer[request.used++] = c;
+}
+
+/**
+ * @brief parse the request line, e.g. GET /index.html?a=1 HTTP/1.1
+ */
+void HttpServerInterfaceImpl::parseRequestLine(HttpClientSlot& slot){
+
+    HttpRequestData &request = slot.request;
+    char *line = request.buffer + slot.linestart;
+
+    // blank lines ahead of a request are skipped, some clients send one after a body
+    if ('\0' == *line) {
+        request.used = slot.linestart;
+        return;
+    }
+
+    slot.state = HTTP_PARSE_HEADERS;
+
+    // Split the request line into components where it lies
+    char *uri = strchr(line, ' ');
+    char *version = uri ? strchr(uri + 1, ' ') : nullptr;
+    if (nullptr == version) {
+        return;
+    }
+    *uri++ = '\0';
+    *version++ = '\0';
+
+    request.method = line;
+    request.uri = uri;
+    request.version = version;
+
+    char *query = strchr(uri, '?');
+    if (nullptr != query) {
+        *query++ = '\0';
+        parseArgs(request, query);
+    }
+}
+
+/**
+ * @brief parse one header line, the empty one ends the headers
+ */
+void HttpServerInterfaceImpl::parseHeaderLine(HttpClientSlot& slot){
+
+    HttpRequestData &request = slot.request;
+    char *key = request.buffer + slot.linestart;
+
+    if ('\0' == *key) {
+
+        request.used = slot.linestart;
+
+        if (0 != slot.refusal) {
+            slot.state = HTTP_PARSE_READY;
+        } else if (slot.isForm) {
+            // a multipart body is streamed to storage by the handler pass
+            // rather than being held here, see parseRequest
+            slot.state = HTTP_PARSE_READY;
+        } else if (slot.contentLength > 0) {
+            // a url encoded body is kept for its arguments, any other is read
+            // past so the next pipelined request starts where it should
+            slot.keepbody = slot.isEncoded;
+            slot.state = HTTP_PARSE_BODY;
+            // subtracted rather than added so a length near 4G cannot wrap past
+            // the check; the refusal goes out now, not after a body that size
+            if (slot.keepbody && slot.contentLength >= (uint32_t)(HTTP_SERVER_REQUEST_BUFFER_SIZE - request.used)) {
+                slot.keepbody = false;
+                slot.refusal = HTTP_RESP_PAYLOAD_TOO_LARGE;
+                slot.state = HTTP_PARSE_READY;
+            }
+        } else {
+            slot.state = HTTP_PARSE_READY;
+        }
+        return;
+    }
+
+    // a line without a colon is not a header
+    if (0 == slot.valuestart) {
+        request.used = slot.linestart;
+        return;
+    }
+
+    char *value = request.buffer + slot.valuestart;
+    while (' ' == *value || '\t' == *value) {
+        value++;
+    }
+
+    if (0 == strcasecmp(key, HTTP_HEADER_KEY_CONTENT_TYPE)) {
+
+        if (0 == strncmp_ro(value, HTTP_CONTENT_TYPE_URLENCODED, strlen_ro(HTTP_CONTENT_TYPE_URLENCODED))) {
+            slot.isForm = false;
+            slot.isEncoded = true;
+        } else if (0 == strncmp_ro(value, HTTP_CONTENT_TYPE_MULTIPART, strlen_ro(HTTP_CONTENT_TYPE_MULTIPART))) {
+            char *boundary = strchr(value, '=');
+            if (nullptr != boundary) {
+                boundary++;
+                if ('"' == *boundary) {
+                    boundary++;
+                    char *quote = strchr(boundary, '"');
+                    if (quote) {
+                        *quote = '\0';
+                    }
+                }
+                slot.isForm = true;
+                slot.boundary = boundary;
+            }
+        }
+    } else if (0 == strcasecmp(key, HTTP_HEADER_KEY_CONTENT_LENGTH)) {
+        slot.contentLength = StringToUint32(value);
+    }
+
+    // Keep the header if it is in the list of headers to collect. the
+    // content type stays too while the boundary points into it.
+    if (isCollectedHeader(key) && request.headercount < HTTP_SERVER_MAX_HEADERS) {
+        request.headers[request.headercount].key = key;
+        request.headers[request.headercount].value = value;
+        request.headercount++;
+    } else if (nullptr == slot.boundary || slot.boundary < key) {
+        request.used = slot.linestart;
+    }
+}
+
+/**
+ * @brief whether a header is in the list of headers to collect
+ */
+bool HttpServerInterfaceImpl::isCollectedHeader(const char *key) const{
+
+    for (size_t i = 0; i < m_collectHeaders.size(); i++){
+        if (m_collectHeaders[i].key && 0 == strcasecmp(m_collectHeaders[i].key, key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief split a query string or url encoded body into arguments where it lies
+ */
+void HttpServerInterfaceImpl::parseArgs(HttpRequestData& request, char *text){
+
+    while (nullptr != text && '\0' != *text) {
+
+        char *next = strchr(text, '&');
+        if (nullptr != next) {
+            *next++ = '\0';
+        }
+
+        char *value = strchr(text, '=');
+        if (nullptr != value && request.argcount < HTTP_SERVER_MAX_ARGS) {
+            *value++ = '\0';
+            urlDecode(text);
+            urlDecode(value);
+            request.args[request.argcount].key = text;
+            request.args[request.argcount].value = value;
+            request.argcount++;
+        }
+
+        text = next;
+    }
+}
+
+/**
+ * @brief answer the request a slot has finished reading
+ */
+void HttpServerInterfaceImpl::dispatchRequest(HttpClientSlot& slot){
+
+    m_client = slot.client;
+    m_clientSlot = &slot;
+    m_clientRequest = &slot.request;
+
+    // bytes read past the head wait at the end of the buffer, out of the way
+    // of the route arguments added after the request
+    if (0 != slot.carry) {
+        memmove(slot.request.buffer + HTTP_SERVER_REQUEST_BUFFER_SIZE - slot.carry, slot.request.buffer + slot.carryat, slot.carry);
+        slot.carryat = HTTP_SERVER_REQUEST_BUFFER_SIZE - slot.carry;
+    }
+
+    // The response promised to close unless the client asked to keep the
+    // connection, see prepareResponseHeader
+    const char *connection = headerView(HTTP_HEADER_KEY_CONNECTION);
+    bool keepalive = nullptr != connection && '\0' != *connection && 0 != strcasecmp(connection, "close");
 
-        // Check for keep-alive timeout
-        if( m_currentclient_lastactivity_timestamp != 0 &&
-            (__i_instance.getUtilityInstance().millis_now() - m_currentclient_lastactivity_timestamp) > HTTP_DEFAULT_KEEP_ALIVE_MS ){
-            closeClient();
-            m_currentclient_lastactivity_timestamp = 0;
+    if (0 != slot.refusal) {
+
+        // a request that did not fit is answered without its handler, and
+        // the connection is not trusted with another
+        send(slot.refusal, MIME_TYPE_TEXT_PLAIN, "");
+        keepalive = false;
+    }
+    #if defined(ENABLE_HTTPS_SERVER) && defined(ENABLE_TLS_SERVICE)
+    else if( !m_client->isSecure() ){
+        sendHttpsRedirect();
+    }
+    #endif
+    else {
+
+        // Multipart fields and files
+        parseRequest(slot);
+
+        // Handle the request based on the URI and method
+        bool pathfound = false;
+        int16_t route = findRoute(m_clientRequest->uri, getHttpMethod(m_clientRequest->method), pathfound);
+
+        if (HttpRouteTable::NO_ROUTE != route) {
+            // Call the registered handler for the URI
+            if (m_uriHandlerMap[route].urihandler) {
+                m_uriHandlerMap[route].urihandler();
+            }
+        } else if (pathfound) {
+            send(HTTP_RESP_METHOD_NOT_ALLOWED, MIME_TYPE_TEXT_PLAIN, "");
+        } else {
+            // If no handler was found, call the notFoundHandler
+            if (UriToHandlerMap::notFoundHandler) {
+                UriToHandlerMap::notFoundHandler();
+            }
         }
-    } else if (m_client && !m_client->connected()) {
-        closeClient();
+    }
+
+    // Flush the client buffer
+    m_client->flush(FLUSH_ALL);
+
+    m_client = nullptr;
+    m_clientSlot = nullptr;
+    m_clientRequest = nullptr;
+
+    // what was read past this request starts the next one
+    uint16_t carryat = slot.carryat;
+    uint16_t carry = slot.carry;
+    slot.reset();
+    if (0 != carry && !slot.streaming) {
+        memmove(slot.request.buffer, slot.request.buffer + carryat, carry);
+        slot.carry = carry;
+    }
+    slot.lastactivity = __i_instance.getUtilityInstance().millis_now();
+
+    // a stream outlives its request whatever the client asked for
+    if (!keepalive && !slot.streaming) {
+        closeClient(slot);
     }
 }
 
@@ -240,7 +655,7 @@ void HttpServerInterfaceImpl::handleClient(){
  * close
  */
 void HttpServerInterfaceImpl::close(){
-    closeClient();
+    closeClients();
     if( nullptr != m_server ){
         m_server->close();
     }
@@ -254,15 +669,14 @@ void HttpServerInterfaceImpl::close(){
 #if defined(ENABLE_HTTPS_SERVER) && defined(ENABLE_TLS_SERVICE)
 void HttpServerInterfaceImpl::sendHttpsRedirect(){
 
-    pdiutil::string host = header(CHARPTR_WRAP(HTTP_HEADER_KEY_HOST));
-    pdiutil::string::size_type port_sep = host.find(':');
-    if( port_sep != pdiutil::string::npos ){
-        host = host.substr(0, port_sep);
-    }
+    const char *host = headerView(HTTP_HEADER_KEY_HOST);
+    const char *port_sep = host ? strchr(host, ':') : nullptr;
 
     pdiutil::string location = CHARPTR_WRAP("https://");
-    location += host;
-    location += m_clientRequest.uri;
+    if( host ){
+        location.append(host, port_sep ? (pdiutil::string::size_type)(port_sep - host) : strlen(host));
+    }
+    location += m_clientRequest->uri;
 
     addHeader(CHARPTR_WRAP(HTTP_HEADER_KEY_LOCATION), location);
     send(HTTP_RESP_MOVED_PERMANENTLY);
@@ -273,11 +687,84 @@ void HttpServerInterfaceImpl::sendHttpsRedirect(){
  * on uri find call registered handler
  */
 void HttpServerInterfaceImpl::on(const pdiutil::string &uri, CallBackVoidArgFn handler){
-    uint32_t before = m_uriHandlerMap.size();
-    m_uriHandlerMap.push_back({uri, handler});
+    on(uri, HTTP_METHOD_MAX, handler);
+}
+
+/**
+ * on uri and method find call registered handler. a path segment starting
+ * with ':' is a parameter, read by the handler as an argument of that name.
+ */
+void HttpServerInterfaceImpl::on(const pdiutil::string &uri, http_method_t method, CallBackVoidArgFn handler){
+    int16_t route = m_uriHandlerMap.size();
+    m_uriHandlerMap.push_back({handler, method, HttpRouteTable::NO_ROUTE});
 
-    if (m_uriHandlerMap.size() == before) {
+    if (m_uriHandlerMap.size() == (uint32_t)route) {
         SysLogE("HTTP: route %s not registered, out of memory\n", uri.c_str());
+        return;
+    }
+
+    // routes of one pattern are chained, newest first
+    int16_t previous = m_routes.insert(uri.c_str(), route);
+    m_uriHandlerMap[route].next = previous;
+}
+
+/**
+ * @brief the route for a request. one registered for its method is taken
+ * over one for any method, and the earliest registered wins a tie. pathfound
+ * tells a path with no route for this method from a path with none at all.
+ */
+int16_t HttpServerInterfaceImpl::findRoute(const char *uri, http_method_t method, bool &pathfound){
+
+    HttpRouteParam params[HTTP_SERVER_MAX_ROUTE_PARAMS];
+    uint8_t paramcount = 0;
+    int16_t chain = m_routes.match(uri, params, HTTP_SERVER_MAX_ROUTE_PARAMS, paramcount);
+
+    pathfound = HttpRouteTable::NO_ROUTE != chain;
+
+    int16_t exact = HttpRouteTable::NO_ROUTE;
+    int16_t any = HttpRouteTable::NO_ROUTE;
+    for (int16_t i = chain; HttpRouteTable::NO_ROUTE != i; i = m_uriHandlerMap[i].next) {
+        if (m_uriHandlerMap[i].method == method) {
+            exact = i;
+        } else if (HTTP_METHOD_MAX == m_uriHandlerMap[i].method) {
+            any = i;
+        }
+    }
+
+    int16_t route = HttpRouteTable::NO_ROUTE != exact ? exact : any;
+    if (HttpRouteTable::NO_ROUTE != route && paramcount > 0) {
+        addRouteArgs(*m_clientSlot, params, paramcount);
+    }
+    return route;
+}
+
+/**
+ * @brief make path parameters arguments of the request. their text is copied
+ * past the end of what the request buffer holds, a parameter without room
+ * there is left out. like the uri they come from, they are not url decoded.
+ */
+void HttpServerInterfaceImpl::addRouteArgs(HttpClientSlot& slot, const HttpRouteParam *params, uint8_t count){
+
+    HttpRequestData &request = slot.request;
+    for (uint8_t i = 0; i < count && request.argcount < HTTP_SERVER_MAX_ARGS; i++) {
+
+        uint16_t need = params[i].namelen + params[i].valuelen + 2;
+        if (request.used + need > HTTP_SERVER_REQUEST_BUFFER_SIZE - slot.carry) {
+            break;
+        }
+
+        char *key = request.buffer + request.used;
+        memcpy(key, params[i].name, params[i].namelen);
+        key[params[i].namelen] = '\0';
+
+        char *value = key + params[i].namelen + 1;
+        memcpy(value, params[i].value, params[i].valuelen);
+        value[params[i].valuelen] = '\0';
+
+        request.used += need;
+        request.args[request.argcount].key = key;
+        request.args[request.argcount].value = value;
+        request.argcount++;
     }
 }
 
@@ -289,28 +776,66 @@ void HttpServerInterfaceImpl::onNotFound(CallBackVoidArgFn fn){
     UriToHandlerMap::notFoundHandler = fn;
 }
 
+/**
+ * isKeyNamed
+ * whether a NUL terminated key of the request is the name asked for, which
+ * is a view and so need not be terminated itself
+ */
+static bool isKeyNamed(const char *key, pdiutil::string_view name, bool anycase){
+    if (nullptr == key) {
+        return false;
+    }
+    int differs = anycase ? strncasecmp(key, name.data(), name.size()) : strncmp(key, name.data(), name.size());
+    return 0 == differs && '\0' == key[name.size()];
+}
+
 /**
  * arg
  * get request argument value by name
  */
 pdiutil::string HttpServerInterfaceImpl::arg(const pdiutil::string &name) const {
+    return pdiutil::string(argView(pdiutil::string_view(name)));
+}
+
+/**
+ * argView
+ * get request argument value by name without copying it. the view lives in
+ * the request buffer, so it is only good until the handler returns.
+ */
+const char *HttpServerInterfaceImpl::argView(const char *name) const {
+    if (nullptr == name) {
+        return nullptr;
+    }
+    // the values found are NUL terminated where they lie
+    return argView(pdiutil::string_view(name)).data();
+}
+
+/**
+ * argView
+ * get request argument value by a name that is itself a view, say one cut
+ * from a uri, without copying either. an absent argument has a null data().
+ */
+pdiutil::string_view HttpServerInterfaceImpl::argView(pdiutil::string_view name) const {
+    if (nullptr == m_clientRequest) {
+        return pdiutil::string_view(); // No request being answered
+    }
     // Check if the query/form name exists in the request
-    for (uint32_t j = 0; j < m_clientRequest.queries.size(); j++){
-        if (m_clientRequest.queries[j].isKeyMatch(name.c_str())) {
-            return m_clientRequest.queries[j].value ? m_clientRequest.queries[j].value : "";
+    for (uint8_t j = 0; j < m_clientRequest->argcount; j++){
+        if (isKeyNamed(m_clientRequest->args[j].key, name, false)) {
+            return m_clientRequest->args[j].value;
         }
     }
-    for (uint32_t j = 0; j < m_clientRequest.formdata.size(); j++){
-        if (m_clientRequest.formdata[j].isKeyMatch(name.c_str())) {
-            return m_clientRequest.formdata[j].value ? m_clientRequest.formdata[j].value : "";
+    for (uint32_t j = 0; j < m_clientRequest->formdata.size(); j++){
+        if (isKeyNamed(m_clientRequest->formdata[j].key, name, false)) {
+            return m_clientRequest->formdata[j].value ? m_clientRequest->formdata[j].value : "";
         }
     }
-    for (uint32_t j = 0; j < m_clientRequest.files.size(); j++){
-        if (m_clientRequest.files[j].isKeyMatch(name.c_str())) {
-            return m_clientRequest.files[j].value ? m_clientRequest.files[j].value : "";
+    for (uint32_t j = 0; j < m_clientRequest->files.size(); j++){
+        if (isKeyNamed(m_clientRequest->files[j].key, name, false)) {
+            return m_clientRequest->files[j].value ? m_clientRequest->files[j].value : "";
         }
     }
-    return "";
+    return pdiutil::string_view();
 }
 
 /**
@@ -319,22 +844,7 @@ pdiutil::string HttpServerInterfaceImpl::arg(const pdiutil::string &name) const
  * exists, so a form clearing a field is not mistaken for a form never sent.
  */
 bool HttpServerInterfaceImpl::hasArg(const pdiutil::string &name) const{
-    for (uint32_t j = 0; j < m_clientRequest.queries.size(); j++){
-        if (m_clientRequest.queries[j].isKeyMatch(name.c_str())) {
-            return true;
-        }
-    }
-    for (uint32_t j = 0; j < m_clientRequest.formdata.size(); j++){
-        if (m_clientRequest.formdata[j].isKeyMatch(name.c_str())) {
-            return true;
-        }
-    }
-    for (uint32_t j = 0; j < m_clientRequest.files.size(); j++){
-        if (m_clientRequest.files[j].isKeyMatch(name.c_str())) {
-            return true;
-        }
-    }
-    return false;
+    return nullptr != argView(pdiutil::string_view(name)).data();
 }
 
 /**
@@ -342,8 +852,7 @@ bool HttpServerInterfaceImpl::hasArg(const pdiutil::string &name) const{
  * check if the request method is POST
  */
 bool HttpServerInterfaceImpl::isPostRequest() const{
-    pdiutil::string method_post = CHARPTR_WRAP("POST");
-    return (m_clientRequest.method == method_post);
+    return (nullptr != m_clientRequest && 0 == strcmp(m_clientRequest->method, "POST"));
 }
 
 /**
@@ -351,7 +860,7 @@ bool HttpServerInterfaceImpl::isPostRequest() const{
  * set the request headers to collect
  */
 void HttpServerInterfaceImpl::collectHeaders(const char *headerKeys[], const size_t headerKeysCount){
-    m_clientRequest.headers.clear();
+    m_collectHeaders.clear();
 
     // Add default headers to collect list
     pdiutil::string host_key = CHARPTR_WRAP(HTTP_HEADER_KEY_HOST);
@@ -359,11 +868,11 @@ void HttpServerInterfaceImpl::collectHeaders(const char *headerKeys[], const siz
     pdiutil::string connection_key = CHARPTR_WRAP(HTTP_HEADER_KEY_CONNECTION);
     pdiutil::string content_type_key = CHARPTR_WRAP(HTTP_HEADER_KEY_CONTENT_TYPE);
     pdiutil::string content_length_key = CHARPTR_WRAP(HTTP_HEADER_KEY_CONTENT_LENGTH);
-    m_clientRequest.headers.push_back({host_key.c_str(), nullptr});
-    m_clientRequest.headers.push_back({authorization_key.c_str(), nullptr});
-    m_clientRequest.headers.push_back({connection_key.c_str(), nullptr});
-    m_clientRequest.headers.push_back({content_type_key.c_str(), nullptr});
-    m_clientRequest.headers.push_back({content_length_key.c_str(), nullptr});
+    m_collectHeaders.push_back({host_key.c_str(), nullptr});
+    m_collectHeaders.push_back({authorization_key.c_str(), nullptr});
+    m_collectHeaders.push_back({connection_key.c_str(), nullptr});
+    m_collectHeaders.push_back({content_type_key.c_str(), nullptr});
+    m_collectHeaders.push_back({content_length_key.c_str(), nullptr});
 
     // Collect headers from the provided header keys
     for (size_t i = 0; i < headerKeysCount; ++i) {
@@ -372,15 +881,15 @@ void HttpServerInterfaceImpl::collectHeaders(const char *headerKeys[], const siz
             bool isHeaderCollected = false;
 
             // Check if the header already exists in the request
-            for (size_t j = 0; j < m_clientRequest.headers.size(); j++){
-                if (m_clientRequest.headers[j].isKeyMatch(headerKeys[i])) {
+            for (size_t j = 0; j < m_collectHeaders.size(); j++){
+                if (m_collectHeaders[j].isKeyMatch(headerKeys[i])) {
                     isHeaderCollected = true;
                     break;
                 }
             }
 
             if (!isHeaderCollected) {
-                m_clientRequest.headers.push_back({headerKeys[i], nullptr});
+                m_collectHeaders.push_back({headerKeys[i], nullptr});
             }
         }
     }
@@ -391,21 +900,44 @@ void HttpServerInterfaceImpl::collectHeaders(const char *headerKeys[], const siz
  * get request header value by name
  */
 pdiutil::string HttpServerInterfaceImpl::header(const pdiutil::string &name) const {
-    // Check if the header name exists in the request
-    for (uint32_t j = 0; j < m_clientRequest.headers.size(); j++){
-        if (m_clientRequest.headers[j].isKeyMatch(name.c_str())) {
-            return m_clientRequest.headers[j].value ? m_clientRequest.headers[j].value : "";
+    return pdiutil::string(headerView(pdiutil::string_view(name)));
+}
+
+/**
+ * headerView
+ * get request header value by name without copying it, good until the
+ * handler returns. header names are matched regardless of case.
+ */
+const char *HttpServerInterfaceImpl::headerView(const char *name) const {
+    if (nullptr == name) {
+        return nullptr;
+    }
+    return headerView(pdiutil::string_view(name)).data();
+}
+
+/**
+ * headerView
+ * get request header value by a name that is itself a view. an absent
+ * header has a null data().
+ */
+pdiutil::string_view HttpServerInterfaceImpl::headerView(pdiutil::string_view name) const {
+    if (nullptr == m_clientRequest) {
+        return pdiutil::string_view(); // No request being answered
+    }
+    for (uint8_t j = 0; j < m_clientRequest->headercount; j++){
+        if (isKeyNamed(m_clientRequest->headers[j].key, name, true)) {
+            return m_clientRequest->headers[j].value;
         }
     }
-    return "";
+    return pdiutil::string_view();
 }
 
 /**
  * hasHeader
  * check if header exists
  */
-bool HttpServerInterfaceImpl::hasHeader(const pdiutil::string &name) const{    
-    return !header(name).empty();
+bool HttpServerInterfaceImpl::hasHeader(const pdiutil::string &name) const{
+    return !headerView(pdiutil::string_view(name)).empty();
 }
 
 /**
@@ -446,181 +978,200 @@ void HttpServerInterfaceImpl::send(int code, mimetype_t content_type, const char
  */
 void HttpServerInterfaceImpl::sendChunk(const char *chunk){
 
-    int32_t chunklen = strlen(chunk);
-    
-    if( chunk && chunklen >= 0 ){
-    
-        // Send the chunk in response
-        char temp[20]; memset(temp, 0, 20);
-        __snprintf(temp, 20, "%X\r\n", chunklen);
-
-        sendPacket(m_client, (uint8_t *)temp, strlen(temp));
-        __i_instance.getUtilityInstance().yield();
-        sendPacket(m_client, (uint8_t *)chunk, chunklen, 400, 5000);
-        __i_instance.getUtilityInstance().yield();
-        sendPacket(m_client, (uint8_t *)"\r\n", 2);
-        __i_instance.getUtilityInstance().yield();
+    if( chunk ){
+        writeChunk(m_client, chunk, strlen(chunk));
     }
 }
 
 /**
- * @brief parse incoming HTTP request.
+ * @brief write one chunk of a chunked body to a client, an empty one ends it.
+ * false when the client could not take it.
  */
-void HttpServerInterfaceImpl::parseRequest(){
+bool HttpServerInterfaceImpl::writeChunk(iClientInterface* client, const char *data, uint16_t len){
 
-    if (!m_server || !m_client) {
-        return; // Client/Server not initialized
-    }
+    char temp[20]; memset(temp, 0, 20);
+    __snprintf(temp, 20, "%X\r\n", len);
 
-    int32_t max_timeout = HTTP_CLIENT_MAX_READ_MS;
-    uint32_t start = __i_instance.getUtilityInstance().millis_now();
-    uint32_t now = start;
-    pdiutil::string request_line;
-    CallBackVoidArgFn readLineYield = [&]() {
+    bool sent = sendPacket(client, (uint8_t *)temp, strlen(temp));
+    __i_instance.getUtilityInstance().yield();
+    if( sent && len > 0 ){
+        sent = sendPacket(client, (uint8_t *)data, len, 400, 5000);
         __i_instance.getUtilityInstance().yield();
-    };
+    }
+    sent = sent && sendPacket(client, (uint8_t *)"\r\n", 2);
+    __i_instance.getUtilityInstance().yield();
+    return sent;
+}
 
-    // Read the request line
-    m_client->readLine(request_line, readLineYield);
+/**
+ * @brief answer the current request with a text/event-stream body and keep the
+ * slot for it. events go out as chunks of that body, each one whole, so a
+ * client reads them as they are sent and the slot holds no buffer meanwhile.
+ */
+int16_t HttpServerInterfaceImpl::openEventStream(){
 
-    if (request_line.empty()) {
-        return; // No request line received
+    if (nullptr == m_clientSlot || nullptr == m_client) {
+        return -1; // not inside a handler
     }
 
-    // Parse the request line
-    // Example: GET /index.html HTTP/1.1
-    pdiutil::string method;
-    pdiutil::string uri;
-    pdiutil::string version;
+    if (m_clientSlot->streaming) {
+        return (int16_t)(((m_clientSlot->streamserial & 0x7F) << 8) | (m_clientSlot - m_slots));
+    }
 
-    // Split the request line into components
-    pdiutil::string::size_type pos1 = request_line.find(' ');
-    pdiutil::string::size_type pos2 = request_line.find(' ', pos1 + 1);
+    uint8_t streams = 0;
+    for (uint8_t i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++) {
+        if (nullptr != m_slots[i].client && m_slots[i].streaming) {
+            streams++;
+        }
+    }
 
-    if (pos1 != pdiutil::string::npos && pos2 != pdiutil::string::npos) {
-        method = request_line.substr(0, pos1);
-        uri = request_line.substr(pos1 + 1, pos2 - pos1 - 1);
-        version = request_line.substr(pos2 + 1);
+    if (streams >= HTTP_SERVER_MAX_EVENT_STREAMS) {
+        send(HTTP_RESP_SERVICE_UNAVAILABLE, MIME_TYPE_TEXT_PLAIN, "");
+        return -1;
     }
 
-    // Set the parsed values to the request structure
-    m_clientRequest.uri = uri;
-    m_clientRequest.method = method;
-    m_clientRequest.version = version;
+    addHeader(CHARPTR_WRAP_RO(HTTP_HEADER_KEY_CACHE_CONTROL), CHARPTR_WRAP_RO(HTTP_HEADER_VALUE_NO_CACHE));
 
-    // Read headers
-    pdiutil::string header_line;
-    bool isForm = false; // Indicates form data
-    bool isEncoded = false; // Indicates encoded data
-    pdiutil::string boundaryStr; // Boundary for multipart/form-data
-    uint32_t contentLength = 0; // Content length
-    pdiutil::string content_type_key = CHARPTR_WRAP(HTTP_HEADER_KEY_CONTENT_TYPE);
-    pdiutil::string content_length_key = CHARPTR_WRAP(HTTP_HEADER_KEY_CONTENT_LENGTH);
+    pdiutil::string response;
+    prepareResponseHeader(response, HTTP_RESP_OK, "text/event-stream", 0, true);
+    sendPacket(m_client, (uint8_t *)response.c_str(), response.length());
 
-    while (1) {
+    m_clientSlot->streaming = true;
+    m_clientSlot->streamserial++;
+    return (int16_t)(((m_clientSlot->streamserial & 0x7F) << 8) | (m_clientSlot - m_slots));
+}
 
-        m_client->readLine(header_line, readLineYield, 256);
-        if(header_line.empty()) break; // Exit if no more headers
+/**
+ * @brief the slot still carrying the stream a handle was given for
+ */
+HttpServerInterfaceImpl::HttpClientSlot* HttpServerInterfaceImpl::findStream(int16_t stream){
 
-        // Split header line into key and value
-        pdiutil::string::size_type colon_pos = header_line.find(':');
-        if (colon_pos != pdiutil::string::npos) {
-            pdiutil::string key = header_line.substr(0, colon_pos);
-            pdiutil::string value = header_line.substr(colon_pos + 1);
-            // Trim leading spaces from value
-            value.erase(0, value.find_first_not_of(' '));
+    if (stream < 0 || (stream & 0xFF) >= HTTP_SERVER_MAX_CLIENTS) {
+        return nullptr;
+    }
 
-            // Collect header if it is in the list of headers to collect
-            for (size_t i = 0; i < m_clientRequest.headers.size(); i++){
-                m_clientRequest.headers[i].setvalue(key.c_str(), value.c_str());
-            }
+    HttpClientSlot &slot = m_slots[stream & 0xFF];
+    if (nullptr == slot.client || !slot.streaming || (slot.streamserial & 0x7F) != ((stream >> 8) & 0x7F)) {
+        return nullptr;
+    }
+    return &slot;
+}
 
-            if( key == content_type_key ){
+/**
+ * @brief send one event, "event: name" when named, then its data line
+ */
+bool HttpServerInterfaceImpl::sendEvent(int16_t stream, const char *event, const char *data){
 
-                if( value.find(getMimeTypeString(MIME_TYPE_APPLICATION_X_WWW_FORM_URLENCODED)) != pdiutil::string::npos ){
-                    isForm = false;
-                    isEncoded = true;
-                } else if( value.find(ROPTR_WRAP("multipart/")) != pdiutil::string::npos ){
-                    isForm = true;
-                    boundaryStr = value.substr(value.find('=') + 1);
-                    boundaryStr.replace("\"","");
-                }
-            }else if( key == content_length_key ){
-                contentLength = StringToUint32(value.c_str());
-            }
-        }
+    HttpClientSlot *slot = findStream(stream);
+    if (nullptr == slot || nullptr == data) {
+        return false;
     }
 
-    __i_instance.getUtilityInstance().yield(); // Yield to allow other tasks to run
+    if (!slot->client->connected()) {
+        closeClient(*slot);
+        return false;
+    }
 
-    // read body if content length is specified
-    if(!isForm && contentLength > 0) {
+    pdiutil::string frame;
+    frame.reserve(strlen(data) + (nullptr != event ? strlen(event) : 0) + 16);
+    if (nullptr != event) {
+        frame += CHARPTR_WRAP("event: ");
+        frame += event;
+        frame += "\n";
+    }
+    frame += CHARPTR_WRAP("data: ");
+    frame += data;
+    frame += "\n\n";
 
-        char* body = pdiutil::safe_new_array<char>(contentLength + 1);
-        if( body ){
-            uint16_t readlen = readPacket(  m_client,
-                                            (uint8_t *)body,
-                                            contentLength,
-                                            max_timeout,
-                                            0);
+    if (!writeChunk(slot->client, frame.c_str(), frame.length())) {
+        closeClient(*slot);
+        return false;
+    }
+    slot->lastactivity = __i_instance.getUtilityInstance().millis_now();
+    return true;
+}
 
-            if (readlen > 0) {
-                body[readlen] = '\0'; // Null-terminate the body
-                m_clientRequest.body = pdiutil::string(body, readlen);
-            } else {
-                m_clientRequest.body.clear(); // Clear body if read failed
+/**
+ * @brief end a stream with the last chunk and give its slot back
+ */
+void HttpServerInterfaceImpl::closeEventStream(int16_t stream){
+
+    HttpClientSlot *slot = findStream(stream);
+    if (nullptr != slot) {
+        writeChunk(slot->client, "", 0);
+        closeClient(*slot);
+    }
+}
+
+/**
+ * @brief read a multipart body up to a delimiter the way the client's own
+ * readStringUntil does, taking what the head's last block carried first
+ */
+void HttpServerInterfaceImpl::readPartUntil(HttpClientSlot& slot, pdiutil::string& out, char delimiter, bool keepdelimiter, const CallBackVoidArgFn& yield, uint32_t maxlen){
+
+    uint32_t len = 0;
+    while (0 != slot.carry) {
+        char c = slot.request.buffer[slot.carryat++];
+        slot.carry--;
+        if (delimiter == c) {
+            if (keepdelimiter) {
+                out += c;
             }
-            pdiutil::safe_delete_array(body);
+            return;
+        }
+        out += c;
+        len++;
+        if (maxlen > 0 && len >= maxlen) {
+            return;
         }
     }
+    m_client->readStringUntil(out, delimiter, keepdelimiter, yield, maxlen > 0 ? maxlen - len : 0);
+}
 
-    __i_instance.getUtilityInstance().yield(); // Yield to allow other tasks to run
-
-    if(!isForm && m_clientRequest.body.length() < contentLength) {
-        return;
-    }
+/**
+ * @brief a multipart line without its line ending, see readPartUntil
+ */
+void HttpServerInterfaceImpl::readPartLine(HttpClientSlot& slot, pdiutil::string& out, const CallBackVoidArgFn& yield, uint32_t maxlen){
 
-    // Parse query parameters from the URI
-    pdiutil::string::size_type query_pos = m_clientRequest.uri.find('?');
-    if (query_pos != pdiutil::string::npos || (isEncoded && m_clientRequest.body.length() > 0)) {
+    out.clear();
+    readPartUntil(slot, out, '\r', false, yield, maxlen);
+    readPartUntil(slot, out, '\n', false, yield, 0);
+}
 
-        pdiutil::string query_string;
-        
-        if(query_pos != pdiutil::string::npos){
-            query_string = m_clientRequest.uri.substr(query_pos + 1);
-            m_clientRequest.uri = m_clientRequest.uri.substr(0, query_pos); // Update URI to exclude query string
-        }
+/**
+ * @brief a streaming client sends nothing more that is answered, whatever it
+ * does send is dropped so it cannot fill the socket. the slot is freed once
+ * the client goes away, see pollClient.
+ */
+void HttpServerInterfaceImpl::pollStream(HttpClientSlot& slot){
 
-        // If the request is a form submission, append the body to the query string
-        // This is typically used for application/x-www-form-urlencoded data
-        if(isEncoded && m_clientRequest.body.length() > 0){
-            query_string += '&';
-            query_string += m_clientRequest.body;
+    uint8_t scrap[32];
+    while (slot.client->available() > 0) {
+        if (slot.client->read(scrap, sizeof(scrap)) <= 0) {
+            break;
         }
-        
-        pdiutil::string::size_type param_start = 0;
-        pdiutil::string::size_type param_end = 0;
+    }
+}
 
-        // Parse each query parameter
-        while (param_start < query_string.length()) {
+/**
+ * @brief finish a request the slot has read: the query string and any url
+ * encoded form are already split in place, a multipart body is streamed here
+ * as it is still in the socket.
+ */
+void HttpServerInterfaceImpl::parseRequest(HttpClientSlot& slot){
 
-            param_end = query_string.find('&', param_start);
-            if (param_end == pdiutil::string::npos) {
-                param_end = query_string.length(); // Last parameter
-            }
-            pdiutil::string param = query_string.substr(param_start, param_end - param_start);
-            pdiutil::string::size_type equal_pos = param.find('=');
-            if (equal_pos != pdiutil::string::npos) {
-                pdiutil::string key = param.substr(0, equal_pos);
-                pdiutil::string value = param.substr(equal_pos + 1);
-                urlDecode(key);
-                urlDecode(value);
-                m_clientRequest.queries.push_back({key.c_str(), value.c_str()});
-            }
-            param_start = param_end + 1;
-        }
+    if (!m_server || !m_client) {
+        return; // Client/Server not initialized
     }
 
+    CallBackVoidArgFn readLineYield = [&]() {
+        __i_instance.getUtilityInstance().yield();
+    };
+
+    bool isForm = slot.isForm; // Indicates form data
+    // Boundary for multipart/form-data, a view into the slot buffer
+    pdiutil::string boundaryStr = slot.boundary ? slot.boundary : "";
+
     if(isForm){
         // Handle multipart/form-data parsing
         pdiutil::string boundary = "--" + boundaryStr;
@@ -635,7 +1186,7 @@ void HttpServerInterfaceImpl::parseRequest(){
         while (1) {
 
             pdiutil::string line;
-            m_client->readLine(line, readLineYield);
+            readPartLine(slot, line, readLineYield);
 
             // The same rule as the body reader: a socket that yields nothing is
             // only worth waiting on while the peer is still there and the wait
@@ -694,7 +1245,7 @@ void HttpServerInterfaceImpl::parseRequest(){
 
                     // Continue reading lines until we find enpty line after Content-Disposition
                     while (true){
-                        m_client->readLine(part, readLineYield); // Read the next line after Content-Disposition
+                        readPartLine(slot, part, readLineYield); // Read the next line after Content-Disposition
                         if (!part.empty()) {
                             pdiutil::string::size_type argtypeStart = part.find(ROPTR_WRAP("Content-Type: "));
                             if (argtypeStart != pdiutil::string::npos) {
@@ -708,10 +1259,10 @@ void HttpServerInterfaceImpl::parseRequest(){
 
                     if( argfilename.empty() ){
                         // Read the argument value
-                        m_client->readLine(argvalue, readLineYield, 128);
+                        readPartLine(slot, argvalue, readLineYield, 128);
 
                         // Store the argument in the request
-                        m_clientRequest.formdata.push_back({argname.c_str(), argvalue.c_str()});
+                        m_clientRequest->formdata.push_back({argname.c_str(), argvalue.c_str()});
                     }else{
 
                         // Read the file content
@@ -745,8 +1296,8 @@ void HttpServerInterfaceImpl::parseRequest(){
 
                         while (1) {
 
-                            m_client->readStringUntil(part, '\r', true, readLineYield, maxreadinonecall);
-                            m_client->readStringUntil(part, '\n', true, readLineYield, maxreadinonecall);
+                            readPartUntil(slot, part, '\r', true, readLineYield, maxreadinonecall);
+                            readPartUntil(slot, part, '\n', true, readLineYield, maxreadinonecall);
 
                             uint32_t heldbefore = lastread.length();
                             lastread += part;
@@ -863,12 +1414,12 @@ void HttpServerInterfaceImpl::parseRequest(){
                         if( upload_aborted ){
                             __i_instance.getFileSystemInstance().deleteFile(tempFilePath.c_str());
                         }else{
-                            m_clientRequest.files.push_back({argname.c_str(), tempFilePath.c_str()});
+                            m_clientRequest->files.push_back({argname.c_str(), tempFilePath.c_str()});
                         }
                         #else
                         if( !upload_aborted ){
                             argvalue = argfilename + ':' + argvalue;
-                            m_clientRequest.files.push_back({argname.c_str(), argvalue.c_str()});
+                            m_clientRequest->files.push_back({argname.c_str(), argvalue.c_str()});
                         }
                         #endif
 
@@ -897,7 +1448,7 @@ void HttpServerInterfaceImpl::prepareResponseHeader(pdiutil::string& _header, in
 
     _header.clear();
 
-    _header += m_clientRequest.version;
+    _header += m_clientRequest->version;
     _header += ' ';
     _header += pdiutil::to_string(code);
     _header += ' ';
@@ -977,15 +1528,19 @@ bool HttpServerInterfaceImpl::handleStaticFileRequest(){
 
     #ifdef ENABLE_STORAGE_SERVICE
 
-    pdiutil::string method_get = CHARPTR_WRAP("GET");
-    pdiutil::string method_head = CHARPTR_WRAP("HEAD");
-    if (m_clientRequest.method == method_get || m_clientRequest.method == method_head) {
+    if (nullptr == m_clientRequest || nullptr == m_client) {
+        return false; // No request being answered
+    }
+    if (0 == strcmp(m_clientRequest->method, "GET") || 0 == strcmp(m_clientRequest->method, "HEAD")) {
 
-        pdiutil::string filePath = m_storagePath + (m_clientRequest.uri[0] == '/' ? m_clientRequest.uri.substr(1) : m_clientRequest.uri);
-        mimetype_t filetype = __i_instance.getFileSystemInstance().getFileMimeType(filePath.c_str());
+        const char *uri = m_clientRequest->uri;
+        pdiutil::string filePath = m_storagePath + (uri[0] == '/' ? uri + 1 : uri);
+        iFileSystemInterface &fs = __i_instance.getFileSystemInstance();
+        mimetype_t filetype = fs.getFileMimeType(filePath.c_str());
 
-        // Check if the request URI is a static file
-        if (__i_instance.getFileSystemInstance().isFileExist(filePath.c_str())) {
+        // Check if the request URI is a static file, opening it checks access once
+        int16_t fd = fs.isDirectory(filePath.c_str()) ? PDI_ERR_NOT_FOUND : fs.openFile(filePath.c_str(), FILE_OPEN_READ);
+        if (fd >= 0) {
 
             if (filetype == MIME_TYPE_MAX) {
                 filetype = MIME_TYPE_TEXT_PLAIN;
@@ -994,24 +1549,25 @@ bool HttpServerInterfaceImpl::handleStaticFileRequest(){
             // Set the content type based on the file type
             // Add Content-Disposition header to force download
             m_responseHeaders.clear();
-            pdiutil::string content_disposition_value = CHARPTR_WRAP("attachment; filename=\"") + __i_instance.getFileSystemInstance().basename(filePath.c_str()) + "\"";
+            pdiutil::string content_disposition_value = CHARPTR_WRAP("attachment; filename=\"") + fs.basename(filePath.c_str()) + "\"";
             addHeader(CHARPTR_WRAP(HTTP_HEADER_KEY_CONTENT_DISPOSITION), content_disposition_value);
 
+            int64_t filesize = fs.seekHandle(fd, 0, FILE_SEEK_END);
+            fs.seekHandle(fd, 0, FILE_SEEK_SET);
+
             pdiutil::string response;
-            prepareResponseHeader(response, HTTP_RESP_OK, getMimeTypeString(filetype), __i_instance.getFileSystemInstance().getFileSize(filePath.c_str()));
+            prepareResponseHeader(response, HTTP_RESP_OK, getMimeTypeString(filetype), filesize < 0 ? 0 : (uint32_t)filesize);
 
             // Send the response headers
             sendPacket(m_client, (uint8_t *)response.c_str(), response.length());
 
-            // Send the response body
-            int iStatus = __i_instance.getFileSystemInstance().readFile(filePath.c_str(), 400, [&](char* data, uint32_t size)->bool{
-                sendPacket(m_client, (uint8_t *)data, size, 400, 3000);
-                // return true to continue reading
-                return true;
-            });
-
-            // Make sure data has been sent
-            // m_client->write((const uint8_t*)"", 0);
+            // Send the response body, one buffer at a time from the open file
+            char chunk[400];
+            int32_t readbytes;
+            while ((readbytes = fs.readHandle(fd, chunk, sizeof(chunk))) > 0) {
+                sendPacket(m_client, (uint8_t *)chunk, readbytes, 400, 3000);
+            }
+            fs.closeFile(fd);
 
             bStatus = true;
         }
@@ -1023,13 +1579,25 @@ bool HttpServerInterfaceImpl::handleStaticFileRequest(){
 }
 
 /**
- * @brief close current client.
+ * @brief close the client of a slot and give the slot back.
+ */
+void HttpServerInterfaceImpl::closeClient(HttpClientSlot& slot) {
+    if (slot.client) {
+        slot.client->close();
+        pdiutil::safe_delete(slot.client);
+        slot.client = nullptr;
+    }
+    slot.reset();
+    slot.streaming = false;
+    slot.lastactivity = 0;
+}
+
+/**
+ * @brief close every connected client.
  */
-void HttpServerInterfaceImpl::closeClient() {
-    if (m_client) {
-        m_client->close();
-        pdiutil::safe_delete(m_client);
-        m_client = nullptr;
+void HttpServerInterfaceImpl::closeClients() {
+    for (uint8_t i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++) {
+        closeClient(m_slots[i]);
     }
 }
 
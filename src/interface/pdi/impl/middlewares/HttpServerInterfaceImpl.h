@@ -12,6 +12,7 @@ created Date    : 1st June 2025
 #define _HTTP_SERVER_INTERFACE_IMPL_H_
 
 #include <interface/pdi/middlewares/iServerInterface.h>
+#include "HttpRouteTable.h"
 
 /**
  * HttpServerInterfaceImpl class
@@ -44,14 +45,19 @@ public:
   #endif
 
   virtual void on(const pdiutil::string &uri, CallBackVoidArgFn handler) override;
+  virtual void on(const pdiutil::string &uri, http_method_t method, CallBackVoidArgFn handler) override;
   virtual void onNotFound(CallBackVoidArgFn fn) override;   // called when handler is not assigned
 
   virtual pdiutil::string arg(const pdiutil::string &name) const override;                        // get request argument value by name
+  virtual const char *argView(const char *name) const override;                                   // view of an argument value, nullptr when absent
+  virtual pdiutil::string_view argView(pdiutil::string_view name) const override;                 // the same for a name that is a view, null data() when absent
   virtual bool hasArg(const pdiutil::string &name) const override;                                // check if argument exists
   virtual bool isPostRequest() const override;                                                    // check if request method is POST
 
   virtual void collectHeaders(const char *headerKeys[], const size_t headerKeysCount) override;   // set the request headers to collect
   virtual pdiutil::string header(const pdiutil::string &name) const override;                     // get request header value by name
+  virtual const char *headerView(const char *name) const override;                                // view of a header value, nullptr when absent
+  virtual pdiutil::string_view headerView(pdiutil::string_view name) const override;              // the same for a name that is a view, null data() when absent
   virtual bool hasHeader(const pdiutil::string &name) const override;                             // check if header exists
   virtual void addHeader(const pdiutil::string &name, const pdiutil::string &value) override;
 
@@ -60,11 +66,14 @@ public:
 
   virtual void send(int code, mimetype_t content_type = MIME_TYPE_MAX, const char *content = nullptr, bool send_in_chunks = false) override;
   virtual void sendChunk(const char *chunk = nullptr) override;
+
+  virtual int16_t openEventStream() override;
+  virtual bool sendEvent(int16_t stream, const char *event, const char *data) override;
+  virtual void closeEventStream(int16_t stream) override;
 protected:
 
   iTcpServerInterface* m_server;
-  iClientInterface* m_client;
-  uint64_t m_currentclient_lastactivity_timestamp;
+  iClientInterface* m_client;             // client being answered, only set while its handler runs
   volatile bool m_handlingclientfromcb;
   #ifdef ENABLE_TLS_SERVICE
   bool m_secure;
@@ -81,52 +90,157 @@ protected:
   pdiutil::string m_clientCaPath;
   #endif
 
+  /**
+   * a registered handler. routes sharing a pattern are chained through next,
+   * the route table holds the last one registered for each pattern.
+   */
   struct UriToHandlerMap{
-    pdiutil::string uri;
     CallBackVoidArgFn urihandler = nullptr;
+    http_method_t method;               // HTTP_METHOD_MAX for any method
+    int16_t next;
     static CallBackVoidArgFn notFoundHandler;
 
-    UriToHandlerMap(const pdiutil::string &uri, CallBackVoidArgFn handler)
-      : uri(uri), urihandler(handler) {}
+    UriToHandlerMap(CallBackVoidArgFn handler, http_method_t method, int16_t next)
+      : urihandler(handler), method(method), next(next) {}
   };
-  
+
   pdiutil::vector<UriToHandlerMap> m_uriHandlerMap;
+  HttpRouteTable m_routes;
   pdiutil::string m_responseHeaders;
 
   pdiutil::string m_storagePath; // Storage path for static files
 
+  /**
+   * a header or an argument of the request, both pointing into its buffer
+   */
+  struct RequestField{
+    const char *key;
+    const char *value;
+  };
+
+  /**
+   * one request, parsed in place. the request line, the headers kept and a
+   * url encoded body are read into the buffer and cut up there with NUL
+   * bytes, so method, uri, headers and arguments are views into it and
+   * reading a request allocates nothing. only multipart fields and uploaded
+   * files, which are read while the handler runs, are held on the heap.
+   */
   struct HttpRequestData{
 
-    pdiutil::string method; // HTTP method
-    pdiutil::string version; // HTTP version
-    pdiutil::string uri;    // Request URI
-    pdiutil::string body; // Request body
-    pdiutil::vector<http_header_t> headers;
-    pdiutil::vector<http_query_t> queries; // Query parameters
+    char buffer[HTTP_SERVER_REQUEST_BUFFER_SIZE];
+    uint16_t used;                                    // bytes of buffer taken
+    const char *method;                               // HTTP method
+    const char *uri;                                  // Request URI, without its query string
+    const char *version;                              // HTTP version
+    RequestField headers[HTTP_SERVER_MAX_HEADERS];    // collected headers
+    RequestField args[HTTP_SERVER_MAX_ARGS];          // query and url encoded form arguments
+    uint8_t headercount;
+    uint8_t argcount;
     pdiutil::vector<http_query_t> formdata; // Form data parameters
     pdiutil::vector<http_file_t> files; // Uploaded files
-    bool isPending; // Indicates if the request is still being processed
+
+    HttpRequestData() { clear(); }
 
     void clear() {
-      method.clear();
-      version.clear();
-      uri.clear();
-      body.clear();
-      for (auto &header : headers) {
-        header.setvalue((const char*)header.key, nullptr);
-      }
-      queries.clear();
+      used = 0;
+      method = uri = "";
+      version = "HTTP/1.1"; // answered with when the request line was refused
+      headercount = 0;
+      argcount = 0;
       formdata.clear();
       files.clear();
-      isPending = false;
     }
 
-  } m_clientRequest;
+  };
+
+  /**
+   * where a client slot is in reading its current request. the bytes of one
+   * request are taken in as they arrive, so a slow client never holds up the
+   * others; a slot only runs its handler once the request is complete.
+   */
+  enum http_parse_state : uint8_t {
+    HTTP_PARSE_REQUEST_LINE,
+    HTTP_PARSE_HEADERS,
+    HTTP_PARSE_BODY,
+    HTTP_PARSE_READY,
+  };
+
+  /**
+   * one connected client and the request it is sending. requests on a
+   * keep-alive connection are taken one after the other from the same slot,
+   * so a pipelined one waits in the socket until the previous one is answered.
+   */
+  struct HttpClientSlot{
+
+    iClientInterface* client;
+    HttpRequestData request;
+    http_parse_state state;
+    uint16_t linestart;             // where the line being read starts in the buffer
+    uint16_t valuestart;            // where its value starts, 0 until a header's colon is seen
+    bool skipline;                  // the rest of the line is not kept
+    bool keepbody;                  // the body is read into the buffer rather than dropped
+    uint16_t refusal;               // status answered instead of the handler, 0 when none
+    const char *boundary;           // multipart boundary, nullptr for other bodies
+    uint32_t contentLength;
+    uint32_t bodyread;
+    uint16_t carryat;               // where bytes read but not yet taken start in the buffer
+    uint16_t carry;                 // how many there are, read past a line or past the head
+    bool isForm;
+    bool isEncoded;
+    bool streaming;                 // answered with an event stream, nothing more is read
+    uint8_t streamserial;           // tells the streams this slot has carried apart
+    uint64_t lastactivity;
+
+    HttpClientSlot() : client(nullptr), streaming(false), streamserial(0), lastactivity(0) { reset(); }
+
+    // between two requests, holding nothing that a close would lose
+    bool isIdle() const { return HTTP_PARSE_REQUEST_LINE == state && request.used == linestart && !skipline && 0 == carry; }
+
+    void reset() {
+      request.clear();
+      state = HTTP_PARSE_REQUEST_LINE;
+      linestart = 0;
+      valuestart = 0;
+      skipline = false;
+      keepbody = false;
+      refusal = 0;
+      boundary = nullptr;
+      contentLength = 0;
+      bodyread = 0;
+      carryat = 0;
+      carry = 0;
+      isForm = false;
+      isEncoded = false;
+    }
+  };
 
-  void parseRequest();
+  HttpClientSlot m_slots[HTTP_SERVER_MAX_CLIENTS];
+  HttpClientSlot* m_clientSlot;           // slot of m_client, only set while its handler runs
+  HttpRequestData* m_clientRequest;       // request of m_client, only set while its handler runs
+  pdiutil::vector<http_header_t> m_collectHeaders;
+
+  bool acceptClient(iTcpServerInterface* server);
+  void evictIdleClient();
+  void pollClient(HttpClientSlot& slot);
+  bool readHead(HttpClientSlot& slot);
+  void takeHeadByte(HttpClientSlot& slot, char c);
+  void parseRequestLine(HttpClientSlot& slot);
+  void parseHeaderLine(HttpClientSlot& slot);
+  bool isCollectedHeader(const char *key) const;
+  void parseArgs(HttpRequestData& request, char *text);
+  void dispatchRequest(HttpClientSlot& slot);
+  int16_t findRoute(const char *uri, http_method_t method, bool &pathfound);
+  void addRouteArgs(HttpClientSlot& slot, const HttpRouteParam *params, uint8_t count);
+  void parseRequest(HttpClientSlot& slot);
+  void readPartUntil(HttpClientSlot& slot, pdiutil::string& out, char delimiter, bool keepdelimiter, const CallBackVoidArgFn& yield, uint32_t maxlen = 0);
+  void readPartLine(HttpClientSlot& slot, pdiutil::string& out, const CallBackVoidArgFn& yield, uint32_t maxlen = 0);
   void prepareResponseHeader(pdiutil::string& _header, int code, const char *content_type, uint32_t content_length, bool chunk_encoding = false);
   void sendResponse(int code, mimetype_t content_type, const char *content, bool chunk_encoding = false);
-  void closeClient();
+  bool writeChunk(iClientInterface* client, const char *data, uint16_t len);
+  HttpClientSlot* findStream(int16_t stream);
+  void pollStream(HttpClientSlot& slot);
+  void closeClient(HttpClientSlot& slot);
+  void closeClients();
 };
 
 #endif
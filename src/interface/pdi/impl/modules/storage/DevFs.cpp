@@ -42,7 +42,9 @@ const uint8_t s_dev_file_count = sizeof(s_dev_files) / sizeof(s_dev_files[0]);
 
 DevFs __i_devfs;
 
-DevFs::DevFs() : iFileSystemInterface(s_dev_null_storage) {}
+DevFs::DevFs() : iFileSystemInterface(s_dev_null_storage) {
+    memset(m_handles, 0, sizeof(m_handles));
+}
 
 const char* DevFs::normalizePath(const char* path) const {
     if (!path) return "";
@@ -69,7 +71,7 @@ pdiutil::string DevFs::basename(const char* path) {
     return pdiutil::string(last);
 }
 
-int DevFs::streamFill(bool random, uint64_t size, pdiutil::function<bool(char*, uint32_t)> readbackfn, uint64_t offset) {
+int DevFs::streamFill(bool random, uint64_t size, pdiutil::function_ref<bool(char*, uint32_t)> readbackfn, uint64_t offset) {
     // Unbounded nodes are capped so `cat` terminates on an MCU.
     uint32_t cap = DEVFS_STREAM_READ_MAX;
     if (offset >= cap) return 0;
@@ -99,7 +101,7 @@ int DevFs::streamFill(bool random, uint64_t size, pdiutil::function<bool(char*,
     return (int)done;
 }
 
-int DevFs::readFile(const char* path, uint64_t size, pdiutil::function<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
+int DevFs::readFile(const char* path, uint64_t size, pdiutil::function_ref<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
     if (!path || !readbackfn) return PDI_ERR_INVALID_ARG;
     switch (classify(path)) {
         case DEV_NULL:    return 0; // EOF, deliver nothing
@@ -118,6 +120,65 @@ int DevFs::writeFile(const char* path, const char* content, uint32_t size, bool
     return (int)size;
 }
 
+DevFs::devfs_handle_t* DevFs::handleOf(int16_t fd) {
+    if (fd < 0 || fd >= VFS_SYNTHETIC_MAX_OPEN_FILES || m_handles[fd].m_kind == DEV_INVALID) return nullptr;
+    return &m_handles[fd];
+}
+
+int16_t DevFs::openFile(const char* path, uint8_t flags) {
+    if (!(flags & (FILE_OPEN_READ | FILE_OPEN_WRITE | FILE_OPEN_APPEND))) return PDI_ERR_INVALID_ARG;
+    NodeKind k = classify(path);
+    if (k == DEV_ROOT) return STORAGE_ERROR_NOT_A_FILE;
+    if (k == DEV_INVALID) return PDI_ERR_NOT_FOUND;
+    for (int16_t fd = 0; fd < VFS_SYNTHETIC_MAX_OPEN_FILES; ++fd) {
+        if (m_handles[fd].m_kind != DEV_INVALID) continue;
+        m_handles[fd].m_kind = k;
+        m_handles[fd].m_pos = 0;
+        return fd;
+    }
+    return PDI_ERR_FULL;
+}
+
+int32_t DevFs::readHandle(int16_t fd, char* buffer, uint32_t size) {
+    devfs_handle_t* h = handleOf(fd);
+    if (!h || !buffer) return PDI_ERR_INVALID_ARG;
+    if (h->m_kind == DEV_NULL || h->m_pos >= DEVFS_STREAM_READ_MAX) return 0;
+
+    uint32_t n = DEVFS_STREAM_READ_MAX - h->m_pos;
+    if (n > size) n = size;
+    if (h->m_kind == DEV_ZERO) {
+        memset(buffer, 0, n);
+    } else {
+        for (uint32_t i = 0; i < n; i += 4) {
+            uint32_t r = __i_dvc_ctrl.random_now();
+            memcpy(buffer + i, &r, (n - i) < 4 ? (n - i) : 4);
+        }
+    }
+    h->m_pos += n;
+    return (int32_t)n;
+}
+
+int32_t DevFs::writeHandle(int16_t fd, const char* buffer, uint32_t size) {
+    // Every writable dev node discards its input.
+    return handleOf(fd) ? (int32_t)size : PDI_ERR_INVALID_ARG;
+}
+
+int64_t DevFs::seekHandle(int16_t fd, int64_t offset, file_seek_t whence) {
+    devfs_handle_t* h = handleOf(fd);
+    if (!h) return PDI_ERR_INVALID_ARG;
+    int64_t pos = (whence == FILE_SEEK_CUR) ? (int64_t)h->m_pos + offset : offset;
+    if (whence == FILE_SEEK_END || pos < 0) return PDI_ERR_RANGE;
+    h->m_pos = (uint32_t)pos;
+    return pos;
+}
+
+pdi_err_t DevFs::closeFile(int16_t fd) {
+    devfs_handle_t* h = handleOf(fd);
+    if (!h) return PDI_ERR_INVALID_ARG;
+    h->m_kind = DEV_INVALID;
+    return 0;
+}
+
 int64_t DevFs::getFileSize(const char* path) {
     NodeKind k = classify(path);
     return (k == DEV_ROOT || k == DEV_INVALID) ? STORAGE_ERROR_NOT_A_FILE : 0;
@@ -22,6 +22,7 @@ Created Date    : 23rd July 2026
 
 #include <interface/pdi/modules/storage/iFileSystemInterface.h>
 #include <interface/pdi/modules/storage/iStorageInterface.h>
+#include <config/VfsConfig.h>
 
 class DevFs : public iFileSystemInterface {
 public:
@@ -41,7 +42,7 @@ public:
   int writeFile(const char *path, const char *content, uint32_t size,
                 bool append = false) override;
   int readFile(const char *path, uint64_t size,
-               pdiutil::function<bool(char *, uint32_t)> readbackfn,
+               pdiutil::function_ref<bool(char *, uint32_t)> readbackfn,
                uint64_t offset = 0, const char *readUntilMatchStr = nullptr,
                bool *didmatchfound = nullptr) override;
 
@@ -64,10 +65,12 @@ public:
   pdi_err_t createDirectory(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t deleteDirectory(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t rename(const char *oldPath, const char *newPath) override { return PDI_ERR_NOT_SUPPORTED; }
-  pdi_err_t copyFile(const char *sourcePath, const char *destPath) override {
+  pdi_err_t copyFile(const char *sourcePath, const char *destPath, CallBackCopyProgressFn progress = nullptr) override {
+    return PDI_ERR_NOT_SUPPORTED;
+  }
+  pdi_err_t moveFile(const char *oldPath, const char *newPath, CallBackCopyProgressFn progress = nullptr) override {
     return PDI_ERR_NOT_SUPPORTED;
   }
-  pdi_err_t moveFile(const char *oldPath, const char *newPath) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t deleteFile(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
 
   int64_t getFileSize(const char *path) override;
@@ -110,6 +113,12 @@ public:
   int setFileOwner(const char *path, uint16_t uid, uint16_t gid) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t touch(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
 
+  int16_t openFile(const char *path, uint8_t flags) override;
+  int32_t readHandle(int16_t fd, char *buffer, uint32_t size) override;
+  int32_t writeHandle(int16_t fd, const char *buffer, uint32_t size) override;
+  int64_t seekHandle(int16_t fd, int64_t offset, file_seek_t whence = FILE_SEEK_SET) override;
+  pdi_err_t closeFile(int16_t fd) override;
+
 protected:
   uint32_t nowEpoch() override { return 0; }
 
@@ -123,10 +132,21 @@ private:
     DEV_URANDOM
   };
 
+  // an open file. the endless streams stop after DEVFS_STREAM_READ_MAX bytes
+  // per open, as they do per readFile, so a copy from one ends.
+  struct devfs_handle_t {
+    NodeKind m_kind;   // DEV_INVALID while the handle is free
+    uint32_t m_pos;
+  };
+
+  devfs_handle_t m_handles[VFS_SYNTHETIC_MAX_OPEN_FILES];
+
+  devfs_handle_t *handleOf(int16_t fd);
+
   NodeKind classify(const char *path) const;
   const char *normalizePath(const char *path) const;
   int streamFill(bool random, uint64_t size,
-                 pdiutil::function<bool(char *, uint32_t)> readbackfn,
+                 pdiutil::function_ref<bool(char *, uint32_t)> readbackfn,
                  uint64_t offset);
 };
 
@@ -17,7 +17,9 @@ Created Date    : 6th Apr 2025
 #include "FileSystemInterfaceImpl.h"
 #include "../../../../../../external/LittleFSWrapper.cpp"
 #include <helpers/StorageHelper.h>
+#include <utility/TaskScheduler.h>
 #include <interface/pdi/middlewares/iNtpInterface.h>
+#include <interface/pdi/middlewares/iDeviceControlInterface.h>
 #include <service_provider/session/SessionManager.h>
 
 
@@ -41,6 +43,11 @@ pdi_err_t FileSystemInterfaceImpl::init() {
         // Create home and temp directories if they do not exist
         // createDirectory(m_home.c_str());
         createDirectory(m_temp.c_str());
+
+        // usage queries read a cached count; give back what was freed since
+        if (m_scrub_task < 0) {
+            m_scrub_task = __task_scheduler.setInterval([&]() { this->scrubUsage(); }, VFS_USAGE_SCRUB_INTERVAL, __i_dvc_ctrl.millis_now(), DEFAULT_TASK_PRIORITY, RODT_ATTR("fsscrub"));
+        }
     }
 
     return status;
@@ -336,6 +343,10 @@ uint16_t FileSystemInterfaceImpl::currentUmask(){
     return (nullptr != s) ? s->m_umask : (uint16_t)FILE_UMASK_DEFAULT;
 }
 
+void FileSystemInterfaceImpl::copyYield(){
+    __i_dvc_ctrl.yield();
+}
+
 pdi_err_t FileSystemInterfaceImpl::getFileMeta(const char *path, file_info_t &out){
     if( !isFileExist(path) && !isDirExist(path) ){
         return PDI_ERR_NOT_FOUND;
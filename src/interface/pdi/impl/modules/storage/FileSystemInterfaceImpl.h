@@ -33,12 +33,13 @@ public:
      * @param storage Reference to an iStorageInterface implementation.
      */
     FileSystemInterfaceImpl(iStorageInterface& storage, bool defaultConfig) : 
+        LittleFSWrapper(storage, defaultConfig),
         m_pwd(FILE_SEPARATOR),
         m_lastpwd(FILE_SEPARATOR),
         m_root(FILE_SEPARATOR),
         m_home(FILE_SEPARATOR),
         m_temp("/temp/"),
-        LittleFSWrapper(storage, defaultConfig) {
+        m_scrub_task(-1) {
     }
 
     /**
@@ -186,11 +187,17 @@ protected:
      *        FILE_UMASK_DEFAULT when there is no active session.
      */
     uint16_t currentUmask() override;
+
+    /**
+     * @brief Yields to the device between the blocks of a long copy.
+     */
+    void copyYield() override;
     pdiutil::string m_pwd; ///< Present working directory.
     pdiutil::string m_lastpwd; ///< Last Present working directory.
     pdiutil::string m_root; ///< Root directory of the file system.
     pdiutil::string m_home; ///< Home directory of the session.
     pdiutil::string m_temp; ///< Temporary directory for file operations.
+    pdiutil::task_id_t m_scrub_task; ///< Interval recounting the blocks in use.
 };
 
 #endif // _FILE_SYSTEM_INTERFACE_IMPL_H
\ No newline at end of file
@@ -14,6 +14,9 @@ Created Date    : 21st July 2026
 
 #include "ProcFs.h"
 #include <interface/pdi.h>
+#ifdef ENABLE_SYSLOG_SERVICE
+#include <service_provider/network/SyslogServiceProvider.h>
+#endif
 
 namespace {
 
@@ -32,7 +35,10 @@ ProcFsNullStorage s_proc_null_storage;
 // function body. String literals here already live in RODATA/IROM.
 const char* const s_proc_files[] = {
     "uptime",
-    "version"
+    "version",
+#ifdef ENABLE_SYSLOG_SERVICE
+    "syslog",
+#endif
 };
 
 const uint8_t s_proc_file_count = sizeof(s_proc_files) / sizeof(s_proc_files[0]);
@@ -60,7 +66,7 @@ pdiutil::string ProcFs::basename(const char* path) {
 
 pdiutil::string ProcFs::generateContent(const char* path) {
     const char* norm = normalizePath(path);
-    char buf[128];
+    char buf[160];
     buf[0] = '\0';
 
     if (strcmp_ro(norm, RODT_ATTR("uptime")) == 0) {
@@ -81,10 +87,20 @@ pdiutil::string ProcFs::generateContent(const char* path) {
         __snprintf(buf, sizeof(buf), fmt.c_str(), rel.c_str(), cfg.c_str());
         return pdiutil::string(buf);
     }
+#ifdef ENABLE_SYSLOG_SERVICE
+    if (strcmp_ro(norm, RODT_ATTR("syslog")) == 0) {
+        // line counters since boot, then the bytes still waiting in the ring
+        const syslog_stats_t& s = __syslog_service.stats();
+        pdiutil::string fmt = CHARPTR_WRAP("queued %u\ndropped %u\nwritten %u\nfailed %u\nbytes %u\nrotations %u\npending %u\n");
+        __snprintf(buf, sizeof(buf), fmt.c_str(), s.m_queued, s.m_dropped, s.m_written,
+                   s.m_failed, s.m_bytes, s.m_rotations, __syslog_service.pending());
+        return pdiutil::string(buf);
+    }
+#endif
     return pdiutil::string();
 }
 
-int ProcFs::readFile(const char* path, uint64_t size, pdiutil::function<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
+int ProcFs::readFile(const char* path, uint64_t size, pdiutil::function_ref<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
     if (!path || !readbackfn) return PDI_ERR_INVALID_ARG;
     pdiutil::string content = generateContent(path);
     if (content.empty()) return PDI_ERR_NOT_FOUND;
@@ -104,6 +120,20 @@ int ProcFs::readFile(const char* path, uint64_t size, pdiutil::function<bool(cha
     return (int)done;
 }
 
+int16_t ProcFs::openFile(const char* path, uint8_t flags) {
+    if (flags & (FILE_OPEN_WRITE | FILE_OPEN_APPEND | FILE_OPEN_CREATE | FILE_OPEN_TRUNC)) return STORAGE_ERROR_READ_ONLY;
+    if (!(flags & FILE_OPEN_READ)) return PDI_ERR_INVALID_ARG;
+    if (isDirectory(path)) return STORAGE_ERROR_NOT_A_FILE;
+    if (!isFileExist(path)) return PDI_ERR_NOT_FOUND;
+    return m_files.open(path, flags, generateContent(path));
+}
+
+pdi_err_t ProcFs::closeFile(int16_t fd) {
+    if (!m_files.get(fd)) return PDI_ERR_INVALID_ARG;
+    m_files.release(fd);
+    return 0;
+}
+
 int64_t ProcFs::getFileSize(const char* path) {
     pdiutil::string content = generateContent(path);
     return content.empty() ? PDI_ERR_NOT_FOUND : (int64_t)content.length();
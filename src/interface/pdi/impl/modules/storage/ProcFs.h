@@ -5,8 +5,8 @@ This is free software. You can redistribute it and/or modify it but without any
 warranty.
 
 ProcFS is a synthetic read-only filesystem mounted at /proc. Node contents
-(/proc/uptime, /proc/meminfo, /proc/version, /proc/tasks, /proc/scheduler,
-/proc/net) are generated dynamically on read.
+(/proc/uptime, /proc/meminfo, /proc/version, /proc/syslog, /proc/tasks,
+/proc/scheduler, /proc/net) are generated dynamically on read.
 
 Author          : Suraj I.
 Created Date    : 21st July 2026
@@ -21,6 +21,7 @@ Created Date    : 21st July 2026
 
 #include <interface/pdi/modules/storage/iFileSystemInterface.h>
 #include <interface/pdi/modules/storage/iStorageInterface.h>
+#include "SnapshotFiles.h"
 
 class ProcFs : public iFileSystemInterface {
 public:
@@ -42,7 +43,7 @@ public:
     return PDI_ERR_NOT_SUPPORTED;
   }
   int readFile(const char *path, uint64_t size,
-               pdiutil::function<bool(char *, uint32_t)> readbackfn,
+               pdiutil::function_ref<bool(char *, uint32_t)> readbackfn,
                uint64_t offset = 0, const char *readUntilMatchStr = nullptr,
                bool *didmatchfound = nullptr) override;
 
@@ -65,10 +66,12 @@ public:
   pdi_err_t createDirectory(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t deleteDirectory(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t rename(const char *oldPath, const char *newPath) override { return PDI_ERR_NOT_SUPPORTED; }
-  pdi_err_t copyFile(const char *sourcePath, const char *destPath) override {
+  pdi_err_t copyFile(const char *sourcePath, const char *destPath, CallBackCopyProgressFn progress = nullptr) override {
+    return PDI_ERR_NOT_SUPPORTED;
+  }
+  pdi_err_t moveFile(const char *oldPath, const char *newPath, CallBackCopyProgressFn progress = nullptr) override {
     return PDI_ERR_NOT_SUPPORTED;
   }
-  pdi_err_t moveFile(const char *oldPath, const char *newPath) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t deleteFile(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
 
   int64_t getFileSize(const char *path) override;
@@ -111,10 +114,18 @@ public:
   int setFileOwner(const char *path, uint16_t uid, uint16_t gid) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t touch(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
 
+  int16_t openFile(const char *path, uint8_t flags) override;
+  int32_t readHandle(int16_t fd, char *buffer, uint32_t size) override { return m_files.read(fd, buffer, size); }
+  int32_t writeHandle(int16_t fd, const char *buffer, uint32_t size) override { return STORAGE_ERROR_READ_ONLY; }
+  int64_t seekHandle(int16_t fd, int64_t offset, file_seek_t whence = FILE_SEEK_SET) override { return m_files.seek(fd, offset, whence); }
+  pdi_err_t closeFile(int16_t fd) override;
+
 protected:
   uint32_t nowEpoch() override { return 0; }
 
 private:
+  SnapshotFiles m_files;
+
   pdiutil::string generateContent(const char *path);
   const char *normalizePath(const char *path) const;
 };
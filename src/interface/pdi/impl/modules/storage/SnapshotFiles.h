@@ -0,0 +1,106 @@
+/******************************* Snapshot Files *******************************
+This file is part of the PDI Stack.
+
+This is free software. You can redistribute it and/or modify it but without any
+warranty.
+
+Open files of a synthetic backend (procfs, sysfs). A node's content is
+generated once when it is opened and the handle reads that snapshot, so a
+reader taking it in small pieces sees one consistent text and the generator
+runs once per open rather than once per read. Writes collect in the snapshot
+and are handed back at close for the backend to apply in one go.
+
+Author          : Suraj I.
+Created Date    : 17th Oct 2026
+******************************************************************************/
+
+#ifndef _SNAPSHOT_FILES_H
+#define _SNAPSHOT_FILES_H
+
+#include <config/VfsConfig.h>
+#include <interface/pdi/modules/storage/iFileSystemInterface.h>
+
+class SnapshotFiles {
+public:
+  struct entry_t {
+    pdiutil::string m_path;   ///< backend-relative path it was opened with
+    pdiutil::string m_data;   ///< the snapshot, and what was written over it
+    uint32_t m_pos;
+    uint8_t m_flags;
+    bool m_used;
+    bool m_written;
+    entry_t() : m_pos(0), m_flags(0), m_used(false), m_written(false) {}
+  };
+
+  /**
+   * @brief Takes a free handle holding content as its snapshot.
+   * @return The handle, or PDI_ERR_FULL when every one is taken.
+   */
+  int16_t open(const char *path, uint8_t flags, const pdiutil::string &content) {
+    for (int16_t fd = 0; fd < VFS_SYNTHETIC_MAX_OPEN_FILES; ++fd) {
+      entry_t &e = m_entries[fd];
+      if (e.m_used) continue;
+      e.m_path = path;
+      e.m_data = content;
+      e.m_pos = 0;
+      e.m_flags = flags;
+      e.m_used = true;
+      e.m_written = false;
+      return fd;
+    }
+    return PDI_ERR_FULL;
+  }
+
+  entry_t *get(int16_t fd) {
+    if (fd < 0 || fd >= VFS_SYNTHETIC_MAX_OPEN_FILES || !m_entries[fd].m_used) return nullptr;
+    return &m_entries[fd];
+  }
+
+  int32_t read(int16_t fd, char *buffer, uint32_t size) {
+    entry_t *e = get(fd);
+    if (!e || !buffer) return PDI_ERR_INVALID_ARG;
+    if (e->m_pos >= e->m_data.length()) return 0;
+    uint32_t n = (uint32_t)e->m_data.length() - e->m_pos;
+    if (n > size) n = size;
+    memcpy(buffer, e->m_data.c_str() + e->m_pos, n);
+    e->m_pos += n;
+    return (int32_t)n;
+  }
+
+  int32_t write(int16_t fd, const char *buffer, uint32_t size) {
+    entry_t *e = get(fd);
+    if (!e || !buffer) return PDI_ERR_INVALID_ARG;
+    if (!(e->m_flags & (FILE_OPEN_WRITE | FILE_OPEN_APPEND))) return PDI_ERR_PERM;
+    if (size == 0) return 0;
+    if (e->m_flags & FILE_OPEN_APPEND) e->m_pos = (uint32_t)e->m_data.length();
+    if (e->m_pos + size > e->m_data.length()) e->m_data.resize(e->m_pos + size, '\0');
+    memcpy(&e->m_data[e->m_pos], buffer, size);
+    e->m_pos += size;
+    e->m_written = true;
+    return (int32_t)size;
+  }
+
+  int64_t seek(int16_t fd, int64_t offset, file_seek_t whence) {
+    entry_t *e = get(fd);
+    if (!e) return PDI_ERR_INVALID_ARG;
+    int64_t base = (whence == FILE_SEEK_CUR) ? e->m_pos
+                 : (whence == FILE_SEEK_END) ? (int64_t)e->m_data.length() : 0;
+    int64_t pos = base + offset;
+    if (pos < 0 || pos > (int64_t)e->m_data.length()) return PDI_ERR_RANGE;
+    e->m_pos = (uint32_t)pos;
+    return pos;
+  }
+
+  void release(int16_t fd) {
+    entry_t *e = get(fd);
+    if (!e) return;
+    e->m_path.clear();
+    e->m_data.clear();
+    e->m_used = false;
+  }
+
+private:
+  entry_t m_entries[VFS_SYNTHETIC_MAX_OPEN_FILES];
+};
+
+#endif
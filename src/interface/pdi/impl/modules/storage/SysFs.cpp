@@ -159,7 +159,7 @@ int SysFs::writeFile(const char* path, const char* content, uint32_t size, bool
 #endif
 }
 
-int SysFs::readFile(const char* path, uint64_t size, pdiutil::function<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
+int SysFs::readFile(const char* path, uint64_t size, pdiutil::function_ref<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
     if (!path || !readbackfn) return PDI_ERR_INVALID_ARG;
     pdiutil::string content = generateContent(path);
     if (content.empty()) return PDI_ERR_NOT_FOUND;
@@ -179,6 +179,30 @@ int SysFs::readFile(const char* path, uint64_t size, pdiutil::function<bool(char
     return (int)done;
 }
 
+int16_t SysFs::openFile(const char* path, uint8_t flags) {
+    if (!(flags & (FILE_OPEN_READ | FILE_OPEN_WRITE | FILE_OPEN_APPEND))) return PDI_ERR_INVALID_ARG;
+    int16_t pin;
+    NodeKind k = classify(path, pin);
+    if (k == SYS_INVALID) return PDI_ERR_NOT_FOUND;
+    if (k != SYS_VALUE && k != SYS_MODE) return STORAGE_ERROR_NOT_A_FILE;
+    // A truncating writer starts from nothing rather than the reading.
+    pdiutil::string content;
+    if (!(flags & FILE_OPEN_TRUNC)) content = generateContent(path);
+    return m_files.open(path, flags, content);
+}
+
+pdi_err_t SysFs::closeFile(int16_t fd) {
+    SnapshotFiles::entry_t* e = m_files.get(fd);
+    if (!e) return PDI_ERR_INVALID_ARG;
+    // What was written is applied once, as a single writeFile would.
+    int rc = 0;
+    if (e->m_written) {
+        rc = writeFile(e->m_path.c_str(), e->m_data.c_str(), (uint32_t)e->m_data.length());
+    }
+    m_files.release(fd);
+    return (rc < 0) ? rc : 0;
+}
+
 int64_t SysFs::getFileSize(const char* path) {
     pdiutil::string content = generateContent(path);
     return content.empty() ? PDI_ERR_NOT_FOUND : (int64_t)content.length();
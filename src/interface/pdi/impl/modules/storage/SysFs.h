@@ -22,6 +22,7 @@ Created Date    : 23rd July 2026
 
 #include <interface/pdi/modules/storage/iFileSystemInterface.h>
 #include <interface/pdi/modules/storage/iStorageInterface.h>
+#include "SnapshotFiles.h"
 
 class SysFs : public iFileSystemInterface {
 public:
@@ -41,7 +42,7 @@ public:
   int writeFile(const char *path, const char *content, uint32_t size,
                 bool append = false) override;
   int readFile(const char *path, uint64_t size,
-               pdiutil::function<bool(char *, uint32_t)> readbackfn,
+               pdiutil::function_ref<bool(char *, uint32_t)> readbackfn,
                uint64_t offset = 0, const char *readUntilMatchStr = nullptr,
                bool *didmatchfound = nullptr) override;
 
@@ -64,10 +65,12 @@ public:
   pdi_err_t createDirectory(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t deleteDirectory(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t rename(const char *oldPath, const char *newPath) override { return PDI_ERR_NOT_SUPPORTED; }
-  pdi_err_t copyFile(const char *sourcePath, const char *destPath) override {
+  pdi_err_t copyFile(const char *sourcePath, const char *destPath, CallBackCopyProgressFn progress = nullptr) override {
+    return PDI_ERR_NOT_SUPPORTED;
+  }
+  pdi_err_t moveFile(const char *oldPath, const char *newPath, CallBackCopyProgressFn progress = nullptr) override {
     return PDI_ERR_NOT_SUPPORTED;
   }
-  pdi_err_t moveFile(const char *oldPath, const char *newPath) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t deleteFile(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
 
   int64_t getFileSize(const char *path) override;
@@ -110,6 +113,12 @@ public:
   int setFileOwner(const char *path, uint16_t uid, uint16_t gid) override { return PDI_ERR_NOT_SUPPORTED; }
   pdi_err_t touch(const char *path) override { return PDI_ERR_NOT_SUPPORTED; }
 
+  int16_t openFile(const char *path, uint8_t flags) override;
+  int32_t readHandle(int16_t fd, char *buffer, uint32_t size) override { return m_files.read(fd, buffer, size); }
+  int32_t writeHandle(int16_t fd, const char *buffer, uint32_t size) override { return m_files.write(fd, buffer, size); }
+  int64_t seekHandle(int16_t fd, int64_t offset, file_seek_t whence = FILE_SEEK_SET) override { return m_files.seek(fd, offset, whence); }
+  pdi_err_t closeFile(int16_t fd) override;
+
 protected:
   uint32_t nowEpoch() override { return 0; }
 
@@ -124,6 +133,8 @@ private:
     SYS_MODE
   };
 
+  SnapshotFiles m_files;
+
   NodeKind classify(const char *path, int16_t &pin_out) const;
   bool isValidPin(uint8_t pin) const;
   pdiutil::string generateContent(const char *path);
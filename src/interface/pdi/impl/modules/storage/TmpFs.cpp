@@ -32,7 +32,27 @@ TmpFsNullStorage s_tmp_null_storage;
 
 TmpFs __i_tmpfs;
 
-TmpFs::TmpFs() : iFileSystemInterface(s_tmp_null_storage) {}
+TmpFs::TmpFs()
+    : iFileSystemInterface(s_tmp_null_storage), m_free(TMPFS_NO_NODE), m_count(0),
+      m_bytes(0), m_spare(nullptr), m_sparecount(0) {
+    for (uint16_t i = 0; i < TMPFS_HASH_BUCKETS; ++i) m_buckets[i] = TMPFS_NO_NODE;
+    tmpfs_node_t root;
+    root.m_type = FILE_TYPE_DIR;
+    root.m_used = true;
+    root.m_perms = 0777;
+    m_nodes.push_back(root);
+}
+
+TmpFs::~TmpFs() {
+    for (uint32_t i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes[i].m_used) truncate(m_nodes[i]);
+    }
+    while (m_spare) {
+        tmpfs_chunk_t* next = m_spare->m_next;
+        pdiutil::safe_delete(m_spare);
+        m_spare = next;
+    }
+}
 
 // ---- path helpers ---------------------------------------------------------
 
@@ -47,35 +67,268 @@ pdiutil::string TmpFs::normalize(const char* path) const {
     return out;
 }
 
-int TmpFs::findNode(const pdiutil::string& norm) const {
-    for (uint32_t i = 0; i < m_nodes.size(); ++i) {
-        if (m_nodes[i].m_path == norm) return (int)i;
+uint16_t TmpFs::bucketOf(uint16_t dir, const char* name, uint32_t len) const {
+    uint32_t h = 2166136261u ^ dir;
+    for (uint32_t i = 0; i < len; ++i) {
+        h ^= (uint8_t)name[i];
+        h *= 16777619u;
     }
-    return PDI_ERR_NOT_FOUND;
+    return (uint16_t)(h % TMPFS_HASH_BUCKETS);
 }
 
-pdiutil::string TmpFs::parentOf(const pdiutil::string& norm) const {
-    int cut = -1;
-    for (int i = (int)norm.length() - 1; i >= 0; --i) {
-        if (norm[i] == '/') { cut = i; break; }
+uint16_t TmpFs::lookup(uint16_t dir, const char* name, uint32_t len) const {
+    for (uint16_t id = m_buckets[bucketOf(dir, name, len)]; id != TMPFS_NO_NODE; id = m_nodes[id].m_hashnext) {
+        const tmpfs_node_t& n = m_nodes[id];
+        if (n.m_parent == dir && n.m_name.length() == len && 0 == memcmp(n.m_name.c_str(), name, len)) {
+            return id;
+        }
+    }
+    return TMPFS_NO_NODE;
+}
+
+// Walks a normalized path from the root, one lookup per component. parent is
+// set to the directory the last component belongs in, or TMPFS_NO_NODE when
+// an earlier component is missing or is not a directory.
+uint16_t TmpFs::walk(const pdiutil::string& norm, uint16_t* parent, pdiutil::string* leaf) const {
+    uint16_t dir = 0;
+    uint16_t id = 0;
+    const char* p = norm.c_str();
+    while (*p) {
+        const char* end = p;
+        while (*end && *end != '/') end++;
+        uint32_t len = (uint32_t)(end - p);
+        if (len > 0) {
+            dir = id;
+            if (dir == TMPFS_NO_NODE || m_nodes[dir].m_type != FILE_TYPE_DIR) {
+                dir = TMPFS_NO_NODE;
+                id = TMPFS_NO_NODE;
+            } else {
+                id = lookup(dir, p, len);
+            }
+            if (leaf) leaf->assign(p, len);
+        }
+        p = *end ? end + 1 : end;
     }
-    if (cut < 0) return pdiutil::string();
-    return norm.substr(0, cut);
+    if (parent) *parent = dir;
+    return id;
 }
 
-bool TmpFs::parentExists(const pdiutil::string& norm) const {
-    pdiutil::string parent = parentOf(norm);
-    if (parent.empty()) return true; // root always exists
-    int idx = findNode(parent);
-    return (idx >= 0 && m_nodes[idx].m_type == FILE_TYPE_DIR);
+uint16_t TmpFs::findNode(const char* path) const {
+    return walk(normalize(path));
 }
 
-uint32_t TmpFs::usedBytes() const {
-    uint32_t total = 0;
-    for (uint32_t i = 0; i < m_nodes.size(); ++i) {
-        total += (uint32_t)m_nodes[i].m_data.length();
+bool TmpFs::isWithin(uint16_t id, uint16_t dir) const {
+    for (uint16_t at = dir; at != TMPFS_NO_NODE; at = m_nodes[at].m_parent) {
+        if (at == id) return true;
+    }
+    return false;
+}
+
+void TmpFs::link(uint16_t id, uint16_t dir, const pdiutil::string& name) {
+    tmpfs_node_t& n = m_nodes[id];
+    tmpfs_node_t& d = m_nodes[dir];
+    n.m_name = name;
+    n.m_parent = dir;
+    n.m_next = TMPFS_NO_NODE;
+    n.m_prev = d.m_lastchild;
+    if (d.m_lastchild != TMPFS_NO_NODE) m_nodes[d.m_lastchild].m_next = id;
+    else d.m_child = id;
+    d.m_lastchild = id;
+
+    uint16_t b = bucketOf(dir, name.c_str(), (uint32_t)name.length());
+    n.m_hashnext = m_buckets[b];
+    m_buckets[b] = id;
+}
+
+void TmpFs::unlink(uint16_t id) {
+    tmpfs_node_t& n = m_nodes[id];
+    tmpfs_node_t& d = m_nodes[n.m_parent];
+    if (n.m_prev != TMPFS_NO_NODE) m_nodes[n.m_prev].m_next = n.m_next;
+    else d.m_child = n.m_next;
+    if (n.m_next != TMPFS_NO_NODE) m_nodes[n.m_next].m_prev = n.m_prev;
+    else d.m_lastchild = n.m_prev;
+
+    uint16_t* at = &m_buckets[bucketOf(n.m_parent, n.m_name.c_str(), (uint32_t)n.m_name.length())];
+    while (*at != TMPFS_NO_NODE && *at != id) at = &m_nodes[*at].m_hashnext;
+    if (*at == id) *at = n.m_hashnext;
+    n.m_parent = TMPFS_NO_NODE;
+}
+
+// Makes an empty node at norm. Returns its id, or a negative error code.
+int32_t TmpFs::makeNode(const pdiutil::string& norm, file_type_t type, uint16_t defperms) {
+    if (norm.empty() || norm.length() > TMPFS_MAX_PATH) return STORAGE_ERROR_BAD_PATH;
+    uint16_t dir = TMPFS_NO_NODE;
+    pdiutil::string leaf;
+    if (walk(norm, &dir, &leaf) != TMPFS_NO_NODE) return PDI_ERR_EXISTS;
+    if (dir == TMPFS_NO_NODE) return STORAGE_ERROR_NO_PARENT;
+    if (m_count >= TMPFS_MAX_NODES) return STORAGE_ERROR_NODE_LIMIT;
+
+    uint16_t id = m_free;
+    if (id != TMPFS_NO_NODE) {
+        m_free = m_nodes[id].m_next;
+    } else {
+        id = (uint16_t)m_nodes.size();
+        m_nodes.push_back(tmpfs_node_t());
+        if (m_nodes.size() == id) return PDI_ERR_NO_MEM;
+    }
+
+    tmpfs_node_t& n = m_nodes[id];
+    n.m_type = type;
+    n.m_used = true;
+    n.m_size = 0;
+    n.m_child = n.m_lastchild = TMPFS_NO_NODE;
+    stampNew(n, defperms);
+    link(id, dir, leaf);
+    m_count++;
+    return id;
+}
+
+// Frees a node and, for a directory, everything under it.
+void TmpFs::freeNode(uint16_t id) {
+    while (m_nodes[id].m_child != TMPFS_NO_NODE) {
+        freeNode(m_nodes[id].m_child);
+    }
+    unlink(id);
+    tmpfs_node_t& n = m_nodes[id];
+    truncate(n);
+    n.m_name.clear();
+    n.m_used = false;
+    n.m_gen++;
+    n.m_next = m_free;
+    m_free = id;
+    m_count--;
+}
+
+// ---- chunk store ----------------------------------------------------------
+
+tmpfs_chunk_t* TmpFs::takeChunk() {
+    tmpfs_chunk_t* chunk = m_spare;
+    if (chunk) {
+        m_spare = chunk->m_next;
+        m_sparecount--;
+    } else {
+        chunk = pdiutil::safe_new<tmpfs_chunk_t>();
+        if (!chunk) return nullptr;
+    }
+    chunk->m_next = nullptr;
+    memset(chunk->m_data, 0, TMPFS_CHUNK_SIZE);
+    return chunk;
+}
+
+void TmpFs::giveChunk(tmpfs_chunk_t* chunk) {
+    if (m_sparecount < TMPFS_SPARE_CHUNKS) {
+        chunk->m_next = m_spare;
+        m_spare = chunk;
+        m_sparecount++;
+    } else {
+        pdiutil::safe_delete(chunk);
+    }
+}
+
+// Empties a file, handing its chunks back.
+void TmpFs::truncate(tmpfs_node_t& node) {
+    while (node.m_head) {
+        tmpfs_chunk_t* next = node.m_head->m_next;
+        giveChunk(node.m_head);
+        node.m_head = next;
+    }
+    node.m_tail = nullptr;
+    m_bytes -= node.m_size;
+    node.m_size = 0;
+    node.m_epoch++;
+}
+
+// The index-th chunk of a file that has it, walking on from the cursor when
+// it is still good and not past the chunk wanted, from the first otherwise.
+tmpfs_chunk_t* TmpFs::chunkAt(tmpfs_node_t& node, uint32_t index, tmpfs_cursor_t& cursor) {
+    uint32_t last = (node.m_size + TMPFS_CHUNK_SIZE - 1) / TMPFS_CHUNK_SIZE - 1;
+    tmpfs_chunk_t* chunk;
+    uint32_t at;
+    if (index == last) {
+        chunk = node.m_tail;
+        at = last;
+    } else if (cursor.m_chunk && cursor.m_epoch == node.m_epoch && cursor.m_index <= index) {
+        chunk = cursor.m_chunk;
+        at = cursor.m_index;
+    } else {
+        chunk = node.m_head;
+        at = 0;
+    }
+    while (at < index) {
+        chunk = chunk->m_next;
+        at++;
+    }
+    cursor.m_chunk = chunk;
+    cursor.m_index = index;
+    cursor.m_epoch = node.m_epoch;
+    return chunk;
+}
+
+int32_t TmpFs::readAt(tmpfs_node_t& node, uint32_t pos, char* buffer, uint32_t size, tmpfs_cursor_t& cursor) {
+    if (pos >= node.m_size) return 0;
+    if (size > node.m_size - pos) size = node.m_size - pos;
+    uint32_t done = 0;
+    while (done < size) {
+        uint32_t at = pos + done;
+        tmpfs_chunk_t* chunk = chunkAt(node, at / TMPFS_CHUNK_SIZE, cursor);
+        uint32_t off = at % TMPFS_CHUNK_SIZE;
+        uint32_t n = TMPFS_CHUNK_SIZE - off;
+        if (n > size - done) n = size - done;
+        memcpy(buffer + done, chunk->m_data + off, n);
+        done += n;
+    }
+    return (int32_t)done;
+}
+
+// Writes at pos, growing the file with zeros up to it when it lies past the
+// end. Either all of it lands or, when the budget or the heap is short,
+// nothing does.
+int32_t TmpFs::writeAt(tmpfs_node_t& node, uint32_t pos, const char* buffer, uint32_t size, tmpfs_cursor_t& cursor) {
+    uint32_t end = pos + size;
+    if (end > node.m_size) {
+        if (m_bytes - node.m_size + end > TMPFS_MAX_BYTES) return PDI_ERR_NO_SPACE;
+
+        uint32_t have = (node.m_size + TMPFS_CHUNK_SIZE - 1) / TMPFS_CHUNK_SIZE;
+        uint32_t need = (end + TMPFS_CHUNK_SIZE - 1) / TMPFS_CHUNK_SIZE;
+        tmpfs_chunk_t* head = nullptr;
+        tmpfs_chunk_t* tail = nullptr;
+        for (uint32_t i = have; i < need; ++i) {
+            tmpfs_chunk_t* chunk = takeChunk();
+            if (!chunk) {
+                while (head) {
+                    tmpfs_chunk_t* next = head->m_next;
+                    giveChunk(head);
+                    head = next;
+                }
+                return PDI_ERR_NO_MEM;
+            }
+            if (tail) tail->m_next = chunk;
+            else head = chunk;
+            tail = chunk;
+        }
+
+        // chunks come zeroed and files only ever shrink to nothing, so a gap
+        // left before pos already reads as zeros
+        if (head) {
+            if (node.m_tail) node.m_tail->m_next = head;
+            else node.m_head = head;
+            node.m_tail = tail;
+        }
+        m_bytes += end - node.m_size;
+        node.m_size = end;
+    }
+
+    uint32_t done = 0;
+    while (done < size) {
+        uint32_t at = pos + done;
+        tmpfs_chunk_t* chunk = chunkAt(node, at / TMPFS_CHUNK_SIZE, cursor);
+        uint32_t off = at % TMPFS_CHUNK_SIZE;
+        uint32_t n = TMPFS_CHUNK_SIZE - off;
+        if (n > size - done) n = size - done;
+        memcpy(chunk->m_data + off, buffer + done, n);
+        done += n;
     }
-    return total;
+    return (int32_t)size;
 }
 
 // ---- stamping hooks -------------------------------------------------------
@@ -114,29 +367,33 @@ void TmpFs::stampNew(tmpfs_node_t& n, uint16_t defperms) {
 int TmpFs::putContent(const pdiutil::string& norm, const char* content, uint32_t size, bool append) {
     if (norm.empty() || norm.length() > TMPFS_MAX_PATH) return STORAGE_ERROR_BAD_PATH;
 
-    int idx = findNode(norm);
-    if (idx >= 0 && m_nodes[idx].m_type == FILE_TYPE_DIR) return STORAGE_ERROR_NOT_A_FILE;
-
-    if (idx < 0) {
-        if (!parentExists(norm)) return STORAGE_ERROR_NO_PARENT;
-        if (m_nodes.size() >= TMPFS_MAX_NODES) return STORAGE_ERROR_NODE_LIMIT;
-        if (usedBytes() + size > TMPFS_MAX_BYTES) return PDI_ERR_NO_SPACE;
-        tmpfs_node_t n;
-        n.m_path = norm;
-        n.m_type = FILE_TYPE_REG;
-        stampNew(n, FILE_PERM_DEFAULT_FILE);
-        if (content && size > 0) n.m_data.append(content, size);
-        m_nodes.push_back(n);
+    uint16_t id = walk(norm);
+    if (id != TMPFS_NO_NODE && m_nodes[id].m_type == FILE_TYPE_DIR) return STORAGE_ERROR_NOT_A_FILE;
+
+    tmpfs_cursor_t cursor;
+    if (id == TMPFS_NO_NODE) {
+        if (m_bytes + size > TMPFS_MAX_BYTES) return PDI_ERR_NO_SPACE;
+        int32_t made = makeNode(norm, FILE_TYPE_REG, FILE_PERM_DEFAULT_FILE);
+        if (made < 0) return made;
+        if (content && size > 0) {
+            int32_t rc = writeAt(m_nodes[made], 0, content, size, cursor);
+            if (rc < 0) {
+                freeNode((uint16_t)made);
+                return rc;
+            }
+        }
         return (int)size;
     }
 
-    tmpfs_node_t& node = m_nodes[idx];
-    uint32_t oldlen = (uint32_t)node.m_data.length();
-    uint32_t newused = append ? (usedBytes() + size) : (usedBytes() - oldlen + size);
+    tmpfs_node_t& node = m_nodes[id];
+    uint32_t newused = append ? (m_bytes + size) : (m_bytes - node.m_size + size);
     if (newused > TMPFS_MAX_BYTES) return PDI_ERR_NO_SPACE;
 
-    if (!append) node.m_data.clear();
-    if (content && size > 0) node.m_data.append(content, size);
+    if (!append) truncate(node);
+    if (content && size > 0) {
+        int32_t rc = writeAt(node, node.m_size, content, size, cursor);
+        if (rc < 0) return rc;
+    }
     node.m_mtime = nowEpoch();
     return (int)size;
 }
@@ -146,7 +403,7 @@ int TmpFs::putContent(const pdiutil::string& norm, const char* content, uint32_t
 int TmpFs::createFile(const char* path, const char* content, int64_t size) {
     pdiutil::string norm = normalize(path);
     if (norm.empty()) return STORAGE_ERROR_BAD_PATH;
-    if (findNode(norm) >= 0) return PDI_ERR_EXISTS;
+    if (walk(norm) != TMPFS_NO_NODE) return PDI_ERR_EXISTS;
     uint32_t len = (size < 0) ? (content ? (uint32_t)strlen(content) : 0) : (uint32_t)size;
     return putContent(norm, content, len, false);
 }
@@ -157,85 +414,175 @@ int TmpFs::writeFile(const char* path, const char* content, uint32_t size, bool
 }
 
 int TmpFs::editFile(const char* path, uint64_t offset, const char* content, uint32_t size) {
-    pdiutil::string norm = normalize(path);
-    int idx = findNode(norm);
+    uint16_t id = findNode(path);
     if (!content) return PDI_ERR_NULL_PTR;
-    if (idx < 0 || m_nodes[idx].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
-
-    tmpfs_node_t& node = m_nodes[idx];
-    uint32_t oldlen = (uint32_t)node.m_data.length();
-    uint32_t end = (uint32_t)offset + size;
-    if (end > oldlen) {
-        if (usedBytes() - oldlen + end > TMPFS_MAX_BYTES) return PDI_ERR_NO_SPACE;
-        node.m_data.resize(end, '\0');
-    }
-    for (uint32_t i = 0; i < size; ++i) {
-        node.m_data[(uint32_t)offset + i] = content[i];
-    }
+    if (id == TMPFS_NO_NODE || m_nodes[id].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
+
+    tmpfs_node_t& node = m_nodes[id];
+    tmpfs_cursor_t cursor;
+    int32_t rc = writeAt(node, (uint32_t)offset, content, size, cursor);
+    if (rc < 0) return rc;
     node.m_mtime = nowEpoch();
     return (int)size;
 }
 
-int TmpFs::readFile(const char* path, uint64_t size, pdiutil::function<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
+int TmpFs::readFile(const char* path, uint64_t size, pdiutil::function_ref<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
     if (!path || !readbackfn) return PDI_ERR_INVALID_ARG;
-    pdiutil::string norm = normalize(path);
-    int idx = findNode(norm);
-    if (idx < 0 || m_nodes[idx].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
+    uint16_t id = findNode(path);
+    if (id == TMPFS_NO_NODE || m_nodes[id].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
 
-    pdiutil::string& data = m_nodes[idx].m_data;
-    if (offset >= data.length()) return 0;
+    tmpfs_node_t& node = m_nodes[id];
+    if (offset >= node.m_size) return 0;
 
     // `size` is the per-iteration chunk limit — loop until content is drained.
-    uint32_t total = (uint32_t)data.length() - (uint32_t)offset;
-    uint32_t chunk = (size > 0 && size < total) ? (uint32_t)size : total;
+    // A piece inside one chunk is handed over in place; one that straddles two
+    // is gathered into scratch first, so every piece but the last is full.
+    uint32_t total = node.m_size - (uint32_t)offset;
+    uint32_t piece = (size > 0 && size < total) ? (uint32_t)size : total;
+    char* scratch = nullptr;
+    tmpfs_cursor_t cursor;
     uint32_t done = 0;
     while (done < total) {
+        uint32_t at = (uint32_t)offset + done;
         uint32_t n = total - done;
-        if (n > chunk) n = chunk;
-        if (!readbackfn((char*)data.c_str() + offset + done, n)) break;
+        if (n > piece) n = piece;
+
+        char* data;
+        uint32_t off = at % TMPFS_CHUNK_SIZE;
+        if (off + n <= TMPFS_CHUNK_SIZE) {
+            data = chunkAt(node, at / TMPFS_CHUNK_SIZE, cursor)->m_data + off;
+        } else {
+            if (!scratch) scratch = pdiutil::safe_new_array<char>(piece);
+            if (!scratch) {
+                if (done == 0) return PDI_ERR_NO_MEM;
+                break;
+            }
+            readAt(node, at, scratch, n, cursor);
+            data = scratch;
+        }
+
+        if (!readbackfn(data, n)) break;
         done += n;
     }
+    pdiutil::safe_delete_array(scratch);
     return (int)done;
 }
 
-pdi_err_t TmpFs::createDirectory(const char* path) {
+// ---- open files -----------------------------------------------------------
+
+TmpFs::tmpfs_handle_t* TmpFs::handleOf(int16_t fd) {
+    if (fd < 0 || fd >= VFS_MAX_OPEN_FILES || !m_handles[fd].m_used) return nullptr;
+    return &m_handles[fd];
+}
+
+tmpfs_node_t* TmpFs::nodeOf(const tmpfs_handle_t& h) {
+    if (h.m_node >= m_nodes.size()) return nullptr;
+    tmpfs_node_t& node = m_nodes[h.m_node];
+    return (node.m_used && node.m_gen == h.m_gen) ? &node : nullptr;
+}
+
+int16_t TmpFs::openFile(const char* path, uint8_t flags) {
+    if (!(flags & (FILE_OPEN_READ | FILE_OPEN_WRITE | FILE_OPEN_APPEND))) return PDI_ERR_INVALID_ARG;
     pdiutil::string norm = normalize(path);
-    if (norm.empty() || norm.length() > TMPFS_MAX_PATH) return STORAGE_ERROR_BAD_PATH;
-    if (findNode(norm) >= 0) return PDI_ERR_EXISTS;
-    if (!parentExists(norm)) return STORAGE_ERROR_NO_PARENT;
-    if (m_nodes.size() >= TMPFS_MAX_NODES) return STORAGE_ERROR_NODE_LIMIT;
-
-    tmpfs_node_t n;
-    n.m_path = norm;
-    n.m_type = FILE_TYPE_DIR;
-    stampNew(n, FILE_PERM_DEFAULT_DIR);
-    m_nodes.push_back(n);
+    if (norm.empty()) return STORAGE_ERROR_BAD_PATH;
+
+    uint16_t id = walk(norm);
+    if (id != TMPFS_NO_NODE && m_nodes[id].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
+    if (id != TMPFS_NO_NODE && (flags & FILE_OPEN_CREATE) && (flags & FILE_OPEN_EXCL)) return PDI_ERR_EXISTS;
+    if (id == TMPFS_NO_NODE && !(flags & FILE_OPEN_CREATE)) return PDI_ERR_NOT_FOUND;
+
+    int16_t fd = 0;
+    while (fd < VFS_MAX_OPEN_FILES && m_handles[fd].m_used) fd++;
+    if (fd >= VFS_MAX_OPEN_FILES) return PDI_ERR_FULL;
+
+    // A missing file is made empty, an existing one emptied when truncating.
+    if (id == TMPFS_NO_NODE || (flags & FILE_OPEN_TRUNC)) {
+        int rc = putContent(norm, nullptr, 0, false);
+        if (rc < 0) return rc;
+        id = walk(norm);
+    }
+
+    tmpfs_handle_t& h = m_handles[fd];
+    h.m_node = id;
+    h.m_gen = m_nodes[id].m_gen;
+    h.m_pos = 0;
+    h.m_flags = flags;
+    h.m_used = true;
+    h.m_cursor = tmpfs_cursor_t();
+    return fd;
+}
+
+int32_t TmpFs::readHandle(int16_t fd, char* buffer, uint32_t size) {
+    tmpfs_handle_t* h = handleOf(fd);
+    if (!h || !buffer) return PDI_ERR_INVALID_ARG;
+    tmpfs_node_t* node = nodeOf(*h);
+    if (!node) return PDI_ERR_NOT_FOUND;
+
+    int32_t n = readAt(*node, h->m_pos, buffer, size, h->m_cursor);
+    h->m_pos += n;
+    return n;
+}
+
+int32_t TmpFs::writeHandle(int16_t fd, const char* buffer, uint32_t size) {
+    tmpfs_handle_t* h = handleOf(fd);
+    if (!h || !buffer) return PDI_ERR_INVALID_ARG;
+    if (size == 0) return 0;
+    tmpfs_node_t* node = nodeOf(*h);
+    if (!node) return PDI_ERR_NOT_FOUND;
+
+    if (h->m_flags & FILE_OPEN_APPEND) h->m_pos = node->m_size;
+    int32_t rc = writeAt(*node, h->m_pos, buffer, size, h->m_cursor);
+    if (rc < 0) return rc;
+    h->m_pos += size;
+    node->m_mtime = nowEpoch();
+    return (int32_t)size;
+}
+
+int64_t TmpFs::seekHandle(int16_t fd, int64_t offset, file_seek_t whence) {
+    tmpfs_handle_t* h = handleOf(fd);
+    if (!h) return PDI_ERR_INVALID_ARG;
+    int64_t base = 0;
+    if (whence == FILE_SEEK_CUR) {
+        base = h->m_pos;
+    } else if (whence == FILE_SEEK_END) {
+        tmpfs_node_t* node = nodeOf(*h);
+        if (!node) return PDI_ERR_NOT_FOUND;
+        base = (int64_t)node->m_size;
+    }
+    int64_t pos = base + offset;
+    if (pos < 0 || pos > TMPFS_MAX_BYTES) return PDI_ERR_RANGE;
+    h->m_pos = (uint32_t)pos;
+    return pos;
+}
+
+pdi_err_t TmpFs::closeFile(int16_t fd) {
+    tmpfs_handle_t* h = handleOf(fd);
+    if (!h) return PDI_ERR_INVALID_ARG;
+    h->m_node = TMPFS_NO_NODE;
+    h->m_used = false;
     return 0;
 }
 
+pdi_err_t TmpFs::createDirectory(const char* path) {
+    int32_t made = makeNode(normalize(path), FILE_TYPE_DIR, FILE_PERM_DEFAULT_DIR);
+    return (made < 0) ? made : 0;
+}
+
 pdi_err_t TmpFs::deleteFile(const char* path) {
-    pdiutil::string norm = normalize(path);
-    int idx = findNode(norm);
-    if (idx < 0 || m_nodes[idx].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
-    m_nodes.erase(m_nodes.begin() + idx);
+    uint16_t id = findNode(path);
+    if (id == TMPFS_NO_NODE || m_nodes[id].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
+    freeNode(id);
     return 0;
 }
 
 pdi_err_t TmpFs::deleteDirectory(const char* path) {
     pdiutil::string norm = normalize(path);
     if (norm.empty()) return STORAGE_ERROR_BAD_PATH;
-    int idx = findNode(norm);
-    if (idx < 0 || m_nodes[idx].m_type != FILE_TYPE_DIR) return STORAGE_ERROR_NOT_A_DIRECTORY;
-
-    // Remove the directory and every descendant (prefix "norm/").
-    pdiutil::string prefix = norm;
-    prefix += "/";
-    for (int i = (int)m_nodes.size() - 1; i >= 0; --i) {
-        const pdiutil::string& p = m_nodes[i].m_path;
-        if (p == norm || (p.length() > prefix.length() && p.compare(0, prefix.length(), prefix) == 0)) {
-            m_nodes.erase(m_nodes.begin() + i);
-        }
-    }
+    uint16_t id = walk(norm);
+    if (id == TMPFS_NO_NODE || m_nodes[id].m_type != FILE_TYPE_DIR) return STORAGE_ERROR_NOT_A_DIRECTORY;
+
+    // Remove the directory and every descendant.
+    freeNode(id);
     return 0;
 }
 
@@ -243,59 +590,63 @@ pdi_err_t TmpFs::rename(const char* oldPath, const char* newPath) {
     pdiutil::string oldn = normalize(oldPath);
     pdiutil::string newn = normalize(newPath);
     if (oldn.empty() || newn.empty()) return STORAGE_ERROR_BAD_PATH;
-    int oidx = findNode(oldn);
-    if (oidx < 0) return PDI_ERR_NOT_FOUND;
-    if (findNode(newn) >= 0) return PDI_ERR_EXISTS;
-    if (!parentExists(newn)) return STORAGE_ERROR_NO_PARENT;
-    if (newn.length() > TMPFS_MAX_PATH) return STORAGE_ERROR_NAME_TOO_LONG;
+    uint16_t id = walk(oldn);
+    if (id == TMPFS_NO_NODE) return PDI_ERR_NOT_FOUND;
 
-    bool isdir = (m_nodes[oidx].m_type == FILE_TYPE_DIR);
-    m_nodes[oidx].m_path = newn;
+    uint16_t dir = TMPFS_NO_NODE;
+    pdiutil::string leaf;
+    if (walk(newn, &dir, &leaf) != TMPFS_NO_NODE) return PDI_ERR_EXISTS;
+    if (dir == TMPFS_NO_NODE) return STORAGE_ERROR_NO_PARENT;
+    if (newn.length() > TMPFS_MAX_PATH) return STORAGE_ERROR_NAME_TOO_LONG;
+    // a directory cannot move into its own tree
+    if (isWithin(id, dir)) return STORAGE_ERROR_BAD_PATH;
 
-    if (isdir) {
-        pdiutil::string oldprefix = oldn; oldprefix += "/";
-        pdiutil::string newprefix = newn; newprefix += "/";
-        for (uint32_t i = 0; i < m_nodes.size(); ++i) {
-            pdiutil::string& p = m_nodes[i].m_path;
-            if (p.length() > oldprefix.length() && p.compare(0, oldprefix.length(), oldprefix) == 0) {
-                p = newprefix + p.substr(oldprefix.length());
-            }
-        }
-    }
+    // The entries under a directory name it by id, so they come along as is.
+    unlink(id);
+    link(id, dir, leaf);
     return 0;
 }
 
-pdi_err_t TmpFs::moveFile(const char* oldPath, const char* newPath) {
+pdi_err_t TmpFs::moveFile(const char* oldPath, const char* newPath, CallBackCopyProgressFn) {
     return rename(oldPath, newPath);
 }
 
-pdi_err_t TmpFs::copyFile(const char* sourcePath, const char* destPath) {
-    pdiutil::string src = normalize(sourcePath);
+pdi_err_t TmpFs::copyFile(const char* sourcePath, const char* destPath, CallBackCopyProgressFn progress) {
     pdiutil::string dst = normalize(destPath);
-    int sidx = findNode(src);
-    if (sidx < 0 || m_nodes[sidx].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
+    uint16_t sid = findNode(sourcePath);
+    if (sid == TMPFS_NO_NODE || m_nodes[sid].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
     if (dst.empty()) return STORAGE_ERROR_BAD_PATH;
-    if (findNode(dst) >= 0) return PDI_ERR_EXISTS;
-    if (!parentExists(dst)) return STORAGE_ERROR_NO_PARENT;
     if (dst.length() > TMPFS_MAX_PATH) return STORAGE_ERROR_NAME_TOO_LONG;
-    if (m_nodes.size() >= TMPFS_MAX_NODES) return STORAGE_ERROR_NODE_LIMIT;
-    uint32_t len = (uint32_t)m_nodes[sidx].m_data.length();
-    if (usedBytes() + len > TMPFS_MAX_BYTES) return PDI_ERR_NO_SPACE;
-
-    tmpfs_node_t n;
-    n.m_path = dst;
-    n.m_type = FILE_TYPE_REG;
-    n.m_data = m_nodes[sidx].m_data;
-    stampNew(n, FILE_PERM_DEFAULT_FILE);
-    m_nodes.push_back(n);
+    uint32_t len = m_nodes[sid].m_size;
+    if (m_bytes + len > TMPFS_MAX_BYTES) return PDI_ERR_NO_SPACE;
+
+    int32_t made = makeNode(dst, FILE_TYPE_REG, FILE_PERM_DEFAULT_FILE);
+    if (made < 0) return made;
+
+    // the bytes are already in memory, so the whole copy is one block
+    if (progress && !progress(len, len)) {
+        freeNode((uint16_t)made);
+        return PDI_ERR_ABORTED;
+    }
+
+    tmpfs_cursor_t cursor;
+    for (tmpfs_chunk_t* chunk = m_nodes[sid].m_head; chunk; chunk = chunk->m_next) {
+        tmpfs_node_t& node = m_nodes[made];
+        uint32_t n = len - node.m_size;
+        if (n > TMPFS_CHUNK_SIZE) n = TMPFS_CHUNK_SIZE;
+        int32_t rc = writeAt(node, node.m_size, chunk->m_data, n, cursor);
+        if (rc < 0) {
+            freeNode((uint16_t)made);
+            return rc;
+        }
+    }
     return 0;
 }
 
 pdi_err_t TmpFs::touch(const char* path) {
-    pdiutil::string norm = normalize(path);
-    int idx = findNode(norm);
-    if (idx >= 0) {
-        m_nodes[idx].m_mtime = nowEpoch();
+    uint16_t id = findNode(path);
+    if (id != TMPFS_NO_NODE) {
+        m_nodes[id].m_mtime = nowEpoch();
         return 0;
     }
     return createFile(path, nullptr, 0);
@@ -304,23 +655,19 @@ pdi_err_t TmpFs::touch(const char* path) {
 // ---- query API ------------------------------------------------------------
 
 int64_t TmpFs::getFileSize(const char* path) {
-    pdiutil::string norm = normalize(path);
-    int idx = findNode(norm);
-    if (idx < 0 || m_nodes[idx].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
-    return (int64_t)m_nodes[idx].m_data.length();
+    uint16_t id = findNode(path);
+    if (id == TMPFS_NO_NODE || m_nodes[id].m_type != FILE_TYPE_REG) return STORAGE_ERROR_NOT_A_FILE;
+    return (int64_t)m_nodes[id].m_size;
 }
 
 bool TmpFs::isFileExist(const char* path) {
-    pdiutil::string norm = normalize(path);
-    int idx = findNode(norm);
-    return (idx >= 0 && m_nodes[idx].m_type == FILE_TYPE_REG);
+    uint16_t id = findNode(path);
+    return (id != TMPFS_NO_NODE && m_nodes[id].m_type == FILE_TYPE_REG);
 }
 
 bool TmpFs::isDirExist(const char* path) {
-    pdiutil::string norm = normalize(path);
-    if (norm.empty()) return true; // root
-    int idx = findNode(norm);
-    return (idx >= 0 && m_nodes[idx].m_type == FILE_TYPE_DIR);
+    uint16_t id = findNode(path);
+    return (id != TMPFS_NO_NODE && m_nodes[id].m_type == FILE_TYPE_DIR);
 }
 
 bool TmpFs::isDirectory(const char* path) {
@@ -328,28 +675,25 @@ bool TmpFs::isDirectory(const char* path) {
 }
 
 int TmpFs::getDirFileList(const char* path, pdiutil::vector<file_info_t>& items, const char* pattern) {
-    pdiutil::string norm = normalize(path);
-    if (!isDirExist(path)) return STORAGE_ERROR_NOT_A_DIRECTORY;
-
-    for (uint32_t i = 0; i < m_nodes.size(); ++i) {
-        const tmpfs_node_t& node = m_nodes[i];
-        if (parentOf(node.m_path) != norm) continue;
+    uint16_t dir = findNode(path);
+    if (dir == TMPFS_NO_NODE || m_nodes[dir].m_type != FILE_TYPE_DIR) return STORAGE_ERROR_NOT_A_DIRECTORY;
 
-        pdiutil::string base = basename(node.m_path.c_str());
+    for (uint16_t id = m_nodes[dir].m_child; id != TMPFS_NO_NODE; id = m_nodes[id].m_next) {
+        const tmpfs_node_t& node = m_nodes[id];
         file_info_t info;
         memset(&info, 0, sizeof(info));
         info.m_type  = node.m_type;
-        info.m_size  = (node.m_type == FILE_TYPE_REG) ? (int64_t)node.m_data.length() : 0;
+        info.m_size  = (node.m_type == FILE_TYPE_REG) ? (int64_t)node.m_size : 0;
         info.m_perms = node.m_perms;
         info.m_uid   = node.m_uid;
         info.m_gid   = node.m_gid;
         info.m_ctime = node.m_ctime;
         info.m_mtime = node.m_mtime;
         // Callers (ls) delete[] m_name — hand them a heap copy.
-        uint32_t nlen = (uint32_t)base.length();
+        uint32_t nlen = (uint32_t)node.m_name.length();
         info.m_name = pdiutil::safe_new_array<char>(nlen + 1);
         if (nullptr == info.m_name) continue;
-        memcpy(info.m_name, base.c_str(), nlen);
+        memcpy(info.m_name, node.m_name.c_str(), nlen);
         info.m_name[nlen] = '\0';
         items.push_back(info);
     }
@@ -369,33 +713,24 @@ pdiutil::string TmpFs::basename(const char* path) {
 
 int TmpFs::getFileAttr(const char* path, uint8_t type, void* buffer, uint32_t size) {
     if (!buffer || size == 0) return PDI_ERR_INVALID_ARG;
-    pdiutil::string norm = normalize(path);
-
-    uint16_t perms, uid, gid;
-    uint32_t ctime, mtime;
-    if (norm.empty()) {
-        perms = 0777; uid = 0; gid = 0; ctime = 0; mtime = 0;
-    } else {
-        int idx = findNode(norm);
-        if (idx < 0) return PDI_ERR_NOT_FOUND;
-        perms = m_nodes[idx].m_perms; uid = m_nodes[idx].m_uid; gid = m_nodes[idx].m_gid;
-        ctime = m_nodes[idx].m_ctime; mtime = m_nodes[idx].m_mtime;
-    }
-
-    if (type == FILE_ATTR_PERMS && size >= sizeof(uint16_t)) { *(uint16_t*)buffer = perms; return sizeof(uint16_t); }
-    if (type == FILE_ATTR_UID && size >= sizeof(uint16_t))   { *(uint16_t*)buffer = uid;   return sizeof(uint16_t); }
-    if (type == FILE_ATTR_GID && size >= sizeof(uint16_t))   { *(uint16_t*)buffer = gid;   return sizeof(uint16_t); }
-    if (type == FILE_ATTR_CTIME && size >= sizeof(uint32_t)) { *(uint32_t*)buffer = ctime; return sizeof(uint32_t); }
-    if (type == FILE_ATTR_MTIME && size >= sizeof(uint32_t)) { *(uint32_t*)buffer = mtime; return sizeof(uint32_t); }
+    uint16_t id = findNode(path);
+    if (id == TMPFS_NO_NODE) return PDI_ERR_NOT_FOUND;
+    const tmpfs_node_t& node = m_nodes[id];
+
+    if (type == FILE_ATTR_PERMS && size >= sizeof(uint16_t)) { *(uint16_t*)buffer = node.m_perms; return sizeof(uint16_t); }
+    if (type == FILE_ATTR_UID && size >= sizeof(uint16_t))   { *(uint16_t*)buffer = node.m_uid;   return sizeof(uint16_t); }
+    if (type == FILE_ATTR_GID && size >= sizeof(uint16_t))   { *(uint16_t*)buffer = node.m_gid;   return sizeof(uint16_t); }
+    if (type == FILE_ATTR_CTIME && size >= sizeof(uint32_t)) { *(uint32_t*)buffer = node.m_ctime; return sizeof(uint32_t); }
+    if (type == FILE_ATTR_MTIME && size >= sizeof(uint32_t)) { *(uint32_t*)buffer = node.m_mtime; return sizeof(uint32_t); }
     return STORAGE_ERROR_ATTR_NOT_FOUND;
 }
 
 int TmpFs::setFileAttr(const char* path, uint8_t type, const void* buffer, uint32_t size) {
     if (!buffer || size == 0) return PDI_ERR_INVALID_ARG;
     pdiutil::string norm = normalize(path);
-    int idx = findNode(norm);
-    if (idx < 0) return PDI_ERR_NOT_FOUND;
-    tmpfs_node_t& node = m_nodes[idx];
+    uint16_t id = walk(norm);
+    if (norm.empty() || id == TMPFS_NO_NODE) return PDI_ERR_NOT_FOUND;
+    tmpfs_node_t& node = m_nodes[id];
 
     if (type == FILE_ATTR_PERMS && size >= sizeof(uint16_t)) { node.m_perms = *(const uint16_t*)buffer; return (int)size; }
     if (type == FILE_ATTR_UID && size >= sizeof(uint16_t))   { node.m_uid   = *(const uint16_t*)buffer; return (int)size; }
@@ -406,20 +741,12 @@ int TmpFs::setFileAttr(const char* path, uint8_t type, const void* buffer, uint3
 }
 
 pdi_err_t TmpFs::getFileMeta(const char* path, file_info_t& out) {
-    pdiutil::string norm = normalize(path);
     // m_name is left untouched per the interface contract.
-
-    if (norm.empty()) {
-        out.m_type = FILE_TYPE_DIR; out.m_size = 0; out.m_perms = 0777;
-        out.m_uid = 0; out.m_gid = 0; out.m_ctime = 0; out.m_mtime = 0;
-        return 0;
-    }
-
-    int idx = findNode(norm);
-    if (idx < 0) return PDI_ERR_NOT_FOUND;
-    const tmpfs_node_t& node = m_nodes[idx];
+    uint16_t id = findNode(path);
+    if (id == TMPFS_NO_NODE) return PDI_ERR_NOT_FOUND;
+    const tmpfs_node_t& node = m_nodes[id];
     out.m_type  = node.m_type;
-    out.m_size  = (node.m_type == FILE_TYPE_REG) ? (int64_t)node.m_data.length() : 0;
+    out.m_size  = (node.m_type == FILE_TYPE_REG) ? (int64_t)node.m_size : 0;
     out.m_perms = node.m_perms;
     out.m_uid   = node.m_uid;
     out.m_gid   = node.m_gid;
@@ -430,18 +757,18 @@ pdi_err_t TmpFs::getFileMeta(const char* path, file_info_t& out) {
 
 int TmpFs::setFilePermissions(const char* path, uint16_t perms) {
     pdiutil::string norm = normalize(path);
-    int idx = findNode(norm);
-    if (idx < 0) return PDI_ERR_NOT_FOUND;
-    m_nodes[idx].m_perms = perms;
+    uint16_t id = walk(norm);
+    if (norm.empty() || id == TMPFS_NO_NODE) return PDI_ERR_NOT_FOUND;
+    m_nodes[id].m_perms = perms;
     return 0;
 }
 
 int TmpFs::setFileOwner(const char* path, uint16_t uid, uint16_t gid) {
     pdiutil::string norm = normalize(path);
-    int idx = findNode(norm);
-    if (idx < 0) return PDI_ERR_NOT_FOUND;
-    m_nodes[idx].m_uid = uid;
-    m_nodes[idx].m_gid = gid;
+    uint16_t id = walk(norm);
+    if (norm.empty() || id == TMPFS_NO_NODE) return PDI_ERR_NOT_FOUND;
+    m_nodes[id].m_uid = uid;
+    m_nodes[id].m_gid = gid;
     return 0;
 }
 
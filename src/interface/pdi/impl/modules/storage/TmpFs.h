@@ -9,6 +9,11 @@ backends it actually stores file content and directories in the heap. Mounted at
 /tmp for scratch space. Node count and total byte budget are bounded by
 TmpFsConfig.h; everything is lost on reboot.
 
+Directories form a tree of nodes, each entry found by hashing its parent and
+name, so a path costs one bucket walk per component. File content lives in
+fixed-size chunks chained from the node: an append fills the last chunk and
+takes another, and a truncate hands every chunk back.
+
 Author          : Suraj I.
 Created Date    : 23rd July 2026
 ******************************************************************************/
@@ -21,24 +26,67 @@ Created Date    : 23rd July 2026
 #ifdef ENABLE_TMPFS
 
 #include <config/TmpFsConfig.h>
+#include <config/VfsConfig.h>
 #include <interface/pdi/modules/storage/iFileSystemInterface.h>
 #include <interface/pdi/modules/storage/iStorageInterface.h>
 
+// Node id of no node: the end of a list, or a lookup that found nothing.
+#define TMPFS_NO_NODE 0xFFFF
+
+struct tmpfs_chunk_t {
+  tmpfs_chunk_t *m_next;
+  char m_data[TMPFS_CHUNK_SIZE];
+};
+
+/**
+ * A file or directory. Nodes name each other by id, their slot in the node
+ * table, so a rename only relinks the one node however deep its tree is.
+ * Node 0 is the root.
+ */
 struct tmpfs_node_t {
-  pdiutil::string m_path; ///< normalized, no leading '/', e.g. "x/a.txt"
-  pdiutil::string m_data; ///< file content (regular files only)
+  pdiutil::string m_name;  ///< name within its directory, empty for the root
+  tmpfs_chunk_t *m_head;   ///< content chunks, in file order
+  tmpfs_chunk_t *m_tail;
+  uint32_t m_size;
+  uint16_t m_parent;
+  uint16_t m_child;        ///< first and last entry of a directory
+  uint16_t m_lastchild;
+  uint16_t m_next;         ///< siblings, in the order they were made
+  uint16_t m_prev;
+  uint16_t m_hashnext;     ///< next node in the same lookup bucket
+  uint16_t m_gen;          ///< bumped when the slot is freed
+  uint16_t m_epoch;        ///< bumped when chunks are given back
   file_type_t m_type;
+  bool m_used;
   uint16_t m_perms;
   uint16_t m_uid;
   uint16_t m_gid;
   uint32_t m_ctime;
   uint32_t m_mtime;
+  tmpfs_node_t()
+    : m_head(nullptr), m_tail(nullptr), m_size(0), m_parent(TMPFS_NO_NODE),
+      m_child(TMPFS_NO_NODE), m_lastchild(TMPFS_NO_NODE), m_next(TMPFS_NO_NODE),
+      m_prev(TMPFS_NO_NODE), m_hashnext(TMPFS_NO_NODE), m_gen(0), m_epoch(0),
+      m_type(FILE_TYPE_REG), m_used(false), m_perms(0), m_uid(0), m_gid(0),
+      m_ctime(0), m_mtime(0) {}
+};
+
+/**
+ * Where the last transfer on a file stopped, so the next one carries on from
+ * that chunk instead of walking from the first. Only trusted while the file's
+ * epoch says no chunk has been given back since.
+ */
+struct tmpfs_cursor_t {
+  tmpfs_chunk_t *m_chunk;
+  uint32_t m_index;
+  uint16_t m_epoch;
+  tmpfs_cursor_t() : m_chunk(nullptr), m_index(0), m_epoch(0) {}
 };
 
 class TmpFs : public iFileSystemInterface {
 public:
   TmpFs();
-  virtual ~TmpFs() {}
+  virtual ~TmpFs();
 
   pdi_err_t init() override { return 0; }
 
@@ -46,7 +94,7 @@ public:
   int editFile(const char *path, uint64_t offset, const char *content, uint32_t size) override;
   int writeFile(const char *path, const char *content, uint32_t size, bool append = false) override;
   int readFile(const char *path, uint64_t size,
-               pdiutil::function<bool(char *, uint32_t)> readbackfn,
+               pdiutil::function_ref<bool(char *, uint32_t)> readbackfn,
                uint64_t offset = 0, const char *readUntilMatchStr = nullptr,
                bool *didmatchfound = nullptr) override;
 
@@ -69,8 +117,8 @@ public:
   pdi_err_t createDirectory(const char *path) override;
   pdi_err_t deleteDirectory(const char *path) override;
   pdi_err_t rename(const char *oldPath, const char *newPath) override;
-  pdi_err_t copyFile(const char *sourcePath, const char *destPath) override;
-  pdi_err_t moveFile(const char *oldPath, const char *newPath) override;
+  pdi_err_t copyFile(const char *sourcePath, const char *destPath, CallBackCopyProgressFn progress = nullptr) override;
+  pdi_err_t moveFile(const char *oldPath, const char *newPath, CallBackCopyProgressFn progress = nullptr) override;
   pdi_err_t deleteFile(const char *path) override;
 
   int64_t getFileSize(const char *path) override;
@@ -81,10 +129,9 @@ public:
   bool isDirectory(const char *path) override;
 
   uint64_t getTotalSize() override { return TMPFS_MAX_BYTES; }
-  uint64_t getUsedSize() override { return usedBytes(); }
+  uint64_t getUsedSize() override { return m_bytes; }
   uint64_t getFreeSize() override {
-    uint64_t used = usedBytes();
-    return (used >= TMPFS_MAX_BYTES) ? 0 : (TMPFS_MAX_BYTES - used);
+    return (m_bytes >= TMPFS_MAX_BYTES) ? 0 : (TMPFS_MAX_BYTES - m_bytes);
   }
 
   pdiutil::string getPWD() const override { return pdiutil::string("/tmp"); }
@@ -112,6 +159,12 @@ public:
   int setFileOwner(const char *path, uint16_t uid, uint16_t gid) override;
   pdi_err_t touch(const char *path) override;
 
+  int16_t openFile(const char *path, uint8_t flags) override;
+  int32_t readHandle(int16_t fd, char *buffer, uint32_t size) override;
+  int32_t writeHandle(int16_t fd, const char *buffer, uint32_t size) override;
+  int64_t seekHandle(int16_t fd, int64_t offset, file_seek_t whence = FILE_SEEK_SET) override;
+  pdi_err_t closeFile(int16_t fd) override;
+
 protected:
   uint32_t nowEpoch() override;
   void currentOwner(uint16_t &uid, uint16_t &gid) override;
@@ -119,12 +172,50 @@ protected:
 
 private:
   pdiutil::vector<tmpfs_node_t> m_nodes;
+  uint16_t m_buckets[TMPFS_HASH_BUCKETS];
+  uint16_t m_free;          ///< freed node slots, chained through m_next
+  uint16_t m_count;         ///< nodes in use, the root not counted
+  uint32_t m_bytes;         ///< content bytes across all files
+  tmpfs_chunk_t *m_spare;   ///< chunks kept back for reuse
+  uint16_t m_sparecount;
+
+  /**
+   * an open file. it names its node by id and generation, so a node deleted
+   * under it reads as gone even once its slot is reused.
+   */
+  struct tmpfs_handle_t {
+    uint16_t m_node;
+    uint16_t m_gen;
+    uint32_t m_pos;
+    uint8_t m_flags;
+    bool m_used;
+    tmpfs_cursor_t m_cursor;
+    tmpfs_handle_t() : m_node(TMPFS_NO_NODE), m_gen(0), m_pos(0), m_flags(0), m_used(false) {}
+  };
+
+  tmpfs_handle_t m_handles[VFS_MAX_OPEN_FILES];
+
+  tmpfs_handle_t *handleOf(int16_t fd);
+  tmpfs_node_t *nodeOf(const tmpfs_handle_t &h);
 
   pdiutil::string normalize(const char *path) const;
-  int findNode(const pdiutil::string &norm) const;
-  pdiutil::string parentOf(const pdiutil::string &norm) const;
-  bool parentExists(const pdiutil::string &norm) const;
-  uint32_t usedBytes() const;
+  uint16_t bucketOf(uint16_t dir, const char *name, uint32_t len) const;
+  uint16_t lookup(uint16_t dir, const char *name, uint32_t len) const;
+  uint16_t walk(const pdiutil::string &norm, uint16_t *parent = nullptr, pdiutil::string *leaf = nullptr) const;
+  uint16_t findNode(const char *path) const;
+  bool isWithin(uint16_t id, uint16_t dir) const;
+  void link(uint16_t id, uint16_t dir, const pdiutil::string &name);
+  void unlink(uint16_t id);
+  int32_t makeNode(const pdiutil::string &norm, file_type_t type, uint16_t defperms);
+  void freeNode(uint16_t id);
+
+  tmpfs_chunk_t *takeChunk();
+  void giveChunk(tmpfs_chunk_t *chunk);
+  void truncate(tmpfs_node_t &node);
+  tmpfs_chunk_t *chunkAt(tmpfs_node_t &node, uint32_t index, tmpfs_cursor_t &cursor);
+  int32_t readAt(tmpfs_node_t &node, uint32_t pos, char *buffer, uint32_t size, tmpfs_cursor_t &cursor);
+  int32_t writeAt(tmpfs_node_t &node, uint32_t pos, const char *buffer, uint32_t size, tmpfs_cursor_t &cursor);
+
   void stampNew(tmpfs_node_t &n, uint16_t defperms);
   int putContent(const pdiutil::string &norm, const char *content, uint32_t size, bool append);
 };
@@ -13,6 +13,8 @@ Created Date    : 20th July 2026
 #ifdef ENABLE_STORAGE_SERVICE
 
 #include "VfsDispatcher.h"
+#include <interface/pdi/modules/storage/FileCopyEngine.h>
+#include <interface/pdi/middlewares/iDeviceControlInterface.h>
 
 #ifdef ENABLE_AUTH_SERVICE
 #include <service_provider/session/SessionManager.h>
@@ -35,7 +37,9 @@ const pdiutil::string s_empty_string;
 
 }
 
-VfsDispatcher::VfsDispatcher() : iFileSystemInterface(s_null_storage), m_mount_count(0), m_priv_depth(0) {}
+VfsDispatcher::VfsDispatcher() : iFileSystemInterface(s_null_storage), m_mount_count(0), m_priv_depth(0) {
+    memset(m_handles, 0, sizeof(m_handles));
+}
 
 int8_t VfsDispatcher::mount(const char* prefix, iFileSystemInterface* backend, const char* name, vfs_type_t type) {
     if (!prefix || !backend) {
@@ -219,7 +223,7 @@ int VfsDispatcher::writeFile(const char* path, const char* content, uint32_t siz
     if (!checkAccess(path, VFS_ACCESS_W)) return PDI_ERR_PERM;
     VFS_ROUTE_PATH(writeFile, path, STORAGE_ERROR_NOT_MOUNTED, content, size, append);
 }
-int VfsDispatcher::readFile(const char* path, uint64_t size, pdiutil::function<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
+int VfsDispatcher::readFile(const char* path, uint64_t size, pdiutil::function_ref<bool(char*, uint32_t)> readbackfn, uint64_t offset, const char* readUntilMatchStr, bool* didmatchfound) {
     if (!checkAccess(path, VFS_ACCESS_R)) return PDI_ERR_PERM;
     VFS_ROUTE_PATH(readFile, path, STORAGE_ERROR_NOT_MOUNTED, size, readbackfn, offset, readUntilMatchStr, didmatchfound);
 }
@@ -243,6 +247,10 @@ int VfsDispatcher::readLineInFile(const char* path, int32_t linenumber, pdiutil:
     if (!checkAccess(path, VFS_ACCESS_R)) return PDI_ERR_PERM;
     VFS_ROUTE_PATH(readLineInFile, path, STORAGE_ERROR_NOT_MOUNTED, linenumber, linedata, pattern, yield);
 }
+pdi_err_t VfsDispatcher::indexLines(const char* path, CallBackVoidArgFn yield) {
+    if (!checkAccess(path, VFS_ACCESS_W)) return PDI_ERR_PERM;
+    VFS_ROUTE_PATH(indexLines, path, STORAGE_ERROR_NOT_MOUNTED, yield);
+}
 pdi_err_t VfsDispatcher::createDirectory(const char* path) {
     VFS_ROUTE_PATH(createDirectory, path, STORAGE_ERROR_NOT_MOUNTED);
 }
@@ -305,29 +313,43 @@ pdi_err_t VfsDispatcher::touch(const char* path) {
 
 #undef VFS_ROUTE_PATH
 
-int VfsDispatcher::crossCopy(iFileSystemInterface* sb, const char* srel, iFileSystemInterface* db, const char* drel) {
+void VfsDispatcher::copyYield() {
+    __i_dvc_ctrl.yield();
+}
+
+int VfsDispatcher::crossCopy(iFileSystemInterface* sb, const char* srel, iFileSystemInterface* db, const char* drel,
+                            const CallBackCopyProgressFn& progress) {
     // Only regular files stream across a mount boundary.
     if (!sb->isFileExist(srel) || sb->isDirectory(srel)) return STORAGE_ERROR_NOT_A_FILE;
     if (db->isFileExist(drel) || db->isDirExist(drel)) return PDI_ERR_EXISTS;
 
-    // Deliver source content in chunks; the first chunk creates/truncates the
-    // destination, the rest append. `size` here is the per-callback chunk cap.
-    bool first = true;
-    bool ok = true;
-    int rc = sb->readFile(srel, 128, [&](char* data, uint32_t n)->bool {
-        int w = db->writeFile(drel, data, n, !first);
-        first = false;
-        if (w < 0) { ok = false; return false; }
-        return true;
-    });
-    if (rc < 0 || !ok) {
-        db->deleteFile(drel);
+    int16_t sfd = sb->openFile(srel, FILE_OPEN_READ);
+    if (sfd < 0) return STORAGE_ERROR_BACKEND;
+    // Opening with create makes the destination even when the source is empty.
+    int16_t dfd = db->openFile(drel, FILE_OPEN_WRITE | FILE_OPEN_CREATE | FILE_OPEN_TRUNC);
+    if (dfd < 0) {
+        sb->closeFile(sfd);
         return STORAGE_ERROR_BACKEND;
     }
-    // Empty source: no chunk was delivered. A zero-byte writeFile does not
-    // create the file on every backend (LittleFS opens without O_CREAT for an
-    // empty write), so materialise the empty destination with createFile.
-    if (first && db->createFile(drel, "", 0) < 0) return STORAGE_ERROR_BACKEND;
+
+    // A synthetic source may not know its size up front; the engine then
+    // takes its largest block.
+    int64_t size = sb->seekHandle(sfd, 0, FILE_SEEK_END);
+    sb->seekHandle(sfd, 0);
+    FileCopyEngine engine(0, size > 0 ? (uint64_t)size : 0);
+    int64_t copied = engine.run(
+        [&](char* buffer, uint32_t len) { return sb->readHandle(sfd, buffer, len); },
+        [&](const char* buffer, uint32_t len) { return db->writeHandle(dfd, buffer, len); },
+        [&](uint64_t done, uint64_t total) {
+            copyYield();
+            return !progress || progress(done, total);
+        });
+    sb->closeFile(sfd);
+    pdi_err_t closed = db->closeFile(dfd);
+    if (copied < 0 || closed < 0) {
+        db->deleteFile(drel);
+        return (PDI_ERR_ABORTED == copied) ? PDI_ERR_ABORTED : STORAGE_ERROR_BACKEND;
+    }
     return 0;
 }
 
@@ -339,32 +361,184 @@ pdi_err_t VfsDispatcher::rename(const char* oldPath, const char* newPath) {
     if (!ob || !nb) return STORAGE_ERROR_NOT_MOUNTED;
     if (ob == nb) return ob->rename(orel, nrel);
     // Cross-mount rename == copy to the new backend then drop the source.
-    int rc = crossCopy(ob, orel, nb, nrel);
+    int rc = crossCopy(ob, orel, nb, nrel, nullptr);
     if (rc < 0) return rc;
     return ob->deleteFile(orel);
 }
-pdi_err_t VfsDispatcher::copyFile(const char* sourcePath, const char* destPath) {
+pdi_err_t VfsDispatcher::copyFile(const char* sourcePath, const char* destPath, CallBackCopyProgressFn progress) {
     if (!checkAccess(sourcePath, VFS_ACCESS_R)) return PDI_ERR_PERM;
     if (!checkAccess(destPath, VFS_ACCESS_W)) return PDI_ERR_PERM;
     const char *srel = nullptr, *drel = nullptr;
     iFileSystemInterface* sb = resolve(sourcePath, &srel);
     iFileSystemInterface* db = resolve(destPath, &drel);
     if (!sb || !db) return STORAGE_ERROR_NOT_MOUNTED;
-    if (sb == db) return sb->copyFile(srel, drel);
-    return crossCopy(sb, srel, db, drel);
+    if (sb == db) return sb->copyFile(srel, drel, progress);
+    return crossCopy(sb, srel, db, drel, progress);
 }
-pdi_err_t VfsDispatcher::moveFile(const char* oldPath, const char* newPath) {
+pdi_err_t VfsDispatcher::moveFile(const char* oldPath, const char* newPath, CallBackCopyProgressFn progress) {
     if (!checkAccess(newPath, VFS_ACCESS_W)) return PDI_ERR_PERM;
     const char *orel = nullptr, *nrel = nullptr;
     iFileSystemInterface* ob = resolve(oldPath, &orel);
     iFileSystemInterface* nb = resolve(newPath, &nrel);
     if (!ob || !nb) return STORAGE_ERROR_NOT_MOUNTED;
-    if (ob == nb) return ob->moveFile(orel, nrel);
-    int rc = crossCopy(ob, orel, nb, nrel);
+    // Within one backend a move is a rename and never touches the bytes.
+    if (ob == nb) return ob->moveFile(orel, nrel, progress);
+    int rc = crossCopy(ob, orel, nb, nrel, progress);
     if (rc < 0) return rc;
     return ob->deleteFile(orel);
 }
 
+VfsDispatcher::vfs_handle_t* VfsDispatcher::handleOf(int16_t fd) {
+    if (fd < 0 || fd >= VFS_MAX_OPEN_FILES || !m_handles[fd].m_backend) return nullptr;
+    return &m_handles[fd];
+}
+
+// Pass held writes down to the backend. Returns 0 or the backend's error.
+int32_t VfsDispatcher::flushHandle(vfs_handle_t& h) {
+    if (!h.m_dirty) return 0;
+    uint16_t held = h.m_length;
+    int32_t w = held ? h.m_backend->writeHandle(h.m_fd, h.m_buffer, held) : 0;
+    h.m_dirty = false;
+    h.m_length = 0;
+    h.m_pos = 0;
+    if (w < 0) return w;
+    return (w == held) ? 0 : PDI_ERR_IO;
+}
+
+// Forget bytes read ahead, moving the backend back to where the caller is.
+int64_t VfsDispatcher::dropReadAhead(vfs_handle_t& h) {
+    if (h.m_dirty) return 0;
+    uint16_t ahead = h.m_length - h.m_pos;
+    h.m_length = 0;
+    h.m_pos = 0;
+    return ahead ? h.m_backend->seekHandle(h.m_fd, -(int64_t)ahead, FILE_SEEK_CUR) : 0;
+}
+
+int16_t VfsDispatcher::openFile(const char* path, uint8_t flags) {
+    uint8_t need = 0;
+    if (flags & FILE_OPEN_READ) need |= VFS_ACCESS_R;
+    if (flags & (FILE_OPEN_WRITE | FILE_OPEN_APPEND | FILE_OPEN_TRUNC)) need |= VFS_ACCESS_W;
+    if (!need) return PDI_ERR_INVALID_ARG;
+    if (!checkAccess(path, need)) return PDI_ERR_PERM;
+
+    const char* rel = nullptr;
+    iFileSystemInterface* b = resolve(path, &rel);
+    if (!b) return STORAGE_ERROR_NOT_MOUNTED;
+
+    int16_t fd = 0;
+    while (fd < VFS_MAX_OPEN_FILES && m_handles[fd].m_backend) fd++;
+    if (fd >= VFS_MAX_OPEN_FILES) return PDI_ERR_FULL;
+
+    int16_t bfd = b->openFile(rel, flags);
+    if (bfd < 0) return bfd;
+
+    vfs_handle_t& h = m_handles[fd];
+    memset(&h, 0, sizeof(h));
+    h.m_backend = b;
+    h.m_fd = bfd;
+    h.m_flags = flags;
+    return fd;
+}
+
+int32_t VfsDispatcher::readHandle(int16_t fd, char* buffer, uint32_t size) {
+    vfs_handle_t* h = handleOf(fd);
+    if (!h || !buffer) return PDI_ERR_INVALID_ARG;
+    if (!(h->m_flags & FILE_OPEN_READ)) return PDI_ERR_PERM;
+    int32_t rc = flushHandle(*h);
+    if (rc < 0) return rc;
+    if (!h->m_buffer) h->m_buffer = pdiutil::safe_new_array<char>(VFS_HANDLE_BUFFER_SIZE);
+
+    uint32_t done = 0;
+    while (done < size) {
+        if (h->m_pos < h->m_length) {
+            uint32_t n = h->m_length - h->m_pos;
+            if (n > size - done) n = size - done;
+            memcpy(buffer + done, h->m_buffer + h->m_pos, n);
+            h->m_pos += n;
+            done += n;
+            continue;
+        }
+        // Large reads, or a handle that got no buffer, go straight through.
+        if (!h->m_buffer || size - done >= VFS_HANDLE_BUFFER_SIZE) {
+            int32_t r = h->m_backend->readHandle(h->m_fd, buffer + done, size - done);
+            if (r < 0) return done ? (int32_t)done : r;
+            done += r;
+            break;
+        }
+        int32_t r = h->m_backend->readHandle(h->m_fd, h->m_buffer, VFS_HANDLE_BUFFER_SIZE);
+        if (r <= 0) {
+            if (r < 0 && !done) return r;
+            break;
+        }
+        h->m_length = (uint16_t)r;
+        h->m_pos = 0;
+    }
+    return (int32_t)done;
+}
+
+int32_t VfsDispatcher::writeHandle(int16_t fd, const char* buffer, uint32_t size) {
+    vfs_handle_t* h = handleOf(fd);
+    if (!h || !buffer) return PDI_ERR_INVALID_ARG;
+    if (!(h->m_flags & (FILE_OPEN_WRITE | FILE_OPEN_APPEND))) return PDI_ERR_PERM;
+    int64_t sk = dropReadAhead(*h);
+    if (sk < 0) return (int32_t)sk;
+    if (!h->m_buffer) h->m_buffer = pdiutil::safe_new_array<char>(VFS_HANDLE_BUFFER_SIZE);
+
+    // Large writes, or a handle that got no buffer, go straight through.
+    if (!h->m_buffer || size >= VFS_HANDLE_BUFFER_SIZE) {
+        int32_t rc = flushHandle(*h);
+        if (rc < 0) return rc;
+        return h->m_backend->writeHandle(h->m_fd, buffer, size);
+    }
+
+    uint32_t done = 0;
+    while (done < size) {
+        uint32_t n = VFS_HANDLE_BUFFER_SIZE - h->m_length;
+        if (n > size - done) n = size - done;
+        memcpy(h->m_buffer + h->m_length, buffer + done, n);
+        h->m_length += n;
+        h->m_dirty = true;
+        done += n;
+        if (h->m_length == VFS_HANDLE_BUFFER_SIZE) {
+            int32_t rc = flushHandle(*h);
+            if (rc < 0) return rc;
+        }
+    }
+    return (int32_t)size;
+}
+
+int64_t VfsDispatcher::seekHandle(int16_t fd, int64_t offset, file_seek_t whence) {
+    vfs_handle_t* h = handleOf(fd);
+    if (!h) return PDI_ERR_INVALID_ARG;
+    int32_t rc = flushHandle(*h);
+    if (rc < 0) return rc;
+
+    // A relative move that stays inside what was read ahead keeps the buffer.
+    if (whence == FILE_SEEK_CUR && h->m_length) {
+        int64_t target = (int64_t)h->m_pos + offset;
+        if (target >= 0 && target <= h->m_length) {
+            int64_t end = h->m_backend->seekHandle(h->m_fd, 0, FILE_SEEK_CUR);
+            if (end < 0) return end;
+            h->m_pos = (uint16_t)target;
+            return end - (h->m_length - h->m_pos);
+        }
+        offset -= (h->m_length - h->m_pos);
+    }
+    h->m_length = 0;
+    h->m_pos = 0;
+    return h->m_backend->seekHandle(h->m_fd, offset, whence);
+}
+
+pdi_err_t VfsDispatcher::closeFile(int16_t fd) {
+    vfs_handle_t* h = handleOf(fd);
+    if (!h) return PDI_ERR_INVALID_ARG;
+    int32_t rc = flushHandle(*h);
+    int32_t cr = h->m_backend->closeFile(h->m_fd);
+    pdiutil::safe_delete_array(h->m_buffer);
+    memset(h, 0, sizeof(*h));
+    return (rc < 0) ? rc : cr;
+}
+
 uint64_t VfsDispatcher::getTotalSize() {
     iFileSystemInterface* r = rootBackend();
     return r ? r->getTotalSize() : 0;
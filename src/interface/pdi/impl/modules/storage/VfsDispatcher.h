@@ -39,19 +39,20 @@ public:
     int createFile(const char* path, const char* content, int64_t size = -1) override;
     int editFile(const char* path, uint64_t offset, const char* content, uint32_t size) override;
     int writeFile(const char* path, const char* content, uint32_t size, bool append = false) override;
-    int readFile(const char* path, uint64_t size, pdiutil::function<bool(char*, uint32_t)> readbackfn, uint64_t offset = 0, const char* readUntilMatchStr = nullptr, bool* didmatchfound = nullptr) override;
+    int readFile(const char* path, uint64_t size, pdiutil::function_ref<bool(char*, uint32_t)> readbackfn, uint64_t offset = 0, const char* readUntilMatchStr = nullptr, bool* didmatchfound = nullptr) override;
 
     int64_t getOffsetFromLineNumber(const char* path, int linenumber, CallBackVoidArgFn yield = nullptr) override;
     int64_t getLineNumberFromOffset(const char* path, int64_t offset, CallBackVoidArgFn yield = nullptr) override;
     int findInFile(const char* path, const char* findStr, pdiutil::vector<uint32_t>* findindices, int maxindices = -1, int everynthindice = 1, int64_t offset = 0, CallBackVoidArgFn yield = nullptr) override;
     int getLineNumbersInFile(const char* path, pdiutil::vector<uint32_t>& linenumberindices, int maxlinenumbers = -1, int linenumberoffset = 0, CallBackVoidArgFn yield = nullptr) override;
     int readLineInFile(const char* path, int32_t linenumber, pdiutil::string& linedata, const char* pattern = nullptr, CallBackVoidArgFn yield = nullptr) override;
+    pdi_err_t indexLines(const char* path, CallBackVoidArgFn yield = nullptr) override;
 
     pdi_err_t createDirectory(const char* path) override;
     pdi_err_t deleteDirectory(const char* path) override;
     pdi_err_t rename(const char* oldPath, const char* newPath) override;
-    pdi_err_t copyFile(const char* sourcePath, const char* destPath) override;
-    pdi_err_t moveFile(const char* oldPath, const char* newPath) override;
+    pdi_err_t copyFile(const char* sourcePath, const char* destPath, CallBackCopyProgressFn progress = nullptr) override;
+    pdi_err_t moveFile(const char* oldPath, const char* newPath, CallBackCopyProgressFn progress = nullptr) override;
     pdi_err_t deleteFile(const char* path) override;
 
     int64_t getFileSize(const char* path) override;
@@ -89,6 +90,15 @@ public:
     int setFileOwner(const char* path, uint16_t uid, uint16_t gid) override;
     pdi_err_t touch(const char* path) override;
 
+    // Handles are routed like paths: the mount is resolved and the access
+    // bits checked once at open, after which a handle only names a backend
+    // handle and the buffer kept in front of it.
+    int16_t openFile(const char* path, uint8_t flags) override;
+    int32_t readHandle(int16_t fd, char* buffer, uint32_t size) override;
+    int32_t writeHandle(int16_t fd, const char* buffer, uint32_t size) override;
+    int64_t seekHandle(int16_t fd, int64_t offset, file_seek_t whence = FILE_SEEK_SET) override;
+    pdi_err_t closeFile(int16_t fd) override;
+
     // POSIX-style access-mode bits accepted by checkAccess.
     static constexpr uint8_t VFS_ACCESS_R = 4;
     static constexpr uint8_t VFS_ACCESS_W = 2;
@@ -115,16 +125,37 @@ public:
 
 protected:
     uint32_t nowEpoch() override { return 0; }
+    void copyYield() override;
 
     iFileSystemInterface* resolve(const char* path, const char** relpath_out) const;
     iFileSystemInterface* rootBackend() const;
 
-    // Stream a regular file from one backend to another (used when copy/move
-    // cross a mount boundary). Returns 0 on success, -1 otherwise.
+    // Stream a regular file from one backend to another through a handle on
+    // each (used when copy/move cross a mount boundary), in FileCopyEngine
+    // blocks. Returns 0 on success, a negative error code otherwise.
     int crossCopy(iFileSystemInterface* sb, const char* srel,
-                  iFileSystemInterface* db, const char* drel);
+                  iFileSystemInterface* db, const char* drel,
+                  const CallBackCopyProgressFn& progress);
+
+    // An open file. The buffer holds either bytes read ahead of the caller
+    // (m_pos is the next one to hand out) or writes not yet passed down
+    // (m_dirty), never both, so the backend position is always known.
+    struct vfs_handle_t {
+        iFileSystemInterface* m_backend;   // nullptr while the slot is free
+        int16_t m_fd;                      // handle of the backend
+        uint8_t m_flags;
+        bool m_dirty;
+        char* m_buffer;                    // VFS_HANDLE_BUFFER_SIZE bytes, nullptr until first used
+        uint16_t m_length;                 // bytes held in the buffer
+        uint16_t m_pos;
+    };
+
+    vfs_handle_t* handleOf(int16_t fd);
+    int32_t flushHandle(vfs_handle_t& h);
+    int64_t dropReadAhead(vfs_handle_t& h);
 
     vfs_mount_t m_mounts[VFS_MAX_MOUNTS];
+    vfs_handle_t m_handles[VFS_MAX_OPEN_FILES];
     uint8_t m_mount_count;
     uint8_t m_priv_depth;
 };
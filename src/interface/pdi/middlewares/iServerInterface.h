@@ -155,14 +155,19 @@ public:
   #endif
 
   virtual void on(const pdiutil::string &uri, CallBackVoidArgFn handler) = 0;
+  virtual void on(const pdiutil::string &uri, http_method_t method, CallBackVoidArgFn handler) { on(uri, handler); } // only for requests of method
   virtual void onNotFound(CallBackVoidArgFn fn) = 0;   // called when handler is not assigned
 
   virtual pdiutil::string arg(const pdiutil::string &name) const = 0;                       // get request argument value by name
+  virtual const char *argView(const char *name) const { return nullptr; }                  // view of an argument value, valid until the handler returns
+  virtual pdiutil::string_view argView(pdiutil::string_view name) const { return pdiutil::string_view(); } // the same keyed by a view
   virtual bool hasArg(const pdiutil::string &name) const = 0;                               // check if argument exists
   virtual bool isPostRequest() const { return false; }                                      // check if request method is POST
 
   virtual void collectHeaders(const char *headerKeys[], const size_t headerKeysCount) = 0;  // set the request headers to collect
   virtual pdiutil::string header(const pdiutil::string &name) const = 0;                    // get request header value by name
+  virtual const char *headerView(const char *name) const { return nullptr; }               // view of a header value, valid until the handler returns
+  virtual pdiutil::string_view headerView(pdiutil::string_view name) const { return pdiutil::string_view(); } // the same keyed by a view
   virtual bool hasHeader(const pdiutil::string &name) const = 0;                            // check if header exists
   virtual void addHeader(const pdiutil::string &name, const pdiutil::string &value) = 0;
 
@@ -171,6 +176,22 @@ public:
   
   virtual void send(int code, mimetype_t content_type = MIME_TYPE_MAX, const char *content = nullptr, bool send_in_chunks = false) = 0;
   virtual void sendChunk(const char *chunk = nullptr) {}
+
+  /**
+   * @brief Answer the current request with a server-sent event stream and keep
+   *        its connection once the handler returns. Only valid inside a handler.
+   * @return Handle of the stream, or -1 when it was refused with 503.
+   */
+  virtual int16_t openEventStream() { return -1; }
+  /**
+   * @brief Push one event down an open stream.
+   * @param stream Handle returned by openEventStream().
+   * @param event Event name, nullptr for the default "message" event.
+   * @param data Event data, a single line.
+   * @return false once the stream is gone, the handle is then stale.
+   */
+  virtual bool sendEvent(int16_t stream, const char *event, const char *data) { return false; }
+  virtual void closeEventStream(int16_t stream) {}
 };
 
 /// derived class must define this
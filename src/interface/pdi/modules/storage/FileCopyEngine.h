@@ -0,0 +1,83 @@
+/***************************** File Copy Engine *******************************
+This file is part of the PDI Stack.
+
+This is free software. You can redistribute it and/or modify it but without any
+warranty.
+
+Moves a file's bytes from a reader to a writer in blocks as large as the heap
+and the backends allow. The scratch buffer is sized once per copy to the
+smaller of VFS_COPY_BUFFER_MAX, the backend's block and the file itself, then
+halved until the heap can spare it; when it cannot spare even that, the copy
+runs through VFS_COPY_BUFFER_MIN bytes of stack. Between blocks the caller's
+pace callback gets a turn, which is where it yields and where it may stop.
+
+Author          : Suraj I.
+Created Date    : 17th Oct 2026
+******************************************************************************/
+
+#ifndef _FILE_COPY_ENGINE_H
+#define _FILE_COPY_ENGINE_H
+
+#include <config/VfsConfig.h>
+#include <interface/interface_includes.h>
+
+class FileCopyEngine {
+public:
+  typedef pdiutil::function<int32_t(char *, uint32_t)> reader_t;
+  typedef pdiutil::function<int32_t(const char *, uint32_t)> writer_t;
+
+  /**
+   * @param unit The transfer size the backend handles best, 0 when it has none.
+   * @param total Bytes the copy will move, 0 when not known up front.
+   */
+  FileCopyEngine(uint32_t unit, uint64_t total)
+    : m_buffer(nullptr), m_size(VFS_COPY_BUFFER_MIN), m_total(total) {
+    uint32_t want = VFS_COPY_BUFFER_MAX;
+    if (unit && unit < want) want = unit;
+    if (total && total < want) want = (uint32_t)total;
+    for (; want > VFS_COPY_BUFFER_MIN; want /= 2) {
+      m_buffer = pdiutil::safe_new_array<char>(want);
+      if (m_buffer) {
+        m_size = want;
+        break;
+      }
+    }
+  }
+
+  ~FileCopyEngine() { pdiutil::safe_delete_array(m_buffer); }
+
+  /**
+   * @brief Bytes moved per block, fixed for the life of the engine.
+   */
+  uint32_t blockSize() const { return m_size; }
+
+  /**
+   * @brief Copies until the reader reports the end.
+   * @param pace Called after every block with the bytes copied so far and the
+   *        total; returning false stops the copy.
+   * @return Bytes copied, or a negative error code: the reader's or the
+   *         writer's own, PDI_ERR_IO on a short write, PDI_ERR_ABORTED when
+   *         pace stopped it.
+   */
+  int64_t run(const reader_t &read, const writer_t &write, const CallBackCopyProgressFn &pace) {
+    char fallback[VFS_COPY_BUFFER_MIN];
+    char *buffer = m_buffer ? m_buffer : fallback;
+    uint64_t copied = 0;
+    int32_t n;
+    while ((n = read(buffer, m_size)) > 0) {
+      int32_t w = write(buffer, (uint32_t)n);
+      if (w < 0) return w;
+      if (w != n) return PDI_ERR_IO;
+      copied += (uint32_t)n;
+      if (pace && !pace(copied, m_total)) return PDI_ERR_ABORTED;
+    }
+    return (n < 0) ? n : (int64_t)copied;
+  }
+
+private:
+  char *m_buffer;
+  uint32_t m_size;
+  uint64_t m_total;
+};
+
+#endif
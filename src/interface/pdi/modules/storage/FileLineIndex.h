@@ -0,0 +1,147 @@
+/***************************** File Line Index ********************************
+This file is part of the PDI Stack.
+
+This is free software. You can redistribute it and/or modify it but without any
+warranty.
+
+Where the lines of a file start, kept next to the file so a line-addressed read
+seeks close to its line instead of counting newlines from byte 0. The record
+holds the size and newline count of the bytes it has seen and the offset of
+every stride-th line. It is fed bytes in file order, so an append only costs
+the appended bytes; when the checkpoints fill up every other one is dropped
+and the stride doubles, which keeps the record within VFS_LINE_INDEX_BYTES and
+any lookup within one stride of scanning.
+
+Author          : Suraj I.
+Created Date    : 17th Oct 2026
+******************************************************************************/
+
+#ifndef _FILE_LINE_INDEX_H
+#define _FILE_LINE_INDEX_H
+
+#include <config/VfsConfig.h>
+#include <interface/interface_includes.h>
+
+class FileLineIndex {
+public:
+  static constexpr uint32_t HEADER_BYTES = 16;
+  static constexpr uint16_t CAPACITY = (VFS_LINE_INDEX_BYTES - HEADER_BYTES) / sizeof(uint32_t);
+
+  FileLineIndex() { reset(); }
+
+  void reset() {
+    memset(&m_record, 0, sizeof(m_record));
+    m_record.m_stride = VFS_LINE_INDEX_STRIDE;
+  }
+
+  /**
+   * @brief The record as stored, and its length once count checkpoints are in.
+   */
+  void *data() { return &m_record; }
+  uint32_t length() const { return HEADER_BYTES + m_record.m_count * sizeof(uint32_t); }
+  uint32_t room() const { return sizeof(m_record); }
+
+  /**
+   * @brief Empties the record to be read back into; a read that finds no
+   *        attribute leaves it empty, and an empty record is not loaded.
+   */
+  void *clear() {
+    memset(&m_record, 0, sizeof(m_record));
+    return &m_record;
+  }
+
+  /**
+   * @brief Checks a record just read back from its attribute.
+   */
+  bool loaded() const { return m_record.m_stride > 0 && m_record.m_count <= CAPACITY; }
+
+  uint32_t size() const { return m_record.m_size; }
+  uint32_t newlines() const { return m_record.m_newlines; }
+
+  /**
+   * @brief Lines in the file, counting a last one without its newline.
+   */
+  uint32_t lines() const { return m_record.m_newlines + (m_record.m_open ? 1 : 0); }
+
+  /**
+   * @brief Counts the next bytes of the file.
+   */
+  void feed(const char *data, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+      if (data[i] != '\n') continue;
+      m_record.m_newlines++;
+      if (m_record.m_newlines % m_record.m_stride) continue;
+      if (m_record.m_count == CAPACITY) compact();
+      if (0 == m_record.m_newlines % m_record.m_stride) {
+        m_record.m_marks[m_record.m_count++] = m_record.m_size + i + 1;
+      }
+    }
+    if (size) {
+      m_record.m_size += size;
+      m_record.m_open = (data[size - 1] != '\n');
+    }
+  }
+
+  /**
+   * @brief Forgets everything from offset on, back to the checkpoint at or
+   *        before it, so the bytes after it can be fed again.
+   */
+  void rewind(uint32_t offset) {
+    if (offset >= m_record.m_size) return;
+    while (m_record.m_count && m_record.m_marks[m_record.m_count - 1] > offset) {
+      m_record.m_count--;
+    }
+    m_record.m_newlines = m_record.m_count * m_record.m_stride;
+    m_record.m_size = m_record.m_count ? m_record.m_marks[m_record.m_count - 1] : 0;
+    m_record.m_open = 0;
+  }
+
+  /**
+   * @brief Nearest checkpoint at or before a line.
+   * @param offset Set to where that checkpoint's line starts.
+   * @return The checkpoint's line number.
+   */
+  uint32_t lineBefore(uint32_t line, uint32_t &offset) const {
+    uint32_t k = line / m_record.m_stride;
+    if (k > m_record.m_count) k = m_record.m_count;
+    offset = k ? m_record.m_marks[k - 1] : 0;
+    return k * m_record.m_stride;
+  }
+
+  /**
+   * @brief Nearest checkpoint at or before an offset.
+   * @param from Set to where that checkpoint's line starts.
+   * @return The checkpoint's line number.
+   */
+  uint32_t lineAt(uint32_t offset, uint32_t &from) const {
+    uint32_t lo = 0, hi = m_record.m_count;
+    while (lo < hi) {
+      uint32_t mid = (lo + hi) / 2;
+      if (m_record.m_marks[mid] <= offset) lo = mid + 1;
+      else hi = mid;
+    }
+    from = lo ? m_record.m_marks[lo - 1] : 0;
+    return lo * m_record.m_stride;
+  }
+
+private:
+  void compact() {
+    for (uint16_t i = 0; i < m_record.m_count / 2; i++) {
+      m_record.m_marks[i] = m_record.m_marks[2 * i + 1];
+    }
+    m_record.m_count /= 2;
+    m_record.m_stride *= 2;
+  }
+
+  struct record_t {
+    uint32_t m_size;      ///< bytes counted
+    uint32_t m_newlines;  ///< '\n' among them
+    uint32_t m_stride;    ///< lines between checkpoints
+    uint16_t m_count;     ///< checkpoints held
+    uint8_t m_open;       ///< the last byte counted is not a '\n'
+    uint8_t m_reserved;
+    uint32_t m_marks[CAPACITY]; ///< m_marks[k] is where line (k+1)*stride starts
+  } m_record;
+};
+
+#endif
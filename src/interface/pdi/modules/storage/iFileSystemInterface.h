@@ -86,13 +86,13 @@ public:
      * @brief Reads content from a file.
      * @param path The path of the file to read.
      * @param size The maximum number of bytes to read in one loop.
-     * @param readbackfn callback function for readback.
+     * @param readbackfn callback function for readback, only called before readFile returns.
      * @param offset Offset from where to read the file content.
      * @param readUntilMatchStr Pointer to the sring match to read until.
      * @param didmatchfound Optional pointer to a boolean that will be set to true if the match string was found.
      * @return The number of bytes read, or -1 on failure.
      */
-    virtual int readFile(const char* path, uint64_t size, pdiutil::function<bool(char *, uint32_t)> readbackfn, uint64_t offset = 0, const char* readUntilMatchStr=nullptr, bool *didmatchfound=nullptr) = 0;
+    virtual int readFile(const char* path, uint64_t size, pdiutil::function_ref<bool(char *, uint32_t)> readbackfn, uint64_t offset = 0, const char* readUntilMatchStr=nullptr, bool *didmatchfound=nullptr) = 0;
 
     /**
      * @brief Find the offset in file if line number given.
@@ -173,17 +173,22 @@ public:
      * @brief Copies a file to a new path.
      * @param sourcePath The path of the source file.
      * @param destPath The path of the destination file.
+     * @param progress Optional, called after every block with the bytes copied
+     *        and the file size. Returning false stops the copy, removes the
+     *        partial destination and fails it with PDI_ERR_ABORTED.
      * @return 0 on success, or a negative error code on failure.
      */
-    virtual pdi_err_t copyFile(const char* sourcePath, const char* destPath) = 0;
+    virtual pdi_err_t copyFile(const char* sourcePath, const char* destPath, CallBackCopyProgressFn progress = nullptr) = 0;
 
     /**
      * @brief Moves a file to a new path.
      * @param oldPath The current path of the file.
      * @param newPath The new path of the file.
+     * @param progress Optional, as for copyFile. Only a move that has to copy
+     *        the bytes reports any; a rename in place is a single step.
      * @return 0 on success, or a negative error code on failure.
      */
-    virtual pdi_err_t moveFile(const char* oldPath, const char* newPath) = 0;
+    virtual pdi_err_t moveFile(const char* oldPath, const char* newPath, CallBackCopyProgressFn progress = nullptr) = 0;
 
     /**
      * @brief Deletes a file.
@@ -395,6 +400,63 @@ public:
      * @return 0 on success, or a negative error code on failure.
      */
     virtual pdi_err_t touch(const char *path) = 0;
+
+    /**
+     * @brief Opens a file for streaming access. The path is resolved and
+     *        checked once here; reads, writes and seeks on the handle then
+     *        carry on from where the last one stopped. Backends without
+     *        handle support refuse every open.
+     * @param path The path of the file to open.
+     * @param flags file_open_flag_t bits, or'd together.
+     * @return A handle >= 0, or a negative error code on failure.
+     */
+    virtual int16_t openFile(const char *path, uint8_t flags) { return PDI_ERR_NOT_SUPPORTED; }
+
+    /**
+     * @brief Reads from the current position of an open file.
+     * @param fd Handle returned by openFile.
+     * @param buffer Buffer to receive the data.
+     * @param size Capacity of the buffer in bytes.
+     * @return The number of bytes read, 0 at end of file, or a negative error code.
+     */
+    virtual int32_t readHandle(int16_t fd, char *buffer, uint32_t size) { return PDI_ERR_NOT_SUPPORTED; }
+
+    /**
+     * @brief Writes at the current position of an open file.
+     * @param fd Handle returned by openFile.
+     * @param buffer The data to write.
+     * @param size The number of bytes to write.
+     * @return The number of bytes written, or a negative error code on failure.
+     */
+    virtual int32_t writeHandle(int16_t fd, const char *buffer, uint32_t size) { return PDI_ERR_NOT_SUPPORTED; }
+
+    /**
+     * @brief Moves the position of an open file. seekHandle(fd, 0, FILE_SEEK_CUR)
+     *        tells the position without moving it.
+     * @param fd Handle returned by openFile.
+     * @param offset Offset from whence.
+     * @param whence Where the offset counts from.
+     * @return The new position, or a negative error code on failure.
+     */
+    virtual int64_t seekHandle(int16_t fd, int64_t offset, file_seek_t whence = FILE_SEEK_SET) { return PDI_ERR_NOT_SUPPORTED; }
+
+    /**
+     * @brief Closes an open file, committing what was written to it.
+     * @param fd Handle returned by openFile, stale once this returns.
+     * @return 0 on success, or a negative error code on failure.
+     */
+    virtual pdi_err_t closeFile(int16_t fd) { return PDI_ERR_NOT_SUPPORTED; }
+
+    /**
+     * @brief Keeps a line index with the file (attribute FILE_ATTR_LINES) so
+     *        the line lookups seek near their line rather than scan from the
+     *        start. Appends and writes keep it current once it exists; drop
+     *        it with removeFileAttr. Backends without attributes refuse it.
+     * @param path The path of the file to index.
+     * @param yield Optional callback function to yield control during long operations.
+     * @return 0 on success, or a negative error code on failure.
+     */
+    virtual pdi_err_t indexLines(const char *path, CallBackVoidArgFn yield = nullptr) { return PDI_ERR_NOT_SUPPORTED; }
 protected:
     /**
      * @brief Get current wall-clock time as seconds since Unix epoch, or 0
@@ -418,6 +480,13 @@ protected:
      */
     virtual uint16_t currentUmask() { return 0; }
 
+    /**
+     * @brief Called between the blocks of a copy so a long one does not hold
+     *        the CPU. Default does nothing; the policy layer hands the device
+     *        a turn.
+     */
+    virtual void copyYield() {}
+
     iStorageInterface& m_istorage; ///< Reference to the storage interface used for file operations.
 };
 
@@ -297,16 +297,21 @@ struct FileEditCommand : public CommandBase {
 		// Scan for '\n' ourselves so this works on any backend (some ignore
 		// the readUntilMatchStr argument). Bytes up to the newline form the
 		// line; the newline itself is counted in 'consumed' but not returned.
+		int16_t fd = __i_fs.openFile(m_tmppath.c_str(), FILE_OPEN_READ);
+		if( fd < 0 ) return false;
+		__i_fs.seekHandle(fd, byteOffset);
+
 		pdiutil::string raw;
 		bool foundnl = false;
-		int bytes = __i_fs.readFile(m_tmppath.c_str(), 64, [&](char *d, uint32_t sz)->bool{
-			for( uint32_t i = 0; i < sz; i++ ){
-				if( d[i] == '\n' ){ foundnl = true; return false; }
+		char d[64];
+		int32_t sz;
+		while( !foundnl && (sz = __i_fs.readHandle(fd, d, sizeof(d))) > 0 ){
+			for( int32_t i = 0; i < sz; i++ ){
+				if( d[i] == '\n' ){ foundnl = true; break; }
 				raw.push_back(d[i]);
 			}
-			return true;
-		}, byteOffset);
-		if( bytes < 0 ) return false;
+		}
+		__i_fs.closeFile(fd);
 
 		hadEOL = foundnl;
 		consumed = (uint32_t)raw.size() + (foundnl ? 1 : 0);
@@ -323,11 +328,14 @@ struct FileEditCommand : public CommandBase {
 		uint32_t windowStart = (offset > FWRITE_BACKSCAN) ? (offset - FWRITE_BACKSCAN) : 0;
 		uint32_t want = offset - windowStart;
 		pdiutil::string buf;
-		__i_fs.readFile(m_tmppath.c_str(), 64, [&](char *d, uint32_t sz)->bool{
-			buf.append(d, sz);
-			return buf.size() < want;
-		}, windowStart);
-		if( (uint32_t)buf.size() > want ) buf.resize(want);
+		int16_t fd = __i_fs.openFile(m_tmppath.c_str(), FILE_OPEN_READ);
+		if( fd >= 0 ){
+			buf.resize(want);
+			__i_fs.seekHandle(fd, windowStart);
+			int32_t got = __i_fs.readHandle(fd, &buf[0], want);
+			buf.resize(got > 0 ? (uint32_t)got : 0);
+			__i_fs.closeFile(fd);
+		}
 
 		// buf == file[windowStart, offset); last char is the previous line's '\n'.
 		if( buf.empty() ) return 0;
@@ -343,27 +351,34 @@ struct FileEditCommand : public CommandBase {
 		pdiutil::string scratch = m_tmppath;
 		scratch += ".e";
 		if( __i_fs.isFileExist(scratch.c_str()) ) __i_fs.deleteFile(scratch.c_str());
-		if( __i_fs.createFile(scratch.c_str(), "") < 0 ) return;
-
-		if( spliceStart > 0 ){
-			uint32_t copied = 0;
-			__i_fs.readFile(m_tmppath.c_str(), 128, [&](char *d, uint32_t sz)->bool{
-				uint32_t take = sz;
-				if( copied + take > spliceStart ) take = spliceStart - copied;
-				if( take ) __i_fs.writeFile(scratch.c_str(), d, take, true);
-				copied += take;
-				return copied < spliceStart;
-			}, 0);
+
+		// One handle on each file for the whole splice rather than an open per piece.
+		int16_t src = __i_fs.openFile(m_tmppath.c_str(), FILE_OPEN_READ);
+		if( src < 0 ) return;
+		int16_t dst = __i_fs.openFile(scratch.c_str(), FILE_OPEN_WRITE | FILE_OPEN_CREATE | FILE_OPEN_TRUNC);
+		if( dst < 0 ){ __i_fs.closeFile(src); return; }
+
+		char d[128];
+		int32_t sz;
+		uint32_t copied = 0;
+		while( copied < spliceStart ){
+			uint32_t take = spliceStart - copied;
+			if( take > sizeof(d) ) take = sizeof(d);
+			if( (sz = __i_fs.readHandle(src, d, take)) <= 0 ) break;
+			__i_fs.writeHandle(dst, d, sz);
+			copied += sz;
 		}
 
 		if( insertData && insertLen ){
-			__i_fs.writeFile(scratch.c_str(), insertData, insertLen, true);
+			__i_fs.writeHandle(dst, insertData, insertLen);
 		}
 
-		__i_fs.readFile(m_tmppath.c_str(), 128, [&](char *d, uint32_t sz)->bool{
-			__i_fs.writeFile(scratch.c_str(), d, sz, true);
-			return true;
-		}, spliceEnd);
+		__i_fs.seekHandle(src, spliceEnd);
+		while( (sz = __i_fs.readHandle(src, d, sizeof(d))) > 0 ){
+			__i_fs.writeHandle(dst, d, sz);
+		}
+		__i_fs.closeFile(src);
+		__i_fs.closeFile(dst);
 
 		__i_fs.deleteFile(m_tmppath.c_str());
 		__i_fs.rename(scratch.c_str(), m_tmppath.c_str());
@@ -217,6 +217,17 @@ bool DatabaseServiceProvider::get_mqtt_pubsub_config_table(mqtt_pubsub_config_ta
 {
   return __mqtt_pubsub_table.get(_table);
 }
+
+/**
+ * read-only view of the mqtt pubsub config table, for the publish and
+ * subscribe cycles that read it on every interval.
+ *
+ * @return table, or nullptr when it is not registered
+ */
+const mqtt_pubsub_config_table *DatabaseServiceProvider::peek_mqtt_pubsub_config_table()
+{
+  return __mqtt_pubsub_table.peek();
+}
 #endif
 
 #ifdef ENABLE_EMAIL_SERVICE
@@ -76,6 +76,7 @@ public:
   bool get_mqtt_general_config_table(mqtt_general_config_table *_table);
   bool get_mqtt_lwt_config_table(mqtt_lwt_config_table *_table);
   bool get_mqtt_pubsub_config_table(mqtt_pubsub_config_table *_table);
+  const mqtt_pubsub_config_table *peek_mqtt_pubsub_config_table();
 #endif
 
 #ifdef ENABLE_EMAIL_SERVICE
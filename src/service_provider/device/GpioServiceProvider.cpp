@@ -165,21 +165,70 @@ bool GpioServiceProvider::handleGpioHttpRequest( bool isEventPost ){
 #endif
 
 /**
- * append gpio payload to string arg
- *
- * @param pdiutil::string& _payload
+ * where the gpio json payload goes: the end of a string
  */
-void GpioServiceProvider::appendGpioJsonPayload( pdiutil::string &_payload, bool isEventPost, pdiutil::vector<pdiutil::string> *allowedlist ){
+class GpioPayloadString
+{
+public:
+  GpioPayloadString( pdiutil::string &_payload ): m_payload(_payload){}
+
+  void put( const char *_text ){ this->m_payload += _text; }
+  void put( uint32_t _number ){ this->m_payload += pdiutil::to_string(_number); }
+  void unput( void ){ this->m_payload.pop_back(); }
+
+protected:
+  pdiutil::string &m_payload;
+};
+
+/**
+ * where the gpio json payload goes: a fixed buffer, written in place and
+ * marked as overflowed once it runs out
+ */
+class GpioPayloadBuffer
+{
+public:
+  GpioPayloadBuffer( char *_out, uint16_t _size ): m_out(_out), m_size(_size), m_used(0), m_overflow(false){}
+
+  void put( const char *_text ){
+    uint16_t _len = strlen(_text);
+    if( _len > this->m_size - this->m_used ){
+      this->m_overflow = true;
+      return;
+    }
+    memcpy( this->m_out + this->m_used, _text, _len );
+    this->m_used += _len;
+  }
+  void put( uint32_t _number ){
+    char _digits[12];
+    Uint32ToString( _number, _digits, sizeof(_digits) );
+    this->put( (const char*)_digits );
+  }
+  void unput( void ){ if( this->m_used > 0 ) this->m_used--; }
+
+  int32_t length( void ) const { return this->m_overflow ? PDI_ERR_OVERFLOW : this->m_used; }
+
+protected:
+  char *m_out;
+  uint16_t m_size;
+  uint16_t m_used;
+  bool m_overflow;
+};
 
-  _payload += "{";
+/**
+ * build the gpio json payload into the sink
+ */
+template <typename T>
+void GpioServiceProvider::buildGpioJsonPayload( T &_sink, bool isEventPost, pdiutil::vector<pdiutil::string> *allowedlist ){
+
+  _sink.put("{");
 
   if( __i_dvc_ctrl.getDeviceMac().size() ){
 
-    _payload += "\"";
-    _payload += CHARPTR_WRAP(GPIO_PAYLOAD_MAC_KEY);
-    _payload += CHARPTR_WRAP("\":\"");
-    _payload += __i_dvc_ctrl.getDeviceMac().c_str();
-    _payload += CHARPTR_WRAP("\",");
+    _sink.put("\"");
+    _sink.put(CHARPTR_WRAP(GPIO_PAYLOAD_MAC_KEY));
+    _sink.put(CHARPTR_WRAP("\":\""));
+    _sink.put(__i_dvc_ctrl.getDeviceMac().c_str());
+    _sink.put(CHARPTR_WRAP("\","));
   }
 
 #ifdef ENABLE_DEVICE_IOT
@@ -187,53 +236,53 @@ void GpioServiceProvider::appendGpioJsonPayload( pdiutil::string &_payload, bool
   const char* _duid = __device_iot_service.getDeviceId();
   if( _duid && _duid[0] != '\0' ){
 
-    _payload += "\"";
-    _payload += CHARPTR_WRAP(GPIO_PAYLOAD_DUID_KEY);
-    _payload += CHARPTR_WRAP("\":\"");
-    _payload += _duid;
-    _payload += CHARPTR_WRAP("\",");
+    _sink.put("\"");
+    _sink.put(CHARPTR_WRAP(GPIO_PAYLOAD_DUID_KEY));
+    _sink.put(CHARPTR_WRAP("\":\""));
+    _sink.put(_duid);
+    _sink.put(CHARPTR_WRAP("\","));
   }
 #endif
 
 #ifndef ENABLE_GPIO_BASIC_ONLY
   if( isEventPost ){
 
-    _payload += "\"";
-    _payload += CHARPTR_WRAP(GPIO_EVENT_PIN_KEY);
-    _payload += CHARPTR_WRAP("\":\"");
+    _sink.put("\"");
+    _sink.put(CHARPTR_WRAP(GPIO_EVENT_PIN_KEY));
+    _sink.put(CHARPTR_WRAP("\":\""));
 
     if( __gpio_event_track.event_gpio_pin < MAX_DIGITAL_GPIO_PINS ){
-      _payload += "D";
-      _payload += pdiutil::to_string(__gpio_event_track.event_gpio_pin);
+      _sink.put("D");
+      _sink.put((uint32_t)__gpio_event_track.event_gpio_pin);
     }else{
-      _payload += "A";
-      _payload += pdiutil::to_string(__gpio_event_track.event_gpio_pin - MAX_DIGITAL_GPIO_PINS);
+      _sink.put("A");
+      _sink.put((uint32_t)(__gpio_event_track.event_gpio_pin - MAX_DIGITAL_GPIO_PINS));
     }
 
-    _payload += CHARPTR_WRAP("\",");
+    _sink.put(CHARPTR_WRAP("\","));
   }
 #endif
 
-  _payload += "\"";
-  _payload += CHARPTR_WRAP(GPIO_PAYLOAD_DATA_KEY);
-  _payload += CHARPTR_WRAP("\":{");
+  _sink.put("\"");
+  _sink.put(CHARPTR_WRAP(GPIO_PAYLOAD_DATA_KEY));
+  _sink.put(CHARPTR_WRAP("\":{"));
 
   bool _remove_comma = false;
   for (uint8_t _pin = 0; _pin < MAX_DIGITAL_GPIO_PINS; _pin++) {
 
     if( !__i_dvc_ctrl.isExceptionalGpio(_pin) && this->isAllowedGpioPin(_pin, allowedlist) ){
 
-      _payload += "\"D";
-      _payload += pdiutil::to_string(_pin);
-      _payload += CHARPTR_WRAP("\":{\"");
-      _payload += CHARPTR_WRAP(GPIO_PAYLOAD_MODE_KEY);
-      _payload += CHARPTR_WRAP("\":");
-      _payload += pdiutil::to_string(this->m_gpio_config_copy.gpio_mode[_pin]);
-      _payload += CHARPTR_WRAP(",\"");
-      _payload += CHARPTR_WRAP(GPIO_PAYLOAD_VALUE_KEY);
-      _payload += CHARPTR_WRAP("\":");
-      _payload += pdiutil::to_string(this->m_gpio_config_copy.gpio_readings[_pin]);
-      _payload += CHARPTR_WRAP("},");
+      _sink.put("\"D");
+      _sink.put((uint32_t)_pin);
+      _sink.put(CHARPTR_WRAP("\":{\""));
+      _sink.put(CHARPTR_WRAP(GPIO_PAYLOAD_MODE_KEY));
+      _sink.put(CHARPTR_WRAP("\":"));
+      _sink.put((uint32_t)this->m_gpio_config_copy.gpio_mode[_pin]);
+      _sink.put(CHARPTR_WRAP(",\""));
+      _sink.put(CHARPTR_WRAP(GPIO_PAYLOAD_VALUE_KEY));
+      _sink.put(CHARPTR_WRAP("\":"));
+      _sink.put((uint32_t)this->m_gpio_config_copy.gpio_readings[_pin]);
+      _sink.put(CHARPTR_WRAP("},"));
 
       _remove_comma = true;
     }
@@ -243,27 +292,52 @@ void GpioServiceProvider::appendGpioJsonPayload( pdiutil::string &_payload, bool
 
     if( !__i_dvc_ctrl.isExceptionalGpio(MAX_DIGITAL_GPIO_PINS+_pin) && this->isAllowedGpioPin(MAX_DIGITAL_GPIO_PINS+_pin, allowedlist) ){
 
-      _payload += "\"A";
-      _payload += pdiutil::to_string(_pin);
-      _payload += CHARPTR_WRAP("\":{\"");
-      _payload += CHARPTR_WRAP(GPIO_PAYLOAD_MODE_KEY);
-      _payload += CHARPTR_WRAP("\":");
-      _payload += pdiutil::to_string(this->m_gpio_config_copy.gpio_mode[MAX_DIGITAL_GPIO_PINS+_pin]);
-      _payload += CHARPTR_WRAP(",\"");
-      _payload += CHARPTR_WRAP(GPIO_PAYLOAD_VALUE_KEY);
-      _payload += CHARPTR_WRAP("\":");
-      _payload += pdiutil::to_string(this->m_gpio_config_copy.gpio_readings[MAX_DIGITAL_GPIO_PINS+_pin]);
-      _payload += CHARPTR_WRAP("},");
+      _sink.put("\"A");
+      _sink.put((uint32_t)_pin);
+      _sink.put(CHARPTR_WRAP("\":{\""));
+      _sink.put(CHARPTR_WRAP(GPIO_PAYLOAD_MODE_KEY));
+      _sink.put(CHARPTR_WRAP("\":"));
+      _sink.put((uint32_t)this->m_gpio_config_copy.gpio_mode[MAX_DIGITAL_GPIO_PINS+_pin]);
+      _sink.put(CHARPTR_WRAP(",\""));
+      _sink.put(CHARPTR_WRAP(GPIO_PAYLOAD_VALUE_KEY));
+      _sink.put(CHARPTR_WRAP("\":"));
+      _sink.put((uint32_t)this->m_gpio_config_copy.gpio_readings[MAX_DIGITAL_GPIO_PINS+_pin]);
+      _sink.put(CHARPTR_WRAP("},"));
 
       _remove_comma = true;
     }
   }
 
   if( _remove_comma ){
-    _payload.pop_back(); // remove last comma
+    _sink.unput(); // remove last comma
   }
 
-  _payload += CHARPTR_WRAP("}}");
+  _sink.put(CHARPTR_WRAP("}}"));
+}
+
+/**
+ * append gpio payload to string arg
+ *
+ * @param pdiutil::string& _payload
+ */
+void GpioServiceProvider::appendGpioJsonPayload( pdiutil::string &_payload, bool isEventPost, pdiutil::vector<pdiutil::string> *allowedlist ){
+
+  GpioPayloadString _sink(_payload);
+  this->buildGpioJsonPayload( _sink, isEventPost, allowedlist );
+}
+
+/**
+ * write gpio payload into a buffer, without a string in between
+ *
+ * @param char* _out
+ * @param uint16_t _size
+ * @return int32_t bytes written, PDI_ERR_OVERFLOW when they do not fit
+ */
+int32_t GpioServiceProvider::writeGpioJsonPayload( char *_out, uint16_t _size, bool isEventPost, pdiutil::vector<pdiutil::string> *allowedlist ){
+
+  GpioPayloadBuffer _sink(_out, _size);
+  this->buildGpioJsonPayload( _sink, isEventPost, allowedlist );
+  return _sink.length();
 }
 
 /**
@@ -42,6 +42,7 @@ public:
   void enable_update_gpio_table_from_copy(void);
   bool isAllowedGpioPin(uint8_t _pin, pdiutil::vector<pdiutil::string> *allowedlist);
   void appendGpioJsonPayload(pdiutil::string &_payload, bool isEventPost = false, pdiutil::vector<pdiutil::string> *allowedlist = nullptr);
+  int32_t writeGpioJsonPayload(char *_out, uint16_t _size, bool isEventPost = false, pdiutil::vector<pdiutil::string> *allowedlist = nullptr);
   void applyGpioJsonPayload(char *_payload, uint16_t _payload_length, pdiutil::vector<pdiutil::string> *allowedlist = nullptr);
   #ifndef ENABLE_GPIO_BASIC_ONLY
   void applyGpioEventJsonPayload(char *_payload, uint16_t _payload_length, pdiutil::vector<pdiutil::string> *allowedlist = nullptr);
@@ -75,6 +76,9 @@ public:
 
 protected:
 
+  template <typename T>
+  void buildGpioJsonPayload(T &_sink, bool isEventPost, pdiutil::vector<pdiutil::string> *allowedlist);
+
 #ifdef ENABLE_HTTP_CLIENT
   /**
    * @var	Http_Client  *m_http_client
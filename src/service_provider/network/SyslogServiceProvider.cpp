@@ -15,6 +15,7 @@ created Date    : 26th July 2026
 #include <interface/pdi/impl/modules/storage/VfsDispatcher.h>
 #include <interface/pdi/middlewares/iNtpInterface.h>
 #include <utility/DataTypeConversions.h>
+#include <utility/TaskScheduler.h>
 
 #ifdef ENABLE_SYSLOG_FORWARD
 #include <interface/pdi/middlewares/iUdpInterface.h>
@@ -22,20 +23,45 @@ created Date    : 26th July 2026
 #include <utility/EventUtil.h>
 #endif
 
-// guards against re-entry (an FS/socket-path log must not recurse into the sink)
+// guards against re-entry (a socket-path log must not recurse into the sink)
 static bool s_syslog_busy = false;
 
+// guards drain on its own: a line logged while the file is written, an FS
+// error included, is queued behind the ones going out, push only moves the
+// head and drain only the tail
+static bool s_syslog_draining = false;
+
+// a queued line: length (2), type (1) and epoch (4) ahead of its bytes
+static const uint16_t SYSLOG_RECORD_HEADER = 7;
+
 SyslogServiceProvider::SyslogServiceProvider() : ServiceProvider(SERVICE_SYSLOG, "SYSLOG")
+  , m_head(0)
+  , m_tail(0)
+  , m_drain_task(-1)
+  , m_fd(-1)
+  , m_fd_type(INFO_LOG)
+  , m_fd_size(0)
+  , m_batch(nullptr)
+  , m_batch_cap(0)
+  , m_batch_len(0)
 #ifdef ENABLE_SYSLOG_FORWARD
   , m_udp(nullptr)
   , m_port(SYSLOG_REMOTE_PORT)
   , m_resolved(false)
 #endif
 {
+  memset(&m_stats, 0, sizeof(m_stats));
 }
 
 SyslogServiceProvider::~SyslogServiceProvider() {
-  stopService();
+  // the log manager and the filesystem may already be gone at static
+  // teardown, so only what this service holds itself is let go here
+#ifdef ENABLE_SYSLOG_FORWARD
+  if (nullptr != m_udp) {
+    m_udp->close();
+    pdiutil::safe_delete(m_udp);
+  }
+#endif
 }
 
 bool SyslogServiceProvider::initService(void *arg) {
@@ -63,6 +89,7 @@ bool SyslogServiceProvider::initService(void *arg) {
 bool SyslogServiceProvider::stopService() {
 
   __log_manager.setSyslogSink(nullptr);
+  flush();
 
 #ifdef ENABLE_SYSLOG_FORWARD
   if (nullptr != m_udp) {
@@ -81,10 +108,22 @@ void SyslogServiceProvider::sink(logger_type_t log_type, const char *line, uint1
 
 void SyslogServiceProvider::handleLine(logger_type_t log_type, const char *line, uint16_t len) {
 
-  if (s_syslog_busy || nullptr == line || 0 == len) return;
+  if (nullptr == line || 0 == len) return;
+  if (s_syslog_busy) {
+    m_stats.m_dropped++;
+    return;
+  }
   s_syslog_busy = true;
+  if (len >= SYSLOG_LINE_MAX) len = SYSLOG_LINE_MAX - 1;
 
-  writeToFile(log_type, line, len);
+  // the line is stamped now, however long it waits for the file
+  uint32_t epoch = __i_ntp.is_valid_ntptime() ? (uint32_t)__i_ntp.get_ntp_time() : 0;
+  if (push(log_type, epoch, line, len) && m_drain_task < 0) {
+    m_drain_task = __task_scheduler.setTimeout([]() {
+      __syslog_service.m_drain_task = -1;
+      __syslog_service.drain();
+    }, SYSLOG_FLUSH_DELAY, __i_dvc_ctrl.millis_now(), DEFAULT_TASK_PRIORITY, RODT_ATTR("syslog"));
+  }
 #ifdef ENABLE_SYSLOG_FORWARD
   forward(log_type, line, len);
 #endif
@@ -92,6 +131,15 @@ void SyslogServiceProvider::handleLine(logger_type_t log_type, const char *line,
   s_syslog_busy = false;
 }
 
+void SyslogServiceProvider::flush() {
+
+  if (m_drain_task >= 0) {
+    __task_scheduler.clearTimeout(m_drain_task);
+    m_drain_task = -1;
+  }
+  drain();
+}
+
 const char *SyslogServiceProvider::fileForType(logger_type_t type) {
   switch (type) {
     case ERROR_LOG:   return SYSLOG_FILE_ERROR;
@@ -102,52 +150,194 @@ const char *SyslogServiceProvider::fileForType(logger_type_t type) {
   }
 }
 
-void SyslogServiceProvider::writeToFile(logger_type_t type, const char *line, uint16_t len) {
+void SyslogServiceProvider::ringIn(uint32_t at, const void *src, uint16_t len) {
+
+  uint32_t from = at & (SYSLOG_RING_SIZE - 1);
+  uint32_t first = SYSLOG_RING_SIZE - from;
+  if (first > len) first = len;
+  memcpy(m_ring + from, src, first);
+  memcpy(m_ring, (const uint8_t *)src + first, len - first);
+}
+
+void SyslogServiceProvider::ringOut(uint32_t at, void *dst, uint16_t len) {
+
+  uint32_t from = at & (SYSLOG_RING_SIZE - 1);
+  uint32_t first = SYSLOG_RING_SIZE - from;
+  if (first > len) first = len;
+  memcpy(dst, m_ring + from, first);
+  memcpy((uint8_t *)dst + first, m_ring, len - first);
+}
+
+bool SyslogServiceProvider::push(logger_type_t type, uint32_t epoch, const char *line, uint16_t len) {
+
+  uint32_t head = m_head;
+  if (SYSLOG_RING_SIZE - (head - m_tail) < (uint32_t)SYSLOG_RECORD_HEADER + len) {
+    m_stats.m_dropped++;
+    return false;
+  }
+
+  uint8_t header[SYSLOG_RECORD_HEADER];
+  header[0] = (uint8_t)(len & 0xFF);
+  header[1] = (uint8_t)(len >> 8);
+  header[2] = (uint8_t)type;
+  memcpy(header + 3, &epoch, sizeof(epoch));
+  ringIn(head, header, SYSLOG_RECORD_HEADER);
+  ringIn(head + SYSLOG_RECORD_HEADER, line, len);
+
+  // publish only once the record is whole
+  m_head = head + SYSLOG_RECORD_HEADER + len;
+  m_stats.m_queued++;
+  return true;
+}
+
+void SyslogServiceProvider::drain() {
+
+  if (s_syslog_draining || m_tail == m_head) return;
+  s_syslog_draining = true;
 
-  // ensure the log directory once (storage is mounted before this service inits)
+  // ensure the log directory (storage is mounted before this service inits)
   if (!__i_fs.isDirExist(SYSLOG_DIR)) {
     __i_fs.createDirectory(SYSLOG_DIR);
   }
 
-  const char *path = fileForType(type);
-  // append while under the threshold; once crossed, start the file over
-  int64_t sz = __i_fs.getFileSize(path);
-  bool append = (sz >= 0 && sz < SYSLOG_FILE_MAX_SIZE);
+  // gather writes in a heap batch, or a small stack one when the heap is short
+  char fallback[64];
+  char *batch = pdiutil::safe_new_array<char>(SYSLOG_WRITE_BATCH);
+  m_batch = (nullptr != batch) ? batch : fallback;
+  m_batch_cap = (nullptr != batch) ? SYSLOG_WRITE_BATCH : sizeof(fallback);
+  m_batch_len = 0;
+
+  // only what was queued on entry, so lines the writes themselves log wait
+  // for the next drain rather than keeping this one going
+  uint32_t head = m_head;
+  char line[SYSLOG_LINE_MAX];
+  while (m_tail != head) {
+    uint32_t tail = m_tail;
+    uint8_t header[SYSLOG_RECORD_HEADER];
+    ringOut(tail, header, SYSLOG_RECORD_HEADER);
+    uint16_t len = (uint16_t)(header[0] | (header[1] << 8));
+    uint32_t epoch;
+    memcpy(&epoch, header + 3, sizeof(epoch));
+    ringOut(tail + SYSLOG_RECORD_HEADER, line, len);
+
+    // the copy is out, so the producer may have the room back
+    m_tail = tail + SYSLOG_RECORD_HEADER + len;
+    writeLine((logger_type_t)header[2], epoch, line, len);
+  }
+  closeLog();
+
+  pdiutil::safe_delete_array(batch);
+  m_batch = nullptr;
+  s_syslog_draining = false;
+}
+
+void SyslogServiceProvider::writeLine(logger_type_t type, uint32_t epoch, const char *line, uint16_t len) {
 
   // one timestamp for this entry (NTP-backed; dashes when the clock is unsynced)
   char ts[24];
-  uint32_t epoch = __i_ntp.is_valid_ntptime() ? (uint32_t)__i_ntp.get_ntp_time() : 0;
   EpochToDateTimeString(epoch, ts, sizeof(ts), SYSLOG_FILE_TS_FMT);
   uint16_t tslen = (uint16_t)strlen(ts);
 
   // stamp the start of every line: prefix the entry, re-prefix after each
   // embedded newline, and make sure it ends on its own line
-  uint16_t nl = 0;
-  for (uint16_t i = 0; i < len; i++) if ('\n' == line[i]) nl++;
-  uint32_t outcap = (uint32_t)len + (uint32_t)(nl + 1) * tslen + 2;
+  uint32_t outlen = len;
+  bool at_line_start = true;
+  for (uint16_t i = 0; i < len; i++) {
+    if (at_line_start && '\n' != line[i]) outlen += tslen;
+    at_line_start = ('\n' == line[i]);
+  }
+  if ('\n' != line[len - 1]) outlen++;
 
-  char *out = pdiutil::safe_new_array<char>(outcap);
-  if (nullptr == out) {                        // low heap — write the raw line
-    __i_fs.writeFile(path, line, len, append);
-    return;
+  if (m_fd < 0 || m_fd_type != type) {
+    closeLog();
+    if (!openLog(type)) {
+      m_stats.m_failed++;
+      return;
+    }
+  }
+  if (m_fd_size > 0 && m_fd_size + outlen > SYSLOG_FILE_MAX_SIZE) {
+    closeLog();
+    rotate(type);
+    if (!openLog(type)) {
+      m_stats.m_failed++;
+      return;
+    }
   }
 
-  uint32_t o = 0;
-  bool at_line_start = true;
+  at_line_start = true;
   for (uint16_t i = 0; i < len; i++) {
     char c = line[i];
     if (at_line_start && '\n' != c) {
-      memcpy(out + o, ts, tslen);
-      o += tslen;
+      for (uint16_t t = 0; t < tslen; t++) {
+        if (m_batch_len == m_batch_cap) commit();
+        m_batch[m_batch_len++] = ts[t];
+      }
       at_line_start = false;
     }
-    out[o++] = c;
+    if (m_batch_len == m_batch_cap) commit();
+    m_batch[m_batch_len++] = c;
     if ('\n' == c) at_line_start = true;
   }
-  if (0 == o || '\n' != out[o - 1]) out[o++] = '\n';
+  if ('\n' != line[len - 1]) {
+    if (m_batch_len == m_batch_cap) commit();
+    m_batch[m_batch_len++] = '\n';
+  }
+
+  m_fd_size += outlen;
+  m_stats.m_written++;
+}
+
+bool SyslogServiceProvider::openLog(logger_type_t type) {
+
+  m_fd = __i_fs.openFile(fileForType(type), FILE_OPEN_WRITE | FILE_OPEN_CREATE | FILE_OPEN_APPEND);
+  if (m_fd < 0) return false;
+
+  int64_t size = __i_fs.seekHandle(m_fd, 0, FILE_SEEK_END);
+  m_fd_size = (size > 0) ? (uint32_t)size : 0;
+  m_fd_type = type;
+  return true;
+}
+
+void SyslogServiceProvider::commit() {
+
+  if (0 == m_batch_len) return;
+  if (m_fd >= 0) {
+    int32_t n = __i_fs.writeHandle(m_fd, m_batch, m_batch_len);
+    if (n > 0) m_stats.m_bytes += (uint32_t)n;
+  }
+  m_batch_len = 0;
+}
 
-  __i_fs.writeFile(path, out, (uint32_t)o, append);
-  pdiutil::safe_delete_array(out);
+void SyslogServiceProvider::closeLog() {
+
+  commit();
+  if (m_fd >= 0) {
+    __i_fs.closeFile(m_fd);
+    m_fd = -1;
+  }
+}
+
+void SyslogServiceProvider::rotate(logger_type_t type) {
+
+  const char *path = fileForType(type);
+  m_stats.m_rotations++;
+  if (0 == SYSLOG_ROTATE_COUNT) {
+    __i_fs.deleteFile(path);
+    return;
+  }
+
+  // shift each generation up one, letting the oldest fall off the end
+  pdiutil::string base(path);
+  pdiutil::string to = base + "." + pdiutil::to_string(SYSLOG_ROTATE_COUNT);
+  __i_fs.deleteFile(to.c_str());
+  for (int k = SYSLOG_ROTATE_COUNT; k > 1; k--) {
+    pdiutil::string from = base + "." + pdiutil::to_string(k - 1);
+    if (__i_fs.isFileExist(from.c_str())) {
+      __i_fs.rename(from.c_str(), to.c_str());
+    }
+    to = from;
+  }
+  __i_fs.rename(path, to.c_str());
 }
 
 #ifdef ENABLE_SYSLOG_FORWARD
@@ -233,6 +423,13 @@ void SyslogServiceProvider::printStatusToTerminal(iTerminalInterface *terminal)
   terminal->write_ro(RODT_ATTR("  logdir    : "));
   terminal->writeln_ro(RODT_ATTR(SYSLOG_DIR));
 
+  terminal->write_ro(RODT_ATTR("  written   : "));
+  terminal->writeln((int32_t)m_stats.m_written);
+  terminal->write_ro(RODT_ATTR("  dropped   : "));
+  terminal->writeln((int32_t)m_stats.m_dropped);
+  terminal->write_ro(RODT_ATTR("  pending   : "));
+  terminal->writeln((int32_t)pending());
+
 #ifdef ENABLE_SYSLOG_FORWARD
   terminal->write_ro(RODT_ATTR("  collector : "));
   if (m_host.length() > 0) {
@@ -19,12 +19,28 @@ created Date    : 26th July 2026
  * SyslogServiceProvider class
  *
  * The sink behind every SysLog* line. LogManager assembles a line, echoes it to
- * the console, then hands it here; this service persists it to
- * /var/log/syslog.<type> (append with truncate-at-size rotation). When
+ * the console, then hands it here; this service queues it in a ring and a
+ * scheduler task appends the queued lines to /var/log/syslog.<type> in
+ * batches, one open per file per pass, rotating a file to syslog.<type>.1,
+ * .2, ... before it crosses SYSLOG_FILE_MAX_SIZE. The caller never waits on
+ * the filesystem; a line the ring has no room for is dropped and counted. When
  * ENABLE_SYSLOG_FORWARD is set it additionally ships the same line to a remote
  * collector as an RFC 3164 datagram over UDP (built on iUdpInterface, no vendor
  * library); the collector is (re)resolved via NameResolver on station-got-IP.
  */
+/**
+ * counters behind /proc/syslog, since boot
+ */
+struct syslog_stats_t
+{
+  uint32_t m_queued;    ///< lines taken into the ring
+  uint32_t m_dropped;   ///< lines the ring had no room for
+  uint32_t m_written;   ///< lines appended to a file
+  uint32_t m_failed;    ///< lines lost to a file that would not open or write
+  uint32_t m_bytes;     ///< bytes appended to the files
+  uint32_t m_rotations; ///< files rotated
+};
+
 class SyslogServiceProvider : public ServiceProvider
 {
 
@@ -36,16 +52,52 @@ public:
   bool stopService() override;
   void printStatusToTerminal(iTerminalInterface *terminal) override;
 
-  /* persist one assembled syslog line to file (and forward it when enabled) */
+  /* queue one assembled syslog line for the file (and forward it when enabled) */
   void handleLine(logger_type_t log_type, const char *line, uint16_t len);
 
+  /* write out every queued line now rather than when the task comes round */
+  void flush();
+
+  const syslog_stats_t &stats() const { return m_stats; }
+
+  /* bytes waiting in the ring */
+  uint32_t pending() const { return m_head - m_tail; }
+
 protected:
   /* LogManager sink adapter — delegates to the singleton */
   static void sink(logger_type_t log_type, const char *line, uint16_t len);
 
-  void writeToFile(logger_type_t log_type, const char *line, uint16_t len);
   const char *fileForType(logger_type_t log_type);
 
+  /* the ring. handleLine is its only producer and drain its only consumer;
+     each moves only its own index, so neither needs the other to stop */
+  bool push(logger_type_t log_type, uint32_t epoch, const char *line, uint16_t len);
+  void ringIn(uint32_t at, const void *src, uint16_t len);
+  void ringOut(uint32_t at, void *dst, uint16_t len);
+  void drain();
+
+  /* the file a drain is appending to */
+  void writeLine(logger_type_t log_type, uint32_t epoch, const char *line, uint16_t len);
+  bool openLog(logger_type_t log_type);
+  void closeLog();
+  void commit();
+  void rotate(logger_type_t log_type);
+
+  // ringIn and ringOut wrap positions with a mask rather than a division
+  static_assert((SYSLOG_RING_SIZE & (SYSLOG_RING_SIZE - 1)) == 0, "SYSLOG_RING_SIZE must be a power of two");
+  uint8_t            m_ring[SYSLOG_RING_SIZE];
+  volatile uint32_t  m_head;
+  volatile uint32_t  m_tail;
+  pdiutil::task_id_t m_drain_task;
+  syslog_stats_t     m_stats;
+
+  int16_t            m_fd;
+  logger_type_t      m_fd_type;
+  uint32_t           m_fd_size;
+  char              *m_batch;
+  uint16_t           m_batch_cap;
+  uint16_t           m_batch_len;
+
 #ifdef ENABLE_SYSLOG_FORWARD
   bool ensureSocket(void);
   bool resolveCollector(void);
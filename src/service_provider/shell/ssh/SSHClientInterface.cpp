@@ -77,7 +77,7 @@ int8_t SSHClientInterface::connected(){
  * @return The number of bytes written, or 0 on failure.
  */
 int32_t SSHClientInterface::write(const uint8_t* c_str, uint32_t size){
-    if(m_tcpClient && m_client_session && m_client_session->current_channel.ischannelreqsuccess > 1){
+    if(m_tcpClient && m_client_session && m_channel && m_channel->ischannelreqsuccess > 1){
 
 
         m_written_data.insert(m_written_data.end(), c_str, c_str+size);
@@ -85,7 +85,7 @@ int32_t SSHClientInterface::write(const uint8_t* c_str, uint32_t size){
         int32_t datasize = m_written_data.size();
         if( datasize > (0.75*m_minSizeToWritePayload) ){
 
-            if(send_channel_data(m_client_session, (const char*)m_written_data.data(), datasize)){
+            if(send_channel_data(m_client_session, m_channel, (const char*)m_written_data.data(), datasize)){
                 m_written_data.clear();
                 return size;
             }
@@ -280,7 +280,7 @@ int32_t SSHClientInterface::commit(){
     int32_t datasize = m_written_data.size();
     if( datasize > 0 && m_client_session ){
 
-        if(send_channel_data(m_client_session, (const char*)m_written_data.data(), datasize)){
+        if(send_channel_data(m_client_session, m_channel, (const char*)m_written_data.data(), datasize)){
         }
         m_written_data.clear();
         return datasize;
@@ -17,6 +17,7 @@ namespace LWSSH {
 
 // forward declaration
 struct LWSSHSession;    
+struct SSHChannel;
 
 /**
  * SSH Client interface to interact with client over channel data packets.
@@ -29,6 +30,7 @@ public:
     SSHClientInterface(iTcpClientInterface* tcpclient) : 
         m_tcpClient(tcpclient), 
         m_client_session(nullptr),
+        m_channel(nullptr),
         m_minSizeToWritePayload(1024),
         m_writeCommitTaskId(-1)
     {}
@@ -36,6 +38,7 @@ public:
     // Destructor
     ~SSHClientInterface(){
         m_client_session = nullptr;
+        m_channel = nullptr;
         m_tcpClient = nullptr;
         __task_scheduler.clearTimeout(m_writeCommitTaskId);
     }
@@ -182,11 +185,26 @@ public:
         m_client_session = session;
     }
 
+    /** 
+     * @brief set the session channel the terminal runs on, nullptr when none
+     */
+    void setSSHChannel(SSHChannel* channel){
+        m_channel = channel;
+    }
+
+    /** 
+     * @brief get the session channel the terminal runs on
+     */
+    SSHChannel* getSSHChannel() const{
+        return m_channel;
+    }
+
 private:
     pdiutil::vector<uint8_t> m_received_data;
     pdiutil::vector<uint8_t> m_written_data;
     iTcpClientInterface* m_tcpClient;
     LWSSHSession* m_client_session;
+    SSHChannel* m_channel;
     uint32_t m_minSizeToWritePayload;
     pdiutil::task_id_t m_writeCommitTaskId;
 };
@@ -99,7 +99,7 @@ int LWSSH::parse_encrypted_packet(LWSSHSession* session, ssh_packet &packet) {
     }
 
     // take header part to get packet length
-    pdiutil::vector<uint8_t> header;
+    pdiutil::small_vector<uint8_t, 4> header;
     for (uint32_t i = 0; i < 4; ++i) {
         header.push_back(session->m_client->read());
         __i_dvc_ctrl.yield();
@@ -118,18 +118,44 @@ int LWSSH::parse_encrypted_packet(LWSSHSession* session, ssh_packet &packet) {
         packetvec.push_back(header[i]);
     }
 
+    // With several channels open only channel data for the channel that asked
+    // for bolus chunks goes that way. The first cipher block holds the message
+    // type and recipient, so decrypt a copy of it to see where the packet is for.
+    SSHChannel *boluschannel = nullptr;
+    for (uint8_t i = 0; i < SSH_MAX_CHANNELS; ++i) {
+        if (session->m_channels[i].in_use && session->m_channels[i].doHandleBolusChannelDataChunksCb) {
+            boluschannel = &session->m_channels[i];
+            break;
+        }
+    }
+    uint32_t _peekedBytes = 0;
+    if (boluschannel) {
+        for (; _peekedBytes < AES_BLOCKLEN - 4; ++_peekedBytes) {
+            packetvec.push_back(session->m_client->read());
+        }
+        uint8_t block[AES_BLOCKLEN];
+        memcpy(block, packetvec.data(), AES_BLOCKLEN);
+        AES_ctx peek = session->aes_ctx_ctos;
+        AES_CTR_xcrypt_buffer(&peek, block, AES_BLOCKLEN);
+        uint32_t recipient = (block[6] << 24) | (block[7] << 16) | (block[8] << 8) | block[9];
+        boluschannel = session->findChannel(recipient);
+        if (block[5] != SSH2_MSG_CHANNEL_DATA || !boluschannel || !boluschannel->doHandleBolusChannelDataChunksCb) {
+            boluschannel = nullptr;
+        }
+    }
+
     // Handle if more size channel data packets received while provided blous chunk handler
     // Here we will not verify the packet as we will be considering it is 
     // intentionally processed for bolus chunks to support in
     // minimum sftp packet size of 32768 bytes which might be difficult to handle
     // in single packet read. So to avoid OOM we will be considering that whenever sftp layer 
     // adding this callback it is intentionally to handle bolus chunks.
-    if(session->current_channel.doHandleBolusChannelDataChunksCb){
+    if(boluschannel){
 
         bool _continue = true;
         bool _handlerContinue = true;
         bool _parsedInitialSSHHeader = false;
-        uint32_t _totalBytesRead = 0;
+        uint32_t _totalBytesRead = _peekedBytes;
         uint8_t padding_length = 0;
         uint32_t now = __i_dvc_ctrl.millis_now();
 
@@ -159,7 +185,7 @@ int LWSSH::parse_encrypted_packet(LWSSHSession* session, ssh_packet &packet) {
             if( islastchunk ){
 
                 // seperate out MAC data
-                pdiutil::vector<uint8_t> recv_mac(session->mac_len);
+                pdiutil::small_vector<uint8_t, 32> recv_mac(session->mac_len);
                 for (int32_t i = session->mac_len; i > 0; i--) {
                     recv_mac[i-1] = packetvec.back();
                     packetvec.pop_back();
@@ -227,6 +253,9 @@ int LWSSH::parse_encrypted_packet(LWSSHSession* session, ssh_packet &packet) {
                 // Remove headers from string from first initial paylod chunk
                 packetvec.erase(packetvec.begin(), packetvec.begin() + sshoffset);
                 _parsedInitialSSHHeader = true;
+
+                // the data counts against the channel's receive window as usual
+                boluschannel->local_window -= pdistd::min(boluschannel->local_window, data_len);
             }
 
             if( !_parsedInitialSSHHeader ){
@@ -234,7 +263,7 @@ int LWSSH::parse_encrypted_packet(LWSSHSession* session, ssh_packet &packet) {
             }
 
             while (packetvec.size()){
-                _handlerContinue = session->current_channel.doHandleBolusChannelDataChunksCb(packetvec);
+                _handlerContinue = boluschannel->doHandleBolusChannelDataChunksCb(packetvec);
             }
             
             if( !_handlerContinue ){
@@ -255,19 +284,19 @@ int LWSSH::parse_encrypted_packet(LWSSHSession* session, ssh_packet &packet) {
         } while (_continue);
 
         if( !_handlerContinue ){
-            session->current_channel.doHandleBolusChannelDataChunksCb = nullptr; // Reset the callback after handling bolus chunks
+            boluschannel->doHandleBolusChannelDataChunksCb = nullptr; // Reset the callback after handling bolus chunks
         }
         return 1; // Bolus chunks handled, no need to parse further
     }
 
     // take next packet_len bytes + MAC part to form complete packet
-    for (uint32_t i = 0; session->m_client->available() && i < packet_length + session->mac_len; ++i) {
+    for (uint32_t i = _peekedBytes; session->m_client->available() && i < packet_length + session->mac_len; ++i) {
         packetvec.push_back(session->m_client->read());
         __i_dvc_ctrl.yield();
     }
 
     // seperate out MAC data
-    pdiutil::vector<uint8_t> recv_mac(session->mac_len);
+    pdiutil::small_vector<uint8_t, 32> recv_mac(session->mac_len);
     for (int32_t i = session->mac_len; i > 0; i--) {
         recv_mac[i-1] = packetvec.back();
         packetvec.pop_back();
@@ -332,7 +361,7 @@ bool LWSSH::parse_name_list(const pdiutil::vector<uint8_t>& payload, uint32_t& o
     if (offset + len > payload.size()) return false;
     pdiutil::string names(reinterpret_cast<const char*>(&payload[offset]), len);
     offset += len;
-    uint32_t start = 0, end;
+    size_t start = 0, end;
     while ((end = names.find(',', start)) != pdiutil::string::npos) {
         name_list.push_back(names.substr(start, end - start));
         start = end + 1;
@@ -627,22 +656,51 @@ void LWSSH::append_ssh_string(pdiutil::vector<uint8_t>& out, const char* data, u
 }
 
 /**
- * @brief read an SSH string to the output string.
+ * @brief read an SSH string as a view of its bytes in the payload.
  * @param payload payload from which string has to be read
- * @param str The output string to read in.
+ * @param str The bytes of the string, good while the payload is unchanged.
  * @param offset payload offset from which needs to read strign data.
  */
-bool LWSSH::read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::string& str, int32_t &offset){
+bool LWSSH::read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::span<const uint8_t>& str, int32_t &offset){
 
-    if (offset + 4 > payload.size()) return false;
+    if (offset < 0 || (uint32_t)offset + 4 > payload.size()) return false;
     uint32_t len = (payload[offset] << 24) | (payload[offset+1] << 16) | (payload[offset+2] << 8) | payload[offset+3];
     offset += 4;
-    if (offset + len > payload.size()) return false;
-    str.assign((const char*)&payload[offset], len);
+    // compared against what is left, so a huge length cannot wrap past the check
+    if (len > payload.size() - (uint32_t)offset) return false;
+    str = pdiutil::span<const uint8_t>(payload.data() + offset, len);
     offset += len;
     return true;
 }
 
+/**
+ * @brief read an SSH string as a view of its characters in the payload.
+ * @param payload payload from which string has to be read
+ * @param str The string, good while the payload is unchanged.
+ * @param offset payload offset from which needs to read strign data.
+ */
+bool LWSSH::read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::string_view& str, int32_t &offset){
+
+    pdiutil::span<const uint8_t> bytes;
+    if (!read_ssh_string(payload, bytes, offset)) return false;
+    str = pdiutil::string_view((const char*)bytes.data(), bytes.size());
+    return true;
+}
+
+/**
+ * @brief read an SSH string to the output string.
+ * @param payload payload from which string has to be read
+ * @param str The output string to read in.
+ * @param offset payload offset from which needs to read strign data.
+ */
+bool LWSSH::read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::string& str, int32_t &offset){
+
+    pdiutil::string_view view;
+    if (!read_ssh_string(payload, view, offset)) return false;
+    str.assign(view.data(), view.size());
+    return true;
+}
+
 /**
  * @brief read an SSH string to the output string.
  * @param payload payload from which string has to be read
@@ -651,76 +709,228 @@ bool LWSSH::read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::st
  */
 bool LWSSH::read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::vector<uint8_t>& str, int32_t &offset){
 
-    if (offset + 4 > payload.size()) return false;
-    uint32_t len = (payload[offset] << 24) | (payload[offset+1] << 16) | (payload[offset+2] << 8) | payload[offset+3];
-    offset += 4;
-    if (offset + len > payload.size()) return false;
-    for (uint32_t i = 0; i < len; i++){
-        str.push_back(payload[offset+i]);
-    }
-    offset += len;
+    pdiutil::span<const uint8_t> bytes;
+    if (!read_ssh_string(payload, bytes, offset)) return false;
+    str.insert(str.end(), bytes.begin(), bytes.end());
     return true;
 }
 
+/**
+ * @brief Append a uint32 in network byte order.
+ */
+static void append_uint32(pdiutil::vector<uint8_t>& out, uint32_t value){
+    out.push_back((value >> 24) & 0xFF);
+    out.push_back((value >> 16) & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+    out.push_back(value & 0xFF);
+}
+
 /**
  * @brief Prepare the channel open reply and send.
  * @param session The SSH session to use.
+ * @param channel The channel being confirmed.
  * @param window_size Window size.
  * @param max_packet Max packet size.
  * @return true if the message was sent successfully, false otherwise.
  */
-bool LWSSH::send_channel_open_confirmation(LWSSHSession *session, uint32_t window_size, uint32_t max_packet){
+bool LWSSH::send_channel_open_confirmation(LWSSHSession *session, const SSHChannel &channel, uint32_t window_size, uint32_t max_packet){
 
     // Build SSH2_MSG_CHANNEL_OPEN_CONFIRMATION
-    pdiutil::vector<uint8_t> reply;
+    ssh_small_packet reply;
     reply.push_back(SSH2_MSG_CHANNEL_OPEN_CONFIRMATION);
-    reply.push_back((session->current_channel.client_channel_id >> 24) & 0xFF);
-    reply.push_back((session->current_channel.client_channel_id >> 16) & 0xFF);
-    reply.push_back((session->current_channel.client_channel_id >> 8) & 0xFF);
-    reply.push_back(session->current_channel.client_channel_id & 0xFF);
-
-    reply.push_back((session->current_channel.server_channel_id >> 24) & 0xFF);
-    reply.push_back((session->current_channel.server_channel_id >> 16) & 0xFF);
-    reply.push_back((session->current_channel.server_channel_id >> 8) & 0xFF);
-    reply.push_back(session->current_channel.server_channel_id & 0xFF);
-
-    reply.push_back((window_size >> 24) & 0xFF);
-    reply.push_back((window_size >> 16) & 0xFF);
-    reply.push_back((window_size >> 8) & 0xFF);
-    reply.push_back(window_size & 0xFF);
-
-    reply.push_back((max_packet >> 24) & 0xFF);
-    reply.push_back((max_packet >> 16) & 0xFF);
-    reply.push_back((max_packet >> 8) & 0xFF);
-    reply.push_back(max_packet & 0xFF);
+    append_uint32(reply, channel.client_channel_id);
+    append_uint32(reply, channel.server_channel_id);
+    append_uint32(reply, window_size);
+    append_uint32(reply, max_packet);
 
     // Send as SSH packet (encrypted)
     return send_server_ssh_packet(session, reply, true);
 }
 
 /**
- * @brief Send channel data to client.
+ * @brief Refuse a channel the client asked to open.
+ * @param session The SSH session to use.
+ * @param client_channel_id The ID the client gave the channel.
+ * @param reason One of SSH2_OPEN_*.
+ * @return true if the message was sent successfully, false otherwise.
+ */
+bool LWSSH::send_channel_open_failure(LWSSHSession *session, uint32_t client_channel_id, uint32_t reason){
+
+    ssh_small_packet reply;
+    reply.push_back(SSH2_MSG_CHANNEL_OPEN_FAILURE); // 92
+    append_uint32(reply, client_channel_id);
+    append_uint32(reply, reason);
+    append_ssh_string(reply, "", 0); // description
+    append_ssh_string(reply, "", 0); // language tag
+    return send_server_ssh_packet(session, reply, true);
+}
+
+/**
+ * @brief Send a message that carries nothing but the recipient channel, like
+ * SSH2_MSG_CHANNEL_SUCCESS, _FAILURE, _EOF or _CLOSE.
  * @param session The SSH session to use.
+ * @param channel The channel it is for.
+ * @param msg_type The message type.
+ * @return true if the message was sent successfully, false otherwise.
+ */
+bool LWSSH::send_channel_message(LWSSHSession *session, const SSHChannel &channel, uint8_t msg_type){
+
+    ssh_small_packet reply;
+    reply.push_back(msg_type);
+    append_uint32(reply, channel.client_channel_id);
+    return send_server_ssh_packet(session, reply, true);
+}
+
+/**
+ * @brief Queue channel data for the client and send what its window allows.
+ * @param session The SSH session to use.
+ * @param channel The channel the data is for.
  * @param data data to send.
  * @param length data length.
- * @return true if the message was sent successfully, false otherwise.
+ * @return true if the data was taken, false if the channel is closed or the connection failed.
+ */
+bool LWSSH::send_channel_data(LWSSHSession *session, SSHChannel *channel, const char *data, uint32_t length){
+
+    if (!session || !channel || !channel->in_use || channel->close_sent || channel->close_pending) {
+        return false;
+    }
+    channel->tx_queue.insert(channel->tx_queue.end(), data, data + length);
+    return flush_channel_data(session);
+}
+
+/**
+ * @brief Send queued channel data, one packet per channel in turn, until the
+ * queues are empty or the client's windows are used up. A channel that has a
+ * close pending is closed once its queue has gone out.
+ * @param session The SSH session to use.
+ * @return false if the connection failed.
  */
-bool LWSSH::send_channel_data(LWSSHSession *session, const char *data, uint32_t length){
-    pdiutil::vector<uint8_t> chdatapayload;
-    chdatapayload.push_back(SSH2_MSG_CHANNEL_DATA); // 94
-
-    // Use the client's channel id as recipient
-    uint32_t client_channel_id = session->current_channel.client_channel_id;
-    chdatapayload.push_back((client_channel_id >> 24) & 0xFF);
-    chdatapayload.push_back((client_channel_id >> 16) & 0xFF);
-    chdatapayload.push_back((client_channel_id >> 8) & 0xFF);
-    chdatapayload.push_back(client_channel_id & 0xFF);
-
-    // Prepare your data as an SSH string
-    append_ssh_string(chdatapayload, data, length); // This adds 4-byte length + data
-
-    // Send the packet (encrypted)
-    return send_server_ssh_packet(session, chdatapayload, true);
+bool LWSSH::flush_channel_data(LWSSHSession *session){
+
+    if (!session) {
+        return false;
+    }
+
+    bool sent = true;
+    while (sent) {
+
+        sent = false;
+        for (uint8_t n = 0; n < SSH_MAX_CHANNELS; n++) {
+
+            SSHChannel &channel = session->m_channels[(session->m_tx_next + n) % SSH_MAX_CHANNELS];
+            if (!channel.in_use || channel.close_sent) {
+                continue;
+            }
+
+            uint32_t pending = channel.tx_queue.size() - channel.tx_sent;
+            uint32_t maxpacket = channel.max_packet_size ? channel.max_packet_size : SSH_CHANNEL_MAX_PACKET;
+            uint32_t chunk = pdistd::min(pending, pdistd::min(channel.window_size, maxpacket));
+
+            if (chunk > 0) {
+
+                ssh_small_packet chdatapayload;
+                chdatapayload.push_back(SSH2_MSG_CHANNEL_DATA); // 94
+                append_uint32(chdatapayload, channel.client_channel_id);
+                append_ssh_string(chdatapayload, (const char *)channel.tx_queue.data() + channel.tx_sent, chunk);
+
+                if (!send_server_ssh_packet(session, chdatapayload, true)) {
+                    return false;
+                }
+                channel.tx_sent += chunk;
+                channel.window_size -= chunk;
+                if (channel.tx_sent == channel.tx_queue.size()) {
+                    channel.tx_queue.clear();
+                    channel.tx_sent = 0;
+                }
+                sent = true;
+            }
+
+            if (channel.close_pending && channel.tx_queue.empty()) {
+                channel.close_pending = false;
+                send_channel_close(session, channel, channel.exit_status);
+            }
+        }
+        session->m_tx_next = (session->m_tx_next + 1) % SSH_MAX_CHANNELS;
+    }
+    return true;
+}
+
+/**
+ * @brief Give the client more window once half of what it had is used. None is
+ * given while the channel's output is backlogged, so the client stops sending.
+ * @param session The SSH session to use.
+ * @param channel The channel to top up.
+ * @return false if the message could not be sent.
+ */
+bool LWSSH::send_channel_window_adjust(LWSSHSession *session, SSHChannel &channel){
+
+    if (!channel.in_use || channel.close_sent || channel.txBacklogged() || channel.local_window > SSH_CHANNEL_WINDOW / 2) {
+        return true;
+    }
+
+    uint32_t bytes = SSH_CHANNEL_WINDOW - channel.local_window;
+    ssh_small_packet adjust;
+    adjust.push_back(SSH2_MSG_CHANNEL_WINDOW_ADJUST); // 93
+    append_uint32(adjust, channel.client_channel_id);
+    append_uint32(adjust, bytes);
+    if (!send_server_ssh_packet(session, adjust, true)) {
+        return false;
+    }
+    channel.local_window += bytes;
+    return true;
+}
+
+/**
+ * @brief End a channel from our side: EOF, its exit status and CLOSE. When
+ * output is still queued for it the close waits until that has gone out.
+ * @param session The SSH session to use.
+ * @param channel The channel to close.
+ * @param exit_status Exit status reported to the client.
+ * @return false if the messages could not be sent.
+ */
+bool LWSSH::send_channel_close(LWSSHSession *session, SSHChannel &channel, uint32_t exit_status){
+
+    if (!channel.in_use || channel.close_sent) {
+        return true;
+    }
+    if (!channel.tx_queue.empty()) {
+        channel.close_pending = true;
+        channel.exit_status = exit_status;
+        return true;
+    }
+
+    bool bstatus = send_channel_message(session, channel, SSH2_MSG_CHANNEL_EOF); // 96
+
+    ssh_small_packet reply;
+    reply.push_back(SSH2_MSG_CHANNEL_REQUEST); // 98
+    append_uint32(reply, channel.client_channel_id);
+    pdiutil::string reqtype = CHARPTR_WRAP("exit-status");
+    append_ssh_string(reply, reqtype.c_str(), reqtype.length());
+    reply.push_back(0); // false, we don't want reply for exit-status
+    append_uint32(reply, exit_status);
+    bstatus = bstatus && send_server_ssh_packet(session, reply, true);
+
+    bstatus = bstatus && send_channel_message(session, channel, SSH2_MSG_CHANNEL_CLOSE); // 97
+    channel.close_sent = true;
+    channel.ischannelreqsuccess = -1;
+    return bstatus;
+}
+
+/**
+ * @brief Free a channel's slot once both sides have closed it.
+ * @param session The SSH session it belongs to.
+ * @param channel The channel to free.
+ */
+void LWSSH::release_channel(LWSSHSession *session, SSHChannel &channel){
+
+    int16_t &fd = channel.subsystem_req.sftp.fd;
+    if (fd >= 0) { __i_fs.closeFile(fd); fd = -1; } // client went away without SSH_FXP_CLOSE
+
+    if (session && session->m_sshclient && session->m_sshclient->getSSHChannel() == &channel) {
+        session->m_sshclient->commit();
+        session->m_sshclient->setSSHChannel(nullptr);
+    }
+    channel = SSHChannel();
 }
 
 /**
@@ -1376,17 +1586,15 @@ bool LWSSH::extract_ed25519_blob_field(const pdiutil::vector<uint8_t>& blob, pdi
     out.clear();
 
     int32_t offset = 0;
-    pdiutil::string type;
+    pdiutil::string_view type;
     if (!read_ssh_string(blob, type, offset)) return false;
+    if (type != pdiutil::string_view(CHARPTR_WRAP(SSH_ED25519_KEY_TYPE_STR))) return false;
 
-    pdiutil::string expected = CHARPTR_WRAP(SSH_ED25519_KEY_TYPE_STR);
-    if (type != expected) return false;
-
-    pdiutil::vector<uint8_t> field;
+    pdiutil::span<const uint8_t> field;
     if (!read_ssh_string(blob, field, offset)) return false;
     if (field.size() != expected_size) return false;
 
-    out = field;
+    out.assign(field.begin(), field.end());
     return true;
 }
 
@@ -1479,12 +1687,11 @@ void LWSSH::build_pubkey_auth_signed_data(LWSSHSession* session, const SSHUserAu
 // Parse an "ssh-rsa" public-key blob (string("ssh-rsa") mpint(e) mpint(n)) into key.
 static bool extract_rsa_pubkey(const pdiutil::vector<uint8_t>& blob, rsa_key& key) {
     int32_t offset = 0;
-    pdiutil::string type;
+    pdiutil::string_view type;
     if (!read_ssh_string(blob, type, offset)) return false;
-    pdiutil::string expected = CHARPTR_WRAP(SSH_RSA_KEY_TYPE_STR);
-    if (type != expected) return false;
+    if (type != pdiutil::string_view(CHARPTR_WRAP(SSH_RSA_KEY_TYPE_STR))) return false;
 
-    pdiutil::vector<uint8_t> e, n;
+    pdiutil::span<const uint8_t> e, n;
     if (!read_ssh_string(blob, e, offset)) return false;
     if (!read_ssh_string(blob, n, offset)) return false;
 
@@ -1503,7 +1710,7 @@ static bool extract_rsa_pubkey(const pdiutil::vector<uint8_t>& blob, rsa_key& ke
 bool LWSSH::verify_pubkey_signature(LWSSHSession* session, const SSHUserAuthRequest& req) {
 
     int32_t offset = 0;
-    pdiutil::string type;
+    pdiutil::string_view type;
     if (!read_ssh_string(req.pubkey_blob, type, offset)) {
         return false;
     }
@@ -1525,13 +1732,12 @@ bool LWSSH::verify_pubkey_signature(LWSSHSession* session, const SSHUserAuthRequ
 
         // signature blob: string(sig-algo-name) + string(raw signature)
         int32_t sigoff = 0;
-        pdiutil::string signame;
-        pdiutil::vector<uint8_t> rawsig;
+        pdiutil::string_view signame;
+        pdiutil::span<const uint8_t> rawsig;
         if (!read_ssh_string(req.signature, signame, sigoff)) return false;
         if (!read_ssh_string(req.signature, rawsig, sigoff)) return false;
 
-        pdiutil::string rsa512 = CHARPTR_WRAP(SSH_RSA_SIG_ALGO_SHA512_STR);
-        rsa_hash_alg alg = (signame == rsa512) ? RSA_HASH_SHA512 : RSA_HASH_SHA256;
+        rsa_hash_alg alg = (signame == pdiutil::string_view(CHARPTR_WRAP(SSH_RSA_SIG_ALGO_SHA512_STR))) ? RSA_HASH_SHA512 : RSA_HASH_SHA256;
 
         rsa_key* key = pdiutil::safe_new<rsa_key>();
         if (!key) return false;
@@ -1553,23 +1759,23 @@ bool LWSSH::verify_pubkey_signature(LWSSHSession* session, const SSHUserAuthRequ
 
 /**
  * @brief Parse the channel open request.
- * @param session The SSH session to use.
  * @param packet recieved ssh packet.
+ * @param channel channel to fill with the client's side of it.
  */
-bool LWSSH::parse_channel_open_request(LWSSHSession *session, ssh_packet &packet){
+bool LWSSH::parse_channel_open_request(const ssh_packet &packet, SSHChannel &channel){
 
-    if (!session || packet.payload.empty() || packet.payload[0] != SSH2_MSG_CHANNEL_OPEN) {
+    if (packet.payload.empty() || packet.payload[0] != SSH2_MSG_CHANNEL_OPEN) {
         return false;
     }
 
     int32_t offset = 1; // skip message type
 
     // Parse channel type (SSH string)
-    if (!read_ssh_string(packet.payload, session->current_channel.channel_type, offset)) return false;
+    if (!read_ssh_string(packet.payload, channel.channel_type, offset)) return false;
 
     // Parse sender channel (uint32)
     if (offset + 4 > packet.payload.size()) return false;
-    session->current_channel.client_channel_id =
+    channel.client_channel_id =
         (packet.payload[offset] << 24) |
         (packet.payload[offset+1] << 16) |
         (packet.payload[offset+2] << 8) |
@@ -1578,7 +1784,7 @@ bool LWSSH::parse_channel_open_request(LWSSHSession *session, ssh_packet &packet
 
     // Parse initial window size (uint32)
     if (offset + 4 > packet.payload.size()) return false;
-    session->current_channel.window_size =
+    channel.window_size =
         (packet.payload[offset] << 24) |
         (packet.payload[offset+1] << 16) |
         (packet.payload[offset+2] << 8) |
@@ -1587,15 +1793,25 @@ bool LWSSH::parse_channel_open_request(LWSSHSession *session, ssh_packet &packet
 
     // Parse max packet size (uint32)
     if (offset + 4 > packet.payload.size()) return false;
-    session->current_channel.max_packet_size =
+    channel.max_packet_size =
         (packet.payload[offset] << 24) |
         (packet.payload[offset+1] << 16) |
         (packet.payload[offset+2] << 8) |
         (packet.payload[offset+3]);
     offset += 4;
 
-    session->current_channel.server_channel_id++;
+    return true;
+}
+
+/**
+ * @brief Parse the recipient channel every channel message starts with.
+ * @param payload received payload of the channel message
+ * @param recipient set to our id of the channel.
+ */
+bool LWSSH::parse_channel_recipient(const pdiutil::vector<uint8_t> &payload, uint32_t &recipient){
 
+    if (payload.size() < 5) return false;
+    recipient = (payload[1] << 24) | (payload[2] << 16) | (payload[3] << 8) | payload[4];
     return true;
 }
 
@@ -1637,16 +1853,17 @@ bool LWSSH::parse_channel_request(const pdiutil::vector<uint8_t> &payload, SSHCh
 /**
  * @brief Parse the channel request type pty-req.
  * @param session The SSH session to use.
+ * @param channel The channel the pty is for.
  * @param data recieved payload.
  */
-bool LWSSH::parse_channel_request_pty_req(LWSSHSession *session, const pdiutil::vector<uint8_t> &data){
+bool LWSSH::parse_channel_request_pty_req(LWSSHSession *session, SSHChannel &channel, const pdiutil::vector<uint8_t> &data){
  
     if (!session || data.empty()) {
         return false;
     }
     
     int32_t offset = 0;
-    SSHPtyReq &req = session->current_channel.pty_req;
+    SSHPtyReq &req = channel.pty_req;
 
     // Parse TERM string
     if (!read_ssh_string(data, req.term, offset)) return false;
@@ -22,6 +22,9 @@ namespace LWSSH {
 // SSH name list type
 typedef pdiutil::vector<pdiutil::string> ssh_name_list;
 
+// Buffer for a short packet, held inline until it outgrows SSH_SMALL_PACKET_INLINE
+typedef pdiutil::small_vector<uint8_t, SSH_SMALL_PACKET_INLINE> ssh_small_packet;
+
 // SSH packet structure
 struct ssh_packet {
     pdiutil::vector<uint8_t> payload; // vector to the packet payload data
@@ -59,6 +62,7 @@ struct SSHSubsystemRequest {
     struct Sftp{
         pdiutil::string filepath;
         pdiutil::string handle; // Handle for the sftp, if needed. currently supporting 1 only at a time
+        int16_t fd = -1; // file handle held open from SSH_FXP_OPEN until SSH_FXP_CLOSE, -1 when none
         uint32_t fxp_write_totalrecvd = 0; // Total bytes received for current write operation
         uint32_t fxp_write_expectedrecvlen = 0; // Expected total length for current
         uint8_t fxp_write_header[28] = {0}; // per-session reassembled SSH_FXP_WRITE header
@@ -87,18 +91,31 @@ struct SSHChannelData {
     pdiutil::vector<uint8_t> data; // raw data, can be text or binary
 };
 struct SSHChannel {
+    bool in_use = false;              // slot holds an open channel
     pdiutil::string channel_type;     // e.g., "session"
     uint32_t client_channel_id = 0;   // The ID assigned by the client
-    uint32_t server_channel_id = 0;   // The ID assigned by your server
-    uint32_t window_size = 0;
-    uint32_t max_packet_size = 0;
-    // Add more fields as needed (state, pty info, etc.)
-    // e.g., bool shell_started, std::string pty_type, etc.
+    uint32_t server_channel_id = 0;   // The ID assigned by your server, its slot in the session
+    uint32_t window_size = 0;         // bytes the client still accepts from us
+    uint32_t max_packet_size = 0;     // largest data packet the client accepts
+    uint32_t local_window = 0;        // bytes we still accept from the client
     pdiutil::string req_type;
     SSHPtyReq pty_req;
     SSHSubsystemRequest subsystem_req;
     int ischannelreqsuccess = -1;
     pdiutil::function<bool(pdiutil::vector<uint8_t> &)> doHandleBolusChannelDataChunksCb = nullptr; // If provided, handle client bolus chunks
+
+    // Output waiting for the client's window, sent a packet at a time in turn
+    // with the other channels of the session
+    pdiutil::vector<uint8_t> tx_queue;
+    uint32_t tx_sent = 0;             // bytes at the front of tx_queue already sent
+    bool close_pending = false;       // close once tx_queue has gone out
+    bool close_sent = false;          // our CHANNEL_CLOSE is out, waiting for the client's
+    uint32_t exit_status = 0;         // reported with the pending close
+
+    // More output waiting than the cap, hold back the client's requests
+    bool txBacklogged() const {
+        return (tx_queue.size() - tx_sent) > SSH_CHANNEL_TX_QUEUE_CAP;
+    }
 };
 
 // SSH key exchange initialization fields
@@ -194,6 +211,36 @@ struct LWSSHSession {
         pdiutil::safe_delete(m_client);
     }
 
+    // Take a free slot of the channel table for a channel the client opens
+    SSHChannel* openChannel() {
+        for (uint8_t i = 0; i < SSH_MAX_CHANNELS; i++) {
+            if (!m_channels[i].in_use) {
+                m_channels[i] = SSHChannel();
+                m_channels[i].in_use = true;
+                m_channels[i].server_channel_id = i;
+                return &m_channels[i];
+            }
+        }
+        return nullptr;
+    }
+
+    // Channel a message is addressed to, by the id we gave it
+    SSHChannel* findChannel(uint32_t server_channel_id) {
+        if (server_channel_id < SSH_MAX_CHANNELS && m_channels[server_channel_id].in_use) {
+            return &m_channels[server_channel_id];
+        }
+        return nullptr;
+    }
+
+    // Number of channels open on the connection
+    uint8_t openChannels() const {
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < SSH_MAX_CHANNELS; i++) {
+            if (m_channels[i].in_use) count++;
+        }
+        return count;
+    }
+
     // Check if the session is in a valid state
     bool isSessionTimeout() const {
         return (__i_dvc_ctrl.millis_now() - m_last_recv_timestamp) > m_session_timeout;
@@ -236,7 +283,9 @@ struct LWSSHSession {
     uint32_t packets_seq_num_ctos; // Sequence number for client-to-server packets
     uint32_t packets_seq_num_stoc; // Sequence number for server-to-client packets
 
-    SSHChannel current_channel; // For single-channel servers. currently keeping single channle only.
+    SSHChannel m_channels[SSH_MAX_CHANNELS]; // channels multiplexed over this connection
+    uint8_t m_tx_next = 0;      // channel that sends first in the next output round
+    uint64_t m_last_channel_closed_at = 0; // when the last open channel closed, 0 while any is open
     ssh_config_t m_ssh_config;  // Per-session auth policy, loaded lazily before userauth.
     bool m_ssh_config_loaded = false;
     SSHKeyAlgorithm m_negotiated_hostkey_algo = SSH_KEY_ALGO_ED25519; // SSH_KEY_ALGO_MIN => none
@@ -268,9 +317,10 @@ bool verify_pubkey_signature(LWSSHSession* session, const SSHUserAuthRequest& re
 bool parse_name_list(const pdiutil::vector<uint8_t>& payload, uint32_t& offset, ssh_name_list& name_list);
 bool parse_kex_init_fields(const pdiutil::vector<uint8_t>& payload, SSHKexInitFields& fields);
 bool parse_kex_ecdh_init(const pdiutil::vector<uint8_t>& payload, EcdhInitPacket& packet);
-bool parse_channel_open_request(LWSSHSession* session, ssh_packet &packet);
+bool parse_channel_open_request(const ssh_packet &packet, SSHChannel& channel);
+bool parse_channel_recipient(const pdiutil::vector<uint8_t>& payload, uint32_t& recipient);
 bool parse_channel_request(const pdiutil::vector<uint8_t>& payload, SSHChannelRequest& req);
-bool parse_channel_request_pty_req(LWSSHSession* session, const pdiutil::vector<uint8_t>& data);
+bool parse_channel_request_pty_req(LWSSHSession* session, SSHChannel& channel, const pdiutil::vector<uint8_t>& data);
 bool parse_channel_data_request(const pdiutil::vector<uint8_t>& payload, SSHChannelData& datareq);
 
 void append_name_list(pdiutil::vector<uint8_t>& out, const ssh_name_list& names);
@@ -282,10 +332,18 @@ void prepare_server_kexinit(pdiutil::vector<uint8_t> &payload);
 void encrypt_ssh_payload(LWSSHSession* session, pdiutil::vector<uint8_t> &payload);
 void prepare_ssh_packet(pdiutil::vector<uint8_t> &payload, int32_t block_size = 8);
 bool send_server_ssh_packet(LWSSHSession* session, pdiutil::vector<uint8_t> &payload, bool encrypt = false);
+bool read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::span<const uint8_t>& str, int32_t &offset);
+bool read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::string_view& str, int32_t &offset);
 bool read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::string& str, int32_t &offset);
 bool read_ssh_string(const pdiutil::vector<uint8_t>& payload, pdiutil::vector<uint8_t>& str, int32_t &offset);
-bool send_channel_open_confirmation(LWSSHSession* session, uint32_t window_size, uint32_t max_packet);
-bool send_channel_data(LWSSHSession* session, const char* data, uint32_t length);
+bool send_channel_open_confirmation(LWSSHSession* session, const SSHChannel& channel, uint32_t window_size, uint32_t max_packet);
+bool send_channel_open_failure(LWSSHSession* session, uint32_t client_channel_id, uint32_t reason);
+bool send_channel_message(LWSSHSession* session, const SSHChannel& channel, uint8_t msg_type);
+bool send_channel_data(LWSSHSession* session, SSHChannel* channel, const char* data, uint32_t length);
+bool flush_channel_data(LWSSHSession* session);
+bool send_channel_window_adjust(LWSSHSession* session, SSHChannel& channel);
+bool send_channel_close(LWSSHSession* session, SSHChannel& channel, uint32_t exit_status = 0);
+void release_channel(LWSSHSession* session, SSHChannel& channel);
 
 void build_exchange_hash(
     const pdiutil::string &client_version,           // e.g. "SSH-2.0-OpenSSH_9.0"
@@ -174,6 +174,12 @@ void SSHServer::closeSession() {
     __i_dvc_ctrl.wait(5);
     __i_dvc_ctrl.yield();
     if (m_session) {
+        for (uint8_t i = 0; i < SSH_MAX_CHANNELS; i++) {
+            if (m_session->m_channels[i].in_use) {
+                release_channel(m_session, m_session->m_channels[i]);
+            }
+        }
+        m_channel = nullptr;
         pdiutil::safe_delete(m_session);
         m_session = nullptr;
     }
@@ -259,13 +265,28 @@ void SSHServer::serviceSession() {
         if (m_session->m_state == LWSSHSession::SESSION_STATE_CHANNEL_REQUEST ||
             m_session->m_state == LWSSHSession::SESSION_STATE_SESSION_ESTABLISHED) {
 
-            bool is_sftp = (m_session->current_channel.req_type == "subsystem" &&
-                            m_session->current_channel.subsystem_req.subsystem.find("sftp") == 0);
+            // A connection with sftp open but no shell idles on the sftp timeout
+            bool is_sftp = false;
+            for (uint8_t i = 0; i < SSH_MAX_CHANNELS; i++) {
+                const SSHChannel &channel = m_session->m_channels[i];
+                if (channel.in_use && channel.req_type == "subsystem" &&
+                    channel.subsystem_req.subsystem.find("sftp") == 0) {
+                    is_sftp = true;
+                }
+            }
+            if (m_session->m_sshclient && m_session->m_sshclient->getSSHChannel()) {
+                is_sftp = false;
+            }
 
             session_t *termsession = m_session->m_sshclient ?
                 SessionManager::findByTerminal(m_session->m_sshclient) : nullptr;
 
-            if (!is_sftp && nullptr != termsession) {
+            // A connection left without channels is kept for the client to open
+            // more on, unless another client is waiting for its pool slot
+            if (0 != m_session->m_last_channel_closed_at && m_server->hasClient() &&
+                (__i_dvc_ctrl.millis_now() - m_session->m_last_channel_closed_at) > SSH_CHANNEL_CLOSE_GRACE_MS) {
+                m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+            } else if (!is_sftp && nullptr != termsession) {
 
                 if (__cmd_service.isSessionBusy(termsession)) {
                     termsession->m_lastActivityAt = (uint32_t)__i_dvc_ctrl.millis_now();
@@ -768,289 +789,349 @@ void LWSSH::SSHServer::handleChannelRequest(){
 
             uint8_t msg_type = m_session->m_sshpacket.payload[0];
 
+            // Everything after the open names the channel it is for
+            uint32_t recipient = 0;
+            m_channel = nullptr;
+            if( msg_type >= SSH2_MSG_CHANNEL_WINDOW_ADJUST && msg_type <= SSH2_MSG_CHANNEL_FAILURE &&
+                parse_channel_recipient(m_session->m_sshpacket.payload, recipient) ){
+                m_channel = m_session->findChannel(recipient);
+            }
+
             if(msg_type == SSH2_MSG_CHANNEL_OPEN){
 
-                bool bstatus = parse_channel_open_request(m_session, m_session->m_sshpacket);
+                handleChannelOpen();
+            }else if(msg_type == SSH2_MSG_GLOBAL_REQUEST){
 
-                if(bstatus){
+                // No global requests are supported, refuse those that want an answer
+                pdiutil::string_view reqname;
+                int32_t offset = 1;
+                if( read_ssh_string(m_session->m_sshpacket.payload, reqname, offset) &&
+                    offset < (int32_t)m_session->m_sshpacket.payload.size() &&
+                    m_session->m_sshpacket.payload[offset] != 0 ){
 
-                    // Currently setting same received client window size & packet size 
-                    bstatus = send_channel_open_confirmation(m_session, m_session->current_channel.window_size, m_session->current_channel.max_packet_size);
+                    pdiutil::vector<uint8_t> reply;
+                    reply.push_back(SSH2_MSG_REQUEST_FAILURE); // 82
+                    send_server_ssh_packet(m_session, reply, true);
+                }
+            }else if(msg_type >= SSH2_MSG_CHANNEL_WINDOW_ADJUST && msg_type <= SSH2_MSG_CHANNEL_FAILURE && nullptr == m_channel){
 
-                    if(!bstatus){
+                // for a channel that is not open (any more), nothing to do
+            }else if(msg_type == SSH2_MSG_CHANNEL_WINDOW_ADJUST){
 
-                        m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
-                    }
-                }else{
-                    m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+                const pdiutil::vector<uint8_t> &payload = m_session->m_sshpacket.payload;
+                if( payload.size() >= 9 ){
+                    uint32_t bytes = (payload[5] << 24) | (payload[6] << 16) | (payload[7] << 8) | payload[8];
+                    m_channel->window_size += pdistd::min(bytes, (uint32_t)(0xFFFFFFFF - m_channel->window_size));
                 }
             }else if(msg_type == SSH2_MSG_CHANNEL_REQUEST){
 
-                SSHChannelRequest recvreqst;
-                bool bstatus = parse_channel_request(m_session->m_sshpacket.payload, recvreqst);
+                handleChannelRequestType();
+            }else if(msg_type == SSH2_MSG_CHANNEL_DATA){
 
-                if(bstatus){
+                handleChannelData();
+            }else if(msg_type == SSH2_MSG_CHANNEL_EOF){
 
-                    pdiutil::string rt_pty = CHARPTR_WRAP("pty-req");
-                    pdiutil::string rt_shell = CHARPTR_WRAP("shell");
-                    pdiutil::string rt_env = CHARPTR_WRAP("env");
-                    pdiutil::string rt_subsystem = CHARPTR_WRAP("subsystem");
-                    pdiutil::string rt_exec = CHARPTR_WRAP("exec");
-                    pdiutil::string rt_window_change = CHARPTR_WRAP("window-change");
+                // The client sends nothing more on this channel, end it from our side too
+                if( !send_channel_close(m_session, *m_channel) ){
+                    m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+                }
+            }else if(msg_type == SSH2_MSG_CHANNEL_CLOSE){
 
-                    // window-change is transient; keep the channel's active mode
-                    if( recvreqst.request_type != rt_window_change ){
-                        m_session->current_channel.req_type = recvreqst.request_type;
-                    }
+                // Answer the client's close unless ours is already out. Output
+                // still queued is of no use to it any more.
+                if( !m_channel->close_sent ){
+                    m_channel->tx_queue.clear();
+                    m_channel->tx_sent = 0;
+                    send_channel_message(m_session, *m_channel, SSH2_MSG_CHANNEL_CLOSE); // 97
+                }
+                release_channel(m_session, *m_channel);
+                m_channel = nullptr;
 
-                    if( recvreqst.request_type == rt_pty ){
+                // Other channels keep the connection, see serviceSession for
+                // when it goes once it has none
+                if( 0 == m_session->openChannels() ){
+                    m_session->m_last_channel_closed_at = __i_dvc_ctrl.millis_now();
+                }
+            }else{
+                __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->writeln();
+                __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write_ro(RODT_ATTR("SSH Client channel req else : "));
+                __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->writeln((int32_t)m_session->m_sshpacket.payload.size());
+                for (size_t i = 0; i < m_session->m_sshpacket.payload.size(); i++)
+                {
+                    __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write_ro(RODT_ATTR("0x"));
+                    __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write((uint32_t)m_session->m_sshpacket.payload[i], true, true);
+                    __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write_ro(RODT_ATTR(", "));
+                }
+                __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->writeln();
+            }
+        }else if(parsestatus < 0){
+            m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+        }
 
-                        // parse the pty-req channel request type specific data
-                        parse_channel_request_pty_req(m_session, recvreqst.request_specific_data);
-                    }else if( recvreqst.request_type == rt_window_change ){
+        pdiutil::string rt_shell = CHARPTR_WRAP("shell");
+        pdiutil::string rt_pty = CHARPTR_WRAP("pty-req");
+        pdiutil::string rt_subsystem = CHARPTR_WRAP("subsystem");
 
-                        if( recvreqst.request_specific_data.size() >= 8 && m_session->m_sshclient ){
-                            uint32_t w = (recvreqst.request_specific_data[0] << 24) | (recvreqst.request_specific_data[1] << 16) | (recvreqst.request_specific_data[2] << 8) | recvreqst.request_specific_data[3];
-                            uint32_t h = (recvreqst.request_specific_data[4] << 24) | (recvreqst.request_specific_data[5] << 16) | (recvreqst.request_specific_data[6] << 8) | recvreqst.request_specific_data[7];
-                            m_session->current_channel.pty_req.width_chars = w;
-                            m_session->current_channel.pty_req.height_rows = h;
-                            m_session->m_sshclient->set_column_width((uint16_t)w);
-                            m_session->m_sshclient->set_row_count((uint16_t)h);
-                        }
-                    }else if( recvreqst.request_type == rt_shell ){
+        // Once channel establish set the ssh client interface i.e. terminal interface to commandline
+        if( m_channel && m_channel->ischannelreqsuccess == 1 ){
 
-                    }else if( recvreqst.request_type == rt_env ){
+            m_channel->ischannelreqsuccess = 2;
 
-                    // todo: update section when environment variables are supported
-                    }else if( recvreqst.request_type == rt_subsystem ){
+            if( m_session->m_sshclient && (
+                m_channel->req_type == rt_shell ||
+                m_channel->req_type == rt_pty
+            )){
+                m_session->m_sshclient->setSSHChannel(m_channel);
+                #ifdef ENABLE_CMD_SERVICE
+                __cmd_service.useTerminal(m_session->m_sshclient);
+                #endif
+            }
+        }
 
-                        int32_t offset = 0;
-                        if (offset + 4 > recvreqst.request_specific_data.size()){
+        #ifdef ENABLE_CMD_SERVICE
+        SSHChannel *shell = m_session->m_sshclient ? m_session->m_sshclient->getSSHChannel() : nullptr;
+        if( shell &&
+            shell->ischannelreqsuccess > 1 &&
+            ( shell->req_type == rt_shell ||
+              shell->req_type == rt_pty ) &&
+            !shell->txBacklogged() &&
+            m_session->m_sshclient->available() > 0
+        ){
+            cmd_result_t res = __cmd_service.processTerminalInput(m_session->m_sshclient);
 
-                            m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
-                        }else{
+            if( res == CMD_RESULT_TERMINAL_ABORTED ){
+                __auth_service.setAuthorized(false);
+                SessionManager::changeDirectory(__i_fs.getHomeDirectory());
+                m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+            }
+        }
+        #endif
 
-                            int32_t vallen = (recvreqst.request_specific_data[offset] << 24) | (recvreqst.request_specific_data[offset+1] << 16) | (recvreqst.request_specific_data[offset+2] << 8) | recvreqst.request_specific_data[offset+3];
-                            offset += 4;
+        // Send queued output, a packet per channel in turn, then take up the
+        // sftp requests held back while a channel's output was backlogged
+        if( !flush_channel_data(m_session) ){
+            m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+        }
+        pdiutil::vector<uint8_t> nodata;
+        for (uint8_t i = 0; i < SSH_MAX_CHANNELS && m_session->m_state == LWSSHSession::SESSION_STATE_CHANNEL_REQUEST; i++) {
+            SSHChannel &held = m_session->m_channels[i];
+            if( held.in_use && !held.close_sent && !held.txBacklogged() &&
+                held.req_type == rt_subsystem &&
+                held.subsystem_req.sftp.rx_accum.size() >= 4 ){
+                m_channel = &held;
+                handleChannelSubsystemRequest(nodata);
+            }
+        }
+        m_channel = nullptr;
 
-                            if ((offset + vallen) > recvreqst.request_specific_data.size()){
+        // Top up receive windows of the channels that are keeping up
+        for (uint8_t i = 0; i < SSH_MAX_CHANNELS; i++) {
+            if( !send_channel_window_adjust(m_session, m_session->m_channels[i]) ){
+                m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+            }
+        }
+    }
+}
 
-                                m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
-                            }else{
+/**
+ * @brief Handle a client opening a channel
+ */
+void LWSSH::SSHServer::handleChannelOpen(){
 
-                                pdiutil::string val(reinterpret_cast<const char*>(recvreqst.request_specific_data.data() + offset), vallen);
-                                m_session->current_channel.subsystem_req.subsystem = val;
-                            }
-                        }
-                    }
+    SSHChannel opened;
+    if( !parse_channel_open_request(m_session->m_sshpacket, opened) ){
 
-                    // send reply if want
-                    if (recvreqst.want_reply && (recvreqst.request_type == rt_shell ||
-                        recvreqst.request_type == rt_pty ||
-                        recvreqst.request_type == rt_subsystem
-                    )) {
-                        pdiutil::vector<uint8_t> reply;
-                        reply.push_back(SSH2_MSG_CHANNEL_SUCCESS); // 99
-                        // recipient channel (client's channel id)
-                        reply.push_back((m_session->current_channel.client_channel_id >> 24) & 0xFF);
-                        reply.push_back((m_session->current_channel.client_channel_id >> 16) & 0xFF);
-                        reply.push_back((m_session->current_channel.client_channel_id >> 8) & 0xFF);
-                        reply.push_back(m_session->current_channel.client_channel_id & 0xFF);
-
-                        if(send_server_ssh_packet(m_session, reply, true)){
-                            if(m_session->current_channel.ischannelreqsuccess < 0){
-                                m_session->current_channel.ischannelreqsuccess = 1;
-                            }
-                        }else{
-                            m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
-                        }
-                    }else if (recvreqst.want_reply && recvreqst.request_type == rt_exec) {
+        m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+        return;
+    }
 
-                        pdiutil::string execcmd;
-                        int32_t execoff = 0;
-                        read_ssh_string(recvreqst.request_specific_data, execcmd, execoff);
+    // Only session channels are served, no forwarding
+    pdiutil::string ct_session = CHARPTR_WRAP("session");
+    if( opened.channel_type != ct_session ){
 
-                        pdiutil::string scp_prefix = CHARPTR_WRAP("scp");
-                        bool isscp = (execcmd.find(scp_prefix) == 0);
+        send_channel_open_failure(m_session, opened.client_channel_id, SSH2_OPEN_UNKNOWN_CHANNEL_TYPE);
+        return;
+    }
 
-                        pdiutil::vector<uint8_t> reply;
-                        reply.push_back(isscp ? SSH2_MSG_CHANNEL_SUCCESS : SSH2_MSG_CHANNEL_FAILURE);
-                        reply.push_back((m_session->current_channel.client_channel_id >> 24) & 0xFF);
-                        reply.push_back((m_session->current_channel.client_channel_id >> 16) & 0xFF);
-                        reply.push_back((m_session->current_channel.client_channel_id >> 8) & 0xFF);
-                        reply.push_back(m_session->current_channel.client_channel_id & 0xFF);
-
-                        if(send_server_ssh_packet(m_session, reply, true)){
-
-                            if(isscp){
-                                pdiutil::string scperr = CHARPTR_WRAP("\x02legacy SCP not supported on this device, use sftp instead\n");
-                                // const char *scperr = "\x02legacy SCP not supported on this device, use sftp instead\n";
-                                send_channel_data(m_session, scperr.c_str(), scperr.length());
-                            }
-                            m_session->current_channel.ischannelreqsuccess = -1;
-                        }
-                        m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
-                    }
-                }else{
-                    m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
-                }
-            }else if(msg_type == SSH2_MSG_CHANNEL_DATA){
+    m_channel = m_session->openChannel();
+    if( nullptr == m_channel ){
 
-                SSHChannelData chdata;
-                bool bstatus = parse_channel_data_request(m_session->m_sshpacket.payload, chdata);
+        send_channel_open_failure(m_session, opened.client_channel_id, SSH2_OPEN_RESOURCE_SHORTAGE);
+        return;
+    }
+    m_channel->channel_type = opened.channel_type;
+    m_channel->client_channel_id = opened.client_channel_id;
+    m_channel->window_size = opened.window_size;
+    m_channel->max_packet_size = opened.max_packet_size;
+    m_channel->local_window = SSH_CHANNEL_WINDOW;
+    m_session->m_last_channel_closed_at = 0;
 
-                if( bstatus ){
+    if( !send_channel_open_confirmation(m_session, *m_channel, SSH_CHANNEL_WINDOW, SSH_CHANNEL_MAX_PACKET) ){
 
-                    pdiutil::string rt_shell = CHARPTR_WRAP("shell");
-                    pdiutil::string rt_pty = CHARPTR_WRAP("pty-req");
-                    pdiutil::string rt_exec = CHARPTR_WRAP("exec");
-                    pdiutil::string rt_subsystem = CHARPTR_WRAP("subsystem");
+        m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+    }
+}
 
-                    if( m_session->current_channel.req_type == rt_shell ||
-                        m_session->current_channel.req_type == rt_pty
-                    ){
-                        if( m_session->m_sshclient ){
-                            m_session->m_sshclient->setReceivedChannelData(chdata.data);
+/**
+ * @brief Handle a channel request (pty-req, shell, subsystem, exec, ...) for m_channel
+ */
+void LWSSH::SSHServer::handleChannelRequestType(){
 
-                            #ifdef ENABLE_CMD_SERVICE
+    SSHChannelRequest recvreqst;
+    if( !parse_channel_request(m_session->m_sshpacket.payload, recvreqst) ){
 
-                            cmd_result_t res = __cmd_service.processTerminalInput(m_session->m_sshclient);
+        m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+        return;
+    }
 
-                            // Only an explicit terminal abort (logout / EOF)
-                            // closes the SSH channel. CMD_RESULT_ABORTED is a
-                            // command-scope Ctrl+C/Ctrl+Z — session stays.
-                            if( res == CMD_RESULT_TERMINAL_ABORTED ){
-                                __auth_service.setAuthorized(false);
-                                SessionManager::changeDirectory(__i_fs.getHomeDirectory());
-                                m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
-                            }
-                            #endif
-                        }
-                    }else if( m_session->current_channel.req_type == rt_exec ){
+    pdiutil::string rt_pty = CHARPTR_WRAP("pty-req");
+    pdiutil::string rt_shell = CHARPTR_WRAP("shell");
+    pdiutil::string rt_env = CHARPTR_WRAP("env");
+    pdiutil::string rt_subsystem = CHARPTR_WRAP("subsystem");
+    pdiutil::string rt_exec = CHARPTR_WRAP("exec");
+    pdiutil::string rt_window_change = CHARPTR_WRAP("window-change");
 
-                    }else if( m_session->current_channel.req_type == rt_subsystem ){
-                        handleChannelSubsystemRequest(chdata.data);
-                    }
-                }
-            }else if(msg_type == SSH2_MSG_CHANNEL_EOF){
+    // There is one terminal per connection, a second shell on it is refused
+    SSHChannel *terminal = m_session->m_sshclient ? m_session->m_sshclient->getSSHChannel() : nullptr;
+    bool wants_terminal = (recvreqst.request_type == rt_pty || recvreqst.request_type == rt_shell);
+    if( wants_terminal && (nullptr == m_session->m_sshclient || (terminal && terminal != m_channel)) ){
 
-                pdiutil::vector<uint8_t> reply;
-                reply.push_back(SSH2_MSG_CHANNEL_EOF); // 96
-                // recipient channel (client's channel id)
-                reply.push_back((m_session->current_channel.client_channel_id >> 24) & 0xFF);
-                reply.push_back((m_session->current_channel.client_channel_id >> 16) & 0xFF);
-                reply.push_back((m_session->current_channel.client_channel_id >> 8) & 0xFF);
-                reply.push_back(m_session->current_channel.client_channel_id & 0xFF);
-
-                if(send_server_ssh_packet(m_session, reply, true)){
-
-                    __i_dvc_ctrl.wait(10); // Wait for a moment to ensure the client receives the EOF
-                    // After sending EOF, we can send exit status and close the channel
-                    // Send exit status before closing the channel
-                    reply.clear();
-                    reply.push_back(SSH2_MSG_CHANNEL_REQUEST); // 98
-                    // recipient channel (client's channel id)
-                    reply.push_back((m_session->current_channel.client_channel_id >> 24) & 0xFF);
-                    reply.push_back((m_session->current_channel.client_channel_id >> 16) & 0xFF);
-                    reply.push_back((m_session->current_channel.client_channel_id >> 8) & 0xFF);
-                    reply.push_back(m_session->current_channel.client_channel_id & 0xFF);
-                    // append equest type "exit-status"
-                    pdiutil::string reqtype = CHARPTR_WRAP("exit-status");
-                    append_ssh_string(reply, reqtype.c_str(), reqtype.length());
-                    // append want reply flag
-                    reply.push_back(0); // false, we don't want reply for exit-status
-                    // append exit status
-                    uint32_t exit_status = 0; // Set exit status as needed
-                    reply.push_back((exit_status >> 24) & 0xFF);
-                    reply.push_back((exit_status >> 16) & 0xFF);
-                    reply.push_back((exit_status >> 8) & 0xFF);
-                    reply.push_back(exit_status & 0xFF);
-                    send_server_ssh_packet(m_session, reply, true);
+        if( recvreqst.want_reply ){
+            send_channel_message(m_session, *m_channel, SSH2_MSG_CHANNEL_FAILURE); // 100
+        }
+        return;
+    }
 
-                    __i_dvc_ctrl.wait(10);
-                    reply.clear();
-                    reply.push_back(SSH2_MSG_CHANNEL_CLOSE); // 97
-                    reply.push_back((m_session->current_channel.client_channel_id >> 24) & 0xFF);
-                    reply.push_back((m_session->current_channel.client_channel_id >> 16) & 0xFF);
-                    reply.push_back((m_session->current_channel.client_channel_id >> 8) & 0xFF);
-                    reply.push_back(m_session->current_channel.client_channel_id & 0xFF);
-                    send_server_ssh_packet(m_session, reply, true);
-                    m_session->current_channel.ischannelreqsuccess = -1;
+    // window-change is transient; keep the channel's active mode
+    if( recvreqst.request_type != rt_window_change ){
+        m_channel->req_type = recvreqst.request_type;
+    }
 
-                    __task_scheduler.setTimeout( [&]() {
-                        if( nullptr != m_session ){
-                            m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
-                        }
-                    }, SSH_CHANNEL_CLOSE_GRACE_MS, __i_dvc_ctrl.millis_now() );
-                }else{
-                    m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
-                }
-            }else if(msg_type == SSH2_MSG_CHANNEL_CLOSE){
+    if( recvreqst.request_type == rt_pty ){
 
-                if( m_session->current_channel.ischannelreqsuccess >= 0 ){
+        // parse the pty-req channel request type specific data
+        parse_channel_request_pty_req(m_session, *m_channel, recvreqst.request_specific_data);
+    }else if( recvreqst.request_type == rt_window_change ){
 
-                    pdiutil::vector<uint8_t> reply;
-                    reply.push_back(SSH2_MSG_CHANNEL_CLOSE); // 97
-                    // recipient channel (client's channel id)
-                    reply.push_back((m_session->current_channel.client_channel_id >> 24) & 0xFF);
-                    reply.push_back((m_session->current_channel.client_channel_id >> 16) & 0xFF);
-                    reply.push_back((m_session->current_channel.client_channel_id >> 8) & 0xFF);
-                    reply.push_back(m_session->current_channel.client_channel_id & 0xFF);
+        if( recvreqst.request_specific_data.size() >= 8 && m_session->m_sshclient && terminal == m_channel ){
+            uint32_t w = (recvreqst.request_specific_data[0] << 24) | (recvreqst.request_specific_data[1] << 16) | (recvreqst.request_specific_data[2] << 8) | recvreqst.request_specific_data[3];
+            uint32_t h = (recvreqst.request_specific_data[4] << 24) | (recvreqst.request_specific_data[5] << 16) | (recvreqst.request_specific_data[6] << 8) | recvreqst.request_specific_data[7];
+            m_channel->pty_req.width_chars = w;
+            m_channel->pty_req.height_rows = h;
+            m_session->m_sshclient->set_column_width((uint16_t)w);
+            m_session->m_sshclient->set_row_count((uint16_t)h);
+        }
+    }else if( recvreqst.request_type == rt_shell ){
+
+    }else if( recvreqst.request_type == rt_env ){
+
+    // todo: update section when environment variables are supported
+    }else if( recvreqst.request_type == rt_subsystem ){
+
+        int32_t offset = 0;
+        if (offset + 4 > recvreqst.request_specific_data.size()){
+
+            m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
+        }else{
+
+            int32_t vallen = (recvreqst.request_specific_data[offset] << 24) | (recvreqst.request_specific_data[offset+1] << 16) | (recvreqst.request_specific_data[offset+2] << 8) | recvreqst.request_specific_data[offset+3];
+            offset += 4;
+
+            if ((offset + vallen) > recvreqst.request_specific_data.size()){
 
-                    send_server_ssh_packet(m_session, reply, true);
-                    m_session->current_channel.ischannelreqsuccess = -1;
-                }
                 m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
             }else{
-                __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->writeln();
-                __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write_ro(RODT_ATTR("SSH Client channel req else : "));
-                __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->writeln((int32_t)m_session->m_sshpacket.payload.size());
-                for (size_t i = 0; i < m_session->m_sshpacket.payload.size(); i++)
-                {
-                    __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write_ro(RODT_ATTR("0x"));
-                    __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write((uint32_t)m_session->m_sshpacket.payload[i], true, true);
-                    __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write_ro(RODT_ATTR(", "));
-                }
-                __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->writeln();
+
+                pdiutil::string val(reinterpret_cast<const char*>(recvreqst.request_specific_data.data() + offset), vallen);
+                m_channel->subsystem_req.subsystem = val;
             }
-        }else if(parsestatus < 0){
+        }
+    }
+
+    // send reply if want
+    if (recvreqst.want_reply && (recvreqst.request_type == rt_shell ||
+        recvreqst.request_type == rt_pty ||
+        recvreqst.request_type == rt_subsystem
+    )) {
+        if(send_channel_message(m_session, *m_channel, SSH2_MSG_CHANNEL_SUCCESS)){ // 99
+            if(m_channel->ischannelreqsuccess < 0){
+                m_channel->ischannelreqsuccess = 1;
+            }
+        }else{
             m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
         }
+    }else if (recvreqst.request_type == rt_exec) {
 
-        // Once channel establish set the ssh client interface i.e. terminal interface to commandline
-        if( m_session->m_sshclient && m_session->current_channel.ischannelreqsuccess == 1 ){
+        pdiutil::string execcmd;
+        int32_t execoff = 0;
+        read_ssh_string(recvreqst.request_specific_data, execcmd, execoff);
 
-            m_session->current_channel.ischannelreqsuccess = 2;
+        pdiutil::string scp_prefix = CHARPTR_WRAP("scp");
+        bool isscp = (execcmd.find(scp_prefix) == 0);
 
-            pdiutil::string rt_shell = CHARPTR_WRAP("shell");
-            pdiutil::string rt_pty = CHARPTR_WRAP("pty-req");
-            if( m_session->current_channel.req_type == rt_shell ||
-                m_session->current_channel.req_type == rt_pty
-            ){
-                #ifdef ENABLE_CMD_SERVICE
-                __cmd_service.useTerminal(m_session->m_sshclient);
-                #endif
-            }
+        // Commands are not run outside the shell. Only the channel is refused,
+        // the others on the connection carry on.
+        if( recvreqst.want_reply ){
+            send_channel_message(m_session, *m_channel, isscp ? SSH2_MSG_CHANNEL_SUCCESS : SSH2_MSG_CHANNEL_FAILURE);
+        }
+        if(isscp){
+            pdiutil::string scperr = CHARPTR_WRAP("\x02legacy SCP not supported on this device, use sftp instead\n");
+            send_channel_data(m_session, m_channel, scperr.c_str(), scperr.length());
+            send_channel_close(m_session, *m_channel, 1);
+        }else if( !recvreqst.want_reply ){
+            send_channel_close(m_session, *m_channel, 127);
         }
+    }else if (recvreqst.want_reply && recvreqst.request_type != rt_window_change) {
+
+        send_channel_message(m_session, *m_channel, SSH2_MSG_CHANNEL_FAILURE); // 100
+    }
+}
+
+/**
+ * @brief Handle channel data for m_channel
+ */
+void LWSSH::SSHServer::handleChannelData(){
+
+    SSHChannelData chdata;
+    if( !parse_channel_data_request(m_session->m_sshpacket.payload, chdata) ){
+        return;
+    }
+    m_channel->local_window -= pdistd::min(m_channel->local_window, (uint32_t)chdata.data.size());
+
+    pdiutil::string rt_shell = CHARPTR_WRAP("shell");
+    pdiutil::string rt_pty = CHARPTR_WRAP("pty-req");
+    pdiutil::string rt_exec = CHARPTR_WRAP("exec");
+    pdiutil::string rt_subsystem = CHARPTR_WRAP("subsystem");
+
+    if( m_channel->req_type == rt_shell ||
+        m_channel->req_type == rt_pty
+    ){
+        if( m_session->m_sshclient && m_session->m_sshclient->getSSHChannel() == m_channel ){
+            m_session->m_sshclient->setReceivedChannelData(chdata.data);
+
+            #ifdef ENABLE_CMD_SERVICE
+
+            // Input stays buffered while output is backlogged, see handleChannelRequest
+            if( m_channel->txBacklogged() ){
+                return;
+            }
 
-        #ifdef ENABLE_CMD_SERVICE
-        pdiutil::string rt_shell_pending = CHARPTR_WRAP("shell");
-        pdiutil::string rt_pty_pending = CHARPTR_WRAP("pty-req");
-        if( m_session->m_sshclient &&
-            m_session->current_channel.ischannelreqsuccess > 1 &&
-            ( m_session->current_channel.req_type == rt_shell_pending ||
-              m_session->current_channel.req_type == rt_pty_pending ) &&
-            m_session->m_sshclient->available() > 0
-        ){
             cmd_result_t res = __cmd_service.processTerminalInput(m_session->m_sshclient);
 
+            // Only an explicit terminal abort (logout / EOF)
+            // closes the SSH channel. CMD_RESULT_ABORTED is a
+            // command-scope Ctrl+C/Ctrl+Z — session stays.
             if( res == CMD_RESULT_TERMINAL_ABORTED ){
                 __auth_service.setAuthorized(false);
                 SessionManager::changeDirectory(__i_fs.getHomeDirectory());
                 m_session->m_state = LWSSHSession::SESSION_STATE_SESSION_CLOSE;
             }
+            #endif
         }
-        #endif
+    }else if( m_channel->req_type == rt_exec ){
+
+    }else if( m_channel->req_type == rt_subsystem ){
+        handleChannelSubsystemRequest(chdata.data);
     }
 }
 
@@ -1062,12 +1143,13 @@ void LWSSH::SSHServer::handleChannelSubsystemRequest(pdiutil::vector<uint8_t>& d
 
     // Parse the exec request packet
     pdiutil::string sftp_str = CHARPTR_WRAP("sftp");
-    if (m_session->current_channel.subsystem_req.subsystem.find(sftp_str) == 0) {
+    if (m_channel->subsystem_req.subsystem.find(sftp_str) == 0) {
 
-        pdiutil::vector<uint8_t> &accum = m_session->current_channel.subsystem_req.sftp.rx_accum;
+        pdiutil::vector<uint8_t> &accum = m_channel->subsystem_req.sftp.rx_accum;
         accum.insert(accum.end(), data.begin(), data.end());
 
-        while (accum.size() >= 4) {
+        // Requests wait in accum while the replies to earlier ones are backlogged
+        while (accum.size() >= 4 && !m_channel->txBacklogged()) {
 
             uint32_t packetlen = (accum[0] << 24) | (accum[1] << 16) | (accum[2] << 8) | accum[3];
 
@@ -1095,7 +1177,7 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
 
     // Parse the exec request packet
     pdiutil::string sftp_str = CHARPTR_WRAP("sftp");
-    if (m_session->current_channel.subsystem_req.subsystem.find(sftp_str) == 0) {
+    if (m_channel->subsystem_req.subsystem.find(sftp_str) == 0) {
 
         // __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->writeln();
         // __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write_ro(RODT_ATTR("SSH Client channel sftp req : "));
@@ -1391,21 +1473,40 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                                 // This will be used to handle bolus chunks in the future which may receive from client
                                 // along with SSH_FXP_WRITE paket. Reason to handle them in encryption layer is to avoid
                                 // OOM on small devies having memory constraints.
-                                m_session->current_channel.doHandleBolusChannelDataChunksCb = [&](pdiutil::vector<uint8_t> &boluschunk)->bool{
+                                SSHChannel *boluschannel = m_channel;
+                                m_channel->doHandleBolusChannelDataChunksCb = [this, boluschannel](pdiutil::vector<uint8_t> &boluschunk)->bool{
+                                    m_channel = boluschannel;
                                     return handleChannelSftpBolusChunks(boluschunk);
                                 };
                             }
                         }
                     }
 
+                    // Keep the file open for the reads and writes that follow, so each
+                    // of them is a seek on the open file rather than a fresh lookup
+                    if( errcode == -1 ){
+
+                        auto &sftp = m_channel->subsystem_req.sftp;
+                        if( sftp.fd >= 0 ){ __i_fs.closeFile(sftp.fd); sftp.fd = -1; } // only one handle at a time
+                        if( __i_fs.isFileExist(filename.c_str()) ){
+
+                            uint8_t openflags = FILE_OPEN_READ | ((flags & SSH_FXF_WRITE) ? FILE_OPEN_WRITE : 0);
+                            sftp.fd = __i_fs.openFile(filename.c_str(), openflags);
+                            if( sftp.fd < 0 ){
+                                errcode = (PDI_ERR_PERM == sftp.fd) ? SSH_FX_PERMISSION_DENIED : SSH_FX_FAILURE;
+                                sftp.fd = -1;
+                            }
+                        }
+                    }
+
                     // If we have a valid handle, prepare the SSH_FXP_HANDLE reply
                     if( errcode == -1 ){
 
                         uint8_t handlesize = 3;
                         char handle[handlesize + 1]; memset(handle, 0, handlesize + 1); genUniqueKey(handle, handlesize); // Generate a unique handle for this open file
-                        m_session->current_channel.subsystem_req.sftp.filepath = filename;
-                        m_session->current_channel.subsystem_req.sftp.handle = handle;
-                        m_session->current_channel.subsystem_req.sftp.is_dir = false;
+                        m_channel->subsystem_req.sftp.filepath = filename;
+                        m_channel->subsystem_req.sftp.handle = handle;
+                        m_channel->subsystem_req.sftp.is_dir = false;
 
                         uint32_t reply_len = 1 + 4 + 4 + handlesize; // type + reqid + handle size + handle bytes
                         sftp_reply.push_back((reply_len >> 24) & 0xFF);
@@ -1452,7 +1553,8 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                                 for (file_info_t item : itemlist) { pdiutil::safe_delete_array(item.m_name); }
                                 itemlist.clear();
                             } else {
-                                auto &sftp = m_session->current_channel.subsystem_req.sftp;
+                                auto &sftp = m_channel->subsystem_req.sftp;
+                                if (sftp.fd >= 0) { __i_fs.closeFile(sftp.fd); sftp.fd = -1; } // only one handle at a time
                                 sftp.dir_entries.clear();
                                 sftp.readdir_offset = 0;
                                 sftp.is_dir = true;
@@ -1509,7 +1611,7 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                         pdiutil::string handle(reinterpret_cast<const char*>(&data[payloadoffset]), handlelen);
                         payloadoffset += handlelen;
 
-                        auto &sftp = m_session->current_channel.subsystem_req.sftp;
+                        auto &sftp = m_channel->subsystem_req.sftp;
 
                         if (sftp.handle != handle || !sftp.is_dir) {
                             errcode = SSH_FX_INVALID_HANDLE;
@@ -1693,7 +1795,7 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                             pdiutil::string handle(reinterpret_cast<const char*>(&data[payloadoffset]), handlelen);
                             payloadoffset += handlelen;
 
-                            auto &sftp = m_session->current_channel.subsystem_req.sftp;
+                            auto &sftp = m_channel->subsystem_req.sftp;
 
                             if (sftp.handle != handle) {
                                 errcode = SSH_FX_INVALID_HANDLE;
@@ -1897,7 +1999,7 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                         pdiutil::string handle(reinterpret_cast<const char*>(&data[payloadoffset]), handlelen);
                         payloadoffset += handlelen;
 
-                        if( m_session->current_channel.subsystem_req.sftp.handle == handle ){
+                        if( m_channel->subsystem_req.sftp.handle == handle ){
                             // Parse offset
                             uint64_t fileoffset = ((uint64_t)data[payloadoffset] << 56) | ((uint64_t)data[payloadoffset+1] << 48) |
                                             ((uint64_t)data[payloadoffset+2] << 40) | ((uint64_t)data[payloadoffset+3] << 32) |
@@ -1909,84 +2011,53 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                             uint32_t length = (data[payloadoffset] << 24) | (data[payloadoffset+1] << 16) | (data[payloadoffset+2] << 8) | data[payloadoffset+3];
                             payloadoffset += 4;
 
-                            // Check if the file exists and read data
-                            if (__i_fs.isFileExist(m_session->current_channel.subsystem_req.sftp.filepath.c_str())) {
+                            // Read at the offset from the file held open since SSH_FXP_OPEN
+                            int16_t fd = m_channel->subsystem_req.sftp.fd;
+                            if( fd < 0 ){
 
-                                uint64_t file_size = __i_fs.getFileSize(m_session->current_channel.subsystem_req.sftp.filepath.c_str());
-                                
-                                if (fileoffset >= file_size && length > 0) {
+                                errcode = SSH_FX_NO_SUCH_PATH;
+                            }else if( length == 0 ){
 
-                                    errcode = SSH_FX_EOF; // EOF if offset is beyond file size and length is greater than zero
-                                }else if(file_size > 0 && length == 0){
+                                errcode = SSH_FX_EOF; // end of file if accepted length is zero
+                            }else{
 
-                                    errcode = SSH_FX_EOF; // end of file if accepted length is zero
-                                }else{
-                                    
-                                    bool startsending = false;
-                                    uint64_t totalskip = 0;
-
-                                    int iStatus = __i_fs.readFile(m_session->current_channel.subsystem_req.sftp.filepath.c_str(), 1024, [&](char* data, uint32_t size)->bool{
-                                        
-                                        if( !startsending ){
-
-                                            if( fileoffset == 0 ){
-
-                                                startsending = true; // Start sending data from the beginning
-                                            }else{
-
-                                                if( totalskip < fileoffset ){
-
-                                                    uint32_t skip = fileoffset - totalskip;
-                                                    
-                                                    if( skip >= size ){
-                                                        totalskip += size;
-                                                        return true; // Skip this chunk, continue reading
-                                                    }else{
-                                                        data += skip; // Skip the initial bytes
-                                                        size -= skip; // Reduce the size to send
-                                                        totalskip += skip; // Update total skip
-                                                        startsending = true;
-                                                    }
-                                                }else{
-                                                    startsending = true;
-                                                }
-                                            }
-                                        }
+                                // Read straight into the reply, behind room for its header
+                                uint32_t want = length < 1024 ? length : 1024;
+                                size_t head = sftp_reply.size();
+                                sftp_reply.resize(head + 13 + want);
 
-                                        if( startsending ){
-                                            // Prepare SSH_FXP_DATA reply (type 103)
-                                            uint32_t reply_len = 1 + 4 + 4 + size; // type + reqid + data length + data
-                                            sftp_reply.push_back((reply_len >> 24) & 0xFF);
-                                            sftp_reply.push_back((reply_len >> 16) & 0xFF);
-                                            sftp_reply.push_back((reply_len >> 8) & 0xFF);
-                                            sftp_reply.push_back(reply_len & 0xFF);
+                                int64_t pos = __i_fs.seekHandle(fd, (int64_t)fileoffset);
+                                int32_t size = (pos < 0) ? (int32_t)pos : __i_fs.readHandle(fd, (char*)&sftp_reply[head + 13], want);
 
-                                            sftp_reply.push_back(SSH_FXP_DATA); // type 103
+                                if( size <= 0 ){
 
-                                            sftp_reply.push_back((request_id >> 24) & 0xFF);
-                                            sftp_reply.push_back((request_id >> 16) & 0xFF);
-                                            sftp_reply.push_back((request_id >> 8) & 0xFF);
-                                            sftp_reply.push_back(request_id & 0xFF);
+                                    sftp_reply.resize(head);
+                                    // EOF if offset is beyond file size, failure if read operation failed
+                                    errcode = (size == 0 || PDI_ERR_RANGE == size) ? SSH_FX_EOF : SSH_FX_FAILURE;
+                                }else{
 
-                                            sftp_reply.push_back((size >> 24) & 0xFF);
-                                            sftp_reply.push_back((size >> 16) & 0xFF);
-                                            sftp_reply.push_back((size >> 8) & 0xFF);
-                                            sftp_reply.push_back(size & 0xFF);
+                                    sftp_reply.resize(head + 13 + size);
 
-                                            sftp_reply.insert(sftp_reply.end(), data, data + size);
-                                        }
+                                    // Prepare SSH_FXP_DATA reply (type 103)
+                                    uint32_t reply_len = 1 + 4 + 4 + size; // type + reqid + data length + data
+                                    uint8_t *reply = &sftp_reply[head];
+                                    reply[0] = (reply_len >> 24) & 0xFF;
+                                    reply[1] = (reply_len >> 16) & 0xFF;
+                                    reply[2] = (reply_len >> 8) & 0xFF;
+                                    reply[3] = reply_len & 0xFF;
 
-                                        // return false to stop continue reading as we collected the chunk we need to send
-                                        return false;
-                                    });
+                                    reply[4] = SSH_FXP_DATA; // type 103
 
-                                    if( iStatus < 0 ){
-                                        
-                                        errcode = SSH_FX_FAILURE; // Failure if read operation failed
-                                    }
+                                    reply[5] = (request_id >> 24) & 0xFF;
+                                    reply[6] = (request_id >> 16) & 0xFF;
+                                    reply[7] = (request_id >> 8) & 0xFF;
+                                    reply[8] = request_id & 0xFF;
+
+                                    reply[9] = (size >> 24) & 0xFF;
+                                    reply[10] = (size >> 16) & 0xFF;
+                                    reply[11] = (size >> 8) & 0xFF;
+                                    reply[12] = size & 0xFF;
                                 }
-                            }else{
-                                errcode = SSH_FX_NO_SUCH_PATH;
                             }
                         }else{
                             errcode = SSH_FX_INVALID_HANDLE;
@@ -2005,7 +2076,7 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                         pdiutil::string handle(reinterpret_cast<const char*>(&data[payloadoffset]), handlelen);
                         payloadoffset += handlelen;
 
-                        if( m_session->current_channel.subsystem_req.sftp.handle == handle ){
+                        if( m_channel->subsystem_req.sftp.handle == handle ){
                             // Parse offset
                             uint64_t fileoffset = ((uint64_t)data[payloadoffset] << 56) | ((uint64_t)data[payloadoffset+1] << 48) |
                                             ((uint64_t)data[payloadoffset+2] << 40) | ((uint64_t)data[payloadoffset+3] << 32) |
@@ -2017,11 +2088,12 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                             uint32_t length = (data[payloadoffset] << 24) | (data[payloadoffset+1] << 16) | (data[payloadoffset+2] << 8) | data[payloadoffset+3];
                             payloadoffset += 4;
 
-                            int iStatus = __i_fs.editFile(  m_session->current_channel.subsystem_req.sftp.filepath.c_str(), 
-                                                            fileoffset,
-                                                            (const char*)&data[payloadoffset], 
-                                                            length);
-                            if( iStatus < 0 ){
+                            // Write at the offset into the file held open since SSH_FXP_OPEN,
+                            // a gap past its end reads back as zeros
+                            int16_t fd = m_channel->subsystem_req.sftp.fd;
+                            int64_t pos = (fd < 0) ? PDI_ERR_INVALID_ARG : __i_fs.seekHandle(fd, (int64_t)fileoffset);
+                            int32_t iStatus = (pos < 0) ? (int32_t)pos : __i_fs.writeHandle(fd, (const char*)&data[payloadoffset], length);
+                            if( iStatus < 0 || (uint32_t)iStatus != length ){
                                 errcode = SSH_FX_FAILURE; // Failure if write operation failed
                             }else{
                                 errcode = SSH_FX_OK; // SSH_FX_OK (0) for successful write
@@ -2043,13 +2115,13 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                         pdiutil::string handle(reinterpret_cast<const char*>(&data[payloadoffset]), handlelen);
                         payloadoffset += handlelen;
 
-                        if( m_session->current_channel.subsystem_req.sftp.handle == handle ){
+                        if( m_channel->subsystem_req.sftp.handle == handle ){
 
                             // too: parse the attributes if present
                             // currently not using until dont support attributes
                             errcode = SSH_FX_OK;
 
-                            m_session->current_channel.doHandleBolusChannelDataChunksCb = nullptr; // reset the bolus chunk handler if any
+                            m_channel->doHandleBolusChannelDataChunksCb = nullptr; // reset the bolus chunk handler if any
                         }else{
                             errcode = SSH_FX_INVALID_HANDLE;
                         }
@@ -2067,14 +2139,18 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
                         pdiutil::string handle(reinterpret_cast<const char*>(&data[payloadoffset]), handlelen);
                         payloadoffset += handlelen;
 
-                        if( m_session->current_channel.subsystem_req.sftp.handle == handle ){
+                        if( m_channel->subsystem_req.sftp.handle == handle ){
                             // Successfully closed the file/dir, send success reply
                             errcode = SSH_FX_OK; // SSH_FX_OK (0) for successful close
 
-                            m_session->current_channel.doHandleBolusChannelDataChunksCb = nullptr; // reset the bolus chunk handler if any
+                            m_channel->doHandleBolusChannelDataChunksCb = nullptr; // reset the bolus chunk handler if any
 
                             // Release dir-handle state if this was an OPENDIR handle
-                            auto &sftp = m_session->current_channel.subsystem_req.sftp;
+                            auto &sftp = m_channel->subsystem_req.sftp;
+                            if( sftp.fd >= 0 && __i_fs.closeFile(sftp.fd) < 0 ){
+                                errcode = SSH_FX_FAILURE; // held writes could not be put down
+                            }
+                            sftp.fd = -1;
                             sftp.is_dir = false;
                             sftp.readdir_offset = 0;
                             sftp.dir_entries.clear();
@@ -2118,7 +2194,7 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
 
                 // Send the SFTP reply back to the client
                 if( sftp_reply.size() > 0 && expectReply ){
-                    if (send_channel_data(m_session, (const char*)sftp_reply.data(), sftp_reply.size())) {
+                    if (send_channel_data(m_session, m_channel, (const char*)sftp_reply.data(), sftp_reply.size())) {
                         // __i_dvc_ctrl.getTerminal(TERMINAL_TYPE_SERIAL)->write_ro(RODT_ATTR("SSH SFTP subsystem rply sent : "));
                         // for (size_t i = 0; i < sftp_reply.size(); i++)
                         // {
@@ -2139,10 +2215,10 @@ void LWSSH::SSHServer::handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t
 
 bool LWSSH::SSHServer::handleChannelSftpBolusChunks(pdiutil::vector<uint8_t> &boluschunk){
 
-    uint8_t *sftpheader = m_session->current_channel.subsystem_req.sftp.fxp_write_header;
-    uint64_t &sftpheaderoffset = m_session->current_channel.subsystem_req.sftp.fxp_write_headeroffset;
-    uint32_t &expectedDataLen = m_session->current_channel.subsystem_req.sftp.fxp_write_expectedrecvlen;
-    uint32_t &totalreceived = m_session->current_channel.subsystem_req.sftp.fxp_write_totalrecvd;
+    uint8_t *sftpheader = m_channel->subsystem_req.sftp.fxp_write_header;
+    uint64_t &sftpheaderoffset = m_channel->subsystem_req.sftp.fxp_write_headeroffset;
+    uint32_t &expectedDataLen = m_channel->subsystem_req.sftp.fxp_write_expectedrecvlen;
+    uint32_t &totalreceived = m_channel->subsystem_req.sftp.fxp_write_totalrecvd;
     bool continueReceiving = true;
 
     // initial chunk
@@ -2153,7 +2229,7 @@ bool LWSSH::SSHServer::handleChannelSftpBolusChunks(pdiutil::vector<uint8_t> &bo
         // If the first chunk is not SSH_FXP_WRITE, handle it normally and stop further chunk receiving
         if( boluschunk[4] != SSH_FXP_WRITE ){
 
-            m_session->current_channel.doHandleBolusChannelDataChunksCb = nullptr; // reset the callback
+            m_channel->doHandleBolusChannelDataChunksCb = nullptr; // reset the callback
             handleChannelSubsystemSftpRequest(boluschunk);
             boluschunk.clear();
             return false; // stop receiving further chunks
@@ -62,6 +62,7 @@ private:
     iServerInterface* m_server;
     LWSSHSession* m_sessions[SSH_MAX_SESSIONS]; // concurrent session pool
     LWSSHSession* m_session;                    // session currently being serviced
+    SSHChannel* m_channel = nullptr;            // channel of m_session currently being serviced
     bool m_handling = false;                    // re-entrancy guard for handle()
 
     // Create SSH_CONFIG_FILE with default policy when it is missing.
@@ -78,6 +79,9 @@ private:
     void handleKeyExchange();
     void handleAuthentication();
     void handleChannelRequest();
+    void handleChannelOpen();
+    void handleChannelRequestType();
+    void handleChannelData();
     void handleChannelSubsystemRequest(pdiutil::vector<uint8_t>& data);
     void handleChannelSubsystemSftpRequest(pdiutil::vector<uint8_t>& data, bool expectReply = true);
     bool handleChannelSftpBolusChunks(pdiutil::vector<uint8_t>& boluschunk);
@@ -75,65 +75,147 @@ bool MqttServiceProvider::initService( void *arg ){
 void MqttServiceProvider::handleMqttPublish(bool sync){
 
   LogI("MQTT: handling mqtt publish interval, %d\n", (int)sync);
-  if( !this->m_mqtt_client.is_mqtt_connected() ) return;
+  bool _connected = this->m_mqtt_client.is_mqtt_connected();
 
-  mqtt_pubsub_config_table _mqtt_pubsub_configs;
-  __database_service.get_mqtt_pubsub_config_table(&_mqtt_pubsub_configs);
+  const mqtt_pubsub_config_table *_mqtt_pubsub_configs = __database_service.peek_mqtt_pubsub_config_table();
+  if( nullptr == _mqtt_pubsub_configs || nullptr == this->m_mqtt_payload ) return;
 
-  pdiutil::string mac_placeholder = CHARPTR_WRAP("[mac]");
+  MqttSlotWriter _slots = [&]( uint8_t _slot, char *_out, uint16_t _size ) -> int32_t {
+    return this->writeMqttSlot( _slot, _out, _size );
+  };
+
+  // with nobody to hand the payload to first, it is rendered straight into the
+  // packet. otherwise it goes through m_mqtt_payload, where the callback (or
+  // whoever fills it without a default payload) sees it and may change it
+  bool _direct = this->m_mqtt_publish_data_cb == nullptr && !this->m_publish_payload.empty();
+
+  mqtt_msg_writer_t _payload = [&]( char *_out, uint16_t _size ) -> int32_t {
+    if( _direct ){
+      return this->m_publish_payload.render( _out, _size, _slots );
+    }
+    return MqttTemplate::expand( this->m_mqtt_payload, strlen(this->m_mqtt_payload), _out, _size, _slots );
+  };
 
   for (uint8_t i = 0; i < MQTT_MAX_PUBLISH_TOPIC; i++) {
 
-    __find_and_replace( _mqtt_pubsub_configs.publish_topics[i].topic, mac_placeholder.c_str(), __i_dvc_ctrl.getDeviceMac().c_str(), 2, MQTT_TOPIC_BUF_SIZE );
-    if( nullptr != this->m_mqtt_payload && strlen(_mqtt_pubsub_configs.publish_topics[i].topic) > 0 ){
+    if( this->m_publish_topics[i].empty() ) continue;
+    // qos 1/2 publishes are spooled while the broker is away, qos 0 ones are not
+    if( !_connected && 0 == _mqtt_pubsub_configs->publish_topics[i].qos ) continue;
 
-      LogI("MQTT: publishing on topic : %s\n", _mqtt_pubsub_configs.publish_topics[i].topic);
+    LogI("MQTT: publishing on topic : %s\n", _mqtt_pubsub_configs->publish_topics[i].topic);
 
-      #ifdef ENABLE_MQTT_DEFAULT_PAYLOAD
+    if( !_direct ){
 
-        pdiutil::string *_payload = pdiutil::safe_new<pdiutil::string>();
+      if( !this->m_publish_payload.empty() ){
+        int32_t _len = this->m_publish_payload.render( this->m_mqtt_payload, MQTT_PAYLOAD_BUF_SIZE - 1, _slots );
+        this->m_mqtt_payload[ _len < 0 ? 0 : _len ] = 0;
+      }
+      if( nullptr != this->m_mqtt_publish_data_cb ){
+        this->m_mqtt_publish_data_cb( this->m_mqtt_payload, MQTT_PAYLOAD_BUF_SIZE );
+      }
+    }
 
-        if( nullptr != _payload ){
+    const MqttTemplate &_topic = this->m_publish_topics[i];
+    bool ret = this->m_mqtt_client.Publish(
+      [&]( char *_out, uint16_t _size ) -> int32_t { return _topic.render( _out, _size, _slots ); },
+      _payload,
+      _mqtt_pubsub_configs->publish_topics[i].qos < MQTT_MAX_QOS_LEVEL ?
+      _mqtt_pubsub_configs->publish_topics[i].qos : MQTT_MAX_QOS_LEVEL,
+      _mqtt_pubsub_configs->publish_topics[i].retain
+    );
 
-          #ifdef ENABLE_GPIO_SERVICE
+    if( ret && sync && _connected ){
+      this->m_mqtt_client.MQTT_Task();
+    }
+  }
+}
 
-            __gpio_service.appendGpioJsonPayload( *_payload );
-          #else
+/**
+ * compile the publish topics and the default payload, so that publishing only
+ * has to fill in their placeholders
+ *
+ * @param   const mqtt_pubsub_config_table* _mqtt_pubsub_configs
+ */
+void MqttServiceProvider::compileMqttTemplates( const mqtt_pubsub_config_table *_mqtt_pubsub_configs ){
 
-            *_payload += "Hello from PDI Client : ";
-            *_payload += __i_dvc_ctrl.getDeviceId();
-          #endif
+  this->m_device_mac = __i_dvc_ctrl.getDeviceMac();
 
-          memset( this->m_mqtt_payload, 0, MQTT_PAYLOAD_BUF_SIZE );
-          size_t _payload_len = pdistd::min( (size_t)_payload->size(), (size_t)(MQTT_PAYLOAD_BUF_SIZE - 1) );
-          memcpy(this->m_mqtt_payload, _payload->c_str(), _payload_len);
+  for (uint8_t i = 0; i < MQTT_MAX_PUBLISH_TOPIC; i++) {
 
-          pdiutil::safe_delete(_payload);
-        }
+    const char *_topic = _mqtt_pubsub_configs->publish_topics[i].topic;
+    this->m_publish_topics[i].compile( _topic, strnlen( _topic, MQTT_TOPIC_BUF_SIZE - 1 ) );
+  }
 
-      #else
+  #ifdef ENABLE_MQTT_DEFAULT_PAYLOAD
 
-      #endif
+    #ifdef ENABLE_GPIO_SERVICE
 
-      if( nullptr != this->m_mqtt_publish_data_cb ){
-        this->m_mqtt_publish_data_cb( this->m_mqtt_payload, MQTT_PAYLOAD_BUF_SIZE );
+      pdiutil::string _payload = CHARPTR_WRAP("[gpio]");
+    #else
+
+      pdiutil::string _payload = CHARPTR_WRAP("Hello from PDI Client : ");
+      _payload += pdiutil::to_string(__i_dvc_ctrl.getDeviceId());
+    #endif
+
+    this->m_publish_payload.compile( _payload.c_str(), _payload.size() );
+  #else
+
+    this->m_publish_payload.clear();
+  #endif
+}
+
+/**
+ * write the value of a topic or payload placeholder
+ *
+ * @param   uint8_t _slot
+ * @param   char* _out
+ * @param   uint16_t _size
+ * @return  int32_t bytes written, PDI_ERR_OVERFLOW when they do not fit
+ */
+int32_t MqttServiceProvider::writeMqttSlot( uint8_t _slot, char *_out, uint16_t _size ){
+
+  char _value[24];
+  _value[0] = 0;
+
+  switch ( _slot ) {
+
+    case MQTT_SLOT_MAC:{
+
+      if( this->m_device_mac.size() > _size ) return PDI_ERR_OVERFLOW;
+      memcpy( _out, this->m_device_mac.c_str(), this->m_device_mac.size() );
+      return this->m_device_mac.size();
+    }
+    case MQTT_SLOT_IP:{
+
+      ipaddress_t _ip = __i_wifi.localIP();
+      if( !_ip.isSet() ) break;
+      char *_at = _value;
+      for (uint8_t i = 0; i < 4; i++) {
+        if( i > 0 ) *_at++ = '.';
+        Uint32ToString( _ip.ip4[i], _at, 4 );
+        _at += strlen(_at);
       }
-      __find_and_replace( this->m_mqtt_payload, mac_placeholder.c_str(), __i_dvc_ctrl.getDeviceMac().c_str(), 2, MQTT_PAYLOAD_BUF_SIZE );
-
-      bool ret = this->m_mqtt_client.Publish(
-        _mqtt_pubsub_configs.publish_topics[i].topic,
-        this->m_mqtt_payload,
-        strlen( this->m_mqtt_payload ),
-        _mqtt_pubsub_configs.publish_topics[i].qos < MQTT_MAX_QOS_LEVEL ?
-        _mqtt_pubsub_configs.publish_topics[i].qos : MQTT_MAX_QOS_LEVEL,
-        _mqtt_pubsub_configs.publish_topics[i].retain
-      );
+      break;
+    }
+    case MQTT_SLOT_EPOCH:{
 
-      if( ret && sync ){
-        this->m_mqtt_client.MQTT_Task();
+      if( __i_ntp.is_valid_ntptime() ){
+        Uint32ToString( (uint32_t)__i_ntp.get_ntp_time(), _value, sizeof(_value) );
       }
+      break;
     }
+    #ifdef ENABLE_GPIO_SERVICE
+    case MQTT_SLOT_GPIO:
+      return __gpio_service.writeGpioJsonPayload( _out, _size );
+    #endif
+    default:
+      break;
   }
+
+  uint16_t _len = strlen(_value);
+  if( _len > _size ) return PDI_ERR_OVERFLOW;
+  memcpy( _out, _value, _len );
+  return _len;
 }
 
 /**
@@ -144,22 +226,26 @@ void MqttServiceProvider::handleMqttSubScribe(){
   LogI("MQTT: handling mqtt subscribe interval\n");
   if( !this->m_mqtt_client.is_mqtt_connected() ) return;
 
-  mqtt_pubsub_config_table _mqtt_pubsub_configs;
-  __database_service.get_mqtt_pubsub_config_table(&_mqtt_pubsub_configs);
+  const mqtt_pubsub_config_table *_mqtt_pubsub_configs = __database_service.peek_mqtt_pubsub_config_table();
+  if( nullptr == _mqtt_pubsub_configs ) return;
 
   pdiutil::string mac_placeholder = CHARPTR_WRAP("[mac]");
+  char _topic[MQTT_TOPIC_BUF_SIZE];
 
   for (uint8_t i = 0; i < MQTT_MAX_SUBSCRIBE_TOPIC; i++) {
 
-    __find_and_replace( _mqtt_pubsub_configs.subscribe_topics[i].topic, mac_placeholder.c_str(), __i_dvc_ctrl.getDeviceMac().c_str(), 2, MQTT_TOPIC_BUF_SIZE );
+    if( 0 == _mqtt_pubsub_configs->subscribe_topics[i].topic[0] ) continue;
+    memcpy( _topic, _mqtt_pubsub_configs->subscribe_topics[i].topic, MQTT_TOPIC_BUF_SIZE );
+    _topic[MQTT_TOPIC_BUF_SIZE - 1] = 0;
+    __find_and_replace( _topic, mac_placeholder.c_str(), __i_dvc_ctrl.getDeviceMac().c_str(), 2, MQTT_TOPIC_BUF_SIZE );
 
-    if( strlen(_mqtt_pubsub_configs.subscribe_topics[i].topic) > 0 && !this->m_mqtt_client.is_topic_subscribed(_mqtt_pubsub_configs.subscribe_topics[i].topic) ){
+    if( strlen(_topic) > 0 && !this->m_mqtt_client.is_topic_subscribed(_topic) ){
 
       this->m_mqtt_client.Subscribe(
 
-        _mqtt_pubsub_configs.subscribe_topics[i].topic,
-        _mqtt_pubsub_configs.subscribe_topics[i].qos < MQTT_MAX_QOS_LEVEL ?
-        _mqtt_pubsub_configs.subscribe_topics[i].qos : MQTT_MAX_QOS_LEVEL
+        _topic,
+        _mqtt_pubsub_configs->subscribe_topics[i].qos < MQTT_MAX_QOS_LEVEL ?
+        _mqtt_pubsub_configs->subscribe_topics[i].qos : MQTT_MAX_QOS_LEVEL
       );
     }
   }
@@ -189,6 +275,8 @@ void MqttServiceProvider::handleMqttConfigChange( int _mqtt_config_type ){
   __database_service.get_mqtt_general_config_table(&_mqtt_general_configs);
   __database_service.get_mqtt_pubsub_config_table(&_mqtt_pubsub_configs);
 
+  this->compileMqttTemplates( &_mqtt_pubsub_configs );
+
   if( MQTT_GENERAL_CONFIG == _mqtt_config_type || MQTT_LWT_CONFIG == _mqtt_config_type ){
 
     this->m_mqtt_client.DeleteClient();
@@ -366,6 +454,32 @@ void MqttServiceProvider::printConfigToTerminal(iTerminalInterface *terminal)
   }
 }
 
+/**
+ * print how the qos 1/2 publishes are getting on to terminal
+ */
+void MqttServiceProvider::printStatusToTerminal(iTerminalInterface *terminal)
+{
+  if (nullptr == terminal) return;
+
+  const mqtt_stats_t &_stats = this->m_mqtt_client.stats();
+  terminal->write_ro(RODT_ATTR("  connected : "));
+  terminal->writeln_ro(this->m_mqtt_client.is_mqtt_connected() ? RODT_ATTR("yes") : RODT_ATTR("no"));
+  terminal->write_ro(RODT_ATTR("  spooled   : "));
+  terminal->writeln((int32_t)_stats.m_spooled);
+  terminal->write_ro(RODT_ATTR("  sent      : "));
+  terminal->writeln((int32_t)_stats.m_sent);
+  terminal->write_ro(RODT_ATTR("  acked     : "));
+  terminal->writeln((int32_t)_stats.m_acked);
+  terminal->write_ro(RODT_ATTR("  retried   : "));
+  terminal->writeln((int32_t)_stats.m_retried);
+  terminal->write_ro(RODT_ATTR("  dropped   : "));
+  terminal->writeln((int32_t)_stats.m_dropped);
+  terminal->write_ro(RODT_ATTR("  in flight : "));
+  terminal->writeln((int32_t)this->m_mqtt_client.inflight());
+  terminal->write_ro(RODT_ATTR("  spool     : "));
+  terminal->writeln((int32_t)this->m_mqtt_client.spooled());
+}
+
 
 MqttServiceProvider __mqtt_service;
 
@@ -18,6 +18,7 @@ created Date    : 1st June 2019
 #include <service_provider/device/GpioServiceProvider.h>
 #endif
 #include <transports/mqtt/MqttClient.h>
+#include <transports/mqtt/MqttTemplate.h>
 
 #define MQTT_PAYLOAD_BUF_SIZE 400
 
@@ -49,6 +50,7 @@ public:
   void setMqttSubscribeDataCallback(MqttSubscribeDataCallback _cb);
   void stop(void);
   void printConfigToTerminal(iTerminalInterface *terminal) override;
+  void printStatusToTerminal(iTerminalInterface *terminal) override;
 
   /**
    * @var	int|0 m_mqtt_timer_cb_id
@@ -85,6 +87,21 @@ public:
 
 protected:
 
+  void compileMqttTemplates(const mqtt_pubsub_config_table *_mqtt_pubsub_configs);
+  int32_t writeMqttSlot(uint8_t _slot, char *_out, uint16_t _size);
+
+  /**
+   * @array	MqttTemplate  m_publish_topics
+   */
+  MqttTemplate m_publish_topics[MQTT_MAX_PUBLISH_TOPIC];
+  /**
+   * @var	MqttTemplate  m_publish_payload
+   */
+  MqttTemplate m_publish_payload;
+  /**
+   * @var	pdiutil::string  m_device_mac
+   */
+  pdiutil::string m_device_mac;
 };
 
 extern MqttServiceProvider __mqtt_service;
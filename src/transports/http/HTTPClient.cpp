@@ -970,8 +970,8 @@ int16_t Http_Client::handleResponse()
                             m_client->readStringUntil(body, 0, false, nullptr, chunkSize);
                             
                             // consume trailing CRLF 
-                            pdiutil::string crlf;
-                            m_client->readLine(crlf, nullptr, 2);
+                            char crlf[2];
+                            m_client->readLine(crlf);
                         }
 
                         memset(m_response.response, 0, m_response.max_resp_length + 1);
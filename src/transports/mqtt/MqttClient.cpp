@@ -95,6 +95,29 @@ bool MQTTClient::is_mqtt_connected()
   return (isConnected(this->m_client) && this->m_mqttClient.mqtt_connected);
 }
 
+uint8_t MQTTClient::inflight() const
+{
+  uint8_t busy = 0;
+  for (uint8_t i = 0; i < MQTT_INFLIGHT_WINDOW; i++)
+  {
+    if (nullptr != this->m_mqttClient.inflight[i].packet)
+    {
+      busy++;
+    }
+  }
+  return busy;
+}
+
+uint32_t MQTTClient::spooled() const
+{
+  return this->m_spool.size();
+}
+
+const mqtt_stats_t &MQTTClient::stats() const
+{
+  return this->m_stats;
+}
+
 bool MQTTClient::is_topic_subscribed(char *_topic)
 {
   for (uint16_t i = 0; i < this->m_mqttClient.subscribed_topics.size(); i++)
@@ -183,6 +206,8 @@ void MQTTClient::deliver_publish(uint8_t *message, size_t length)
 
 void MQTTClient::mqtt_client_recv()
 {
+  mqtt_inflight_t *_slot = nullptr;
+
   if (nullptr == this->m_mqttClient.mqtt_state.in_buffer)
   {
     return;
@@ -235,6 +260,12 @@ void MQTTClient::mqtt_client_recv()
           {
             this->m_connectedCb((uint32_t *)this);
           }
+          // what was on the wire when the link went goes again, oldest first,
+          // and the spool carries on behind it
+          this->mqtt_retry_inflight(true);
+          while (MQTT_DATA == this->m_mqttClient.connState && this->mqtt_send_spooled())
+          {
+          }
         }
       }
       break;
@@ -306,9 +337,13 @@ void MQTTClient::mqtt_client_recv()
 
       case MQTT_MSG_TYPE_PUBACK:
 
-        if (MQTT_MSG_TYPE_PUBLISH == this->m_mqttClient.mqtt_state.pending_msg_type && this->m_mqttClient.mqtt_state.pending_msg_id == msg_id)
+        _slot = this->find_inflight(msg_id, MQTT_MSG_TYPE_PUBACK);
+        if (nullptr != _slot)
         {
           LogI("MQTT: received MQTT_MSG_TYPE_PUBACK, finish QoS1 publish\n");
+          this->release_inflight(_slot);
+          this->m_stats.m_acked++;
+          this->settle_spool();
           if (nullptr != this->m_publishedCb)
           {
             this->m_publishedCb((uint32_t *)this);
@@ -321,6 +356,18 @@ void MQTTClient::mqtt_client_recv()
 
         this->m_mqttClient.mqtt_state.outbound_message = mqtt_msg_pubrel(&this->m_mqttClient.mqtt_state.mqtt_connection, msg_id);
 
+        // the broker holds the publish now, so the slot keeps the pubrel
+        // instead, for the resend until pubcomp releases the id
+        _slot = this->find_inflight(msg_id, MQTT_MSG_TYPE_PUBREC);
+        if (nullptr != _slot && this->m_mqttClient.mqtt_state.outbound_message->length > 0)
+        {
+          memcpy(_slot->packet, this->m_mqttClient.mqtt_state.outbound_message->data, this->m_mqttClient.mqtt_state.outbound_message->length);
+          _slot->length = this->m_mqttClient.mqtt_state.outbound_message->length;
+          _slot->await = MQTT_MSG_TYPE_PUBCOMP;
+          _slot->retry_tick = 0;
+          this->settle_spool();
+        }
+
         if (QUEUE_Puts(&this->m_mqttClient.msgQueue, this->m_mqttClient.mqtt_state.outbound_message->data, this->m_mqttClient.mqtt_state.outbound_message->length) == -1)
         {
           LogW("MQTT: Queue full\n");
@@ -339,9 +386,12 @@ void MQTTClient::mqtt_client_recv()
 
       case MQTT_MSG_TYPE_PUBCOMP:
 
-        if (MQTT_MSG_TYPE_PUBLISH == this->m_mqttClient.mqtt_state.pending_msg_type && this->m_mqttClient.mqtt_state.pending_msg_id == msg_id)
+        _slot = this->find_inflight(msg_id, MQTT_MSG_TYPE_PUBCOMP);
+        if (nullptr != _slot)
         {
           LogI("MQTT: received MQTT_MSG_TYPE_PUBCOMP, finish QoS2 publish\n");
+          this->release_inflight(_slot);
+          this->m_stats.m_acked++;
           if (nullptr != this->m_publishedCb)
           {
             this->m_publishedCb((uint32_t *)this);
@@ -473,10 +523,6 @@ void MQTTClient::MQTT_Task()
 
   LogI("MQTT: Task %d\n", (int)this->m_mqttClient.connState);
 
-  uint8_t dataBuffer[MQTT_BUF_SIZE];
-  uint16_t dataLen;
-  memset(dataBuffer, 0, MQTT_BUF_SIZE);
-
   switch (this->m_mqttClient.connState)
   {
   default:
@@ -508,50 +554,251 @@ void MQTTClient::MQTT_Task()
     this->mqtt_send_keepalive();
     break;
   case MQTT_DATA:
-    // if ( QUEUE_IsEmpty(&this->m_mqttClient.msgQueue) || this->m_mqttClient.sendTimeout != 0 ) {
-    if (QUEUE_IsEmpty(&this->m_mqttClient.msgQueue))
+    // acknowledgements first, so the window has room before it is filled
+    for (uint8_t i = 0; i < 2 * MQTT_INFLIGHT_WINDOW && MQTT_DATA == this->m_mqttClient.connState; i++)
     {
+      if (nullptr == this->m_client || this->m_client->available() < 1)
+      {
+        break;
+      }
       this->mqtt_client_recv();
-      break;
     }
-    if (QUEUE_Gets(&this->m_mqttClient.msgQueue, dataBuffer, &dataLen, MQTT_BUF_SIZE) == 0)
+    while (MQTT_DATA == this->m_mqttClient.connState && this->mqtt_send_queued())
     {
-      LogI("MQTT: getting queue packets :");
-      for (int i = 0; i < dataLen; i++)
-      {
-        LogI("%c", (char)dataBuffer[i]);
-        __i_dvc_ctrl.wait(0);
-      }
-      LogI("\n");
+    }
+    while (MQTT_DATA == this->m_mqttClient.connState && this->mqtt_send_spooled())
+    {
+    }
+    break;
+  }
+  __i_dvc_ctrl.yield(); // yield purpose
+}
 
-      uint8_t msg_qos = mqtt_get_qos(dataBuffer);
-      uint8_t msg_type = mqtt_get_type(dataBuffer);
+/**
+ * sends one packet off the queue: a qos 0 publish, a subscription change or an
+ * acknowledgement the broker is owed
+ */
+bool MQTTClient::mqtt_send_queued()
+{
+  uint16_t dataLen = 0;
+  const uint8_t *dataBuffer = QUEUE_Peek(&this->m_mqttClient.msgQueue, &dataLen);
 
-      this->m_mqttClient.mqtt_state.pending_msg_type = msg_type;
-      this->m_mqttClient.mqtt_state.pending_msg_id = mqtt_get_id(dataBuffer, dataLen);
+  if (nullptr == dataBuffer)
+  {
+    return false;
+  }
 
-      this->m_mqttClient.sendTimeout = MQTT_SEND_TIMEOUT;
-      bool result = sendPacket(this->m_client, dataBuffer, dataLen);
+  LogI("MQTT: getting queue packets :");
+  for (int i = 0; i < dataLen; i++)
+  {
+    LogI("%c", (char)dataBuffer[i]);
+    __i_dvc_ctrl.wait(0);
+  }
+  LogI("\n");
 
-      if (result)
-      {
-        LogI("MQTT: data packet sent of id: %d\n", this->m_mqttClient.mqtt_state.pending_msg_id);
-        this->m_mqttClient.connState = (MQTT_MSG_TYPE_PUBLISH == msg_type && 0 == msg_qos) ? MQTT_DATA : MQTT_DATA_SENT;
-        this->m_mqttClient.readTimeout = 0;
-      }
-      else
+  uint8_t msg_type = mqtt_get_type(dataBuffer);
+
+  this->m_mqttClient.mqtt_state.pending_msg_type = msg_type;
+  this->m_mqttClient.mqtt_state.pending_msg_id = mqtt_get_id(dataBuffer, dataLen);
+
+  // sent from where it lies in the queue, and let go of either way as before
+  this->m_mqttClient.sendTimeout = MQTT_SEND_TIMEOUT;
+  bool result = sendPacket(this->m_client, (uint8_t *)dataBuffer, dataLen);
+  QUEUE_Consume(&this->m_mqttClient.msgQueue);
+
+  if (result)
+  {
+    LogI("MQTT: data packet sent of id: %d\n", this->m_mqttClient.mqtt_state.pending_msg_id);
+    // only a subscription change holds the line for its answer
+    this->m_mqttClient.connState = (MQTT_MSG_TYPE_SUBSCRIBE == msg_type || MQTT_MSG_TYPE_UNSUBSCRIBE == msg_type) ? MQTT_DATA_SENT : MQTT_DATA;
+    this->m_mqttClient.readTimeout = 0;
+  }
+  else
+  {
+    SysLogE("MQTT: data packet send failed\n");
+    this->m_mqttClient.connState = MQTT_DATA_FAILED;
+    this->m_mqttClient.host_connect_tick = 0;
+    this->disconnectServer();
+  }
+
+  this->m_mqttClient.mqtt_state.outbound_message = nullptr;
+  return result;
+}
+
+/**
+ * takes the next publish off the spool into a free in-flight slot and sends
+ * it under a fresh message id
+ */
+bool MQTTClient::mqtt_send_spooled()
+{
+  mqtt_inflight_t *slot = nullptr;
+  for (uint8_t i = 0; i < MQTT_INFLIGHT_WINDOW && nullptr == slot; i++)
+  {
+    if (nullptr == this->m_mqttClient.inflight[i].packet)
+    {
+      slot = &this->m_mqttClient.inflight[i];
+    }
+  }
+  if (nullptr == slot || 0 == this->m_spool.backlog())
+  {
+    return false;
+  }
+
+  uint8_t *packet = pdiutil::safe_new_array<uint8_t>(MQTT_BUF_SIZE);
+  if (nullptr == packet)
+  {
+    return false;
+  }
+  uint32_t offset = 0;
+  uint16_t length = this->m_spool.next(packet, MQTT_BUF_SIZE, offset);
+  if (0 == length)
+  {
+    pdiutil::safe_delete_array(packet);
+    return false;
+  }
+
+  slot->msg_id = this->next_msg_id();
+  mqtt_set_id(packet, length, slot->msg_id);
+  slot->packet = packet;
+  slot->length = length;
+  slot->await = (1 == mqtt_get_qos(packet)) ? MQTT_MSG_TYPE_PUBACK : MQTT_MSG_TYPE_PUBREC;
+  slot->retry_tick = 0;
+  slot->offset = offset;
+  slot->seq = ++this->m_mqttClient.inflight_seq;
+
+  LogI("MQTT: publish sent of id: %d, in flight: %d\n", slot->msg_id, this->inflight());
+  this->m_stats.m_sent++;
+  return this->mqtt_send_inflight(slot);
+}
+
+bool MQTTClient::mqtt_send_inflight(mqtt_inflight_t *slot)
+{
+  this->m_mqttClient.sendTimeout = MQTT_SEND_TIMEOUT;
+  if (sendPacket(this->m_client, slot->packet, slot->length))
+  {
+    this->m_mqttClient.readTimeout = 0;
+    return true;
+  }
+
+  // the slot keeps the packet; it goes again once the broker is back
+  SysLogE("MQTT: data packet send failed\n");
+  this->m_mqttClient.connState = MQTT_DATA_FAILED;
+  this->m_mqttClient.host_connect_tick = 0;
+  this->disconnectServer();
+  return false;
+}
+
+/**
+ * resends what has waited MQTT_RETRY_INTERVAL ticks for its acknowledgement,
+ * or everything in flight when all is set, oldest first either way
+ */
+void MQTTClient::mqtt_retry_inflight(bool all)
+{
+  uint32_t last = 0;
+  for (uint8_t n = 0; n < MQTT_INFLIGHT_WINDOW; n++)
+  {
+    mqtt_inflight_t *oldest = nullptr;
+    for (uint8_t i = 0; i < MQTT_INFLIGHT_WINDOW; i++)
+    {
+      mqtt_inflight_t *slot = &this->m_mqttClient.inflight[i];
+      if (nullptr != slot->packet && slot->seq > last && (nullptr == oldest || slot->seq < oldest->seq))
       {
-        SysLogE("MQTT: data packet send failed\n");
-        this->m_mqttClient.connState = MQTT_DATA_FAILED;
-        this->m_mqttClient.host_connect_tick = 0;
-        this->disconnectServer();
+        oldest = slot;
       }
+    }
+    if (nullptr == oldest)
+    {
+      break;
+    }
+    last = oldest->seq;
 
-      this->m_mqttClient.mqtt_state.outbound_message = nullptr;
+    if (!all && ++oldest->retry_tick < MQTT_RETRY_INTERVAL)
+    {
+      continue;
+    }
+    oldest->retry_tick = 0;
+    if (MQTT_MSG_TYPE_PUBLISH == mqtt_get_type(oldest->packet))
+    {
+      mqtt_set_dup(oldest->packet);
+    }
+    LogI("MQTT: resending id: %d\n", oldest->msg_id);
+    this->m_stats.m_retried++;
+    if (!this->mqtt_send_inflight(oldest))
+    {
+      break;
     }
-    break;
   }
-  __i_dvc_ctrl.yield(); // yield purpose
+}
+
+/**
+ * the slot in flight under msg_id, waiting on await, or on anything when await
+ * is 0
+ */
+mqtt_inflight_t *MQTTClient::find_inflight(uint16_t msg_id, uint8_t await)
+{
+  for (uint8_t i = 0; i < MQTT_INFLIGHT_WINDOW; i++)
+  {
+    mqtt_inflight_t *slot = &this->m_mqttClient.inflight[i];
+    if (nullptr != slot->packet && slot->msg_id == msg_id && (0 == await || slot->await == await))
+    {
+      return slot;
+    }
+  }
+  return nullptr;
+}
+
+void MQTTClient::release_inflight(mqtt_inflight_t *slot)
+{
+  pdiutil::safe_delete_array(slot->packet);
+  memset(slot, 0, sizeof(mqtt_inflight_t));
+}
+
+/**
+ * the spool keeps everything from the oldest publish the broker has not yet
+ * taken; past that it can let go
+ */
+void MQTTClient::settle_spool()
+{
+  uint32_t head = this->m_spool.cursor();
+  for (uint8_t i = 0; i < MQTT_INFLIGHT_WINDOW; i++)
+  {
+    mqtt_inflight_t *slot = &this->m_mqttClient.inflight[i];
+    if (nullptr != slot->packet && MQTT_MSG_TYPE_PUBCOMP != slot->await && slot->offset < head)
+    {
+      head = slot->offset;
+    }
+  }
+  this->m_spool.settle(head);
+}
+
+uint16_t MQTTClient::next_msg_id()
+{
+  uint16_t msg_id;
+  do
+  {
+    msg_id = ++this->m_mqttClient.mqtt_state.mqtt_connection.message_id;
+  } while (0 == msg_id || nullptr != this->find_inflight(msg_id, 0));
+  return msg_id;
+}
+
+/**
+ * zeroes the client state field by field; the subscribed topics are a vector,
+ * which a memset of the whole struct would leak
+ */
+void MQTTClient::mqtt_client_reset()
+{
+  this->clear_all_subscribed_topics();
+  memset(&this->m_mqttClient.mqtt_state, 0, sizeof(mqtt_state_t));
+  memset(&this->m_mqttClient.connect_info, 0, sizeof(mqtt_connect_info_t));
+  memset(&this->m_mqttClient.msgQueue, 0, sizeof(QUEUE));
+  memset(this->m_mqttClient.inflight, 0, sizeof(this->m_mqttClient.inflight));
+  this->m_mqttClient.inflight_seq = 0;
+  this->m_mqttClient.keepAliveTick = 0;
+  this->m_mqttClient.sendTimeout = 0;
+  this->m_mqttClient.readTimeout = 0;
+  this->m_mqttClient.connState = MQTT_PUBLISH_RECV;
+  this->m_mqttClient.host_connect_tick = 0;
+  this->m_mqttClient.mqtt_connected = false;
 }
 
 void MQTTClient::mqtt_client_delete()
@@ -581,6 +828,12 @@ void MQTTClient::mqtt_client_delete()
 
   pdiutil::safe_delete_array(this->m_mqttClient.msgQueue.buf);
 
+  for (uint8_t i = 0; i < MQTT_INFLIGHT_WINDOW; i++)
+  {
+    this->release_inflight(&this->m_mqttClient.inflight[i]);
+  }
+  this->m_spool.close();
+
   if (nullptr != this->m_client)
   {
     // delete this->m_client;
@@ -595,10 +848,6 @@ void MQTTClient::mqtt_client_delete()
 bool MQTTClient::Subscribe(char *topic, uint8_t qos)
 {
 
-  uint8_t dataBuffer[MQTT_BUF_SIZE];
-  uint16_t dataLen;
-  memset(dataBuffer, 0, MQTT_BUF_SIZE);
-
   if (!isConnected(this->m_client))
   {
     return false;
@@ -614,7 +863,7 @@ bool MQTTClient::Subscribe(char *topic, uint8_t qos)
   while (QUEUE_Puts(&this->m_mqttClient.msgQueue, this->m_mqttClient.mqtt_state.outbound_message->data, this->m_mqttClient.mqtt_state.outbound_message->length) == -1)
   {
     LogW("MQTT: Queue full\n");
-    if (QUEUE_Gets(&this->m_mqttClient.msgQueue, dataBuffer, &dataLen, MQTT_BUF_SIZE) == -1)
+    if (!QUEUE_Consume(&this->m_mqttClient.msgQueue))
     {
       SysLogE("MQTT: Serious buffer error\n");
       return false;
@@ -632,10 +881,6 @@ bool MQTTClient::Subscribe(char *topic, uint8_t qos)
 bool MQTTClient::UnSubscribe(char *topic)
 {
 
-  uint8_t dataBuffer[MQTT_BUF_SIZE];
-  uint16_t dataLen;
-  memset(dataBuffer, 0, MQTT_BUF_SIZE);
-
   this->m_mqttClient.mqtt_state.outbound_message = mqtt_msg_unsubscribe(&this->m_mqttClient.mqtt_state.mqtt_connection,
                                                                         topic,
                                                                         &this->m_mqttClient.mqtt_state.pending_msg_id);
@@ -645,7 +890,7 @@ bool MQTTClient::UnSubscribe(char *topic)
   while (QUEUE_Puts(&this->m_mqttClient.msgQueue, this->m_mqttClient.mqtt_state.outbound_message->data, this->m_mqttClient.mqtt_state.outbound_message->length) == -1)
   {
     LogW("MQTT: Queue full\n");
-    if (QUEUE_Gets(&this->m_mqttClient.msgQueue, dataBuffer, &dataLen, MQTT_BUF_SIZE) == -1)
+    if (!QUEUE_Consume(&this->m_mqttClient.msgQueue))
     {
       SysLogE("MQTT: Serious buffer error\n");
       return false;
@@ -660,11 +905,9 @@ bool MQTTClient::UnSubscribe(char *topic)
 bool MQTTClient::Publish(const char *topic, const char *data, size_t data_length, uint8_t qos, uint8_t retain)
 {
 
-  uint8_t dataBuffer[MQTT_BUF_SIZE];
-  uint16_t dataLen;
-  memset(dataBuffer, 0, MQTT_BUF_SIZE);
-
-  if (!isConnected(this->m_client))
+  // qos 0 is at most once, so with no link there is nowhere for it to go. the
+  // others wait in the spool for the broker.
+  if ((0 == qos && !isConnected(this->m_client)) || nullptr == this->m_mqttClient.mqtt_state.out_buffer)
   {
     return false;
   }
@@ -674,16 +917,50 @@ bool MQTTClient::Publish(const char *topic, const char *data, size_t data_length
                                                                     topic, data, data_length,
                                                                     qos, retain,
                                                                     &this->m_mqttClient.mqtt_state.pending_msg_id);
-  if (0 == this->m_mqttClient.mqtt_state.outbound_message->length)
+  return this->mqtt_queue_publish(qos);
+}
+
+bool MQTTClient::Publish(const mqtt_msg_writer_t &topic, const mqtt_msg_writer_t &data, uint8_t qos, uint8_t retain)
+{
+
+  if ((0 == qos && !isConnected(this->m_client)) || nullptr == this->m_mqttClient.mqtt_state.out_buffer)
+  {
+    return false;
+  }
+
+  this->m_mqttClient.mqtt_state.outbound_message = mqtt_msg_publish_with(&this->m_mqttClient.mqtt_state.mqtt_connection,
+                                                                         topic, data,
+                                                                         qos, retain,
+                                                                         &this->m_mqttClient.mqtt_state.pending_msg_id);
+  return this->mqtt_queue_publish(qos);
+}
+
+/**
+ * hands the publish just built to the spool, or to the queue for qos 0
+ */
+bool MQTTClient::mqtt_queue_publish(uint8_t qos)
+{
+  if (nullptr == this->m_mqttClient.mqtt_state.outbound_message || 0 == this->m_mqttClient.mqtt_state.outbound_message->length)
   {
     SysLogE("MQTT: Queuing publish failed\n");
     return false;
   }
-  LogI("MQTT: queuing publish, length: %d, queue size(%d/%d)\r\n", this->m_mqttClient.mqtt_state.outbound_message->length, this->m_mqttClient.msgQueue.rb.fill_cnt, this->m_mqttClient.msgQueue.rb.size);
+  if (qos > 0)
+  {
+    if (!this->m_spool.push(this->m_mqttClient.mqtt_state.outbound_message->data, this->m_mqttClient.mqtt_state.outbound_message->length))
+    {
+      SysLogE("MQTT: spooling publish failed\n");
+      this->m_stats.m_dropped++;
+      return false;
+    }
+    this->m_stats.m_spooled++;
+    return true;
+  }
+  LogI("MQTT: queuing publish, length: %d, queue size(%d/%d)\r\n", this->m_mqttClient.mqtt_state.outbound_message->length, (int)QUEUE_Used(&this->m_mqttClient.msgQueue), (int)this->m_mqttClient.msgQueue.rb.size);
   while (QUEUE_Puts(&this->m_mqttClient.msgQueue, this->m_mqttClient.mqtt_state.outbound_message->data, this->m_mqttClient.mqtt_state.outbound_message->length) == -1)
   {
     LogW("MQTT: Queue full\n");
-    if (QUEUE_Gets(&this->m_mqttClient.msgQueue, dataBuffer, &dataLen, MQTT_BUF_SIZE) == -1)
+    if (!QUEUE_Consume(&this->m_mqttClient.msgQueue))
     {
       SysLogE("MQTT: Serious buffer error\n");
       return false;
@@ -706,6 +983,8 @@ MQTTClient::MQTTClient() : m_mqttDataCallbackArgs(reinterpret_cast<uint32_t *>(t
                            m_timeoutCb(nullptr),
                            m_dataCb(nullptr)
 {
+  memset(&this->m_stats, 0, sizeof(mqtt_stats_t));
+  this->mqtt_client_reset();
 }
 
 MQTTClient::~MQTTClient()
@@ -776,7 +1055,7 @@ void MQTTClient::InitConnection(char *host, pdiutil::net_port_t port, uint8_t se
   LogI("MQTT: InitConnection\n");
 
   int _host_len = strlen(host);
-  memset(&this->m_mqttClient, 0, sizeof(MQTT_Client));
+  this->mqtt_client_reset();
   this->m_host = pdiutil::safe_new_array<char>(_host_len + 1);
 
   if (nullptr != this->m_host)
@@ -851,6 +1130,7 @@ void MQTTClient::InitClient(char *client_id, char *client_user, char *client_pas
   mqtt_msg_init(&this->m_mqttClient.mqtt_state.mqtt_connection, this->m_mqttClient.mqtt_state.out_buffer, this->m_mqttClient.mqtt_state.out_buffer_length);
 
   QUEUE_Init(&this->m_mqttClient.msgQueue, QUEUE_BUFFER_SIZE);
+  this->m_spool.open(MQTT_SPOOL_FILE);
 
   // this->MQTT_Task();
 }
@@ -902,9 +1182,10 @@ void MQTTClient::mqtt_timer()
 
   if (MQTT_DATA == this->m_mqttClient.connState)
   {
+    this->mqtt_retry_inflight(false);
     this->m_mqttClient.keepAliveTick++;
     int _keep_alive = this->m_mqttClient.mqtt_state.connect_info->keepalive * 0.85;
-    if (this->m_mqttClient.keepAliveTick > _keep_alive)
+    if (MQTT_DATA == this->m_mqttClient.connState && this->m_mqttClient.keepAliveTick > _keep_alive)
     {
       this->m_mqttClient.connState = MQTT_KEEPALIVE_REQ;
     }
@@ -15,6 +15,7 @@ created Date    : 1st June 2019
 #include <interface/pdi.h>
 #include <helpers/ClientHelper.h>
 #include "Mqtt_msg.h"
+#include "MqttSpool.h"
 
 typedef enum
 {
@@ -83,6 +84,34 @@ typedef struct
 	uint8_t pending_publish_qos;
 } mqtt_state_t;
 
+/**
+ * A QoS 1/2 publish on the wire. The slot holds what was sent so it can go
+ * again, and is free while packet is null. A QoS 2 publish swaps its packet
+ * for the pubrel once the broker has recorded it.
+ */
+typedef struct
+{
+	uint8_t *packet;
+	uint16_t length;
+	uint16_t msg_id;
+	uint8_t await;
+	uint8_t retry_tick;
+	uint32_t offset;
+	uint32_t seq;
+} mqtt_inflight_t;
+
+/**
+ * publish counters since the client was created
+ */
+typedef struct
+{
+	uint32_t m_spooled;
+	uint32_t m_sent;
+	uint32_t m_acked;
+	uint32_t m_retried;
+	uint32_t m_dropped;
+} mqtt_stats_t;
+
 typedef void (*MqttCallback)(uint32_t *args);
 typedef void (*MqttDataCallback)(uint32_t *args, const char *topic, uint32_t topic_len, const char *data, uint32_t lengh);
 
@@ -96,6 +125,8 @@ typedef struct
 	uint32_t readTimeout;
 	tConnState connState;
 	QUEUE msgQueue;
+	mqtt_inflight_t inflight[MQTT_INFLIGHT_WINDOW];
+	uint32_t inflight_seq;
 	uint16_t host_connect_tick;
 	pdiutil::vector<mqtt_subscribed_topics_t> subscribed_topics;
 	bool mqtt_connected;
@@ -133,12 +164,20 @@ public:
 	void Connect(void);
 	void Disconnect(void);
 	bool Publish(const char *topic, const char *data, size_t data_length, uint8_t qos, uint8_t retain);
+	/**
+	 * @brief Publishes with the topic and payload written by the writers
+	 * straight into the packet being built.
+	 */
+	bool Publish(const mqtt_msg_writer_t &topic, const mqtt_msg_writer_t &data, uint8_t qos, uint8_t retain);
 	void DeleteClient(void);
 
 	void mqtt_timer(void);
 	void MQTT_Task(void);
 
 	bool is_mqtt_connected(void);
+	uint8_t inflight(void) const;
+	uint32_t spooled(void) const;
+	const mqtt_stats_t &stats(void) const;
 	bool is_topic_subscribed(char *_topic);
 	void clear_all_subscribed_topics(void);
 	void add_to_subscribed_topics(char *_topic, uint8_t _qos);
@@ -153,6 +192,8 @@ protected:
 	uint8_t m_security;
 
 	iClientInterface *m_client;
+	MqttSpool m_spool;
+	mqtt_stats_t m_stats;
 
 	MqttCallback m_connectedCb;
 	MqttCallback m_disconnectedCb;
@@ -166,12 +207,22 @@ protected:
 	uint16_t readFullPacket(uint8_t *buffer, uint16_t maxsize, uint16_t timeout);
 
 	void mqtt_client_delete(void);
+	void mqtt_client_reset(void);
 	void mqtt_send_keepalive(void);
 	void mqtt_client_connect(void);
 	void mqtt_client_disconnect(void);
 	// void mqtt_wificlient_delete( void );
 	void mqtt_client_recv(void);
 	void deliver_publish(uint8_t *message, size_t length);
+	bool mqtt_queue_publish(uint8_t qos);
+	bool mqtt_send_queued(void);
+	bool mqtt_send_spooled(void);
+	bool mqtt_send_inflight(mqtt_inflight_t *slot);
+	void mqtt_retry_inflight(bool all);
+	mqtt_inflight_t *find_inflight(uint16_t msg_id, uint8_t await);
+	void release_inflight(mqtt_inflight_t *slot);
+	void settle_spool(void);
+	uint16_t next_msg_id(void);
 };
 
 #endif
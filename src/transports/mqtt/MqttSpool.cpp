@@ -0,0 +1,349 @@
+/******************************** MQTT Spool **********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+#include <config/Config.h>
+
+#if defined(ENABLE_MQTT_SERVICE)
+
+#include "MqttSpool.h"
+
+#ifdef ENABLE_STORAGE_SERVICE
+
+#include <interface/pdi/impl/modules/storage/VfsDispatcher.h>
+
+#define MQTT_SPOOL_RECORD_HEADER 2
+#define MQTT_SPOOL_COPY_BLOCK 128
+
+/**
+ * what the spool attribute holds: the running offset of the file's first byte
+ * and of the first record the broker has not acknowledged
+ */
+typedef struct
+{
+  uint32_t base;
+  uint32_t head;
+} mqtt_spool_mark_t;
+
+MqttSpool::MqttSpool() : m_base(0),
+                         m_head(0),
+                         m_send(0),
+                         m_tail(0)
+{
+}
+
+MqttSpool::~MqttSpool()
+{
+}
+
+bool MqttSpool::open(const char *path)
+{
+  this->close();
+  if (nullptr == path)
+  {
+    return false;
+  }
+  this->m_path = path;
+
+  int64_t size = __i_fs.getFileSize(path);
+  if (size < 0)
+  {
+    size_t slash = this->m_path.rfind('/');
+    if (slash != pdiutil::string::npos && slash > 0)
+    {
+      pdiutil::string dir = this->m_path.substr(0, slash);
+      if (!__i_fs.isDirExist(dir.c_str()))
+      {
+        __i_fs.createDirectory(dir.c_str());
+      }
+    }
+    return true;
+  }
+
+  mqtt_spool_mark_t mark = {0, 0};
+  if (sizeof(mark) == __i_fs.getFileAttr(path, MQTT_SPOOL_ATTR, &mark, sizeof(mark)))
+  {
+    this->m_base = mark.base;
+    this->m_head = mark.head;
+  }
+  this->m_tail = this->m_base + (uint32_t)size;
+  if (this->m_head < this->m_base || this->m_head > this->m_tail)
+  {
+    this->m_head = this->m_base;
+  }
+  this->m_send = this->m_head;
+  LogI("MQTT: spool holds %d bytes\n", (int)(this->m_tail - this->m_head));
+  return true;
+}
+
+void MqttSpool::close()
+{
+  this->m_path.clear();
+  this->m_base = this->m_head = this->m_send = this->m_tail = 0;
+}
+
+bool MqttSpool::push(const uint8_t *packet, uint16_t length)
+{
+  if (this->m_path.empty() || nullptr == packet || 0 == length)
+  {
+    return false;
+  }
+
+  uint32_t need = MQTT_SPOOL_RECORD_HEADER + length;
+  if (this->m_tail - this->m_base + need > MQTT_SPOOL_MAX_SIZE)
+  {
+    this->compact();
+    if (this->m_tail - this->m_base + need > MQTT_SPOOL_MAX_SIZE)
+    {
+      LogW("MQTT: spool full\n");
+      return false;
+    }
+  }
+
+  // written at the tail rather than appended, so a record torn by a failed
+  // write is overwritten by the next one instead of being read back
+  int16_t fd = __i_fs.openFile(this->m_path.c_str(), FILE_OPEN_WRITE | FILE_OPEN_CREATE);
+  if (fd < 0)
+  {
+    return false;
+  }
+  uint8_t header[MQTT_SPOOL_RECORD_HEADER] = {(uint8_t)(length >> 8), (uint8_t)(length & 0xff)};
+  bool written = __i_fs.seekHandle(fd, this->m_tail - this->m_base, FILE_SEEK_SET) >= 0 &&
+                 MQTT_SPOOL_RECORD_HEADER == __i_fs.writeHandle(fd, (const char *)header, MQTT_SPOOL_RECORD_HEADER) &&
+                 length == __i_fs.writeHandle(fd, (const char *)packet, length);
+  if (PDI_OK != __i_fs.closeFile(fd))
+  {
+    written = false;
+  }
+  if (written)
+  {
+    this->m_tail += need;
+  }
+  return written;
+}
+
+uint16_t MqttSpool::next(uint8_t *buffer, uint16_t size, uint32_t &offset)
+{
+  if (this->m_send >= this->m_tail || nullptr == buffer)
+  {
+    return 0;
+  }
+
+  int16_t fd = __i_fs.openFile(this->m_path.c_str(), FILE_OPEN_READ);
+  if (fd < 0)
+  {
+    return 0;
+  }
+
+  uint8_t header[MQTT_SPOOL_RECORD_HEADER];
+  uint16_t length = 0;
+  bool damaged = false;
+  while (0 == length && !damaged && this->m_send < this->m_tail)
+  {
+    if (__i_fs.seekHandle(fd, this->m_send - this->m_base, FILE_SEEK_SET) < 0 ||
+        MQTT_SPOOL_RECORD_HEADER != __i_fs.readHandle(fd, (char *)header, MQTT_SPOOL_RECORD_HEADER))
+    {
+      damaged = true;
+      break;
+    }
+
+    length = ((uint16_t)header[0] << 8) | header[1];
+    if (0 == length || this->m_send + MQTT_SPOOL_RECORD_HEADER + length > this->m_tail)
+    {
+      damaged = true;
+    }
+    else if (length > size)
+    {
+      // whole but too big to hand out; stepping past it leaves it to settle
+      // with the records around it and keeps the ones queued after it
+      SysLogE("MQTT: spool record at %d is %d bytes, skipped\n", (int)this->m_send, (int)length);
+      this->m_send += MQTT_SPOOL_RECORD_HEADER + length;
+      length = 0;
+    }
+    else if (length != __i_fs.readHandle(fd, (char *)buffer, length))
+    {
+      damaged = true;
+    }
+  }
+  __i_fs.closeFile(fd);
+
+  if (damaged)
+  {
+    // a torn record from a write cut short; the next push takes its place
+    SysLogE("MQTT: spool record at %d is damaged\n", (int)this->m_send);
+    this->m_tail = this->m_send;
+    return 0;
+  }
+  if (0 == length)
+  {
+    return 0;
+  }
+
+  offset = this->m_send;
+  this->m_send += MQTT_SPOOL_RECORD_HEADER + length;
+  return length;
+}
+
+void MqttSpool::settle(uint32_t head)
+{
+  if (head <= this->m_head || head > this->m_send)
+  {
+    return;
+  }
+  this->m_head = head;
+
+  if (this->m_head == this->m_tail)
+  {
+    __i_fs.deleteFile(this->m_path.c_str());
+    this->m_base = this->m_head;
+    return;
+  }
+  this->mark();
+}
+
+uint32_t MqttSpool::cursor() const
+{
+  return this->m_send;
+}
+
+uint32_t MqttSpool::backlog() const
+{
+  return this->m_tail - this->m_send;
+}
+
+uint32_t MqttSpool::size() const
+{
+  return this->m_tail - this->m_head;
+}
+
+/**
+ * records the broker has taken are dropped from the front of the file by
+ * copying the rest to a new one, which then replaces it
+ */
+bool MqttSpool::compact()
+{
+  if (this->m_head == this->m_base)
+  {
+    return false;
+  }
+
+  pdiutil::string temp = this->m_path + "~";
+  int16_t in = __i_fs.openFile(this->m_path.c_str(), FILE_OPEN_READ);
+  int16_t out = __i_fs.openFile(temp.c_str(), FILE_OPEN_WRITE | FILE_OPEN_CREATE | FILE_OPEN_TRUNC);
+  bool copied = in >= 0 && out >= 0 && __i_fs.seekHandle(in, this->m_head - this->m_base, FILE_SEEK_SET) >= 0;
+
+  char block[MQTT_SPOOL_COPY_BLOCK];
+  uint32_t left = this->m_tail - this->m_head;
+  while (copied && left > 0)
+  {
+    int32_t n = __i_fs.readHandle(in, block, left < sizeof(block) ? left : sizeof(block));
+    copied = n > 0 && n == __i_fs.writeHandle(out, block, n);
+    left -= copied ? n : 0;
+  }
+  if (in >= 0)
+  {
+    __i_fs.closeFile(in);
+  }
+  if (out >= 0 && PDI_OK != __i_fs.closeFile(out))
+  {
+    copied = false;
+  }
+
+  mqtt_spool_mark_t mark = {this->m_head, this->m_head};
+  if (copied && __i_fs.setFileAttr(temp.c_str(), MQTT_SPOOL_ATTR, &mark, sizeof(mark)) < 0)
+  {
+    copied = false;
+  }
+  if (copied && PDI_OK != __i_fs.rename(temp.c_str(), this->m_path.c_str()))
+  {
+    __i_fs.deleteFile(this->m_path.c_str());
+    copied = (PDI_OK == __i_fs.rename(temp.c_str(), this->m_path.c_str()));
+  }
+  if (!copied)
+  {
+    __i_fs.deleteFile(temp.c_str());
+    return false;
+  }
+
+  this->m_base = this->m_head;
+  return true;
+}
+
+void MqttSpool::mark()
+{
+  mqtt_spool_mark_t mark = {this->m_base, this->m_head};
+  __i_fs.setFileAttr(this->m_path.c_str(), MQTT_SPOOL_ATTR, &mark, sizeof(mark));
+}
+
+#else
+
+MqttSpool::MqttSpool()
+{
+  memset(&this->m_queue, 0, sizeof(QUEUE));
+}
+
+MqttSpool::~MqttSpool()
+{
+  this->close();
+}
+
+bool MqttSpool::open(const char *path)
+{
+  this->close();
+  QUEUE_Init(&this->m_queue, MQTT_SPOOL_RAM_SIZE);
+  return nullptr != this->m_queue.buf;
+}
+
+void MqttSpool::close()
+{
+  pdiutil::safe_delete_array(this->m_queue.buf);
+  memset(&this->m_queue, 0, sizeof(QUEUE));
+}
+
+bool MqttSpool::push(const uint8_t *packet, uint16_t length)
+{
+  if (nullptr == this->m_queue.buf)
+  {
+    return false;
+  }
+  return -1 != QUEUE_Puts(&this->m_queue, packet, length);
+}
+
+uint16_t MqttSpool::next(uint8_t *buffer, uint16_t size, uint32_t &offset)
+{
+  uint16_t length = 0;
+  offset = 0;
+  if (nullptr == this->m_queue.buf || -1 == QUEUE_Gets(&this->m_queue, buffer, &length, size))
+  {
+    return 0;
+  }
+  return length;
+}
+
+void MqttSpool::settle(uint32_t head)
+{
+}
+
+uint32_t MqttSpool::cursor() const
+{
+  return 0;
+}
+
+uint32_t MqttSpool::backlog() const
+{
+  return nullptr != this->m_queue.buf ? QUEUE_Used(&this->m_queue) : 0;
+}
+
+uint32_t MqttSpool::size() const
+{
+  return this->backlog();
+}
+
+#endif
+
+#endif
@@ -0,0 +1,83 @@
+/******************************** MQTT Spool **********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+QoS 1/2 publishes waiting for the broker. Each one is appended to the spool
+file as a two byte length and the packet, and stays there until the broker has
+acknowledged it. Records are addressed by a running offset that survives the
+file being compacted: the file attribute MQTT_SPOOL_ATTR keeps the offset of
+its first byte and the offset of the first record the broker does not have, so
+after a reboot the client starts again from the first unacknowledged publish.
+A spool that drains completely is deleted. Without the storage service the
+spool is a ring in RAM and lives only as long as the client.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+#ifndef MQTT_SPOOL_H
+#define MQTT_SPOOL_H
+
+#include <interface/pdi.h>
+
+class MqttSpool
+{
+
+public:
+	MqttSpool();
+	~MqttSpool();
+
+	/**
+	 * @brief Picks up the spool left at path, creating its directory if needed.
+	 */
+	bool open(const char *path = MQTT_SPOOL_FILE);
+	/**
+	 * @brief Lets go of the spool. What the broker has not acknowledged stays.
+	 */
+	void close(void);
+
+	/**
+	 * @brief Appends a packet. False when it does not fit or cannot be written.
+	 */
+	bool push(const uint8_t *packet, uint16_t length);
+	/**
+	 * @brief Hands out the next packet not handed out yet.
+	 * @param offset Set to where the packet sits, for settle.
+	 * @return The packet length, 0 when there is none.
+	 */
+	uint16_t next(uint8_t *buffer, uint16_t size, uint32_t &offset);
+	/**
+	 * @brief Drops every packet before head; the broker has them.
+	 */
+	void settle(uint32_t head);
+
+	/**
+	 * @brief Where the next packet handed out will come from.
+	 */
+	uint32_t cursor(void) const;
+	/**
+	 * @brief Bytes pushed but not handed out yet.
+	 */
+	uint32_t backlog(void) const;
+	/**
+	 * @brief Bytes the broker has not acknowledged yet.
+	 */
+	uint32_t size(void) const;
+
+protected:
+#ifdef ENABLE_STORAGE_SERVICE
+	bool compact(void);
+	void mark(void);
+
+	pdiutil::string m_path;
+	uint32_t m_base;
+	uint32_t m_head;
+	uint32_t m_send;
+	uint32_t m_tail;
+#else
+	QUEUE m_queue;
+#endif
+};
+
+#endif
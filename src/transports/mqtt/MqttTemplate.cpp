@@ -0,0 +1,155 @@
+/****************************** MQTT Template *********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+#include <config/Config.h>
+
+#if defined(ENABLE_MQTT_SERVICE)
+
+#include "MqttTemplate.h"
+
+/**
+ * placeholders in slot order, starting at MQTT_SLOT_MAC
+ */
+static const char *const mqtt_template_placeholders[MQTT_SLOT_MAX - 1] = {
+    "[mac]",
+    "[ip]",
+    "[epoch]",
+    "[gpio]",
+};
+
+/**
+ * the slot of the placeholder text starts with, if any, and how long it is
+ */
+uint8_t MqttTemplate::match(const char *text, uint16_t length, uint16_t &skip)
+{
+  if (0 == length || '[' != text[0])
+  {
+    return MQTT_SLOT_TEXT;
+  }
+  for (uint8_t i = 0; i < MQTT_SLOT_MAX - 1; i++)
+  {
+    uint16_t len = strlen(mqtt_template_placeholders[i]);
+    if (len <= length && 0 == memcmp(text, mqtt_template_placeholders[i], len))
+    {
+      skip = len;
+      return i + 1;
+    }
+  }
+  return MQTT_SLOT_TEXT;
+}
+
+void MqttTemplate::compile(const char *text, uint16_t length)
+{
+  clear();
+  if (nullptr == text)
+  {
+    return;
+  }
+
+  m_text.reserve(length);
+  for (uint16_t i = 0; i < length;)
+  {
+    uint16_t skip = 0;
+    uint8_t slot = match(text + i, length - i, skip);
+    if (MQTT_SLOT_TEXT != slot)
+    {
+      m_parts.push_back({0, 0, slot});
+      i += skip;
+      continue;
+    }
+
+    // grow the literal run before this one rather than start another
+    if (m_parts.empty() || MQTT_SLOT_TEXT != m_parts.back().slot)
+    {
+      m_parts.push_back({(uint16_t)m_text.size(), 0, MQTT_SLOT_TEXT});
+    }
+    m_text.push_back(text[i++]);
+    m_parts.back().length++;
+  }
+}
+
+void MqttTemplate::clear(void)
+{
+  m_text.clear();
+  m_parts.clear();
+}
+
+bool MqttTemplate::empty(void) const
+{
+  return m_parts.empty();
+}
+
+bool MqttTemplate::uses(uint8_t slot) const
+{
+  for (uint16_t i = 0; i < m_parts.size(); i++)
+  {
+    if (slot == m_parts[i].slot)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+int32_t MqttTemplate::render(char *out, uint16_t size, const MqttSlotWriter &slots) const
+{
+  uint16_t used = 0;
+  for (uint16_t i = 0; i < m_parts.size(); i++)
+  {
+    const mqtt_template_part_t &part = m_parts[i];
+    if (MQTT_SLOT_TEXT == part.slot)
+    {
+      if (part.length > size - used)
+      {
+        return PDI_ERR_OVERFLOW;
+      }
+      memcpy(out + used, m_text.c_str() + part.offset, part.length);
+      used += part.length;
+      continue;
+    }
+
+    int32_t written = slots ? slots(part.slot, out + used, size - used) : 0;
+    if (written < 0)
+    {
+      return written;
+    }
+    used += written;
+  }
+  return used;
+}
+
+int32_t MqttTemplate::expand(const char *text, uint16_t length, char *out, uint16_t size, const MqttSlotWriter &slots)
+{
+  uint16_t used = 0;
+  for (uint16_t i = 0; i < length;)
+  {
+    uint16_t skip = 0;
+    uint8_t slot = match(text + i, length - i, skip);
+    if (MQTT_SLOT_TEXT == slot)
+    {
+      if (used >= size)
+      {
+        return PDI_ERR_OVERFLOW;
+      }
+      out[used++] = text[i++];
+      continue;
+    }
+
+    int32_t written = slots ? slots(slot, out + used, size - used) : 0;
+    if (written < 0)
+    {
+      return written;
+    }
+    used += written;
+    i += skip;
+  }
+  return used;
+}
+
+#endif
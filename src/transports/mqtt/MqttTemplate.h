@@ -0,0 +1,85 @@
+/****************************** MQTT Template *********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+A topic or payload with placeholders in it, such as "pdi/[mac]/state". It is
+compiled once, when the text changes, into runs of literal text and slots for
+the placeholders. Rendering is then one pass that copies the runs and has the
+owner write each slot's value in its place, straight into the packet being
+built rather than into a copy that is searched and patched afterwards.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+#ifndef MQTT_TEMPLATE_H
+#define MQTT_TEMPLATE_H
+
+#include <interface/pdi.h>
+
+/**
+ * what a placeholder stands for. text is a literal run, not a placeholder.
+ */
+enum mqtt_template_slot : uint8_t {
+  MQTT_SLOT_TEXT = 0,
+  MQTT_SLOT_MAC,   // [mac]
+  MQTT_SLOT_IP,    // [ip]
+  MQTT_SLOT_EPOCH, // [epoch]
+  MQTT_SLOT_GPIO,  // [gpio]
+  MQTT_SLOT_MAX
+};
+
+/**
+ * writes a slot's value into out, returning the bytes written or a negative
+ * PDI_ERR_* when they do not fit in size
+ */
+typedef pdiutil::function<int32_t(uint8_t slot, char *out, uint16_t size)> MqttSlotWriter;
+
+typedef struct {
+  uint16_t offset; // into the literal text, for a text run
+  uint16_t length;
+  uint8_t slot;
+} mqtt_template_part_t;
+
+class MqttTemplate
+{
+
+public:
+	/**
+	 * @brief Splits text into literal runs and slots.
+	 */
+	void compile(const char *text, uint16_t length);
+	/**
+	 * @brief Forgets the compiled text.
+	 */
+	void clear(void);
+	/**
+	 * @brief Whether nothing was compiled, or only empty text.
+	 */
+	bool empty(void) const;
+	/**
+	 * @brief Whether there is a slot for this placeholder in the text.
+	 */
+	bool uses(uint8_t slot) const;
+
+	/**
+	 * @brief Writes the text with every slot filled by slots.
+	 * @return Bytes written, or PDI_ERR_OVERFLOW when they do not fit in size.
+	 */
+	int32_t render(char *out, uint16_t size, const MqttSlotWriter &slots) const;
+
+	/**
+	 * @brief Compiles and renders in the same pass, keeping nothing, for text
+	 * that is only seen once.
+	 */
+	static int32_t expand(const char *text, uint16_t length, char *out, uint16_t size, const MqttSlotWriter &slots);
+
+protected:
+	static uint8_t match(const char *text, uint16_t length, uint16_t &skip);
+
+	pdiutil::string m_text;
+	pdiutil::vector<mqtt_template_part_t> m_parts;
+};
+
+#endif
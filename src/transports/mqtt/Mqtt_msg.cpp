@@ -251,7 +251,7 @@ const char* mqtt_get_publish_data(uint8_t* buffer, uint16_t* length){
   return (const char*)(buffer + i);
 }
 
-uint16_t mqtt_get_id(uint8_t* buffer, uint16_t length){
+uint16_t mqtt_get_id(const uint8_t* buffer, uint16_t length){
 
   if( nullptr == buffer || length < 1 ){
     return 0;
@@ -316,6 +316,38 @@ uint16_t mqtt_get_id(uint8_t* buffer, uint16_t length){
   }
 }
 
+/**
+ * stamps a message id into a built QoS 1/2 publish, which is given its id only
+ * when it goes on the wire rather than when it was spooled
+ */
+bool mqtt_set_id(uint8_t* buffer, uint16_t length, uint16_t message_id){
+
+  if( nullptr == buffer || length < 2 || MQTT_MSG_TYPE_PUBLISH != mqtt_get_type(buffer) || 0 == mqtt_get_qos(buffer) ){
+    return false;
+  }
+
+  int i;
+  for(i = 1; i < length; ++i){
+    if( 0 == (buffer[i] & 0x80) ){
+      ++i;
+      break;
+    }
+  }
+
+  if(i + 2 > length){
+    return false;
+  }
+  int topiclen = buffer[i] << 8 | buffer[i + 1];
+  i += 2 + topiclen;
+
+  if(i + 2 > length){
+    return false;
+  }
+  buffer[i] = message_id >> 8;
+  buffer[i + 1] = message_id & 0xff;
+  return true;
+}
+
 mqtt_message_t* mqtt_msg_connect(mqtt_connection_t* connection, mqtt_connect_info_t* info){
 
   if( nullptr == connection || nullptr == info ){
@@ -440,6 +472,51 @@ mqtt_message_t* mqtt_msg_publish(mqtt_connection_t* connection, const char* topi
   return fini_message(connection, MQTT_MSG_TYPE_PUBLISH, 0, qos, retain);
 }
 
+/**
+ * builds a publish in place: the topic and the payload are written by the
+ * callers' writers straight into the connection buffer, with no copy of either
+ * kept anywhere else on the way
+ */
+mqtt_message_t* mqtt_msg_publish_with(mqtt_connection_t* connection, const mqtt_msg_writer_t& topic, const mqtt_msg_writer_t& data, uint8_t qos, uint8_t retain, uint16_t* message_id){
+
+  if( nullptr == connection ){
+    return nullptr;
+  }
+
+  init_message(connection);
+
+  if( nullptr == connection->buffer || connection->message.length + 2 > connection->buffer_length ){
+    return fail_message(connection);
+  }
+
+  uint16_t topic_at = connection->message.length;
+  connection->message.length += 2;
+  int32_t topic_length = topic((char*)connection->buffer + connection->message.length, connection->buffer_length - connection->message.length);
+  if( topic_length <= 0 ){
+    return fail_message(connection);
+  }
+  connection->buffer[topic_at] = topic_length >> 8;
+  connection->buffer[topic_at + 1] = topic_length & 0xff;
+  connection->message.length += topic_length;
+
+  if(qos > 0){
+
+    if( 0 == (*message_id = append_message_id(connection, 0)) ){
+      return fail_message(connection);
+    }
+  }else{
+    *message_id = 0;
+  }
+
+  int32_t data_length = data((char*)connection->buffer + connection->message.length, connection->buffer_length - connection->message.length);
+  if( data_length < 0 ){
+    return fail_message(connection);
+  }
+  connection->message.length += data_length;
+
+  return fini_message(connection, MQTT_MSG_TYPE_PUBLISH, 0, qos, retain);
+}
+
 mqtt_message_t* mqtt_msg_puback(mqtt_connection_t* connection, uint16_t message_id){
 
   if( nullptr == connection ){
@@ -53,6 +53,12 @@ typedef struct {
   uint16_t buffer_length;
 } mqtt_connection_t;
 
+/**
+ * writes part of a packet straight into the connection buffer, returning the
+ * bytes written or a negative PDI_ERR_* when they do not fit in size
+ */
+typedef pdiutil::function<int32_t(char* out, uint16_t size)> mqtt_msg_writer_t;
+
 typedef struct {
 
   char* client_id;
@@ -66,19 +72,22 @@ typedef struct {
   uint8_t clean_session;
 } mqtt_connect_info_t;
 
-static inline uint8_t mqtt_get_type(uint8_t* buffer) { return (buffer[0] & 0xf0) >> 4; }
-static inline uint8_t mqtt_get_dup(uint8_t* buffer) { return (buffer[0] & 0x08) >> 3; }
-static inline uint8_t mqtt_get_qos(uint8_t* buffer) { return (buffer[0] & 0x06) >> 1; }
-static inline uint8_t mqtt_get_retain(uint8_t* buffer) { return (buffer[0] & 0x01); }
+static inline uint8_t mqtt_get_type(const uint8_t* buffer) { return (buffer[0] & 0xf0) >> 4; }
+static inline uint8_t mqtt_get_dup(const uint8_t* buffer) { return (buffer[0] & 0x08) >> 3; }
+static inline uint8_t mqtt_get_qos(const uint8_t* buffer) { return (buffer[0] & 0x06) >> 1; }
+static inline uint8_t mqtt_get_retain(const uint8_t* buffer) { return (buffer[0] & 0x01); }
+static inline void mqtt_set_dup(uint8_t* buffer) { buffer[0] |= 0x08; }
 
 void mqtt_msg_init(mqtt_connection_t* connection, uint8_t* buffer, uint16_t buffer_length);
 int32_t mqtt_get_total_length(uint8_t* buffer, uint16_t length);
 const char* mqtt_get_publish_topic(uint8_t* buffer, uint16_t* length);
 const char* mqtt_get_publish_data(uint8_t* buffer, uint16_t* length);
-uint16_t mqtt_get_id(uint8_t* buffer, uint16_t length);
+uint16_t mqtt_get_id(const uint8_t* buffer, uint16_t length);
+bool mqtt_set_id(uint8_t* buffer, uint16_t length, uint16_t message_id);
 
 mqtt_message_t* mqtt_msg_connect(mqtt_connection_t* connection, mqtt_connect_info_t* info);
 mqtt_message_t* mqtt_msg_publish(mqtt_connection_t* connection, const char* topic, const char* data, size_t data_length, uint8_t qos, uint8_t retain, uint16_t* message_id);
+mqtt_message_t* mqtt_msg_publish_with(mqtt_connection_t* connection, const mqtt_msg_writer_t& topic, const mqtt_msg_writer_t& data, uint8_t qos, uint8_t retain, uint16_t* message_id);
 mqtt_message_t* mqtt_msg_puback(mqtt_connection_t* connection, uint16_t message_id);
 mqtt_message_t* mqtt_msg_pubrec(mqtt_connection_t* connection, uint16_t message_id);
 mqtt_message_t* mqtt_msg_pubrel(mqtt_connection_t* connection, uint16_t message_id);
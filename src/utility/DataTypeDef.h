@@ -24,7 +24,14 @@ Created Date    : 1st June 2019
 #include <limits.h>
 #include <utility/pdistl/functional>
 #include <utility/pdistl/string>
+#include <utility/pdistl/string_view>
+#include <utility/pdistl/span>
 #include <utility/pdistl/vector>
+#include <utility/pdistl/small_vector>
+#include <utility/pdistl/map>
+#include <utility/pdistl/set>
+#include <utility/pdistl/flat_map>
+#include <utility/pdistl/unordered_map>
 #include <utility/pdistl/cstdio>
 #include <utility/pdistl/cstring>
 #include <utility/pdistl/cmath>
@@ -35,10 +42,38 @@ namespace pdiutil {
     // String type alias
     using string = pdistd::string;
 
+    // Non owning view of characters held elsewhere
+    using string_view = pdistd::string_view;
+
+    // Non owning view of elements held elsewhere
+    template <class T>
+    using span = pdistd::span<T>;
+
     // Vector type alias
     template <class T, class A = pdistd::allocator<T>> 
     using vector = pdistd::vector<T, A>;
 
+    // Vector holding its first N elements inside itself
+    template <class T, size_t N, class A = pdistd::allocator<T>>
+    using small_vector = pdistd::small_vector<T, N, A>;
+
+    // Ordered map, a red-black tree
+    template <class K, class V, class C = pdistd::less<K>, class A = pdistd::allocator<V>>
+    using map = pdistd::map<K, V, C, A>;
+
+    // Ordered set, a red-black tree
+    template <class K, class C = pdistd::less<K>, class A = pdistd::allocator<K>>
+    using set = pdistd::set<K, C, A>;
+
+    // Ordered map in one sorted vector, for tables mostly read
+    template <class K, class V, class C = pdistd::less<K>, class A = pdistd::allocator<pdistd::pair<K, V>>>
+    using flat_map = pdistd::flat_map<K, V, C, A>;
+
+    // Hash map in one open addressed array
+    template <class K, class V, class H = pdistd::hash<K>, class E = pdistd::equal_to<K>,
+              class A = pdistd::allocator<pdistd::pair<K, V>>>
+    using unordered_map = pdistd::unordered_map<K, V, H, E, A>;
+
     // Conversion to string
     using pdistd::to_string;
 
@@ -46,6 +81,10 @@ namespace pdiutil {
     template<typename _Res, typename... _ArgTypes>
     using function = pdistd::function<_Res, _ArgTypes...>;
 
+    // Borrowed callable for callbacks run before the call taking them returns
+    template<typename _Signature>
+    using function_ref = pdistd::function_ref<_Signature>;
+
 } // namespace pdiutil
 
 // Attribute for read-only data (can be redefined in derived interfaces)
@@ -243,6 +282,7 @@ typedef pdiutil::function<void(void)> CallBackVoidArgFn;
 typedef pdiutil::function<void(void *)> CallBackVoidPointerArgFn;
 typedef pdiutil::function<void *(void *)> CallBackVoidPointerArgVoidPointerRetFn;
 typedef pdiutil::function<bool(const uint8_t *, uint32_t)> CallBackBytesArgBoolRetFn;
+typedef pdiutil::function<bool(uint64_t, uint64_t)> CallBackCopyProgressFn;      // (copied, total), false stops the copy
 
 /**
  * Logging types
@@ -691,9 +731,28 @@ enum file_attr_id_t : uint8_t {
     FILE_ATTR_PERMS = 3,     ///< uint16_t POSIX-style permission bit mask
     FILE_ATTR_UID   = 4,     ///< uint16_t owning user id
     FILE_ATTR_GID   = 5,     ///< uint16_t owning group id
+    FILE_ATTR_LINES = 6,     ///< FileLineIndex record, see iFileSystemInterface::indexLines
     FILE_ATTR_USER_BASE = 16 ///< first attribute id available to user code
 };
 
+// Access flags for iFileSystemInterface::openFile, or'd together. A handle
+// needs FILE_OPEN_READ or FILE_OPEN_WRITE; FILE_OPEN_APPEND implies a write.
+enum file_open_flag_t : uint8_t {
+    FILE_OPEN_READ   = 0x01, ///< handle may read
+    FILE_OPEN_WRITE  = 0x02, ///< handle may write
+    FILE_OPEN_CREATE = 0x04, ///< create the file when it is missing
+    FILE_OPEN_TRUNC  = 0x08, ///< empty the file on open
+    FILE_OPEN_APPEND = 0x10, ///< every write lands at the end of the file
+    FILE_OPEN_EXCL   = 0x20  ///< with FILE_OPEN_CREATE, refuse a file that exists
+};
+
+// Origin of an iFileSystemInterface::seekHandle offset.
+enum file_seek_t : uint8_t {
+    FILE_SEEK_SET = 0, ///< from the start of the file
+    FILE_SEEK_CUR,     ///< from the current position
+    FILE_SEEK_END      ///< from the end of the file
+};
+
 // Default POSIX-style permission bits assigned to newly created entries.
 #define FILE_PERM_DEFAULT_FILE  0644
 #define FILE_PERM_DEFAULT_DIR   0755
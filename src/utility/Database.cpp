@@ -9,6 +9,7 @@ Created Date    : 1st June 2019
 ******************************************************************************/
 
 #include "Database.h"
+#include <interface/pdi.h>
 
 // Initialize static members of DatabaseTableAbstractLayer
 int DatabaseTableAbstractLayer::m_total_instances = 0;
@@ -19,7 +20,8 @@ DatabaseTableAbstractLayer *DatabaseTableAbstractLayer::m_instances[MAX_TABLES]
  *
  * Initializes the database object and sets the maximum database size to 0.
  */
-Database::Database() : m_max_db_size(0)
+Database::Database() : m_max_db_size(0),
+                       m_commit_task_id(-1)
 {
 }
 
@@ -67,6 +69,60 @@ void Database::clear_all()
             this->m_database_tables[i].m_instance->clear();
         }
     }
+
+    // a reset is usually followed by a restart, so it does not wait out a window
+    this->commit();
+}
+
+/**
+ * @brief Commits saved tables once DATABASE_COMMIT_WINDOW_MS has passed.
+ *
+ * Saves only change the working copy of the store, so every save inside the
+ * window is carried by the single commit that closes it.
+ */
+void Database::schedule_commit()
+{
+    if (!__i_db.hasUncommittedConfigs())
+    {
+        return;
+    }
+
+    if (0 == DATABASE_COMMIT_WINDOW_MS)
+    {
+        this->commit();
+        return;
+    }
+
+    if (__task_scheduler.is_registered_task(this->m_commit_task_id) >= 0)
+    {
+        return;
+    }
+
+    this->m_commit_task_id = __task_scheduler.setTimeout([this]() {
+        this->m_commit_task_id = -1;
+        this->commit();
+    }, DATABASE_COMMIT_WINDOW_MS, __i_dvc_ctrl.millis_now(), DEFAULT_TASK_PRIORITY, RODT_ATTR("dbcommit"));
+
+    // no slot for the timeout, so nothing would close the window
+    if (this->m_commit_task_id < 0)
+    {
+        this->commit();
+    }
+}
+
+/**
+ * @brief Commits saved tables now and closes any open window.
+ *
+ * @return False when the medium refused the write.
+ */
+bool Database::commit()
+{
+    if (this->m_commit_task_id >= 0)
+    {
+        __task_scheduler.clearTimeout(this->m_commit_task_id);
+        this->m_commit_task_id = -1;
+    }
+    return __i_db.commitConfigs();
 }
 
 /**
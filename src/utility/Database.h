@@ -158,11 +158,33 @@ public:
      */
     void clear_all(void);
 
+    /**
+     * @brief Commits saved tables once DATABASE_COMMIT_WINDOW_MS has passed.
+     *
+     * Called after a save. The window opens on the first save after a commit
+     * and is not pushed back by later ones, so a steady stream of saves still
+     * reaches the medium.
+     */
+    void schedule_commit(void);
+
+    /**
+     * @brief Commits saved tables now and closes any open window.
+     * @return False when the medium refused the write.
+     */
+    bool commit(void);
+
     /**
      * @var uint32_t m_max_db_size
      * @brief Maximum size of the database in bytes.
      */
     uint32_t m_max_db_size;
+
+private:
+    /**
+     * @var pdiutil::task_id_t m_commit_task_id
+     * @brief The timeout closing the open commit window, or -1.
+     */
+    pdiutil::task_id_t m_commit_task_id;
 };
 
 /**
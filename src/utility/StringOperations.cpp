@@ -80,6 +80,18 @@ int32_t __strstr(const char *str, uint32_t _strlen, const char *substr, uint32_t
     return -1;
 }
 
+/**
+ * @brief Finds the first occurrence of a substring in a view.
+ * @param str The view to search in.
+ * @param substr The substring to search for.
+ * @param _from The offset in the view to start searching from.
+ * @return The index of the first occurrence of the substring, or -1 if not found.
+ */
+int32_t __strstr(pdiutil::string_view str, pdiutil::string_view substr, uint32_t _from)
+{
+    return __strstr(str.data(), str.size(), substr.data(), substr.size(), _from);
+}
+
 /**
  * @brief Trims a specific character from both ends of a string.
  * 
@@ -148,6 +160,35 @@ char *__strtrim(char *str, uint16_t _overflow_limit)
     return __strtrim_val(str, ' ', _overflow_limit);
 }
 
+/**
+ * @brief Narrows a view past a character at either end.
+ * @param str The view to trim.
+ * @param _val The character to trim.
+ * @return The trimmed view.
+ */
+pdiutil::string_view __strtrim_val(pdiutil::string_view str, char _val)
+{
+    while (!str.empty() && str.front() == _val)
+    {
+        str.remove_prefix(1);
+    }
+    while (!str.empty() && str.back() == _val)
+    {
+        str.remove_suffix(1);
+    }
+    return str;
+}
+
+/**
+ * @brief Narrows a view past spaces at either end.
+ * @param str The view to trim.
+ * @return The trimmed view.
+ */
+pdiutil::string_view __strtrim(pdiutil::string_view str)
+{
+    return __strtrim_val(str, ' ');
+}
+
 /**
  * @brief Compares two strings for equality.
  * 
@@ -596,24 +637,57 @@ bool __get_from_json(const char *_str, const char *_key, char *_value, int _max_
         return false;
     }
 
-    int _str_len = strlen(_str);
+    pdiutil::string_view found;
+    if (!__get_from_json(pdiutil::string_view(_str), pdiutil::string_view(_key), found))
+    {
+        return false;
+    }
 
-    int _key_index = __strstr(_str, _key, _str_len);
-    if (_key_index < 0 || _key_index >= _str_len)
+    int len = (int)found.size();
+    if (len >= _max_value_len) len = _max_value_len - 1;
+
+    memset(_value, 0, _max_value_len);
+    memcpy(_value, found.data(), len);
+
+    return true;
+}
+
+/**
+ * @brief Finds the value of a key in a JSON string without copying it.
+ *
+ * The value runs from past the colon up to the comma or closing brace that
+ * ends it at its own nesting level, then is trimmed of commas, spaces and
+ * quotes in that order.
+ *
+ * @param _str The JSON string to parse.
+ * @param _key The key to search for.
+ * @param _value Set to the value inside _str.
+ * @return True if the key-value pair was found, false otherwise.
+ */
+bool __get_from_json(pdiutil::string_view _str, pdiutil::string_view _key, pdiutil::string_view &_value)
+{
+    if (nullptr == _str.data() || nullptr == _key.data())
+    {
         return false;
+    }
 
-    int _colon_index = __strstr(_str + _key_index, ":", (_str_len - _key_index));
+    int32_t _key_index = __strstr(_str, _key);
+    if (_key_index < 0)
+        return false;
+
+    int32_t _colon_index = __strstr(_str, pdiutil::string_view(":", 1), (uint32_t)_key_index);
     if (_colon_index < 0)
         return false;
 
-    const char* pos = _str + _key_index + _colon_index + 1; // skip colon
-    while ((*pos == ' ' || *pos == '\t' || *pos == '\n') && (pos - _str) < _str_len ) pos++; // skip whitespace
+    const char* pos = _str.data() + _colon_index + 1; // skip colon
+    const char* last = _str.data() + _str.size();
+    while (pos < last && (*pos == ' ' || *pos == '\t' || *pos == '\n')) pos++; // skip whitespace
 
     int quotes = 0, braces = 0, brackets = 0;
     const char* start = pos;
     const char* end = pos;
 
-    while (*end) {
+    while (end < last && *end) {
         char c = *end;
 
         if (c == '"') {
@@ -642,26 +716,10 @@ bool __get_from_json(const char *_str, const char *_key, char *_value, int _max_
         end++;
     }
 
-    int len = end - start;
-    if (len >= _max_value_len) len = _max_value_len - 1;
-
-    memset(_value, 0, _max_value_len);
-    memcpy(_value, start, len);
-
-    // the trimmed pointer walks forward inside _value, so the shift back to the
-    // front overlaps and has to carry the trimmed length along with its nul
-    char* _trimmedstr = __strtrim_val(_value, ',', _max_value_len);
-    if( nullptr != _trimmedstr )
-    memmove(_value, _trimmedstr, strlen(_trimmedstr) + 1);
-
-    _trimmedstr = __strtrim(_value, _max_value_len);
-    if( nullptr != _trimmedstr )
-    memmove(_value, _trimmedstr, strlen(_trimmedstr) + 1);
-
-    _trimmedstr = __strtrim_val(_value, '"', _max_value_len);
-    if( nullptr != _trimmedstr )
-    memmove(_value, _trimmedstr, strlen(_trimmedstr) + 1);
-
+    _value = pdiutil::string_view(start, end - start);
+    _value = __strtrim_val(_value, ',');
+    _value = __strtrim(_value);
+    _value = __strtrim_val(_value, '"');
     return true;
 }
 
@@ -41,6 +41,16 @@ int __strstr(const char *str, const char *substr, int _len = 300);
  */
 int32_t __strstr(const char *str, uint32_t _strlen, const char *substr, uint32_t _substrlen, uint32_t _from = 0);
 
+/**
+ * @brief Finds the first occurrence of a substring in a view, binary safe like
+ * the length delimited variant above.
+ * @param str The view to search in.
+ * @param substr The substring to search for.
+ * @param _from The offset in the view to start searching from.
+ * @return The index of the first occurrence of the substring, or -1 if not found.
+ */
+int32_t __strstr(pdiutil::string_view str, pdiutil::string_view substr, uint32_t _from = 0);
+
 /**
  * @brief Trims leading and trailing whitespace from a string.
  * @param str The string to trim.
@@ -58,6 +68,23 @@ char *__strtrim(char *str, uint16_t _overflow_limit = 300);
  */
 char *__strtrim_val(char *str, char _val, uint16_t _overflow_limit = 300);
 
+/**
+ * @brief Narrows a view past leading and trailing spaces, leaving what it
+ * points into untouched.
+ * @param str The view to trim.
+ * @return The trimmed view, empty when nothing but spaces was left.
+ */
+pdiutil::string_view __strtrim(pdiutil::string_view str);
+
+/**
+ * @brief Narrows a view past leading and trailing occurrences of a character,
+ * leaving what it points into untouched.
+ * @param str The view to trim.
+ * @param _val The character to trim.
+ * @return The trimmed view.
+ */
+pdiutil::string_view __strtrim_val(pdiutil::string_view str, char _val);
+
 /**
  * @brief Compares two strings for equality.
  * @param str1 The first string to compare.
@@ -123,6 +150,15 @@ void __find_and_replace(char *_str, const char *_find_str, const char *_replace_
  */
 bool __get_from_json(const char *_str, const char *_key, char *_value, int _max_value_len);
 
+/**
+ * @brief Finds the value of a key in a JSON string without copying it.
+ * @param _str The JSON string to parse, which need not be NUL terminated.
+ * @param _key The key to search for.
+ * @param _value Set to the value inside _str, trimmed as the copying variant does.
+ * @return True if the key-value pair was found, false otherwise.
+ */
+bool __get_from_json(pdiutil::string_view _str, pdiutil::string_view _key, pdiutil::string_view &_value);
+
 
 /**
  * @brief Convert to lowercase if any uppercase char.
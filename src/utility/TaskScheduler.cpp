@@ -22,8 +22,21 @@ Created Date    : 1st June 2019
  */
 TaskScheduler::TaskScheduler() : m_util(nullptr),
                                  m_max_tasks(MAX_SCHEDULABLE_TASKS),
-                                 m_rebase_start_priotask(false)
+                                 m_rebase_start_priotask(false),
+                                 m_free_head(0),
+                                 m_free_count(MAX_SCHEDULABLE_TASKS),
+                                 m_task_count(0),
+                                 m_has_expired(false),
+                                 m_due_count(0),
+                                 m_last_pass_ms(0)
 {
+    for (uint16_t i = 0; i < MAX_SCHEDULABLE_TASKS; i++)
+    {
+        this->m_heap_pos[i] = -1;
+        this->m_free_slots[i] = i;
+        this->m_slot_gen[i] = 0;
+    }
+
     // the table is sized once and never grown or compacted after this, so a
     // slot never moves and a running task keeps the callable it is executing.
     // a slot with m_task_id < 0 is free, which is what task_t() leaves behind
@@ -123,6 +136,7 @@ pdiutil::task_id_t TaskScheduler::updateInterval(pdiutil::task_id_t _task_id, Ca
         if (nullptr != _name) this->m_tasks[_registered_index].m_name = _name;
         this->m_tasks[_registered_index].m_owner = _owner;
         CRITICAL_SECTION_EXIT
+        this->queueTask(_registered_index);
         return _task_id;
     }
     else
@@ -165,26 +179,17 @@ bool TaskScheduler::clearInterval(pdiutil::task_id_t _id)
  */
 pdiutil::task_id_t TaskScheduler::register_task(CallBackVoidArgFn _task_fn, pdiutil::millis_t _duration, pdiutil::task_priority_t _task_priority, pdiutil::millis_t _last_millis, pdiutil::attempts_t _max_attempts, const char* _name, uint8_t _owner)
 {
-    // claim a free slot in place, the table is never grown so slots never move
-    uint16_t _slot = this->m_tasks.size();
-    for (uint16_t i = 0; i < this->m_tasks.size() && i < this->m_max_tasks; i++)
+    // claim the slot at the head of the free ring in place, the table is never
+    // grown so slots never move
+    if (this->m_task_count < this->m_max_tasks && this->m_free_count > 0)
     {
-        if (this->m_tasks[i].m_task_id < 0)
-        {
-            _slot = i;
-            break;
-        }
-    }
-
-    if (_slot < this->m_tasks.size())
-    {
-        pdiutil::task_id_t _new_id = this->get_unique_task_id();
-        if (_new_id < 0)
-        {
-            return -1;
-        }
-
         CRITICAL_SECTION_ENTER
+        uint16_t _slot = this->m_free_slots[this->m_free_head];
+        this->m_free_head = (this->m_free_head + 1) % MAX_SCHEDULABLE_TASKS;
+        this->m_free_count--;
+        this->m_task_count++;
+
+        pdiutil::task_id_t _new_id = this->makeTaskId(_slot);
         task_t &_new_task = this->m_tasks[_slot];
         _new_task.m_task = _task_fn;
         _new_task.m_duration = _duration;
@@ -198,6 +203,7 @@ pdiutil::task_id_t TaskScheduler::register_task(CallBackVoidArgFn _task_fn, pdiu
         _new_task.m_name = _name;
         _new_task.m_owner = _owner;
         CRITICAL_SECTION_EXIT
+        this->queueTask(_slot);
         return _new_id;
     }
     return -1;
@@ -232,6 +238,7 @@ bool TaskScheduler::setTaskNice(pdiutil::task_id_t _id, int8_t _nice)
     CRITICAL_SECTION_ENTER
     this->m_tasks[_idx].m_nice = _nice;
     CRITICAL_SECTION_EXIT
+    this->queueTask(_idx);
     return true;
 }
 
@@ -249,6 +256,8 @@ bool TaskScheduler::sendSignal(pdiutil::task_id_t _id, signal_t _sig)
     CRITICAL_SECTION_ENTER
     this->m_tasks[_idx].m_pending_sig = (uint8_t)_sig;
     CRITICAL_SECTION_EXIT
+    // a stopped task is off the queue, and the signal is what brings it back
+    this->queueTask(_idx);
     return true;
 }
 
@@ -273,6 +282,7 @@ uint16_t TaskScheduler::sendSignalByName(const char* _name, signal_t _sig, uint8
         CRITICAL_SECTION_ENTER
         t.m_pending_sig = (uint8_t)_sig;
         CRITICAL_SECTION_EXIT
+        this->queueTask(i);
         hits++;
     }
     return hits;
@@ -334,67 +344,152 @@ int TaskScheduler::computeScore(const task_t& _t, uint64_t _now)
 }
 
 /**
- * @brief Sort the task indices according to their priority and score.
+ * @brief Time at which a task next wants the scheduler.
  *
  */
-uint16_t TaskScheduler::getSortedTaskList(uint16_t* _priority_indices, uint16_t _task_count)
+pdiutil::millis_t TaskScheduler::dueAt(const task_t& _t) const
 {
-    const uint32_t tolerance = 3; // ms tolerance window
-    uint64_t now = m_util->millis_now();
+    if (_t.m_pending_sig != SIG_NONE)
+    {
+        return 0;
+    }
+
+    #ifdef ENABLE_CONTEXTUAL_EXECUTION
+    // the executive runs the body, the pass only has to notice it finishing
+    if (_t.m_task_mode != TASK_MODE_INLINE)
+    {
+        return 0;
+    }
+    #endif
+
+    return _t.m_last_millis + _t.m_duration;
+}
 
-    // only live slots enter the list. a free slot has no due time, which scores
-    // as maximally overdue and would sort above every real task
-    uint16_t _live_count = 0;
-    for (uint16_t i = 0; i < _task_count && i < this->m_tasks.size(); i++)
+/**
+ * @brief Heap ordering of two slots.
+ *
+ */
+bool TaskScheduler::dueBefore(uint16_t _slot_a, uint16_t _slot_b) const
+{
+    const task_t &_a = this->m_tasks[_slot_a];
+    const task_t &_b = this->m_tasks[_slot_b];
+
+    pdiutil::millis_t _due_a = this->dueAt(_a);
+    pdiutil::millis_t _due_b = this->dueAt(_b);
+    if (_due_a != _due_b)
     {
-        if (this->m_tasks[i].m_task_id >= 0)
+        return _due_a < _due_b;
+    }
+
+    int _prio_a = (int)_a.m_task_priority - (int)_a.m_nice;
+    int _prio_b = (int)_b.m_task_priority - (int)_b.m_nice;
+    if (_prio_a != _prio_b)
+    {
+        return _prio_a > _prio_b;
+    }
+
+    return _a.m_task_exec_us < _b.m_task_exec_us;
+}
+
+void TaskScheduler::heapSwap(uint16_t _pos_a, uint16_t _pos_b)
+{
+    uint16_t _slot_a = this->m_due_heap[_pos_a];
+    uint16_t _slot_b = this->m_due_heap[_pos_b];
+    this->m_due_heap[_pos_a] = _slot_b;
+    this->m_due_heap[_pos_b] = _slot_a;
+    this->m_heap_pos[_slot_b] = _pos_a;
+    this->m_heap_pos[_slot_a] = _pos_b;
+}
+
+void TaskScheduler::heapSiftUp(uint16_t _pos)
+{
+    while (_pos > 0)
+    {
+        uint16_t _parent = (_pos - 1) / 2;
+        if (!this->dueBefore(this->m_due_heap[_pos], this->m_due_heap[_parent]))
         {
-            _priority_indices[_live_count++] = i;
+            break;
         }
+        this->heapSwap(_pos, _parent);
+        _pos = _parent;
     }
-    _task_count = _live_count;
+}
 
-    for (uint16_t i = 0; i < _task_count; i++)
+void TaskScheduler::heapSiftDown(uint16_t _pos)
+{
+    while (true)
     {
-        for (uint16_t j = i + 1; j < _task_count; j++)
-        {
-            auto &task_i = this->m_tasks[_priority_indices[i]];
-            auto &task_j = this->m_tasks[_priority_indices[j]];
-
-            uint64_t next_due_i = task_i.m_last_millis + task_i.m_duration;
-            uint64_t next_due_j = task_j.m_last_millis + task_j.m_duration;
-
-            bool swap_needed = false;
-
-            // --- Blend policy, priority into a score ---
-            int score_i = this->computeScore(task_i, now);
-            int score_j = this->computeScore(task_j, now);
-            
-            // --- Compare blended score first (priority-biased) ---
-            if (score_i != score_j) {
-
-                swap_needed = (score_j > score_i);
-            } else {
-                // --- Scores equal → compare due times with tolerance ---
-                int64_t diff = (int64_t)(next_due_i - next_due_j);
-
-                if (abs(diff) > (int64_t)tolerance) {
-                    swap_needed = (next_due_j < next_due_i);
-                } else {
-                    // --- Due times effectively equal → compare exec time ---
-                    if (task_i.m_task_exec_us > task_j.m_task_exec_us) {
-                        swap_needed = true;
-                    }
-                }
-            }
+        uint16_t _first = _pos;
+        uint16_t _left = 2 * _pos + 1;
+        uint16_t _right = _left + 1;
 
-            if (swap_needed) {
-                pdistd::swap(_priority_indices[i], _priority_indices[j]);
-            }
+        if (_left < this->m_due_count && this->dueBefore(this->m_due_heap[_left], this->m_due_heap[_first]))
+        {
+            _first = _left;
         }
+        if (_right < this->m_due_count && this->dueBefore(this->m_due_heap[_right], this->m_due_heap[_first]))
+        {
+            _first = _right;
+        }
+        if (_first == _pos)
+        {
+            break;
+        }
+        this->heapSwap(_pos, _first);
+        _pos = _first;
     }
+}
 
-    return _task_count;
+/**
+ * @brief Puts a slot on the due queue, or moves it if it is already queued.
+ *
+ */
+void TaskScheduler::queueTask(int16_t _slot)
+{
+    if (_slot < 0 || _slot >= (int16_t)MAX_SCHEDULABLE_TASKS || this->m_tasks[_slot].m_task_id < 0)
+    {
+        return;
+    }
+
+    CRITICAL_SECTION_ENTER
+    int16_t _pos = this->m_heap_pos[_slot];
+    if (_pos < 0)
+    {
+        _pos = this->m_due_count++;
+        this->m_due_heap[_pos] = _slot;
+        this->m_heap_pos[_slot] = _pos;
+    }
+    // the key may have moved either way, only one of the two does anything
+    this->heapSiftUp(_pos);
+    this->heapSiftDown(this->m_heap_pos[_slot]);
+    CRITICAL_SECTION_EXIT
+}
+
+/**
+ * @brief Takes a slot off the due queue if it is on it.
+ *
+ */
+void TaskScheduler::dequeueTask(int16_t _slot)
+{
+    if (_slot < 0 || _slot >= (int16_t)MAX_SCHEDULABLE_TASKS || this->m_heap_pos[_slot] < 0)
+    {
+        return;
+    }
+
+    CRITICAL_SECTION_ENTER
+    uint16_t _pos = this->m_heap_pos[_slot];
+    uint16_t _last = --this->m_due_count;
+    if (_pos != _last)
+    {
+        this->heapSwap(_pos, _last);
+    }
+    this->m_heap_pos[_slot] = -1;
+    if (_pos != _last)
+    {
+        this->heapSiftUp(_pos);
+        this->heapSiftDown(this->m_heap_pos[this->m_due_heap[_pos]]);
+    }
+    CRITICAL_SECTION_EXIT
 }
 
 /**
@@ -409,16 +504,67 @@ void TaskScheduler::handle_tasks()
         return;
     }
 
-    uint16_t _priority_indices[MAX_SCHEDULABLE_TASKS];
+    pdiutil::millis_t _now = m_util->millis_now();
 
-    // free slots are left out of the list, so this is the live task count
-    uint16_t _task_count = this->getSortedTaskList(_priority_indices, this->m_tasks.size());
-    this->m_rebase_start_priotask = true; // run only one task and break for next turn
+    // the millisecond counter wrapped. every queued key is now far in the
+    // future, so restart each task's period from here, as the per task clamp
+    // below does for a single task
+    if (_now < this->m_last_pass_ms)
+    {
+        for (uint16_t i = 0; i < this->m_due_count; i++)
+        {
+            task_t &_task = this->m_tasks[this->m_due_heap[i]];
+            if (_task.m_last_millis > _now)
+            {
+                _task.m_last_millis = _now;
+            }
+        }
+        for (int16_t i = ((int16_t)this->m_due_count / 2) - 1; i >= 0; i--)
+        {
+            this->heapSiftDown(i);
+        }
+    }
+    this->m_last_pass_ms = _now;
 
-    for (uint16_t i = 0; i < _task_count; i++)
+    // an order change asked for before this pass is already in the queue
+    this->m_rebase_start_priotask = false;
+
+    // everything due right now comes off the queue once. a slot is only put
+    // back after it ran, so a task that is always due cannot spin the pass
+    uint16_t _due[MAX_SCHEDULABLE_TASKS];
+    int _scores[MAX_SCHEDULABLE_TASKS];
+    uint16_t _due_count = 0;
+
+    while (this->m_due_count > 0 && this->dueAt(this->m_tasks[this->m_due_heap[0]]) <= _now)
     {
+        uint16_t _slot = this->m_due_heap[0];
+        this->dequeueTask(_slot);
+
+        // the policy score decides the order among tasks due together. the
+        // batch comes off the heap in due order, so equal scores keep it
+        int _score = this->computeScore(this->m_tasks[_slot], _now);
+        uint16_t _at = _due_count++;
+        while (_at > 0 && _scores[_at - 1] < _score)
+        {
+            _due[_at] = _due[_at - 1];
+            _scores[_at] = _scores[_at - 1];
+            _at--;
+        }
+        _due[_at] = _slot;
+        _scores[_at] = _score;
+    }
+
+    for (uint16_t i = 0; i < _due_count; i++)
+    {
+        uint16_t _slot = _due[i];
         uint64_t _last_start_ms = m_util->millis_now();
-        auto &_task = this->m_tasks[_priority_indices[i]];
+        auto &_task = this->m_tasks[_slot];
+
+        // released since it was popped, by a task that ran before it
+        if (_task.m_task_id < 0)
+        {
+            continue;
+        }
 
         #ifdef ENABLE_CONTEXTUAL_EXECUTION
         if( _task.m_task_mode != TASK_MODE_INLINE ){
@@ -457,6 +603,11 @@ void TaskScheduler::handle_tasks()
                 }
             }
 
+            if( _task.m_task_id >= 0 && _task.m_max_attempts != 0 ){
+                this->queueTask(_slot);
+            }else{
+                this->m_has_expired = true;
+            }
             continue;
         }
         #endif
@@ -479,9 +630,14 @@ void TaskScheduler::handle_tasks()
                 }
             }
             CRITICAL_SECTION_EXIT
-            if (sig == SIG_KILL || sig == SIG_TERM) continue;
+            if (sig == SIG_KILL || sig == SIG_TERM)
+            {
+                this->m_has_expired = true;
+                continue;
+            }
         }
 
+        // a stopped task stays off the queue until SIG_CONT puts it back
         if (_task.m_state == TASK_STATE_STOPPED)
         {
             continue;
@@ -509,7 +665,10 @@ void TaskScheduler::handle_tasks()
                 _task.m_task_exec_us = (uint32_t)(_cb_end_us - _cb_start_us);
                 _task.m_total_exec_us += (uint64_t)_task.m_task_exec_us;
                 _task.m_run_count++;
-                _task.m_state = TASK_STATE_SLEEPING;
+                if (_task.m_state == TASK_STATE_RUNNING)
+                {
+                    _task.m_state = TASK_STATE_SLEEPING;
+                }
                 CRITICAL_SECTION_EXIT
             }
 
@@ -539,18 +698,60 @@ void TaskScheduler::handle_tasks()
             CRITICAL_SECTION_EXIT
         }
 
+        // the callback may have re-armed, cleared or stopped itself
+        if (_task.m_task_id >= 0 && _task.m_max_attempts != 0 && _task.m_state != TASK_STATE_STOPPED)
+        {
+            this->queueTask(_slot);
+        }
+        else if (_task.m_max_attempts == 0)
+        {
+            this->m_has_expired = true;
+        }
+
         if (nullptr != m_util)
         {
             m_util->yield();
         }
 
-        // Break the loop in case resorting is needed
+        // Break the loop in case resorting is needed. what was still due goes
+        // back on the queue and runs next pass in the new order
         if( this->m_rebase_start_priotask ){
             this->m_rebase_start_priotask = false;
+            for (uint16_t j = i + 1; j < _due_count; j++)
+            {
+                this->queueTask(_due[j]);
+            }
             break;
         }
     }
-    this->remove_expired_tasks();
+
+    if (this->m_has_expired)
+    {
+        this->remove_expired_tasks();
+    }
+}
+
+/**
+ * @brief Milliseconds until the earliest queued task is due.
+ *
+ * The head of the due queue is the earliest task, so this is one read.
+ */
+uint32_t TaskScheduler::nextDeadlineMs()
+{
+    if (nullptr == m_util || 0 == this->m_due_count)
+    {
+        return UINT32_MAX;
+    }
+
+    pdiutil::millis_t _due = this->dueAt(this->m_tasks[this->m_due_heap[0]]);
+    pdiutil::millis_t _now = m_util->millis_now();
+    if (_due <= _now)
+    {
+        return 0;
+    }
+
+    pdiutil::millis_t _wait = _due - _now;
+    return _wait > UINT32_MAX ? UINT32_MAX : (uint32_t)_wait;
 }
 
 /**
@@ -558,6 +759,7 @@ void TaskScheduler::handle_tasks()
  */
 void TaskScheduler::remove_expired_tasks()
 {
+    this->m_has_expired = false;
     for (uint16_t i = 0; i < this->m_tasks.size(); i++)
     {
         if (this->m_tasks[i].m_task_id >= 0 && this->m_tasks[i].m_max_attempts == 0)
@@ -573,8 +775,15 @@ void TaskScheduler::remove_expired_tasks()
 
             // released in place. erasing would shift later entries, and that
             // reassignment frees the callable a running task is executing
+            // the slot joins the tail of the free ring under its next generation,
+            // so the id it carried now is never handed out again soon
+            this->dequeueTask(i);
             CRITICAL_SECTION_ENTER
             this->m_tasks[i].clear();
+            this->m_slot_gen[i] = (this->m_slot_gen[i] + 1) % TASK_GENERATIONS;
+            this->m_free_slots[(this->m_free_head + this->m_free_count) % MAX_SCHEDULABLE_TASKS] = i;
+            this->m_free_count++;
+            this->m_task_count--;
             CRITICAL_SECTION_EXIT
         }
     }
@@ -627,19 +836,19 @@ bool TaskScheduler::hasTaskFinalizer(pdiutil::task_id_t _id)
 int16_t TaskScheduler::is_registered_task(pdiutil::task_id_t _id)
 {
     // a free slot carries a negative id, so it must never match a lookup
-    if (_id < 0)
+    if (_id <= 0)
     {
         return -1;
     }
 
-    for (uint16_t i = 0; i < this->m_tasks.size(); i++)
+    // a stale id names its old slot but carries an older generation, so the
+    // full id comparison rejects it
+    int16_t _slot = (int16_t)(_id & TASK_SLOT_MASK) - 1;
+    if (_slot < 0 || _slot >= (int16_t)this->m_tasks.size() || this->m_tasks[_slot].m_task_id != _id)
     {
-        if (this->m_tasks[i].m_task_id == _id)
-        {
-            return i;
-        }
+        return -1;
     }
-    return -1;
+    return _slot;
 }
 
 /**
@@ -656,51 +865,50 @@ bool TaskScheduler::remove_task(pdiutil::task_id_t _id)
         return false;
     }
 
-    bool _removed = false;
-    for (uint16_t i = 0; i < this->m_tasks.size(); i++)
+    int16_t i = this->is_registered_task(_id);
+    if (i < 0)
     {
-        if (this->m_tasks[i].m_task_id == _id)
-        {
-			// removing task create bug if this function will call inside another task
-			// hence making its max attempts to 0 which will considered as expired task
-			// this->m_tasks.erase( this->m_tasks.begin() + i );
-            CRITICAL_SECTION_ENTER
-            this->m_tasks[i].m_duration = 10;
-            this->m_tasks[i].m_task_priority = 0;
-            this->m_tasks[i].m_max_attempts = 0;
-            this->m_tasks[i].m_task = nullptr;
-            this->m_tasks[i].m_state = TASK_STATE_ZOMBIE;
-            #ifdef ENABLE_CONTEXTUAL_EXECUTION
-            this->m_tasks[i].m_task_exec = nullptr;
-            #endif
-            CRITICAL_SECTION_EXIT
-            _removed = true;
-        }
+        return false;
     }
-    return _removed;
+
+    // removing task create bug if this function will call inside another task
+    // hence making its max attempts to 0 which will considered as expired task
+    // this->m_tasks.erase( this->m_tasks.begin() + i );
+    CRITICAL_SECTION_ENTER
+    this->m_tasks[i].m_duration = 10;
+    this->m_tasks[i].m_task_priority = 0;
+    this->m_tasks[i].m_max_attempts = 0;
+    this->m_tasks[i].m_task = nullptr;
+    this->m_tasks[i].m_state = TASK_STATE_ZOMBIE;
+    #ifdef ENABLE_CONTEXTUAL_EXECUTION
+    this->m_tasks[i].m_task_exec = nullptr;
+    #endif
+    CRITICAL_SECTION_EXIT
+    this->dequeueTask(i);
+    this->m_has_expired = true;
+    return true;
 }
 
 /**
- * @brief Generates a unique ID for a new task.
+ * @brief The id the next registration will be given.
  *
- * @return A unique task ID.
+ * @return A unique task ID, or -1 when no slot is free.
  */
 pdiutil::task_id_t TaskScheduler::get_unique_task_id()
 {
-    for (pdiutil::task_id_t _id = 1; _id < this->m_max_tasks; _id++)
+    if (this->m_task_count >= this->m_max_tasks || 0 == this->m_free_count)
     {
-        bool _id_used = false;
-        for (uint16_t i = 0; i < this->m_tasks.size(); i++)
-        {
-            if (this->m_tasks[i].m_task_id == _id)
-            {
-                _id_used = true;
-            }
-        }
-        if (!_id_used)
-            return _id;
+        return -1;
     }
-    return -1;
+    return this->makeTaskId(this->m_free_slots[this->m_free_head]);
+}
+
+/**
+ * @brief Builds the id a slot is handed out under in its current generation.
+ */
+pdiutil::task_id_t TaskScheduler::makeTaskId(uint16_t _slot) const
+{
+    return (pdiutil::task_id_t)((this->m_slot_gen[_slot] << TASK_SLOT_BITS) | (_slot + 1));
 }
 
 /**
@@ -710,20 +918,12 @@ pdiutil::task_id_t TaskScheduler::get_unique_task_id()
  */
 task_t* TaskScheduler::get_task(pdiutil::task_id_t _id)
 {
-    // a free slot carries a negative id, so it must never match a lookup
-    if (_id < 0)
+    int16_t _index = this->is_registered_task(_id);
+    if (_index < 0)
     {
         return nullptr;
     }
-
-    for (uint16_t i = 0; i < this->m_tasks.size(); i++)
-    {
-        if (this->m_tasks[i].m_task_id == _id)
-        {
-            return &this->m_tasks[i];
-        }
-    }
-    return nullptr;
+    return &this->m_tasks[_index];
 }
 
 /**
@@ -924,6 +1124,8 @@ int TaskScheduler::scheduleUnderExecSched(iExecutionScheduler* _exec_sched, pdiu
 
             t->m_task_mode = _task_mode;
             ret = _exec_sched->schedule_task(t, _stackdepth);
+            // now due every pass, so its executive is watched for finishing
+            __task_scheduler.queueTask(__task_scheduler.is_registered_task(_task_id));
         }
     }
     return ret;
@@ -19,6 +19,11 @@ Created Date    : 1st June 2019
 #include "iUtilityInterface.h"
 #include <interface/pdi/threading/iExecution.h>
 
+/**
+ * @brief Bits needed to hold a task slot number, counted from one.
+ */
+constexpr uint8_t taskSlotBits(uint16_t _n) { return _n ? (uint8_t)(1 + taskSlotBits(_n >> 1)) : 0; }
+
 /**
  * @class TaskScheduler
  * @brief Provides functionality for scheduling and managing tasks.
@@ -141,7 +146,8 @@ public:
 
     /**
      * @brief Update the nice value of a task (POSIX-style, -20..19).
-     *        Does not immediately re-sort; caller may follow with rebaseAndRestartPrioTasks().
+     *        The task is re-queued at once; rebaseAndRestartPrioTasks() only
+     *        matters to a caller running inside a pass.
      * @return true if the task was found and updated.
      */
     bool setTaskNice(pdiutil::task_id_t _id, int8_t _nice);
@@ -173,9 +179,22 @@ public:
 
     /**
      * @brief Executes all registered tasks that are due.
+     *
+     * Due tasks are popped off a min-heap keyed on their next due time, so a
+     * pass costs O(log n) per task it dispatches rather than a re-sort of the
+     * whole table. Every task due at the start of the pass runs in that pass,
+     * ordered among themselves by their policy score.
      */
     void handle_tasks();
 
+    /**
+     * @brief Milliseconds until the earliest queued task is due.
+     *
+     * Lets the main loop idle rather than poll. 0 means something is due now,
+     * a pending signal included, and UINT32_MAX that nothing is queued.
+     */
+    uint32_t nextDeadlineMs();
+
     /**
      * @brief Removes all expired tasks from the scheduler.
      */
@@ -201,6 +220,10 @@ public:
     /**
      * @brief Checks if a task is registered.
      *
+     * The slot is read straight out of the id and the generation in the id must
+     * match the slot's, so this is constant time and an id held past its task
+     * never reaches whatever took the slot over.
+     *
      * @param _id The unique ID of the task to check.
      * @return The index of the task if registered, or -1 if not found.
      */
@@ -215,9 +238,9 @@ public:
     bool remove_task(pdiutil::task_id_t _id);
 
     /**
-     * @brief Generates a unique ID for a new task.
+     * @brief The id the next registration will be given.
      *
-     * @return A unique task ID.
+     * @return A unique task ID, or -1 when no slot is free.
      */
     pdiutil::task_id_t get_unique_task_id(void);
 
@@ -232,11 +255,7 @@ public:
      * @brief Number of registered tasks (live or zombie).
      */
     uint16_t getTaskCount() const {
-      uint16_t _count = 0;
-      for (uint16_t i = 0; i < m_tasks.size(); i++) {
-        if (m_tasks[i].m_task_id >= 0) _count++;
-      }
-      return _count;
+      return m_task_count;
     }
 
     /**
@@ -276,6 +295,8 @@ public:
     /**
      * @brief Break the task execution, sort with priorities and restart the task queue.
      *
+     * Ends the current pass after the running task; whatever was still due is
+     * put back on the queue and runs next pass in the new order.
      */
     void rebaseAndRestartPrioTasks();
 
@@ -339,18 +360,42 @@ protected:
     iUtilityInterface *m_util;
 
     /**
-     * @brief Sort the task indices according to their priority and score.
+     * @brief Return the computed score for task.
      *
      */
-    uint16_t getSortedTaskList(uint16_t* _priority_indices, uint16_t _task_count);
+    int computeScore(const task_t& _t, uint64_t _now);
 
     /**
-     * @brief Return the computed score for task.
+     * @brief Time at which a task next wants the scheduler.
      *
+     * A pending signal or a task handed to a contextual executive is due at
+     * once, everything else at its last run plus its duration.
      */
-    int computeScore(const task_t& _t, uint64_t _now);
+    pdiutil::millis_t dueAt(const task_t& _t) const;
+
+    /**
+     * @brief Puts a slot on the due queue, or moves it if it is already queued.
+     *
+     * Called by every api that changes what the ordering looks at, so the queue
+     * is kept current incrementally and never rebuilt.
+     */
+    void queueTask(int16_t _slot);
+
+    /**
+     * @brief Takes a slot off the due queue if it is on it.
+     */
+    void dequeueTask(int16_t _slot);
 
 private:
+    /**
+     * A task id is the slot number plus one in the low bits and the slot's
+     * generation above it. Fresh slots are generation zero, so the first ids a
+     * scheduler hands out are still 1, 2, 3.
+     */
+    static constexpr uint8_t TASK_SLOT_BITS = taskSlotBits(MAX_SCHEDULABLE_TASKS);
+    static constexpr uint16_t TASK_SLOT_MASK = (uint16_t)((1u << TASK_SLOT_BITS) - 1);
+    static constexpr uint16_t TASK_GENERATIONS = (uint16_t)((0x7FFFu >> TASK_SLOT_BITS) + 1);
+
     /**
      * @var uint8_t m_max_tasks
      * @brief Maximum number of tasks allowed in the scheduler.
@@ -362,6 +407,89 @@ private:
      * @brief Break the task execution, sort with priorities and restart the task queue.
      */
     bool m_rebase_start_priotask;
+
+    /**
+     * @var uint16_t m_free_slots[MAX_SCHEDULABLE_TASKS]
+     * @brief Ring of free slot indices. Released slots join the tail and are
+     * claimed from the head, so a slot rests as long as possible before it is
+     * handed out under its next generation.
+     */
+    uint16_t m_free_slots[MAX_SCHEDULABLE_TASKS];
+
+    /**
+     * @var uint16_t m_free_head
+     * @brief Position in m_free_slots of the next slot to claim.
+     */
+    uint16_t m_free_head;
+
+    /**
+     * @var uint16_t m_free_count
+     * @brief Number of slots on the free ring.
+     */
+    uint16_t m_free_count;
+
+    /**
+     * @var uint16_t m_slot_gen[MAX_SCHEDULABLE_TASKS]
+     * @brief Generation of each slot, moved on every time the slot is released.
+     */
+    uint16_t m_slot_gen[MAX_SCHEDULABLE_TASKS];
+
+    /**
+     * @var uint16_t m_task_count
+     * @brief Number of slots holding a task, live or zombie.
+     */
+    uint16_t m_task_count;
+
+    /**
+     * @var bool m_has_expired
+     * @brief Set when a task reaches zero attempts, so a pass only walks the
+     * table to reap when there is something to reap.
+     */
+    bool m_has_expired;
+
+    /**
+     * @var uint16_t m_due_heap[MAX_SCHEDULABLE_TASKS]
+     * @brief Binary min-heap of slot indices, earliest due first, then the
+     * higher effective priority.
+     */
+    uint16_t m_due_heap[MAX_SCHEDULABLE_TASKS];
+
+    /**
+     * @var int16_t m_heap_pos[MAX_SCHEDULABLE_TASKS]
+     * @brief Position of each slot in m_due_heap, -1 when it is not queued.
+     */
+    int16_t m_heap_pos[MAX_SCHEDULABLE_TASKS];
+
+    /**
+     * @var uint16_t m_due_count
+     * @brief Number of slots on the due queue.
+     */
+    uint16_t m_due_count;
+
+    /**
+     * @var pdiutil::millis_t m_last_pass_ms
+     * @brief Clock reading of the previous pass, to notice the millisecond
+     * counter wrapping.
+     */
+    pdiutil::millis_t m_last_pass_ms;
+
+    /**
+     * @brief Builds the id a slot is handed out under in its current generation.
+     */
+    pdiutil::task_id_t makeTaskId(uint16_t _slot) const;
+
+    /**
+     * @brief Heap ordering: earlier due time first, then higher effective
+     * priority, then the task that ran shorter last time.
+     */
+    bool dueBefore(uint16_t _slot_a, uint16_t _slot_b) const;
+
+    /**
+     * @brief Heap maintenance, keeping m_heap_pos in step with m_due_heap.
+     */
+    void heapSwap(uint16_t _pos_a, uint16_t _pos_b);
+    void heapSiftUp(uint16_t _pos);
+    void heapSiftDown(uint16_t _pos);
 };
 
 /**
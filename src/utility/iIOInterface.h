@@ -379,6 +379,44 @@ public:
     readStringUntil(_outstr, '\n', false, _yield, 0);
   }
 
+  /**
+   * @brief Reads a line into the caller's buffer and returns a view of it, so
+   *        reading a line allocates nothing.
+   * @param _buffer Where the line is read to. Bytes past its end are still
+   *        read up to the line ending, then dropped.
+   * @param _yield Optional callback function to yield control during reading.
+   * The carriage return and the newline after it are consumed and left out,
+   * exactly as the string variant above does.
+   * @return View of the line in _buffer.
+   */
+  virtual pdiutil::string_view readLine(pdiutil::span<char> _buffer, const CallBackVoidArgFn &_yield = nullptr){
+
+    uint32_t len = 0;
+    char delimiter = '\r';
+
+    if(_yield != nullptr) {
+      _yield();
+    }
+
+    while (available() > 0) {
+      char c = (char)read();
+      if (c == delimiter) {
+        if ('\n' == delimiter) {
+          break;
+        }
+        delimiter = '\n';
+        continue;
+      }
+      if (len < _buffer.size()) {
+        _buffer[len++] = c;
+      }
+      if(_yield != nullptr) {
+        _yield();
+      }
+    }
+    return pdiutil::string_view(_buffer.data(), len);
+  }
+
   /**
    * @brief Checks if the connection is active.
    * @return Connection status (1 for connected, 0 for disconnected).
@@ -77,6 +77,15 @@ public:
    */
   virtual void yield() = 0;
 
+  /**
+   * @brief Idles until the given time has passed, or sooner when the port
+   *        notices work arriving. The serve loop calls this when no task is
+   *        due, so a port that can sleep the cpu or block on its descriptors
+   *        does so here. The default returns at once and the loop keeps polling.
+   * @param ms The longest the caller can afford to be away.
+   */
+  virtual void idle(uint32_t ms){ (void)ms; }
+
   /**
    * @brief Returns a 32-bit random value. Default is a portable xorshift PRNG
    *        seeded from micros_now() — adequate for non-cryptographic use on
@@ -81,26 +81,25 @@ namespace pdistd
     return static_cast<typename pdistd::remove_reference<_Tp>::type &&>(__t);
   }
 
-  // template <typename _Tp>
-  // struct __move_if_noexcept_cond
-  //     : public __and_<__not_<is_nothrow_move_constructible<_Tp>>,
-  //                     is_copy_constructible<_Tp>>::type
-  // {
-  // };
+  template <typename _Tp>
+  struct __move_if_noexcept_cond
+      : public __not_<is_nothrow_move_constructible<_Tp>>::type
+  {
+  };
 
   /**
    *  @brief  Conditionally convert a value to an rvalue.
    *  @param  __x  A thing of arbitrary type.
    *  @return The parameter, possibly cast to an rvalue-reference.
    *
-   *  Same as std::move unless the type's move constructor could throw and the
-   *  type is copyable, in which case an lvalue-reference is returned instead.
+   *  Same as pdistd::move unless the type's move constructor could throw, in
+   *  which case an lvalue-reference is returned instead so it is copied.
    */
-  // template<typename _Tp>
-  //   constexpr typename
-  //   conditional<__move_if_noexcept_cond<_Tp>::value, const _Tp&, _Tp&&>::type
-  //   move_if_noexcept(_Tp& __x) _UCXX_NOEXCEPT
-  //   { return pdistd::move(__x); }
+  template<typename _Tp>
+    constexpr typename
+    conditional<__move_if_noexcept_cond<_Tp>::value, const _Tp&, _Tp&&>::type
+    move_if_noexcept(_Tp& __x) _UCXX_NOEXCEPT
+    { return pdistd::move(__x); }
 
   // declval, from type_traits.
 
@@ -0,0 +1,309 @@
+/***************************** PDI STD File ***********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+Walking and balancing for the red-black tree in rb_tree. None of it looks at a
+value, so every map and set shares this one copy.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+
+#include "rb_tree"
+
+namespace pdistd{
+
+	static void __rb_tree_rotate_left(__rb_tree_node_base* x, __rb_tree_node_base*& root){
+		__rb_tree_node_base* y = x->right;
+		x->right = y->left;
+		if(0 != y->left){
+			y->left->parent = x;
+		}
+		y->parent = x->parent;
+		if(x == root){
+			root = y;
+		}else if(x == x->parent->left){
+			x->parent->left = y;
+		}else{
+			x->parent->right = y;
+		}
+		y->left = x;
+		x->parent = y;
+	}
+
+	static void __rb_tree_rotate_right(__rb_tree_node_base* x, __rb_tree_node_base*& root){
+		__rb_tree_node_base* y = x->left;
+		x->left = y->right;
+		if(0 != y->right){
+			y->right->parent = x;
+		}
+		y->parent = x->parent;
+		if(x == root){
+			root = y;
+		}else if(x == x->parent->right){
+			x->parent->right = y;
+		}else{
+			x->parent->left = y;
+		}
+		y->right = x;
+		x->parent = y;
+	}
+
+	_UCXXEXPORT __rb_tree_node_base* __rb_tree_increment(__rb_tree_node_base* x){
+		if(0 != x->right){
+			x = x->right;
+			while(0 != x->left){
+				x = x->left;
+			}
+			return x;
+		}
+		__rb_tree_node_base* y = x->parent;
+		while(x == y->right){
+			x = y;
+			y = y->parent;
+		}
+		//	Stepping off the largest node of a tree of one lands x on the header already
+		if(x->right != y){
+			x = y;
+		}
+		return x;
+	}
+
+	_UCXXEXPORT __rb_tree_node_base* __rb_tree_decrement(__rb_tree_node_base* x){
+		//	Only the header is red and its own grandparent
+		if(!x->black && x->parent->parent == x){
+			return x->right;
+		}
+		if(0 != x->left){
+			x = x->left;
+			while(0 != x->right){
+				x = x->right;
+			}
+			return x;
+		}
+		__rb_tree_node_base* y = x->parent;
+		while(x == y->left){
+			x = y;
+			y = y->parent;
+		}
+		return y;
+	}
+
+	_UCXXEXPORT void __rb_tree_insert_and_rebalance(bool insert_left, __rb_tree_node_base* x,
+		__rb_tree_node_base* p, __rb_tree_node_base& header)
+	{
+		__rb_tree_node_base*& root = header.parent;
+
+		x->parent = p;
+		x->left = 0;
+		x->right = 0;
+		x->black = false;
+
+		if(insert_left){
+			p->left = x;
+			if(p == &header){
+				header.parent = x;
+				header.right = x;
+			}else if(p == header.left){
+				header.left = x;
+			}
+		}else{
+			p->right = x;
+			if(p == header.right){
+				header.right = x;
+			}
+		}
+
+		while(x != root && !x->parent->black){
+			__rb_tree_node_base* const xpp = x->parent->parent;
+
+			if(x->parent == xpp->left){
+				__rb_tree_node_base* const y = xpp->right;
+				if(0 != y && !y->black){
+					x->parent->black = true;
+					y->black = true;
+					xpp->black = false;
+					x = xpp;
+				}else{
+					if(x == x->parent->right){
+						x = x->parent;
+						__rb_tree_rotate_left(x, root);
+					}
+					x->parent->black = true;
+					xpp->black = false;
+					__rb_tree_rotate_right(xpp, root);
+				}
+			}else{
+				__rb_tree_node_base* const y = xpp->left;
+				if(0 != y && !y->black){
+					x->parent->black = true;
+					y->black = true;
+					xpp->black = false;
+					x = xpp;
+				}else{
+					if(x == x->parent->left){
+						x = x->parent;
+						__rb_tree_rotate_right(x, root);
+					}
+					x->parent->black = true;
+					xpp->black = false;
+					__rb_tree_rotate_left(xpp, root);
+				}
+			}
+		}
+		root->black = true;
+	}
+
+	_UCXXEXPORT __rb_tree_node_base* __rb_tree_rebalance_for_erase(__rb_tree_node_base* z,
+		__rb_tree_node_base& header)
+	{
+		__rb_tree_node_base*& root = header.parent;
+		__rb_tree_node_base*& leftmost = header.left;
+		__rb_tree_node_base*& rightmost = header.right;
+		__rb_tree_node_base* y = z;
+		__rb_tree_node_base* x = 0;
+		__rb_tree_node_base* x_parent = 0;
+
+		if(0 == y->left){
+			x = y->right;
+		}else if(0 == y->right){
+			x = y->left;
+		}else{
+			//	Two children: z's successor, which has no left child, takes its place
+			y = y->right;
+			while(0 != y->left){
+				y = y->left;
+			}
+			x = y->right;
+		}
+
+		if(y != z){
+			z->left->parent = y;
+			y->left = z->left;
+			if(y != z->right){
+				x_parent = y->parent;
+				if(0 != x){
+					x->parent = y->parent;
+				}
+				y->parent->left = x;
+				y->right = z->right;
+				z->right->parent = y;
+			}else{
+				x_parent = y;
+			}
+			if(root == z){
+				root = y;
+			}else if(z->parent->left == z){
+				z->parent->left = y;
+			}else{
+				z->parent->right = y;
+			}
+			y->parent = z->parent;
+			bool color = y->black;
+			y->black = z->black;
+			z->black = color;
+			//	From here y is the node leaving the tree
+			y = z;
+		}else{
+			x_parent = y->parent;
+			if(0 != x){
+				x->parent = y->parent;
+			}
+			if(root == z){
+				root = x;
+			}else if(z->parent->left == z){
+				z->parent->left = x;
+			}else{
+				z->parent->right = x;
+			}
+			if(leftmost == z){
+				if(0 == z->right){
+					leftmost = z->parent;
+				}else{
+					leftmost = x;
+					while(0 != leftmost->left){
+						leftmost = leftmost->left;
+					}
+				}
+			}
+			if(rightmost == z){
+				if(0 == z->left){
+					rightmost = z->parent;
+				}else{
+					rightmost = x;
+					while(0 != rightmost->right){
+						rightmost = rightmost->right;
+					}
+				}
+			}
+		}
+
+		//	Taking out a black node leaves one path short a black, which is pushed up or rotated away
+		if(y->black){
+			while(x != root && (0 == x || x->black)){
+				if(x == x_parent->left){
+					__rb_tree_node_base* w = x_parent->right;
+					if(!w->black){
+						w->black = true;
+						x_parent->black = false;
+						__rb_tree_rotate_left(x_parent, root);
+						w = x_parent->right;
+					}
+					if((0 == w->left || w->left->black) && (0 == w->right || w->right->black)){
+						w->black = false;
+						x = x_parent;
+						x_parent = x_parent->parent;
+					}else{
+						if(0 == w->right || w->right->black){
+							w->left->black = true;
+							w->black = false;
+							__rb_tree_rotate_right(w, root);
+							w = x_parent->right;
+						}
+						w->black = x_parent->black;
+						x_parent->black = true;
+						if(0 != w->right){
+							w->right->black = true;
+						}
+						__rb_tree_rotate_left(x_parent, root);
+						break;
+					}
+				}else{
+					__rb_tree_node_base* w = x_parent->left;
+					if(!w->black){
+						w->black = true;
+						x_parent->black = false;
+						__rb_tree_rotate_right(x_parent, root);
+						w = x_parent->left;
+					}
+					if((0 == w->right || w->right->black) && (0 == w->left || w->left->black)){
+						w->black = false;
+						x = x_parent;
+						x_parent = x_parent->parent;
+					}else{
+						if(0 == w->left || w->left->black){
+							w->right->black = true;
+							w->black = false;
+							__rb_tree_rotate_left(w, root);
+							w = x_parent->left;
+						}
+						w->black = x_parent->black;
+						x_parent->black = true;
+						if(0 != w->left){
+							w->left->black = true;
+						}
+						__rb_tree_rotate_right(x_parent, root);
+						break;
+					}
+				}
+			}
+			if(0 != x){
+				x->black = true;
+			}
+		}
+		return y;
+	}
+
+}
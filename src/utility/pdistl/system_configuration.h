@@ -41,6 +41,41 @@ added by        : Suraj I.
  */
 //#define __UCLIBCXX_STL_BUFFER_SIZE__ 32
 #define __UCLIBCXX_STL_BUFFER_SIZE__ 8
+/*
+ * A vector or string that has to grow takes this percentage of its current
+ * capacity, and never less than the size asked for plus the buffer above, so
+ * appending one element at a time copies each element a bounded number of
+ * times. 100 grows by the buffer alone, the way the containers used to.
+ */
+#ifndef __UCLIBCXX_STL_GROWTH_PERCENT__
+#define __UCLIBCXX_STL_GROWTH_PERCENT__ 150
+#endif
+/*
+ * Characters a string holds inside itself, terminator included, before it
+ * takes a buffer from the heap. Short keys, header names and temporaries then
+ * never touch the allocator, at this many bytes on every string. 0 puts every
+ * string on the heap.
+ */
+#ifndef __UCLIBCXX_STRING_INLINE_SIZE__
+#define __UCLIBCXX_STRING_INLINE_SIZE__ 16
+#endif
+/*
+ * Pointers' worth of room a function keeps inside itself for the callable it
+ * wraps, one of them taken by the holder's vtable. A lambda capturing this and
+ * a couple of references then costs no allocation to make or copy; a bigger
+ * one goes to the heap as before. Every function is this much larger.
+ */
+#ifndef __UCLIBCXX_FUNCTION_INLINE_POINTERS__
+#define __UCLIBCXX_FUNCTION_INLINE_POINTERS__ 4
+#endif
+/*
+ * Eighths of an unordered_map's slots that may be taken, erased ones included,
+ * before it grows. Higher packs more into the same memory at the cost of
+ * longer probe runs; lookups stay short up to about 7.
+ */
+#ifndef __UCLIBCXX_UNORDERED_MAX_LOAD_EIGHTHS__
+#define __UCLIBCXX_UNORDERED_MAX_LOAD_EIGHTHS__ 7
+#endif
 #undef __UCLIBCXX_CODE_EXPANSION__
 
 /*
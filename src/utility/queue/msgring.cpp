@@ -0,0 +1,193 @@
+/**
+ * @file
+ * @brief Length-prefixed message ring
+ */
+
+#include "msgring.h"
+
+/**
+ * @brief Length written where a record did not fit, sending the reader to the
+ * front of the buffer.
+ */
+#define MSGRING_WRAP_MARK 0xFFFF
+
+static inline size_t msgring_load(const volatile size_t *index)
+{
+	return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+static inline void msgring_store(volatile size_t *index, size_t value)
+{
+	__atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief where the record at tail really starts, past any wrap
+ */
+static size_t msgring_front(const MSGRING *r, size_t tail)
+{
+	if (r->size - tail < MSGRING_HEADER_SIZE)
+		return 0;
+
+	uint16_t len;
+	memcpy(&len, r->buf + tail, MSGRING_HEADER_SIZE);
+	return (MSGRING_WRAP_MARK == len) ? 0 : tail;
+}
+
+/**
+ * @brief init a MSGRING object
+ * @param r pointer to a MSGRING object
+ * @param buf pointer to a byte array
+ * @param size size of buf
+ * @return 0 if successfull, otherwise failed
+ */
+int MSGRING_Init(MSGRING *r, uint8_t *buf, size_t size)
+{
+	if (r == NULL || buf == NULL || size <= MSGRING_HEADER_SIZE)
+		return -1;
+
+	r->buf = buf;
+	r->size = size;
+	r->head = r->tail = r->reserved = 0;
+
+	return 0;
+}
+
+/**
+ * @brief find room for a record of len bytes that does not wrap
+ * @param r pointer to a MSGRING object
+ * @param len most the record will hold
+ * @return where to write the record, nullptr if it does not fit
+ *
+ * head is never allowed to catch up with tail from behind, since the two
+ * being equal is what empty looks like. Because a record never wraps, one
+ * longer than half the buffer may not fit even when the ring is empty.
+ */
+uint8_t *MSGRING_Reserve(MSGRING *r, uint16_t len)
+{
+	if (r == NULL || r->buf == NULL || len > MSGRING_MAX_RECORD)
+		return nullptr;
+
+	size_t need = MSGRING_HEADER_SIZE + (size_t)len;
+	size_t head = r->head;
+	size_t tail = msgring_load(&r->tail);
+	size_t at;
+
+	if (head >= tail)
+	{
+		if (r->size - head >= need && (head + need < r->size || tail > 0))
+			at = head;
+		else if (need < tail)
+			at = 0; // wrap to the front
+		else
+			return nullptr;
+	}
+	else if (tail - head > need)
+	{
+		at = head;
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	r->reserved = at;
+	return r->buf + at + MSGRING_HEADER_SIZE;
+}
+
+/**
+ * @brief publish the record reserved last
+ * @param r pointer to a MSGRING object
+ * @param len bytes written, no more than were reserved
+ */
+void MSGRING_Commit(MSGRING *r, uint16_t len)
+{
+	size_t head = r->head;
+	size_t at = r->reserved;
+
+	if (at != head && r->size - head >= MSGRING_HEADER_SIZE)
+	{
+		uint16_t mark = MSGRING_WRAP_MARK;
+		memcpy(r->buf + head, &mark, MSGRING_HEADER_SIZE);
+	}
+	memcpy(r->buf + at, &len, MSGRING_HEADER_SIZE);
+
+	size_t next = at + MSGRING_HEADER_SIZE + len;
+	msgring_store(&r->head, next >= r->size ? 0 : next);
+}
+
+/**
+ * @brief copy a record into the ring
+ * @param r pointer to a MSGRING object
+ * @param data pointer to the record
+ * @param len length of the record
+ * @return 0 if successfull, otherwise failed
+ */
+int MSGRING_Put(MSGRING *r, const uint8_t *data, uint16_t len)
+{
+	uint8_t *slot = MSGRING_Reserve(r, len);
+	if (slot == nullptr)
+		return -1;
+
+	if (len > 0)
+		memcpy(slot, data, len);
+	MSGRING_Commit(r, len);
+	return 0;
+}
+
+/**
+ * @brief the oldest record, left where it is
+ * @param r pointer to a MSGRING object
+ * @param len set to the record length
+ * @return the record, nullptr if the ring is empty
+ */
+const uint8_t *MSGRING_Peek(MSGRING *r, uint16_t *len)
+{
+	size_t tail = r->tail;
+	if (tail == msgring_load(&r->head))
+		return nullptr;
+
+	tail = msgring_front(r, tail);
+	memcpy(len, r->buf + tail, MSGRING_HEADER_SIZE);
+	return r->buf + tail + MSGRING_HEADER_SIZE;
+}
+
+/**
+ * @brief drop the oldest record
+ * @param r pointer to a MSGRING object
+ * @return 0 if successfull, otherwise failed
+ */
+int MSGRING_Consume(MSGRING *r)
+{
+	size_t tail = r->tail;
+	if (tail == msgring_load(&r->head))
+		return -1;
+
+	uint16_t len;
+	tail = msgring_front(r, tail);
+	memcpy(&len, r->buf + tail, MSGRING_HEADER_SIZE);
+
+	size_t next = tail + MSGRING_HEADER_SIZE + len;
+	msgring_store(&r->tail, next >= r->size ? 0 : next);
+	return 0;
+}
+
+/**
+ * @brief bytes in use, headers and wrap gap included
+ * @param r pointer to a MSGRING object
+ */
+size_t MSGRING_Used(const MSGRING *r)
+{
+	size_t head = msgring_load(&r->head);
+	size_t tail = msgring_load(&r->tail);
+	return head >= tail ? head - tail : r->size - tail + head;
+}
+
+/**
+ * @brief whether the ring holds no record
+ * @param r pointer to a MSGRING object
+ */
+bool MSGRING_IsEmpty(const MSGRING *r)
+{
+	return msgring_load(&r->head) == msgring_load(&r->tail);
+}
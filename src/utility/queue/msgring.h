@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @brief Length-prefixed message ring
+ *
+ * Whole records in a byte ring, each a two byte length followed by its bytes.
+ * A record never wraps: when it does not fit before the end of the buffer the
+ * producer leaves a wrap mark there and starts again at the front, so every
+ * record can be written and read in place. The producer asks for room with
+ * MSGRING_Reserve, fills it and publishes it with MSGRING_Commit; the consumer
+ * sees the oldest record with MSGRING_Peek and lets it go with MSGRING_Consume.
+ *
+ * The producer only ever moves head and the consumer only ever moves tail,
+ * each published with a release store and read with an acquire load, so one
+ * producer and one consumer may run in different contexts (a thread and the
+ * loop, or an ISR and the loop) without a lock. More than one of either needs
+ * its own locking around the calls.
+ */
+
+#ifndef _MSG_RING_H_
+#define _MSG_RING_H_
+
+#include <utility/DataTypeDef.h>
+
+/**
+ * @brief Bytes in front of each record holding its length.
+ */
+#define MSGRING_HEADER_SIZE 2
+
+/**
+ * @brief The longest record a ring carries.
+ */
+#define MSGRING_MAX_RECORD 0xFFFE
+
+/**
+ * @struct MSGRING
+ * @brief Represents a message ring.
+ */
+typedef struct
+{
+    uint8_t *buf;         /**< Buffer memory, owned by the caller */
+    size_t size;          /**< Size of the buffer */
+    volatile size_t head; /**< Where the next record goes, moved by the producer */
+    volatile size_t tail; /**< Where the oldest record is, moved by the consumer */
+    size_t reserved;      /**< Producer side: where the pending reservation starts */
+} MSGRING;
+
+/**
+ * @brief Initializes a message ring over a caller owned buffer.
+ *
+ * @param r Pointer to the MSGRING structure to initialize.
+ * @param buf Pointer to the memory buffer to use for the ring.
+ * @param size Size of the memory buffer.
+ * @return 0 on success, -1 on failure.
+ */
+int MSGRING_Init(MSGRING *r, uint8_t *buf, size_t size);
+
+/**
+ * @brief Finds contiguous room for a record of len bytes.
+ *
+ * Nothing is visible to the consumer until MSGRING_Commit. A second reserve
+ * before the commit replaces the first.
+ *
+ * @param r Pointer to the MSGRING structure.
+ * @param len The most the record will hold.
+ * @return Where to write the record, or nullptr if it does not fit.
+ */
+uint8_t *MSGRING_Reserve(MSGRING *r, uint16_t len);
+
+/**
+ * @brief Publishes the reserved record.
+ *
+ * @param r Pointer to the MSGRING structure.
+ * @param len Bytes actually written, no more than were reserved.
+ */
+void MSGRING_Commit(MSGRING *r, uint16_t len);
+
+/**
+ * @brief Copies a record in; MSGRING_Reserve and MSGRING_Commit in one.
+ *
+ * @param r Pointer to the MSGRING structure.
+ * @param data Pointer to the record.
+ * @param len Length of the record.
+ * @return 0 on success, -1 if it does not fit.
+ */
+int MSGRING_Put(MSGRING *r, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief The oldest record, left in place.
+ *
+ * @param r Pointer to the MSGRING structure.
+ * @param len Set to the record length.
+ * @return The record, or nullptr if the ring is empty.
+ */
+const uint8_t *MSGRING_Peek(MSGRING *r, uint16_t *len);
+
+/**
+ * @brief Drops the oldest record.
+ *
+ * @param r Pointer to the MSGRING structure.
+ * @return 0 on success, -1 if the ring is empty.
+ */
+int MSGRING_Consume(MSGRING *r);
+
+/**
+ * @brief Bytes taken by records, their headers and any wrap gap.
+ *
+ * @param r Pointer to the MSGRING structure.
+ */
+size_t MSGRING_Used(const MSGRING *r);
+
+/**
+ * @brief Checks if the ring holds no record.
+ *
+ * @param r Pointer to the MSGRING structure.
+ */
+bool MSGRING_IsEmpty(const MSGRING *r);
+
+#endif
@@ -34,7 +34,7 @@
  * @brief Initializes a queue.
  *
  * This function allocates memory for the queue's buffer and initializes the
- * associated ring buffer.
+ * associated message ring.
  *
  * @param queue Pointer to the `QUEUE` structure to initialize.
  * @param bufferSize The size of the memory buffer to allocate for the queue.
@@ -43,55 +43,123 @@ void QUEUE_Init(QUEUE *queue, int bufferSize)
 {
     queue->buf = pdiutil::safe_new_array<uint8_t>(bufferSize);
     if (nullptr != queue->buf) {
-        RINGBUF_Init(&queue->rb, queue->buf, bufferSize);
+        MSGRING_Init(&queue->rb, queue->buf, bufferSize);
     }
 }
 
 /**
  * @brief Adds data to the queue.
  *
- * This function writes data to the queue using the ring buffer. If the queue
- * is full, the function will return an error.
+ * This function copies data into the message ring as one message. If the
+ * queue is full, the function will return an error.
  *
  * @param queue Pointer to the `QUEUE` structure.
  * @param buffer Pointer to the data to add to the queue.
  * @param len The length of the data to add.
  * @return The number of bytes written to the queue, or -1 if the queue is full.
  */
-int32_t QUEUE_Puts(QUEUE *queue, uint8_t *buffer, uint16_t len)
+int32_t QUEUE_Puts(QUEUE *queue, const uint8_t *buffer, uint16_t len)
 {
-    return PROTO_AddRb(&queue->rb, buffer, len);
+    if (MSGRING_Put(&queue->rb, buffer, len) != 0)
+        return -1;
+    return len;
 }
 
 /**
  * @brief Retrieves data from the queue.
  *
- * This function reads data from the queue using the ring buffer. If the queue
- * is empty, the function will return an error.
+ * This function copies the oldest message out of the message ring. If the
+ * queue is empty, the function will return an error.
  *
  * @param queue Pointer to the `QUEUE` structure.
  * @param buffer Pointer to the buffer to store the retrieved data.
  * @param len Pointer to store the length of the retrieved data.
  * @param maxLen The maximum length of data to retrieve.
- * @return The number of bytes read from the queue, or -1 if the queue is empty.
+ * @return 0 when a message is read, or -1 if the queue is empty or the
+ * message did not fit.
  */
 int32_t QUEUE_Gets(QUEUE *queue, uint8_t *buffer, uint16_t *len, uint16_t maxLen)
 {
-    return PROTO_ParseRb(&queue->rb, buffer, len, maxLen);
+    uint16_t msgLen = 0;
+    const uint8_t *msg = MSGRING_Peek(&queue->rb, &msgLen);
+    if (nullptr == msg)
+        return -1;
+
+    // one that can never be read would hold up everything behind it
+    int32_t result = -1;
+    if (msgLen <= maxLen)
+    {
+        memcpy(buffer, msg, msgLen);
+        *len = msgLen;
+        result = 0;
+    }
+    MSGRING_Consume(&queue->rb);
+    return result;
 }
 
 /**
- * @brief Checks if the queue is empty.
+ * @brief Makes room for a message to be written in place.
+ *
+ * @param queue Pointer to the `QUEUE` structure.
+ * @param len The most the message will hold.
+ * @return Where to write the message, or nullptr if the queue is full.
+ */
+uint8_t *QUEUE_Reserve(QUEUE *queue, uint16_t len)
+{
+    return MSGRING_Reserve(&queue->rb, len);
+}
+
+/**
+ * @brief Adds the message written in place since `QUEUE_Reserve`.
+ *
+ * @param queue Pointer to the `QUEUE` structure.
+ * @param len The length actually written.
+ */
+void QUEUE_Commit(QUEUE *queue, uint16_t len)
+{
+    MSGRING_Commit(&queue->rb, len);
+}
+
+/**
+ * @brief The oldest message, left in the queue.
+ *
+ * @param queue Pointer to the `QUEUE` structure.
+ * @param len Pointer to store the length of the message.
+ * @return The message, or nullptr if the queue is empty.
+ */
+const uint8_t *QUEUE_Peek(QUEUE *queue, uint16_t *len)
+{
+    return MSGRING_Peek(&queue->rb, len);
+}
+
+/**
+ * @brief Drops the oldest message.
  *
- * This function checks whether the queue is empty by examining the fill count
- * of the ring buffer.
+ * @param queue Pointer to the `QUEUE` structure.
+ * @return True if a message was dropped, false if the queue is empty.
+ */
+bool QUEUE_Consume(QUEUE *queue)
+{
+    return MSGRING_Consume(&queue->rb) == 0;
+}
+
+/**
+ * @brief Bytes the queued messages take up.
+ *
+ * @param queue Pointer to the `QUEUE` structure.
+ */
+size_t QUEUE_Used(QUEUE *queue)
+{
+    return MSGRING_Used(&queue->rb);
+}
+
+/**
+ * @brief Checks if the queue is empty.
  *
  * @param queue Pointer to the `QUEUE` structure.
  * @return True if the queue is empty, false otherwise.
  */
 bool QUEUE_IsEmpty(QUEUE *queue)
 {
-    if (queue->rb.fill_cnt <= 0)
-        return true;
-    return false;
+    return MSGRING_IsEmpty(&queue->rb);
 }
@@ -31,20 +31,22 @@
 #ifndef USER_QUEUE_H_
 #define USER_QUEUE_H_
 
-#include "proto.h"
+#include "msgring.h"
 
 /**
  * @struct QUEUE
  * @brief Represents a queue structure.
  *
  * The `QUEUE` structure provides a simple abstraction for managing a queue
- * using a ring buffer. It supports operations for adding and retrieving data
- * in a FIFO (First In, First Out) manner.
+ * of messages over a length-prefixed message ring. Messages come out whole and
+ * in FIFO (First In, First Out) order. Besides the copying calls, a message can
+ * be built in place with `QUEUE_Reserve`/`QUEUE_Commit` and sent from where it
+ * lies with `QUEUE_Peek`/`QUEUE_Consume`.
  */
 typedef struct
 {
     uint8_t *buf; ///< Pointer to the memory buffer used for the queue.
-    RINGBUF rb;   ///< Ring buffer structure for managing the queue.
+    MSGRING rb;   ///< Message ring managing the queue.
 } QUEUE;
 
 /**
@@ -69,7 +71,7 @@ void QUEUE_Init(QUEUE *queue, int bufferSize);
  * @param len The length of the data to add.
  * @return The number of bytes written to the queue, or -1 if the queue is full.
  */
-int32_t QUEUE_Puts(QUEUE *queue, uint8_t *buffer, uint16_t len);
+int32_t QUEUE_Puts(QUEUE *queue, const uint8_t *buffer, uint16_t len);
 
 /**
  * @brief Retrieves data from the queue.
@@ -81,10 +83,52 @@ int32_t QUEUE_Puts(QUEUE *queue, uint8_t *buffer, uint16_t len);
  * @param buffer Pointer to the buffer to store the retrieved data.
  * @param len Pointer to store the length of the retrieved data.
  * @param maxLen The maximum length of data to retrieve.
- * @return The number of bytes read from the queue, or -1 if the queue is empty.
+ * @return 0 when a message is read, or -1 if the queue is empty. A message
+ * longer than maxLen is dropped and -1 returned.
  */
 int32_t QUEUE_Gets(QUEUE *queue, uint8_t *buffer, uint16_t *len, uint16_t maxLen);
 
+/**
+ * @brief Makes room for a message to be written in place.
+ *
+ * @param queue Pointer to the `QUEUE` structure.
+ * @param len The most the message will hold.
+ * @return Where to write the message, or nullptr if the queue is full.
+ */
+uint8_t *QUEUE_Reserve(QUEUE *queue, uint16_t len);
+
+/**
+ * @brief Adds the message written in place since `QUEUE_Reserve`.
+ *
+ * @param queue Pointer to the `QUEUE` structure.
+ * @param len The length actually written.
+ */
+void QUEUE_Commit(QUEUE *queue, uint16_t len);
+
+/**
+ * @brief The oldest message, left in the queue.
+ *
+ * @param queue Pointer to the `QUEUE` structure.
+ * @param len Pointer to store the length of the message.
+ * @return The message, or nullptr if the queue is empty.
+ */
+const uint8_t *QUEUE_Peek(QUEUE *queue, uint16_t *len);
+
+/**
+ * @brief Drops the oldest message.
+ *
+ * @param queue Pointer to the `QUEUE` structure.
+ * @return True if a message was dropped, false if the queue is empty.
+ */
+bool QUEUE_Consume(QUEUE *queue);
+
+/**
+ * @brief Bytes the queued messages take up.
+ *
+ * @param queue Pointer to the `QUEUE` structure.
+ */
+size_t QUEUE_Used(QUEUE *queue);
+
 /**
  * @brief Checks if the queue is empty.
  *
@@ -35,6 +35,38 @@ created Date    : 1st June 2019
  */
 #define DASHBOARD_JSON_RESERVE 1024
 
+/**
+ * @define DASHBOARD_EVENT_INTERVAL_MS
+ * @brief How often the sections are rebuilt for the open event streams, and
+ * how often a page without one polls instead.
+ */
+#ifndef DASHBOARD_EVENT_INTERVAL_MS
+#define DASHBOARD_EVENT_INTERVAL_MS 3000
+#endif
+
+/**
+ * @enum dashboard_section_t
+ * @brief The parts of the monitor payload that are pushed on their own.
+ */
+enum dashboard_section_t {
+	DASHBOARD_SECTION_CLOCK,
+	DASHBOARD_SECTION_NETWORK,
+	DASHBOARD_SECTION_STORAGE,
+	DASHBOARD_SECTION_TASKS,
+	DASHBOARD_SECTION_SESSIONS,
+	DASHBOARD_SECTION_GPIO,
+	DASHBOARD_SECTION_MAX
+};
+
+/**
+ * @struct dashboard_stream_t
+ * @brief An open event stream and the session it was opened under.
+ */
+struct dashboard_stream_t {
+	int16_t m_stream;
+	char m_token[WEB_SESSION_TOKEN_HEX_LEN + 1];
+};
+
 /**
  * DashboardController class
  */
@@ -45,7 +77,9 @@ class DashboardController : public Controller {
 		/**
 		 * DashboardController constructor
 		 */
-		DashboardController():Controller("dashboard"){
+		DashboardController():Controller("dashboard"),
+		m_stream_count(0),
+		m_event_task(-1){
 		}
 
 		/**
@@ -63,6 +97,7 @@ class DashboardController : public Controller {
 			if( nullptr != this->m_route_handler ){
 				this->m_route_handler->register_route( WEB_SERVER_DASHBOARD_ROUTE, [&]() { this->handleDashboardRoute(); }, AUTH_MIDDLEWARE );
 	      		this->m_route_handler->register_route( WEB_SERVER_DASHBOARD_MONITOR_ROUTE, [&]() { this->handleDashboardMonitor(); }, API_MIDDLEWARE );
+	      		this->m_route_handler->register_route( WEB_SERVER_DASHBOARD_EVENTS_ROUTE, [&]() { this->handleDashboardEvents(); }, API_MIDDLEWARE );
 			}
 		}
 
@@ -89,7 +124,17 @@ class DashboardController : public Controller {
 			_response += CHARPTR_WRAP("0,\"nm\":\"\",\"ip\":\"\",\"mc\":\"\",\"rs\":0,\"nt\":0");
 #endif
 
-			_response += CHARPTR_WRAP("},\"nwt\":");
+			_response += "}";
+		}
+
+		/**
+		 * append the uptime and the network time, which change on every look.
+		 */
+		void appendClockJson(pdiutil::string &_response)
+		{
+			_response += CHARPTR_WRAP("\"up\":");
+			_response += pdiutil::to_string((int32_t)((uint32_t)__i_dvc_ctrl.millis_now() / 1000));
+			_response += CHARPTR_WRAP(",\"nwt\":");
 			_response += pdiutil::to_string(__i_ntp.get_ntp_time());
 		}
 
@@ -99,13 +144,13 @@ class DashboardController : public Controller {
 		void appendStorageJson(pdiutil::string &_response)
 		{
 #ifdef ENABLE_STORAGE_SERVICE
-			_response += CHARPTR_WRAP(",\"fs\":{\"t\":");
+			_response += CHARPTR_WRAP("\"fs\":{\"t\":");
 			_response += pdiutil::to_string((int32_t)__i_fs.getTotalSize());
 			_response += CHARPTR_WRAP(",\"u\":");
 			_response += pdiutil::to_string((int32_t)__i_fs.getUsedSize());
 			_response += "}";
 #else
-			_response += CHARPTR_WRAP(",\"fs\":0");
+			_response += CHARPTR_WRAP("\"fs\":0");
 #endif
 		}
 
@@ -119,9 +164,7 @@ class DashboardController : public Controller {
 		{
 			uint32_t _now = (uint32_t)__i_dvc_ctrl.millis_now();
 
-			_response += CHARPTR_WRAP(",\"up\":");
-			_response += pdiutil::to_string((int32_t)(_now / 1000));
-			_response += CHARPTR_WRAP(",\"hp\":");
+			_response += CHARPTR_WRAP("\"hp\":");
 			_response += pdiutil::to_string((int32_t)__i_dvc_ctrl.get_free_heap());
 			_response += CHARPTR_WRAP(",\"hb\":");
 			_response += pdiutil::to_string((int32_t)__i_dvc_ctrl.get_max_free_block());
@@ -195,7 +238,7 @@ class DashboardController : public Controller {
 		 */
 		void appendSessionsJson(pdiutil::string &_response)
 		{
-			_response += CHARPTR_WRAP(",\"se\":[");
+			_response += CHARPTR_WRAP("\"se\":[");
 
 #ifdef ENABLE_AUTH_SERVICE
 			uint32_t _now = (uint32_t)__i_dvc_ctrl.millis_now();
@@ -230,7 +273,7 @@ class DashboardController : public Controller {
 		 */
 		void appendGpioJson(pdiutil::string &_response)
 		{
-			_response += CHARPTR_WRAP(",\"gm\":");
+			_response += CHARPTR_WRAP("\"gm\":");
 
 #ifdef ENABLE_GPIO_SERVICE
 			_response += pdiutil::to_string(ANALOG_GPIO_RESOLUTION);
@@ -314,11 +357,11 @@ class DashboardController : public Controller {
 			_response->reserve(DASHBOARD_JSON_RESERVE);
 			*_response = "{";
 
-			this->appendNetworkJson(*_response);
-			this->appendStorageJson(*_response);
-			this->appendTasksJson(*_response);
-			this->appendSessionsJson(*_response);
-			this->appendGpioJson(*_response);
+			for (uint8_t _section = 0; _section < DASHBOARD_SECTION_MAX; _section++)
+			{
+				if (_section > 0) *_response += ",";
+				this->appendSectionJson((dashboard_section_t)_section, *_response);
+			}
 
 			*_response += "}";
 
@@ -328,6 +371,108 @@ class DashboardController : public Controller {
 			pdiutil::safe_delete(_response);
 		}
 
+		/**
+		 * handle dashboard event stream calls. the connection is kept and the
+		 * sections that changed are pushed to it every DASHBOARD_EVENT_INTERVAL_MS,
+		 * from one snapshot shared by every open stream, so the cost of a page
+		 * left open no longer grows with the number of viewers.
+		 */
+		void handleDashboardEvents(void)
+		{
+			if (nullptr == this->m_web_resource || nullptr == this->m_web_resource->m_server || nullptr == this->m_route_handler)
+			{
+				return;
+			}
+
+			web_session_t *_session = this->m_route_handler->active_session();
+
+			if (nullptr == _session || m_stream_count >= HTTP_SERVER_MAX_EVENT_STREAMS)
+			{
+				this->m_web_resource->m_server->send(HTTP_RESP_SERVICE_UNAVAILABLE, MIME_TYPE_TEXT_PLAIN, "");
+				return;
+			}
+
+			int16_t _stream = this->m_web_resource->m_server->openEventStream();
+			if (_stream < 0) return;
+
+			// the streams already open get what changed since their last event,
+			// so the newcomer starts from the same snapshot they now hold
+			this->pushChangedSections();
+
+			pdiutil::string _payload;
+			_payload.reserve(DASHBOARD_JSON_RESERVE);
+			_payload = "{";
+			for (uint8_t _section = 0; _section < DASHBOARD_SECTION_MAX; _section++)
+			{
+				if (_section > 0) _payload += ",";
+				_payload += m_sections[_section];
+			}
+			_payload += "}";
+
+			if (!this->m_web_resource->m_server->sendEvent(_stream, nullptr, _payload.c_str())) return;
+
+			m_streams[m_stream_count].m_stream = _stream;
+			memcpy(m_streams[m_stream_count].m_token, _session->m_token, sizeof(m_streams[m_stream_count].m_token));
+			m_stream_count++;
+
+			if (m_event_task < 0)
+			{
+				m_event_task = __task_scheduler.setInterval([&]() { this->pushChangedSections(); }, DASHBOARD_EVENT_INTERVAL_MS, __i_dvc_ctrl.millis_now(), DEFAULT_TASK_PRIORITY, RODT_ATTR("dashboard"));
+			}
+		}
+
+		/**
+		 * rebuild the sections once and send those that changed to every open
+		 * stream. a stream whose client left, or whose session ended, is closed.
+		 */
+		void pushChangedSections(void)
+		{
+			for (uint8_t _idx = m_stream_count; _idx > 0; _idx--)
+			{
+				dashboard_stream_t &_entry = m_streams[_idx - 1];
+				if (nullptr == __web_session_manager.validate(_entry.m_token))
+				{
+					this->m_web_resource->m_server->closeEventStream(_entry.m_stream);
+					this->dropStream(_idx - 1);
+				}
+			}
+
+			pdiutil::string _payload;
+			_payload.reserve(DASHBOARD_JSON_RESERVE);
+			pdiutil::string _section;
+			_section.reserve(DASHBOARD_JSON_RESERVE / 2);
+
+			for (uint8_t _idx = 0; _idx < DASHBOARD_SECTION_MAX; _idx++)
+			{
+				_section.clear();
+				this->appendSectionJson((dashboard_section_t)_idx, _section);
+				if (_section == m_sections[_idx]) continue;
+
+				m_sections[_idx] = _section;
+				_payload += _payload.empty() ? "{" : ",";
+				_payload += _section;
+			}
+
+			if (!_payload.empty())
+			{
+				_payload += "}";
+
+				for (uint8_t _idx = m_stream_count; _idx > 0; _idx--)
+				{
+					if (!this->m_web_resource->m_server->sendEvent(m_streams[_idx - 1].m_stream, nullptr, _payload.c_str()))
+					{
+						this->dropStream(_idx - 1);
+					}
+				}
+			}
+
+			if (0 == m_stream_count && m_event_task >= 0)
+			{
+				__task_scheduler.clearInterval(m_event_task);
+				m_event_task = -1;
+			}
+		}
+
 		/**
 		 * handle dashboard page route. it build & send dashboard html to client.
 		 */
@@ -335,44 +480,78 @@ class DashboardController : public Controller {
 		{
 			LogI("Handling Dashboard route\n");
 
-			char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-			if (nullptr == _page) return;
+			PageWriter _page(this->m_web_resource->m_server);
+			if (!_page.ok()) return;
 
-			BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+			_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 			concat_header_html( _page, true );
 
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_STYLE);
-			CONTINUE_SEND_IN_CHUNK(_page);
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_HEAD);
-			CONTINUE_SEND_IN_CHUNK(_page);
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_STORAGE);
-			CONTINUE_SEND_IN_CHUNK(_page);
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_TASKS);
-			CONTINUE_SEND_IN_CHUNK(_page);
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_SESSIONS);
-			CONTINUE_SEND_IN_CHUNK(_page);
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_NETWORK);
-			CONTINUE_SEND_IN_CHUNK(_page);
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_GPIO);
-			CONTINUE_SEND_IN_CHUNK(_page);
-
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_SCRIPT1);
-			CONTINUE_SEND_IN_CHUNK(_page);
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_SCRIPT2);
-			CONTINUE_SEND_IN_CHUNK(_page);
-			strcat_ro(_page, WEB_SERVER_DASHBOARD_SCRIPT3);
-			CONTINUE_SEND_IN_CHUNK(_page);
-
-			strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-			CONTINUE_SEND_IN_CHUNK(_page);
-
-			END_SENDING_CHUNK();
-
-			pdiutil::safe_delete_array(_page);
+			_page.append_ro(WEB_SERVER_DASHBOARD_STYLE);
+			_page.append_ro(WEB_SERVER_DASHBOARD_HEAD);
+			_page.append_ro(WEB_SERVER_DASHBOARD_STORAGE);
+			_page.append_ro(WEB_SERVER_DASHBOARD_TASKS);
+			_page.append_ro(WEB_SERVER_DASHBOARD_SESSIONS);
+			_page.append_ro(WEB_SERVER_DASHBOARD_NETWORK);
+			_page.append_ro(WEB_SERVER_DASHBOARD_GPIO);
+
+			_page.append_ro(WEB_SERVER_DASHBOARD_SCRIPT1);
+			_page.append_ro(WEB_SERVER_DASHBOARD_INTERVAL_TOP);
+			_page.append(pdiutil::to_string((int32_t)DASHBOARD_EVENT_INTERVAL_MS).c_str());
+			_page.append_ro(WEB_SERVER_DASHBOARD_INTERVAL_BOTTOM);
+			_page.append_ro(WEB_SERVER_DASHBOARD_SCRIPT2);
+			_page.append_ro(WEB_SERVER_DASHBOARD_SCRIPT3);
+
+			_page.append_ro(WEB_SERVER_FOOTER_HTML);
+
+			_page.end();
+
 		}
 
 	private:
 
+		/**
+		 * append one section of the monitor payload.
+		 */
+		void appendSectionJson(dashboard_section_t _section, pdiutil::string &_response)
+		{
+			switch (_section)
+			{
+				case DASHBOARD_SECTION_CLOCK:    this->appendClockJson(_response); break;
+				case DASHBOARD_SECTION_NETWORK:  this->appendNetworkJson(_response); break;
+				case DASHBOARD_SECTION_STORAGE:  this->appendStorageJson(_response); break;
+				case DASHBOARD_SECTION_TASKS:    this->appendTasksJson(_response); break;
+				case DASHBOARD_SECTION_SESSIONS: this->appendSessionsJson(_response); break;
+				case DASHBOARD_SECTION_GPIO:     this->appendGpioJson(_response); break;
+				default: break;
+			}
+		}
+
+		/**
+		 * forget an open stream, the last one takes its place.
+		 */
+		void dropStream(uint8_t _idx)
+		{
+			if (_idx >= m_stream_count) return;
+			m_stream_count--;
+			if (_idx != m_stream_count) m_streams[_idx] = m_streams[m_stream_count];
+		}
+
+		/**
+		 * last pushed text of each section, shared by every open stream
+		 */
+		pdiutil::string m_sections[DASHBOARD_SECTION_MAX];
+
+		/**
+		 * streams the sections are pushed to
+		 */
+		dashboard_stream_t m_streams[HTTP_SERVER_MAX_EVENT_STREAMS];
+		uint8_t m_stream_count;
+
+		/**
+		 * interval pushing the sections, -1 while no stream is open
+		 */
+		pdiutil::task_id_t m_event_task;
+
 		/**
 		 * lifetime cpu share of a task, scaled by 100 so it stays integral.
 		 */
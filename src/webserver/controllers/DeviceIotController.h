@@ -55,20 +55,17 @@ public:
 	/**
 	 * build device register config html.
 	 *
-	 * @param	char*	_page
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
+	 * @param	PageWriter&	_page
 	 */
-	void build_device_register_config_html(char *_page, int _max_size = PAGE_HTML_MAX_SIZE)
+	void build_device_register_config_html(PageWriter &_page)
 	{
 		if (nullptr == this->m_web_resource || nullptr == this->m_web_resource->m_db_conn)
 		{
 			return;
 		}
 
-		memset(_page, 0, _max_size);
 		concat_header_html( _page );
-		strcat_ro(_page, WEB_SERVER_DEVICE_REGISTER_CONFIG_PAGE_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_DEVICE_REGISTER_CONFIG_PAGE_TOP);
 
 		device_iot_config_table _device_iot_configs;
 		this->m_web_resource->m_db_conn->get_device_iot_config_table(&_device_iot_configs);
@@ -76,10 +73,8 @@ public:
 		concat_tr_input_html_tags(_page, RODT_ATTR("Device Id:"), RODT_ATTR("duid"), _device_iot_configs.device_iot_duid, DEVICE_IOT_DUID_MAX_LENGTH - 1);
 		concat_tr_input_html_tags(_page, RODT_ATTR("Registry Host:"), RODT_ATTR("dhst"), _device_iot_configs.device_iot_host, DEVICE_IOT_HOST_BUF_SIZE - 1);
 		concat_csrf_input_html_tag(_page);
-		CONTINUE_SEND_IN_CHUNK(_page);
 
-		strcat_ro(_page, WEB_SERVER_FOOTER_WITH_OTP_MONITOR_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_FOOTER_WITH_OTP_MONITOR_HTML);
 	}
 
 	/**
@@ -120,15 +115,14 @@ public:
 		}
 		else
 		{
-			char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-			if (nullptr == _page) return;
+			PageWriter _page(this->m_web_resource->m_server);
+			if (!_page.ok()) return;
 			
-			BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+			_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 			this->build_device_register_config_html(_page);
-			END_SENDING_CHUNK();
+			_page.end();
 
 			// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-			pdiutil::safe_delete_array(_page);
 		}
 	}
 };
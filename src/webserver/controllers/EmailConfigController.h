@@ -68,19 +68,16 @@ public:
 	/**
 	 * build email config html.
 	 *
-	 * @param	char*		_page
+	 * @param	PageWriter&		_page
 	 * @param	bool|false	_is_error
 	 * @param	bool|false	_enable_flash
 	 * @param	bool|false	_is_test_mail
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 	 */
-	void build_email_config_html(char *_page, bool _is_error = false, bool _enable_flash = false, bool _is_test_mail = false, int _max_size = PAGE_HTML_MAX_SIZE)
+	void build_email_config_html(PageWriter &_page, bool _is_error = false, bool _enable_flash = false, bool _is_test_mail = false)
 	{
 
-		// memset(_page, 0, _max_size);
 		concat_header_html( _page );
-		strcat_ro(_page, WEB_SERVER_EMAIL_CONFIG_PAGE_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_EMAIL_CONFIG_PAGE_TOP);
 
 		char _port[10];
 		memset(_port, 0, 10);
@@ -94,7 +91,6 @@ public:
 		concat_tr_input_html_tags(_page, RODT_ATTR("Mail Port:"), RODT_ATTR("ml_prt"), _port);
 		concat_tr_input_html_tags(_page, RODT_ATTR("Mail Username:"), RODT_ATTR("ml_usr"), this->email_configs.mail_username, DEFAULT_MAIL_USERNAME_MAX_SIZE - 1);
 		concat_tr_input_html_tags(_page, RODT_ATTR("Mail Password:"), RODT_ATTR("ml_psw"), this->email_configs.mail_password, DEFAULT_MAIL_PASSWORD_MAX_SIZE - 1, (char *)"password");
-		CONTINUE_SEND_IN_CHUNK(_page);
 
 		concat_tr_input_html_tags(_page, RODT_ATTR("Mail From:"), RODT_ATTR("ml_frm"), this->email_configs.mail_from, DEFAULT_MAIL_FROM_MAX_SIZE - 1);
 		concat_tr_input_html_tags(_page, RODT_ATTR("Mail From Name:"), RODT_ATTR("ml_frnm"), this->email_configs.mail_from_name, DEFAULT_MAIL_FROM_NAME_MAX_SIZE - 1);
@@ -103,17 +99,15 @@ public:
 		concat_tr_input_html_tags(_page, RODT_ATTR("Mail Subject:"), RODT_ATTR("ml_sub"), this->email_configs.mail_subject, DEFAULT_MAIL_SUBJECT_MAX_SIZE - 1);
 		concat_tr_input_html_tags(_page, RODT_ATTR("Send Test Mail ?"), RODT_ATTR("tstml"), "test", HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_CHECKBOX_TAG_TYPE, false);
 		// concat_tr_input_html_tags( _page, RODT_ATTR("Mail Frequency:"), RODT_ATTR("ml_freq"), _freq );
-		CONTINUE_SEND_IN_CHUNK(_page);
 
 		concat_csrf_input_html_tag( _page );
-		strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
+		_page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 
 		if (_enable_flash)
 			concat_flash_message_div(_page, _is_error ? RODT_ATTR("Invalid length error") : _is_test_mail ? HTML_EMAIL_SUCCESS_FLASH
 																									 : HTML_SUCCESS_FLASH,
 									 _is_error ? ALERT_DANGER : ALERT_SUCCESS);
-		strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_FOOTER_HTML);
 	}
 
 	/**
@@ -196,15 +190,14 @@ public:
 			_is_posted = true;
 		}
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		this->build_email_config_html(_page, _is_error, _is_posted, _is_test_mail);
-		END_SENDING_CHUNK();
+		_page.end();
 
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 
 		if (_is_posted && !_is_error && _is_test_mail)
 		{
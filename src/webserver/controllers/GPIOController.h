@@ -150,46 +150,40 @@ public:
 			return;
 		}
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		concat_header_html( _page );
-		strcat_ro(_page, WEB_SERVER_MENU_CARD_PAGE_WRAP_TOP);
+		_page.append_ro(WEB_SERVER_MENU_CARD_PAGE_WRAP_TOP);
 
 		concat_svg_menu_card(_page, WEB_SERVER_GPIO_MENU_TITLE_MODES, SVG_ICON48_PATH_TUNE, WEB_SERVER_GPIO_MODE_CONFIG_ROUTE);
 		concat_svg_menu_card(_page, WEB_SERVER_GPIO_MENU_TITLE_CONTROL, SVG_ICON48_PATH_GAME_ASSET, WEB_SERVER_GPIO_WRITE_CONFIG_ROUTE);
 		concat_svg_menu_card(_page, WEB_SERVER_GPIO_MENU_TITLE_SERVER, SVG_ICON48_PATH_COMPUTER, WEB_SERVER_GPIO_SERVER_CONFIG_ROUTE);
-		CONTINUE_SEND_IN_CHUNK(_page);
 		concat_svg_menu_card(_page, WEB_SERVER_GPIO_MENU_TITLE_MONITOR, SVG_ICON48_PATH_EYE, WEB_SERVER_GPIO_MONITOR_ROUTE);
 		concat_svg_menu_card(_page, WEB_SERVER_GPIO_MENU_TITLE_EVENT, SVG_ICON48_PATH_NOTIFICATION, WEB_SERVER_GPIO_EVENT_CONFIG_ROUTE);
 
-		strcat_ro(_page, WEB_SERVER_MENU_CARD_PAGE_WRAP_BOTTOM);
-		strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_MENU_CARD_PAGE_WRAP_BOTTOM);
+		_page.append_ro(WEB_SERVER_FOOTER_HTML);
 
-		END_SENDING_CHUNK();
+		_page.end();
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 	}
 
 	/**
 	 * build gpio monitor html page
 	 *
-	 * @param	char*	_page
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
+	 * @param	PageWriter&	_page
 	 */
-	void build_gpio_monitor_html(char *_page, int _max_size = PAGE_HTML_MAX_SIZE)
+	void build_gpio_monitor_html(PageWriter &_page)
 	{
-		// memset(_page, 0, _max_size);
 		concat_header_html( _page );
-		strcat_ro(_page, WEB_SERVER_GPIO_MONITOR_PAGE_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_GPIO_MONITOR_PAGE_TOP);
 
 		char *_gpio_monitor_table_heading[] = {"Pin", "Mode", "value"};
-		strcat_ro(_page, HTML_TABLE_OPEN_TAG);
+		_page.append_ro(HTML_TABLE_OPEN_TAG);
 		concat_style_attribute(_page, RODT_ATTR("width:92%"));
-		strcat_ro(_page, HTML_TAG_CLOSE_BRACKET);
+		_page.append_ro(HTML_TAG_CLOSE_BRACKET);
 		concat_table_heading_row(_page, _gpio_monitor_table_heading, 3, nullptr, nullptr, RODT_ATTR("btn"), nullptr);
 
 		char _name[5];
@@ -203,7 +197,6 @@ public:
 				__appendUintToBuff(_name, "D%d", _pin, 4);
 
 				concat_table_data_row(_page, _gpio_monitor_table_data, 3, nullptr, nullptr, RODT_ATTR("btnd"), nullptr);
-				CONTINUE_SEND_IN_CHUNK(_page);
 			}
 		}
 
@@ -215,27 +208,24 @@ public:
 				__appendUintToBuff(_name, "A%d", _pin, 4);
 
 				concat_table_data_row(_page, _gpio_monitor_table_data, 3, nullptr, nullptr, RODT_ATTR("btnd"), nullptr);
-				CONTINUE_SEND_IN_CHUNK(_page);
 			}
 		}
-		strcat_ro(_page, HTML_TABLE_CLOSE_TAG);
+		_page.append_ro(HTML_TABLE_CLOSE_TAG);
 
-		strcat_ro(_page, HTML_DIV_OPEN_TAG);
+		_page.append_ro(HTML_DIV_OPEN_TAG);
 		concat_style_attribute(_page, RODT_ATTR("display:inline-flex;margin-top:25px;"));
-		strcat_ro(_page, HTML_TAG_CLOSE_BRACKET);
+		_page.append_ro(HTML_TAG_CLOSE_BRACKET);
 		
 		pdiutil::string y_axis_title = CHARPTR_WRAP("A0 ( 0 - 1024 )");
 		pdiutil::string y_axis_title_style = CHARPTR_WRAP("writing-mode:vertical-lr");
 		concat_graph_axis_title_div(_page, (char*)y_axis_title.c_str(), (char*)y_axis_title_style.c_str());
 
-		strcat_ro(_page, WEB_SERVER_GPIO_MONITOR_SVG_ELEMENT);
-		strcat_ro(_page, HTML_DIV_CLOSE_TAG);
+		_page.append_ro(WEB_SERVER_GPIO_MONITOR_SVG_ELEMENT);
+		_page.append_ro(HTML_DIV_CLOSE_TAG);
 
 		pdiutil::string x_axis_title = CHARPTR_WRAP("Time");
 		concat_graph_axis_title_div(_page, (char*)x_axis_title.c_str());
-		CONTINUE_SEND_IN_CHUNK(_page);
-		strcat_ro(_page, WEB_SERVER_FOOTER_WITH_ANALOG_MONITOR_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_FOOTER_WITH_ANALOG_MONITOR_HTML);
 	}
 
 	/**
@@ -251,32 +241,28 @@ public:
 			return;
 		}
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		this->build_gpio_monitor_html(_page);
-		END_SENDING_CHUNK();
+		_page.end();
 
 		this->_last_monitor_point.x = 0;
 		this->_last_monitor_point.y = GPIO_MAX_GRAPH_HEIGHT - GPIO_GRAPH_BOTTOM_MARGIN;
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 	}
 
 	/**
 	 * build gpio server config html.
 	 *
-	 * @param	char*		_page
+	 * @param	PageWriter&		_page
 	 * @param	bool|false	_enable_flash
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 	 */
-	void build_gpio_server_config_html(char *_page, bool _enable_flash = false, int _max_size = PAGE_HTML_MAX_SIZE)
+	void build_gpio_server_config_html(PageWriter &_page, bool _enable_flash = false)
 	{
-		// memset(_page, 0, _max_size);
 		concat_header_html( _page );
-		strcat_ro(_page, WEB_SERVER_GPIO_SERVER_PAGE_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_GPIO_SERVER_PAGE_TOP);
 
 		char _port[10], _freq[10];
 		memset(_port, 0, 10);
@@ -287,14 +273,12 @@ public:
 		concat_tr_input_html_tags(_page, RODT_ATTR("Host Address:"), RODT_ATTR("hst"), __gpio_service.m_gpio_config_copy.gpio_host, GPIO_HOST_BUF_SIZE - 1);
 		concat_tr_input_html_tags(_page, RODT_ATTR("Host Port:"), RODT_ATTR("prt"), _port);
 		concat_tr_input_html_tags(_page, RODT_ATTR("Post Frequency:"), RODT_ATTR("frq"), _freq);
-		CONTINUE_SEND_IN_CHUNK(_page);
 
 		concat_csrf_input_html_tag( _page );
-		strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
+		_page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 		if (_enable_flash)
 			concat_flash_message_div(_page, HTML_SUCCESS_FLASH, ALERT_SUCCESS);
-		strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_FOOTER_HTML);
 	}
 
 	/**
@@ -334,15 +318,14 @@ public:
 			_is_posted = true;
 		}
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		this->build_gpio_server_config_html(_page, _is_posted);
-		END_SENDING_CHUNK();
+		_page.end();
 
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 		if (_is_posted)
 		{
 			__gpio_service.handleGpioModes(GPIO_SERVER_CONFIG);
@@ -352,16 +335,13 @@ public:
 	/**
 	 * build gpio mode config html.
 	 *
-	 * @param	char*	_page
+	 * @param	PageWriter&	_page
 	 * @param	bool|false	_enable_flash
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 	 */
-	void build_gpio_mode_config_html(char *_page, bool _enable_flash = false, int _max_size = PAGE_HTML_MAX_SIZE)
+	void build_gpio_mode_config_html(PageWriter &_page, bool _enable_flash = false)
 	{
-		// memset(_page, 0, _max_size);
 		concat_header_html( _page );
-		strcat_ro(_page, WEB_SERVER_GPIO_CONFIG_PAGE_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_GPIO_CONFIG_PAGE_TOP);
 
 		const char *_gpio_mode_general_options[] = {"OFF", "DOUT", "DIN", "BLINK", "AOUT"};
 		const char *_gpio_mode_analog_options[] = {"OFF", "", "", "", "", "AIN"};
@@ -381,7 +361,6 @@ public:
 			if (!__i_dvc_ctrl.isExceptionalGpio(_pin))
 			{
 				concat_tr_select_html_tags(_page, _name, _label, _gpio_mode_general_options, _gpio_mode_general_options_size, (int)__gpio_service.m_gpio_config_copy.gpio_mode[_pin], _exception);
-				CONTINUE_SEND_IN_CHUNK(_page);
 			}
 		}
 
@@ -394,16 +373,14 @@ public:
 			if (!__i_dvc_ctrl.isExceptionalGpio(MAX_DIGITAL_GPIO_PINS + _pin))
 			{
 				concat_tr_select_html_tags(_page, _name, _label, _gpio_mode_analog_options, _gpio_mode_analog_options_size, (int)__gpio_service.m_gpio_config_copy.gpio_mode[MAX_DIGITAL_GPIO_PINS + _pin]);
-				CONTINUE_SEND_IN_CHUNK(_page);
 			}
 		}
 
 		concat_csrf_input_html_tag( _page );
-		strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
+		_page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 		if (_enable_flash)
 			concat_flash_message_div(_page, HTML_SUCCESS_FLASH, ALERT_SUCCESS);
-		strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_FOOTER_HTML);
 	}
 
 	/**
@@ -468,15 +445,14 @@ public:
 			_is_posted = true;
 		}
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		this->build_gpio_mode_config_html(_page, _is_posted);
-		END_SENDING_CHUNK();
+		_page.end();
 
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 		if (_is_posted)
 		{
 			__gpio_service.handleGpioModes(GPIO_MODE_CONFIG);
@@ -486,17 +462,14 @@ public:
 	/**
 	 * build gpio write config html.
 	 *
-	 * @param	char*	_page
+	 * @param	PageWriter&	_page
 	 * @param	bool|false	_enable_flash
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 	 */
-	void build_gpio_write_config_html(char *_page, bool _enable_flash = false, int _max_size = PAGE_HTML_MAX_SIZE)
+	void build_gpio_write_config_html(PageWriter &_page, bool _enable_flash = false)
 	{
 
-		// memset(_page, 0, _max_size);
 		concat_header_html( _page );
-		strcat_ro(_page, WEB_SERVER_GPIO_WRITE_PAGE_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_GPIO_WRITE_PAGE_TOP);
 
 		const char *_gpio_digital_write_options[] = {"LOW", "HIGH"};
 		int _gpio_digital_write_options_size = sizeof(_gpio_digital_write_options) / sizeof(_gpio_digital_write_options[0]);
@@ -534,23 +507,21 @@ public:
 						concat_tr_input_html_tags(_page, _name, _label, _input_value, 0, HTML_INPUT_RANGE_TAG_TYPE, false, false);
 					}
 				}
-				CONTINUE_SEND_IN_CHUNK(_page);
 			}
 		}
 
 		if (_added_options)
 		{
 			concat_csrf_input_html_tag( _page );
-			strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
+			_page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 		}
 		else
 		{
-			strcat_ro(_page, WEB_SERVER_GPIO_WRITE_EMPTY_MESSAGE);
+			_page.append_ro(WEB_SERVER_GPIO_WRITE_EMPTY_MESSAGE);
 		}
 		if (_enable_flash)
 			concat_flash_message_div(_page, HTML_SUCCESS_FLASH, ALERT_SUCCESS);
-		strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_FOOTER_HTML);
 	}
 
 	/**
@@ -597,15 +568,14 @@ public:
 			}
 		}
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		this->build_gpio_write_config_html(_page, _is_posted);
-		END_SENDING_CHUNK();
+		_page.end();
 
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 		if (_is_posted)
 		{
 			__gpio_service.handleGpioModes(GPIO_WRITE_CONFIG);
@@ -641,16 +611,13 @@ public:
 	/**
 	 * build gpio event config html.
 	 *
-	 * @param	char*	_page
+	 * @param	PageWriter&	_page
 	 * @param	bool|false	_enable_flash
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 	 */
-	void build_gpio_event_config_html(char *_page, bool _enable_flash = false, int _max_size = PAGE_HTML_MAX_SIZE)
+	void build_gpio_event_config_html(PageWriter &_page, bool _enable_flash = false)
 	{
-		// memset(_page, 0, _max_size);
 		concat_header_html( _page );
-		strcat_ro(_page, WEB_SERVER_GPIO_EVENT_PAGE_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_GPIO_EVENT_PAGE_TOP);
 
 		const char *_gpio_digital_event_options[] = {"LOW", "HIGH"};
 #ifdef ENABLE_EMAIL_SERVICE
@@ -690,11 +657,11 @@ public:
 						__appendUintToBuff(_event_label, "al%d", _evtidx, 7);
 
 						_added_options = true;
-						strcat_ro(_page, HTML_TR_OPEN_TAG);
-						strcat_ro(_page, HTML_TAG_CLOSE_BRACKET);
+						_page.append_ro(HTML_TR_OPEN_TAG);
+						_page.append_ro(HTML_TAG_CLOSE_BRACKET);
 						concat_td_select_html_tags(_page, _name, _label, _gpio_digital_event_options, _gpio_digital_event_options_size, (int)__gpio_service.m_gpio_config_copy.gpio_events[_evtidx].eventConditionValue);
 						concat_td_select_html_tags(_page, (char *)" ? ", _event_label, _gpio_event_channels, _gpio_event_channels_size, (int)__gpio_service.m_gpio_config_copy.gpio_events[_evtidx].eventChannel);
-						strcat_ro(_page, HTML_TR_CLOSE_TAG);
+						_page.append_ro(HTML_TR_CLOSE_TAG);
 					}
 				}else{
 
@@ -708,24 +675,23 @@ public:
 						_added_options = true;
 						memset(_analog_value, 0, 10);
 						__appendUintToBuff(_analog_value, "%d", __gpio_service.m_gpio_config_copy.gpio_events[_evtidx].eventConditionValue, 8);
-						strcat_ro(_page, HTML_TR_OPEN_TAG);
-						strcat_ro(_page, HTML_TAG_CLOSE_BRACKET);
-						strcat_ro(_page, HTML_TD_OPEN_TAG);
-						strcat_ro(_page, HTML_TAG_CLOSE_BRACKET);
-						strcat(_page, _name);
-						strcat_ro(_page, HTML_TD_CLOSE_TAG);
-						strcat_ro(_page, HTML_TD_OPEN_TAG);
-						strcat_ro(_page, HTML_STYLE_ATTR);
-						strcat_ro(_page, RODT_ATTR("'display:flex;'"));
-						strcat_ro(_page, HTML_TAG_CLOSE_BRACKET);
+						_page.append_ro(HTML_TR_OPEN_TAG);
+						_page.append_ro(HTML_TAG_CLOSE_BRACKET);
+						_page.append_ro(HTML_TD_OPEN_TAG);
+						_page.append_ro(HTML_TAG_CLOSE_BRACKET);
+						_page.append(_name);
+						_page.append_ro(HTML_TD_CLOSE_TAG);
+						_page.append_ro(HTML_TD_OPEN_TAG);
+						_page.append_ro(HTML_STYLE_ATTR);
+						_page.append_ro(RODT_ATTR("'display:flex;'"));
+						_page.append_ro(HTML_TAG_CLOSE_BRACKET);
 						concat_select_html_tag(_page, _label, _gpio_analog_event_comparators, _gpio_analog_event_comparators_size, (int)__gpio_service.m_gpio_config_copy.gpio_events[_evtidx].eventCondition);
 						concat_input_html_tag(_page, _event_value, _analog_value);
-						strcat_ro(_page, HTML_TD_CLOSE_TAG);
+						_page.append_ro(HTML_TD_CLOSE_TAG);
 						concat_td_select_html_tags(_page, (char *)" ? ", _event_label, _gpio_event_channels, _gpio_event_channels_size, (int)__gpio_service.m_gpio_config_copy.gpio_events[_evtidx].eventChannel);
-						strcat_ro(_page, HTML_TR_CLOSE_TAG);
+						_page.append_ro(HTML_TR_CLOSE_TAG);
 					}					
 				}
-				CONTINUE_SEND_IN_CHUNK(_page);
 			}
 		}
 
@@ -740,24 +706,23 @@ public:
 				}
 				const char **arr = constcharpvec.data();
 
-				strcat_ro(_page, HTML_LINE_BREAK_TAG);
-				strcat_ro(_page, HTML_TR_OPEN_TAG);
-				strcat_ro(_page, HTML_TAG_CLOSE_BRACKET);
+				_page.append_ro(HTML_LINE_BREAK_TAG);
+				_page.append_ro(HTML_TR_OPEN_TAG);
+				_page.append_ro(HTML_TAG_CLOSE_BRACKET);
 				concat_td_select_html_tags(_page, RODT_ATTR("Add Event For "), "ifsl", arr, constcharpvec.size(), -1);
-				strcat_ro(_page, HTML_TR_CLOSE_TAG);
+				_page.append_ro(HTML_TR_CLOSE_TAG);
 			}
 
 			concat_csrf_input_html_tag( _page );
-			strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
+			_page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 		}
 		else
 		{
-			strcat_ro(_page, WEB_SERVER_GPIO_EVENT_EMPTY_MESSAGE);
+			_page.append_ro(WEB_SERVER_GPIO_EVENT_EMPTY_MESSAGE);
 		}
 		if (_enable_flash)
 			concat_flash_message_div(_page, HTML_SUCCESS_FLASH, ALERT_SUCCESS);
-		strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_FOOTER_HTML);
 	}
 
 	/**
@@ -880,15 +845,14 @@ public:
 			}
 		}
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		this->build_gpio_event_config_html(_page, _is_posted);
-		END_SENDING_CHUNK();
+		_page.end();
 
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 		if (_is_posted)
 		{
 			__gpio_service.handleGpioModes(GPIO_EVENT_CONFIG);
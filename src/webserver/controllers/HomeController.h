@@ -53,34 +53,29 @@ public:
 	/**
 	 * build html page with header, middle and footer part.
 	 *
-	 * @param	char*	_page
+	 * @param	PageWriter&	_page
 	 * @param	const char *	_pgm_page
 	 * @param	bool|false	_enable_flash
 	 * @param	char*|""	_message
 	 * @param	FLASH_MSG_TYPE|ALERT_SUCCESS	_alert_type
 	 * @param	bool|true	_enable_header_footer
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 	 */
 	void build_html(
-		char *_page,
+		PageWriter &_page,
 		const char * _pgm_page,
 		bool _enable_flash = false,
 		char *_message = "",
 		FLASH_MSG_TYPE _alert_type = ALERT_SUCCESS,
-		bool _enable_header_footer = true,
-		int _max_size = PAGE_HTML_MAX_SIZE)
+		bool _enable_header_footer = true)
 	{
-		// memset(_page, 0, _max_size);
 
 		if (_enable_header_footer)
 			concat_header_html( _page );
-		strcat_ro(_page, _pgm_page);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(_pgm_page);
 		if (_enable_flash)
 			concat_flash_message_div(_page, _message, _alert_type);
 		if (_enable_header_footer)
-			strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+			_page.append_ro(WEB_SERVER_FOOTER_HTML);
 	}
 
 	/**
@@ -104,15 +99,14 @@ public:
 		}
 	  }
 
-	  char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-	  if (nullptr == _page) return;
+	  PageWriter _page(this->m_web_resource->m_server);
+	  if (!_page.ok()) return;
 
-	  BEGIN_SEND_IN_CHUNK(HTTP_RESP_NOT_FOUND, MIME_TYPE_TEXT_HTML, _page);
+	  _page.begin(HTTP_RESP_NOT_FOUND, MIME_TYPE_TEXT_HTML);
 	  this->build_html(_page, WEB_SERVER_404_PAGE);
-	  END_SENDING_CHUNK();
+	  _page.end();
 
 	//   this->m_web_resource->m_server->send(HTTP_RESP_NOT_FOUND, MIME_TYPE_TEXT_HTML, _page);
-	  pdiutil::safe_delete_array(_page);
 	}
 
 	/**
@@ -129,23 +123,22 @@ public:
 			return;
 		}
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 		
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		concat_header_html( _page );
 
 		if (this->m_route_handler->has_active_session())
 		{
 
-			strcat_ro(_page, WEB_SERVER_MENU_CARD_PAGE_WRAP_TOP);
+			_page.append_ro(WEB_SERVER_MENU_CARD_PAGE_WRAP_TOP);
 
 			concat_svg_menu_card(_page, WEB_SERVER_HOME_MENU_TITLE_LOGIN, SVG_ICON48_PATH_ACCOUNT_CIRCLE, WEB_SERVER_LOGIN_CONFIG_ROUTE);
 			concat_svg_menu_card(_page, WEB_SERVER_HOME_MENU_TITLE_WIFI, SVG_ICON48_PATH_WIFI, WEB_SERVER_WIFI_CONFIG_ROUTE);
 #ifdef ENABLE_OTA_SERVICE
 			concat_svg_menu_card(_page, WEB_SERVER_HOME_MENU_TITLE_OTA, SVG_ICON48_PATH_CLOUD_DOWNLOAD, WEB_SERVER_OTA_CONFIG_ROUTE);
 #endif
-			CONTINUE_SEND_IN_CHUNK(_page);
 #ifdef ENABLE_MQTT_SERVICE
 			concat_svg_menu_card(_page, WEB_SERVER_HOME_MENU_TITLE_MQTT, SVG_ICON48_PATH_SEND, WEB_SERVER_MQTT_MANAGE_CONFIG_ROUTE);
 #endif
@@ -155,32 +148,27 @@ public:
 #ifdef ENABLE_EMAIL_SERVICE
 			concat_svg_menu_card(_page, WEB_SERVER_HOME_MENU_TITLE_EMAIL, SVG_ICON48_PATH_MAIL, WEB_SERVER_EMAIL_CONFIG_ROUTE);
 #endif
-			CONTINUE_SEND_IN_CHUNK(_page);
 #ifdef ENABLE_STORAGE_SERVICE
 			concat_svg_menu_card(_page, WEB_SERVER_HOME_MENU_TITLE_STORAGE, SVG_ICON48_PATH_COMPUTER, WEB_SERVER_STORAGE_LIST_ROUTE);
 #endif
 #ifdef ENABLE_DEVICE_IOT
 			concat_svg_menu_card(_page, WEB_SERVER_HOME_MENU_TITLE_DEVICE_REGISTER, SVG_ICON48_PATH_BEENHERE, WEB_SERVER_DEVICE_REGISTER_CONFIG_ROUTE);
 #endif
-			CONTINUE_SEND_IN_CHUNK(_page);
 			concat_svg_menu_card(_page, WEB_SERVER_HOME_MENU_TITLE_DASHBOARD, SVG_ICON48_PATH_DASHBOARD, WEB_SERVER_DASHBOARD_ROUTE);
 			concat_svg_menu_card(_page, WEB_SERVER_HOME_MENU_TITLE_LOGOUT, SVG_ICON48_PATH_POWER, WEB_SERVER_LOGOUT_ROUTE);
-			CONTINUE_SEND_IN_CHUNK(_page);
 
-			strcat_ro(_page, WEB_SERVER_MENU_CARD_PAGE_WRAP_BOTTOM);
+			_page.append_ro(WEB_SERVER_MENU_CARD_PAGE_WRAP_BOTTOM);
 		}
 		else
 		{
-			strcat_ro(_page, WEB_SERVER_HOME_PAGE);
+			_page.append_ro(WEB_SERVER_HOME_PAGE);
 		}
 
-		strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
+		_page.append_ro(WEB_SERVER_FOOTER_HTML);
 
-		CONTINUE_SEND_IN_CHUNK(_page);
-		END_SENDING_CHUNK();
+		_page.end();
 
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 	}
 };
 
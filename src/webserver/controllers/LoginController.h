@@ -55,51 +55,43 @@ class LoginController : public Controller {
 		/**
 		 * build html page with header, middle and footer part.
 		 *
-		 * @param	char*	_page
+		 * @param	PageWriter&	_page
 		 * @param	const char *	_pgm_page
 		 * @param	bool|false	_enable_flash
 		 * @param	char*|""	_message
 		 * @param	FLASH_MSG_TYPE|ALERT_SUCCESS	_alert_type
 		 * @param	bool|true	_enable_header_footer
-		 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 		 */
 		void build_html(
-      char* _page,
+      PageWriter &_page,
       const char * _pgm_page,
       bool _enable_flash=false,
       char* _message="",
       FLASH_MSG_TYPE _alert_type=ALERT_SUCCESS ,
-      bool _enable_header_footer=true,
-      int _max_size=PAGE_HTML_MAX_SIZE
+      bool _enable_header_footer=true
     ){
 
-      // memset( _page, 0, _max_size );
-
       if( _enable_header_footer ) concat_header_html( _page );
-      CONTINUE_SEND_IN_CHUNK(_page);
-      strcat_ro( _page, _pgm_page );
+      _page.append_ro( _pgm_page );
       if( _enable_flash )
       concat_flash_message_div( _page, _message, _alert_type );
-      if( _enable_header_footer ) strcat_ro( _page, WEB_SERVER_FOOTER_HTML );
-      CONTINUE_SEND_IN_CHUNK(_page);
+      if( _enable_header_footer ) _page.append_ro( WEB_SERVER_FOOTER_HTML );
     }
 
 		/**
 		 * build change password html. never renders an existing password.
 		 *
-		 * @param	char*	_page
+		 * @param	PageWriter&	_page
 		 * @param	bool|false	_is_error
 		 * @param	bool|false	_enable_flash
 		 * @param	const char*	_message
-		 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 		 */
-		void build_login_config_html( char* _page, bool _is_error=false, bool _enable_flash=false, const char* _message=nullptr, const char* _username=nullptr, int _max_size=PAGE_HTML_MAX_SIZE ){
+		void build_login_config_html( PageWriter &_page, bool _is_error=false, bool _enable_flash=false, const char* _message=nullptr, const char* _username=nullptr ){
 
       char _empty[1] = {0};
 
       concat_header_html( _page );
-      strcat_ro( _page, WEB_SERVER_LOGIN_CONFIG_PAGE_TOP );
-      CONTINUE_SEND_IN_CHUNK(_page);
+      _page.append_ro( WEB_SERVER_LOGIN_CONFIG_PAGE_TOP );
 
       concat_tr_input_html_tags( _page, RODT_ATTR("User:"), RODT_ATTR("usrnm"), (char*)( nullptr != _username ? _username : __auth_service.getUsername() ), LOGIN_CONFIGS_BUF_SIZE-1, (char*)"text", false, true );
       concat_tr_input_html_tags( _page, RODT_ATTR("Current Password:"), RODT_ATTR("cpswd"), _empty, LOGIN_CONFIGS_BUF_SIZE-1, (char*)"password" );
@@ -107,11 +99,10 @@ class LoginController : public Controller {
       concat_tr_input_html_tags( _page, RODT_ATTR("Confirm Password:"), RODT_ATTR("rpswd"), _empty, LOGIN_CONFIGS_BUF_SIZE-1, (char*)"password" );
       concat_csrf_input_html_tag( _page );
 
-      strcat_ro( _page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM );
+      _page.append_ro( WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM );
       if( _enable_flash )
       concat_flash_message_div( _page, _is_error ? (char*)_message : HTML_SUCCESS_FLASH, _is_error ? ALERT_DANGER:ALERT_SUCCESS );
-      strcat_ro( _page, WEB_SERVER_FOOTER_HTML );
-      CONTINUE_SEND_IN_CHUNK(_page);
+      _page.append_ro( WEB_SERVER_FOOTER_HTML );
     }
 
 		/**
@@ -167,19 +158,18 @@ class LoginController : public Controller {
         }
       }
 
-      char* _page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-      if (nullptr == _page) return;
+      PageWriter _page(this->m_web_resource->m_server);
+      if (!_page.ok()) return;
 
       if( _is_changed ){
         __web_session_manager.destroyByUsername( _username.c_str() );
         this->m_route_handler->send_inactive_session_headers();
       }
 
-      BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+      _page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
       this->build_login_config_html( _page, _is_error, _is_posted, _message.c_str(), _username.c_str() );
-      END_SENDING_CHUNK();
+      _page.end();
 
-      pdiutil::safe_delete_array(_page);
     }
 
 		/**
@@ -198,15 +188,14 @@ class LoginController : public Controller {
       this->m_route_handler->has_active_session();
       this->m_route_handler->send_inactive_session_headers();
 
-      char* _page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-      if (nullptr == _page) return;
+      PageWriter _page(this->m_web_resource->m_server);
+      if (!_page.ok()) return;
 
-      BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+      _page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
       this->build_html( _page, WEB_SERVER_LOGOUT_PAGE );
-      END_SENDING_CHUNK();
+      _page.end();
 
       // this->m_web_resource->m_server->send( HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page );
-      pdiutil::safe_delete_array(_page);
     }
 
 		/**
@@ -330,15 +319,14 @@ class LoginController : public Controller {
         }
       }
 
-      char* _page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-      if (nullptr == _page) return;
+      PageWriter _page(this->m_web_resource->m_server);
+      if (!_page.ok()) return;
 
-      BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+      _page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
       this->build_html( _page, WEB_SERVER_LOGIN_PAGE, _is_posted, (char*)_message.c_str(), ALERT_DANGER );
-      END_SENDING_CHUNK();
+      _page.end();
 
       // this->m_web_resource->m_server->send( HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page );
-      pdiutil::safe_delete_array(_page);
     }
 
 };
@@ -76,35 +76,31 @@ public:
       return;
     }
 
-    char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-    if (nullptr == _page) return;
+    PageWriter _page(this->m_web_resource->m_server);
+    if (!_page.ok()) return;
 
-    BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+    _page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
     concat_header_html( _page );
-    strcat_ro(_page, WEB_SERVER_MENU_CARD_PAGE_WRAP_TOP);
+    _page.append_ro(WEB_SERVER_MENU_CARD_PAGE_WRAP_TOP);
 
     concat_svg_menu_card(_page, WEB_SERVER_MQTT_MENU_TITLE_GENERAL, SVG_ICON48_PATH_SETTINGS, WEB_SERVER_MQTT_GENERAL_CONFIG_ROUTE);
     concat_svg_menu_card(_page, WEB_SERVER_MQTT_MENU_TITLE_LWT, SVG_ICON48_PATH_BEENHERE, WEB_SERVER_MQTT_LWT_CONFIG_ROUTE);
     concat_svg_menu_card(_page, WEB_SERVER_MQTT_MENU_TITLE_PUBSUB, SVG_ICON48_PATH_IMPORT_EXPORT, WEB_SERVER_MQTT_PUBSUB_CONFIG_ROUTE);
-    CONTINUE_SEND_IN_CHUNK(_page);
 
-    strcat_ro(_page, WEB_SERVER_MENU_CARD_PAGE_WRAP_BOTTOM);
-    strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_MENU_CARD_PAGE_WRAP_BOTTOM);
+    _page.append_ro(WEB_SERVER_FOOTER_HTML);
 
-    END_SENDING_CHUNK();
+    _page.end();
     // this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-    pdiutil::safe_delete_array(_page);
   }
 
   /**
    * build mqtt general config html.
    *
-   * @param	char*	_page
+   * @param	PageWriter&	_page
    * @param	bool|false	_enable_flash
-   * @param	int|PAGE_HTML_MAX_SIZE	_max_size
    */
-  void build_mqtt_general_config_html(char *_page, bool _enable_flash = false, int _max_size = PAGE_HTML_MAX_SIZE)
+  void build_mqtt_general_config_html(PageWriter &_page, bool _enable_flash = false)
   {
     if (nullptr == this->m_web_resource ||
         nullptr == this->m_web_resource->m_db_conn)
@@ -112,10 +108,8 @@ public:
       return;
     }
 
-    // memset(_page, 0, _max_size);
     concat_header_html( _page );
-    strcat_ro(_page, WEB_SERVER_MQTT_GENERAL_PAGE_TOP);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_MQTT_GENERAL_PAGE_TOP);
 
     mqtt_general_config_table _mqtt_general_configs;
     this->m_web_resource->m_db_conn->get_mqtt_general_config_table(&_mqtt_general_configs);
@@ -132,31 +126,26 @@ public:
     concat_tr_input_html_tags(_page, RODT_ATTR("Host Port:"), RODT_ATTR("prt"), _port);
     concat_tr_input_html_tags(_page, RODT_ATTR("Client Id:"), RODT_ATTR("clid"), _mqtt_general_configs.client_id, MQTT_CLIENT_ID_BUF_SIZE - 1);
     concat_tr_input_html_tags(_page, RODT_ATTR("Username:"), RODT_ATTR("usrn"), _mqtt_general_configs.username, MQTT_USERNAME_BUF_SIZE - 1);
-    CONTINUE_SEND_IN_CHUNK(_page);
     concat_tr_input_html_tags(_page, RODT_ATTR("Password:"), RODT_ATTR("pswd"), _mqtt_general_configs.password, MQTT_PASSWORD_BUF_SIZE - 1);
     concat_tr_input_html_tags(_page, RODT_ATTR("Keep Alive:"), RODT_ATTR("kpalv"), _keepalive);
     concat_tr_input_html_tags(_page, RODT_ATTR("Clean Session:"), RODT_ATTR("cln"), "clean", HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_CHECKBOX_TAG_TYPE, _mqtt_general_configs.clean_session != 0);
 
     concat_csrf_input_html_tag( _page );
-    strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 #else
 
     concat_tr_input_html_tags(_page, RODT_ATTR("Host Address:"), RODT_ATTR("hst"), _mqtt_general_configs.host, MQTT_HOST_BUF_SIZE - 1, HTML_INPUT_TEXT_TAG_TYPE, false, true);
     concat_tr_input_html_tags(_page, RODT_ATTR("Host Port:"), RODT_ATTR("prt"), _port, HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_TEXT_TAG_TYPE, false, true);
     concat_tr_input_html_tags(_page, RODT_ATTR("Client Id:"), RODT_ATTR("clid"), _mqtt_general_configs.client_id, MQTT_CLIENT_ID_BUF_SIZE - 1, HTML_INPUT_TEXT_TAG_TYPE, false, true);
     concat_tr_input_html_tags(_page, RODT_ATTR("Username:"), RODT_ATTR("usrn"), _mqtt_general_configs.username, MQTT_USERNAME_BUF_SIZE - 1, HTML_INPUT_TEXT_TAG_TYPE, false, true);
-    CONTINUE_SEND_IN_CHUNK(_page);
     concat_tr_input_html_tags(_page, RODT_ATTR("Password:"), RODT_ATTR("pswd"), _mqtt_general_configs.password, MQTT_PASSWORD_BUF_SIZE - 1, HTML_INPUT_TEXT_TAG_TYPE, false, true);
     concat_tr_input_html_tags(_page, RODT_ATTR("Keep Alive:"), RODT_ATTR("kpalv"), _keepalive, HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_TEXT_TAG_TYPE, false, true);
     concat_tr_input_html_tags(_page, RODT_ATTR("Clean Session:"), RODT_ATTR("cln"), "clean", HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_CHECKBOX_TAG_TYPE, _mqtt_general_configs.clean_session != 0, true);
-    CONTINUE_SEND_IN_CHUNK(_page);
 #endif
 
     if (_enable_flash)
       concat_flash_message_div(_page, HTML_SUCCESS_FLASH, ALERT_SUCCESS);
-    strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_FOOTER_HTML);
   }
 
   /**
@@ -222,15 +211,14 @@ public:
     }
 #endif
 
-    char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-    if (nullptr == _page) return;
+    PageWriter _page(this->m_web_resource->m_server);
+    if (!_page.ok()) return;
 
-    BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+    _page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
     this->build_mqtt_general_config_html(_page, _is_posted);
-    END_SENDING_CHUNK();
+    _page.end();
 
     // this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-    pdiutil::safe_delete_array(_page);
     if (_is_posted)
     {
       __mqtt_service.handleMqttConfigChange(MQTT_GENERAL_CONFIG);
@@ -240,11 +228,10 @@ public:
   /**
    * build mqtt lwt config html.
    *
-   * @param	char*	_page
+   * @param	PageWriter&	_page
    * @param	bool|false	_enable_flash
-   * @param	int|PAGE_HTML_MAX_SIZE	_max_size
    */
-  void build_mqtt_lwt_config_html(char *_page, bool _enable_flash = false, int _max_size = PAGE_HTML_MAX_SIZE)
+  void build_mqtt_lwt_config_html(PageWriter &_page, bool _enable_flash = false)
   {
 
     if (nullptr == this->m_web_resource ||
@@ -253,11 +240,9 @@ public:
       return;
     }
 
-    // memset(_page, 0, _max_size);
     char _ip_address[20];
     concat_header_html( _page );
-    strcat_ro(_page, WEB_SERVER_MQTT_LWT_PAGE_TOP);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_MQTT_LWT_PAGE_TOP);
 
     mqtt_lwt_config_table _mqtt_lwt_configs;
     this->m_web_resource->m_db_conn->get_mqtt_lwt_config_table(&_mqtt_lwt_configs);
@@ -272,21 +257,18 @@ public:
     concat_tr_input_html_tags(_page, RODT_ATTR("Will Retain:"), RODT_ATTR("wrtn"), "retain", HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_CHECKBOX_TAG_TYPE, _mqtt_lwt_configs.will_retain != 0);
 
     concat_csrf_input_html_tag( _page );
-    strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 #else
 
     concat_tr_input_html_tags(_page, RODT_ATTR("Will Topic:"), RODT_ATTR("wtpc"), _mqtt_lwt_configs.will_topic, MQTT_TOPIC_BUF_SIZE - 1, HTML_INPUT_TEXT_TAG_TYPE, false, true);
     concat_tr_input_html_tags(_page, RODT_ATTR("Will Message:"), RODT_ATTR("wmsg"), _mqtt_lwt_configs.will_message, MQTT_TOPIC_BUF_SIZE - 1, HTML_INPUT_TEXT_TAG_TYPE, false, true);
     concat_tr_select_html_tags(_page, RODT_ATTR("Will QoS:"), RODT_ATTR("wqos"), _qos_options, 3, _mqtt_lwt_configs.will_qos, 0, true);
     concat_tr_input_html_tags(_page, RODT_ATTR("Will Retain:"), RODT_ATTR("wrtn"), "retain", HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_CHECKBOX_TAG_TYPE, _mqtt_lwt_configs.will_retain != 0, true);
-    CONTINUE_SEND_IN_CHUNK(_page);
 #endif
 
     if (_enable_flash)
       concat_flash_message_div(_page, HTML_SUCCESS_FLASH, ALERT_SUCCESS);
-    strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_FOOTER_HTML);
   }
 
   /**
@@ -339,15 +321,14 @@ public:
     }
 #endif
 
-    char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-    if (nullptr == _page) return;
+    PageWriter _page(this->m_web_resource->m_server);
+    if (!_page.ok()) return;
 
-    BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+    _page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
     this->build_mqtt_lwt_config_html(_page, _is_posted);
-    END_SENDING_CHUNK();
+    _page.end();
 
     // this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-    pdiutil::safe_delete_array(_page);
     if (_is_posted)
     {
       __mqtt_service.handleMqttConfigChange(MQTT_LWT_CONFIG);
@@ -357,11 +338,10 @@ public:
   /**
    * build mqtt publish subscribe config html.
    *
-   * @param	char*	_page
+   * @param	PageWriter&	_page
    * @param	bool|false	_enable_flash
-   * @param	int|PAGE_HTML_MAX_SIZE	_max_size
    */
-  void build_mqtt_pubsub_config_html(char *_page, bool _enable_flash = false, int _max_size = PAGE_HTML_MAX_SIZE)
+  void build_mqtt_pubsub_config_html(PageWriter &_page, bool _enable_flash = false)
   {
 
     if (nullptr == this->m_web_resource ||
@@ -370,11 +350,9 @@ public:
       return;
     }
 
-    // memset(_page, 0, _max_size);
     char _ip_address[20];
     concat_header_html( _page );
-    strcat_ro(_page, WEB_SERVER_MQTT_PUBSUB_PAGE_TOP);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_MQTT_PUBSUB_PAGE_TOP);
 
     mqtt_pubsub_config_table _mqtt_pubsub_configs;
     this->m_web_resource->m_db_conn->get_mqtt_pubsub_config_table(&_mqtt_pubsub_configs);
@@ -423,7 +401,6 @@ public:
       concat_tr_input_html_tags(_page, _retain_label, _retain_name, "retain", HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_CHECKBOX_TAG_TYPE, _mqtt_pubsub_configs.publish_topics[i].retain != 0, true);
 
 #endif
-      CONTINUE_SEND_IN_CHUNK(_page);
     }
 #ifdef ALLOW_MQTT_CONFIG_MODIFICATION
 
@@ -457,18 +434,16 @@ public:
       concat_tr_select_html_tags(_page, _qos_label, _qos_name, _qos_options, 3, _mqtt_pubsub_configs.subscribe_topics[i].qos, 0, true);
 
 #endif
-      CONTINUE_SEND_IN_CHUNK(_page);
     }
 
 #ifdef ALLOW_MQTT_CONFIG_MODIFICATION
     concat_csrf_input_html_tag( _page );
-    strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
+    _page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 #endif
 
     if (_enable_flash)
       concat_flash_message_div(_page, HTML_SUCCESS_FLASH, ALERT_SUCCESS);
-    strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_FOOTER_HTML);
   }
 
   /**
@@ -558,15 +533,14 @@ public:
     }
 #endif
 
-    char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-    if (nullptr == _page) return;
+    PageWriter _page(this->m_web_resource->m_server);
+    if (!_page.ok()) return;
 
-    BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+    _page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
     this->build_mqtt_pubsub_config_html(_page, _is_posted);
-    END_SENDING_CHUNK();
+    _page.end();
 
     // this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-    pdiutil::safe_delete_array(_page);
     if (_is_posted)
     {
       __mqtt_service.handleMqttConfigChange(MQTT_PUBSUB_CONFIG);
@@ -55,11 +55,10 @@ public:
 	/**
 	 * build ota server config html.
 	 *
-	 * @param	char*	_page
+	 * @param	PageWriter&	_page
 	 * @param	bool|false	_enable_flash
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 	 */
-	void build_ota_server_config_html(char *_page, bool _enable_flash = false, const char *_message = nullptr, FLASH_MSG_TYPE _alert_type = ALERT_SUCCESS, int _max_size = PAGE_HTML_MAX_SIZE)
+	void build_ota_server_config_html(PageWriter &_page, bool _enable_flash = false, const char *_message = nullptr, FLASH_MSG_TYPE _alert_type = ALERT_SUCCESS)
 	{
 		if (nullptr == this->m_web_resource ||
 			nullptr == this->m_web_resource->m_db_conn)
@@ -67,10 +66,8 @@ public:
 			return;
 		}
 
-		// memset(_page, 0, _max_size);
 		concat_header_html( _page );
-		strcat_ro(_page, WEB_SERVER_OTA_CONFIG_PAGE_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_OTA_CONFIG_PAGE_TOP);
 
 		ota_config_table _ota_configs;
 		this->m_web_resource->m_db_conn->get_ota_config_table(&_ota_configs);
@@ -85,14 +82,14 @@ public:
 		concat_tr_input_html_tags(_page, RODT_ATTR("OTA Port:"), RODT_ATTR("prt"), _port);
 
 		concat_csrf_input_html_tag( _page );
-		strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
+		_page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 #else
 
 		concat_tr_input_html_tags(_page, RODT_ATTR("OTA Host:"), RODT_ATTR("hst"), _ota_configs.ota_host, OTA_HOST_BUF_SIZE - 1, HTML_INPUT_TEXT_TAG_TYPE, false, true);
 		concat_tr_input_html_tags(_page, RODT_ATTR("OTA Port:"), RODT_ATTR("prt"), _port, HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_TEXT_TAG_TYPE, false, true);
 
-		strcat_ro(_page, HTML_TABLE_CLOSE_TAG);
-		strcat_ro(_page, HTML_FORM_CLOSE_TAG);
+		_page.append_ro(HTML_TABLE_CLOSE_TAG);
+		_page.append_ro(HTML_FORM_CLOSE_TAG);
 #endif
 
 #ifdef ENABLE_STORAGE_SERVICE
@@ -101,20 +98,18 @@ public:
 
 		if (_enable_flash)
 			concat_flash_message_div(_page, nullptr != _message ? (char *)_message : HTML_SUCCESS_FLASH, _alert_type);
-		strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_FOOTER_HTML);
 	}
 
 #ifdef ENABLE_STORAGE_SERVICE
 	/**
 	 * build the local image flashing form listing images found on storage.
 	 *
-	 * @param	char*	_page
+	 * @param	PageWriter&	_page
 	 */
-	void build_local_flash_html(char *_page)
+	void build_local_flash_html(PageWriter &_page)
 	{
-		strcat_ro(_page, WEB_SERVER_OTA_LOCAL_FLASH_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_OTA_LOCAL_FLASH_TOP);
 
 		pdiutil::vector<pdiutil::string> _images;
 		__ota_service.collectLocalImages(__i_fs.getHomeDirectory(), _images);
@@ -135,14 +130,13 @@ public:
 			}
 
 			concat_csrf_input_html_tag(_page);
-			strcat_ro(_page, WEB_SERVER_OTA_LOCAL_FLASH_BOTTOM);
+			_page.append_ro(WEB_SERVER_OTA_LOCAL_FLASH_BOTTOM);
 		}
 		else
 		{
-			strcat_ro(_page, WEB_SERVER_OTA_NO_LOCAL_IMAGE);
+			_page.append_ro(WEB_SERVER_OTA_NO_LOCAL_IMAGE);
 		}
 
-		CONTINUE_SEND_IN_CHUNK(_page);
 	}
 #endif
 
@@ -214,16 +208,15 @@ public:
 		}
 #endif
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		this->build_ota_server_config_html(_page, _is_posted, _message.empty() ? nullptr : _message.c_str(),
 										   _is_error ? ALERT_DANGER : ALERT_SUCCESS);
-		END_SENDING_CHUNK();
+		_page.end();
 
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 
 #ifdef ENABLE_STORAGE_SERVICE
 		if (_is_flashed)
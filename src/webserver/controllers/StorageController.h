@@ -77,13 +77,12 @@ public:
 	/**
 	 * build storage html.
 	 *
-	 * @param	char*	_page
+	 * @param	PageWriter&	_page
 	 * @param	bool|false	_enable_flash
 	 * @param	const char*|nullptr	_message
 	 * @param	FLASH_MSG_TYPE|ALERT_SUCCESS	_alert_type
-	 * @param	int|PAGE_HTML_MAX_SIZE	_max_size
 	 */
-	void build_storage_html(char *_page, bool _enable_flash = false, const char *_message = nullptr, FLASH_MSG_TYPE _alert_type = ALERT_SUCCESS, int _max_size = PAGE_HTML_MAX_SIZE)
+	void build_storage_html(PageWriter &_page, bool _enable_flash = false, const char *_message = nullptr, FLASH_MSG_TYPE _alert_type = ALERT_SUCCESS)
 	{
 		if (nullptr == this->m_web_resource ||
 			nullptr == this->m_web_resource->m_server ||
@@ -92,10 +91,8 @@ public:
 			return;
 		}
 
-		// memset(_page, 0, _max_size);
 		concat_header_html( _page, true );
-		strcat_ro(_page, WEB_SERVER_STORAGE_LIST_PAGE_TOP);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_STORAGE_LIST_PAGE_TOP);
 
 		// Prepare the path to fetch
 		pdiutil::string currentpath = __i_fs.getHomeDirectory();
@@ -113,11 +110,10 @@ public:
 		// if(!(resultCode < 0)){
 		if(true){
 
-			strcat_ro(_page, HTML_TABLE_OPEN_TAG);
+			_page.append_ro(HTML_TABLE_OPEN_TAG);
 			concat_id_attribute(_page, RODT_ATTR("strg-tbl"));
 			concat_style_attribute(_page, RODT_ATTR("width:100%;margin-bottom:10px;"));
-			strcat_ro(_page, HTML_TAG_CLOSE_BRACKET);
-			CONTINUE_SEND_IN_CHUNK(_page);
+			_page.append_ro(HTML_TAG_CLOSE_BRACKET);
 
 			// char *_storage_table_heading[] = {"", "Name", "Size"};
 			// concat_table_heading_row(_page, _storage_table_heading, 3, nullptr, nullptr, nullptr, RODT_ATTR("text-align:left"));
@@ -129,7 +125,6 @@ public:
 			char *_storage_path_row[] = {(char*)currentpath.c_str(), (char*)stat.c_str()};
 			const char *_storage_path_row_colspan[] = {RODT_ATTR("4"), RODT_ATTR("3' class='num")};
 			concat_table_data_row(_page, _storage_path_row, 2, RODT_ATTR("pth"), nullptr, nullptr, nullptr, _storage_path_row_colspan);
-			CONTINUE_SEND_IN_CHUNK(_page);
 
 			// Add empty row
 			char *_storage_empty_row[] = {"&nbsp;"};
@@ -140,7 +135,6 @@ public:
 			pdiutil::string loaderdiv = CHARPTR_WRAP("<div id='ldr' class='ldr'></div>");
 			char *_storage_loader_row[] = {(char*)loaderdiv.c_str()};
 			concat_table_data_row(_page, _storage_loader_row, 1, nullptr, nullptr, nullptr, nullptr, _storage_empty_row_colspan);
-			CONTINUE_SEND_IN_CHUNK(_page);
 
 			// // Prepare temporary buffers
 			// uint32_t filenamenavlen = strlen(WEB_SERVER_STORAGE_LIST_ROUTE) + strlen(CURRENT_PATH_ATTRIBUTE) + currentpath.length() + 2*FILE_NAME_MAX_SIZE + 100;
@@ -198,26 +192,20 @@ public:
 			// delete[] filenamenav;
 			// itemlist.clear();
 			
-			strcat_ro(_page, HTML_TABLE_CLOSE_TAG);
+			_page.append_ro(HTML_TABLE_CLOSE_TAG);
 		}
 
-		strcat_ro(_page, WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_SCRIPT1);
-		CONTINUE_SEND_IN_CHUNK(_page);
-		strcat_ro(_page, WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_FORMS1);
+		_page.append_ro(WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_SCRIPT1);
+		_page.append_ro(WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_FORMS1);
 		concat_csrf_input_html_tag(_page);
-		CONTINUE_SEND_IN_CHUNK(_page);
-		strcat_ro(_page, WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_FORMS2);
+		_page.append_ro(WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_FORMS2);
 		concat_csrf_input_html_tag(_page);
-		CONTINUE_SEND_IN_CHUNK(_page);
-		strcat_ro(_page, WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_FORMS3);
-		CONTINUE_SEND_IN_CHUNK(_page);
-		strcat_ro(_page, WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_SCRIPT2);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_FORMS3);
+		_page.append_ro(WEB_SERVER_STORAGE_LIST_PAGE_BOTTOM_SCRIPT2);
 
 		if (_enable_flash)
 			concat_flash_message_div(_page, nullptr != _message ? (char *)_message : HTML_SUCCESS_FLASH, _alert_type);
-		strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-		CONTINUE_SEND_IN_CHUNK(_page);
+		_page.append_ro(WEB_SERVER_FOOTER_HTML);
 	}
 
 	/**
@@ -243,15 +231,14 @@ public:
 			_message = (_err == CHARPTR_WRAP("perm")) ? CHARPTR_WRAP("Permission denied.") : CHARPTR_WRAP("Operation failed.");
 		}
 
-		char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-		if (nullptr == _page) return;
+		PageWriter _page(this->m_web_resource->m_server);
+		if (!_page.ok()) return;
 
-		BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+		_page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
 		this->build_storage_html(_page, _is_error, _is_error ? _message.c_str() : nullptr, ALERT_DANGER);
-		END_SENDING_CHUNK();
+		_page.end();
 
 		// this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-		pdiutil::safe_delete_array(_page);
 	}
 
 	/**
@@ -391,57 +378,38 @@ public:
 		pdiutil::vector<file_info_t> itemlist;
 		int resultCode = __i_fs.getDirFileList(currentpath.c_str(), itemlist);
 
-		// Prepare temporary buffers
-		uint32_t tempbufferlen = pdistd::max(strlen(SVG_ICON48_1616_PATH_TRASH), pdistd::max(strlen(SVG_ICON48_1416_PATH_FOLDER), strlen(SVG_ICON48_1216_PATH_FILE))) + 100;
-		char *tempbuffer = pdiutil::safe_new_array<char>(tempbufferlen);
-		if (nullptr == tempbuffer) {
-			for (file_info_t &item : itemlist) {
-				pdiutil::safe_delete_array(item.m_name);
-			}
-			itemlist.clear();
-			return;
-		}
-
 		pdiutil::string jsonresp = "{";
+		PageWriter _svg(jsonresp);
 		jsonresp += CHARPTR_WRAP("\"dsvg\":\"");
 
 		// Build folder svg element 
-		memset(tempbuffer, 0, tempbufferlen);
 		concat_svg_tag(
-			tempbuffer, 
+			_svg, 
 			SVG_ICON48_1416_PATH_FOLDER,
 			RODT_ATTR("margin-left:0;"),
 			RODT_ATTR("0 0 14 16"),
 			24,24
 		);
-
-		jsonresp += tempbuffer;
 		jsonresp += CHARPTR_WRAP("\",\"fsvg\":\"");
 
 		// Build file svg element 
-		memset(tempbuffer, 0, tempbufferlen);
 		concat_svg_tag(
-			tempbuffer, 
+			_svg, 
 			SVG_ICON48_1216_PATH_FILE,
 			RODT_ATTR("margin-left:0;"),
 			RODT_ATTR("0 0 12 16"),
 			24,24
 		);
-
-		jsonresp += tempbuffer;
 		jsonresp += CHARPTR_WRAP("\",\"tsvg\":\"");
 
 		// Build trash svg element 
-		memset(tempbuffer, 0, tempbufferlen);
 		concat_svg_tag(
-			tempbuffer, 
+			_svg, 
 			SVG_ICON48_1616_PATH_TRASH,
 			nullptr,
 			nullptr,
 			16,16, "#797979"
 		);
-
-		jsonresp += tempbuffer;
 		jsonresp += CHARPTR_WRAP("\",\"csrf\":\"");
 		jsonresp += get_csrf_token();
 		jsonresp += CHARPTR_WRAP("\",\"lst\":[");
@@ -456,14 +424,7 @@ public:
 					continue;
 				}
 
-				// Build link element
-				memset(tempbuffer, 0, tempbufferlen);
 				pdiutil::string _path = currentpath + item.m_name;
-				if( __i_fs.isDirectory(_path.c_str()) ){
-					strcat(tempbuffer, WEB_SERVER_STORAGE_LIST_ROUTE);
-					strcat(tempbuffer, CURRENT_PATH_ATTRIBUTE);
-				}
-				strncat(tempbuffer, _path.c_str(), _path.length());
 
 				char permbuf[11];
 				FilePermsToString(item.m_perms, item.m_type == FILE_TYPE_DIR, permbuf);
@@ -485,7 +446,11 @@ public:
 				jsonresp += group;
 #endif
 				jsonresp += CHARPTR_WRAP("\",\"l\":\"");
-				jsonresp += tempbuffer;
+				if( __i_fs.isDirectory(_path.c_str()) ){
+					jsonresp += WEB_SERVER_STORAGE_LIST_ROUTE;
+					jsonresp += CURRENT_PATH_ATTRIBUTE;
+				}
+				jsonresp += _path;
 				jsonresp += CHARPTR_WRAP("\"},");
 
 				// deallocates memory for items
@@ -496,7 +461,6 @@ public:
 			itemlist.clear();
 		}
 
-		pdiutil::safe_delete_array(tempbuffer);
 		jsonresp += CHARPTR_WRAP("]}");
 
 		this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_APPLICATION_JSON, jsonresp.c_str());
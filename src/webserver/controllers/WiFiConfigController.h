@@ -63,19 +63,16 @@ public:
   /**
    * build wifi config html.
    *
-   * @param	char*	_page
+   * @param	PageWriter&	_page
    * @param	bool|false	_is_error
    * @param	bool|false	_enable_flash
-   * @param	int|PAGE_HTML_MAX_SIZE	_max_size
    */
-  void build_wifi_config_html(char *_page, bool _is_error = false, bool _enable_flash = false, int _max_size = PAGE_HTML_MAX_SIZE)
+  void build_wifi_config_html(PageWriter &_page, bool _is_error = false, bool _enable_flash = false)
   {
 
-    // memset(_page, 0, _max_size);
     char _ip_address[20];
     concat_header_html( _page );
-    strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_TOP);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_TOP);
 
 #ifdef ALLOW_WIFI_CONFIG_MODIFICATION
 
@@ -88,7 +85,6 @@ public:
     concat_tr_input_html_tags(_page, RODT_ATTR("WiFi Gateway:"), RODT_ATTR("sta_gip"), _ip_address);
     __int_ip_to_str(_ip_address, this->wifi_configs.sta_subnet, 20);
     concat_tr_input_html_tags(_page, RODT_ATTR("WiFi Subnet:"), RODT_ATTR("sta_sip"), _ip_address);
-    CONTINUE_SEND_IN_CHUNK(_page);
 
     concat_tr_input_html_tags(_page, RODT_ATTR("Access Name:"), RODT_ATTR("ap_ssid"), this->wifi_configs.ap_ssid, WIFI_CONFIGS_BUF_SIZE - 1);
     concat_tr_input_html_tags(_page, RODT_ATTR("Access Password:"), RODT_ATTR("ap_pswd"), this->wifi_configs.ap_password, WIFI_CONFIGS_BUF_SIZE - 1);
@@ -101,8 +97,7 @@ public:
     concat_tr_input_html_tags(_page, RODT_ATTR("Access Subnet:"), RODT_ATTR("ap_sip"), _ip_address);
 
     concat_csrf_input_html_tag( _page );
-    strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 #else
 
 #ifdef ALLOW_WIFI_SSID_PASSKEY_CONFIG_MODIFICATION_ONLY
@@ -123,7 +118,6 @@ public:
     concat_tr_input_html_tags(_page, RODT_ATTR("WiFi Gateway:"), RODT_ATTR("sta_gip"), _ip_address, HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_TEXT_TAG_TYPE, false, true);
     __int_ip_to_str(_ip_address, this->wifi_configs.sta_subnet, 20);
     concat_tr_input_html_tags(_page, RODT_ATTR("WiFi Subnet:"), RODT_ATTR("sta_sip"), _ip_address, HTML_INPUT_TAG_DEFAULT_MAXLENGTH, HTML_INPUT_TEXT_TAG_TYPE, false, true);
-    CONTINUE_SEND_IN_CHUNK(_page);
 
     concat_tr_input_html_tags(_page, RODT_ATTR("Access Name:"), RODT_ATTR("ap_ssid"), this->wifi_configs.ap_ssid, WIFI_CONFIGS_BUF_SIZE - 1, HTML_INPUT_TEXT_TAG_TYPE, false, true);
     concat_tr_input_html_tags(_page, RODT_ATTR("Access Password:"), RODT_ATTR("ap_pswd"), this->wifi_configs.ap_password, WIFI_CONFIGS_BUF_SIZE - 1, HTML_INPUT_TEXT_TAG_TYPE, false, true);
@@ -138,8 +132,7 @@ public:
 #ifdef ALLOW_WIFI_SSID_PASSKEY_CONFIG_MODIFICATION_ONLY
 
     concat_csrf_input_html_tag( _page );
-    strcat_ro(_page, WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_WIFI_CONFIG_PAGE_BOTTOM);
 
 #endif
 
@@ -147,8 +140,7 @@ public:
 
     if (_enable_flash)
       concat_flash_message_div(_page, _is_error ? RODT_ATTR("Invalid length error(3-20)") : RODT_ATTR("Config saved Successfully..applying new configs."), _is_error ? ALERT_DANGER : ALERT_SUCCESS);
-    strcat_ro(_page, WEB_SERVER_FOOTER_HTML);
-    CONTINUE_SEND_IN_CHUNK(_page);
+    _page.append_ro(WEB_SERVER_FOOTER_HTML);
   }
 
   /**
@@ -254,19 +246,18 @@ public:
     }
 #endif
 
-    char *_page = pdiutil::safe_new_array<char>(PAGE_HTML_MAX_SIZE);
-    if (nullptr == _page) return;
+    PageWriter _page(this->m_web_resource->m_server);
+    if (!_page.ok()) return;
 
     if (_is_posted && !_is_error){
       this->m_route_handler->send_inactive_session_headers();
     }
 
-    BEGIN_SEND_IN_CHUNK(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
+    _page.begin(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML);
     this->build_wifi_config_html(_page, _is_error, _is_posted);
-    END_SENDING_CHUNK();
+    _page.end();
 
     // this->m_web_resource->m_server->send(HTTP_RESP_OK, MIME_TYPE_TEXT_HTML, _page);
-    pdiutil::safe_delete_array(_page);
     if (_is_posted && !_is_error)
     {
       __i_dvc_ctrl.wait(100);
@@ -16,146 +16,142 @@ created Date    : 1st June 2019
 #include <webserver/handlers/RouteHandler.h>
 
 /**
- * @brief Appends a style attribute to the provided buffer.
+ * @brief Appends a style attribute to the provided page.
  *
- * Generates a style attribute and appends it to the provided buffer.
+ * Generates a style attribute and appends it to the provided page.
  *
- * @param _page The buffer to which the style attribute is appended.
+ * @param _page The page to which the style attribute is appended.
  * @param _style The style attribute value.
  */
-void concat_style_attribute( char *_page, const char *_style ){
+void concat_style_attribute( PageWriter &_page, const char *_style ){
 
   if( _style ){
-    strcat_ro( _page, HTML_STYLE_ATTR );
-    strcat( _page, "'" );
-    strcat_ro( _page, _style );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_STYLE_ATTR );
+    _page.append( "'" );
+    _page.append_ro( _style );
+    _page.append( "'" );
   }
 }
 
-void concat_style_attribute( char *_page, char *_style ){
+void concat_style_attribute( PageWriter &_page, char *_style ){
 
   if( _style ){
-    strcat_ro( _page, HTML_STYLE_ATTR );
-    strcat( _page, "'" );
-    strcat( _page, _style );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_STYLE_ATTR );
+    _page.append( "'" );
+    _page.append( _style );
+    _page.append( "'" );
   }
 }
 
 /**
- * @brief Appends a class attribute to the provided buffer.
+ * @brief Appends a class attribute to the provided page.
  *
- * Generates a class attribute and appends it to the provided buffer.
+ * Generates a class attribute and appends it to the provided page.
  *
- * @param _page The buffer to which the class attribute is appended.
+ * @param _page The page to which the class attribute is appended.
  * @param _class The class attribute value.
  */
-void concat_class_attribute( char *_page, const char *_class ){
+void concat_class_attribute( PageWriter &_page, const char *_class ){
 
   if( _class ){
-    strcat_ro( _page, HTML_CLASS_ATTR );
-    strcat( _page, "'" );
-    strcat_ro( _page, _class );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_CLASS_ATTR );
+    _page.append( "'" );
+    _page.append_ro( _class );
+    _page.append( "'" );
   }
 }
 
-void concat_class_attribute( char *_page, char *_class ){
+void concat_class_attribute( PageWriter &_page, char *_class ){
 
   if( _class ){
-    strcat_ro( _page, HTML_CLASS_ATTR );
-    strcat( _page, "'" );
-    strcat( _page, _class );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_CLASS_ATTR );
+    _page.append( "'" );
+    _page.append( _class );
+    _page.append( "'" );
   }
 }
 
 /**
- * @brief Appends an ID attribute to the provided buffer.
+ * @brief Appends an ID attribute to the provided page.
  *
- * Generates an ID attribute and appends it to the provided buffer.
+ * Generates an ID attribute and appends it to the provided page.
  *
- * @param _page The buffer to which the ID attribute is appended.
+ * @param _page The page to which the ID attribute is appended.
  * @param _id The ID attribute value.
  */
-void concat_id_attribute( char *_page, const char *_id ){
+void concat_id_attribute( PageWriter &_page, const char *_id ){
 
   if( _id ){
-    strcat_ro( _page, HTML_ID_ATTR );
-    strcat( _page, "'" );
-    strcat_ro( _page, _id );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_ID_ATTR );
+    _page.append( "'" );
+    _page.append_ro( _id );
+    _page.append( "'" );
   }
 }
 
-void concat_id_attribute( char *_page, char *_id ){
+void concat_id_attribute( PageWriter &_page, char *_id ){
 
   if( _id ){
-    strcat_ro( _page, HTML_ID_ATTR );
-    strcat( _page, "'" );
-    strcat( _page, _id );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_ID_ATTR );
+    _page.append( "'" );
+    _page.append( _id );
+    _page.append( "'" );
   }
 }
 
 /**
- * @brief Appends a colspan attribute to the provided buffer.
+ * @brief Appends a colspan attribute to the provided page.
  *
- * Generates a colspan attribute and appends it to the provided buffer.
+ * Generates a colspan attribute and appends it to the provided page.
  *
- * @param _page The buffer to which the colspan attribute is appended.
+ * @param _page The page to which the colspan attribute is appended.
  * @param _colspan The colspan attribute value.
  */
-void concat_colspan_attribute( char *_page, const char *_colspan ){
+void concat_colspan_attribute( PageWriter &_page, const char *_colspan ){
 
   if( _colspan ){
-    strcat_ro( _page, HTML_COLSPAN_ATTR );
-    strcat( _page, "'" );
-    strcat_ro( _page, _colspan );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_COLSPAN_ATTR );
+    _page.append( "'" );
+    _page.append_ro( _colspan );
+    _page.append( "'" );
   }
 }
 
 /**
- * @brief Appends an HTML heading tag to the provided buffer.
+ * @brief Appends an HTML heading tag to the provided page.
  *
  * Generates an HTML heading tag with the specified attributes and appends it
- * to the provided buffer.
+ * to the provided page.
  *
- * @param _page The buffer to which the heading tag is appended.
+ * @param _page The page to which the heading tag is appended.
  * @param _heading The heading text.
  * @param _heading_level The level of the heading tag (default: 1).
  * @param _class_attr The class attribute for the heading tag (optional).
  * @param _style_attr The style attribute for the heading tag (optional).
  */
-void concat_heading_html_tag( char *_page, const char *_heading, uint8_t _heading_level, const char *_class_attr, const char *_style_attr ){
+void concat_heading_html_tag( PageWriter &_page, const char *_heading, uint8_t _heading_level, const char *_class_attr, const char *_style_attr ){
 
-  strcat_ro( _page,
-    _heading_level == 1 ? HTML_H1_OPEN_TAG :
+  _page.append_ro( _heading_level == 1 ? HTML_H1_OPEN_TAG :
     _heading_level == 2 ? HTML_H2_OPEN_TAG :
     _heading_level == 3 ? HTML_H3_OPEN_TAG :
-    HTML_H4_OPEN_TAG
-  );
+    HTML_H4_OPEN_TAG );
   concat_class_attribute( _page, _class_attr );
   concat_style_attribute( _page, _style_attr );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-  strcat_ro( _page, _heading );
-  strcat_ro( _page,
-    _heading_level == 1 ? HTML_H1_CLOSE_TAG :
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( _heading );
+  _page.append_ro( _heading_level == 1 ? HTML_H1_CLOSE_TAG :
     _heading_level == 2 ? HTML_H2_CLOSE_TAG :
     _heading_level == 3 ? HTML_H3_CLOSE_TAG :
-    HTML_H4_CLOSE_TAG
-  );
+    HTML_H4_CLOSE_TAG );
 }
 
 /**
- * @brief Appends an HTML input tag to the provided buffer.
+ * @brief Appends an HTML input tag to the provided page.
  *
  * Generates an HTML input tag with the specified attributes and appends it to
- * the provided buffer.
+ * the provided page.
  *
- * @param _page The buffer to which the HTML input tag is appended.
+ * @param _page The page to which the HTML input tag is appended.
  * @param _name The name attribute of the input tag.
  * @param _value The value attribute of the input tag.
  * @param _maxlength The maximum length of the input value (default: HTML_INPUT_TAG_DEFAULT_MAXLENGTH).
@@ -166,7 +162,7 @@ void concat_heading_html_tag( char *_page, const char *_heading, uint8_t _headin
  * @param _max The maximum value for range inputs (default: HTML_INPUT_RANGE_DEFAULT_MAX).
  */
 void concat_input_html_tag(
-  char *_page,
+  PageWriter &_page,
   const char *_name,
   char *_value,
   int _maxlength,
@@ -185,24 +181,24 @@ void concat_input_html_tag(
   if( 0 <= __strstr( _type, HTML_INPUT_RANGE_TAG_TYPE, 10 ) )
     _is_range = true;
 
-  strcat_ro( _page, HTML_INPUT_OPEN );
-  strcat_ro( _page, HTML_TYPE_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _type );
-  strcat( _page, "'" );
+  _page.append_ro( HTML_INPUT_OPEN );
+  _page.append_ro( HTML_TYPE_ATTR );
+  _page.append( "'" );
+  _page.append( _type );
+  _page.append( "'" );
 
   if( !_is_checkbox && !_is_range ){
     char _maxlen[7]; memset(_maxlen, 0, 7);
     Int32ToString( _maxlength, _maxlen, sizeof(_maxlen) );
 
-    strcat_ro( _page, HTML_MAXLEN_ATTR );
-    strcat( _page, "'" );
-    strcat( _page, _maxlen );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_MAXLEN_ATTR );
+    _page.append( "'" );
+    _page.append( _maxlen );
+    _page.append( "'" );
   }
 
   if( _checked ){
-    strcat_ro( _page, HTML_CHECKED_ATTR );
+    _page.append_ro( HTML_CHECKED_ATTR );
   }
 
   if( _is_range ){
@@ -210,29 +206,29 @@ void concat_input_html_tag(
     memset(_minbuff, 0, 7); memset(_maxbuff, 0, 7);
     Int32ToString( _min, _minbuff, sizeof(_minbuff) ); Int32ToString( _max, _maxbuff, sizeof(_maxbuff) );
 
-    strcat_ro( _page, HTML_MIN_RANGE_ATTR );
-    strcat( _page, "'" );
-    strcat( _page, _minbuff );
-    strcat( _page, "'" );
-    strcat_ro( _page, HTML_MAX_RANGE_ATTR );
-    strcat( _page, "'" );
-    strcat( _page, _maxbuff );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_MIN_RANGE_ATTR );
+    _page.append( "'" );
+    _page.append( _minbuff );
+    _page.append( "'" );
+    _page.append_ro( HTML_MAX_RANGE_ATTR );
+    _page.append( "'" );
+    _page.append( _maxbuff );
+    _page.append( "'" );
   }
 
-  strcat_ro( _page, HTML_NAME_ATTR );
-  strcat( _page, "'" );
-  strcat_ro( _page, _name );
-  strcat( _page, "'" );
-  if(_disabled)strcat_ro( _page, HTML_DISABLED_ATTR );
-  strcat_ro( _page, HTML_VALUE_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _value );
-  strcat_ro( _page, RODT_ATTR("'/>") );
+  _page.append_ro( HTML_NAME_ATTR );
+  _page.append( "'" );
+  _page.append_ro( _name );
+  _page.append( "'" );
+  if(_disabled)_page.append_ro( HTML_DISABLED_ATTR );
+  _page.append_ro( HTML_VALUE_ATTR );
+  _page.append( "'" );
+  _page.append( _value );
+  _page.append_ro( RODT_ATTR("'/>") );
 }
 
 void concat_input_html_tag(
-  char *_page,
+  PageWriter &_page,
   char *_name,
   char *_value,
   int _maxlength,
@@ -251,24 +247,24 @@ void concat_input_html_tag(
   if( 0 <= __strstr( _type, HTML_INPUT_RANGE_TAG_TYPE, 10 ) )
     _is_range = true;
 
-  strcat_ro( _page, HTML_INPUT_OPEN );
-  strcat_ro( _page, HTML_TYPE_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _type );
-  strcat( _page, "'" );
+  _page.append_ro( HTML_INPUT_OPEN );
+  _page.append_ro( HTML_TYPE_ATTR );
+  _page.append( "'" );
+  _page.append( _type );
+  _page.append( "'" );
 
   if( !_is_checkbox && !_is_range ){
     char _maxlen[7]; memset(_maxlen, 0, 7);
     Int32ToString( _maxlength, _maxlen, sizeof(_maxlen) );
 
-    strcat_ro( _page, HTML_MAXLEN_ATTR );
-    strcat( _page, "'" );
-    strcat( _page, _maxlen );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_MAXLEN_ATTR );
+    _page.append( "'" );
+    _page.append( _maxlen );
+    _page.append( "'" );
   }
 
   if( _checked ){
-    strcat_ro( _page, HTML_CHECKED_ATTR );
+    _page.append_ro( HTML_CHECKED_ATTR );
   }
 
   if( _is_range ){
@@ -276,34 +272,34 @@ void concat_input_html_tag(
     memset(_minbuff, 0, 7); memset(_maxbuff, 0, 7);
     Int32ToString( _min, _minbuff, sizeof(_minbuff) ); Int32ToString( _max, _maxbuff, sizeof(_maxbuff) );
 
-    strcat_ro( _page, HTML_MIN_RANGE_ATTR );
-    strcat( _page, "'" );
-    strcat( _page, _minbuff );
-    strcat( _page, "'" );
-    strcat_ro( _page, HTML_MAX_RANGE_ATTR );
-    strcat( _page, "'" );
-    strcat( _page, _maxbuff );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_MIN_RANGE_ATTR );
+    _page.append( "'" );
+    _page.append( _minbuff );
+    _page.append( "'" );
+    _page.append_ro( HTML_MAX_RANGE_ATTR );
+    _page.append( "'" );
+    _page.append( _maxbuff );
+    _page.append( "'" );
   }
 
-  strcat_ro( _page, HTML_NAME_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _name );
-  strcat( _page, "'" );
-  if(_disabled)strcat_ro( _page, HTML_DISABLED_ATTR );
-  strcat_ro( _page, HTML_VALUE_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _value );
-  strcat_ro( _page, RODT_ATTR("'/>") );
+  _page.append_ro( HTML_NAME_ATTR );
+  _page.append( "'" );
+  _page.append( _name );
+  _page.append( "'" );
+  if(_disabled)_page.append_ro( HTML_DISABLED_ATTR );
+  _page.append_ro( HTML_VALUE_ATTR );
+  _page.append( "'" );
+  _page.append( _value );
+  _page.append_ro( RODT_ATTR("'/>") );
 }
 
 /**
- * @brief Appends an HTML table cell with input fields to the provided buffer.
+ * @brief Appends an HTML table cell with input fields to the provided page.
  *
  * Generates an HTML table cell containing input fields with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the HTML table cell is appended.
+ * @param _page The page to which the HTML table cell is appended.
  * @param _label The label for the input field.
  * @param _name The name attribute of the input field.
  * @param _value The value attribute of the input field.
@@ -315,7 +311,7 @@ void concat_input_html_tag(
  * @param _max The maximum value for range inputs (default: HTML_INPUT_RANGE_DEFAULT_MAX).
  */
 void concat_td_input_html_tags(
-  char *_page,
+  PageWriter &_page,
   const char *_label,
   const char *_name,
   char *_value,
@@ -326,18 +322,18 @@ void concat_td_input_html_tags(
   int _min,
   int _max ){
 
-  strcat_ro( _page, HTML_TD_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-  strcat_ro( _page, _label );
-  strcat_ro( _page, HTML_TD_CLOSE_TAG );
-  strcat_ro( _page, HTML_TD_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TD_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( _label );
+  _page.append_ro( HTML_TD_CLOSE_TAG );
+  _page.append_ro( HTML_TD_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
   concat_input_html_tag( _page, _name, _value, _maxlength, _type, _checked, _disabled, _min, _max );
-  strcat_ro( _page, HTML_TD_CLOSE_TAG );
+  _page.append_ro( HTML_TD_CLOSE_TAG );
 }
 
 void concat_td_input_html_tags(
-  char *_page,
+  PageWriter &_page,
   char *_label,
   char *_name,
   char *_value,
@@ -348,23 +344,23 @@ void concat_td_input_html_tags(
   int _min,
   int _max ){
 
-  strcat_ro( _page, HTML_TD_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-  strcat( _page, _label );
-  strcat_ro( _page, HTML_TD_CLOSE_TAG );
-  strcat_ro( _page, HTML_TD_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TD_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+  _page.append( _label );
+  _page.append_ro( HTML_TD_CLOSE_TAG );
+  _page.append_ro( HTML_TD_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
   concat_input_html_tag( _page, _name, _value, _maxlength, _type, _checked, _disabled, _min, _max );
-  strcat_ro( _page, HTML_TD_CLOSE_TAG );
+  _page.append_ro( HTML_TD_CLOSE_TAG );
 }
 
 /**
- * @brief Appends an HTML table row with input fields to the provided buffer.
+ * @brief Appends an HTML table row with input fields to the provided page.
  *
  * Generates an HTML table row containing input fields with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the HTML table row is appended.
+ * @param _page The page to which the HTML table row is appended.
  * @param _label The label for the input field.
  * @param _name The name attribute of the input field.
  * @param _value The value attribute of the input field.
@@ -376,7 +372,7 @@ void concat_td_input_html_tags(
  * @param _max The maximum value for range inputs (default: HTML_INPUT_RANGE_DEFAULT_MAX).
  */
 void concat_tr_input_html_tags(
-    char *_page,
+    PageWriter &_page,
     const char *_label,
     const char *_name,
     char *_value,
@@ -387,15 +383,15 @@ void concat_tr_input_html_tags(
     int _min,
     int _max ){
   
-      strcat_ro( _page, HTML_TR_OPEN_TAG );
-      strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+      _page.append_ro( HTML_TR_OPEN_TAG );
+      _page.append_ro( HTML_TAG_CLOSE_BRACKET );
       concat_td_input_html_tags(_page, _label, _name, _value, _maxlength, _type, _checked, _disabled, _min, _max);
-      strcat_ro( _page, HTML_TR_CLOSE_TAG );
+      _page.append_ro( HTML_TR_CLOSE_TAG );
   }
   
   
 void concat_tr_input_html_tags(
-  char *_page,
+  PageWriter &_page,
   char *_label,
   char *_name,
   char *_value,
@@ -406,19 +402,19 @@ void concat_tr_input_html_tags(
   int _min,
   int _max ){
 
-    strcat_ro( _page, HTML_TR_OPEN_TAG );
-    strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+    _page.append_ro( HTML_TR_OPEN_TAG );
+    _page.append_ro( HTML_TAG_CLOSE_BRACKET );
     concat_td_input_html_tags(_page, _label, _name, _value, _maxlength, _type, _checked, _disabled, _min, _max);
-    strcat_ro( _page, HTML_TR_CLOSE_TAG );
+    _page.append_ro( HTML_TR_CLOSE_TAG );
 }
 
 /**
- * @brief Appends an HTML select dropdown to the provided buffer.
+ * @brief Appends an HTML select dropdown to the provided page.
  *
  * Generates an HTML select dropdown with the specified options and appends it
- * to the provided buffer.
+ * to the provided page.
  *
- * @param _page The buffer to which the select dropdown is appended.
+ * @param _page The page to which the select dropdown is appended.
  * @param _name The name attribute of the select dropdown.
  * @param _options The array of options for the dropdown.
  * @param _size The number of options in the dropdown.
@@ -426,15 +422,15 @@ void concat_tr_input_html_tags(
  * @param _exception The index of an option to exclude (default: -1).
  * @param _disabled Whether the dropdown is disabled (default: false).
  */
-void concat_select_html_tag( char *_page, char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
+void concat_select_html_tag( PageWriter &_page, char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
 
-  strcat_ro( _page, HTML_SELECT_OPEN );
-  if(_disabled)strcat_ro( _page, HTML_DISABLED_ATTR );
-  strcat_ro( _page, HTML_NAME_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _name );
-  strcat( _page, "'" );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_SELECT_OPEN );
+  if(_disabled)_page.append_ro( HTML_DISABLED_ATTR );
+  _page.append_ro( HTML_NAME_ATTR );
+  _page.append( "'" );
+  _page.append( _name );
+  _page.append( "'" );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
 
   for (int i = 0; i < _size; i++) {
 
@@ -442,30 +438,30 @@ void concat_select_html_tag( char *_page, char *_name, const char** _options, in
       char buf[3];
       memset( buf, 0, 3 );
       Int32ToString( i, buf, sizeof(buf) );
-      strcat_ro( _page, HTML_OPTION_OPEN );
-      strcat_ro( _page, HTML_VALUE_ATTR );
-      strcat( _page, "'" );
-      strcat( _page, buf );
-      strcat( _page, "'" );
+      _page.append_ro( HTML_OPTION_OPEN );
+      _page.append_ro( HTML_VALUE_ATTR );
+      _page.append( "'" );
+      _page.append( buf );
+      _page.append( "'" );
       if( _selected == i )
-      strcat_ro( _page, HTML_SELECTED_ATTR );
-      strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-      strcat( _page, _options[i] );
-      strcat_ro( _page, HTML_OPTION_CLOSE );
+      _page.append_ro( HTML_SELECTED_ATTR );
+      _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+      _page.append( _options[i] );
+      _page.append_ro( HTML_OPTION_CLOSE );
     }
   }
-  strcat_ro( _page, HTML_SELECT_CLOSE );
+  _page.append_ro( HTML_SELECT_CLOSE );
 }
 
-void concat_select_html_tag( char *_page, const char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
+void concat_select_html_tag( PageWriter &_page, const char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
 
-  strcat_ro( _page, HTML_SELECT_OPEN );
-  if(_disabled)strcat_ro( _page, HTML_DISABLED_ATTR );
-  strcat_ro( _page, HTML_NAME_ATTR );
-  strcat( _page, "'" );
-  strcat_ro( _page, _name );
-  strcat( _page, "'" );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_SELECT_OPEN );
+  if(_disabled)_page.append_ro( HTML_DISABLED_ATTR );
+  _page.append_ro( HTML_NAME_ATTR );
+  _page.append( "'" );
+  _page.append_ro( _name );
+  _page.append( "'" );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
 
   for (int i = 0; i < _size; i++) {
 
@@ -473,28 +469,28 @@ void concat_select_html_tag( char *_page, const char *_name, const char** _optio
       char buf[3];
       memset( buf, 0, 3 );
       Int32ToString( i, buf, sizeof(buf) );
-      strcat_ro( _page, HTML_OPTION_OPEN );
-      strcat_ro( _page, HTML_VALUE_ATTR );
-      strcat( _page, "'" );
-      strcat( _page, buf );
-      strcat( _page, "'" );
+      _page.append_ro( HTML_OPTION_OPEN );
+      _page.append_ro( HTML_VALUE_ATTR );
+      _page.append( "'" );
+      _page.append( buf );
+      _page.append( "'" );
       if( _selected == i )
-      strcat_ro( _page, HTML_SELECTED_ATTR );
-      strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-      strcat( _page, _options[i] );
-      strcat_ro( _page, HTML_OPTION_CLOSE );
+      _page.append_ro( HTML_SELECTED_ATTR );
+      _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+      _page.append( _options[i] );
+      _page.append_ro( HTML_OPTION_CLOSE );
     }
   }
-  strcat_ro( _page, HTML_SELECT_CLOSE );
+  _page.append_ro( HTML_SELECT_CLOSE );
 }
 
 /**
- * @brief Appends an HTML table cell with select dropdowns to the provided buffer.
+ * @brief Appends an HTML table cell with select dropdowns to the provided page.
  *
  * Generates an HTML table cell containing select dropdowns with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the table cell is appended.
+ * @param _page The page to which the table cell is appended.
  * @param _label The label for the dropdown.
  * @param _name The name attribute of the dropdown.
  * @param _options The array of options for the dropdown.
@@ -503,37 +499,37 @@ void concat_select_html_tag( char *_page, const char *_name, const char** _optio
  * @param _exception The index of an option to exclude (default: -1).
  * @param _disabled Whether the dropdown is disabled (default: false).
  */
-void concat_td_select_html_tags( char *_page, char *_label, char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
-
-  strcat_ro( _page, HTML_TD_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-  strcat( _page, _label );
-  strcat_ro( _page, HTML_TD_CLOSE_TAG );
-  strcat_ro( _page, HTML_TD_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+void concat_td_select_html_tags( PageWriter &_page, char *_label, char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
+
+  _page.append_ro( HTML_TD_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+  _page.append( _label );
+  _page.append_ro( HTML_TD_CLOSE_TAG );
+  _page.append_ro( HTML_TD_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
   concat_select_html_tag( _page, _name, _options, _size, _selected, _exception, _disabled );
-  strcat_ro( _page, HTML_TD_CLOSE_TAG );
+  _page.append_ro( HTML_TD_CLOSE_TAG );
 }
 
-void concat_td_select_html_tags( char *_page, const char *_label, const char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
+void concat_td_select_html_tags( PageWriter &_page, const char *_label, const char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
 
-  strcat_ro( _page, HTML_TD_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-  strcat_ro( _page, _label );
-  strcat_ro( _page, HTML_TD_CLOSE_TAG );
-  strcat_ro( _page, HTML_TD_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TD_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( _label );
+  _page.append_ro( HTML_TD_CLOSE_TAG );
+  _page.append_ro( HTML_TD_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
   concat_select_html_tag( _page, _name, _options, _size, _selected, _exception, _disabled );
-  strcat_ro( _page, HTML_TD_CLOSE_TAG );
+  _page.append_ro( HTML_TD_CLOSE_TAG );
 }
 
 /**
- * @brief Appends an HTML table row with select dropdowns to the provided buffer.
+ * @brief Appends an HTML table row with select dropdowns to the provided page.
  *
  * Generates an HTML table row containing select dropdowns with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the table row is appended.
+ * @param _page The page to which the table row is appended.
  * @param _label The label for the dropdown.
  * @param _name The name attribute of the dropdown.
  * @param _options The array of options for the dropdown.
@@ -542,193 +538,193 @@ void concat_td_select_html_tags( char *_page, const char *_label, const char *_n
  * @param _exception The index of an option to exclude (default: -1).
  * @param _disabled Whether the dropdown is disabled (default: false).
  */
-void concat_tr_select_html_tags( char *_page, const char *_label, const char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
+void concat_tr_select_html_tags( PageWriter &_page, const char *_label, const char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
 
-  strcat_ro( _page, HTML_TR_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TR_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
   concat_td_select_html_tags( _page, _label, _name, _options, _size, _selected, _exception, _disabled );
-  strcat_ro( _page, HTML_TR_CLOSE_TAG );
+  _page.append_ro( HTML_TR_CLOSE_TAG );
 }
 
-void concat_tr_select_html_tags( char *_page, char *_label, char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
+void concat_tr_select_html_tags( PageWriter &_page, char *_label, char *_name, const char** _options, int _size, int _selected, int _exception, bool _disabled ){
 
-  strcat_ro( _page, HTML_TR_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TR_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
   concat_td_select_html_tags( _page, _label, _name, _options, _size, _selected, _exception, _disabled );
-  strcat_ro( _page, HTML_TR_CLOSE_TAG );
+  _page.append_ro( HTML_TR_CLOSE_TAG );
 }
 
 
 /**
- * @brief Appends an HTML table head with select dropdowns to the provided buffer.
+ * @brief Appends an HTML table head with select dropdowns to the provided page.
  *
  * Generates an HTML table head containing select dropdowns with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the table head is appended.
+ * @param _page The page to which the table head is appended.
  * @param _heading The heading text for the table head.
  * @param _header_level The level of the heading (default: 1).
  * @param _colspan_attr The colspan attribute for the table head (optional).
  * @param _class_attr The class attribute for the table head (optional).
  * @param _style_attr The style attribute for the table head (optional).
  */
-void concat_tr_heading_html_tags( char *_page, const char *_heading, uint8_t	_header_level, const char *_colspan_attr, const char *_class_attr, const char *_style_attr ){
+void concat_tr_heading_html_tags( PageWriter &_page, const char *_heading, uint8_t	_header_level, const char *_colspan_attr, const char *_class_attr, const char *_style_attr ){
 
-  strcat_ro( _page, HTML_TR_OPEN_TAG );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-  strcat_ro( _page, HTML_TD_OPEN_TAG );
+  _page.append_ro( HTML_TR_OPEN_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TD_OPEN_TAG );
   concat_colspan_attribute( _page, _colspan_attr );
   concat_class_attribute( _page, _class_attr );
   concat_style_attribute( _page, _style_attr );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
   concat_heading_html_tag( _page, _heading, _header_level );
-  strcat_ro( _page, HTML_TD_CLOSE_TAG );
-  strcat_ro( _page, HTML_TR_CLOSE_TAG );
+  _page.append_ro( HTML_TD_CLOSE_TAG );
+  _page.append_ro( HTML_TR_CLOSE_TAG );
 }
 
 /**
- * @brief Appends a flash message div to the provided buffer.
+ * @brief Appends a flash message div to the provided page.
  *
  * Generates an HTML div for displaying a flash message with the specified
- * status and appends it to the provided buffer.
+ * status and appends it to the provided page.
  *
- * @param _page The buffer to which the flash message div is appended.
+ * @param _page The page to which the flash message div is appended.
  * @param _message The message to display in the flash message.
  * @param _status The status of the flash message (e.g., ALERT_SUCCESS).
  */
-void concat_flash_message_div( char *_page, const char *_message, int _status ){
-
-  strcat_ro( _page, HTML_DIV_OPEN_TAG );
-  strcat_ro( _page, HTML_CLASS_ATTR );
-  strcat_ro( _page, RODT_ATTR("'msg ") );
-  strcat_ro( _page, _status==ALERT_DANGER ? RODT_ATTR("er"): _status==ALERT_SUCCESS ? RODT_ATTR("ok") : RODT_ATTR("wn") );
-  strcat_ro( _page, RODT_ATTR("'>") );
-  strcat_ro( _page, _message );
-  strcat_ro( _page, HTML_DIV_CLOSE_TAG );
+void concat_flash_message_div( PageWriter &_page, const char *_message, int _status ){
+
+  _page.append_ro( HTML_DIV_OPEN_TAG );
+  _page.append_ro( HTML_CLASS_ATTR );
+  _page.append_ro( RODT_ATTR("'msg ") );
+  _page.append_ro( _status==ALERT_DANGER ? RODT_ATTR("er"): _status==ALERT_SUCCESS ? RODT_ATTR("ok") : RODT_ATTR("wn") );
+  _page.append_ro( RODT_ATTR("'>") );
+  _page.append_ro( _message );
+  _page.append_ro( HTML_DIV_CLOSE_TAG );
 }
 
-void concat_flash_message_div( char *_page, char *_message, int _status ){
+void concat_flash_message_div( PageWriter &_page, char *_message, int _status ){
 
-  strcat_ro( _page, HTML_DIV_OPEN_TAG );
-  strcat_ro( _page, HTML_CLASS_ATTR );
-  strcat_ro( _page, RODT_ATTR("'msg ") );
-  strcat_ro( _page, _status==ALERT_DANGER ? RODT_ATTR("er"): _status==ALERT_SUCCESS ? RODT_ATTR("ok") : RODT_ATTR("wn") );
-  strcat_ro( _page, RODT_ATTR("'>") );
-  strcat( _page, _message );
-  strcat_ro( _page, HTML_DIV_CLOSE_TAG );
+  _page.append_ro( HTML_DIV_OPEN_TAG );
+  _page.append_ro( HTML_CLASS_ATTR );
+  _page.append_ro( RODT_ATTR("'msg ") );
+  _page.append_ro( _status==ALERT_DANGER ? RODT_ATTR("er"): _status==ALERT_SUCCESS ? RODT_ATTR("ok") : RODT_ATTR("wn") );
+  _page.append_ro( RODT_ATTR("'>") );
+  _page.append( _message );
+  _page.append_ro( HTML_DIV_CLOSE_TAG );
 }
 
 /**
- * @brief Appends a graph axis title div to the provided buffer.
+ * @brief Appends a graph axis title div to the provided page.
  *
  * Generates an HTML div for displaying a graph axis title and appends it to
- * the provided buffer.
+ * the provided page.
  *
- * @param _page The buffer to which the graph axis title div is appended.
+ * @param _page The page to which the graph axis title div is appended.
  * @param _title The title text for the graph axis.
  * @param _style The style attribute for the graph axis title (optional).
  */
-void concat_graph_axis_title_div( char *_page, char *_title, char *_style ){
-
-  strcat_ro( _page, HTML_DIV_OPEN_TAG );
-  strcat_ro( _page, HTML_STYLE_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _style );
-  strcat( _page, ";'>" );
-  strcat( _page, _title );
-  strcat_ro( _page, HTML_DIV_CLOSE_TAG );
+void concat_graph_axis_title_div( PageWriter &_page, char *_title, char *_style ){
+
+  _page.append_ro( HTML_DIV_OPEN_TAG );
+  _page.append_ro( HTML_STYLE_ATTR );
+  _page.append( "'" );
+  _page.append( _style );
+  _page.append( ";'>" );
+  _page.append( _title );
+  _page.append_ro( HTML_DIV_CLOSE_TAG );
 }
 
 /**
- * @brief Appends an SVG element to the provided buffer.
+ * @brief Appends an SVG element to the provided page.
  *
  * Generates an SVG element with the specified attributes and appends it to
- * the provided buffer.
+ * the provided page.
  *
- * @param _page The buffer to which the SVG element is appended.
+ * @param _page The page to which the SVG element is appended.
  * @param _path The SVG path data.
  * @param _width The width of the SVG element (default: HTML_SVG_DEFAULT_WIDTH).
  * @param _height The height of the SVG element (default: HTML_SVG_DEFAULT_HEIGHT).
  * @param _fill The fill color of the SVG element (default: HTML_SVG_DEFAULT_FILL).
  */
-void concat_svg_tag( char *_page, const char *_path, const char *_style, const char *_viewbox, int _width, int _height, char *_fill ){
+void concat_svg_tag( PageWriter &_page, const char *_path, const char *_style, const char *_viewbox, int _width, int _height, char *_fill ){
 
   char _widthbuff[7]; memset(_widthbuff, 0, 7);
   Int32ToString( _width, _widthbuff, sizeof(_widthbuff) );
   char _heightbuff[7]; memset(_heightbuff, 0, 7);
   Int32ToString( _height, _heightbuff, sizeof(_heightbuff) );
 
-  strcat_ro( _page, HTML_SVG_OPEN_TAG );
+  _page.append_ro( HTML_SVG_OPEN_TAG );
   concat_style_attribute( _page, _style);
 
-  strcat_ro( _page, HTML_WIDTH_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _widthbuff );
-  strcat( _page, "'" );
+  _page.append_ro( HTML_WIDTH_ATTR );
+  _page.append( "'" );
+  _page.append( _widthbuff );
+  _page.append( "'" );
 
-  strcat_ro( _page, HTML_HEIGHT_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _heightbuff );
-  strcat( _page, "'" );
+  _page.append_ro( HTML_HEIGHT_ATTR );
+  _page.append( "'" );
+  _page.append( _heightbuff );
+  _page.append( "'" );
 
   if( _viewbox != nullptr ){
-    strcat_ro( _page, HTML_VIEWBOX_ATTR );
-    strcat( _page, "'" );
-    strcat_ro( _page, _viewbox );
-    strcat( _page, "'" );
+    _page.append_ro( HTML_VIEWBOX_ATTR );
+    _page.append( "'" );
+    _page.append_ro( _viewbox );
+    _page.append( "'" );
   }
 
-  strcat_ro( _page, HTML_FILL_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _fill );
-  strcat( _page, "'" );
+  _page.append_ro( HTML_FILL_ATTR );
+  _page.append( "'" );
+  _page.append( _fill );
+  _page.append( "'" );
 
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
   
-  strcat_ro( _page, _path );
-  strcat_ro( _page, HTML_SVG_CLOSE_TAG );
+  _page.append_ro( _path );
+  _page.append_ro( HTML_SVG_CLOSE_TAG );
 }
 
 /**
- * @brief Appends an SVG menu card to the provided buffer.
+ * @brief Appends an SVG menu card to the provided page.
  *
  * Generates an SVG menu card with the specified attributes and appends it to
- * the provided buffer.
+ * the provided page.
  *
- * @param _page The buffer to which the SVG menu card is appended.
+ * @param _page The page to which the SVG menu card is appended.
  * @param _menu_title The title of the menu card.
  * @param _svg_path The SVG path data for the menu card icon.
  * @param _menu_link The link associated with the menu card.
  */
-void concat_svg_menu_card( char *_page, const char *_menu_title, const char *_svg_path, char *_menu_link ){
+void concat_svg_menu_card( PageWriter &_page, const char *_menu_title, const char *_svg_path, char *_menu_link ){
 
-  strcat_ro( _page, HTML_DIV_OPEN_TAG );
-  strcat( _page, ">" );
-  strcat_ro( _page, HTML_LINK_OPEN_TAG );
-  strcat_ro( _page, HTML_HREF_ATTR );
+  _page.append_ro( HTML_DIV_OPEN_TAG );
+  _page.append( ">" );
+  _page.append_ro( HTML_LINK_OPEN_TAG );
+  _page.append_ro( HTML_HREF_ATTR );
 
-  strcat( _page, "'" );
-  strcat( _page, _menu_link );
-  strcat( _page, "'>" );
+  _page.append( "'" );
+  _page.append( _menu_link );
+  _page.append( "'>" );
 
   concat_svg_tag( _page, _svg_path );
 
-  strcat_ro( _page, HTML_SPAN_OPEN_TAG );
-  strcat( _page, ">" );
-  strcat_ro( _page, _menu_title );
-  strcat_ro( _page, HTML_SPAN_CLOSE_TAG );
+  _page.append_ro( HTML_SPAN_OPEN_TAG );
+  _page.append( ">" );
+  _page.append_ro( _menu_title );
+  _page.append_ro( HTML_SPAN_CLOSE_TAG );
 
-  strcat_ro( _page, HTML_LINK_CLOSE_TAG );
-  strcat_ro( _page, HTML_DIV_CLOSE_TAG );
+  _page.append_ro( HTML_LINK_CLOSE_TAG );
+  _page.append_ro( HTML_DIV_CLOSE_TAG );
 }
 
 /**
- * @brief Appends an HTML table heading row to the provided buffer.
+ * @brief Appends an HTML table heading row to the provided page.
  *
  * Generates an HTML table heading row with the specified attributes and appends
- * it to the provided buffer.
+ * it to the provided page.
  *
- * @param _page The buffer to which the table heading row is appended.
+ * @param _page The page to which the table heading row is appended.
  * @param _headings The array of headings for the table row.
  * @param _size The number of headings in the row.
  * @param _row_class The class attribute for the table row (optional).
@@ -736,32 +732,32 @@ void concat_svg_menu_card( char *_page, const char *_menu_title, const char *_sv
  * @param _head_class The class attribute for the table headings (optional).
  * @param _head_style The style attribute for the table headings (optional).
  */
-void concat_table_heading_row( char *_page, char** _headings, int _size, const char *_row_class, const char *_row_style, const char *_head_class, const char *_head_style ){
+void concat_table_heading_row( PageWriter &_page, char** _headings, int _size, const char *_row_class, const char *_row_style, const char *_head_class, const char *_head_style ){
 
-  strcat_ro( _page, HTML_TR_OPEN_TAG );
+  _page.append_ro( HTML_TR_OPEN_TAG );
   concat_class_attribute( _page, _row_class );
   concat_style_attribute( _page, _row_style );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
 
   for (int i = 0; i < _size; i++) {
-    strcat_ro( _page, HTML_TH_OPEN_TAG );
+    _page.append_ro( HTML_TH_OPEN_TAG );
     concat_class_attribute( _page, _head_class );
     concat_style_attribute( _page, _head_style );
-    strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-    strcat( _page, _headings[i] );
-    strcat_ro( _page, HTML_TH_CLOSE_TAG );
+    _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+    _page.append( _headings[i] );
+    _page.append_ro( HTML_TH_CLOSE_TAG );
   }
 
-  strcat_ro( _page, HTML_TR_CLOSE_TAG );
+  _page.append_ro( HTML_TR_CLOSE_TAG );
 }
 
 /**
- * @brief Appends an HTML table data row to the provided buffer.
+ * @brief Appends an HTML table data row to the provided page.
  *
  * Generates an HTML table data row with the specified attributes and appends
- * it to the provided buffer.
+ * it to the provided page.
  *
- * @param _page The buffer to which the table data row is appended.
+ * @param _page The page to which the table data row is appended.
  * @param _data_items The array of data items for the table row.
  * @param _size The number of data items in the row.
  * @param _row_class The class attribute for the table row (optional).
@@ -769,80 +765,75 @@ void concat_table_heading_row( char *_page, char** _headings, int _size, const c
  * @param _data_class The class attribute for the table data cells (optional).
  * @param _data_style The style attribute for the table data cells (optional).
  */
-void concat_table_data_row( char *_page, char** _data_items, int _size, const char *_row_class, const char *_row_style, const char *_data_class, const char *_data_style, const char **_td_colspan_attr ){
+void concat_table_data_row( PageWriter &_page, char** _data_items, int _size, const char *_row_class, const char *_row_style, const char *_data_class, const char *_data_style, const char **_td_colspan_attr ){
 
-  strcat_ro( _page, HTML_TR_OPEN_TAG );
+  _page.append_ro( HTML_TR_OPEN_TAG );
   concat_class_attribute( _page, _row_class );
   concat_style_attribute( _page, _row_style );
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
 
   for (int i = 0; i < _size; i++) {
-    strcat_ro( _page, HTML_TD_OPEN_TAG );
+    _page.append_ro( HTML_TD_OPEN_TAG );
     concat_class_attribute( _page, _data_class );
     concat_style_attribute( _page, _data_style );
     if( nullptr != _td_colspan_attr && nullptr != _td_colspan_attr[i] )
       concat_colspan_attribute( _page, _td_colspan_attr[i] );
-    strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-    strcat( _page, _data_items[i] );
-    strcat_ro( _page, HTML_TD_CLOSE_TAG );
+    _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+    _page.append( _data_items[i] );
+    _page.append_ro( HTML_TD_CLOSE_TAG );
   }
 
-  strcat_ro( _page, HTML_TR_CLOSE_TAG );
+  _page.append_ro( HTML_TR_CLOSE_TAG );
 }
 
 /**
- * @brief Appends an HTML link element to the provided buffer.
+ * @brief Appends an HTML link element to the provided page.
  *
  * Generates an HTML link element with the specified attributes and appends
- * it to the provided buffer.
+ * it to the provided page.
  *
- * @param _page The buffer to which the link element is appended.
+ * @param _page The page to which the link element is appended.
  * @param _href The href attribute for the link.
  * @param _innerhtml The innerhtml part of link.
  * @param _class The class attribute for the link(optional).
  * @param _style The style attribute for the link(optional).
  */
-void concat_link_element(char *_page, const char *_href, const char *_innerhtml, const char *_class, const char *_style ){
-  strcat_ro( _page, HTML_LINK_OPEN_TAG );
+void concat_link_element(PageWriter &_page, const char *_href, const char *_innerhtml, const char *_class, const char *_style ){
+  _page.append_ro( HTML_LINK_OPEN_TAG );
 
-  strcat_ro( _page, HTML_HREF_ATTR );
-  strcat( _page, "'" );
-  strcat_ro( _page, _href );
-  strcat( _page, "'" );
+  _page.append_ro( HTML_HREF_ATTR );
+  _page.append( "'" );
+  _page.append_ro( _href );
+  _page.append( "'" );
 
   concat_class_attribute( _page, _class );
   concat_style_attribute( _page, _style );
 
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
-  strcat( _page, _innerhtml );
-  strcat_ro( _page, HTML_LINK_CLOSE_TAG );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
+  _page.append( _innerhtml );
+  _page.append_ro( HTML_LINK_CLOSE_TAG );
 }
 
 /**
  * @brief Appends the page header and opens the content container.
  */
-void concat_header_html( char *_page, bool _wide ){
+void concat_header_html( PageWriter &_page, bool _wide ){
 
-  strcat_ro( _page, WEB_SERVER_HEADER_HTML );
-  CONTINUE_SEND_IN_CHUNK(_page);
+  _page.append_ro( WEB_SERVER_HEADER_HTML );
 
-  strcat_ro( _page, WEB_SERVER_HEADER_HTML_LAYOUT );
-  CONTINUE_SEND_IN_CHUNK(_page);
+  _page.append_ro( WEB_SERVER_HEADER_HTML_LAYOUT );
 
-  strcat_ro( _page, WEB_SERVER_HEADER_HTML_CONTROLS );
-  CONTINUE_SEND_IN_CHUNK(_page);
+  _page.append_ro( WEB_SERVER_HEADER_HTML_CONTROLS );
 
-  strcat_ro( _page, WEB_SERVER_HEADER_HTML_MENU );
-  CONTINUE_SEND_IN_CHUNK(_page);
+  _page.append_ro( WEB_SERVER_HEADER_HTML_MENU );
 
-  strcat_ro( _page, WEB_SERVER_HEADER_CNTNR_OPEN );
+  _page.append_ro( WEB_SERVER_HEADER_CNTNR_OPEN );
 
   if( _wide ){
-    strcat_ro( _page, WEB_SERVER_HEADER_CNTNR_WIDE );
+    _page.append_ro( WEB_SERVER_HEADER_CNTNR_WIDE );
   }
 
-  strcat_ro( _page, WEB_SERVER_HEADER_TITLE );
-  CONTINUE_SEND_IN_CHUNK(_page);
+  _page.append_ro( WEB_SERVER_HEADER_TITLE );
 }
 
 /**
@@ -857,7 +848,7 @@ const char* get_csrf_token( void ){
 /**
  * @brief Appends the csrf hidden input of the active session to a form.
  */
-void concat_csrf_input_html_tag( char *_page ){
+void concat_csrf_input_html_tag( PageWriter &_page ){
 
   const char *_token = get_csrf_token();
 
@@ -865,23 +856,23 @@ void concat_csrf_input_html_tag( char *_page ){
     return;
   }
 
-  strcat_ro( _page, HTML_INPUT_OPEN );
-  strcat_ro( _page, HTML_TYPE_ATTR );
-  strcat( _page, "'" );
-  strcat_ro( _page, RODT_ATTR(HTML_INPUT_HIDDEN_TAG_TYPE) );
-  strcat( _page, "'" );
+  _page.append_ro( HTML_INPUT_OPEN );
+  _page.append_ro( HTML_TYPE_ATTR );
+  _page.append( "'" );
+  _page.append_ro( RODT_ATTR(HTML_INPUT_HIDDEN_TAG_TYPE) );
+  _page.append( "'" );
 
-  strcat_ro( _page, HTML_NAME_ATTR );
-  strcat( _page, "'" );
-  strcat_ro( _page, RODT_ATTR(WEB_CSRF_FIELD_NAME) );
-  strcat( _page, "'" );
+  _page.append_ro( HTML_NAME_ATTR );
+  _page.append( "'" );
+  _page.append_ro( RODT_ATTR(WEB_CSRF_FIELD_NAME) );
+  _page.append( "'" );
 
-  strcat_ro( _page, HTML_VALUE_ATTR );
-  strcat( _page, "'" );
-  strcat( _page, _token );
-  strcat( _page, "'" );
+  _page.append_ro( HTML_VALUE_ATTR );
+  _page.append( "'" );
+  _page.append( _token );
+  _page.append( "'" );
 
-  strcat_ro( _page, HTML_TAG_CLOSE_BRACKET );
+  _page.append_ro( HTML_TAG_CLOSE_BRACKET );
 }
 
 #endif
\ No newline at end of file
@@ -8,7 +8,7 @@ The `DynamicPageBuildHelper.h` file provides utility functions to dynamically
 generate HTML content for the web server. These functions allow for the creation
 of various HTML elements, such as input fields, table rows, headings, select
 dropdowns, SVG elements, and flash messages. The generated HTML is appended to
-a provided buffer to construct complete web pages dynamically.
+a PageWriter, which streams complete web pages out as they are built.
 
 Author          : Suraj I.
 Created Date    : 1st June 2019
@@ -19,6 +19,7 @@ Created Date    : 1st June 2019
 
 #include <webserver/helpers/icon/SvgIcons.h>
 #include <webserver/helpers/HtmlTagsAndAttr.h>
+#include <webserver/helpers/PageWriter.h>
 #include <utility/Utility.h>
 
 /**
@@ -36,12 +37,12 @@ enum FLASH_MSG_TYPE {
 };
 
 /**
- * @brief Appends an HTML input tag to the provided buffer.
+ * @brief Appends an HTML input tag to the provided page.
  *
  * Generates an HTML input tag with the specified attributes and appends it to
- * the provided buffer.
+ * the provided page.
  *
- * @param _page The buffer to which the HTML input tag is appended.
+ * @param _page The page to which the HTML input tag is appended.
  * @param _name The name attribute of the input tag.
  * @param _value The value attribute of the input tag.
  * @param _maxlength The maximum length of the input value (default: HTML_INPUT_TAG_DEFAULT_MAXLENGTH).
@@ -52,7 +53,7 @@ enum FLASH_MSG_TYPE {
  * @param _max The maximum value for range inputs (default: HTML_INPUT_RANGE_DEFAULT_MAX).
  */
 void concat_input_html_tag(
-  char *_page,
+  PageWriter &_page,
   const char *_name,
   char *_value,
   int _maxlength = HTML_INPUT_TAG_DEFAULT_MAXLENGTH,
@@ -64,12 +65,12 @@ void concat_input_html_tag(
 );
 
 /**
- * @brief Appends an HTML table row with input fields to the provided buffer.
+ * @brief Appends an HTML table row with input fields to the provided page.
  *
  * Generates an HTML table row containing input fields with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the HTML table row is appended.
+ * @param _page The page to which the HTML table row is appended.
  * @param _label The label for the input field.
  * @param _name The name attribute of the input field.
  * @param _value The value attribute of the input field.
@@ -81,7 +82,7 @@ void concat_input_html_tag(
  * @param _max The maximum value for range inputs (default: HTML_INPUT_RANGE_DEFAULT_MAX).
  */
 void concat_tr_input_html_tags(
-  char *_page,
+  PageWriter &_page,
   const char *_label,
   const char *_name,
   char *_value,
@@ -94,12 +95,12 @@ void concat_tr_input_html_tags(
 );
 
 /**
- * @brief Appends an HTML table cell with input fields to the provided buffer.
+ * @brief Appends an HTML table cell with input fields to the provided page.
  *
  * Generates an HTML table cell containing input fields with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the HTML table cell is appended.
+ * @param _page The page to which the HTML table cell is appended.
  * @param _label The label for the input field.
  * @param _name The name attribute of the input field.
  * @param _value The value attribute of the input field.
@@ -111,7 +112,7 @@ void concat_tr_input_html_tags(
  * @param _max The maximum value for range inputs (default: HTML_INPUT_RANGE_DEFAULT_MAX).
  */
 void concat_td_input_html_tags(
-  char *_page,
+  PageWriter &_page,
   char *_label,
   char *_name,
   char *_value,
@@ -124,62 +125,62 @@ void concat_td_input_html_tags(
 );
 
 /**
- * @brief Appends a class attribute to the provided buffer.
+ * @brief Appends a class attribute to the provided page.
  *
- * Generates a class attribute and appends it to the provided buffer.
+ * Generates a class attribute and appends it to the provided page.
  *
- * @param _page The buffer to which the class attribute is appended.
+ * @param _page The page to which the class attribute is appended.
  * @param _class The class attribute value.
  */
-void concat_class_attribute(char *_page, const char *_class);
-void concat_class_attribute(char *_page, char *_class);
+void concat_class_attribute(PageWriter &_page, const char *_class);
+void concat_class_attribute(PageWriter &_page, char *_class);
 
 /**
- * @brief Appends a style attribute to the provided buffer.
+ * @brief Appends a style attribute to the provided page.
  *
- * Generates a style attribute and appends it to the provided buffer.
+ * Generates a style attribute and appends it to the provided page.
  *
- * @param _page The buffer to which the style attribute is appended.
+ * @param _page The page to which the style attribute is appended.
  * @param _style The style attribute value.
  */
-void concat_style_attribute(char *_page, const char *_style);
-void concat_style_attribute(char *_page, char *_style);
+void concat_style_attribute(PageWriter &_page, const char *_style);
+void concat_style_attribute(PageWriter &_page, char *_style);
 
 /**
- * @brief Appends an ID attribute to the provided buffer.
+ * @brief Appends an ID attribute to the provided page.
  *
- * Generates an ID attribute and appends it to the provided buffer.
+ * Generates an ID attribute and appends it to the provided page.
  *
- * @param _page The buffer to which the ID attribute is appended.
+ * @param _page The page to which the ID attribute is appended.
  * @param _id The ID attribute value.
  */
-void concat_id_attribute(char *_page, const char *_id);
-void concat_id_attribute(char *_page, char *_id);
+void concat_id_attribute(PageWriter &_page, const char *_id);
+void concat_id_attribute(PageWriter &_page, char *_id);
 
 /**
- * @brief Appends a colspan attribute to the provided buffer.
+ * @brief Appends a colspan attribute to the provided page.
  *
- * Generates a colspan attribute and appends it to the provided buffer.
+ * Generates a colspan attribute and appends it to the provided page.
  *
- * @param _page The buffer to which the colspan attribute is appended.
+ * @param _page The page to which the colspan attribute is appended.
  * @param _colspan The colspan attribute value.
  */
-void concat_colspan_attribute(char *_page, const char *_colspan);
+void concat_colspan_attribute(PageWriter &_page, const char *_colspan);
 
 /**
- * @brief Appends an HTML heading tag to the provided buffer.
+ * @brief Appends an HTML heading tag to the provided page.
  *
  * Generates an HTML heading tag with the specified attributes and appends it
- * to the provided buffer.
+ * to the provided page.
  *
- * @param _page The buffer to which the heading tag is appended.
+ * @param _page The page to which the heading tag is appended.
  * @param _heading The heading text.
  * @param _heading_level The level of the heading tag (default: 1).
  * @param _class_attr The class attribute for the heading tag (optional).
  * @param _style_attr The style attribute for the heading tag (optional).
  */
 void concat_heading_html_tag(
-  char *_page,
+  PageWriter &_page,
   const char *_heading,
   uint8_t _heading_level = 1,
   const char *_class_attr = nullptr,
@@ -187,12 +188,12 @@ void concat_heading_html_tag(
 );
 
 /**
- * @brief Appends an HTML select dropdown to the provided buffer.
+ * @brief Appends an HTML select dropdown to the provided page.
  *
  * Generates an HTML select dropdown with the specified options and appends it
- * to the provided buffer.
+ * to the provided page.
  *
- * @param _page The buffer to which the select dropdown is appended.
+ * @param _page The page to which the select dropdown is appended.
  * @param _name The name attribute of the select dropdown.
  * @param _options The array of options for the dropdown.
  * @param _size The number of options in the dropdown.
@@ -201,7 +202,7 @@ void concat_heading_html_tag(
  * @param _disabled Whether the dropdown is disabled (default: false).
  */
 void concat_select_html_tag(
-  char *_page,
+  PageWriter &_page,
   char *_name,
   const char **_options,
   int _size,
@@ -210,7 +211,7 @@ void concat_select_html_tag(
   bool _disabled = false
 );
 void concat_select_html_tag(
-  char *_page,
+  PageWriter &_page,
   const char *_name,
   const char **_options,
   int _size,
@@ -220,12 +221,12 @@ void concat_select_html_tag(
 );
 
 /**
- * @brief Appends an HTML table cell with select dropdowns to the provided buffer.
+ * @brief Appends an HTML table cell with select dropdowns to the provided page.
  *
  * Generates an HTML table cell containing select dropdowns with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the table cell is appended.
+ * @param _page The page to which the table cell is appended.
  * @param _label The label for the dropdown.
  * @param _name The name attribute of the dropdown.
  * @param _options The array of options for the dropdown.
@@ -235,7 +236,7 @@ void concat_select_html_tag(
  * @param _disabled Whether the dropdown is disabled (default: false).
  */
 void concat_td_select_html_tags(
-  char *_page,
+  PageWriter &_page,
   char *_label,
   char *_name,
   const char **_options,
@@ -245,7 +246,7 @@ void concat_td_select_html_tags(
   bool _disabled = false
 );
 void concat_td_select_html_tags(
-  char *_page,
+  PageWriter &_page,
   const char *_label,
   const char *_name,
   const char **_options,
@@ -256,12 +257,12 @@ void concat_td_select_html_tags(
 );
 
 /**
- * @brief Appends an HTML table row with select dropdowns to the provided buffer.
+ * @brief Appends an HTML table row with select dropdowns to the provided page.
  *
  * Generates an HTML table row containing select dropdowns with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the table row is appended.
+ * @param _page The page to which the table row is appended.
  * @param _label The label for the dropdown.
  * @param _name The name attribute of the dropdown.
  * @param _options The array of options for the dropdown.
@@ -271,7 +272,7 @@ void concat_td_select_html_tags(
  * @param _disabled Whether the dropdown is disabled (default: false).
  */
 void concat_tr_select_html_tags(
-  char *_page,
+  PageWriter &_page,
   char *_label,
   char *_name,
   const char **_options,
@@ -281,7 +282,7 @@ void concat_tr_select_html_tags(
   bool _disabled = false
 );
 void concat_tr_select_html_tags(
-  char *_page,
+  PageWriter &_page,
   const char *_label,
   const char *_name,
   const char **_options,
@@ -292,12 +293,12 @@ void concat_tr_select_html_tags(
 );
 
 /**
- * @brief Appends an HTML table head with select dropdowns to the provided buffer.
+ * @brief Appends an HTML table head with select dropdowns to the provided page.
  *
  * Generates an HTML table head containing select dropdowns with the specified
- * attributes and appends it to the provided buffer.
+ * attributes and appends it to the provided page.
  *
- * @param _page The buffer to which the table head is appended.
+ * @param _page The page to which the table head is appended.
  * @param _heading The heading text for the table head.
  * @param _header_level The level of the heading (default: 1).
  * @param _colspan_attr The colspan attribute for the table head (optional).
@@ -305,7 +306,7 @@ void concat_tr_select_html_tags(
  * @param _style_attr The style attribute for the table head (optional).
  */
 void concat_tr_heading_html_tags(
-  char *_page,
+  PageWriter &_page,
   const char *_heading,
   uint8_t _header_level = 1,
   const char *_colspan_attr = nullptr, 
@@ -314,44 +315,44 @@ void concat_tr_heading_html_tags(
 );
 
 /**
- * @brief Appends a flash message div to the provided buffer.
+ * @brief Appends a flash message div to the provided page.
  *
  * Generates an HTML div for displaying a flash message with the specified
- * status and appends it to the provided buffer.
+ * status and appends it to the provided page.
  *
- * @param _page The buffer to which the flash message div is appended.
+ * @param _page The page to which the flash message div is appended.
  * @param _message The message to display in the flash message.
  * @param _status The status of the flash message (e.g., ALERT_SUCCESS).
  */
-void concat_flash_message_div(char *_page, const char *_message, int _status);
-void concat_flash_message_div(char *_page, char *_message, int _status);
+void concat_flash_message_div(PageWriter &_page, const char *_message, int _status);
+void concat_flash_message_div(PageWriter &_page, char *_message, int _status);
 
 /**
- * @brief Appends a graph axis title div to the provided buffer.
+ * @brief Appends a graph axis title div to the provided page.
  *
  * Generates an HTML div for displaying a graph axis title and appends it to
- * the provided buffer.
+ * the provided page.
  *
- * @param _page The buffer to which the graph axis title div is appended.
+ * @param _page The page to which the graph axis title div is appended.
  * @param _title The title text for the graph axis.
  * @param _style The style attribute for the graph axis title (optional).
  */
-void concat_graph_axis_title_div(char *_page, char *_title, char *_style = "");
+void concat_graph_axis_title_div(PageWriter &_page, char *_title, char *_style = "");
 
 /**
- * @brief Appends an SVG element to the provided buffer.
+ * @brief Appends an SVG element to the provided page.
  *
  * Generates an SVG element with the specified attributes and appends it to
- * the provided buffer.
+ * the provided page.
  *
- * @param _page The buffer to which the SVG element is appended.
+ * @param _page The page to which the SVG element is appended.
  * @param _path The SVG path data.
  * @param _width The width of the SVG element (default: HTML_SVG_DEFAULT_WIDTH).
  * @param _height The height of the SVG element (default: HTML_SVG_DEFAULT_HEIGHT).
  * @param _fill The fill color of the SVG element (default: HTML_SVG_DEFAULT_FILL).
  */
 void concat_svg_tag(
-  char *_page,
+  PageWriter &_page,
   const char *_path,
   const char *_style = nullptr,
   const char *_viewbox = nullptr,
@@ -361,30 +362,30 @@ void concat_svg_tag(
 );
 
 /**
- * @brief Appends an SVG menu card to the provided buffer.
+ * @brief Appends an SVG menu card to the provided page.
  *
  * Generates an SVG menu card with the specified attributes and appends it to
- * the provided buffer.
+ * the provided page.
  *
- * @param _page The buffer to which the SVG menu card is appended.
+ * @param _page The page to which the SVG menu card is appended.
  * @param _menu_title The title of the menu card.
  * @param _svg_path The SVG path data for the menu card icon.
  * @param _menu_link The link associated with the menu card.
  */
 void concat_svg_menu_card(
-  char *_page,
+  PageWriter &_page,
   const char *_menu_title,
   const char *_svg_path,
   char *_menu_link
 );
 
 /**
- * @brief Appends an HTML table heading row to the provided buffer.
+ * @brief Appends an HTML table heading row to the provided page.
  *
  * Generates an HTML table heading row with the specified attributes and appends
- * it to the provided buffer.
+ * it to the provided page.
  *
- * @param _page The buffer to which the table heading row is appended.
+ * @param _page The page to which the table heading row is appended.
  * @param _headings The array of headings for the table row.
  * @param _size The number of headings in the row.
  * @param _row_class The class attribute for the table row (optional).
@@ -393,7 +394,7 @@ void concat_svg_menu_card(
  * @param _head_style The style attribute for the table headings (optional).
  */
 void concat_table_heading_row(
-  char *_page,
+  PageWriter &_page,
   char **_headings,
   int _size,
   const char *_row_class,
@@ -403,12 +404,12 @@ void concat_table_heading_row(
 );
 
 /**
- * @brief Appends an HTML table data row to the provided buffer.
+ * @brief Appends an HTML table data row to the provided page.
  *
  * Generates an HTML table data row with the specified attributes and appends
- * it to the provided buffer.
+ * it to the provided page.
  *
- * @param _page The buffer to which the table data row is appended.
+ * @param _page The page to which the table data row is appended.
  * @param _data_items The array of data items for the table row.
  * @param _size The number of data items in the row.
  * @param _row_class The class attribute for the table row (optional).
@@ -417,7 +418,7 @@ void concat_table_heading_row(
  * @param _data_style The style attribute for the table data cells (optional).
  */
 void concat_table_data_row(
-  char *_page,
+  PageWriter &_page,
   char **_data_items,
   int _size,
   const char *_row_class,
@@ -428,19 +429,19 @@ void concat_table_data_row(
 );
 
 /**
- * @brief Appends an HTML link element to the provided buffer.
+ * @brief Appends an HTML link element to the provided page.
  *
  * Generates an HTML link element with the specified attributes and appends
- * it to the provided buffer.
+ * it to the provided page.
  *
- * @param _page The buffer to which the link element is appended.
+ * @param _page The page to which the link element is appended.
  * @param _href The href attribute for the link.
  * @param _innerhtml The innerhtml part of link.
  * @param _class The class attribute for the link(optional).
  * @param _style The style attribute for the link(optional).
  */
 void concat_link_element(
-  char *_page,
+  PageWriter &_page,
   const char *_href,
   const char *_innerhtml,
   const char *_class = nullptr,
@@ -454,11 +455,11 @@ void concat_link_element(
  * the page buffer; this flushes a chunk between them, so the caller continues
  * with an empty buffer.
  *
- * @param _page The buffer to which the header is appended.
+ * @param _page The page to which the header is appended.
  * @param _wide Whether to widen the container above the mobile breakpoint,
  *              which suits a page showing a table or a dashboard.
  */
-void concat_header_html( char *_page, bool _wide = false );
+void concat_header_html( PageWriter &_page, bool _wide = false );
 
 /**
  * @brief Appends the csrf hidden input of the active session to a form.
@@ -467,9 +468,9 @@ void concat_header_html( char *_page, bool _wide = false );
  * otherwise the middleware rejects the submission. Appends nothing when the
  * request has no active session.
  *
- * @param _page The buffer to which the hidden input is appended.
+ * @param _page The page to which the hidden input is appended.
  */
-void concat_csrf_input_html_tag( char *_page );
+void concat_csrf_input_html_tag( PageWriter &_page );
 
 /**
  * @brief Returns the csrf token of the active session, or an empty string.
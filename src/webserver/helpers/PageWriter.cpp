@@ -0,0 +1,185 @@
+/******************************** Page Writer *********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+Author          : Suraj I.
+created Date    : 17th Oct 2026
+******************************************************************************/
+
+#include <config/Config.h>
+
+#if defined(ENABLE_HTTP_SERVER)
+
+#include "PageWriter.h"
+
+/**
+ * @brief Constructor for the `PageWriter` class. The chunk keeps one byte
+ * past its size for the NUL sendChunk() expects.
+ */
+PageWriter::PageWriter(iHttpServerInterface *_server) :
+  m_server(_server),
+  m_out(nullptr),
+  m_chunk(nullptr),
+  m_length(0),
+  m_written(0)
+{
+  m_chunk = pdiutil::safe_new_array<char>(PAGE_WRITER_CHUNK_SIZE + 1);
+  if( nullptr != m_chunk ){
+    m_chunk[0] = 0;
+  }
+}
+
+/**
+ * @brief Constructor for a `PageWriter` appending to a string.
+ */
+PageWriter::PageWriter(pdiutil::string &_out) :
+  m_server(nullptr),
+  m_out(&_out),
+  m_chunk(nullptr),
+  m_length(0),
+  m_written(0)
+{
+}
+
+/**
+ * @brief Destructor for the `PageWriter` class.
+ */
+PageWriter::~PageWriter(){
+
+  pdiutil::safe_delete_array(m_chunk);
+}
+
+/**
+ * @brief Sends the response header announcing a chunked body.
+ */
+void PageWriter::begin(int _code, mimetype_t _type){
+
+  if( nullptr != m_server ){
+    m_server->send(_code, _type, "", true);
+  }
+}
+
+/**
+ * @brief Appends text held in ram.
+ */
+PageWriter &PageWriter::append(const char *_text){
+
+  if( nullptr != _text ){
+    append(_text, strlen(_text));
+  }
+  return *this;
+}
+
+/**
+ * @brief Appends len bytes of text held in ram. text longer than the room
+ * left is split across chunks.
+ */
+PageWriter &PageWriter::append(const char *_text, uint32_t _len){
+
+  if( nullptr != m_out && nullptr != _text ){
+    m_out->append(_text, _len);
+    m_written += _len;
+    return *this;
+  }
+
+  if( nullptr == m_chunk || nullptr == _text ){
+    return *this;
+  }
+
+  while( _len > 0 ){
+
+    uint32_t _room = PAGE_WRITER_CHUNK_SIZE - m_length;
+    uint32_t _take = _len < _room ? _len : _room;
+
+    memcpy(m_chunk + m_length, _text, _take);
+    m_length += _take;
+    m_written += _take;
+    _text += _take;
+    _len -= _take;
+
+    if( PAGE_WRITER_CHUNK_SIZE == m_length ){
+      flush();
+    }
+  }
+  m_chunk[m_length] = 0;
+  return *this;
+}
+
+/**
+ * @brief Appends text held in flash, copied a chunk at a time.
+ */
+PageWriter &PageWriter::append_ro(const char *_text){
+
+  if( nullptr == _text ){
+    return *this;
+  }
+
+  uint32_t _len = strlen_ro(_text);
+
+  if( nullptr != m_out ){
+    char _part[32];
+    while( _len > 0 ){
+      uint32_t _take = _len < sizeof(_part) ? _len : sizeof(_part);
+      memcpy_ro(_part, _text, _take);
+      m_out->append(_part, _take);
+      m_written += _take;
+      _text += _take;
+      _len -= _take;
+    }
+    return *this;
+  }
+
+  if( nullptr == m_chunk ){
+    return *this;
+  }
+
+  while( _len > 0 ){
+
+    uint32_t _room = PAGE_WRITER_CHUNK_SIZE - m_length;
+    uint32_t _take = _len < _room ? _len : _room;
+
+    memcpy_ro(m_chunk + m_length, _text, _take);
+    m_length += _take;
+    m_written += _take;
+    _text += _take;
+    _len -= _take;
+
+    if( PAGE_WRITER_CHUNK_SIZE == m_length ){
+      flush();
+    }
+  }
+  m_chunk[m_length] = 0;
+  return *this;
+}
+
+/**
+ * @brief Sends what the chunk holds, if anything.
+ */
+void PageWriter::flush(){
+
+  if( nullptr == m_chunk || 0 == m_length ){
+    return;
+  }
+
+  m_chunk[m_length] = 0;
+  if( nullptr != m_server ){
+    m_server->sendChunk(m_chunk);
+  }
+  m_length = 0;
+  m_chunk[0] = 0;
+}
+
+/**
+ * @brief Flushes and ends the chunked response.
+ */
+void PageWriter::end(){
+
+  flush();
+  if( nullptr != m_server ){
+    m_server->sendChunk("");
+  }
+}
+
+#endif
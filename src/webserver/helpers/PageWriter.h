@@ -0,0 +1,106 @@
+/******************************** Page Writer *********************************
+This file is part of the PDI stack.
+
+This is free software. You can redistribute it and/or modify it but without any
+warranty.
+
+The `PageWriter` class builds an HTML page straight into a chunked response.
+It keeps one small chunk buffer and the length written into it, so every append
+is a copy to the end of what is there rather than a scan for it. Once the
+chunk is full it is sent to the client and reused, so a page of any size needs
+only one chunk of heap while it is built.
+
+Author          : Suraj I.
+Created Date    : 17th Oct 2026
+******************************************************************************/
+
+#ifndef _WEB_PAGE_WRITER_H_
+#define _WEB_PAGE_WRITER_H_
+
+#include <interface/pdi.h>
+
+/**
+ * @define PAGE_WRITER_CHUNK_SIZE
+ * @brief Bytes of page held before they are sent to the client as one chunk.
+ */
+#ifndef PAGE_WRITER_CHUNK_SIZE
+#define PAGE_WRITER_CHUNK_SIZE 1024
+#endif
+
+/**
+ * @class PageWriter
+ * @brief Appends page content to a chunk buffer flushed to the response.
+ *
+ * begin() sends the response header, the appends stream the body and end()
+ * sends what is left with the final empty chunk. Text read from flash is
+ * appended with append_ro(). A writer made on a string only appends to it.
+ */
+class PageWriter
+{
+public:
+  /**
+   * @brief Constructor for the `PageWriter` class.
+   * @param _server The server whose current client receives the page.
+   */
+  PageWriter(iHttpServerInterface *_server);
+
+  /**
+   * @brief Constructor for a `PageWriter` that appends to a string instead,
+   * for markup that goes into a json response. It needs no chunk buffer.
+   * @param _out The string the markup is appended to.
+   */
+  PageWriter(pdiutil::string &_out);
+
+  /**
+   * @brief Destructor for the `PageWriter` class. Frees the chunk buffer, the
+   * response is not ended here.
+   */
+  ~PageWriter();
+
+  /**
+   * @brief Whether the chunk buffer could be allocated.
+   */
+  bool ok() const { return nullptr != m_chunk || nullptr != m_out; }
+
+  /**
+   * @brief Sends the response header announcing a chunked body.
+   */
+  void begin(int _code, mimetype_t _type);
+
+  /**
+   * @brief Appends text held in ram.
+   */
+  PageWriter &append(const char *_text);
+  PageWriter &append(const char *_text, uint32_t _len);
+
+  /**
+   * @brief Appends text held in flash, see RODT_ATTR.
+   */
+  PageWriter &append_ro(const char *_text);
+
+  /**
+   * @brief Sends what the chunk holds, if anything.
+   */
+  void flush();
+
+  /**
+   * @brief Flushes and ends the chunked response.
+   */
+  void end();
+
+  /**
+   * @brief Bytes waiting in the chunk, and in total written to the page.
+   */
+  uint16_t length() const { return m_length; }
+  uint32_t written() const { return m_written; }
+
+protected:
+
+  iHttpServerInterface *m_server;
+  pdiutil::string *m_out;
+  char *m_chunk;
+  uint16_t m_length;
+  uint32_t m_written;
+};
+
+#endif
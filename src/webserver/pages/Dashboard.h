@@ -303,13 +303,20 @@ gi('gpl').setAttribute('points',q);\
 </script>";
 
 /**
- * @brief Poll loop. A response other than 200 means the session went away.
+ * @brief Sets the refresh period, in seconds, from DASHBOARD_EVENT_INTERVAL_MS.
+ */
+static const char WEB_SERVER_DASHBOARD_INTERVAL_TOP[] PROG_RODT_ATTR = "<script>GI=";
+static const char WEB_SERVER_DASHBOARD_INTERVAL_BOTTOM[] PROG_RODT_ATTR = "/1000;</script>";
+
+/**
+ * @brief Update loop. Sections pushed over the event stream are merged into
+ * one state which is drawn every period. Without the stream, or once it is
+ * refused, the page polls instead, where a response other than 200 means the
+ * session went away.
  */
 static const char WEB_SERVER_DASHBOARD_SCRIPT3[] PROG_RODT_ATTR = "\
 <script>\
-function rql(){\
-if(this.status!=200){location.href='/login';return;}\
-var r=JSON.parse(this.responseText);\
+function rnd(r){\
 rnw(r.w,r.nwt);\
 rfs(r.fs);\
 rmm(r);\
@@ -329,13 +336,31 @@ tr.insertCell().textContent=r.dv[i][0];\
 tr.insertCell().textContent=r.dv[i][1];\
 }\
 }\
+function rql(){\
+if(this.status!=200){location.href='/login';return;}\
+rnd(JSON.parse(this.responseText));\
+}\
 rq.addEventListener('load',rql);\
 function pol(){\
 rq.open('GET','/listen-dashboard');\
 rq.send();\
 }\
+function fbk(){\
 pol();\
 setInterval(pol,GI*1000);\
+}\
+var R={},es=window.EventSource?new EventSource('/dashboard-events'):null;\
+if(es){\
+es.onmessage=function(e){\
+var d=JSON.parse(e.data),f=!R.w;\
+for(var k in d)R[k]=d[k];\
+if(f)rnd(R);\
+};\
+es.onerror=function(){\
+if(es&&es.readyState==2){es=null;fbk();}\
+};\
+setInterval(function(){if(es&&R.w)rnd(R);},GI*1000);\
+}else fbk();\
 </script>";
 
 #endif
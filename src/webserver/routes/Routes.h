@@ -26,6 +26,7 @@ Created Date    : 1st June 2019
 #define WEB_SERVER_EMAIL_CONFIG_ROUTE "/email-config"     ///< Route for email configuration.
 #define WEB_SERVER_DASHBOARD_ROUTE "/dashboard"           ///< Route for the dashboard.
 #define WEB_SERVER_DASHBOARD_MONITOR_ROUTE "/listen-dashboard" ///< Route for dashboard monitoring.
+#define WEB_SERVER_DASHBOARD_EVENTS_ROUTE "/dashboard-events" ///< Route for the dashboard event stream.
 
 // GPIO-related routes
 #define WEB_SERVER_GPIO_MANAGE_CONFIG_ROUTE "/gpio-manage" ///< Route for GPIO management.
@@ -0,0 +1,78 @@
+/****************************** Alloc Counter *********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+
+#include "AllocCounter.h"
+#include <cstdlib>
+#include <new>
+
+static uint32_t s_allocations = 0;
+static uint64_t s_bytes = 0;
+
+static void *counted_alloc(size_t size)
+{
+    s_allocations++;
+    s_bytes += size;
+    return malloc(size ? size : 1);
+}
+
+void *operator new(size_t size)
+{
+    void *block = counted_alloc(size);
+    if (nullptr == block)
+    {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return counted_alloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return counted_alloc(size);
+}
+
+// every plain form of delete is replaced along with new, so the sanitizer never
+// sees its own delete release a block malloc handed out
+void operator delete(void *block) noexcept { free(block); }
+void operator delete[](void *block) noexcept { free(block); }
+void operator delete(void *block, size_t) noexcept { free(block); }
+void operator delete[](void *block, size_t) noexcept { free(block); }
+void operator delete(void *block, const std::nothrow_t &) noexcept { free(block); }
+void operator delete[](void *block, const std::nothrow_t &) noexcept { free(block); }
+
+namespace pditest
+{
+
+    void AllocCounter::reset()
+    {
+        m_allocations = s_allocations;
+        m_bytes = s_bytes;
+    }
+
+    uint32_t AllocCounter::allocations() const
+    {
+        return s_allocations - m_allocations;
+    }
+
+    uint64_t AllocCounter::bytes() const
+    {
+        return s_bytes - m_bytes;
+    }
+
+} // namespace pditest
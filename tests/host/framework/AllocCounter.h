@@ -0,0 +1,46 @@
+/****************************** Alloc Counter *********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+Counts the heap allocations a piece of code makes. The test binary replaces the
+global operator new with one that counts before handing over to malloc, which
+the sanitizers still watch, so the count covers the embedded stl allocator,
+callback holders and plain new alike.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+
+#ifndef _PDI_TEST_ALLOC_COUNTER_H_
+#define _PDI_TEST_ALLOC_COUNTER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pditest
+{
+
+    /**
+     * @brief Allocations made through operator new since the counter was
+     *        created or last reset.
+     */
+    class AllocCounter
+    {
+
+    public:
+        AllocCounter() { reset(); }
+
+        void reset();
+        uint32_t allocations() const;
+        uint64_t bytes() const;
+
+    private:
+        uint32_t m_allocations;
+        uint64_t m_bytes;
+    };
+
+} // namespace pditest
+
+#endif
@@ -9,6 +9,7 @@ created Date    : 16th Aug 2026
 ******************************************************************************/
 
 #include "pditest.h"
+#include <cstdarg>
 #include <cstdlib>
 #include <ctime>
 
@@ -55,6 +56,17 @@ namespace pditest
         }
     }
 
+    void note(const char *format, ...)
+    {
+        char line[256];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+
+        printf("  %s     %s%s\n", COLOR_DIM, line, COLOR_RESET);
+    }
+
     void describeBytes(char *buf, size_t size, const void *data, size_t len)
     {
         const uint8_t *bytes = (const uint8_t *)data;
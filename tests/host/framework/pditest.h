@@ -58,6 +58,12 @@ namespace pditest
         Registrar(TestCase *testcase) { registerTest(testcase); }
     };
 
+    /**
+     * @brief Print a measurement the running test wants on record, such as a
+     *        benchmark's count, dimmed above its result line.
+     */
+    void note(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
     /**
      * @brief Render a value into buf for a failure message. Falls back to a byte
      *        count for types that carry no obvious text form.
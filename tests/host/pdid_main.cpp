@@ -126,6 +126,7 @@ int main(int argc, char **argv)
         PdiStack.serve();
     }
 
+    __database.commit();
     if (nullptr != fsimagepath)
     {
         __i_storage.flush();
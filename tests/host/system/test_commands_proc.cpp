@@ -31,14 +31,14 @@ static pdiutil::task_id_t parkTask(const char *name, uint8_t owner = 0)
 }
 
 /**
- * A signalled or cleared task stops running at once but is unlinked later: the
- * scheduler walks one task per pass, so several passes are needed before the
- * slot is actually freed and the task leaves the ps listing.
+ * A signalled or cleared task stops running at once but is unlinked later, on
+ * a pass after the one that consumes the signal, so a few passes are needed
+ * before the slot is actually freed and the task leaves the ps listing.
  */
 static void reap()
 {
-    // one pass consumes signals only up to the task it decides to run, so the
-    // bound scales with how many tasks the rest of the suite has registered
+    // a pass breaks off when a callback asks for a rebase, so keep the bound
+    // generous against how many tasks the rest of the suite has registered
     for (uint16_t pass = 0; pass < (MAX_SCHEDULABLE_TASKS * 2) + 16; pass++)
     {
         __task_scheduler.run();
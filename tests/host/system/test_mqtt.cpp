@@ -0,0 +1,566 @@
+/******************************* MQTT Tests ***********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+The mqtt client against a broker stood up in the test on a loopback socket.
+The broker answers only what a test tells it to, so the window, the resends
+and the replay after a reboot are seen on the wire. The client is driven by
+hand, one MQTT_Task pass at a time, which makes a pass the unit the publish
+rate is measured in. QoS 1/2 publishes go through the spool file on the root
+filesystem, so these run in the system tier.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+
+#include <interface/pdi.h>
+#include <transports/mqtt/MqttClient.h>
+#include <transports/mqtt/MqttTemplate.h>
+#include <MountedStack.h>
+#include <pditest.h>
+#include <unistd.h>
+
+#if defined(ENABLE_MQTT_SERVICE) && defined(ENABLE_STORAGE_SERVICE)
+
+static const char *TOPIC = "pditest/spool";
+
+/**
+ * Wait for what the broker wrote to reach the client. A small write can sit
+ * out the client's delayed ack on the loopback, so a fixed pause is not enough.
+ */
+static void settle(TcpClientInterface &tcp, int32_t bytes = 1)
+{
+    for (int attempt = 0; attempt < 500 && tcp.available() < bytes; attempt++)
+    {
+        usleep(1000);
+    }
+}
+
+/**
+ * One packet as the broker saw it.
+ */
+struct packet_t
+{
+    uint8_t type;
+    uint8_t flags;
+    uint16_t msg_id;
+    pdiutil::string topic;
+    pdiutil::string payload;
+};
+
+/**
+ * The broker end of one client connection at a time.
+ */
+struct TestBroker
+{
+    TcpServerInterface server;
+    iClientInterface *peer;
+
+    TestBroker() : peer(nullptr) {}
+
+    ~TestBroker()
+    {
+        pdiutil::safe_delete(peer);
+        server.close();
+    }
+
+    bool listen()
+    {
+        return 0 == server.begin(0);
+    }
+
+    bool accept()
+    {
+        pdiutil::safe_delete(peer);
+        for (int attempt = 0; attempt < 200 && nullptr == peer; attempt++)
+        {
+            peer = server.accept();
+            usleep(1000);
+        }
+        return nullptr != peer;
+    }
+
+    bool readByte(uint8_t &byte)
+    {
+        for (int attempt = 0; attempt < 50; attempt++)
+        {
+            if (peer->available() > 0)
+            {
+                byte = peer->read();
+                return true;
+            }
+            usleep(1000);
+        }
+        return false;
+    }
+
+    /**
+     * The next whole packet, false when none arrives.
+     */
+    bool next(packet_t &packet, bool wait = true)
+    {
+        if (nullptr == peer || (!wait && peer->available() < 1))
+        {
+            return false;
+        }
+        uint8_t header = 0, byte = 0;
+        if (!readByte(header))
+        {
+            return false;
+        }
+        uint32_t length = 0, shift = 0;
+        do
+        {
+            if (!readByte(byte))
+            {
+                return false;
+            }
+            length |= (uint32_t)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        pdiutil::string body;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            if (!readByte(byte))
+            {
+                return false;
+            }
+            body += (char)byte;
+        }
+
+        packet.type = header >> 4;
+        packet.flags = header & 0x0f;
+        packet.msg_id = 0;
+        packet.topic.clear();
+        packet.payload.clear();
+        if (MQTT_MSG_TYPE_PUBLISH == packet.type)
+        {
+            uint16_t topic = ((uint8_t)body[0] << 8) | (uint8_t)body[1];
+            packet.topic = body.substr(2, topic);
+            size_t at = 2 + topic;
+            if (packet.flags & 0x06)
+            {
+                packet.msg_id = ((uint8_t)body[at] << 8) | (uint8_t)body[at + 1];
+                at += 2;
+            }
+            packet.payload = body.substr(at);
+        }
+        else if (length >= 2)
+        {
+            packet.msg_id = ((uint8_t)body[0] << 8) | (uint8_t)body[1];
+        }
+        return true;
+    }
+
+    void send(uint8_t header, uint16_t msg_id)
+    {
+        uint8_t bytes[4] = {header, 2, (uint8_t)(msg_id >> 8), (uint8_t)(msg_id & 0xff)};
+        peer->write(bytes, sizeof(bytes));
+    }
+
+    void connack()
+    {
+        uint8_t bytes[4] = {MQTT_MSG_TYPE_CONNACK << 4, 2, 0, 0};
+        peer->write(bytes, sizeof(bytes));
+    }
+};
+
+static void freshSpool()
+{
+    pditest::mountedVfs();
+    __i_fs.deleteFile(MQTT_SPOOL_FILE);
+    __i_fs.deleteFile(MQTT_SPOOL_FILE "~");
+}
+
+/**
+ * Brings the client up against the broker, up to the CONNECT it sends.
+ */
+static bool connectClient(MQTTClient &client, TcpClientInterface &tcp, TestBroker &broker)
+{
+    mqtt_general_config_table general;
+    mqtt_lwt_config_table lwt;
+    strcpy(general.host, "127.0.0.1");
+    general.port = broker.server.getBoundPort();
+    strcpy(general.client_id, "pditest");
+
+    packet_t connect;
+    return client.begin(&tcp, &general, &lwt) && broker.accept() &&
+           broker.next(connect) && MQTT_MSG_TYPE_CONNECT == connect.type;
+}
+
+static bool acceptClient(MQTTClient &client, TcpClientInterface &tcp, TestBroker &broker)
+{
+    broker.connack();
+    settle(tcp);
+    client.MQTT_Task();
+    return client.is_mqtt_connected();
+}
+
+static pdiutil::string message(int n)
+{
+    char text[16];
+    snprintf(text, sizeof(text), "m%04d", n);
+    return pdiutil::string(text);
+}
+
+static bool publish(MQTTClient &client, int n, uint8_t qos = 1)
+{
+    pdiutil::string text = message(n);
+    return client.Publish(TOPIC, text.c_str(), text.size(), qos, 0);
+}
+
+TEST(mqtt, a_window_of_publishes_goes_out_before_any_ack)
+{
+    freshSpool();
+    TestBroker broker;
+    ASSERT_TRUE(broker.listen());
+    TcpClientInterface tcp;
+    MQTTClient client;
+    ASSERT_TRUE(connectClient(client, tcp, broker));
+    ASSERT_TRUE(acceptClient(client, tcp, broker));
+
+    for (int n = 0; n < 2 * MQTT_INFLIGHT_WINDOW; n++)
+    {
+        ASSERT_TRUE(publish(client, n));
+    }
+    client.MQTT_Task();
+    ASSERT_EQ(client.inflight(), (uint8_t)MQTT_INFLIGHT_WINDOW);
+
+    packet_t sent[MQTT_INFLIGHT_WINDOW];
+    for (int n = 0; n < MQTT_INFLIGHT_WINDOW; n++)
+    {
+        ASSERT_TRUE(broker.next(sent[n]));
+        ASSERT_EQ(sent[n].type, (uint8_t)MQTT_MSG_TYPE_PUBLISH);
+        ASSERT_TRUE(sent[n].payload == message(n));
+        for (int k = 0; k < n; k++)
+        {
+            ASSERT_NE(sent[k].msg_id, sent[n].msg_id);
+        }
+    }
+    packet_t more;
+    ASSERT_FALSE(broker.next(more, false));
+
+    // one ack frees one slot, which the next publish takes
+    broker.send(MQTT_MSG_TYPE_PUBACK << 4, sent[0].msg_id);
+    settle(tcp);
+    client.MQTT_Task();
+    ASSERT_TRUE(broker.next(more));
+    ASSERT_TRUE(more.payload == message(MQTT_INFLIGHT_WINDOW));
+    ASSERT_EQ(client.stats().m_acked, (uint32_t)1);
+}
+
+TEST(mqtt, sustained_qos1_publishing_loses_nothing)
+{
+    freshSpool();
+    TestBroker broker;
+    ASSERT_TRUE(broker.listen());
+    TcpClientInterface tcp;
+    MQTTClient client;
+    ASSERT_TRUE(connectClient(client, tcp, broker));
+    ASSERT_TRUE(acceptClient(client, tcp, broker));
+
+    const int total = 400;
+    int published = 0, delivered = 0, duplicates = 0, outOfOrder = 0;
+    uint32_t passes = 0;
+
+    while (delivered < total && passes < (uint32_t)total * 2)
+    {
+        for (int k = 0; k < MQTT_INFLIGHT_WINDOW && published < total; k++)
+        {
+            ASSERT_TRUE(publish(client, published++));
+        }
+        client.MQTT_Task();
+        passes++;
+
+        packet_t packet;
+        int answered = 0;
+        while (broker.next(packet, false))
+        {
+            if (MQTT_MSG_TYPE_PUBLISH != packet.type)
+            {
+                continue;
+            }
+            if (packet.flags & 0x08)
+            {
+                duplicates++;
+            }
+            if (!(packet.payload == message(delivered)))
+            {
+                outOfOrder++;
+            }
+            delivered++;
+            answered++;
+            broker.send(MQTT_MSG_TYPE_PUBACK << 4, packet.msg_id);
+        }
+        if (answered > 0)
+        {
+            settle(tcp, 4 * answered);
+        }
+    }
+    // the last acks may still be on their way
+    for (int attempt = 0; attempt < 10 && client.stats().m_acked < (uint32_t)total; attempt++)
+    {
+        settle(tcp);
+        client.MQTT_Task();
+    }
+
+    ASSERT_EQ(delivered, total);
+    ASSERT_EQ(duplicates, 0);
+    ASSERT_EQ(outOfOrder, 0);
+    ASSERT_EQ(client.stats().m_acked, (uint32_t)total);
+    ASSERT_EQ(client.stats().m_dropped, (uint32_t)0);
+    ASSERT_EQ(client.inflight(), (uint8_t)0);
+    ASSERT_EQ(client.spooled(), (uint32_t)0);
+    // a pass carries a whole window, where one publish used to wait out a
+    // round trip to the broker before the next could go
+    ASSERT_LE(passes, (uint32_t)(total / MQTT_INFLIGHT_WINDOW + 2));
+}
+
+TEST(mqtt, a_publish_is_written_straight_into_the_packet)
+{
+    freshSpool();
+    TestBroker broker;
+    ASSERT_TRUE(broker.listen());
+    TcpClientInterface tcp;
+    MQTTClient client;
+    ASSERT_TRUE(connectClient(client, tcp, broker));
+    ASSERT_TRUE(acceptClient(client, tcp, broker));
+
+    MqttTemplate topic, payload;
+    const char *topicText = "dev/[mac]/state", *payloadText = "{\"at\":[epoch]}";
+    topic.compile(topicText, strlen(topicText));
+    payload.compile(payloadText, strlen(payloadText));
+    MqttSlotWriter slots = [](uint8_t slot, char *out, uint16_t size) -> int32_t {
+        const char *value = MQTT_SLOT_MAC == slot ? "a1b2c3" : "1700000000";
+        uint16_t len = strlen(value);
+        if (len > size)
+        {
+            return PDI_ERR_OVERFLOW;
+        }
+        memcpy(out, value, len);
+        return len;
+    };
+
+    for (uint8_t qos = 0; qos < 2; qos++)
+    {
+        ASSERT_TRUE(client.Publish(
+            [&](char *out, uint16_t size) -> int32_t { return topic.render(out, size, slots); },
+            [&](char *out, uint16_t size) -> int32_t { return payload.render(out, size, slots); },
+            qos, 0));
+        client.MQTT_Task();
+
+        packet_t sent;
+        ASSERT_TRUE(broker.next(sent));
+        ASSERT_EQ(sent.type, (uint8_t)MQTT_MSG_TYPE_PUBLISH);
+        ASSERT_STREQ(sent.topic.c_str(), "dev/a1b2c3/state");
+        ASSERT_STREQ(sent.payload.c_str(), "{\"at\":1700000000}");
+        if (qos > 0)
+        {
+            ASSERT_NE(sent.msg_id, (uint16_t)0);
+        }
+    }
+
+    // a topic that does not fit is no publish at all
+    ASSERT_FALSE(client.Publish(
+        [](char *out, uint16_t size) -> int32_t { return PDI_ERR_OVERFLOW; },
+        [](char *out, uint16_t size) -> int32_t { return 0; },
+        1, 0));
+}
+
+TEST(mqtt, an_unacknowledged_publish_goes_again_as_a_duplicate)
+{
+    freshSpool();
+    TestBroker broker;
+    ASSERT_TRUE(broker.listen());
+    TcpClientInterface tcp;
+    MQTTClient client;
+    ASSERT_TRUE(connectClient(client, tcp, broker));
+    ASSERT_TRUE(acceptClient(client, tcp, broker));
+
+    ASSERT_TRUE(publish(client, 7));
+    client.MQTT_Task();
+    packet_t first;
+    ASSERT_TRUE(broker.next(first));
+    ASSERT_EQ(first.flags & 0x08, 0);
+
+    for (int tick = 0; tick < MQTT_RETRY_INTERVAL; tick++)
+    {
+        client.mqtt_timer();
+    }
+    packet_t again;
+    ASSERT_TRUE(broker.next(again));
+    ASSERT_EQ(again.type, (uint8_t)MQTT_MSG_TYPE_PUBLISH);
+    ASSERT_EQ(again.msg_id, first.msg_id);
+    ASSERT_NE(again.flags & 0x08, 0);
+    ASSERT_TRUE(again.payload == message(7));
+    ASSERT_EQ(client.stats().m_retried, (uint32_t)1);
+
+    broker.send(MQTT_MSG_TYPE_PUBACK << 4, first.msg_id);
+    settle(tcp);
+    client.MQTT_Task();
+    ASSERT_EQ(client.inflight(), (uint8_t)0);
+}
+
+TEST(mqtt, qos2_holds_its_slot_until_pubcomp)
+{
+    freshSpool();
+    TestBroker broker;
+    ASSERT_TRUE(broker.listen());
+    TcpClientInterface tcp;
+    MQTTClient client;
+    ASSERT_TRUE(connectClient(client, tcp, broker));
+    ASSERT_TRUE(acceptClient(client, tcp, broker));
+
+    ASSERT_TRUE(publish(client, 2, 2));
+    client.MQTT_Task();
+    packet_t sent;
+    ASSERT_TRUE(broker.next(sent));
+    ASSERT_EQ((sent.flags >> 1) & 3, 2);
+
+    broker.send(MQTT_MSG_TYPE_PUBREC << 4, sent.msg_id);
+    settle(tcp);
+    client.MQTT_Task();
+    packet_t pubrel;
+    ASSERT_TRUE(broker.next(pubrel));
+    ASSERT_EQ(pubrel.type, (uint8_t)MQTT_MSG_TYPE_PUBREL);
+    ASSERT_EQ(pubrel.msg_id, sent.msg_id);
+    // the broker has the message, so the spool has let it go
+    ASSERT_EQ(client.spooled(), (uint32_t)0);
+    ASSERT_EQ(client.inflight(), (uint8_t)1);
+
+    broker.send(MQTT_MSG_TYPE_PUBCOMP << 4, sent.msg_id);
+    settle(tcp);
+    client.MQTT_Task();
+    ASSERT_EQ(client.inflight(), (uint8_t)0);
+    ASSERT_EQ(client.stats().m_acked, (uint32_t)1);
+}
+
+TEST(mqtt, unacknowledged_publishes_outlive_a_reboot_in_order)
+{
+    freshSpool();
+    TestBroker broker;
+    ASSERT_TRUE(broker.listen());
+
+    {
+        TcpClientInterface tcp;
+        MQTTClient client;
+        ASSERT_TRUE(connectClient(client, tcp, broker));
+        ASSERT_TRUE(acceptClient(client, tcp, broker));
+
+        for (int n = 0; n < 6; n++)
+        {
+            ASSERT_TRUE(publish(client, n));
+        }
+        client.MQTT_Task();
+        packet_t sent;
+        for (int n = 0; n < 2; n++)
+        {
+            ASSERT_TRUE(broker.next(sent));
+            broker.send(MQTT_MSG_TYPE_PUBACK << 4, sent.msg_id);
+        }
+        settle(tcp);
+        client.MQTT_Task();
+        ASSERT_EQ(client.stats().m_acked, (uint32_t)2);
+        ASSERT_EQ(client.stats().m_sent, (uint32_t)6);
+        // the client goes down with four publishes unanswered
+    }
+    ASSERT_TRUE(__i_fs.isFileExist(MQTT_SPOOL_FILE));
+
+    TcpClientInterface tcp;
+    MQTTClient client;
+    ASSERT_TRUE(connectClient(client, tcp, broker));
+    // made while the broker has not taken the client back yet
+    ASSERT_TRUE(publish(client, 6));
+    ASSERT_TRUE(acceptClient(client, tcp, broker));
+
+    for (int n = 2; n <= 6; n++)
+    {
+        packet_t sent;
+        ASSERT_TRUE(broker.next(sent));
+        ASSERT_EQ(sent.type, (uint8_t)MQTT_MSG_TYPE_PUBLISH);
+        ASSERT_TRUE(sent.payload == message(n));
+        broker.send(MQTT_MSG_TYPE_PUBACK << 4, sent.msg_id);
+        settle(tcp);
+        client.MQTT_Task();
+    }
+    ASSERT_EQ(client.spooled(), (uint32_t)0);
+    ASSERT_FALSE(__i_fs.isFileExist(MQTT_SPOOL_FILE));
+}
+
+TEST(mqtt, a_full_spool_refuses_until_the_broker_catches_up)
+{
+    freshSpool();
+    MqttSpool spool;
+    ASSERT_TRUE(spool.open(MQTT_SPOOL_FILE));
+
+    uint8_t record[100];
+    int pushed = 0;
+    for (;; pushed++)
+    {
+        memset(record, pushed & 0xff, sizeof(record));
+        if (!spool.push(record, sizeof(record)))
+        {
+            break;
+        }
+    }
+    ASSERT_GT(pushed, 0);
+    ASSERT_LE(spool.size(), (uint32_t)MQTT_SPOOL_MAX_SIZE);
+
+    // half of it reaches the broker, which makes room at the front
+    uint8_t read[MQTT_BUF_SIZE];
+    uint32_t offset = 0;
+    for (int n = 0; n < pushed / 2; n++)
+    {
+        ASSERT_EQ(spool.next(read, sizeof(read), offset), (uint16_t)sizeof(record));
+        ASSERT_EQ(read[0], (uint8_t)(n & 0xff));
+    }
+    spool.settle(spool.cursor());
+    memset(record, pushed & 0xff, sizeof(record));
+    ASSERT_TRUE(spool.push(record, sizeof(record)));
+
+    // a reopened spool starts from the first record the broker lacks
+    MqttSpool reopened;
+    ASSERT_TRUE(reopened.open(MQTT_SPOOL_FILE));
+    for (int n = pushed / 2; n <= pushed; n++)
+    {
+        ASSERT_EQ(reopened.next(read, sizeof(read), offset), (uint16_t)sizeof(record));
+        ASSERT_EQ(read[0], (uint8_t)(n & 0xff));
+    }
+    ASSERT_EQ(reopened.next(read, sizeof(read), offset), (uint16_t)0);
+    reopened.settle(reopened.cursor());
+    ASSERT_FALSE(__i_fs.isFileExist(MQTT_SPOOL_FILE));
+}
+
+
+TEST(mqtt, a_record_too_big_for_the_buffer_is_skipped_not_truncated)
+{
+    freshSpool();
+    MqttSpool spool;
+    ASSERT_TRUE(spool.open(MQTT_SPOOL_FILE));
+
+    uint8_t small[20];
+    uint8_t large[60];
+    memset(small, 1, sizeof(small));
+    ASSERT_TRUE(spool.push(small, sizeof(small)));
+    memset(large, 2, sizeof(large));
+    ASSERT_TRUE(spool.push(large, sizeof(large)));
+    memset(small, 3, sizeof(small));
+    ASSERT_TRUE(spool.push(small, sizeof(small)));
+
+    // the record after the oversized one is still handed out
+    uint8_t read[32];
+    uint32_t offset = 0;
+    ASSERT_EQ(spool.next(read, sizeof(read), offset), (uint16_t)sizeof(small));
+    ASSERT_EQ(read[0], (uint8_t)1);
+    ASSERT_EQ(spool.next(read, sizeof(read), offset), (uint16_t)sizeof(small));
+    ASSERT_EQ(read[0], (uint8_t)3);
+    ASSERT_EQ(spool.next(read, sizeof(read), offset), (uint16_t)0);
+
+    spool.settle(spool.cursor());
+    ASSERT_FALSE(__i_fs.isFileExist(MQTT_SPOOL_FILE));
+}
+
+#endif
@@ -0,0 +1,149 @@
+/****************************** Syslog Tests **********************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+The syslog sink queues a line and leaves the file to a scheduler task. These
+drive the sink directly and flush by hand, so what is under test is the ring,
+the batched appends and the rotation, not the scheduler's timing.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+
+#include <interface/pdi.h>
+#include <service_provider/network/SyslogServiceProvider.h>
+#include <MountedStack.h>
+#include <pditest.h>
+
+#ifdef ENABLE_SYSLOG_SERVICE
+
+static VfsDispatcher *mountedVfs()
+{
+    return pditest::mountedVfs();
+}
+
+static pdiutil::string slurp(VfsDispatcher *fs, const char *path)
+{
+    pdiutil::string out;
+    fs->readFile(path, 64, [&out](char *chunk, uint32_t len) {
+        out.append(chunk, len);
+        return true;
+    });
+    return out;
+}
+
+static void removeLogs(VfsDispatcher *fs, const char *path)
+{
+    __syslog_service.flush();
+    fs->deleteFile(path);
+    for (int k = 1; k <= SYSLOG_ROTATE_COUNT + 1; k++)
+    {
+        pdiutil::string rotated = pdiutil::string(path) + "." + pdiutil::to_string(k);
+        fs->deleteFile(rotated.c_str());
+    }
+}
+
+TEST(syslog, a_line_waits_in_the_ring_not_on_the_file)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeLogs(fs, SYSLOG_FILE_INFO);
+
+    __i_storage.clearCounters();
+    __syslog_service.handleLine(INFO_LOG, "queued first\n", 13);
+    __syslog_service.handleLine(INFO_LOG, "queued second", 13);
+    ASSERT_EQ(__i_storage.getReadCount(), (uint32_t)0);
+    ASSERT_EQ(__i_storage.getWriteCount(), (uint32_t)0);
+    ASSERT_GT(__syslog_service.pending(), (uint32_t)0);
+
+    __syslog_service.flush();
+    ASSERT_EQ(__syslog_service.pending(), (uint32_t)0);
+    pdiutil::string log = slurp(fs, SYSLOG_FILE_INFO);
+    ASSERT_NE(log.find("queued first\n"), pdiutil::string::npos);
+    ASSERT_NE(log.find("queued second\n"), pdiutil::string::npos);
+}
+
+TEST(syslog, each_line_of_an_entry_is_stamped)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeLogs(fs, SYSLOG_FILE_ERROR);
+
+    __syslog_service.handleLine(ERROR_LOG, "top\nbottom\n", 11);
+    __syslog_service.flush();
+
+    pdiutil::string log = slurp(fs, SYSLOG_FILE_ERROR);
+    size_t top = log.find("top\n");
+    size_t bottom = log.find("bottom\n");
+    ASSERT_NE(top, pdiutil::string::npos);
+    ASSERT_NE(bottom, pdiutil::string::npos);
+    // the stamp sits between the two
+    ASSERT_GT(bottom, top + 4);
+}
+
+TEST(syslog, a_full_ring_drops_and_counts_what_it_drops)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeLogs(fs, SYSLOG_FILE_SUCCESS);
+
+    char line[100];
+    memset(line, 'd', sizeof(line));
+    syslog_stats_t before = __syslog_service.stats();
+    uint32_t lines = (SYSLOG_RING_SIZE / sizeof(line)) + 4;
+    for (uint32_t i = 0; i < lines; i++)
+    {
+        __syslog_service.handleLine(SUCCESS_LOG, line, sizeof(line));
+    }
+    syslog_stats_t full = __syslog_service.stats();
+    ASSERT_GT(full.m_dropped, before.m_dropped);
+    ASSERT_EQ((full.m_queued - before.m_queued) + (full.m_dropped - before.m_dropped), lines);
+
+    __syslog_service.flush();
+    syslog_stats_t after = __syslog_service.stats();
+    ASSERT_EQ(after.m_written - before.m_written, full.m_queued - before.m_queued);
+    ASSERT_EQ(after.m_failed, before.m_failed);
+}
+
+TEST(syslog, a_full_file_rotates_to_numbered_generations)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeLogs(fs, SYSLOG_FILE_WARNING);
+
+    char line[120];
+    memset(line, 'r', sizeof(line));
+    line[sizeof(line) - 1] = '\n';
+    uint32_t rotations = __syslog_service.stats().m_rotations;
+    uint32_t lines = (SYSLOG_FILE_MAX_SIZE / sizeof(line)) * (SYSLOG_ROTATE_COUNT + 2);
+    for (uint32_t i = 0; i < lines; i++)
+    {
+        __syslog_service.handleLine(WARNING_LOG, line, sizeof(line));
+        if (0 == (i % 4)) __syslog_service.flush();
+    }
+    __syslog_service.flush();
+
+    ASSERT_GE(__syslog_service.stats().m_rotations - rotations, (uint32_t)(SYSLOG_ROTATE_COUNT + 1));
+    ASSERT_LE(fs->getFileSize(SYSLOG_FILE_WARNING), (int64_t)SYSLOG_FILE_MAX_SIZE);
+    for (int k = 1; k <= SYSLOG_ROTATE_COUNT; k++)
+    {
+        pdiutil::string rotated = pdiutil::string(SYSLOG_FILE_WARNING) + "." + pdiutil::to_string(k);
+        int64_t size = fs->getFileSize(rotated.c_str());
+        ASSERT_GT(size, (int64_t)0);
+        ASSERT_LE(size, (int64_t)SYSLOG_FILE_MAX_SIZE);
+    }
+    pdiutil::string beyond = pdiutil::string(SYSLOG_FILE_WARNING) + "." + pdiutil::to_string(SYSLOG_ROTATE_COUNT + 1);
+    ASSERT_FALSE(fs->isFileExist(beyond.c_str()));
+    removeLogs(fs, SYSLOG_FILE_WARNING);
+}
+
+TEST(syslog, proc_reports_the_counters)
+{
+    VfsDispatcher *fs = mountedVfs();
+    ASSERT_TRUE(fs->isFileExist("/proc/syslog"));
+
+    pdiutil::string stats = slurp(fs, "/proc/syslog");
+    pdiutil::string dropped = "dropped " + pdiutil::to_string((int32_t)__syslog_service.stats().m_dropped) + "\n";
+    ASSERT_NE(stats.find(dropped), pdiutil::string::npos);
+    ASSERT_NE(stats.find("pending "), pdiutil::string::npos);
+}
+
+#endif
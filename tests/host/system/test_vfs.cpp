@@ -583,6 +583,145 @@ TEST(tmpfs, filling_it_leaves_the_root_filesystem_alone)
     fs->deleteFile("/tmp/bulk.txt");
 }
 
+TEST(tmpfs, appends_across_chunks_read_back_in_order)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/grown.txt");
+
+    pdiutil::string expected(37 * 60, ' ');
+    for (uint32_t i = 0; i < expected.length(); i++)
+    {
+        expected[i] = (char)('a' + i % 26);
+    }
+    ASSERT_GE(fs->createFile("/tmp/grown.txt", ""), 0);
+    for (uint32_t at = 0; at < expected.length(); at += 37)
+    {
+        ASSERT_EQ(fs->writeFile("/tmp/grown.txt", expected.c_str() + at, 37, true), 37);
+    }
+
+    ASSERT_EQ(fs->getFileSize("/tmp/grown.txt"), (int64_t)expected.length());
+    ASSERT_TRUE(slurp(fs, "/tmp/grown.txt") == expected);
+
+    // pieces that straddle two chunks still come whole
+    uint32_t pieces = 0;
+    bool whole = true;
+    fs->readFile("/tmp/grown.txt", 100, [&](char *, uint32_t len) {
+        whole = whole && (len == 100 || pieces == expected.length() / 100);
+        pieces++;
+        return true;
+    });
+    ASSERT_TRUE(whole);
+    ASSERT_EQ(pieces, (uint32_t)((expected.length() + 99) / 100));
+
+    fs->deleteFile("/tmp/grown.txt");
+}
+
+TEST(tmpfs, a_rewrite_gives_the_budget_back)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/shrunk.txt");
+    uint64_t before = __i_tmpfs.getUsedSize();
+
+    pdiutil::string payload(3000, 'z');
+    ASSERT_GE(fs->createFile("/tmp/shrunk.txt", payload.c_str()), 0);
+    ASSERT_EQ(__i_tmpfs.getUsedSize(), before + 3000);
+
+    ASSERT_EQ(fs->writeFile("/tmp/shrunk.txt", "tiny", 4), 4);
+    ASSERT_EQ(__i_tmpfs.getUsedSize(), before + 4);
+    ASSERT_STREQ(slurp(fs, "/tmp/shrunk.txt").c_str(), "tiny");
+
+    fs->deleteFile("/tmp/shrunk.txt");
+    ASSERT_EQ(__i_tmpfs.getUsedSize(), before);
+}
+
+TEST(tmpfs, an_edit_past_the_end_leaves_zeros_in_the_gap)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/gap.bin");
+    fs->createFile("/tmp/gap.bin", "ab");
+
+    ASSERT_EQ(fs->editFile("/tmp/gap.bin", TMPFS_CHUNK_SIZE + 10, "yz", 2), 2);
+    pdiutil::string got = slurp(fs, "/tmp/gap.bin");
+    ASSERT_EQ(got.length(), (size_t)(TMPFS_CHUNK_SIZE + 12));
+    ASSERT_EQ(got[0], 'a');
+    ASSERT_EQ(got[2], '\0');
+    ASSERT_EQ(got[TMPFS_CHUNK_SIZE + 9], '\0');
+    ASSERT_EQ(got[TMPFS_CHUNK_SIZE + 11], 'z');
+
+    fs->deleteFile("/tmp/gap.bin");
+}
+
+TEST(tmpfs, a_renamed_directory_takes_its_tree_along)
+{
+    VfsDispatcher *fs = mountedVfs();
+
+    ASSERT_EQ(fs->createDirectory("/tmp/outer"), (pdi_err_t)0);
+    ASSERT_EQ(fs->createDirectory("/tmp/outer/inner"), (pdi_err_t)0);
+    ASSERT_GE(fs->createFile("/tmp/outer/inner/leaf.txt", "deep"), 0);
+
+    ASSERT_EQ(fs->rename("/tmp/outer", "/tmp/moved"), (pdi_err_t)0);
+    ASSERT_FALSE(fs->isDirExist("/tmp/outer"));
+    ASSERT_TRUE(fs->isDirExist("/tmp/moved/inner"));
+    ASSERT_STREQ(slurp(fs, "/tmp/moved/inner/leaf.txt").c_str(), "deep");
+
+    pdiutil::vector<file_info_t> items;
+    ASSERT_EQ(fs->getDirFileList("/tmp/moved", items), 1);
+    ASSERT_STREQ(items[0].m_name, "inner");
+    delete[] items[0].m_name;
+
+    ASSERT_EQ(fs->rename("/tmp/moved", "/tmp/moved/inner/loop"), (pdi_err_t)STORAGE_ERROR_BAD_PATH);
+    ASSERT_EQ(fs->createFile("/tmp/moved/inner/leaf.txt/x", "no"), (int)STORAGE_ERROR_NO_PARENT);
+
+    ASSERT_EQ(fs->deleteDirectory("/tmp/moved"), (pdi_err_t)0);
+    ASSERT_FALSE(fs->isFileExist("/tmp/moved/inner/leaf.txt"));
+    ASSERT_EQ(fs->createDirectory("/tmp/moved"), (pdi_err_t)0);
+    ASSERT_FALSE(fs->isDirExist("/tmp/moved/inner"));
+    fs->deleteDirectory("/tmp/moved");
+}
+
+TEST(tmpfs, a_listing_keeps_the_order_entries_were_made)
+{
+    VfsDispatcher *fs = mountedVfs();
+    ASSERT_EQ(fs->createDirectory("/tmp/order"), (pdi_err_t)0);
+    const char *names[] = {"c", "a", "b", "d"};
+    char path[32];
+    for (const char *name : names)
+    {
+        snprintf(path, sizeof(path), "/tmp/order/%s", name);
+        ASSERT_GE(fs->createFile(path, name), 0);
+    }
+    fs->deleteFile("/tmp/order/a");
+
+    pdiutil::vector<file_info_t> items;
+    ASSERT_EQ(fs->getDirFileList("/tmp/order", items), 3);
+    ASSERT_STREQ(items[0].m_name, "c");
+    ASSERT_STREQ(items[1].m_name, "b");
+    ASSERT_STREQ(items[2].m_name, "d");
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        delete[] items[i].m_name;
+    }
+    fs->deleteDirectory("/tmp/order");
+}
+
+TEST(tmpfs, a_handle_to_a_deleted_file_stays_gone_when_its_slot_is_reused)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/first.txt");
+    removeIfPresent(fs, "/tmp/second.txt");
+    fs->createFile("/tmp/first.txt", "first");
+
+    int16_t fd = __i_tmpfs.openFile("/first.txt", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    fs->deleteFile("/tmp/first.txt");
+    fs->createFile("/tmp/second.txt", "second");
+
+    char buf[8];
+    ASSERT_EQ(__i_tmpfs.readHandle(fd, buf, sizeof(buf)), (int32_t)PDI_ERR_NOT_FOUND);
+    __i_tmpfs.closeFile(fd);
+    fs->deleteFile("/tmp/second.txt");
+}
+
 /* ------------------------------------------------------------- cross mount */
 
 TEST(vfs, a_file_copies_from_the_flash_to_memory)
@@ -853,3 +992,291 @@ TEST(vfsperm, ending_a_scope_that_never_began_does_not_underflow)
     fs->endPrivileged();
     ASSERT_FALSE(fs->isPrivileged());
 }
+
+/* ----------------------------------------------------------------- handles */
+
+TEST(vfshandle, small_writes_are_held_until_close)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/held.txt");
+
+    int16_t fd = fs->openFile("/held.txt", FILE_OPEN_WRITE | FILE_OPEN_CREATE | FILE_OPEN_TRUNC);
+    ASSERT_GE(fd, 0);
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(fs->writeHandle(fd, "line\n", 5), 5);
+    }
+    ASSERT_EQ(fs->getFileSize("/held.txt"), (int64_t)0);
+    ASSERT_EQ(fs->closeFile(fd), (pdi_err_t)PDI_OK);
+
+    ASSERT_EQ(fs->getFileSize("/held.txt"), (int64_t)50);
+    fs->deleteFile("/held.txt");
+}
+
+TEST(vfshandle, small_reads_come_back_in_order)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/pieces.txt");
+    pdiutil::string content;
+    for (int i = 0; i < 600; i++)
+    {
+        content += (char)('0' + (i % 10));
+    }
+    fs->createFile("/pieces.txt", content.c_str());
+
+    pdiutil::string back;
+    char buf[7];
+    int32_t n;
+    int16_t fd = fs->openFile("/pieces.txt", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    while ((n = fs->readHandle(fd, buf, sizeof(buf))) > 0)
+    {
+        back.append(buf, n);
+    }
+    fs->closeFile(fd);
+
+    ASSERT_STREQ(back.c_str(), content.c_str());
+    fs->deleteFile("/pieces.txt");
+}
+
+TEST(vfshandle, a_seek_inside_the_read_ahead_reports_the_caller_position)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/ahead.txt");
+    fs->createFile("/ahead.txt", "abcdefghijklmnopqrstuvwxyz");
+
+    char buf[4] = {0};
+    int16_t fd = fs->openFile("/ahead.txt", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->readHandle(fd, buf, 2), 2);
+    ASSERT_EQ(fs->seekHandle(fd, 3, FILE_SEEK_CUR), (int64_t)5);
+    ASSERT_EQ(fs->readHandle(fd, buf, 1), 1);
+    ASSERT_EQ(buf[0], 'f');
+    ASSERT_EQ(fs->seekHandle(fd, 0), (int64_t)0);
+    ASSERT_EQ(fs->readHandle(fd, buf, 1), 1);
+    ASSERT_EQ(buf[0], 'a');
+    fs->closeFile(fd);
+
+    fs->deleteFile("/ahead.txt");
+}
+
+TEST(vfshandle, a_read_after_a_write_sees_it)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/both.txt");
+
+    char buf[8] = {0};
+    int16_t fd = fs->openFile("/both.txt", FILE_OPEN_READ | FILE_OPEN_WRITE | FILE_OPEN_CREATE);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->writeHandle(fd, "written", 7), 7);
+    ASSERT_EQ(fs->seekHandle(fd, 0), (int64_t)0);
+    ASSERT_EQ(fs->readHandle(fd, buf, 7), 7);
+    ASSERT_STREQ(buf, "written");
+    fs->closeFile(fd);
+
+    fs->deleteFile("/both.txt");
+}
+
+TEST(vfshandle, a_tmpfs_file_streams_through_a_handle)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/stream.txt");
+
+    int16_t fd = fs->openFile("/tmp/stream.txt", FILE_OPEN_WRITE | FILE_OPEN_CREATE);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->writeHandle(fd, "in ", 3), 3);
+    ASSERT_EQ(fs->writeHandle(fd, "memory", 6), 6);
+    ASSERT_EQ(fs->closeFile(fd), (pdi_err_t)PDI_OK);
+    ASSERT_STREQ(slurp(fs, "/tmp/stream.txt").c_str(), "in memory");
+
+    fd = fs->openFile("/tmp/stream.txt", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->seekHandle(fd, 0, FILE_SEEK_END), (int64_t)9);
+    fs->closeFile(fd);
+
+    fs->deleteFile("/tmp/stream.txt");
+}
+
+TEST(vfshandle, an_exclusive_create_of_an_existing_tmpfs_file_is_refused)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/there.txt");
+    fs->createFile("/tmp/there.txt", "x");
+
+    ASSERT_EQ(fs->openFile("/tmp/there.txt", FILE_OPEN_WRITE | FILE_OPEN_CREATE | FILE_OPEN_EXCL), (int16_t)PDI_ERR_EXISTS);
+
+    fs->deleteFile("/tmp/there.txt");
+}
+
+TEST(vfshandle, a_procfs_node_reads_as_one_snapshot)
+{
+    VfsDispatcher *fs = mountedVfs();
+
+    pdiutil::string back;
+    char buf[5];
+    int32_t n;
+    int16_t fd = fs->openFile("/proc/version", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    while ((n = fs->readHandle(fd, buf, sizeof(buf))) > 0)
+    {
+        back.append(buf, n);
+    }
+    fs->closeFile(fd);
+
+    ASSERT_STREQ(back.c_str(), slurp(fs, "/proc/version").c_str());
+}
+
+TEST(vfshandle, a_procfs_node_refuses_to_open_for_writing)
+{
+    VfsDispatcher *fs = mountedVfs();
+
+    ASSERT_EQ(fs->openFile("/proc/uptime", FILE_OPEN_WRITE), (int16_t)STORAGE_ERROR_READ_ONLY);
+}
+
+TEST(vfshandle, a_sysfs_write_is_applied_at_close)
+{
+    VfsDispatcher *fs = mountedVfs();
+
+    int16_t fd = fs->openFile("/sys/class/gpio/4/mode", FILE_OPEN_WRITE | FILE_OPEN_TRUNC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->writeHandle(fd, "1", 1), 1);
+    ASSERT_EQ(fs->closeFile(fd), (pdi_err_t)PDI_OK);
+}
+
+TEST(vfshandle, a_devfs_stream_ends)
+{
+    VfsDispatcher *fs = mountedVfs();
+
+    uint32_t total = 0;
+    char buf[16];
+    int32_t n;
+    int16_t fd = fs->openFile("/dev/zero", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    while ((n = fs->readHandle(fd, buf, sizeof(buf))) > 0)
+    {
+        total += n;
+    }
+    fs->closeFile(fd);
+
+    ASSERT_EQ(total, (uint32_t)DEVFS_STREAM_READ_MAX);
+}
+
+TEST(vfshandle, a_handle_opened_for_writing_refuses_a_read)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/wo.txt");
+
+    char c;
+    int16_t fd = fs->openFile("/tmp/wo.txt", FILE_OPEN_WRITE | FILE_OPEN_CREATE);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->readHandle(fd, &c, 1), (int32_t)PDI_ERR_PERM);
+    fs->closeFile(fd);
+
+    fs->deleteFile("/tmp/wo.txt");
+}
+
+TEST(vfshandle, open_needs_at_least_one_access_flag)
+{
+    VfsDispatcher *fs = mountedVfs();
+
+    ASSERT_EQ(fs->openFile("/proc/version", 0), (int16_t)PDI_ERR_INVALID_ARG);
+}
+
+TEST(vfshandle, the_table_refuses_one_past_its_size)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/shared.txt");
+    fs->createFile("/tmp/shared.txt", "x");
+
+    int16_t fds[VFS_MAX_OPEN_FILES];
+    for (int i = 0; i < VFS_MAX_OPEN_FILES; i++)
+    {
+        fds[i] = fs->openFile("/tmp/shared.txt", FILE_OPEN_READ);
+        ASSERT_GE(fds[i], 0);
+    }
+    ASSERT_EQ(fs->openFile("/tmp/shared.txt", FILE_OPEN_READ), (int16_t)PDI_ERR_FULL);
+    for (int i = 0; i < VFS_MAX_OPEN_FILES; i++)
+    {
+        fs->closeFile(fds[i]);
+    }
+
+    fs->deleteFile("/tmp/shared.txt");
+}
+
+TEST(vfshandle, a_copy_out_of_devfs_stops_at_the_stream_cap)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/zeros.bin");
+
+    ASSERT_EQ(fs->copyFile("/dev/zero", "/tmp/zeros.bin"), (pdi_err_t)0);
+    ASSERT_EQ(fs->getFileSize("/tmp/zeros.bin"), (int64_t)DEVFS_STREAM_READ_MAX);
+
+    fs->deleteFile("/tmp/zeros.bin");
+}
+
+TEST(vfsperm, another_user_is_refused_at_open)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/sealed.txt");
+    fs->createFile("/sealed.txt", "not for you");
+    fs->setFileOwner("/sealed.txt", 5, 5);
+    fs->setFilePermissions("/sealed.txt", 0600);
+
+    {
+        ScopedSession stranger(7, 7);
+        ASSERT_EQ(fs->openFile("/sealed.txt", FILE_OPEN_READ), (int16_t)PDI_ERR_PERM);
+    }
+
+    fs->deleteFile("/sealed.txt");
+}
+
+/* -------------------------------------------------------------------- copy */
+
+TEST(vfscopy, a_large_file_crosses_mounts_intact)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/tmp/large.bin");
+    removeIfPresent(fs, "/large.bin");
+    pdiutil::string content;
+    for (int i = 0; i < 3000; i++)
+    {
+        content += (char)('A' + (i % 23));
+    }
+    fs->createFile("/tmp/large.bin", content.c_str());
+
+    ASSERT_EQ(fs->copyFile("/tmp/large.bin", "/large.bin"), (pdi_err_t)0);
+    ASSERT_STREQ(slurp(fs, "/large.bin").c_str(), content.c_str());
+
+    fs->deleteFile("/tmp/large.bin");
+    fs->deleteFile("/large.bin");
+}
+
+TEST(vfscopy, a_stopped_cross_mount_move_keeps_the_source)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/staying.txt");
+    removeIfPresent(fs, "/tmp/staying.txt");
+    fs->createFile("/staying.txt", "not going anywhere");
+
+    ASSERT_EQ(fs->moveFile("/staying.txt", "/tmp/staying.txt", [](uint64_t, uint64_t) { return false; }), (pdi_err_t)PDI_ERR_ABORTED);
+    ASSERT_TRUE(fs->isFileExist("/staying.txt"));
+    ASSERT_FALSE(fs->isFileExist("/tmp/staying.txt"));
+
+    fs->deleteFile("/staying.txt");
+}
+
+TEST(vfscopy, a_move_within_a_mount_is_a_rename_and_copies_nothing)
+{
+    VfsDispatcher *fs = mountedVfs();
+    removeIfPresent(fs, "/here.txt");
+    removeIfPresent(fs, "/there.txt");
+    fs->createFile("/here.txt", "renamed in place");
+
+    uint32_t blocks = 0;
+    ASSERT_EQ(fs->moveFile("/here.txt", "/there.txt", [&blocks](uint64_t, uint64_t) { blocks++; return true; }), (pdi_err_t)0);
+    ASSERT_EQ(blocks, (uint32_t)0);
+    ASSERT_FALSE(fs->isFileExist("/here.txt"));
+    ASSERT_STREQ(slurp(fs, "/there.txt").c_str(), "renamed in place");
+
+    fs->deleteFile("/there.txt");
+}
@@ -10,6 +10,11 @@ created Date    : 16th Aug 2026
 
 #include <pditest.h>
 #include <utility/Database.h>
+#include <database/core/DatabaseTable.h>
+#include <interface/pdi.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /**
  * A table that records whether the engine booted and cleared it.
@@ -274,3 +279,288 @@ TEST(database, the_instance_registry_is_capped_at_max_tables)
 {
     ASSERT_LE(DatabaseTableAbstractLayer::m_total_instances, (int)MAX_TABLES);
 }
+
+/**
+ * A run of bytes saved near the top of the store, clear of every real table.
+ */
+struct DirtyProbe
+{
+    uint8_t bytes[8];
+
+    explicit DirtyProbe(uint8_t seed = 0)
+    {
+        for (uint8_t i = 0; i < sizeof(bytes); i++)
+        {
+            bytes[i] = (uint8_t)(seed + i);
+        }
+    }
+};
+
+static uint16_t probeAddress()
+{
+    return (uint16_t)(__i_db.getMaxDBSize() - 64);
+}
+
+static std::string backingPath()
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/pdi_db_test_%d.bin", (int)getpid());
+    return std::string(path);
+}
+
+/**
+ * Puts the shared store back the way the rest of the suite expects it: zeroed
+ * at the probe, nothing pending and no file behind it.
+ */
+static void resetStore()
+{
+    __i_db.detachBackingFile();
+    DirtyProbe zero;
+    memset(zero.bytes, 0, sizeof(zero.bytes));
+    __i_db.saveConfig(probeAddress(), &zero);
+    __i_db.saveConfig((uint16_t)(probeAddress() + 32), &zero);
+    __database.commit();
+
+    std::string path = backingPath();
+    remove(path.c_str());
+    remove((path + ".jnl").c_str());
+    rmdir(path.c_str());
+}
+
+static int fileByte(const std::string &path, long offset)
+{
+    FILE *f = fopen(path.c_str(), "rb");
+    if (nullptr == f)
+    {
+        return -1;
+    }
+    int value = (0 == fseek(f, offset, SEEK_SET)) ? fgetc(f) : -1;
+    fclose(f);
+    return value;
+}
+
+static void setFileByte(const std::string &path, long offset, uint8_t value)
+{
+    FILE *f = fopen(path.c_str(), "r+b");
+    if (nullptr != f)
+    {
+        fseek(f, offset, SEEK_SET);
+        fputc(value, f);
+        fclose(f);
+    }
+}
+
+TEST(database, a_save_only_marks_the_bytes_it_changed)
+{
+    resetStore();
+
+    DirtyProbe probe(1);
+    probe.bytes[0] = 0;
+    __i_db.saveConfig(probeAddress(), &probe);
+
+    ASSERT_TRUE(__i_db.hasUncommittedConfigs());
+    ASSERT_EQ(__i_db.getDirtyFrom(), (uint32_t)(probeAddress() + 1));
+    ASSERT_EQ(__i_db.getDirtyTo(), (uint32_t)(probeAddress() + sizeof(probe.bytes)));
+
+    ASSERT_TRUE(__i_db.commitConfigs());
+    ASSERT_FALSE(__i_db.hasUncommittedConfigs());
+    resetStore();
+}
+
+TEST(database, saves_inside_one_window_share_a_commit)
+{
+    resetStore();
+    std::string path = backingPath();
+    ASSERT_TRUE(__i_db.attachBackingFile(path.c_str()));
+    uint32_t commits = __i_db.getCommitCount();
+
+    DirtyProbe first(10);
+    DirtyProbe second(20);
+    __i_db.saveConfig(probeAddress(), &first);
+    __database.schedule_commit();
+    __i_db.saveConfig((uint16_t)(probeAddress() + 32), &second);
+    __database.schedule_commit();
+
+    ASSERT_EQ(__i_db.getCommitCount(), commits);
+    ASSERT_EQ(__i_db.getDirtyFrom(), (uint32_t)probeAddress());
+    ASSERT_EQ(__i_db.getDirtyTo(), (uint32_t)(probeAddress() + 32 + sizeof(second.bytes)));
+
+    ASSERT_TRUE(__database.commit());
+    ASSERT_EQ(__i_db.getCommitCount(), commits + 1);
+    ASSERT_EQ(fileByte(path, probeAddress()), 10);
+    ASSERT_EQ(fileByte(path, probeAddress() + 32), 20);
+    resetStore();
+}
+
+/**
+ * The file is patched in place, so bytes outside the dirty range are never
+ * rewritten from the store.
+ */
+TEST(database, a_commit_writes_only_the_dirty_range)
+{
+    resetStore();
+    std::string path = backingPath();
+    ASSERT_TRUE(__i_db.attachBackingFile(path.c_str()));
+
+    long outside = probeAddress() - 8;
+    setFileByte(path, outside, 0x5A);
+
+    DirtyProbe probe(40);
+    __i_db.saveConfig(probeAddress(), &probe);
+    ASSERT_TRUE(__i_db.commitConfigs());
+
+    ASSERT_EQ(fileByte(path, outside), 0x5A);
+    ASSERT_EQ(fileByte(path, probeAddress()), 40);
+    resetStore();
+}
+
+/**
+ * A directory where the file should be lets the journal land but not the patch,
+ * which is where a crash mid commit leaves things. Attaching the real file
+ * afterwards has to finish the commit.
+ */
+TEST(database, a_journal_left_by_an_interrupted_commit_is_replayed_on_attach)
+{
+    resetStore();
+    std::string path = backingPath();
+    ASSERT_EQ(mkdir(path.c_str(), 0700), 0);
+    __i_db.attachBackingFile(path.c_str());
+
+    DirtyProbe probe(60);
+    __i_db.saveConfig(probeAddress(), &probe);
+    ASSERT_FALSE(__i_db.commitConfigs());
+    ASSERT_TRUE(__i_db.hasUncommittedConfigs());
+
+    __i_db.detachBackingFile();
+    rmdir(path.c_str());
+    DirtyProbe zero;
+    memset(zero.bytes, 0, sizeof(zero.bytes));
+    __i_db.saveConfig(probeAddress(), &zero);
+    __i_db.commitConfigs();
+
+    FILE *f = fopen(path.c_str(), "wb");
+    ASSERT_NOT_NULL(f);
+    for (uint32_t i = 0; i < __i_db.getMaxDBSize(); i++)
+    {
+        fputc(0, f);
+    }
+    fclose(f);
+
+    ASSERT_TRUE(__i_db.attachBackingFile(path.c_str()));
+    ASSERT_EQ(fileByte(path, probeAddress()), 60);
+    ASSERT_EQ(fileByte(path + ".jnl", 0), -1);
+    resetStore();
+}
+
+TEST(database, a_torn_journal_is_dropped_without_touching_the_file)
+{
+    resetStore();
+    std::string path = backingPath();
+    ASSERT_TRUE(__i_db.attachBackingFile(path.c_str()));
+    __i_db.detachBackingFile();
+    setFileByte(path, probeAddress(), 0x33);
+
+    FILE *f = fopen((path + ".jnl").c_str(), "wb");
+    ASSERT_NOT_NULL(f);
+    fputs("PDBJ torn", f);
+    fclose(f);
+
+    ASSERT_TRUE(__i_db.attachBackingFile(path.c_str()));
+    ASSERT_EQ(fileByte(path, probeAddress()), 0x33);
+    ASSERT_EQ(fileByte(path + ".jnl", 0), -1);
+    resetStore();
+}
+
+static DatabaseTable<3900, DirtyProbe> s_cached_table;
+static DatabaseTable<4090, DirtyProbe> s_overflowing_table;
+
+/**
+ * Registers the probe tables with the global engine, and makes the store valid
+ * the way a first boot would, since nothing is loaded from an invalid store.
+ * Returns whether it had to, so the test can put that back: later suites boot
+ * the stack expecting an empty store.
+ */
+static bool readyTables()
+{
+    if (0 == __database.m_max_db_size)
+    {
+        __database.init_database(__i_db.getMaxDBSize());
+    }
+    s_cached_table.boot();
+    s_overflowing_table.boot();
+
+    if (__i_db.isValidConfigs())
+    {
+        return false;
+    }
+
+    global_config_table global;
+    __i_db.saveConfig(CONFIG_START, &global);
+    return true;
+}
+
+static void releaseTables(bool validated)
+{
+    if (validated)
+    {
+        // zeroed members rather than a zeroed object: the constructor would
+        // fill in a valid version, and the store has to go back to invalid
+        global_config_table global;
+        memset(global.config_version, 0, sizeof(global.config_version));
+        global.current_year = 0;
+        global.firmware_version = 0;
+        __i_db.saveConfig(CONFIG_START, &global);
+    }
+    __database.commit();
+}
+
+TEST(database, a_peeked_table_follows_every_set_and_clear)
+{
+    bool validated = readyTables();
+
+    const DirtyProbe *view = s_cached_table.peek();
+    ASSERT_NOT_NULL(view);
+
+    DirtyProbe written(70);
+    ASSERT_TRUE(s_cached_table.set(&written));
+    ASSERT_TRUE(s_cached_table.peek() == view);
+    ASSERT_EQ(view->bytes[0], 70);
+    ASSERT_EQ(view->bytes[7], 77);
+
+    s_cached_table.clear();
+    ASSERT_TRUE(s_cached_table.peek() == view);
+    ASSERT_EQ(view->bytes[7], 7);
+
+    DirtyProbe loaded(1);
+    ASSERT_TRUE(s_cached_table.get(&loaded));
+    ASSERT_MEMEQ(loaded.bytes, view->bytes, sizeof(loaded.bytes));
+    releaseTables(validated);
+}
+
+TEST(database, peeking_does_not_move_the_store_version)
+{
+    bool validated = readyTables();
+    s_cached_table.peek();
+
+    uint32_t version = __i_db.getStoreVersion();
+    s_cached_table.peek();
+    DirtyProbe loaded;
+    s_cached_table.get(&loaded);
+    ASSERT_EQ(__i_db.getStoreVersion(), version);
+
+    DirtyProbe same = *s_cached_table.peek();
+    s_cached_table.set(&same);
+    ASSERT_EQ(__i_db.getStoreVersion(), version);
+    releaseTables(validated);
+}
+
+TEST(database, a_table_that_never_registered_cannot_be_read_or_written)
+{
+    bool validated = readyTables();
+
+    DirtyProbe probe(5);
+    ASSERT_NULL(s_overflowing_table.peek());
+    ASSERT_FALSE(s_overflowing_table.get(&probe));
+    ASSERT_FALSE(s_overflowing_table.set(&probe));
+    releaseTables(validated);
+}
@@ -618,3 +618,595 @@ TEST(filesystem, mime_type_of_a_file_without_an_extension_is_unknown)
     fs->createFile("/noext", "x");
     ASSERT_EQ(fs->getFileMimeType(pdiutil::string("/noext")), MIME_TYPE_MAX);
 }
+
+TEST(filehandle, reads_back_what_was_written_through_it)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/handle.txt");
+    int16_t fd = fs->openFile("/handle.txt", FILE_OPEN_WRITE | FILE_OPEN_CREATE);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->writeHandle(fd, "hello ", 6), 6);
+    ASSERT_EQ(fs->writeHandle(fd, "world", 5), 5);
+    ASSERT_EQ(fs->closeFile(fd), (pdi_err_t)PDI_OK);
+
+    ASSERT_STREQ(slurp(fs, "/handle.txt").c_str(), "hello world");
+
+    char buf[16] = {0};
+    fd = fs->openFile("/handle.txt", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->readHandle(fd, buf, sizeof(buf)), 11);
+    ASSERT_EQ(fs->readHandle(fd, buf, sizeof(buf)), 0);
+    fs->closeFile(fd);
+}
+
+TEST(filehandle, seek_moves_the_position_and_reports_it)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/seek.txt");
+    fs->createFile("/seek.txt", "0123456789");
+
+    char buf[4] = {0};
+    int16_t fd = fs->openFile("/seek.txt", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->seekHandle(fd, 0, FILE_SEEK_END), (int64_t)10);
+    ASSERT_EQ(fs->seekHandle(fd, 6), (int64_t)6);
+    ASSERT_EQ(fs->readHandle(fd, buf, 3), 3);
+    ASSERT_MEMEQ(buf, "678", 3);
+    ASSERT_EQ(fs->seekHandle(fd, -5, FILE_SEEK_CUR), (int64_t)4);
+    ASSERT_EQ(fs->readHandle(fd, buf, 1), 1);
+    ASSERT_EQ(buf[0], '4');
+    fs->closeFile(fd);
+}
+
+TEST(filehandle, append_writes_land_at_the_end)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/append.txt");
+    fs->createFile("/append.txt", "abc");
+
+    int16_t fd = fs->openFile("/append.txt", FILE_OPEN_WRITE | FILE_OPEN_APPEND);
+    ASSERT_GE(fd, 0);
+    fs->seekHandle(fd, 0);
+    ASSERT_EQ(fs->writeHandle(fd, "def", 3), 3);
+    fs->closeFile(fd);
+
+    ASSERT_STREQ(slurp(fs, "/append.txt").c_str(), "abcdef");
+}
+
+TEST(filehandle, opening_a_missing_file_without_create_fails)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/nothere.txt");
+    ASSERT_LT(fs->openFile("/nothere.txt", FILE_OPEN_READ), 0);
+    ASSERT_FALSE(fs->isFileExist("/nothere.txt"));
+}
+
+TEST(filehandle, the_table_refuses_one_past_its_size)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/many.txt");
+    fs->createFile("/many.txt", "x");
+
+    int16_t fds[VFS_MAX_OPEN_FILES];
+    for (int i = 0; i < VFS_MAX_OPEN_FILES; i++)
+    {
+        fds[i] = fs->openFile("/many.txt", FILE_OPEN_READ);
+        ASSERT_GE(fds[i], 0);
+    }
+    ASSERT_EQ(fs->openFile("/many.txt", FILE_OPEN_READ), (int16_t)PDI_ERR_FULL);
+
+    for (int i = 0; i < VFS_MAX_OPEN_FILES; i++)
+    {
+        fs->closeFile(fds[i]);
+    }
+    int16_t fd = fs->openFile("/many.txt", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    fs->closeFile(fd);
+}
+
+TEST(filehandle, a_closed_handle_is_refused)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/closed.txt");
+    fs->createFile("/closed.txt", "x");
+
+    char c;
+    int16_t fd = fs->openFile("/closed.txt", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    fs->closeFile(fd);
+    ASSERT_LT(fs->readHandle(fd, &c, 1), 0);
+    ASSERT_LT(fs->closeFile(fd), 0);
+}
+
+/**
+ * Storage accesses, not time, so the comparison holds on any host: reading a
+ * file in small pieces by path reopens and walks it for every piece, a handle
+ * keeps its place.
+ */
+TEST(filehandle, piecewise_reads_touch_storage_less_than_reads_by_path)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    pdiutil::string content;
+    for (int i = 0; i < 2048; i++)
+    {
+        content += (char)('a' + (i % 26));
+    }
+    removeIfPresent(fs, "/bench.txt");
+    fs->createFile("/bench.txt", content.c_str());
+
+    __i_storage.clearCounters();
+    pdiutil::string bypath;
+    for (uint64_t off = 0; off < content.length(); off += 64)
+    {
+        fs->readFile("/bench.txt", 64, [&bypath](char *chunk, uint32_t len) {
+            bypath.append(chunk, len);
+            return false;
+        }, off);
+    }
+    uint32_t pathreads = __i_storage.getReadCount();
+
+    __i_storage.clearCounters();
+    pdiutil::string byhandle;
+    char buf[64];
+    int16_t fd = fs->openFile("/bench.txt", FILE_OPEN_READ);
+    ASSERT_GE(fd, 0);
+    int32_t n;
+    while ((n = fs->readHandle(fd, buf, sizeof(buf))) > 0)
+    {
+        byhandle.append(buf, n);
+    }
+    fs->closeFile(fd);
+    uint32_t handlereads = __i_storage.getReadCount();
+
+    ASSERT_STREQ(bypath.c_str(), content.c_str());
+    ASSERT_STREQ(byhandle.c_str(), content.c_str());
+    ASSERT_LT(handlereads, pathreads);
+}
+
+TEST(filehandle, small_appends_touch_storage_less_than_appends_by_path)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    const char line[] = "2026-10-17 sensor=42\n";
+    const uint32_t linelen = sizeof(line) - 1;
+
+    removeIfPresent(fs, "/bylog.txt");
+    fs->createFile("/bylog.txt", "");
+    __i_storage.clearCounters();
+    for (int i = 0; i < 32; i++)
+    {
+        fs->writeFile("/bylog.txt", line, linelen, true);
+    }
+    uint32_t pathio = __i_storage.getReadCount() + __i_storage.getWriteCount();
+
+    removeIfPresent(fs, "/fdlog.txt");
+    fs->createFile("/fdlog.txt", "");
+    __i_storage.clearCounters();
+    int16_t fd = fs->openFile("/fdlog.txt", FILE_OPEN_WRITE | FILE_OPEN_APPEND);
+    ASSERT_GE(fd, 0);
+    for (int i = 0; i < 32; i++)
+    {
+        ASSERT_EQ(fs->writeHandle(fd, line, linelen), (int32_t)linelen);
+    }
+    fs->closeFile(fd);
+    uint32_t handleio = __i_storage.getReadCount() + __i_storage.getWriteCount();
+
+    ASSERT_EQ(fs->getFileSize("/fdlog.txt"), (int64_t)(32 * linelen));
+    ASSERT_STREQ(slurp(fs, "/fdlog.txt").c_str(), slurp(fs, "/bylog.txt").c_str());
+    ASSERT_LT(handleio, pathio);
+}
+
+/**
+ * Compare a file with the expected bytes a block at a time, so a large one
+ * is not built up into a string first.
+ */
+static bool holds(FileSystemInterface *fs, const char *path, const pdiutil::string &expected)
+{
+    char buf[256];
+    uint32_t at = 0;
+    int32_t n;
+    int16_t fd = fs->openFile(path, FILE_OPEN_READ);
+    if (fd < 0)
+    {
+        return false;
+    }
+    while ((n = fs->readHandle(fd, buf, sizeof(buf))) > 0)
+    {
+        if (at + n > expected.length() || 0 != memcmp(buf, expected.c_str() + at, n))
+        {
+            break;
+        }
+        at += n;
+    }
+    fs->closeFile(fd);
+    return n == 0 && at == expected.length();
+}
+
+static pdiutil::string patterned(uint32_t size)
+{
+    pdiutil::string out(size, ' ');
+    for (uint32_t i = 0; i < size; i++)
+    {
+        out[i] = (char)('a' + (i * 7 + i / 251) % 26);
+    }
+    return out;
+}
+
+TEST(filecopy, a_file_spanning_many_blocks_copies_intact)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    pdiutil::string content = patterned(20000);
+    removeIfPresent(fs, "/big.bin");
+    removeIfPresent(fs, "/big.copy");
+    fs->createFile("/big.bin", content.c_str());
+
+    ASSERT_EQ(fs->copyFile("/big.bin", "/big.copy"), (pdi_err_t)PDI_OK);
+    ASSERT_EQ(fs->getFileSize("/big.copy"), (int64_t)content.length());
+    ASSERT_TRUE(holds(fs, "/big.copy", content));
+
+    fs->deleteFile("/big.bin");
+    fs->deleteFile("/big.copy");
+}
+
+TEST(filecopy, an_empty_file_copies_to_an_empty_file)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/empty.src");
+    removeIfPresent(fs, "/empty.dst");
+    fs->createFile("/empty.src", "");
+
+    ASSERT_EQ(fs->copyFile("/empty.src", "/empty.dst"), (pdi_err_t)PDI_OK);
+    ASSERT_TRUE(fs->isFileExist("/empty.dst"));
+    ASSERT_EQ(fs->getFileSize("/empty.dst"), (int64_t)0);
+
+    fs->deleteFile("/empty.src");
+    fs->deleteFile("/empty.dst");
+}
+
+TEST(filecopy, progress_ends_at_the_file_size)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    pdiutil::string content = patterned(10000);
+    removeIfPresent(fs, "/prog.src");
+    removeIfPresent(fs, "/prog.dst");
+    fs->createFile("/prog.src", content.c_str());
+
+    uint32_t calls = 0;
+    uint64_t lastdone = 0, lasttotal = 0;
+    ASSERT_EQ(fs->copyFile("/prog.src", "/prog.dst", [&](uint64_t done, uint64_t total) {
+        calls++;
+        lastdone = done;
+        lasttotal = total;
+        return true;
+    }), (pdi_err_t)PDI_OK);
+
+    ASSERT_GT(calls, (uint32_t)1);
+    ASSERT_EQ(lastdone, (uint64_t)content.length());
+    ASSERT_EQ(lasttotal, (uint64_t)content.length());
+
+    fs->deleteFile("/prog.src");
+    fs->deleteFile("/prog.dst");
+}
+
+TEST(filecopy, a_stopped_copy_leaves_no_destination)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/stop.src");
+    removeIfPresent(fs, "/stop.dst");
+    fs->createFile("/stop.src", patterned(10000).c_str());
+
+    ASSERT_EQ(fs->copyFile("/stop.src", "/stop.dst", [](uint64_t, uint64_t) { return false; }), (pdi_err_t)PDI_ERR_ABORTED);
+    ASSERT_FALSE(fs->isFileExist("/stop.dst"));
+    ASSERT_TRUE(fs->isFileExist("/stop.src"));
+
+    fs->deleteFile("/stop.src");
+}
+
+TEST(filecopy, a_missing_source_is_reported_and_creates_nothing)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/ghost.src");
+    removeIfPresent(fs, "/ghost.dst");
+
+    ASSERT_LT(fs->copyFile("/ghost.src", "/ghost.dst"), 0);
+    ASSERT_FALSE(fs->isFileExist("/ghost.dst"));
+}
+
+/**
+ * The tracked copy benchmark, in round trips rather than MB/s so it holds on
+ * any host. Every storage access lfs makes is bounded by its 64 byte caches
+ * either way; what a copy pays per block is the lfs call and the walk to the
+ * file position, once per cache line before and once per block now.
+ */
+TEST(filecopy, a_copy_moves_a_whole_block_per_round_trip)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    const uint32_t size = 64 * 1024;
+    pdiutil::string content = patterned(size);
+    removeIfPresent(fs, "/bench.src");
+    removeIfPresent(fs, "/bench.dst");
+    fs->createFile("/bench.src", content.c_str());
+
+    uint32_t trips = 0;
+    ASSERT_EQ(fs->copyFile("/bench.src", "/bench.dst", [&trips](uint64_t, uint64_t) {
+        trips++;
+        return true;
+    }), (pdi_err_t)PDI_OK);
+
+    ASSERT_EQ(trips, (uint32_t)((size + VFS_COPY_BUFFER_MAX - 1) / VFS_COPY_BUFFER_MAX));
+    ASSERT_TRUE(holds(fs, "/bench.dst", content));
+
+    fs->deleteFile("/bench.src");
+    fs->deleteFile("/bench.dst");
+}
+
+/**
+ * Lines of a fixed width, so line k of the file starts at k * 7.
+ */
+static pdiutil::string numbered(uint32_t lines)
+{
+    pdiutil::string out(lines * 7, ' ');
+    char line[16];
+    for (uint32_t i = 0; i < lines; i++)
+    {
+        snprintf(line, sizeof(line), "L%05u\n", (unsigned)i);
+        memcpy(&out[i * 7], line, 7);
+    }
+    return out;
+}
+
+static bool indexed(FileSystemInterface *fs, const char *path)
+{
+    char record[VFS_LINE_INDEX_BYTES];
+    return fs->getFileAttr(path, FILE_ATTR_LINES, record, sizeof(record)) > 0;
+}
+
+TEST(fileline, a_tail_counts_back_from_the_last_line)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/tail.txt");
+    fs->createFile("/tail.txt", "a\nbb\nccc\n");
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/tail.txt", -1), (int64_t)5);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/tail.txt", -2), (int64_t)2);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/tail.txt", -3), (int64_t)0);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/tail.txt", -4), (int64_t)PDI_ERR_RANGE);
+
+    fs->writeFile("/tail.txt", "a\nbb\nccc", 8);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/tail.txt", -1), (int64_t)5);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/tail.txt", -3), (int64_t)0);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/tail.txt", -4), (int64_t)PDI_ERR_RANGE);
+
+    pdiutil::string line;
+    ASSERT_GE(fs->readLineInFile("/tail.txt", -2, line), 0);
+    ASSERT_STREQ(line.c_str(), "bb");
+}
+
+TEST(fileline, a_tail_reads_only_the_end_of_a_large_file)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/tail.log");
+    fs->createFile("/tail.log", numbered(4000).c_str());
+
+    __i_storage.clearCounters();
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/tail.log", -10), (int64_t)(3990 * 7));
+    uint32_t tailreads = __i_storage.getReadCount();
+
+    __i_storage.clearCounters();
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/tail.log", 3990), (int64_t)(3990 * 7));
+    uint32_t scanreads = __i_storage.getReadCount();
+
+    ASSERT_LT(tailreads * 4, scanreads);
+    fs->deleteFile("/tail.log");
+}
+
+TEST(fileline, an_index_gives_the_same_answers_as_a_scan)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/index.log");
+    fs->createFile("/index.log", numbered(3000).c_str());
+    ASSERT_EQ(fs->indexLines("/index.log"), (pdi_err_t)PDI_OK);
+    ASSERT_TRUE(indexed(fs, "/index.log"));
+
+    const int lines[] = {0, 1, 15, 16, 17, 1000, 2047, 2999};
+    for (int line : lines)
+    {
+        ASSERT_EQ(fs->getOffsetFromLineNumber("/index.log", line), (int64_t)(line * 7));
+        ASSERT_EQ(fs->getLineNumberFromOffset("/index.log", line * 7 + 3), (int64_t)line);
+    }
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/index.log", 3000), (int64_t)(3000 * 7));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/index.log", 5000), (int64_t)(3000 * 7));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/index.log", -1), (int64_t)(2999 * 7));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/index.log", -3000), (int64_t)0);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/index.log", -3001), (int64_t)PDI_ERR_RANGE);
+    ASSERT_EQ(fs->getLineNumberFromOffset("/index.log", 3000 * 7), (int64_t)3000);
+
+    pdiutil::string line;
+    ASSERT_GE(fs->readLineInFile("/index.log", 2500, line), 0);
+    ASSERT_STREQ(line.c_str(), "L02500");
+    fs->deleteFile("/index.log");
+}
+
+TEST(fileline, an_indexed_lookup_reads_less_than_a_scan)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    pdiutil::string content = numbered(3000);
+    removeIfPresent(fs, "/plain.log");
+    removeIfPresent(fs, "/fast.log");
+    fs->createFile("/plain.log", content.c_str());
+    fs->createFile("/fast.log", content.c_str());
+    ASSERT_EQ(fs->indexLines("/fast.log"), (pdi_err_t)PDI_OK);
+
+    __i_storage.clearCounters();
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/plain.log", 2900), (int64_t)(2900 * 7));
+    uint32_t scanreads = __i_storage.getReadCount();
+
+    __i_storage.clearCounters();
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/fast.log", 2900), (int64_t)(2900 * 7));
+    uint32_t indexreads = __i_storage.getReadCount();
+
+    ASSERT_LT(indexreads * 4, scanreads);
+    fs->deleteFile("/plain.log");
+    fs->deleteFile("/fast.log");
+}
+
+TEST(fileline, appends_keep_the_index_current)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    pdiutil::string content = numbered(1200);
+    removeIfPresent(fs, "/grow.log");
+    fs->createFile("/grow.log", content.c_str(), 1000 * 7);
+    ASSERT_EQ(fs->indexLines("/grow.log"), (pdi_err_t)PDI_OK);
+
+    for (uint32_t i = 1000; i < 1100; i++)
+    {
+        ASSERT_EQ(fs->writeFile("/grow.log", content.c_str() + i * 7, 7, true), 7);
+    }
+    int16_t fd = fs->openFile("/grow.log", FILE_OPEN_WRITE | FILE_OPEN_APPEND);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->writeHandle(fd, content.c_str() + 1100 * 7, 100 * 7), (int32_t)(100 * 7));
+    ASSERT_EQ(fs->closeFile(fd), (pdi_err_t)PDI_OK);
+
+    ASSERT_TRUE(indexed(fs, "/grow.log"));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/grow.log", 1050), (int64_t)(1050 * 7));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/grow.log", 1150), (int64_t)(1150 * 7));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/grow.log", -1), (int64_t)(1199 * 7));
+    ASSERT_EQ(fs->getLineNumberFromOffset("/grow.log", 1199 * 7), (int64_t)1199);
+    fs->deleteFile("/grow.log");
+}
+
+TEST(fileline, edits_and_rewrites_recount_the_index)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/edit.log");
+    fs->createFile("/edit.log", numbered(200).c_str());
+    ASSERT_EQ(fs->indexLines("/edit.log"), (pdi_err_t)PDI_OK);
+
+    // splits line 50 in two: "L00" and "050"
+    ASSERT_EQ(fs->editFile("/edit.log", 50 * 7 + 3, "\n", 1), 1);
+    ASSERT_TRUE(indexed(fs, "/edit.log"));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/edit.log", 50), (int64_t)(50 * 7));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/edit.log", 51), (int64_t)(50 * 7 + 4));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/edit.log", 52), (int64_t)(51 * 7));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/edit.log", 200), (int64_t)(199 * 7));
+
+    ASSERT_EQ(fs->writeFile("/edit.log", "x\ny\n", 4), 4);
+    ASSERT_TRUE(indexed(fs, "/edit.log"));
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/edit.log", 1), (int64_t)2);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/edit.log", -1), (int64_t)2);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/edit.log", 5), (int64_t)4);
+
+    int16_t fd = fs->openFile("/edit.log", FILE_OPEN_WRITE | FILE_OPEN_TRUNC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fs->writeHandle(fd, "one\ntwo\nthree\n", 14), 14);
+    ASSERT_EQ(fs->closeFile(fd), (pdi_err_t)PDI_OK);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/edit.log", 2), (int64_t)8);
+    ASSERT_EQ(fs->getOffsetFromLineNumber("/edit.log", -1), (int64_t)8);
+    fs->deleteFile("/edit.log");
+}
+
+TEST(fsusage, repeated_queries_read_nothing_from_storage)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    fs->createFile("/usage.txt", "some bytes");
+    __i_storage.clearCounters();
+    uint64_t used = fs->getUsedSize();
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(fs->getUsedSize(), used);
+        ASSERT_EQ(fs->getFreeSize(), fs->getTotalSize() - used);
+    }
+    ASSERT_EQ(__i_storage.getReadCount(), (uint32_t)0);
+    fs->deleteFile("/usage.txt");
+}
+
+TEST(fsusage, a_write_counts_before_the_next_scrub)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    removeIfPresent(fs, "/usage.bin");
+    ASSERT_EQ(__i_rootfs.scrubUsage(), (pdi_err_t)PDI_OK);
+    uint64_t before = fs->getUsedSize();
+
+    pdiutil::string content(5 * 4096, 'u');
+    fs->createFile("/usage.bin", content.c_str());
+    ASSERT_GE(fs->getUsedSize(), before + content.size());
+
+    fs->deleteFile("/usage.bin");
+    ASSERT_GE(fs->getUsedSize(), before + content.size());
+    ASSERT_EQ(__i_rootfs.scrubUsage(), (pdi_err_t)PDI_OK);
+    ASSERT_EQ(fs->getUsedSize(), before);
+}
+
+TEST(fsusage, a_scrub_agrees_with_a_fresh_count)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    pdiutil::string content(3 * 4096, 'a');
+    for (int round = 0; round < 3; round++)
+    {
+        fs->createFile("/usage.a", content.c_str());
+        fs->writeFile("/usage.a", "short", 5);
+        fs->createFile("/usage.b", content.c_str());
+        fs->deleteFile("/usage.a");
+    }
+    ASSERT_EQ(__i_rootfs.scrubUsage(), (pdi_err_t)PDI_OK);
+    uint64_t scrubbed = fs->getUsedSize();
+
+    ASSERT_EQ(__i_rootfs.init(), PDI_OK);
+    ASSERT_EQ(fs->getUsedSize(), scrubbed);
+    fs->deleteFile("/usage.b");
+}
+
+TEST(fsusage, a_scrub_with_nothing_written_reads_nothing)
+{
+    FileSystemInterface *fs = mountedFs();
+    ASSERT_NOT_NULL(fs);
+
+    ASSERT_EQ(__i_rootfs.scrubUsage(), (pdi_err_t)PDI_OK);
+    __i_storage.clearCounters();
+    ASSERT_EQ(__i_rootfs.scrubUsage(), (pdi_err_t)PDI_OK);
+    ASSERT_EQ(__i_storage.getReadCount(), (uint32_t)0);
+}
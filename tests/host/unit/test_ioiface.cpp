@@ -214,6 +214,30 @@ TEST(ioiface, read_line_strips_the_line_ending)
     ASSERT_STREQ(out.c_str(), "second");
 }
 
+TEST(ioiface, read_line_into_a_buffer_views_the_line)
+{
+    pditest::StringTerminal terminal;
+    char buffer[16];
+    terminal.feed("first\r\nsecond\r\n");
+
+    pdiutil::string_view line = terminal.readLine(buffer);
+    ASSERT_EQ(line.size(), (size_t)5);
+    ASSERT_TRUE(line.data() == buffer);
+    ASSERT_TRUE(line == "first");
+
+    ASSERT_TRUE(terminal.readLine(buffer) == "second");
+}
+
+TEST(ioiface, read_line_into_a_buffer_drops_what_does_not_fit)
+{
+    pditest::StringTerminal terminal;
+    char buffer[4];
+    terminal.feed("overlong\r\nnext\r\n");
+
+    ASSERT_TRUE(terminal.readLine(buffer) == "over");
+    ASSERT_TRUE(terminal.readLine(buffer) == "next");
+}
+
 /**
  * readLine consumes a carriage return then a newline, so it strips a crlf
  * ending. A bare newline is not a terminator and stays in the value. Every
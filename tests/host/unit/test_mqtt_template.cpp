@@ -0,0 +1,129 @@
+/**************************** MQTT Template Tests *****************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+
+#include <pditest.h>
+#include <transports/mqtt/MqttTemplate.h>
+
+#if defined(ENABLE_MQTT_SERVICE)
+
+/**
+ * Fills every slot with its own name in braces, counting the calls.
+ */
+struct SlotNames
+{
+    int calls = 0;
+
+    MqttSlotWriter writer()
+    {
+        return [this](uint8_t slot, char *out, uint16_t size) -> int32_t {
+            static const char *names[] = {"", "{mac}", "{ip}", "{epoch}", "{gpio}"};
+            calls++;
+            uint16_t len = strlen(names[slot]);
+            if (len > size)
+            {
+                return PDI_ERR_OVERFLOW;
+            }
+            memcpy(out, names[slot], len);
+            return len;
+        };
+    }
+};
+
+static pdiutil::string render(const MqttTemplate &tmpl, const MqttSlotWriter &slots, uint16_t size = 64)
+{
+    char out[64];
+    int32_t len = tmpl.render(out, size, slots);
+    return len < 0 ? pdiutil::string("<overflow>") : pdiutil::string(out, len);
+}
+
+TEST(mqtt_template, literal_text_renders_as_it_is)
+{
+    MqttTemplate tmpl;
+    SlotNames slots;
+    tmpl.compile("pdi/state", 9);
+
+    ASSERT_FALSE(tmpl.empty());
+    ASSERT_STREQ(render(tmpl, slots.writer()).c_str(), "pdi/state");
+    ASSERT_EQ(slots.calls, 0);
+}
+
+TEST(mqtt_template, every_placeholder_becomes_a_slot)
+{
+    MqttTemplate tmpl;
+    SlotNames slots;
+    const char *text = "[mac]/[ip]/[epoch]:[gpio][mac]";
+    tmpl.compile(text, strlen(text));
+
+    ASSERT_TRUE(tmpl.uses(MQTT_SLOT_MAC));
+    ASSERT_TRUE(tmpl.uses(MQTT_SLOT_GPIO));
+    ASSERT_STREQ(render(tmpl, slots.writer()).c_str(), "{mac}/{ip}/{epoch}:{gpio}{mac}");
+    ASSERT_EQ(slots.calls, 5);
+}
+
+TEST(mqtt_template, brackets_that_are_no_placeholder_stay_text)
+{
+    MqttTemplate tmpl;
+    SlotNames slots;
+    const char *text = "a[b]/[ma/[mac";
+    tmpl.compile(text, strlen(text));
+
+    ASSERT_FALSE(tmpl.uses(MQTT_SLOT_MAC));
+    ASSERT_STREQ(render(tmpl, slots.writer()).c_str(), text);
+    ASSERT_EQ(slots.calls, 0);
+}
+
+TEST(mqtt_template, the_compiled_text_does_not_follow_its_source)
+{
+    MqttTemplate tmpl;
+    SlotNames slots;
+    char text[] = "dev/[mac]/up";
+    tmpl.compile(text, strlen(text));
+    memset(text, 'x', strlen(text));
+
+    ASSERT_STREQ(render(tmpl, slots.writer()).c_str(), "dev/{mac}/up");
+}
+
+TEST(mqtt_template, too_small_a_buffer_is_an_overflow)
+{
+    MqttTemplate tmpl;
+    SlotNames slots;
+    tmpl.compile("dev/[mac]", 9);
+
+    ASSERT_STREQ(render(tmpl, slots.writer(), 9).c_str(), "dev/{mac}");
+    ASSERT_STREQ(render(tmpl, slots.writer(), 8).c_str(), "<overflow>");
+    ASSERT_STREQ(render(tmpl, slots.writer(), 3).c_str(), "<overflow>");
+}
+
+TEST(mqtt_template, nothing_compiled_renders_nothing)
+{
+    MqttTemplate tmpl;
+    SlotNames slots;
+    ASSERT_TRUE(tmpl.empty());
+    tmpl.compile(nullptr, 4);
+    ASSERT_TRUE(tmpl.empty());
+    tmpl.compile("[ip]", 4);
+    tmpl.clear();
+    ASSERT_TRUE(tmpl.empty());
+    ASSERT_STREQ(render(tmpl, slots.writer()).c_str(), "");
+}
+
+TEST(mqtt_template, expand_renders_without_keeping_anything)
+{
+    SlotNames slots;
+    char out[32];
+    const char *text = "{\"at\":[epoch],\"v\":[x]}";
+
+    int32_t len = MqttTemplate::expand(text, strlen(text), out, sizeof(out), slots.writer());
+    ASSERT_EQ(len, (int32_t)strlen("{\"at\":{epoch},\"v\":[x]}"));
+    ASSERT_MEMEQ(out, "{\"at\":{epoch},\"v\":[x]}", len);
+    ASSERT_EQ(MqttTemplate::expand(text, strlen(text), out, 10, slots.writer()), (int32_t)PDI_ERR_OVERFLOW);
+}
+
+#endif
@@ -0,0 +1,214 @@
+/***************************** Message Ring Tests *****************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+Author          : Suraj I.
+created Date    : 18th Oct 2026
+******************************************************************************/
+
+#include <pditest.h>
+#include <utility/queue/msgring.h>
+#include <thread>
+
+TEST(msgring, init_rejects_null_and_undersized_buffers)
+{
+    MSGRING ring;
+    uint8_t storage[8];
+    ASSERT_EQ(MSGRING_Init(&ring, storage, sizeof(storage)), 0);
+    ASSERT_EQ(MSGRING_Init(nullptr, storage, sizeof(storage)), -1);
+    ASSERT_EQ(MSGRING_Init(&ring, nullptr, sizeof(storage)), -1);
+    ASSERT_EQ(MSGRING_Init(&ring, storage, MSGRING_HEADER_SIZE), -1);
+}
+
+TEST(msgring, peek_on_an_empty_ring_finds_nothing)
+{
+    MSGRING ring;
+    uint8_t storage[32];
+    uint16_t len = 0;
+
+    MSGRING_Init(&ring, storage, sizeof(storage));
+    ASSERT_TRUE(MSGRING_IsEmpty(&ring));
+    ASSERT_TRUE(nullptr == MSGRING_Peek(&ring, &len));
+    ASSERT_EQ(MSGRING_Consume(&ring), -1);
+}
+
+TEST(msgring, a_record_is_written_and_read_in_place)
+{
+    MSGRING ring;
+    uint8_t storage[64];
+    uint16_t len = 0;
+
+    MSGRING_Init(&ring, storage, sizeof(storage));
+    uint8_t *slot = MSGRING_Reserve(&ring, 16);
+    ASSERT_TRUE(nullptr != slot);
+    ASSERT_TRUE(slot >= storage && slot + 16 <= storage + sizeof(storage));
+    memcpy(slot, "hello", 5);
+    ASSERT_TRUE(MSGRING_IsEmpty(&ring));
+    MSGRING_Commit(&ring, 5);
+
+    const uint8_t *record = MSGRING_Peek(&ring, &len);
+    ASSERT_TRUE(record == slot);
+    ASSERT_EQ(len, (uint16_t)5);
+    ASSERT_MEMEQ(record, "hello", 5);
+    ASSERT_EQ(MSGRING_Used(&ring), (size_t)(MSGRING_HEADER_SIZE + 5));
+
+    ASSERT_EQ(MSGRING_Consume(&ring), 0);
+    ASSERT_TRUE(MSGRING_IsEmpty(&ring));
+    ASSERT_EQ(MSGRING_Used(&ring), (size_t)0);
+}
+
+TEST(msgring, records_come_out_whole_and_in_order)
+{
+    MSGRING ring;
+    uint8_t storage[64];
+    uint16_t len = 0;
+    const uint8_t first[] = {0x7E, 0x7D};
+    const uint8_t second[] = {0x00, 0xFF, 0x7F};
+
+    MSGRING_Init(&ring, storage, sizeof(storage));
+    ASSERT_EQ(MSGRING_Put(&ring, first, sizeof(first)), 0);
+    ASSERT_EQ(MSGRING_Put(&ring, second, sizeof(second)), 0);
+    ASSERT_EQ(MSGRING_Put(&ring, nullptr, 0), 0);
+
+    const uint8_t *record = MSGRING_Peek(&ring, &len);
+    ASSERT_EQ(len, (uint16_t)sizeof(first));
+    ASSERT_MEMEQ(record, first, sizeof(first));
+    MSGRING_Consume(&ring);
+
+    record = MSGRING_Peek(&ring, &len);
+    ASSERT_EQ(len, (uint16_t)sizeof(second));
+    ASSERT_MEMEQ(record, second, sizeof(second));
+    MSGRING_Consume(&ring);
+
+    ASSERT_TRUE(nullptr != MSGRING_Peek(&ring, &len));
+    ASSERT_EQ(len, (uint16_t)0);
+    MSGRING_Consume(&ring);
+    ASSERT_TRUE(MSGRING_IsEmpty(&ring));
+}
+
+TEST(msgring, a_full_ring_refuses_until_records_are_consumed)
+{
+    MSGRING ring;
+    uint8_t storage[32];
+    uint8_t record[8];
+    int stored = 0;
+
+    MSGRING_Init(&ring, storage, sizeof(storage));
+    memset(record, 0xAB, sizeof(record));
+    while (0 == MSGRING_Put(&ring, record, sizeof(record)))
+    {
+        stored++;
+    }
+    ASSERT_EQ(stored, 3);
+    ASSERT_TRUE(nullptr == MSGRING_Reserve(&ring, sizeof(record)));
+
+    // the write may not catch the read up from behind, so freeing exactly
+    // one record's worth at the front is not yet room for another
+    ASSERT_EQ(MSGRING_Consume(&ring), 0);
+    ASSERT_EQ(MSGRING_Put(&ring, record, sizeof(record)), -1);
+    ASSERT_EQ(MSGRING_Consume(&ring), 0);
+    ASSERT_EQ(MSGRING_Put(&ring, record, sizeof(record)), 0);
+}
+
+TEST(msgring, a_record_that_would_straddle_the_end_starts_at_the_front)
+{
+    MSGRING ring;
+    uint8_t storage[40];
+    uint8_t record[12];
+    uint16_t len = 0;
+
+    MSGRING_Init(&ring, storage, sizeof(storage));
+    memset(record, 1, sizeof(record));
+    MSGRING_Put(&ring, record, sizeof(record));
+    MSGRING_Put(&ring, record, sizeof(record));
+    MSGRING_Consume(&ring);
+
+    // 28 bytes in, 12 left at the end: too few for the header and 11 bytes
+    memset(record, 2, sizeof(record));
+    uint8_t *slot = MSGRING_Reserve(&ring, sizeof(record) - 1);
+    ASSERT_TRUE(slot == storage + MSGRING_HEADER_SIZE);
+    memcpy(slot, record, sizeof(record) - 1);
+    MSGRING_Commit(&ring, sizeof(record) - 1);
+
+    const uint8_t *out = MSGRING_Peek(&ring, &len);
+    ASSERT_EQ(out[0], 1);
+    MSGRING_Consume(&ring);
+
+    out = MSGRING_Peek(&ring, &len);
+    ASSERT_TRUE(out == slot);
+    ASSERT_EQ(len, (uint16_t)(sizeof(record) - 1));
+    ASSERT_MEMEQ(out, record, sizeof(record) - 1);
+    MSGRING_Consume(&ring);
+    ASSERT_TRUE(MSGRING_IsEmpty(&ring));
+}
+
+TEST(msgring, a_commit_may_be_shorter_than_its_reservation)
+{
+    MSGRING ring;
+    uint8_t storage[32];
+    uint16_t len = 0;
+
+    MSGRING_Init(&ring, storage, sizeof(storage));
+    uint8_t *slot = MSGRING_Reserve(&ring, 20);
+    memcpy(slot, "abc", 3);
+    MSGRING_Commit(&ring, 3);
+
+    // what was reserved but not used is free again
+    ASSERT_EQ(MSGRING_Put(&ring, (const uint8_t *)"0123456789", 10), 0);
+    ASSERT_TRUE(nullptr != MSGRING_Peek(&ring, &len));
+    ASSERT_EQ(len, (uint16_t)3);
+}
+
+TEST(msgring, one_producer_and_one_consumer_need_no_lock)
+{
+    MSGRING ring;
+    uint8_t storage[256];
+    const uint32_t total = 20000;
+
+    MSGRING_Init(&ring, storage, sizeof(storage));
+
+    std::thread producer([&ring, total]() {
+        for (uint32_t seq = 0; seq < total;)
+        {
+            // varying lengths move the wrap point around
+            uint16_t len = (uint16_t)(sizeof(seq) + seq % 23);
+            uint8_t *slot = MSGRING_Reserve(&ring, len);
+            if (nullptr == slot)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            memset(slot, (int)(seq & 0xff), len);
+            memcpy(slot, &seq, sizeof(seq));
+            MSGRING_Commit(&ring, len);
+            seq++;
+        }
+    });
+
+    uint32_t received = 0, mismatched = 0;
+    while (received < total)
+    {
+        uint16_t len = 0;
+        const uint8_t *record = MSGRING_Peek(&ring, &len);
+        if (nullptr == record)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t seq = 0;
+        memcpy(&seq, record, sizeof(seq));
+        if (seq != received || len != sizeof(seq) + seq % 23 ||
+            (len > sizeof(seq) && record[len - 1] != (uint8_t)(seq & 0xff)))
+        {
+            mismatched++;
+        }
+        MSGRING_Consume(&ring);
+        received++;
+    }
+    producer.join();
+
+    ASSERT_EQ(mismatched, (uint32_t)0);
+    ASSERT_TRUE(MSGRING_IsEmpty(&ring));
+}
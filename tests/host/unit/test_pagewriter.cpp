@@ -0,0 +1,65 @@
+/***************************** Page Writer Tests ******************************
+This file is part of the pdi stack.
+
+This is free software. you can redistribute it and/or modify it but without any
+warranty.
+
+The page writer without a client: appends land after what is there, a full
+chunk is flushed and reused, and a string writer keeps the whole text.
+
+Author          : Suraj I.
+created Date    : 17th Oct 2026
+******************************************************************************/
+
+#include <interface/pdi.h>
+#include <webserver/helpers/PageWriter.h>
+#include <pditest.h>
+
+static const char PAGE_WRITER_TEST_RO[] PROG_RODT_ATTR = "<div class='btnd'>flash text</div>";
+
+TEST(pagewriter, string_writer_keeps_appends_in_order)
+{
+    pdiutil::string out;
+    PageWriter page(out);
+    ASSERT_TRUE(page.ok());
+
+    page.append("<p>").append_ro(PAGE_WRITER_TEST_RO).append("</p>", 4);
+
+    ASSERT_TRUE(out == "<p><div class='btnd'>flash text</div></p>");
+    ASSERT_EQ(page.written(), (uint32_t)out.size());
+    ASSERT_EQ(page.length(), (uint16_t)0);
+}
+
+TEST(pagewriter, a_full_chunk_is_flushed_and_reused)
+{
+    PageWriter page((iHttpServerInterface *)nullptr);
+    ASSERT_TRUE(page.ok());
+
+    char text[PAGE_WRITER_CHUNK_SIZE / 4];
+    memset(text, 'a', sizeof(text));
+
+    // five quarters of a chunk leave one quarter waiting after a flush
+    for (int i = 0; i < 5; i++)
+    {
+        page.append(text, sizeof(text));
+    }
+    ASSERT_EQ(page.written(), (uint32_t)(5 * sizeof(text)));
+    ASSERT_EQ(page.length(), (uint16_t)sizeof(text));
+
+    page.flush();
+    ASSERT_EQ(page.length(), (uint16_t)0);
+}
+
+TEST(pagewriter, text_longer_than_a_chunk_is_split)
+{
+    PageWriter page((iHttpServerInterface *)nullptr);
+
+    uint32_t size = PAGE_WRITER_CHUNK_SIZE * 2 + 10;
+    char *text = new char[size];
+    memset(text, 'b', size);
+    page.append(text, size);
+    delete[] text;
+
+    ASSERT_EQ(page.written(), size);
+    ASSERT_EQ(page.length(), (uint16_t)10);
+}
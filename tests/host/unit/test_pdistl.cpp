@@ -12,9 +12,11 @@ created Date    : 16th Aug 2026
 ******************************************************************************/
 
 #include <pditest.h>
+#include <AllocCounter.h>
 #include <utility/DataTypeDef.h>
 #include <utility/Utility.h>
 #include <utility/pdistl/map>
+#include <utility/pdistl/list>
 
 TEST(pdistl, string_starts_empty)
 {
@@ -259,6 +261,95 @@ TEST(pdistl, function_can_be_reassigned)
     ASSERT_EQ(fn(1), 10);
 }
 
+TEST(pdistl, function_keeps_a_small_capture_inside_itself)
+{
+    int base = 10;
+    int *scale = &base;
+
+    pditest::AllocCounter counter;
+    pdiutil::function<int(int)> fn = [base, scale](int v) { return v * *scale + base; };
+
+    ASSERT_EQ(counter.allocations(), (uint32_t)0);
+    ASSERT_TRUE(fn.isInline());
+    ASSERT_EQ(fn(2), 30);
+}
+
+TEST(pdistl, function_puts_a_large_capture_on_the_heap)
+{
+    struct Big
+    {
+        uint32_t words[16];
+    } big = {};
+    big.words[15] = 7;
+
+    pdiutil::function<uint32_t()> fn = [big]() { return big.words[15]; };
+
+    ASSERT_FALSE(fn.isInline());
+    ASSERT_EQ(fn(), (uint32_t)7);
+}
+
+TEST(pdistl, function_copy_and_move_keep_the_callable)
+{
+    int base = 3;
+    pdiutil::function<int(int)> small = [base](int v) { return v + base; };
+    pdiutil::function<int(int)> copied(small);
+    ASSERT_EQ(copied(1), 4);
+    ASSERT_EQ(small(1), 4);
+
+    pdiutil::function<int(int)> moved(pdistd::move(small));
+    ASSERT_EQ(moved(2), 5);
+    ASSERT_TRUE(small == nullptr);
+
+    struct Big
+    {
+        int words[16];
+    } big = {};
+    big.words[0] = 9;
+    pdiutil::function<int()> large = [big]() { return big.words[0]; };
+
+    pditest::AllocCounter counter;
+    pdiutil::function<int()> taken(pdistd::move(large));
+    ASSERT_EQ(counter.allocations(), (uint32_t)0);
+    ASSERT_EQ(taken(), 9);
+    ASSERT_TRUE(large == nullptr);
+
+    pdiutil::function<int()> assigned;
+    assigned = taken;
+    ASSERT_EQ(assigned(), 9);
+    ASSERT_EQ(taken(), 9);
+}
+
+TEST(pdistl, function_ref_borrows_a_callable_without_allocating)
+{
+    int calls = 0;
+    auto count = [&calls](int v) { calls += v; return calls; };
+
+    pditest::AllocCounter counter;
+    pdiutil::function_ref<int(int)> ref = count;
+    ASSERT_EQ(ref(2), 2);
+    ASSERT_EQ(ref(3), 5);
+    ASSERT_EQ(counter.allocations(), (uint32_t)0);
+    ASSERT_EQ(calls, 5);
+}
+
+TEST(pdistl, function_ref_of_nothing_is_empty)
+{
+    pdiutil::function_ref<void()> none = nullptr;
+    ASSERT_FALSE((bool)none);
+    ASSERT_TRUE(none == nullptr);
+
+    pdiutil::function<void()> empty;
+    pdiutil::function_ref<void()> ofempty = empty;
+    ASSERT_TRUE(nullptr == ofempty);
+
+    int hits = 0;
+    pdiutil::function<void()> set = [&hits]() { hits++; };
+    pdiutil::function_ref<void()> ofset = set;
+    ASSERT_TRUE(ofset != nullptr);
+    ofset();
+    ASSERT_EQ(hits, 1);
+}
+
 struct SampleConfig
 {
     char name[8];
@@ -345,3 +436,771 @@ TEST(pdistl, vector_of_uri_handler_pairs_survives_growth)
         ASSERT_EQ(called, i);
     }
 }
+
+/**
+ * Counts what a vector does to its elements, and whether it may move them
+ * without risking a throw halfway through a reallocation.
+ */
+static int counted_copies;
+static int counted_moves;
+
+template <bool NothrowMove>
+struct Counted
+{
+    int value;
+
+    Counted(int v = 0) : value(v) {}
+    Counted(const Counted &other) : value(other.value) { counted_copies++; }
+    Counted(Counted &&other) noexcept(NothrowMove) : value(other.value)
+    {
+        other.value = -1;
+        counted_moves++;
+    }
+    Counted &operator=(const Counted &other)
+    {
+        value = other.value;
+        counted_copies++;
+        return *this;
+    }
+};
+
+template <class T>
+static int capacity_changes_to_append(pdiutil::vector<T> &values, int count)
+{
+    int changes = 0;
+    for (int i = 0; i < count; i++)
+    {
+        size_t before = values.capacity();
+        values.push_back(T(i));
+        if (values.capacity() != before)
+        {
+            changes++;
+        }
+    }
+    return changes;
+}
+
+TEST(pdistl, vector_traits_tell_which_elements_move_safely)
+{
+    ASSERT_TRUE(pdistd::is_nothrow_move_constructible<pdiutil::string>::value);
+    ASSERT_TRUE(pdistd::is_nothrow_move_constructible<pdiutil::vector<int>>::value);
+    ASSERT_TRUE(pdistd::is_nothrow_move_constructible<Counted<true>>::value);
+    ASSERT_FALSE(pdistd::is_nothrow_move_constructible<Counted<false>>::value);
+}
+
+/**
+ * The append benchmark, in reallocations and element copies rather than time
+ * so it holds on any host. Growing by the 8 element buffer alone, 4096 appends
+ * took 512 reallocations and copied about 4096 * 4096 / 16 elements across
+ * them; growing by half again takes a few dozen and copies each element a
+ * bounded number of times.
+ */
+TEST(pdistl, vector_appends_reallocate_a_logarithmic_number_of_times)
+{
+    pdiutil::vector<int> values;
+    int changes = capacity_changes_to_append(values, 4096);
+
+    ASSERT_LE(changes, 20);
+    ASSERT_EQ(values.size(), (size_t)4096);
+    for (int i = 0; i < 4096; i++)
+    {
+        ASSERT_EQ(values[i], i);
+    }
+}
+
+TEST(pdistl, vector_growth_moves_elements_that_move_without_throwing)
+{
+    pdiutil::vector<Counted<true>> values;
+    counted_copies = 0;
+    counted_moves = 0;
+
+    capacity_changes_to_append(values, 1024);
+
+    // every element is moved in once and then only moved on each reallocation
+    ASSERT_EQ(counted_copies, 0);
+    ASSERT_LE(counted_moves, 1024 * 4);
+    ASSERT_EQ(values[0].value, 0);
+    ASSERT_EQ(values[1023].value, 1023);
+}
+
+TEST(pdistl, vector_growth_copies_elements_whose_move_may_throw)
+{
+    pdiutil::vector<Counted<false>> values;
+    counted_copies = 0;
+    counted_moves = 0;
+
+    capacity_changes_to_append(values, 1024);
+
+    // the moves are the appends themselves, never the relocations
+    ASSERT_EQ(counted_moves, 1024);
+    ASSERT_GT(counted_copies, 0);
+    ASSERT_LE(counted_copies, 1024 * 3);
+    ASSERT_EQ(values[512].value, 512);
+}
+
+TEST(pdistl, vector_push_back_of_its_own_element_survives_growth)
+{
+    pdiutil::vector<pdiutil::string> names;
+    names.push_back("first");
+    while (names.size() < names.capacity())
+    {
+        names.push_back("filler");
+    }
+
+    names.push_back(names[0]);
+    ASSERT_STREQ(names.back().c_str(), "first");
+    ASSERT_STREQ(names[0].c_str(), "first");
+}
+
+TEST(pdistl, vector_move_takes_the_buffer_and_leaves_the_source_empty)
+{
+    pdiutil::vector<int> source;
+    source.push_back(1);
+    source.push_back(2);
+    const int *buffer = source.data();
+
+    pdiutil::vector<int> moved(pdistd::move(source));
+    ASSERT_TRUE(moved.data() == buffer);
+    ASSERT_EQ(moved.size(), (size_t)2);
+    ASSERT_EQ(source.size(), (size_t)0);
+
+    source.push_back(3);
+    ASSERT_EQ(source[0], 3);
+
+    moved = pdistd::move(source);
+    ASSERT_EQ(moved.size(), (size_t)1);
+    ASSERT_EQ(moved[0], 3);
+    ASSERT_EQ(source.size(), (size_t)0);
+}
+
+TEST(pdistl, vector_shrink_to_fit_releases_the_spare_capacity)
+{
+    pdiutil::vector<int> values;
+    capacity_changes_to_append(values, 100);
+    ASSERT_GT(values.capacity(), (size_t)100);
+
+    values.shrink_to_fit();
+    ASSERT_EQ(values.capacity(), (size_t)100);
+    ASSERT_EQ(values[99], 99);
+
+    values.clear();
+    values.shrink_to_fit();
+    ASSERT_EQ(values.capacity(), (size_t)0);
+    values.push_back(5);
+    ASSERT_EQ(values[0], 5);
+}
+
+TEST(pdistl, string_appends_byte_at_a_time_reallocate_rarely)
+{
+    pdiutil::string text;
+    int changes = 0;
+    for (int i = 0; i < 64 * 1024; i++)
+    {
+        size_t before = text.capacity();
+        text += (char)('a' + i % 26);
+        // reading it back in between must not turn every append into a grow
+        ASSERT_EQ(text.c_str()[i], (char)('a' + i % 26));
+        if (text.capacity() != before)
+        {
+            changes++;
+        }
+    }
+
+    ASSERT_LE(changes, 30);
+    ASSERT_EQ(text.size(), (size_t)64 * 1024);
+}
+
+TEST(pdistl, string_move_leaves_the_source_usable)
+{
+    pdiutil::string source("moved along");
+    pdiutil::string moved(pdistd::move(source));
+
+    ASSERT_STREQ(moved.c_str(), "moved along");
+    ASSERT_EQ(source.size(), (size_t)0);
+    ASSERT_STREQ(source.c_str(), "");
+
+    source = "again";
+    moved = pdistd::move(source);
+    ASSERT_STREQ(moved.c_str(), "again");
+}
+
+TEST(pdistl, string_shrink_to_fit_keeps_room_for_the_terminator)
+{
+    pdiutil::string text;
+    for (int i = 0; i < 100; i++)
+    {
+        text += 'x';
+    }
+
+    text.shrink_to_fit();
+    ASSERT_EQ(text.capacity(), (size_t)101);
+    const char *buffer = text.c_str();
+    ASSERT_EQ(buffer[100], '\0');
+    ASSERT_TRUE(text.c_str() == buffer);
+}
+
+TEST(pdistl, short_string_lives_inside_itself)
+{
+    pditest::AllocCounter counter;
+    pdiutil::string key("Content-Type");
+    key += ": x";
+    pdiutil::string copy(key);
+
+    ASSERT_EQ(counter.allocations(), (uint32_t)0);
+    ASSERT_STREQ(copy.c_str(), "Content-Type: x");
+}
+
+TEST(pdistl, string_spills_to_the_heap_and_shrinks_back_inside)
+{
+    pdiutil::string text("short");
+    text += " and then some more than sixteen";
+    ASSERT_STREQ(text.c_str(), "short and then some more than sixteen");
+
+    text.resize(5);
+    text.shrink_to_fit();
+    ASSERT_STREQ(text.c_str(), "short");
+
+    pditest::AllocCounter counter;
+    text += "er";
+    ASSERT_EQ(counter.allocations(), (uint32_t)0);
+    ASSERT_STREQ(text.c_str(), "shorter");
+}
+
+TEST(pdistl, string_move_of_an_inline_string_copies_the_characters)
+{
+    pdiutil::string source("tiny");
+    pdiutil::string moved(pdistd::move(source));
+    ASSERT_STREQ(moved.c_str(), "tiny");
+    ASSERT_EQ(source.size(), (size_t)0);
+
+    source += "reused";
+    ASSERT_STREQ(source.c_str(), "reused");
+    ASSERT_STREQ(moved.c_str(), "tiny");
+}
+
+TEST(pdistl, small_vector_stays_inline_up_to_its_size)
+{
+    pditest::AllocCounter counter;
+    pdiutil::small_vector<uint8_t, 8> bytes;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        bytes.push_back(i);
+    }
+
+    ASSERT_EQ(counter.allocations(), (uint32_t)0);
+    ASSERT_TRUE(bytes.is_inline());
+    ASSERT_EQ(bytes.size(), (size_t)8);
+    ASSERT_EQ(bytes[7], 7);
+}
+
+TEST(pdistl, small_vector_spills_to_the_heap_and_keeps_its_elements)
+{
+    pdiutil::small_vector<int, 4> values;
+    for (int i = 0; i < 100; i++)
+    {
+        values.push_back(i);
+    }
+
+    ASSERT_FALSE(values.is_inline());
+    ASSERT_EQ(values.size(), (size_t)100);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(values[i], i);
+    }
+
+    values.resize(3);
+    values.shrink_to_fit();
+    ASSERT_TRUE(values.is_inline());
+    ASSERT_EQ(values[2], 2);
+}
+
+TEST(pdistl, small_vector_copy_and_move_keep_the_elements)
+{
+    pdiutil::small_vector<pdiutil::string, 2> inline_names;
+    inline_names.push_back("a");
+    inline_names.push_back("b");
+
+    pdiutil::small_vector<pdiutil::string, 2> heap_names;
+    for (int i = 0; i < 5; i++)
+    {
+        heap_names.push_back(pdiutil::string("name that will not fit inline"));
+    }
+
+    pdiutil::small_vector<pdiutil::string, 2> copy(inline_names);
+    ASSERT_TRUE(copy.is_inline());
+    ASSERT_STREQ(copy[1].c_str(), "b");
+
+    pdiutil::small_vector<pdiutil::string, 2> moved(pdistd::move(inline_names));
+    ASSERT_TRUE(moved.is_inline());
+    ASSERT_STREQ(moved[0].c_str(), "a");
+    ASSERT_EQ(inline_names.size(), (size_t)0);
+    ASSERT_TRUE(inline_names.is_inline());
+
+    const pdiutil::string *buffer = heap_names.data();
+    moved = pdistd::move(heap_names);
+    ASSERT_TRUE(moved.data() == buffer);
+    ASSERT_EQ(moved.size(), (size_t)5);
+    ASSERT_EQ(heap_names.size(), (size_t)0);
+
+    heap_names.push_back("reused");
+    ASSERT_STREQ(heap_names[0].c_str(), "reused");
+}
+
+TEST(pdistl, small_vector_passes_as_a_vector)
+{
+    pdiutil::small_vector<uint8_t, 4> bytes;
+    pdiutil::vector<uint8_t> &as_vector = bytes;
+    as_vector.push_back(1);
+    as_vector.insert(as_vector.end(), 6, 2);
+
+    ASSERT_EQ(bytes.size(), (size_t)7);
+    ASSERT_FALSE(bytes.is_inline());
+    ASSERT_EQ(bytes[6], 2);
+}
+
+TEST(pdistl, string_view_looks_at_characters_without_copying)
+{
+    const char *text = "GET /index.html HTTP/1.1";
+    pdiutil::string_view line(text);
+
+    ASSERT_EQ(line.size(), (size_t)24);
+    ASSERT_TRUE(line.starts_with("GET "));
+    ASSERT_TRUE(line.ends_with('1'));
+
+    pdiutil::string_view uri = line.substr(4, line.find(' ', 4) - 4);
+    ASSERT_TRUE(uri == "/index.html");
+    ASSERT_TRUE(uri.data() == text + 4);
+    ASSERT_EQ(uri.rfind('.'), (size_t)6);
+    ASSERT_EQ(line.find("HTTP"), (size_t)16);
+    ASSERT_EQ(line.find("FTP"), pdiutil::string_view::npos);
+}
+
+TEST(pdistl, string_view_compares_with_strings_and_literals)
+{
+    pdiutil::string owned("ssh-rsa");
+    pdiutil::string_view view("ssh-rsa-cert", 7);
+
+    ASSERT_TRUE(view == owned);
+    ASSERT_TRUE(owned == view);
+    ASSERT_TRUE(view != "ssh-rs");
+    ASSERT_TRUE(pdiutil::string_view("abc") < pdiutil::string_view("abd"));
+    ASSERT_TRUE(pdiutil::string_view("ab") < pdiutil::string_view("abc"));
+
+    pdiutil::string copy(view);
+    copy += pdiutil::string_view("-cert", 5);
+    ASSERT_STREQ(copy.c_str(), "ssh-rsa-cert");
+}
+
+TEST(pdistl, default_string_view_has_no_data)
+{
+    pdiutil::string_view nothing;
+    ASSERT_NULL(nothing.data());
+    ASSERT_TRUE(nothing.empty());
+    ASSERT_NOT_NULL(pdiutil::string_view("").data());
+}
+
+TEST(pdistl, span_views_vectors_arrays_and_slices)
+{
+    pdiutil::vector<uint8_t> bytes;
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        bytes.push_back(i);
+    }
+
+    pdiutil::span<const uint8_t> all(bytes);
+    ASSERT_EQ(all.size(), (size_t)10);
+    ASSERT_TRUE(all.data() == bytes.data());
+
+    pdiutil::span<const uint8_t> middle = all.subspan(3, 4);
+    ASSERT_EQ(middle.size(), (size_t)4);
+    ASSERT_EQ(middle.front(), 3);
+    ASSERT_EQ(middle.back(), 6);
+    ASSERT_EQ(all.subspan(8, 5).size(), (size_t)2);
+    ASSERT_EQ(all.last(2)[0], 8);
+
+    char buffer[6];
+    pdiutil::span<char> writable(buffer);
+    ASSERT_EQ(writable.size(), (size_t)6);
+    writable[0] = 'x';
+    ASSERT_EQ(buffer[0], 'x');
+
+    pdiutil::small_vector<uint8_t, 4> small(3, 7);
+    pdiutil::span<uint8_t> ofsmall(small);
+    ASSERT_EQ(ofsmall.size(), (size_t)3);
+    ASSERT_EQ(ofsmall[2], 7);
+}
+
+static pdiutil::string numbered_key(const char *prefix, uint32_t i)
+{
+    char key[24];
+    snprintf(key, sizeof(key), "%s%04u", prefix, (unsigned)i);
+    return pdiutil::string(key);
+}
+
+// a walk over n keys in an order that is neither sorted nor reversed
+static uint32_t scrambled(uint32_t i, uint32_t n)
+{
+    return (i * 7919u) % n;
+}
+
+TEST(pdistl, map_keeps_keys_sorted_through_inserts_and_erases)
+{
+    const uint32_t n = 1000;
+    pdiutil::map<uint32_t, uint32_t> values;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t k = scrambled(i, n);
+        ASSERT_TRUE(values.insert(pdistd::make_pair(k, k * 3)).second);
+    }
+    ASSERT_FALSE(values.insert(pdistd::make_pair(5u, 0u)).second);
+    ASSERT_EQ(values.size(), (size_t)n);
+
+    uint32_t expect = 0;
+    for (pdiutil::map<uint32_t, uint32_t>::iterator it = values.begin(); it != values.end(); ++it)
+    {
+        ASSERT_EQ(it->first, expect);
+        ASSERT_EQ(it->second, expect * 3);
+        expect++;
+    }
+
+    for (uint32_t k = 0; k < n; k += 2)
+    {
+        ASSERT_EQ(values.erase(k), (size_t)1);
+    }
+    ASSERT_EQ(values.size(), (size_t)(n / 2));
+    ASSERT_TRUE(values.find(10) == values.end());
+    ASSERT_EQ(values.find(11)->second, (uint32_t)33);
+    ASSERT_EQ(values.lower_bound(10)->first, (uint32_t)11);
+    ASSERT_EQ(values.upper_bound(11)->first, (uint32_t)13);
+    ASSERT_EQ((--values.end())->first, n - 1);
+    ASSERT_EQ(values.rbegin()->first, n - 1);
+}
+
+TEST(pdistl, map_index_inserts_a_key_once)
+{
+    pdiutil::map<pdiutil::string, int> counts;
+    counts["beta"]++;
+    counts["alpha"]++;
+    counts["beta"]++;
+
+    ASSERT_EQ(counts.size(), (size_t)2);
+    ASSERT_EQ(counts["beta"], 2);
+    ASSERT_STREQ(counts.begin()->first.c_str(), "alpha");
+
+    const pdiutil::map<pdiutil::string, int> &view = counts;
+    ASSERT_EQ(view.find("alpha")->second, 1);
+    ASSERT_TRUE(view.find("gamma") == view.end());
+    ASSERT_EQ(view.count("beta"), (size_t)1);
+}
+
+TEST(pdistl, map_copies_and_swaps_whole_trees)
+{
+    pdiutil::map<int, int> a;
+    for (int i = 0; i < 50; i++)
+    {
+        a[i] = -i;
+    }
+
+    pdiutil::map<int, int> b(a);
+    b[7] = 70;
+    ASSERT_EQ(a[7], -7);
+    ASSERT_EQ(b.size(), (size_t)50);
+
+    pdiutil::map<int, int> c;
+    c.swap(b);
+    ASSERT_TRUE(b.empty());
+    ASSERT_TRUE(b.begin() == b.end());
+    ASSERT_EQ(c[7], 70);
+    ASSERT_EQ(c.rbegin()->first, 49);
+
+    b = c;
+    ASSERT_TRUE(b == c);
+    c.clear();
+    ASSERT_TRUE(c.empty());
+    ASSERT_EQ(b.size(), (size_t)50);
+}
+
+TEST(pdistl, multimap_keeps_equal_keys_in_insertion_order)
+{
+    pdistd::multimap<int, int> entries;
+    for (int i = 0; i < 9; i++)
+    {
+        entries.insert(pdistd::make_pair(i % 3, i));
+    }
+
+    ASSERT_EQ(entries.count(1), (size_t)3);
+    pdistd::pair<pdistd::multimap<int, int>::iterator, pdistd::multimap<int, int>::iterator> run = entries.equal_range(1);
+    int expect = 1;
+    for (pdistd::multimap<int, int>::iterator it = run.first; it != run.second; ++it)
+    {
+        ASSERT_EQ(it->second, expect);
+        expect += 3;
+    }
+    ASSERT_EQ(entries.erase(1), (size_t)3);
+    ASSERT_EQ(entries.size(), (size_t)6);
+}
+
+TEST(pdistl, set_keeps_one_of_each_key)
+{
+    pdiutil::set<pdiutil::string> names;
+    names.insert("root");
+    names.insert("admin");
+    names.insert("root");
+
+    ASSERT_EQ(names.size(), (size_t)2);
+    ASSERT_STREQ(names.begin()->c_str(), "admin");
+    ASSERT_EQ(names.count("root"), (size_t)1);
+    names.erase(names.begin());
+    ASSERT_STREQ(names.begin()->c_str(), "root");
+}
+
+TEST(pdistl, flat_map_keeps_pairs_sorted_in_one_buffer)
+{
+    pdiutil::flat_map<pdiutil::string, int> table;
+    table.reserve(8);
+    table["gamma"] = 3;
+    table["alpha"] = 1;
+    ASSERT_TRUE(table.insert(pdistd::make_pair(pdiutil::string("beta"), 2)).second);
+    ASSERT_FALSE(table.insert(pdistd::make_pair(pdiutil::string("beta"), 9)).second);
+
+    ASSERT_EQ(table.size(), (size_t)3);
+    ASSERT_STREQ(table.begin()->first.c_str(), "alpha");
+    ASSERT_STREQ((table.begin() + 1)->first.c_str(), "beta");
+    ASSERT_EQ(table.at("beta"), 2);
+    ASSERT_TRUE(table.contains("gamma"));
+    ASSERT_TRUE(table.find("delta") == table.end());
+
+    ASSERT_EQ(table.erase("alpha"), (size_t)1);
+    ASSERT_EQ(table.erase("alpha"), (size_t)0);
+    ASSERT_STREQ(table.begin()->first.c_str(), "beta");
+    ASSERT_EQ(table.capacity(), (size_t)8);
+}
+
+TEST(pdistl, unordered_map_finds_every_key_across_growth)
+{
+    pdiutil::unordered_map<pdiutil::string, uint32_t> table;
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        ASSERT_TRUE(table.insert(pdistd::make_pair(numbered_key("user", i), i)).second);
+    }
+    ASSERT_EQ(table.size(), (size_t)500);
+    ASSERT_LE(table.load_factor(), table.max_load_factor());
+
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        ASSERT_EQ(table.at(numbered_key("user", i)), i);
+    }
+    ASSERT_TRUE(table.find("nobody") == table.end());
+    ASSERT_FALSE(table.insert(pdistd::make_pair(numbered_key("user", 7), 0u)).second);
+
+    uint32_t seen = 0;
+    for (pdiutil::unordered_map<pdiutil::string, uint32_t>::const_iterator it = table.begin(); it != table.end(); ++it)
+    {
+        seen++;
+    }
+    ASSERT_EQ(seen, (uint32_t)500);
+}
+
+TEST(pdistl, unordered_map_erase_keeps_the_rest_reachable)
+{
+    pdiutil::unordered_map<uint32_t, uint32_t> table;
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        table[i * 16] = i;
+    }
+
+    for (pdiutil::unordered_map<uint32_t, uint32_t>::iterator it = table.begin(); it != table.end();)
+    {
+        if (0 == it->second % 3)
+        {
+            it = table.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        ASSERT_EQ(table.count(i * 16), (size_t)(0 == i % 3 ? 0 : 1));
+    }
+    ASSERT_EQ(table.size(), (size_t)133);
+}
+
+TEST(pdistl, unordered_map_reserved_table_fills_and_looks_up_without_allocating)
+{
+    pdiutil::unordered_map<uint32_t, uint32_t> table;
+    table.reserve(100);
+    size_t buckets = table.bucket_count();
+
+    pditest::AllocCounter counter;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        table[i] = i;
+    }
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(table.at(i), i);
+    }
+    table.clear();
+    table[1] = 1;
+
+    ASSERT_EQ(counter.allocations(), (uint32_t)0);
+    ASSERT_EQ(table.bucket_count(), buckets);
+}
+
+static uint32_t hooked_allocations = 0;
+
+template <class T>
+struct HookedAllocator : public pdistd::allocator<T>
+{
+    template <class U>
+    struct rebind
+    {
+        typedef HookedAllocator<U> other;
+    };
+
+    HookedAllocator() {}
+    template <class U>
+    HookedAllocator(const HookedAllocator<U> &) {}
+
+    T *allocate(size_t n, const void * = 0)
+    {
+        hooked_allocations++;
+        return pdistd::allocator<T>::allocate(n);
+    }
+};
+
+TEST(pdistl, associative_containers_allocate_through_their_allocator)
+{
+    hooked_allocations = 0;
+    {
+        pdistd::map<int, int, pdistd::less<int>, HookedAllocator<int>> tree;
+        for (int i = 0; i < 10; i++)
+        {
+            tree[i] = i;
+        }
+    }
+    // one node per key
+    ASSERT_EQ(hooked_allocations, (uint32_t)10);
+
+    hooked_allocations = 0;
+    {
+        pdistd::flat_map<int, int, pdistd::less<int>, HookedAllocator<pdistd::pair<int, int>>> flat;
+        flat.reserve(10);
+        for (int i = 0; i < 10; i++)
+        {
+            flat[i] = i;
+        }
+    }
+    // the vector's starting buffer and the reserved one
+    ASSERT_EQ(hooked_allocations, (uint32_t)2);
+
+    hooked_allocations = 0;
+    {
+        pdistd::unordered_map<int, int, pdistd::hash<int>, pdistd::equal_to<int>, HookedAllocator<pdistd::pair<int, int>>> hashed(10);
+        for (int i = 0; i < 10; i++)
+        {
+            hashed[i] = i;
+        }
+    }
+    // the control bytes and the slots
+    ASSERT_EQ(hooked_allocations, (uint32_t)2);
+}
+
+static uint32_t key_comparisons = 0;
+
+struct CountingLess
+{
+    bool operator()(const pdiutil::string &a, const pdiutil::string &b) const
+    {
+        key_comparisons++;
+        return a < b;
+    }
+};
+
+struct CountingEqual
+{
+    bool operator()(const pdiutil::string &a, const pdiutil::string &b) const
+    {
+        key_comparisons++;
+        return a == b;
+    }
+};
+
+// what map did on a list: walk from the front while the keys sort before k
+static bool list_lookup(const pdistd::list<pdistd::pair<pdiutil::string, uint32_t>> &entries, const pdiutil::string &k)
+{
+    CountingLess less;
+    pdistd::list<pdistd::pair<pdiutil::string, uint32_t>>::const_iterator it = entries.begin();
+    while (it != entries.end() && less(it->first, k))
+    {
+        ++it;
+    }
+    return it != entries.end() && !less(k, it->first);
+}
+
+static uint32_t ceil_log2(uint32_t n)
+{
+    uint32_t bits = 0;
+    while ((1u << bits) < n)
+    {
+        bits++;
+    }
+    return bits;
+}
+
+/**
+ * The lookup benchmark, in key comparisons rather than time so it holds on any
+ * host: name keys, found once each, against the sorted list map used to walk.
+ * The list costs about half the keys per lookup; the tree at most twice the
+ * log of them, the flat map the log, and the hash map about one.
+ */
+TEST(pdistl, keyed_lookups_compare_a_logarithmic_number_of_keys)
+{
+    const uint32_t sizes[] = {10, 100, 1000};
+    for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        const uint32_t n = sizes[s];
+        pdistd::list<pdistd::pair<pdiutil::string, uint32_t>> listed;
+        pdistd::map<pdiutil::string, uint32_t, CountingLess> tree;
+        pdistd::flat_map<pdiutil::string, uint32_t, CountingLess> flat;
+        pdistd::unordered_map<pdiutil::string, uint32_t, pdistd::hash<pdiutil::string>, CountingEqual> hashed;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            pdiutil::string key = numbered_key("session", scrambled(i, n));
+            tree.insert(pdistd::make_pair(key, i));
+            flat.insert(pdistd::make_pair(key, i));
+            hashed.insert(pdistd::make_pair(key, i));
+        }
+        for (uint32_t i = 0; i < n; i++)
+        {
+            listed.push_back(pdistd::make_pair(numbered_key("session", i), i));
+        }
+
+        uint32_t costs[4];
+        for (int kind = 0; kind < 4; kind++)
+        {
+            key_comparisons = 0;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                pdiutil::string key = numbered_key("session", i);
+                bool found = 0 == kind ? list_lookup(listed, key)
+                           : 1 == kind ? tree.find(key) != tree.end()
+                           : 2 == kind ? flat.find(key) != flat.end()
+                                       : hashed.find(key) != hashed.end();
+                ASSERT_TRUE(found);
+            }
+            costs[kind] = key_comparisons;
+        }
+
+        pditest::note("%4u keys: %6.1f list, %4.1f tree, %4.1f flat, %3.1f hashed comparisons per lookup",
+                      (unsigned)n, costs[0] / (double)n, costs[1] / (double)n, costs[2] / (double)n, costs[3] / (double)n);
+
+        ASSERT_LE(costs[1], n * (2 * ceil_log2(n + 1) + 1));
+        ASSERT_LE(costs[2], n * (ceil_log2(n + 1) + 1));
+        ASSERT_LE(costs[3], n * 2);
+        ASSERT_GE(costs[0], n * n / 2);
+    }
+}
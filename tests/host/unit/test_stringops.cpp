@@ -286,6 +286,46 @@ TEST(stringops, get_from_json_rejects_null)
     ASSERT_FALSE(__get_from_json("{}", "a", nullptr, 8));
 }
 
+TEST(stringops, get_from_json_views_the_value_where_it_lies)
+{
+    const char *json = "{\"ssid\":\"pdiStack\",\"ch\":6}";
+    pdiutil::string_view value;
+    ASSERT_TRUE(__get_from_json(pdiutil::string_view(json), "ssid", value));
+    ASSERT_TRUE(value == "pdiStack");
+    ASSERT_TRUE(value.data() == json + 9);
+
+    ASSERT_FALSE(__get_from_json(pdiutil::string_view(json), "none", value));
+}
+
+TEST(stringops, get_from_json_stays_inside_the_view)
+{
+    // the view ends before the second key, so it is not found
+    const char *json = "{\"a\":1,\"b\":2}";
+    pdiutil::string_view value;
+    ASSERT_FALSE(__get_from_json(pdiutil::string_view(json, 7), "b", value));
+    ASSERT_TRUE(__get_from_json(pdiutil::string_view(json, 7), "a", value));
+    ASSERT_TRUE(value == "1");
+}
+
+TEST(stringops, strtrim_narrows_a_view_without_writing)
+{
+    const char text[] = "  padded  ";
+    pdiutil::string_view trimmed = __strtrim(pdiutil::string_view(text));
+    ASSERT_TRUE(trimmed == "padded");
+    ASSERT_STREQ(text, "  padded  ");
+
+    ASSERT_TRUE(__strtrim_val(pdiutil::string_view("\"q\""), '"') == "q");
+    ASSERT_TRUE(__strtrim(pdiutil::string_view("   ")).empty());
+}
+
+TEST(stringops, strstr_searches_views)
+{
+    pdiutil::string_view text("key=value;key=other", 19);
+    ASSERT_EQ(__strstr(text, "key"), 0);
+    ASSERT_EQ(__strstr(text, "key", 1), 10);
+    ASSERT_EQ(__strstr(text.substr(0, 9), "other"), -1);
+}
+
 TEST(stringops, append_uint_to_buff_substitutes_specifier)
 {
     char buf[32];
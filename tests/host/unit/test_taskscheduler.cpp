@@ -243,10 +243,10 @@ TEST(scheduler, unique_ids_do_not_collide_while_tasks_are_live)
 }
 
 /**
- * Ids are handed out as the lowest free integer, so the id of a reaped task is
- * immediately available again. Pinned here until generational ids land.
+ * A released slot comes back under its next generation, so the id of a reaped
+ * task is not handed out again with it.
  */
-TEST(scheduler, id_of_a_reaped_task_is_handed_out_again)
+TEST(scheduler, id_of_a_reaped_task_is_not_handed_out_again)
 {
     TaskScheduler scheduler;
     pditest::FakeClock clock;
@@ -258,15 +258,23 @@ TEST(scheduler, id_of_a_reaped_task_is_handed_out_again)
     scheduler.remove_expired_tasks();
     ASSERT_EQ(scheduler.is_registered_task(oneshot), (int16_t)-1);
 
-    pdiutil::task_id_t replacement = scheduler.setInterval(bumpB, 10, clock.millis_now());
-    ASSERT_EQ(replacement, oneshot);
+    // enough registrations to wrap the free ring back onto the released slot
+    pdiutil::task_id_t replacement = -1;
+    for (uint16_t i = 0; i < MAX_SCHEDULABLE_TASKS; i++)
+    {
+        replacement = scheduler.setInterval(bumpB, 10, clock.millis_now());
+        ASSERT_GT(replacement, 0);
+        ASSERT_NE(replacement, oneshot);
+    }
+    ASSERT_EQ(scheduler.getTaskCount(), (uint16_t)MAX_SCHEDULABLE_TASKS);
+    ASSERT_EQ(scheduler.get_unique_task_id(), (pdiutil::task_id_t)-1);
 }
 
 /**
- * Consequence of the reuse above: a caller holding the stale id retargets the
- * task that took the slot over, replacing a live callback.
+ * A caller holding a stale id cannot reach the task that took the slot over:
+ * lookups miss, and updateInterval registers a fresh task instead.
  */
-TEST(scheduler, stale_id_retargets_the_task_that_took_the_slot)
+TEST(scheduler, stale_id_does_not_reach_the_task_that_took_the_slot)
 {
     TaskScheduler scheduler;
     pditest::FakeClock clock;
@@ -274,20 +282,25 @@ TEST(scheduler, stale_id_retargets_the_task_that_took_the_slot)
     resetCounters();
 
     pdiutil::task_id_t staleid = scheduler.setTimeout(bumpA, 10, clock.millis_now());
+    task_t *slot = scheduler.get_task(staleid);
     runFor(scheduler, clock, 50);
     scheduler.remove_expired_tasks();
 
-    scheduler.setInterval(bumpB, 10, clock.millis_now());
-    resetCounters();
-    runFor(scheduler, clock, 50);
-    ASSERT_GT(s_counter_b, 0);
-
-    scheduler.updateInterval(staleid, bumpA, 10, DEFAULT_TASK_PRIORITY, clock.millis_now());
-    resetCounters();
-    runFor(scheduler, clock, 50);
-
-    ASSERT_GT(s_counter_a, 0);
-    ASSERT_EQ(s_counter_b, 0);
+    pdiutil::task_id_t liveid = -1;
+    for (uint16_t i = 0; i < MAX_SCHEDULABLE_TASKS && liveid < 0; i++)
+    {
+        pdiutil::task_id_t id = scheduler.setInterval(bumpB, 10, clock.millis_now());
+        if (scheduler.get_task(id) == slot)
+        {
+            liveid = id;
+        }
+    }
+    ASSERT_GT(liveid, 0);
+    ASSERT_EQ(scheduler.is_registered_task(staleid), (int16_t)-1);
+    ASSERT_NULL(scheduler.get_task(staleid));
+    ASSERT_FALSE(scheduler.clearInterval(staleid));
+    ASSERT_FALSE(scheduler.sendSignal(staleid, SIG_KILL));
+    ASSERT_NOT_NULL(scheduler.get_task(liveid));
 }
 
 TEST(scheduler, a_finalizer_runs_with_the_task_when_it_is_reaped)
@@ -358,3 +371,160 @@ TEST(scheduler, a_cleared_task_still_runs_its_finalizer)
     ASSERT_EQ(calls, 1);
     ASSERT_LT(scheduler.is_registered_task(id), 0);
 }
+
+TEST(scheduler, every_due_task_runs_in_the_same_pass)
+{
+    TaskScheduler scheduler;
+    pditest::FakeClock clock;
+    scheduler.setUtilityInterface(&clock);
+    resetCounters();
+
+    scheduler.setInterval(bumpA, 10, clock.millis_now());
+    scheduler.setInterval(bumpB, 10, clock.millis_now());
+
+    clock.advance(10);
+    scheduler.handle_tasks();
+
+    ASSERT_EQ(s_counter_a, 1);
+    ASSERT_EQ(s_counter_b, 1);
+}
+
+TEST(scheduler, the_higher_priority_runs_first_among_tasks_due_together)
+{
+    TaskScheduler scheduler;
+    pditest::FakeClock clock;
+    scheduler.setUtilityInterface(&clock);
+    resetCounters();
+
+    scheduler.setInterval(bumpA, 10, clock.millis_now(), 1);
+    scheduler.setInterval(bumpB, 10, clock.millis_now(), 5);
+
+    clock.advance(10);
+    scheduler.handle_tasks();
+
+    ASSERT_EQ(s_order_len, 2);
+    ASSERT_EQ(s_order[0], 2);
+    ASSERT_EQ(s_order[1], 1);
+}
+
+TEST(scheduler, nice_reorders_tasks_that_are_already_queued)
+{
+    TaskScheduler scheduler;
+    pditest::FakeClock clock;
+    scheduler.setUtilityInterface(&clock);
+    resetCounters();
+
+    pdiutil::task_id_t a = scheduler.setInterval(bumpA, 10, clock.millis_now());
+    scheduler.setInterval(bumpB, 10, clock.millis_now());
+    ASSERT_TRUE(scheduler.setTaskNice(a, -10));
+
+    clock.advance(10);
+    scheduler.handle_tasks();
+
+    ASSERT_EQ(s_order_len, 2);
+    ASSERT_EQ(s_order[0], 1);
+}
+
+TEST(scheduler, a_task_that_is_not_due_does_not_hold_back_one_that_is)
+{
+    TaskScheduler scheduler;
+    pditest::FakeClock clock;
+    scheduler.setUtilityInterface(&clock);
+    resetCounters();
+
+    scheduler.setInterval(bumpA, 1000, clock.millis_now(), 10);
+    scheduler.setInterval(bumpB, 10, clock.millis_now(), 0);
+    runFor(scheduler, clock, 100);
+
+    ASSERT_EQ(s_counter_a, 0);
+    ASSERT_GE(s_counter_b, 9);
+}
+
+TEST(scheduler, a_stopped_task_is_skipped_until_it_is_continued)
+{
+    TaskScheduler scheduler;
+    pditest::FakeClock clock;
+    scheduler.setUtilityInterface(&clock);
+    resetCounters();
+
+    pdiutil::task_id_t id = scheduler.setInterval(bumpA, 10, clock.millis_now());
+    ASSERT_TRUE(scheduler.sendSignal(id, SIG_STOP));
+    runFor(scheduler, clock, 100);
+    ASSERT_EQ(s_counter_a, 0);
+    ASSERT_EQ((int)scheduler.get_task(id)->m_state, (int)TASK_STATE_STOPPED);
+
+    ASSERT_TRUE(scheduler.sendSignal(id, SIG_CONT));
+    runFor(scheduler, clock, 100);
+    ASSERT_GT(s_counter_a, 0);
+}
+
+TEST(scheduler, a_killed_task_is_reaped_on_the_next_pass)
+{
+    TaskScheduler scheduler;
+    pditest::FakeClock clock;
+    scheduler.setUtilityInterface(&clock);
+    resetCounters();
+
+    pdiutil::task_id_t id = scheduler.setInterval(bumpA, 1000, clock.millis_now());
+    ASSERT_TRUE(scheduler.sendSignal(id, SIG_KILL));
+    runFor(scheduler, clock, 1);
+
+    ASSERT_LT(scheduler.is_registered_task(id), 0);
+    ASSERT_EQ(s_counter_a, 0);
+}
+
+TEST(scheduler, next_deadline_is_the_time_left_on_the_earliest_task)
+{
+    TaskScheduler scheduler;
+    pditest::FakeClock clock;
+    scheduler.setUtilityInterface(&clock);
+    resetCounters();
+
+    ASSERT_EQ(scheduler.nextDeadlineMs(), (uint32_t)UINT32_MAX);
+
+    scheduler.setInterval(bumpA, 100, clock.millis_now());
+    scheduler.setInterval(bumpB, 30, clock.millis_now());
+    ASSERT_EQ(scheduler.nextDeadlineMs(), (uint32_t)30);
+
+    clock.advance(10);
+    ASSERT_EQ(scheduler.nextDeadlineMs(), (uint32_t)20);
+
+    clock.advance(25);
+    ASSERT_EQ(scheduler.nextDeadlineMs(), (uint32_t)0);
+
+    // registered at time zero, so its period restarts from the run
+    scheduler.handle_tasks();
+    ASSERT_EQ(s_counter_b, 1);
+    ASSERT_EQ(scheduler.nextDeadlineMs(), (uint32_t)30);
+}
+
+TEST(scheduler, a_pending_signal_makes_the_next_deadline_now)
+{
+    TaskScheduler scheduler;
+    pditest::FakeClock clock;
+    scheduler.setUtilityInterface(&clock);
+    resetCounters();
+
+    pdiutil::task_id_t id = scheduler.setInterval(bumpA, 1000, clock.millis_now());
+    ASSERT_EQ(scheduler.nextDeadlineMs(), (uint32_t)1000);
+
+    scheduler.sendSignal(id, SIG_TERM);
+    ASSERT_EQ(scheduler.nextDeadlineMs(), (uint32_t)0);
+
+    scheduler.handle_tasks();
+    ASSERT_EQ(scheduler.nextDeadlineMs(), (uint32_t)UINT32_MAX);
+}
+
+TEST(scheduler, a_stopped_task_does_not_hold_the_next_deadline)
+{
+    TaskScheduler scheduler;
+    pditest::FakeClock clock;
+    scheduler.setUtilityInterface(&clock);
+    resetCounters();
+
+    pdiutil::task_id_t id = scheduler.setInterval(bumpA, 10, clock.millis_now());
+    scheduler.sendSignal(id, SIG_STOP);
+    scheduler.handle_tasks();
+
+    ASSERT_EQ(scheduler.nextDeadlineMs(), (uint32_t)UINT32_MAX);
+}
@@ -3,12 +3,11 @@
 """
 The web portal of a pdi target, driven the way a browser drives it.
 
-One connection per request, closed straight after. The server serves a single
-client at a time, so holding a keep-alive connection open between assertions
-would make the next one wait for the idle timeout; and a request that arrives
-while the previous client is still being served is refused rather than queued,
-which is why every request is retried a few times before it is called a
-failure.
+One connection per request, closed straight after, so every assertion starts
+from a fresh connection rather than one an earlier test left in some state. The
+server holds only a few connections at once, and one arriving while they are
+all busy mid-request waits or is refused, which is why every request is retried
+a few times before it is called a failure.
 
 Nothing here is imported unless a portal test runs, so a target without an http
 server costs nothing.
@@ -65,6 +64,40 @@ class Response(object):
         return "<Response %d %d bytes>" % (self.status, len(self.body))
 
 
+class EventStream(object):
+    """
+    A text/event-stream response read an event at a time.
+
+    The body arrives chunked; chunk framing is dropped and what is left is
+    split on the blank line that ends each event.
+    """
+
+    def __init__(self, connection, response):
+        self.connection = connection
+        self.response = response
+        self.status = response.status
+        self.pending = ""
+
+    def next(self):
+        """The data of the next event as parsed json, or None once it ended."""
+        while "\n\n" not in self.pending:
+            piece = self.response.read1(4096)
+            if not piece:
+                return None
+            self.pending += piece.decode(errors="replace")
+
+        event, _, self.pending = self.pending.partition("\n\n")
+        data = "".join(line[len("data: "):] for line in event.split("\n")
+                       if line.startswith("data: "))
+        try:
+            return json.loads(data)
+        except ValueError as err:
+            raise PortalError("an event was not json: %s\n%s" % (err, data[:400]))
+
+    def close(self):
+        self.connection.close()
+
+
 class Portal(object):
     """An http conversation with one target, remembering its cookies."""
 
@@ -149,6 +182,24 @@ class Portal(object):
         raise PortalError("%s %s failed after %d attempts: %s"
                           % (method, path, attempts, last))
 
+    def events(self, path):
+        """Open an event stream; the caller closes it."""
+        headers = {
+            "Host": "%s:%d" % (self.host, self.port),
+            "Accept": "text/event-stream",
+        }
+        if self.jar:
+            headers["Cookie"] = self._cookie_header()
+
+        connection = http.client.HTTPConnection(self.host, self.port,
+                                                timeout=self.timeout)
+        try:
+            connection.request("GET", path, headers=headers)
+            return EventStream(connection, connection.getresponse())
+        except (http.client.HTTPException, OSError, socket.timeout) as err:
+            connection.close()
+            raise PortalError("GET %s failed: %s" % (path, err))
+
     def get(self, path, attempts=4):
         return self.request("GET", path, attempts=attempts)
 
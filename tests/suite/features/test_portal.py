@@ -13,6 +13,8 @@ Skipped whole when the target serves no http port, so a build without the web
 server reports that rather than a page of failures.
 """
 
+import http.client
+
 from .registry import test, expect_in, expect_not_in, Skip
 
 # every settings page the portal can carry; a build without a service simply
@@ -203,6 +205,39 @@ def firmware_page_offers_both_routes(t):
     expect_in("csrf", page.body, "the firmware form carries a csrf token")
 
 
+@test("the dashboard pushes its state as events, then only what changed")
+def dashboard_event_stream(t):
+    portal = t.portal()
+    a_page(portal, "/dashboard", "the dashboard")
+
+    stream = portal.events("/dashboard-events")
+    try:
+        if 200 != stream.status:
+            raise AssertionError("the dashboard event stream answered %d" % stream.status)
+
+        first = stream.next()
+        if first is None:
+            raise AssertionError("the event stream ended before its first event")
+        for key in ("w", "nwt", "up", "fs", "hp", "ps", "se", "gp", "dv"):
+            expect_in(key, first, "the first event carries every section")
+
+        # the uptime moves between two pushes, so there is always a next one
+        second = stream.next()
+        if second is None:
+            raise AssertionError("the event stream ended after its first event")
+        expect_in("up", second, "a later event carries the clock")
+        for key in second:
+            expect_in(key, first, "a later event only carries known sections")
+    finally:
+        stream.close()
+
+    # polling stays for a browser without event streams
+    answer = portal.get("/listen-dashboard")
+    if 200 != answer.status:
+        raise AssertionError("the dashboard poll answered %d" % answer.status)
+    expect_in("up", answer.json(), "the polled state")
+
+
 @test("an unknown page is reported as not found")
 def unknown_page_is_not_found(t):
     portal = t.portal()
@@ -212,6 +247,31 @@ def unknown_page_is_not_found(t):
         raise AssertionError("an unknown page answered %d" % answer.status)
 
 
+@test("a browser holding its connection open does not lock out another")
+def kept_alive_connections_are_served_together(t):
+    portal = t.portal(login=False)
+
+    def fetch(connection):
+        connection.request("GET", "/login", headers={"Connection": "keep-alive"})
+        answer = connection.getresponse()
+        answer.read()
+        return answer.status
+
+    held = http.client.HTTPConnection(portal.host, portal.port, timeout=5)
+    other = http.client.HTTPConnection(portal.host, portal.port, timeout=5)
+    try:
+        if 200 != fetch(held):
+            raise AssertionError("the first connection was not answered")
+        if 200 != fetch(other):
+            raise AssertionError("the second connection was not answered while the first was open")
+        # the first is still being served on the connection it kept
+        if 200 != fetch(held):
+            raise AssertionError("the kept connection was dropped for the second one")
+    finally:
+        held.close()
+        other.close()
+
+
 @test("a state changing post without a csrf token is refused")
 def post_without_csrf_refused(t):
     portal = t.portal()
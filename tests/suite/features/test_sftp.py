@@ -24,9 +24,10 @@ def sftp_open(t, attempts=3):
     """
     An sftp session on the target, on its own ssh connection.
 
-    A board serves one channel per session, so this does not share the shell's
-    connection. Skips when ssh or the subsystem is not there; anything past the
-    subsystem opening is a real failure.
+    The suite's shell may not be on ssh at all, so this does not share its
+    connection; see test_ssh.open_beside for sftp next to a shell. Skips when
+    ssh or the subsystem is not there; anything past the subsystem opening is a
+    real failure.
     """
     import time
 
@@ -283,3 +284,61 @@ def sftp_alongside_a_shell(t):
         sftp.close()
         client.close()
         t.run("rm /%s" % name)
+
+
+@test("sftp transfers while a shell on the same connection runs commands",
+      needs=("echo",), slow=True)
+def sftp_beside_a_shell_on_one_connection(t):
+    """
+    A graphical client keeps a shell and a transfer on one connection. The
+    transfer runs in a thread while the shell is used, so the two channels'
+    packets interleave on the wire, and neither may stall or corrupt the other.
+    """
+    import threading
+
+    from .test_ssh import open_beside, require_ssh, ssh_dial
+
+    require_ssh(t)
+
+    name = "sftp_beside.dat"
+    blob = patterned(SPLIT_SIZE * 8)
+    outcome = {}
+
+    shell = ssh_dial(t, password=t.password)
+    try:
+        shell.attach(t.username, t.password, timeout=max(t.timeout, 30.0))
+        sftp = open_beside(shell)
+
+        def transfer():
+            try:
+                with sftp.open("/%s" % name, "wb") as fh:
+                    fh.write(blob)
+                with sftp.open("/%s" % name, "rb") as fh:
+                    outcome["back"] = fh.read()
+            except Exception as err:
+                outcome["error"] = err
+
+        worker = threading.Thread(target=transfer)
+        worker.start()
+        try:
+            answered = 0
+            while worker.is_alive() or answered == 0:
+                expect_in("tick%d" % answered, shell.run("echo tick%d" % answered, t.timeout),
+                          "the shell while sftp is transferring")
+                answered += 1
+        finally:
+            worker.join(max(t.timeout, 60.0))
+
+        if worker.is_alive():
+            raise AssertionError("the sftp transfer did not finish beside the shell")
+        if "error" in outcome:
+            raise AssertionError("the sftp transfer failed beside the shell: %s"
+                                 % outcome["error"])
+        if outcome.get("back") != blob:
+            raise AssertionError("sent %d bytes, got %d back"
+                                 % (len(blob), len(outcome.get("back") or b"")))
+
+        sftp.remove("/%s" % name)
+        sftp.close()
+    finally:
+        shell.close()
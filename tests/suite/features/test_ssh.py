@@ -322,6 +322,106 @@ def session_pool_is_bounded(t):
                 pass
 
 
+def open_beside(shell, attempts=3):
+    """
+    An sftp session on the shell's own connection, as a second channel.
+
+    Skips when the subsystem is not there; the connection itself is already
+    proven by the shell that is running on it.
+    """
+    import paramiko
+
+    transport = shell._client.get_transport()
+    try:
+        return paramiko.SFTPClient.from_transport(transport)
+    except Exception as err:
+        raise Skip("the target will not open sftp beside a shell: %s" % err)
+
+
+@test("closing one channel leaves the others on the connection working")
+def channel_close_is_per_channel(t):
+    """
+    A client that finishes a transfer closes that channel and keeps the
+    connection for the shell, and the other way round. Both orders are tried,
+    since the shell channel is the one the terminal is bound to.
+    """
+    require_ssh(t)
+
+    shell = ssh_dial(t, password=t.password)
+    try:
+        shell.attach(t.username, t.password, timeout=max(t.timeout, 30.0))
+
+        sftp = open_beside(shell)
+        sftp.normalize(".")
+        sftp.close()
+
+        expect_in(t.username, shell.run("whoami", t.timeout),
+                  "the shell after the sftp channel beside it closed")
+
+        sftp = open_beside(shell)
+        try:
+            shell._channel.close()
+
+            # the connection is still there for the channel that is left
+            listed = sftp.listdir("/")
+            if not isinstance(listed, list):
+                raise AssertionError("sftp listed %r after the shell closed" % listed)
+            if not sftp.normalize(".").startswith("/"):
+                raise AssertionError("sftp stopped answering after the shell closed")
+        finally:
+            sftp.close()
+    finally:
+        shell.close()
+
+
+@test("a channel past the connection's channel table is refused")
+def channel_table_is_bounded(t):
+    """
+    The channels a connection may hold are a fixed table. Once it is full a new
+    open is answered with a failure rather than taken from another channel, the
+    shell already open keeps working, and a closed channel frees its slot.
+    """
+    require_ssh(t)
+
+    shell = ssh_dial(t, password=t.password)
+    opened = []
+    try:
+        shell.attach(t.username, t.password, timeout=max(t.timeout, 30.0))
+        transport = shell._client.get_transport()
+
+        refused = None
+        for _ in range(8):
+            try:
+                opened.append(transport.open_session(timeout=t.timeout))
+            except Exception as err:
+                refused = err
+                break
+
+        if refused is None:
+            raise AssertionError("the connection took %d channels besides the shell "
+                                 "without refusing one" % len(opened))
+        if not transport.is_active():
+            raise AssertionError("refusing a channel dropped the connection: %s" % refused)
+
+        expect_in(t.username, shell.run("whoami", t.timeout),
+                  "the shell after a channel was refused")
+
+        # a slot given back is usable again
+        if opened:
+            opened.pop().close()
+            try:
+                opened.append(transport.open_session(timeout=t.timeout))
+            except Exception as err:
+                raise AssertionError("a channel could not reuse a closed one's slot: %s" % err)
+    finally:
+        for channel in opened:
+            try:
+                channel.close()
+            except Exception:
+                pass
+        shell.close()
+
+
 def _transport_with_mac(t, mac, attempts=4):
     """An authenticated ssh transport that will only accept `mac`, so a
     successful auth proves the server negotiated exactly that algorithm.